@@ -0,0 +1,253 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file implements the harness of the nds_bench executable and its
+ * entry point. Run it as "nds_bench [filter]" to only run the cases whose
+ * name contains the filter.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include "ndsbench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+/* number of times a case is repeated, the fastest run is reported */
+#define REPETITIONS 3
+
+/* result sent by the child process that ran a case */
+struct NdsBenchReport
+{
+	double ns_per_op;
+	double allocations_per_op;
+	size_t operations;
+	long peak_rss_kb;
+};
+
+/* filter given on the command line and whether a case was already printed */
+static const char *filter = NULL;
+static int printed = 0;
+
+/* values passed to nds_bench_use() */
+static const void *volatile sink = NULL;
+
+
+static void* counting_alloc(void *context, size_t size)
+{
+	((NdsBench*)context)->allocations++;
+
+	return malloc(size);
+}
+
+
+static void* counting_realloc(void *context, void *pointer, size_t old_size, size_t new_size)
+{
+	(void)old_size;
+
+	((NdsBench*)context)->allocations++;
+
+	return realloc(pointer, new_size);
+}
+
+
+static void counting_free(void *context, void *pointer, size_t size)
+{
+	(void)context;
+	(void)size;
+
+	free(pointer);
+}
+
+
+double nds_bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+
+void nds_bench_start(NdsBench *bench)
+{
+	bench->start_allocations = bench->allocations;
+	bench->start_ns = nds_bench_now_ns();
+}
+
+
+void nds_bench_stop(NdsBench *bench, size_t operations)
+{
+	bench->elapsed_ns = nds_bench_now_ns() - bench->start_ns;
+	bench->measured_allocations = bench->allocations - bench->start_allocations;
+	bench->operations = operations;
+}
+
+
+void nds_bench_count_allocation(NdsBench *bench)
+{
+	bench->allocations++;
+}
+
+
+void nds_bench_use(const void *pointer)
+{
+	sink = pointer;
+}
+
+
+static void nds_bench_child(int fd, size_t element_size, size_t elements, NdsBenchFunction function)
+{
+	struct NdsBenchReport report;
+	struct rusage usage;
+	NdsBench bench;
+	int i;
+
+	memset(&report, 0, sizeof(report));
+	report.ns_per_op = -1.0;
+
+	for (i = 0; i < REPETITIONS; i++)
+	{
+		double ns_per_op;
+
+		memset(&bench, 0, sizeof(bench));
+		bench.element_size = element_size;
+		bench.elements = elements;
+		bench.allocator.alloc = counting_alloc;
+		bench.allocator.realloc = counting_realloc;
+		bench.allocator.free = counting_free;
+		bench.allocator.context = &bench;
+
+		function(&bench);
+		if (bench.operations == 0)
+			continue;
+
+		ns_per_op = bench.elapsed_ns / bench.operations;
+		if (report.ns_per_op < 0 || ns_per_op < report.ns_per_op)
+		{
+			report.ns_per_op = ns_per_op;
+			report.allocations_per_op = (double)bench.measured_allocations / bench.operations;
+			report.operations = bench.operations;
+		}
+	}
+
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+		report.peak_rss_kb = usage.ru_maxrss;
+
+	if (write(fd, &report, sizeof(report)) != (ssize_t)sizeof(report))
+		_exit(1);
+
+	_exit(0);
+}
+
+
+void nds_bench_run(const char *name, size_t element_size, size_t elements, NdsBenchFunction function)
+{
+	struct NdsBenchReport report;
+	int fds[2];
+	pid_t pid;
+	int status;
+	ssize_t received;
+
+	/* sanity checks */
+	if (filter && !strstr(name, filter))
+		return;
+
+	/* the output buffered so far must not be duplicated in the child */
+	fflush(stdout);
+
+	if (pipe(fds) != 0)
+	{
+		fprintf(stderr, "nds_bench: pipe() failed for %s\n", name);
+		return;
+	}
+
+	pid = fork();
+	if (pid < 0)
+	{
+		fprintf(stderr, "nds_bench: fork() failed for %s\n", name);
+		close(fds[0]);
+		close(fds[1]);
+		return;
+	}
+
+	if (pid == 0)
+	{
+		close(fds[0]);
+		nds_bench_child(fds[1], element_size, elements, function);
+	}
+
+	close(fds[1]);
+	received = read(fds[0], &report, sizeof(report));
+	close(fds[0]);
+	waitpid(pid, &status, 0);
+
+	if (received != (ssize_t)sizeof(report) || !WIFEXITED(status) || WEXITSTATUS(status) != 0 || report.operations == 0)
+	{
+		fprintf(stderr, "nds_bench: %s failed\n", name);
+		return;
+	}
+
+	printf("%s\n    {\"name\": \"%s\", \"element_size\": %lu, \"elements\": %lu, \"operations\": %lu, "
+		"\"ns_per_op\": %.3f, \"allocations_per_op\": %.6f, \"peak_rss_kb\": %ld}",
+		printed ? "," : "", name, (unsigned long)element_size, (unsigned long)elements,
+		(unsigned long)report.operations, report.ns_per_op, report.allocations_per_op, report.peak_rss_kb);
+	printed = 1;
+}
+
+
+int main(int argc, char *argv[])
+{
+	if (argc > 1)
+		filter = argv[1];
+
+	printf("{\n  \"library\": \"nds\",\n  \"benchmarks\": [");
+
+	nds_vector_bench();
+	nds_search_bench();
+	nds_sort_bench();
+	nds_parallel_bench();
+	nds_scheduler_bench();
+	nds_hash_map_bench();
+	nds_hash_set_bench();
+	nds_tree_map_bench();
+	nds_queue_bench();
+	nds_concurrent_queue_bench();
+	nds_priority_queue_bench();
+	nds_forward_list_bench();
+	nds_list_bench();
+	nds_stack_bench();
+
+	printf("\n  ]\n}\n");
+
+	return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file declares the harness shared by the benchmarks of the nds_bench
+ * executable. Every benchmark case runs in its own process, so the peak
+ * resident set size reported for a case is not inflated by the cases that
+ * ran before it, and the results are printed as one JSON document.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_BENCH_H__
+#define __NDS_BENCH_H__
+
+#include <nds/ndsutils.h>
+
+#include <stddef.h>
+
+
+/* typedef for a benchmark case run by the harness */
+typedef struct NdsBench NdsBench;
+
+/* signature of the function that runs a benchmark case */
+typedef void (*NdsBenchFunction)(NdsBench *bench);
+
+/* state of the benchmark case being run */
+struct NdsBench
+{
+	/* parameters of the case */
+	size_t element_size;
+	size_t elements;
+
+	/* allocator that counts the calls made by the containers under test */
+	NdsAllocator allocator;
+
+	/* number of alloc and realloc calls made since the case started */
+	size_t allocations;
+
+	/* measurement taken between nds_bench_start() and nds_bench_stop() */
+	double start_ns;
+	size_t start_allocations;
+	double elapsed_ns;
+	size_t measured_allocations;
+	size_t operations;
+};
+
+
+/**
+ * Returns a monotonic timestamp in nanoseconds.
+ */
+double nds_bench_now_ns(void);
+
+/**
+ * Starts the measured section of a benchmark case.
+ *
+ * @param bench         the benchmark case
+ */
+void nds_bench_start(NdsBench *bench);
+
+/**
+ * Ends the measured section of a benchmark case.
+ *
+ * @param bench         the benchmark case
+ * @param operations    the number of operations done in the measured section
+ */
+void nds_bench_stop(NdsBench *bench, size_t operations);
+
+/**
+ * Records an allocation made outside of the counting allocator, which is
+ * how the raw malloc()/realloc() baselines report their calls.
+ *
+ * @param bench         the benchmark case
+ */
+void nds_bench_count_allocation(NdsBench *bench);
+
+/**
+ * Runs a benchmark case in a child process and prints its result.
+ * The case is skipped when its name does not match the filter given to
+ * nds_bench on the command line.
+ *
+ * @param name          the name of the case
+ * @param element_size  the size in bytes of the elements used by the case
+ * @param elements      the number of elements used by the case
+ * @param function      the function that runs the case
+ */
+void nds_bench_run(const char *name, size_t element_size, size_t elements, NdsBenchFunction function);
+
+/**
+ * Prevents the compiler from discarding a computed value.
+ *
+ * @param pointer       the value to keep
+ */
+void nds_bench_use(const void *pointer);
+
+/**
+ * Benchmark suites run by nds_bench.
+ */
+void nds_vector_bench(void);
+void nds_search_bench(void);
+void nds_sort_bench(void);
+void nds_parallel_bench(void);
+void nds_scheduler_bench(void);
+void nds_hash_map_bench(void);
+void nds_hash_set_bench(void);
+void nds_tree_map_bench(void);
+void nds_queue_bench(void);
+void nds_concurrent_queue_bench(void);
+void nds_priority_queue_bench(void);
+void nds_forward_list_bench(void);
+void nds_list_bench(void);
+void nds_stack_bench(void);
+
+#endif /* __NDS_BENCH_H__ */
@@ -0,0 +1,288 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the concurrent queue benchmarks of nds_bench. Equal
+ * numbers of producer and consumer threads (the last part of the case name
+ * is the number of each) move 8 byte integers through a queue that fits
+ * 1024 of them. The same transfer goes through the NdsConcurrentQueue with
+ * the try functions, with the batched functions and with the blocking
+ * functions, and through an NdsQueue guarded by a mutex.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ndsbench.h"
+
+#include <nds/ndsconcurrentqueue.h>
+#include <nds/ndsqueue.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+
+/* number of elements moved by every case, capacity of the queues and size of a batch */
+#define TRANSFERS 2000000
+#define CAPACITY 1024
+#define BATCH 32
+
+/* largest number of producers (and consumers) of a case */
+#define MAX_THREADS 8
+
+
+/* the ways to move the elements */
+enum Mode
+{
+	MODE_TRY,
+	MODE_BATCH,
+	MODE_BLOCKING,
+	MODE_MUTEX
+};
+
+/* state shared by the threads of a case */
+struct Transfer
+{
+	enum Mode mode;
+	NdsConcurrentQueue *queue;
+	NdsQueue *locked_queue;
+	pthread_mutex_t lock;
+
+	/* elements left to claim by the producers, elements received by the consumers */
+	size_t produced;
+	size_t consumed;
+	uint64_t sum;
+};
+
+
+/* number of producers and consumers of the next case, set before the case forks */
+static size_t threads = 0;
+
+
+/* claims up to count of the elements that remain to be enqueued */
+static size_t claim(struct Transfer *transfer, size_t count)
+{
+	size_t left = __atomic_load_n(&transfer->produced, __ATOMIC_RELAXED);
+
+	do
+	{
+		if (left == 0)
+			return 0;
+	} while (!__atomic_compare_exchange_n(&transfer->produced, &left, left - (left < count ? left : count), 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+	return left < count ? left : count;
+}
+
+
+/* enqueues count elements, giving up the processor whenever the queue is full */
+static void produce(struct Transfer *transfer, const uint64_t *elements, size_t count)
+{
+	ssize_t added = 0;
+
+	while (count != 0)
+	{
+		switch (transfer->mode)
+		{
+			case MODE_TRY:
+				added = nds_concurrent_queue_try_enqueue(transfer->queue, elements);
+				break;
+
+			case MODE_BATCH:
+				added = nds_concurrent_queue_try_enqueue_n(transfer->queue, elements, count);
+				break;
+
+			case MODE_BLOCKING:
+				added = nds_concurrent_queue_enqueue(transfer->queue, elements) == NDS_OK;
+				break;
+
+			case MODE_MUTEX:
+				pthread_mutex_lock(&transfer->lock);
+				added = nds_queue_size(transfer->locked_queue) < CAPACITY && nds_queue_enqueue(transfer->locked_queue, elements) == NDS_OK;
+				pthread_mutex_unlock(&transfer->lock);
+				break;
+		}
+
+		if (added <= 0)
+			sched_yield();
+		else
+		{
+			elements += added;
+			count -= (size_t)added;
+		}
+	}
+}
+
+
+static void* producer_main(void *context)
+{
+	struct Transfer *transfer = (struct Transfer*)context;
+	uint64_t elements[BATCH];
+	size_t count, i;
+
+	while ((count = claim(transfer, transfer->mode == MODE_BATCH ? BATCH : 1)) != 0)
+	{
+		for (i = 0; i < count; i++)
+			elements[i] = i;
+
+		produce(transfer, elements, count);
+	}
+
+	return NULL;
+}
+
+
+static void* consumer_main(void *context)
+{
+	struct Transfer *transfer = (struct Transfer*)context;
+	uint64_t elements[BATCH], sum = 0;
+	ssize_t removed = 0, i;
+
+	while (__atomic_load_n(&transfer->consumed, __ATOMIC_RELAXED) < TRANSFERS)
+	{
+		switch (transfer->mode)
+		{
+			case MODE_TRY:
+				removed = nds_concurrent_queue_try_dequeue(transfer->queue, elements);
+				break;
+
+			case MODE_BATCH:
+				removed = nds_concurrent_queue_try_dequeue_n(transfer->queue, elements, BATCH);
+				break;
+
+			case MODE_BLOCKING:
+				/* the queue is closed once all the elements went through */
+				if (nds_concurrent_queue_dequeue(transfer->queue, elements) != NDS_OK)
+					return NULL;
+				removed = 1;
+				break;
+
+			case MODE_MUTEX:
+				pthread_mutex_lock(&transfer->lock);
+				removed = nds_queue_dequeue(transfer->locked_queue, elements) == NDS_OK;
+				pthread_mutex_unlock(&transfer->lock);
+				break;
+		}
+
+		if (removed <= 0)
+		{
+			sched_yield();
+			continue;
+		}
+
+		for (i = 0; i < removed; i++)
+			sum += elements[i];
+
+		if (__atomic_add_fetch(&transfer->consumed, (size_t)removed, __ATOMIC_RELAXED) == TRANSFERS && transfer->mode == MODE_BLOCKING)
+			nds_concurrent_queue_close(transfer->queue);
+	}
+
+	__atomic_add_fetch(&transfer->sum, sum, __ATOMIC_RELAXED);
+
+	return NULL;
+}
+
+
+static void run_transfer(NdsBench *bench, enum Mode mode)
+{
+	pthread_t producers[MAX_THREADS], consumers[MAX_THREADS];
+	struct Transfer transfer;
+	size_t i;
+
+	transfer.mode = mode;
+	transfer.queue = nds_concurrent_queue_new_with_allocator(sizeof(uint64_t), CAPACITY, mode == MODE_BLOCKING, &bench->allocator);
+	transfer.locked_queue = nds_queue_new_with_allocator(sizeof(uint64_t), CAPACITY, &bench->allocator);
+	transfer.produced = TRANSFERS;
+	transfer.consumed = 0;
+	transfer.sum = 0;
+	pthread_mutex_init(&transfer.lock, NULL);
+
+	if (transfer.queue && transfer.locked_queue)
+	{
+		nds_bench_start(bench);
+
+		for (i = 0; i < threads; i++)
+		{
+			pthread_create(&consumers[i], NULL, consumer_main, &transfer);
+			pthread_create(&producers[i], NULL, producer_main, &transfer);
+		}
+
+		for (i = 0; i < threads; i++)
+		{
+			pthread_join(producers[i], NULL);
+			pthread_join(consumers[i], NULL);
+		}
+
+		nds_bench_stop(bench, TRANSFERS);
+	}
+
+	nds_bench_use(&transfer.sum);
+	pthread_mutex_destroy(&transfer.lock);
+	nds_queue_destroy(transfer.locked_queue);
+	nds_concurrent_queue_destroy(transfer.queue);
+}
+
+
+static void bench_try(NdsBench *bench)
+{
+	run_transfer(bench, MODE_TRY);
+}
+
+
+static void bench_batch(NdsBench *bench)
+{
+	run_transfer(bench, MODE_BATCH);
+}
+
+
+static void bench_blocking(NdsBench *bench)
+{
+	run_transfer(bench, MODE_BLOCKING);
+}
+
+
+static void bench_mutex(NdsBench *bench)
+{
+	run_transfer(bench, MODE_MUTEX);
+}
+
+
+void nds_concurrent_queue_bench(void)
+{
+	static const size_t counts[] = { 1, 2, 4, 8 };
+	static const char *try_names[] = { "concurrent_queue/try/1", "concurrent_queue/try/2", "concurrent_queue/try/4", "concurrent_queue/try/8" };
+	static const char *batch_names[] = { "concurrent_queue/batch/1", "concurrent_queue/batch/2", "concurrent_queue/batch/4", "concurrent_queue/batch/8" };
+	static const char *blocking_names[] = { "concurrent_queue/blocking/1", "concurrent_queue/blocking/2", "concurrent_queue/blocking/4", "concurrent_queue/blocking/8" };
+	static const char *mutex_names[] = { "concurrent_queue/mutex/1", "concurrent_queue/mutex/2", "concurrent_queue/mutex/4", "concurrent_queue/mutex/8" };
+	size_t i;
+
+	for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+	{
+		threads = counts[i];
+
+		nds_bench_run(try_names[i], sizeof(uint64_t), CAPACITY, bench_try);
+		nds_bench_run(batch_names[i], sizeof(uint64_t), CAPACITY, bench_batch);
+		nds_bench_run(blocking_names[i], sizeof(uint64_t), CAPACITY, bench_blocking);
+		nds_bench_run(mutex_names[i], sizeof(uint64_t), CAPACITY, bench_mutex);
+	}
+}
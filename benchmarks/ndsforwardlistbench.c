@@ -0,0 +1,299 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the forward list benchmarks of nds_bench. The linked
+ * structures hold an 8 byte integer and the number of elements is the
+ * number of structures in the list. The intrusive NdsForwardList is
+ * compared with a list that allocates a node pointing to the structure
+ * for every insertion, which is what a container that does not live inside
+ * the structures has to do.
+ *
+ * The concurrent cases recycle the structures of a free list: every thread
+ * (the last part of the case name is their number) pops a structure, uses
+ * it and pushes it back, through the lock-free NdsConcurrentForwardList and
+ * through an NdsForwardList guarded by a mutex.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ndsbench.h"
+
+#include <nds/ndsforwardlist.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/* number of operations of every case */
+#define OPERATIONS 2000000
+
+/* largest number of threads of a case and number of structures they share */
+#define MAX_THREADS 8
+#define TOKENS 64
+
+
+struct Item
+{
+	NdsForwardLink link;
+	uint64_t value;
+};
+
+
+/* node of the list that does not live inside the structures */
+struct PointerNode
+{
+	struct PointerNode *next;
+	struct Item *item;
+};
+
+
+/* state shared by the threads of a concurrent case */
+struct Recycle
+{
+	int locked;
+	NdsConcurrentForwardList *list;
+	NdsForwardList *locked_list;
+	pthread_mutex_t lock;
+	size_t operations;
+};
+
+
+/* number of threads of the next case, set before the case forks */
+static size_t threads = 0;
+
+
+/* appends to a queue of elements structures and removes from its front */
+static void bench_fifo(NdsBench *bench)
+{
+	NdsForwardList *list = nds_forward_list_new_with_allocator(&bench->allocator);
+	struct Item *items = (struct Item*)malloc(bench->elements * sizeof(struct Item));
+	struct Item *item;
+	uint64_t sum = 0;
+	size_t i;
+
+	if (list && items)
+	{
+		for (i = 0; i < bench->elements; i++)
+		{
+			items[i].value = i;
+			nds_forward_list_push_back(list, &items[i].link);
+		}
+
+		nds_bench_start(bench);
+		for (i = 0; i < OPERATIONS; i++)
+		{
+			item = NDS_CONTAINER_OF(nds_forward_list_pop_front(list), struct Item, link);
+			sum += item->value;
+			nds_forward_list_push_back(list, &item->link);
+		}
+		nds_bench_stop(bench, OPERATIONS);
+	}
+
+	nds_bench_use(&sum);
+	free(items);
+	nds_forward_list_destroy(list);
+}
+
+
+static void bench_pointer_fifo(NdsBench *bench)
+{
+	struct Item *items = (struct Item*)malloc(bench->elements * sizeof(struct Item));
+	struct PointerNode *first = NULL, *last = NULL, *node;
+	struct Item *item;
+	uint64_t sum = 0;
+	size_t i;
+
+	if (items)
+	{
+		for (i = 0; i < bench->elements + OPERATIONS; i++)
+		{
+			/* the first elements pushes fill the list, the next ones push back what was just popped */
+			if (i < bench->elements)
+			{
+				items[i].value = i;
+				item = &items[i];
+			}
+			else
+			{
+				if (i == bench->elements)
+					nds_bench_start(bench);
+
+				node = first;
+				first = node->next;
+				if (!first)
+					last = NULL;
+
+				item = node->item;
+				free(node);
+				sum += item->value;
+			}
+
+			node = (struct PointerNode*)malloc(sizeof(struct PointerNode));
+			node->item = item;
+			node->next = NULL;
+
+			if (last)
+				last->next = node;
+			else
+				first = node;
+
+			last = node;
+			nds_bench_count_allocation(bench);
+		}
+		nds_bench_stop(bench, OPERATIONS);
+	}
+
+	while (first)
+	{
+		node = first;
+		first = node->next;
+		free(node);
+	}
+
+	nds_bench_use(&sum);
+	free(items);
+}
+
+
+static void* recycle_main(void *context)
+{
+	struct Recycle *recycle = (struct Recycle*)context;
+	NdsForwardLink *link;
+	size_t i;
+
+	for (i = 0; i < recycle->operations; i++)
+	{
+		if (recycle->locked)
+		{
+			pthread_mutex_lock(&recycle->lock);
+			link = nds_forward_list_pop_front(recycle->locked_list);
+			pthread_mutex_unlock(&recycle->lock);
+		}
+		else
+			link = nds_concurrent_forward_list_pop_front(recycle->list);
+
+		/* the threads may share the processor, so we give the owners of the structures the chance to push them back */
+		if (!link)
+		{
+			sched_yield();
+			continue;
+		}
+
+		NDS_CONTAINER_OF(link, struct Item, link)->value++;
+
+		if (recycle->locked)
+		{
+			pthread_mutex_lock(&recycle->lock);
+			nds_forward_list_push_front(recycle->locked_list, link);
+			pthread_mutex_unlock(&recycle->lock);
+		}
+		else
+			nds_concurrent_forward_list_push_front(recycle->list, link);
+	}
+
+	return NULL;
+}
+
+
+static void run_recycle(NdsBench *bench, int locked)
+{
+	pthread_t workers[MAX_THREADS];
+	struct Item items[TOKENS];
+	struct Recycle recycle;
+	size_t i;
+
+	recycle.locked = locked;
+	recycle.list = nds_concurrent_forward_list_new_with_allocator(&bench->allocator);
+	recycle.locked_list = nds_forward_list_new_with_allocator(&bench->allocator);
+	recycle.operations = OPERATIONS / threads;
+	pthread_mutex_init(&recycle.lock, NULL);
+
+	if (recycle.list && recycle.locked_list)
+	{
+		for (i = 0; i < TOKENS; i++)
+		{
+			items[i].value = 0;
+
+			if (locked)
+				nds_forward_list_push_front(recycle.locked_list, &items[i].link);
+			else
+				nds_concurrent_forward_list_push_front(recycle.list, &items[i].link);
+		}
+
+		nds_bench_start(bench);
+
+		for (i = 0; i < threads; i++)
+			pthread_create(&workers[i], NULL, recycle_main, &recycle);
+
+		for (i = 0; i < threads; i++)
+			pthread_join(workers[i], NULL);
+
+		nds_bench_stop(bench, recycle.operations * threads);
+	}
+
+	pthread_mutex_destroy(&recycle.lock);
+	nds_forward_list_destroy(recycle.locked_list);
+	nds_concurrent_forward_list_destroy(recycle.list);
+}
+
+
+static void bench_recycle(NdsBench *bench)
+{
+	run_recycle(bench, 0);
+}
+
+
+static void bench_mutex_recycle(NdsBench *bench)
+{
+	run_recycle(bench, 1);
+}
+
+
+void nds_forward_list_bench(void)
+{
+	static const size_t sizes[] = { 1000, 1000000 };
+	static const size_t counts[] = { 1, 2, 4, 8 };
+	static const char *recycle_names[] = { "concurrent_forward_list/recycle/1", "concurrent_forward_list/recycle/2",
+		"concurrent_forward_list/recycle/4", "concurrent_forward_list/recycle/8" };
+	static const char *mutex_names[] = { "concurrent_forward_list/mutex/1", "concurrent_forward_list/mutex/2",
+		"concurrent_forward_list/mutex/4", "concurrent_forward_list/mutex/8" };
+	size_t i;
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+	{
+		nds_bench_run("forward_list/fifo", sizeof(struct Item), sizes[i], bench_fifo);
+		nds_bench_run("pointer_forward_list/fifo", sizeof(struct Item), sizes[i], bench_pointer_fifo);
+	}
+
+	for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+	{
+		threads = counts[i];
+
+		nds_bench_run(recycle_names[i], sizeof(struct Item), TOKENS, bench_recycle);
+		nds_bench_run(mutex_names[i], sizeof(struct Item), TOKENS, bench_mutex_recycle);
+	}
+}
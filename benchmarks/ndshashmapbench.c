@@ -0,0 +1,336 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the hash map benchmarks of nds_bench. The maps have 8
+ * byte integer keys and values and the number of elements is the number of
+ * pairs in the map. The lookups go through a fixed pseudo random list of
+ * keys, and the NdsHashMap is compared with a chained hash table that
+ * allocates a node per pair.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndsbench.h"
+
+#include <nds/ndshashmap.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/* number of lookups done by the find cases */
+#define LOOKUPS 10000000
+
+/* number of keys in the list the lookups cycle through (a power of two) */
+#define LOOKUP_KEYS 65536
+
+
+/* node of the chained hash table used as a baseline */
+struct ChainedNode
+{
+	uint64_t key;
+	uint64_t value;
+	struct ChainedNode *next;
+};
+
+struct ChainedTable
+{
+	struct ChainedNode **buckets;
+	size_t mask;
+};
+
+
+/* the n-th key of the maps, distinct for every n */
+static uint64_t bench_key(uint64_t n)
+{
+	return nds_hash_mix(n + 1);
+}
+
+
+/* the same hash as the default one of the map, called through a pointer */
+static uint64_t callback_hash(const void *key)
+{
+	return nds_hash_mix(*(const uint64_t*)key);
+}
+
+
+static int callback_equal(const void *first, const void *second)
+{
+	return *(const uint64_t*)first == *(const uint64_t*)second;
+}
+
+
+/* fills a map with the first elements keys, optionally with the callbacks */
+static NdsHashMap* hash_map_new(NdsBench *bench, int callbacks)
+{
+	NdsHashMap *map;
+	uint64_t key, i;
+
+	map = nds_hash_map_new_with_allocator(sizeof(uint64_t), sizeof(uint64_t), callbacks ? callback_hash : NULL, callbacks ? callback_equal : NULL, bench->elements,
+		&bench->allocator);
+	if (!map)
+		return NULL;
+
+	for (i = 0; i < bench->elements; i++)
+	{
+		key = bench_key(i);
+		nds_hash_map_insert(map, &key, &i);
+	}
+
+	return map;
+}
+
+
+/* picks the keys the lookups cycle through, among the first inserted keys or outside of them */
+static uint64_t* lookup_keys_new(uint64_t inserted, int hits)
+{
+	uint64_t *keys = (uint64_t*)malloc(LOOKUP_KEYS * sizeof(uint64_t));
+	uint32_t state = 1;
+	size_t i;
+
+	if (!keys)
+		return NULL;
+
+	for (i = 0; i < LOOKUP_KEYS; i++)
+	{
+		state = state * 1103515245u + 12345u;
+		keys[i] = bench_key(hits ? state % inserted : inserted + state);
+	}
+
+	return keys;
+}
+
+
+static void run_find(NdsBench *bench, int hits, int callbacks)
+{
+	NdsHashMap *map = hash_map_new(bench, callbacks);
+	uint64_t *keys = lookup_keys_new(bench->elements, hits), sum = 0;
+	uint64_t *value;
+	size_t i;
+
+	if (map && keys)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < LOOKUPS; i++)
+		{
+			value = (uint64_t*)nds_hash_map_find(map, &keys[i & (LOOKUP_KEYS - 1)]);
+			sum += value ? *value : 1;
+		}
+		nds_bench_stop(bench, LOOKUPS);
+	}
+
+	nds_bench_use(&sum);
+	free(keys);
+	nds_hash_map_destroy(map);
+}
+
+
+static void bench_find_hit(NdsBench *bench)
+{
+	run_find(bench, 1, 0);
+}
+
+
+static void bench_find_miss(NdsBench *bench)
+{
+	run_find(bench, 0, 0);
+}
+
+
+static void bench_find_callback(NdsBench *bench)
+{
+	run_find(bench, 1, 1);
+}
+
+
+/**
+ * Misses on a map filled up to its capacity, right before it would grow,
+ * where the runs of used slots a miss has to scan are the longest.
+ */
+static void bench_find_miss_full(NdsBench *bench)
+{
+	NdsHashMap *map = nds_hash_map_new_with_allocator(sizeof(uint64_t), sizeof(uint64_t), NULL, NULL, bench->elements, &bench->allocator);
+	uint64_t *keys, key, sum = 0, i, capacity;
+	uint64_t *value;
+
+	if (!map)
+		return;
+
+	capacity = (uint64_t)nds_hash_map_capacity(map);
+	for (i = 0; i < capacity; i++)
+	{
+		key = bench_key(i);
+		nds_hash_map_insert(map, &key, &i);
+	}
+
+	keys = lookup_keys_new(capacity, 0);
+
+	if (keys && nds_hash_map_capacity(map) == (ssize_t)capacity)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < LOOKUPS; i++)
+		{
+			value = (uint64_t*)nds_hash_map_find(map, &keys[i & (LOOKUP_KEYS - 1)]);
+			sum += value ? *value : 1;
+		}
+		nds_bench_stop(bench, LOOKUPS);
+	}
+
+	nds_bench_use(&sum);
+	free(keys);
+	nds_hash_map_destroy(map);
+}
+
+
+static void bench_insert(NdsBench *bench)
+{
+	NdsHashMap *map = nds_hash_map_new_with_allocator(sizeof(uint64_t), sizeof(uint64_t), NULL, NULL, 1, &bench->allocator);
+	uint64_t key, i;
+
+	if (!map)
+		return;
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++)
+	{
+		key = bench_key(i);
+		nds_hash_map_insert(map, &key, &i);
+	}
+	nds_bench_stop(bench, bench->elements);
+
+	nds_hash_map_destroy(map);
+}
+
+
+static void bench_insert_reserved(NdsBench *bench)
+{
+	NdsHashMap *map = nds_hash_map_new_with_allocator(sizeof(uint64_t), sizeof(uint64_t), NULL, NULL, bench->elements, &bench->allocator);
+	uint64_t key, i;
+
+	if (!map)
+		return;
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++)
+	{
+		key = bench_key(i);
+		nds_hash_map_insert(map, &key, &i);
+	}
+	nds_bench_stop(bench, bench->elements);
+
+	nds_hash_map_destroy(map);
+}
+
+
+static void bench_remove(NdsBench *bench)
+{
+	NdsHashMap *map = hash_map_new(bench, 0);
+	uint64_t key, i;
+
+	if (!map)
+		return;
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++)
+	{
+		key = bench_key(i);
+		nds_hash_map_remove(map, &key, NULL);
+	}
+	nds_bench_stop(bench, bench->elements);
+
+	nds_hash_map_destroy(map);
+}
+
+
+static struct ChainedNode** chained_find(struct ChainedTable *table, uint64_t key)
+{
+	struct ChainedNode **node = &table->buckets[nds_hash_mix(key) & table->mask];
+
+	while (*node && (*node)->key != key)
+		node = &(*node)->next;
+
+	return node;
+}
+
+
+static void bench_chained_find_hit(NdsBench *bench)
+{
+	uint64_t *keys = lookup_keys_new(bench->elements, 1), sum = 0;
+	struct ChainedNode **node;
+	struct ChainedTable table;
+	size_t buckets = 16, i;
+
+	/* one bucket per pair at most, like the load factor of 1 of std::unordered_map */
+	while (buckets < bench->elements)
+		buckets *= 2;
+
+	table.buckets = (struct ChainedNode**)calloc(buckets, sizeof(struct ChainedNode*));
+	table.mask = buckets - 1;
+
+	if (keys && table.buckets)
+	{
+		for (i = 0; i < bench->elements; i++)
+		{
+			node = chained_find(&table, bench_key(i));
+			*node = (struct ChainedNode*)malloc(sizeof(struct ChainedNode));
+			(*node)->key = bench_key(i);
+			(*node)->value = i;
+			(*node)->next = NULL;
+			nds_bench_count_allocation(bench);
+		}
+
+		nds_bench_start(bench);
+		for (i = 0; i < LOOKUPS; i++)
+		{
+			node = chained_find(&table, keys[i & (LOOKUP_KEYS - 1)]);
+			sum += *node ? (*node)->value : 1;
+		}
+		nds_bench_stop(bench, LOOKUPS);
+	}
+
+	nds_bench_use(&sum);
+	free(keys);
+
+	/* the nodes are released with the process of the case */
+	free(table.buckets);
+}
+
+
+void nds_hash_map_bench(void)
+{
+	static const size_t sizes[] = { 1000, 100000, 1000000 };
+	size_t i;
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+	{
+		nds_bench_run("hash_map/find_hit", sizeof(uint64_t), sizes[i], bench_find_hit);
+		nds_bench_run("hash_map/find_miss", sizeof(uint64_t), sizes[i], bench_find_miss);
+		nds_bench_run("hash_map/find_miss_full", sizeof(uint64_t), sizes[i], bench_find_miss_full);
+		nds_bench_run("hash_map/find_callback", sizeof(uint64_t), sizes[i], bench_find_callback);
+		nds_bench_run("chained/find_hit", sizeof(uint64_t), sizes[i], bench_chained_find_hit);
+	}
+
+	nds_bench_run("hash_map/insert", sizeof(uint64_t), 1000000, bench_insert);
+	nds_bench_run("hash_map/insert_reserved", sizeof(uint64_t), 1000000, bench_insert_reserved);
+	nds_bench_run("hash_map/remove", sizeof(uint64_t), 1000000, bench_remove);
+}
@@ -0,0 +1,259 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the hash set benchmarks of nds_bench. The sets have 8
+ * byte integer elements and the number of elements is the number of
+ * elements in the set. The single and the batched operations go through the
+ * same pseudo random list of elements, so the cases show what overlapping
+ * the cache misses of a batch is worth once the set no longer fits in the
+ * cache.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndsbench.h"
+
+#include <nds/ndshashset.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/* number of lookups done by the contains cases */
+#define LOOKUPS 10000000
+
+/* number of elements in the list the lookups cycle through (a power of two) */
+#define LOOKUP_ELEMENTS 65536
+
+
+/* the n-th element of the sets, distinct for every n */
+static uint64_t bench_element(uint64_t n)
+{
+	return nds_hash_mix(n + 1);
+}
+
+
+/* fills a set with the first count elements */
+static NdsHashSet* hash_set_new(NdsBench *bench, size_t count)
+{
+	NdsHashSet *set;
+	uint64_t element, i;
+
+	set = nds_hash_set_new_with_allocator(sizeof(uint64_t), NULL, NULL, count, &bench->allocator);
+	if (!set)
+		return NULL;
+
+	for (i = 0; i < count; i++)
+	{
+		element = bench_element(i);
+		nds_hash_set_insert(set, &element);
+	}
+
+	return set;
+}
+
+
+/* an array of count pseudo random elements, half of them in a set of the given size */
+static uint64_t* elements_new(size_t count, size_t size)
+{
+	uint64_t *elements = (uint64_t*)malloc(count * sizeof(uint64_t));
+	uint32_t state = 1;
+	size_t i;
+
+	if (!elements)
+		return NULL;
+
+	for (i = 0; i < count; i++)
+	{
+		state = state * 1103515245u + 12345u;
+		elements[i] = bench_element(i % 2 ? state % size : size + state);
+	}
+
+	return elements;
+}
+
+
+static void bench_contains(NdsBench *bench)
+{
+	NdsHashSet *set = hash_set_new(bench, bench->elements);
+	uint64_t *elements = elements_new(LOOKUP_ELEMENTS, bench->elements);
+	size_t i, found = 0;
+
+	if (set && elements)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < LOOKUPS; i++)
+			found += (size_t)nds_hash_set_contains(set, &elements[i & (LOOKUP_ELEMENTS - 1)]);
+		nds_bench_stop(bench, LOOKUPS);
+	}
+
+	nds_bench_use(&found);
+	free(elements);
+	nds_hash_set_destroy(set);
+}
+
+
+static void bench_contains_batch(NdsBench *bench)
+{
+	NdsHashSet *set = hash_set_new(bench, bench->elements);
+	uint64_t *elements = elements_new(LOOKUP_ELEMENTS, bench->elements);
+	size_t i, found = 0;
+
+	if (set && elements)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < LOOKUPS; i += LOOKUP_ELEMENTS)
+			found += (size_t)nds_hash_set_contains_batch(set, elements, LOOKUP_ELEMENTS, NULL);
+		nds_bench_stop(bench, i);
+	}
+
+	nds_bench_use(&found);
+	free(elements);
+	nds_hash_set_destroy(set);
+}
+
+
+/* inserts elements that repeat every other time, so half of the insertions find their element */
+static void bench_insert(NdsBench *bench)
+{
+	NdsHashSet *set = nds_hash_set_new_with_allocator(sizeof(uint64_t), NULL, NULL, bench->elements, &bench->allocator);
+	uint64_t *elements = elements_new(bench->elements, bench->elements);
+	size_t i;
+
+	if (set && elements)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < bench->elements; i++)
+			nds_hash_set_insert(set, &elements[i]);
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	free(elements);
+	nds_hash_set_destroy(set);
+}
+
+
+static void bench_insert_batch(NdsBench *bench)
+{
+	NdsHashSet *set = nds_hash_set_new_with_allocator(sizeof(uint64_t), NULL, NULL, bench->elements, &bench->allocator);
+	uint64_t *elements = elements_new(bench->elements, bench->elements);
+
+	if (set && elements)
+	{
+		nds_bench_start(bench);
+		nds_hash_set_insert_batch(set, elements, bench->elements, NULL);
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	free(elements);
+	nds_hash_set_destroy(set);
+}
+
+
+static void bench_new_from_vector(NdsBench *bench)
+{
+	NdsVector *vector = nds_vector_new_with_capacity(sizeof(uint64_t), bench->elements);
+	uint64_t element, i;
+	NdsHashSet *set = NULL;
+
+	if (vector)
+	{
+		for (i = 0; i < bench->elements; i++)
+		{
+			element = bench_element(i);
+			nds_vector_push_back(vector, &element);
+		}
+
+		nds_bench_start(bench);
+		set = nds_hash_set_new_from_vector(vector, NULL, NULL);
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	nds_hash_set_destroy(set);
+	nds_vector_destroy(vector);
+}
+
+
+/* the second set holds every other element of the first one and as many others */
+static void run_algebra(NdsBench *bench, NdsHashSet* (*operation)(NdsHashSet*, NdsHashSet*))
+{
+	NdsHashSet *first = hash_set_new(bench, bench->elements);
+	NdsHashSet *second = nds_hash_set_new_with_allocator(sizeof(uint64_t), NULL, NULL, bench->elements, &bench->allocator);
+	NdsHashSet *result = NULL;
+	uint64_t element, i;
+
+	if (first && second)
+	{
+		for (i = 0; i < bench->elements; i++)
+		{
+			element = bench_element(i % 2 ? i - 1 : bench->elements + i);
+			nds_hash_set_insert(second, &element);
+		}
+
+		nds_bench_start(bench);
+		result = operation(first, second);
+		nds_bench_stop(bench, 2 * bench->elements);
+	}
+
+	nds_hash_set_destroy(result);
+	nds_hash_set_destroy(second);
+	nds_hash_set_destroy(first);
+}
+
+
+static void bench_union(NdsBench *bench)
+{
+	run_algebra(bench, nds_hash_set_union);
+}
+
+
+static void bench_intersection(NdsBench *bench)
+{
+	run_algebra(bench, nds_hash_set_intersection);
+}
+
+
+static void bench_difference(NdsBench *bench)
+{
+	run_algebra(bench, nds_hash_set_difference);
+}
+
+
+void nds_hash_set_bench(void)
+{
+	static const size_t sizes[] = { 1000, 100000, 1000000 };
+	size_t i;
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+	{
+		nds_bench_run("hash_set/contains", sizeof(uint64_t), sizes[i], bench_contains);
+		nds_bench_run("hash_set/contains_batch", sizeof(uint64_t), sizes[i], bench_contains_batch);
+	}
+
+	nds_bench_run("hash_set/insert", sizeof(uint64_t), 1000000, bench_insert);
+	nds_bench_run("hash_set/insert_batch", sizeof(uint64_t), 1000000, bench_insert_batch);
+	nds_bench_run("hash_set/new_from_vector", sizeof(uint64_t), 1000000, bench_new_from_vector);
+	nds_bench_run("hash_set/union", sizeof(uint64_t), 1000000, bench_union);
+	nds_bench_run("hash_set/intersection", sizeof(uint64_t), 1000000, bench_intersection);
+	nds_bench_run("hash_set/difference", sizeof(uint64_t), 1000000, bench_difference);
+}
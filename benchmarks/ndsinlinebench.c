@@ -0,0 +1,120 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file measures the cost of the NdsVector accessors and element API.
+ * It is built twice: once against the shared library and once against the
+ * static library with NDS_INLINE_FAST_PATH and link-time optimization, so
+ * the two runs show what inlining the container into the loops is worth.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <nds/ndsvector.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+/* number of elements pushed in the vector and number of accessor calls */
+#define ELEMENTS 10000000
+#define CALLS 100000000
+
+
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+
+int main()
+{
+	NdsVector *vector;
+	volatile long sink = 0;
+	long sum = 0;
+	double start;
+	int i, element;
+
+#ifdef NDS_INLINE_FAST_PATH
+	const char *mode = "static library, inline fast path";
+#else
+	const char *mode = "shared library";
+#endif
+
+	vector = nds_vector_new(sizeof(int));
+	if (!vector)
+	{
+		printf("Error during NdsVector creation!\n");
+		return 1;
+	}
+
+	printf("NdsVector accessors (%s)\n", mode);
+
+	start = now_ns();
+	for (i = 0; i < ELEMENTS; i++)
+		nds_vector_push_back(vector, &i);
+	printf("  nds_vector_push_back    %6.2f ns/op\n", (now_ns() - start) / ELEMENTS);
+
+	start = now_ns();
+	for (i = 0; i < nds_vector_size(vector); i++)
+	{
+		nds_vector_get(vector, i, &element);
+		sum += element;
+	}
+	sink = sum;
+	printf("  nds_vector_get          %6.2f ns/op\n", (now_ns() - start) / ELEMENTS);
+
+	start = now_ns();
+	for (i = 0; i < nds_vector_size(vector); i++)
+	{
+		element = -i;
+		nds_vector_set(vector, i, &element);
+	}
+	printf("  nds_vector_set          %6.2f ns/op\n", (now_ns() - start) / ELEMENTS);
+
+	sum = 0;
+	start = now_ns();
+	for (i = 0; i < CALLS; i++)
+		sum += nds_vector_size(vector) + nds_vector_capacity(vector) + nds_vector_is_empty(vector);
+	sink = sum;
+	printf("  size/capacity/is_empty  %6.2f ns/op\n", (now_ns() - start) / CALLS);
+
+	start = now_ns();
+	while (nds_vector_pop_back(vector, &element) == NDS_OK)
+		sum += element;
+	sink = sum;
+	printf("  nds_vector_pop_back     %6.2f ns/op\n", (now_ns() - start) / ELEMENTS);
+
+	(void)sink;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return 0;
+}
@@ -0,0 +1,398 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the list benchmarks of nds_bench. The elements are 8
+ * byte integers and the number of elements is the length of the list. The
+ * NdsList, with one element per node and unrolled, is compared with a
+ * pointer based doubly-linked list that allocates every node with malloc(),
+ * the layout of std::list.
+ *
+ * The lists iterated by the benchmarks are built the way lists are built in
+ * programs: together with another list, so that the two take turns at the
+ * allocator, and then churned by removing half of the elements and
+ * appending new ones. After that the nodes of the pointer list are spread
+ * over the heap in no particular order.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndsbench.h"
+
+#include <nds/ndslist.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/* node capacity of the lists of the next case, set before the case forks */
+static size_t node_capacity = 1;
+
+
+struct PointerNode
+{
+	struct PointerNode *next;
+	struct PointerNode *prev;
+	uint64_t value;
+};
+
+
+struct PointerList
+{
+	struct PointerNode *head;
+	struct PointerNode *tail;
+};
+
+
+/* the n-th pseudo random element */
+static uint64_t bench_element(uint64_t n)
+{
+	return nds_hash_mix(n + 1);
+}
+
+
+static void sum_element(void *element, void *context)
+{
+	*(uint64_t*)context += *(uint64_t*)element;
+}
+
+
+static NdsList* list_new(NdsBench *bench)
+{
+	return nds_list_new_with_allocator(sizeof(uint64_t), node_capacity, &bench->allocator);
+}
+
+
+/* fills the list and a second one in turns, then removes half of the elements and appends as many new ones */
+static NdsList* list_build(NdsBench *bench)
+{
+	NdsList *list = list_new(bench), *other = list_new(bench);
+	NdsListIterator iterator;
+	uint64_t element, i;
+
+	if (!list || !other)
+	{
+		nds_list_destroy(list);
+		nds_list_destroy(other);
+
+		return NULL;
+	}
+
+	for (i = 0; i < bench->elements; i++)
+	{
+		element = bench_element(i);
+		nds_list_push_back(list, &element);
+		nds_list_push_back(other, &element);
+	}
+
+	for (i = 0, nds_list_first(list, &iterator); iterator.element != NULL; i++)
+	{
+		if (bench_element(i) & 1)
+			nds_list_erase(list, &iterator, NULL);
+		else
+			nds_list_iterator_next(&iterator);
+	}
+
+	for (i = (uint64_t)nds_list_size(list); i < bench->elements; i++)
+	{
+		element = bench_element(i);
+		nds_list_push_back(list, &element);
+	}
+
+	nds_list_destroy(other);
+
+	return list;
+}
+
+
+static void bench_push_back(NdsBench *bench)
+{
+	NdsList *list = list_new(bench);
+	uint64_t element, i;
+
+	if (list)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < bench->elements; i++)
+		{
+			element = i;
+			nds_list_push_back(list, &element);
+		}
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	nds_list_destroy(list);
+}
+
+
+static void bench_iterate(NdsBench *bench)
+{
+	NdsList *list = list_build(bench);
+	NdsListIterator iterator;
+	uint64_t sum = 0;
+	int found;
+
+	if (list)
+	{
+		nds_bench_start(bench);
+		for (found = nds_list_first(list, &iterator); found == 1; found = nds_list_iterator_next(&iterator))
+			sum += *(uint64_t*)iterator.element;
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	nds_bench_use(&sum);
+	nds_list_destroy(list);
+}
+
+
+static void bench_for_each(NdsBench *bench)
+{
+	NdsList *list = list_build(bench);
+	uint64_t sum = 0;
+
+	if (list)
+	{
+		nds_bench_start(bench);
+		nds_list_for_each(list, sum_element, &sum);
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	nds_bench_use(&sum);
+	nds_list_destroy(list);
+}
+
+
+/* walks the list once, erasing every other element and inserting a new one before each of the others */
+static void bench_insert_erase(NdsBench *bench)
+{
+	NdsList *list = list_build(bench);
+	NdsListIterator iterator;
+	uint64_t element, i;
+
+	if (list)
+	{
+		nds_bench_start(bench);
+		for (i = 0, nds_list_first(list, &iterator); iterator.element != NULL; i++)
+		{
+			if (i & 1)
+				nds_list_erase(list, &iterator, NULL);
+			else
+			{
+				element = i;
+				nds_list_insert(list, &iterator, &element);
+				nds_list_iterator_next(&iterator);
+				nds_list_iterator_next(&iterator);
+			}
+		}
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	nds_list_destroy(list);
+}
+
+
+static void pointer_push_back(NdsBench *bench, struct PointerList *list, uint64_t value)
+{
+	struct PointerNode *node = (struct PointerNode*)malloc(sizeof(struct PointerNode));
+
+	node->value = value;
+	node->next = NULL;
+	node->prev = list->tail;
+
+	if (list->tail)
+		list->tail->next = node;
+	else
+		list->head = node;
+
+	list->tail = node;
+	nds_bench_count_allocation(bench);
+}
+
+
+/* unlinks and frees the node, returning the node after it */
+static struct PointerNode* pointer_erase(struct PointerList *list, struct PointerNode *node)
+{
+	struct PointerNode *next = node->next;
+
+	if (node->prev)
+		node->prev->next = next;
+	else
+		list->head = next;
+
+	if (next)
+		next->prev = node->prev;
+	else
+		list->tail = node->prev;
+
+	free(node);
+
+	return next;
+}
+
+
+static void pointer_insert(NdsBench *bench, struct PointerList *list, struct PointerNode *before, uint64_t value)
+{
+	struct PointerNode *node = (struct PointerNode*)malloc(sizeof(struct PointerNode));
+
+	node->value = value;
+	node->next = before;
+	node->prev = before->prev;
+
+	if (before->prev)
+		before->prev->next = node;
+	else
+		list->head = node;
+
+	before->prev = node;
+	nds_bench_count_allocation(bench);
+}
+
+
+static void pointer_destroy(struct PointerList *list)
+{
+	while (list->head)
+		pointer_erase(list, list->head);
+}
+
+
+/* the same construction as list_build() */
+static void pointer_build(NdsBench *bench, struct PointerList *list)
+{
+	struct PointerList other = { NULL, NULL };
+	struct PointerNode *node;
+	uint64_t i, size = 0;
+
+	for (i = 0; i < bench->elements; i++)
+	{
+		pointer_push_back(bench, list, bench_element(i));
+		pointer_push_back(bench, &other, bench_element(i));
+	}
+
+	for (i = 0, node = list->head; node; i++)
+	{
+		if (bench_element(i) & 1)
+			node = pointer_erase(list, node);
+		else
+		{
+			node = node->next;
+			size++;
+		}
+	}
+
+	for (i = size; i < bench->elements; i++)
+		pointer_push_back(bench, list, bench_element(i));
+
+	pointer_destroy(&other);
+}
+
+
+static void bench_pointer_push_back(NdsBench *bench)
+{
+	struct PointerList list = { NULL, NULL };
+	uint64_t i;
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++)
+		pointer_push_back(bench, &list, i);
+	nds_bench_stop(bench, bench->elements);
+
+	pointer_destroy(&list);
+}
+
+
+static void bench_pointer_iterate(NdsBench *bench)
+{
+	struct PointerList list = { NULL, NULL };
+	struct PointerNode *node;
+	uint64_t sum = 0;
+
+	pointer_build(bench, &list);
+
+	nds_bench_start(bench);
+	for (node = list.head; node; node = node->next)
+		sum += node->value;
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(&sum);
+	pointer_destroy(&list);
+}
+
+
+static void bench_pointer_insert_erase(NdsBench *bench)
+{
+	struct PointerList list = { NULL, NULL };
+	struct PointerNode *node;
+	uint64_t i;
+
+	pointer_build(bench, &list);
+
+	nds_bench_start(bench);
+	for (i = 0, node = list.head; node; i++)
+	{
+		if (i & 1)
+			node = pointer_erase(&list, node);
+		else
+		{
+			pointer_insert(bench, &list, node, i);
+			node = node->next;
+		}
+	}
+	nds_bench_stop(bench, bench->elements);
+
+	pointer_destroy(&list);
+}
+
+
+void nds_list_bench(void)
+{
+	static const size_t sizes[] = { 1000, 1000000 };
+	static const size_t node_capacities[] = { 1, 0 };
+	static const char *push_back_names[] = { "list/push_back", "unrolled_list/push_back" };
+	static const char *iterate_names[] = { "list/iterate", "unrolled_list/iterate" };
+	static const char *for_each_names[] = { "list/for_each", "unrolled_list/for_each" };
+	static const char *insert_erase_names[] = { "list/insert_erase", "unrolled_list/insert_erase" };
+	size_t i, j;
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+	{
+		for (j = 0; j < sizeof(node_capacities) / sizeof(node_capacities[0]); j++)
+		{
+			node_capacity = node_capacities[j];
+
+			nds_bench_run(iterate_names[j], sizeof(uint64_t), sizes[i], bench_iterate);
+			nds_bench_run(for_each_names[j], sizeof(uint64_t), sizes[i], bench_for_each);
+		}
+
+		nds_bench_run("pointer_list/iterate", sizeof(uint64_t), sizes[i], bench_pointer_iterate);
+	}
+
+	for (j = 0; j < sizeof(node_capacities) / sizeof(node_capacities[0]); j++)
+	{
+		node_capacity = node_capacities[j];
+
+		nds_bench_run(push_back_names[j], sizeof(uint64_t), 1000000, bench_push_back);
+		nds_bench_run(insert_erase_names[j], sizeof(uint64_t), 1000000, bench_insert_erase);
+	}
+
+	nds_bench_run("pointer_list/push_back", sizeof(uint64_t), 1000000, bench_pointer_push_back);
+	nds_bench_run("pointer_list/insert_erase", sizeof(uint64_t), 1000000, bench_pointer_insert_erase);
+}
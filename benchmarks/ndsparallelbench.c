@@ -0,0 +1,226 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the parallel benchmarks of nds_bench. The parallel
+ * algorithms of NdsVector run with 1, 2, 4 and 8 threads (the number is the
+ * last part of the case name) and are compared with a sequential loop over
+ * the same elements.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndsbench.h"
+
+#include <nds/ndsscheduler.h>
+#include <nds/ndsvector.h>
+
+#include <stdint.h>
+#include <string.h>
+
+
+/* number of elements of the vectors */
+#define ELEMENTS 4000000
+
+
+static void scale_element(void *element, void *context)
+{
+	(void)context;
+
+	*(uint32_t*)element = *(uint32_t*)element * 3 + 1;
+}
+
+
+static void add_element(void *accumulator, const void *value, void *context)
+{
+	(void)context;
+
+	*(uint64_t*)accumulator += *(const uint32_t*)value;
+}
+
+
+static void add_partial(void *accumulator, const void *value, void *context)
+{
+	(void)context;
+
+	*(uint64_t*)accumulator += *(const uint64_t*)value;
+}
+
+
+static int compare_element(const void *first, const void *second)
+{
+	uint32_t a = *(const uint32_t*)first, b = *(const uint32_t*)second;
+
+	return (a > b) - (a < b);
+}
+
+
+static NdsVector* parallel_vector_new(NdsBench *bench)
+{
+	NdsVector *vector;
+	uint32_t state = 1;
+	size_t i;
+
+	vector = nds_vector_new_with_allocator(sizeof(uint32_t), bench->elements, &bench->allocator);
+	if (!vector)
+		return NULL;
+
+	for (i = 0; i < bench->elements; i++)
+	{
+		state = state * 1103515245u + 12345u;
+		nds_vector_push_back(vector, &state);
+	}
+
+	return vector;
+}
+
+
+static void bench_parallel_for_each(NdsBench *bench)
+{
+	NdsVector *vector = parallel_vector_new(bench);
+
+	if (!vector)
+		return;
+
+	nds_bench_start(bench);
+	nds_vector_parallel_for_each(vector, scale_element, NULL);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(nds_vector_data(vector));
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_serial_for_each(NdsBench *bench)
+{
+	NdsVector *vector = parallel_vector_new(bench);
+	char *element;
+	size_t i;
+
+	if (!vector)
+		return;
+	element = (char*)nds_vector_data(vector);
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++, element += sizeof(uint32_t))
+		scale_element(element, NULL);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(nds_vector_data(vector));
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_parallel_reduce(NdsBench *bench)
+{
+	NdsVector *vector = parallel_vector_new(bench);
+	uint64_t sum = 0;
+
+	if (!vector)
+		return;
+
+	nds_bench_start(bench);
+	nds_vector_parallel_reduce(vector, &sum, sizeof(sum), add_element, add_partial, NULL);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(&sum);
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_serial_reduce(NdsBench *bench)
+{
+	NdsVector *vector = parallel_vector_new(bench);
+	const char *element;
+	uint64_t sum = 0;
+	size_t i;
+
+	if (!vector)
+		return;
+	element = (const char*)nds_vector_data(vector);
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++, element += sizeof(uint32_t))
+		add_element(&sum, element, NULL);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(&sum);
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_parallel_sort(NdsBench *bench)
+{
+	NdsVector *vector = parallel_vector_new(bench);
+
+	if (!vector)
+		return;
+
+	nds_bench_start(bench);
+	nds_vector_parallel_sort(vector, compare_element);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(nds_vector_data(vector));
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_serial_sort(NdsBench *bench)
+{
+	NdsVector *vector = parallel_vector_new(bench);
+
+	if (!vector)
+		return;
+
+	nds_bench_start(bench);
+	nds_vector_stable_sort(vector, compare_element);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(nds_vector_data(vector));
+	nds_vector_destroy(vector);
+}
+
+
+void nds_parallel_bench(void)
+{
+	static const size_t workers[] = { 1, 2, 4, 8 };
+	static const char *for_each_names[] = { "parallel/for_each/1", "parallel/for_each/2", "parallel/for_each/4", "parallel/for_each/8" };
+	static const char *reduce_names[] = { "parallel/reduce/1", "parallel/reduce/2", "parallel/reduce/4", "parallel/reduce/8" };
+	static const char *sort_names[] = { "parallel/sort/1", "parallel/sort/2", "parallel/sort/4", "parallel/sort/8" };
+	size_t i;
+
+	nds_bench_run("serial/for_each", sizeof(uint32_t), ELEMENTS, bench_serial_for_each);
+	nds_bench_run("serial/reduce", sizeof(uint32_t), ELEMENTS, bench_serial_reduce);
+	nds_bench_run("serial/sort", sizeof(uint32_t), ELEMENTS, bench_serial_sort);
+
+	/* the worker count is set before the cases fork, so every case starts its own workers */
+	for (i = 0; i < sizeof(workers) / sizeof(workers[0]); i++)
+	{
+		nds_set_worker_count(workers[i]);
+
+		nds_bench_run(for_each_names[i], sizeof(uint32_t), ELEMENTS, bench_parallel_for_each);
+		nds_bench_run(reduce_names[i], sizeof(uint32_t), ELEMENTS, bench_parallel_reduce);
+		nds_bench_run(sort_names[i], sizeof(uint32_t), ELEMENTS, bench_parallel_sort);
+	}
+
+	nds_set_worker_count(0);
+}
@@ -0,0 +1,221 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the priority queue benchmarks of nds_bench. The
+ * elements are 8 byte integers with pseudo random values and the number of
+ * elements is the size of the heap. Every case runs with a binary heap and
+ * with heaps of arity 4 and 8 (the last part of the case name), built by the
+ * same code, so the cases show what the arity is worth.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndsbench.h"
+
+#include <nds/ndspriorityqueue.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/* number of operations of the push_pop and update cases */
+#define OPERATIONS 2000000
+
+
+/* arity of the heaps of the next case, set before the case forks */
+static size_t arity = 0;
+
+
+static int element_compare(const void *first, const void *second)
+{
+	uint64_t a = *(const uint64_t*)first, b = *(const uint64_t*)second;
+
+	return (a > b) - (a < b);
+}
+
+
+/* the n-th pseudo random element */
+static uint64_t bench_element(uint64_t n)
+{
+	return nds_hash_mix(n + 1) >> 16;
+}
+
+
+/* a queue of the case's arity holding the first count elements */
+static NdsPriorityQueue* queue_new(NdsBench *bench, size_t count, int indexed)
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new_with_allocator(sizeof(uint64_t), element_compare, arity, count, indexed, &bench->allocator);
+	uint64_t element, i;
+
+	if (!queue)
+		return NULL;
+
+	for (i = 0; i < count; i++)
+	{
+		element = bench_element(i);
+		nds_priority_queue_push(queue, &element);
+	}
+
+	return queue;
+}
+
+
+/* pops the lowest element and pushes a larger one, like a scheduler that moves its jobs forward in time */
+static void bench_push_pop(NdsBench *bench)
+{
+	NdsPriorityQueue *queue = queue_new(bench, bench->elements, 0);
+	uint64_t element, i;
+
+	if (queue)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < OPERATIONS; i++)
+		{
+			nds_priority_queue_pop(queue, &element);
+			element += bench_element(i) >> 24;
+			nds_priority_queue_push(queue, &element);
+		}
+		nds_bench_stop(bench, OPERATIONS);
+	}
+
+	nds_priority_queue_destroy(queue);
+}
+
+
+/* pushes all the elements one by one and pops them all */
+static void bench_push_all(NdsBench *bench)
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new_with_allocator(sizeof(uint64_t), element_compare, arity, bench->elements, 0, &bench->allocator);
+	uint64_t element, sum = 0, i;
+
+	if (queue)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < bench->elements; i++)
+		{
+			element = bench_element(i);
+			nds_priority_queue_push(queue, &element);
+		}
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	nds_bench_use(&sum);
+	nds_priority_queue_destroy(queue);
+}
+
+
+static void bench_pop_all(NdsBench *bench)
+{
+	NdsPriorityQueue *queue = queue_new(bench, bench->elements, 0);
+	uint64_t element, sum = 0, i;
+
+	if (queue)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < bench->elements; i++)
+		{
+			nds_priority_queue_pop(queue, &element);
+			sum += element;
+		}
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	nds_bench_use(&sum);
+	nds_priority_queue_destroy(queue);
+}
+
+
+/* builds the heap from all the elements at once (Floyd) */
+static void bench_push_n(NdsBench *bench)
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new_with_allocator(sizeof(uint64_t), element_compare, arity, bench->elements, 0, &bench->allocator);
+	uint64_t *elements = (uint64_t*)malloc(bench->elements * sizeof(uint64_t));
+	size_t i;
+
+	if (queue && elements)
+	{
+		for (i = 0; i < bench->elements; i++)
+			elements[i] = bench_element(i);
+
+		nds_bench_start(bench);
+		nds_priority_queue_push_n(queue, elements, bench->elements);
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	free(elements);
+	nds_priority_queue_destroy(queue);
+}
+
+
+/* lowers the keys of random elements of an indexed queue, like the relaxation step of Dijkstra's algorithm */
+static void bench_decrease_key(NdsBench *bench)
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new_with_allocator(sizeof(uint64_t), element_compare, arity, bench->elements, 1, &bench->allocator);
+	uint64_t element, i;
+	size_t handle;
+
+	if (queue)
+	{
+		for (i = 0; i < bench->elements; i++)
+		{
+			element = bench_element(i) + ((uint64_t)1 << 48);
+			nds_priority_queue_insert(queue, &element, &handle);
+		}
+
+		nds_bench_start(bench);
+		for (i = 0; i < OPERATIONS; i++)
+		{
+			handle = (size_t)(bench_element(i) % bench->elements);
+			nds_priority_queue_get(queue, handle, &element);
+			element -= element >> 4;
+			nds_priority_queue_update(queue, handle, &element);
+		}
+		nds_bench_stop(bench, OPERATIONS);
+	}
+
+	nds_priority_queue_destroy(queue);
+}
+
+
+void nds_priority_queue_bench(void)
+{
+	static const size_t arities[] = { 2, 4, 8 };
+	static const char *push_pop_names[] = { "priority_queue/push_pop/2", "priority_queue/push_pop/4", "priority_queue/push_pop/8" };
+	static const char *push_all_names[] = { "priority_queue/push_all/2", "priority_queue/push_all/4", "priority_queue/push_all/8" };
+	static const char *pop_all_names[] = { "priority_queue/pop_all/2", "priority_queue/pop_all/4", "priority_queue/pop_all/8" };
+	static const char *push_n_names[] = { "priority_queue/push_n/2", "priority_queue/push_n/4", "priority_queue/push_n/8" };
+	static const char *decrease_key_names[] = { "priority_queue/decrease_key/2", "priority_queue/decrease_key/4", "priority_queue/decrease_key/8" };
+	size_t i;
+
+	for (i = 0; i < sizeof(arities) / sizeof(arities[0]); i++)
+	{
+		arity = arities[i];
+
+		nds_bench_run(push_pop_names[i], sizeof(uint64_t), 1000, bench_push_pop);
+		nds_bench_run(push_pop_names[i], sizeof(uint64_t), 1000000, bench_push_pop);
+		nds_bench_run(push_all_names[i], sizeof(uint64_t), 1000000, bench_push_all);
+		nds_bench_run(pop_all_names[i], sizeof(uint64_t), 1000000, bench_pop_all);
+		nds_bench_run(push_n_names[i], sizeof(uint64_t), 1000000, bench_push_n);
+		nds_bench_run(decrease_key_names[i], sizeof(uint64_t), 1000000, bench_decrease_key);
+	}
+}
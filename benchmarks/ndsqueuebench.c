@@ -0,0 +1,240 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the queue benchmarks of nds_bench. The elements are 8
+ * byte integers. The NdsQueue cases keep the given number of elements in
+ * the queue while they enqueue and dequeue, one by one or in batches, and
+ * the grow case fills an empty queue. The NdsSpscQueue cases move elements
+ * from a producer thread to the consumer thread through a queue that fits
+ * the given number of elements, one by one or in batches.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ndsbench.h"
+
+#include <nds/ndsqueue.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+
+/* number of elements that go through the queue in every case */
+#define TRANSFERS 10000000
+
+/* number of elements of a batch in the batched cases */
+#define BATCH 64
+
+
+/* arguments of the producer thread of the NdsSpscQueue cases */
+struct Producer
+{
+	NdsSpscQueue *queue;
+	size_t batch;
+};
+
+
+/* fills a queue with count elements */
+static NdsQueue* queue_new(NdsBench *bench, size_t count)
+{
+	NdsQueue *queue = nds_queue_new_with_allocator(sizeof(uint64_t), count, &bench->allocator);
+	uint64_t i;
+
+	if (!queue)
+		return NULL;
+
+	for (i = 0; i < count; i++)
+		nds_queue_enqueue(queue, &i);
+
+	return queue;
+}
+
+
+static void bench_enqueue_dequeue(NdsBench *bench)
+{
+	NdsQueue *queue = queue_new(bench, bench->elements);
+	uint64_t i, element, sum = 0;
+
+	if (queue)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < TRANSFERS; i++)
+		{
+			nds_queue_enqueue(queue, &i);
+			nds_queue_dequeue(queue, &element);
+			sum += element;
+		}
+		nds_bench_stop(bench, TRANSFERS);
+	}
+
+	nds_bench_use(&sum);
+	nds_queue_destroy(queue);
+}
+
+
+static void bench_enqueue_dequeue_n(NdsBench *bench)
+{
+	NdsQueue *queue = queue_new(bench, bench->elements);
+	uint64_t elements[BATCH], i, j, sum = 0;
+
+	if (queue)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < TRANSFERS; i += BATCH)
+		{
+			for (j = 0; j < BATCH; j++)
+				elements[j] = i + j;
+
+			nds_queue_enqueue_n(queue, elements, BATCH);
+			nds_queue_dequeue_n(queue, elements, BATCH);
+
+			for (j = 0; j < BATCH; j++)
+				sum += elements[j];
+		}
+		nds_bench_stop(bench, i);
+	}
+
+	nds_bench_use(&sum);
+	nds_queue_destroy(queue);
+}
+
+
+/* the queue starts with the default capacity, so the case includes every growth */
+static void bench_grow(NdsBench *bench)
+{
+	NdsQueue *queue = nds_queue_new_with_allocator(sizeof(uint64_t), 0, &bench->allocator);
+	uint64_t i;
+
+	if (queue)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < bench->elements; i++)
+			nds_queue_enqueue(queue, &i);
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	nds_queue_destroy(queue);
+}
+
+
+/* enqueues 0, 1, ..., TRANSFERS - 1 and gives up the processor whenever the queue is full */
+static void* producer_main(void *context)
+{
+	struct Producer *producer = (struct Producer*)context;
+	uint64_t elements[BATCH], next = 0, j;
+	ssize_t added;
+
+	while (next < TRANSFERS)
+	{
+		if (producer->batch == 1)
+		{
+			added = nds_spsc_queue_try_enqueue(producer->queue, &next);
+		}
+		else
+		{
+			for (j = 0; j < BATCH; j++)
+				elements[j] = next + j;
+			added = nds_spsc_queue_enqueue_n(producer->queue, elements, TRANSFERS - next < BATCH ? TRANSFERS - next : BATCH);
+		}
+
+		if (added <= 0)
+			sched_yield();
+		else
+			next += (uint64_t)added;
+	}
+
+	return NULL;
+}
+
+
+/* the consumer runs in the thread of the case, so the time includes starting and joining the producer */
+static void run_transfer(NdsBench *bench, size_t batch)
+{
+	NdsSpscQueue *queue = nds_spsc_queue_new_with_allocator(sizeof(uint64_t), bench->elements, &bench->allocator);
+	uint64_t elements[BATCH], received = 0, sum = 0;
+	struct Producer producer;
+	pthread_t thread;
+	ssize_t removed, j;
+
+	if (queue)
+	{
+		producer.queue = queue;
+		producer.batch = batch;
+
+		nds_bench_start(bench);
+		pthread_create(&thread, NULL, producer_main, &producer);
+
+		while (received < TRANSFERS)
+		{
+			removed = nds_spsc_queue_dequeue_n(queue, elements, batch);
+			if (removed == 0)
+				sched_yield();
+
+			for (j = 0; j < removed; j++)
+				sum += elements[j];
+			received += (uint64_t)removed;
+		}
+
+		pthread_join(thread, NULL);
+		nds_bench_stop(bench, TRANSFERS);
+	}
+
+	nds_bench_use(&sum);
+	nds_spsc_queue_destroy(queue);
+}
+
+
+static void bench_spsc_transfer(NdsBench *bench)
+{
+	run_transfer(bench, 1);
+}
+
+
+static void bench_spsc_transfer_n(NdsBench *bench)
+{
+	run_transfer(bench, BATCH);
+}
+
+
+void nds_queue_bench(void)
+{
+	static const size_t sizes[] = { 16, 1000, 1000000 };
+	size_t i;
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+	{
+		nds_bench_run("queue/enqueue_dequeue", sizeof(uint64_t), sizes[i], bench_enqueue_dequeue);
+		nds_bench_run("queue/enqueue_dequeue_n", sizeof(uint64_t), sizes[i], bench_enqueue_dequeue_n);
+	}
+
+	nds_bench_run("queue/grow", sizeof(uint64_t), 10000000, bench_grow);
+
+	for (i = 0; i < 2; i++)
+	{
+		nds_bench_run("spsc_queue/transfer", sizeof(uint64_t), sizes[i + 1], bench_spsc_transfer);
+		nds_bench_run("spsc_queue/transfer_n", sizeof(uint64_t), sizes[i + 1], bench_spsc_transfer_n);
+	}
+}
@@ -0,0 +1,284 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the scheduler benchmarks of nds_bench. They measure
+ * fine-grained fork/join recursion, a parallel quicksort of an NdsVector and
+ * a naive Fibonacci, with 1, 2, 4 and 8 threads (the number is the last part
+ * of the case name). The serial cases run the same recursion without
+ * spawning any task.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndsbench.h"
+
+#include <nds/ndsscheduler.h>
+#include <nds/ndsvector.h>
+
+#include <stdint.h>
+
+
+/* number of elements of the sorted vectors */
+#define ELEMENTS 4000000
+
+/* subarrays that are not larger than this are sorted without spawning tasks, or with an insertion sort */
+#define QUICKSORT_CUTOFF 512
+#define INSERTION_CUTOFF 16
+
+/* the Fibonacci number computed by the fibonacci cases and the size under which it runs serially */
+#define FIBONACCI_N 30
+#define FIBONACCI_CUTOFF 12
+
+
+/* number of worker threads used by the next case, set before the case forks */
+static size_t threads = 0;
+
+/* arguments of a quicksort task */
+struct QuicksortTask
+{
+	NdsScheduler *scheduler;
+	uint32_t *elements;
+	size_t size;
+};
+
+/* arguments and result of a Fibonacci task */
+struct FibonacciTask
+{
+	NdsScheduler *scheduler;
+	unsigned int n;
+	uint64_t result;
+};
+
+
+static void insertion_sort(uint32_t *elements, size_t size)
+{
+	size_t i, j;
+
+	for (i = 1; i < size; i++)
+	{
+		uint32_t element = elements[i];
+
+		for (j = i; j > 0 && elements[j - 1] > element; j--)
+			elements[j] = elements[j - 1];
+		elements[j] = element;
+	}
+}
+
+
+/* Hoare partition around the median of the first, middle and last element, returns the size of the left part */
+static size_t partition(uint32_t *elements, size_t size)
+{
+	uint32_t a = elements[0], b = elements[size / 2], c = elements[size - 1];
+	uint32_t pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+	size_t i = 0, j = size - 1;
+
+	for (;;)
+	{
+		uint32_t swap;
+
+		while (elements[i] < pivot)
+			i++;
+		while (elements[j] > pivot)
+			j--;
+
+		if (i >= j)
+			return j + 1;
+
+		swap = elements[i];
+		elements[i++] = elements[j];
+		elements[j--] = swap;
+	}
+}
+
+
+/* sorts a subarray, spawning the left part as a task when a scheduler is given */
+static void quicksort_task(void *context)
+{
+	struct QuicksortTask *arguments = (struct QuicksortTask*)context;
+	uint32_t *elements = arguments->elements;
+	size_t size = arguments->size;
+
+	while (size > INSERTION_CUTOFF)
+	{
+		size_t left = partition(elements, size);
+		struct QuicksortTask child;
+		NdsTask task;
+
+		child.scheduler = arguments->scheduler;
+		child.elements = elements;
+		child.size = left;
+
+		if (arguments->scheduler && size > QUICKSORT_CUTOFF && nds_task_spawn(arguments->scheduler, &task, quicksort_task, &child) == NDS_OK)
+		{
+			struct QuicksortTask right = *arguments;
+
+			right.elements = elements + left;
+			right.size = size - left;
+			quicksort_task(&right);
+			nds_task_wait(arguments->scheduler, &task);
+			return;
+		}
+
+		quicksort_task(&child);
+		elements += left;
+		size -= left;
+	}
+
+	insertion_sort(elements, size);
+}
+
+
+static void fibonacci_task(void *context)
+{
+	struct FibonacciTask *arguments = (struct FibonacciTask*)context;
+	struct FibonacciTask first, second;
+	NdsTask task;
+
+	if (arguments->n < 2)
+	{
+		arguments->result = arguments->n;
+		return;
+	}
+
+	first = *arguments;
+	first.n = arguments->n - 1;
+	second = *arguments;
+	second.n = arguments->n - 2;
+
+	if (arguments->scheduler && arguments->n > FIBONACCI_CUTOFF && nds_task_spawn(arguments->scheduler, &task, fibonacci_task, &first) == NDS_OK)
+	{
+		fibonacci_task(&second);
+		nds_task_wait(arguments->scheduler, &task);
+	}
+	else
+	{
+		fibonacci_task(&first);
+		fibonacci_task(&second);
+	}
+
+	arguments->result = first.result + second.result;
+}
+
+
+static void run_quicksort(NdsBench *bench, NdsScheduler *scheduler)
+{
+	NdsVector *vector = nds_vector_new_with_allocator(sizeof(uint32_t), bench->elements, &bench->allocator);
+	struct QuicksortTask task;
+	uint32_t state = 1;
+	size_t i;
+
+	if (!vector)
+		return;
+
+	for (i = 0; i < bench->elements; i++)
+	{
+		state = state * 1103515245u + 12345u;
+		nds_vector_push_back(vector, &state);
+	}
+
+	task.scheduler = scheduler;
+	task.elements = (uint32_t*)nds_vector_data(vector);
+	task.size = bench->elements;
+
+	nds_bench_start(bench);
+	quicksort_task(&task);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(nds_vector_data(vector));
+	nds_vector_destroy(vector);
+}
+
+
+static void run_fibonacci(NdsBench *bench, NdsScheduler *scheduler)
+{
+	struct FibonacciTask task;
+
+	task.scheduler = scheduler;
+	task.n = FIBONACCI_N;
+
+	/* one operation is one call of the recursion, there are 2 * fib(n + 1) - 1 of them */
+	nds_bench_start(bench);
+	fibonacci_task(&task);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(&task.result);
+}
+
+
+static void bench_serial_quicksort(NdsBench *bench)
+{
+	run_quicksort(bench, NULL);
+}
+
+
+static void bench_scheduler_quicksort(NdsBench *bench)
+{
+	/* the thread that runs the case works too, so it is not counted in the scheduler */
+	NdsScheduler *scheduler = nds_scheduler_new(threads - 1);
+
+	if (!scheduler)
+		return;
+
+	run_quicksort(bench, scheduler);
+	nds_scheduler_destroy(scheduler);
+}
+
+
+static void bench_serial_fibonacci(NdsBench *bench)
+{
+	run_fibonacci(bench, NULL);
+}
+
+
+static void bench_scheduler_fibonacci(NdsBench *bench)
+{
+	NdsScheduler *scheduler = nds_scheduler_new(threads - 1);
+
+	if (!scheduler)
+		return;
+
+	run_fibonacci(bench, scheduler);
+	nds_scheduler_destroy(scheduler);
+}
+
+
+void nds_scheduler_bench(void)
+{
+	static const size_t workers[] = { 1, 2, 4, 8 };
+	static const char *quicksort_names[] = { "scheduler/quicksort/1", "scheduler/quicksort/2", "scheduler/quicksort/4", "scheduler/quicksort/8" };
+	static const char *fibonacci_names[] = { "scheduler/fibonacci/1", "scheduler/fibonacci/2", "scheduler/fibonacci/4", "scheduler/fibonacci/8" };
+	/* 2 * fib(31) - 1 calls of the recursion */
+	const size_t calls = 2 * 1346269 - 1;
+	size_t i;
+
+	nds_bench_run("scheduler/serial/quicksort", sizeof(uint32_t), ELEMENTS, bench_serial_quicksort);
+	nds_bench_run("scheduler/serial/fibonacci", sizeof(uint64_t), calls, bench_serial_fibonacci);
+
+	for (i = 0; i < sizeof(workers) / sizeof(workers[0]); i++)
+	{
+		threads = workers[i];
+
+		nds_bench_run(quicksort_names[i], sizeof(uint32_t), ELEMENTS, bench_scheduler_quicksort);
+		nds_bench_run(fibonacci_names[i], sizeof(uint64_t), calls, bench_scheduler_fibonacci);
+	}
+}
@@ -0,0 +1,178 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the search benchmarks of nds_bench. nds_vector_find()
+ * and nds_vector_count() are compared with a scalar loop that compares the
+ * elements one by one with memcmp(). The searched element is missing, so
+ * every case scans the whole vector.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndsbench.h"
+
+#include <nds/ndsvector.h>
+
+#include <string.h>
+
+
+/* number of elements searched and number of times the vector is scanned */
+#define ELEMENTS 1000000
+#define SCANS 10
+
+/* the largest element size used by the cases */
+#define MAX_ELEMENT_SIZE 64
+
+
+/* fills a vector with elements whose bytes never take the value 0xff */
+static NdsVector* search_vector_new(NdsBench *bench)
+{
+	unsigned char element[MAX_ELEMENT_SIZE];
+	NdsVector *vector;
+	size_t i, k;
+
+	vector = nds_vector_new_with_allocator(bench->element_size, bench->elements, &bench->allocator);
+	if (!vector)
+		return NULL;
+
+	for (i = 0; i < bench->elements; i++)
+	{
+		for (k = 0; k < bench->element_size; k++)
+			element[k] = (unsigned char)((i + k) % 255);
+
+		nds_vector_push_back(vector, element);
+	}
+
+	return vector;
+}
+
+
+static void bench_search_find(NdsBench *bench)
+{
+	unsigned char missing[MAX_ELEMENT_SIZE];
+	NdsVector *vector = search_vector_new(bench);
+	size_t i;
+	ssize_t found = 0;
+
+	if (!vector)
+		return;
+	memset(missing, 0xff, sizeof(missing));
+
+	nds_bench_start(bench);
+	for (i = 0; i < SCANS; i++)
+		found += nds_vector_find(vector, missing);
+	nds_bench_stop(bench, SCANS * bench->elements);
+
+	nds_bench_use(&found);
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_scalar_find(NdsBench *bench)
+{
+	unsigned char missing[MAX_ELEMENT_SIZE];
+	NdsVector *vector = search_vector_new(bench);
+	const char *data;
+	size_t i, j;
+	ssize_t found = 0;
+
+	if (!vector)
+		return;
+	memset(missing, 0xff, sizeof(missing));
+	data = (const char*)nds_vector_data(vector);
+
+	nds_bench_start(bench);
+	for (i = 0; i < SCANS; i++)
+	{
+		for (j = 0; j < bench->elements; j++)
+			if (memcmp(data + j * bench->element_size, missing, bench->element_size) == 0)
+				break;
+
+		found += j < bench->elements ? (ssize_t)j : -1;
+	}
+	nds_bench_stop(bench, SCANS * bench->elements);
+
+	nds_bench_use(&found);
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_search_count(NdsBench *bench)
+{
+	unsigned char missing[MAX_ELEMENT_SIZE];
+	NdsVector *vector = search_vector_new(bench);
+	size_t i;
+	ssize_t count = 0;
+
+	if (!vector)
+		return;
+	memset(missing, 0xff, sizeof(missing));
+
+	nds_bench_start(bench);
+	for (i = 0; i < SCANS; i++)
+		count += nds_vector_count(vector, missing);
+	nds_bench_stop(bench, SCANS * bench->elements);
+
+	nds_bench_use(&count);
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_scalar_count(NdsBench *bench)
+{
+	unsigned char missing[MAX_ELEMENT_SIZE];
+	NdsVector *vector = search_vector_new(bench);
+	const char *data;
+	size_t i, j, count = 0;
+
+	if (!vector)
+		return;
+	memset(missing, 0xff, sizeof(missing));
+	data = (const char*)nds_vector_data(vector);
+
+	nds_bench_start(bench);
+	for (i = 0; i < SCANS; i++)
+		for (j = 0; j < bench->elements; j++)
+			count += memcmp(data + j * bench->element_size, missing, bench->element_size) == 0;
+	nds_bench_stop(bench, SCANS * bench->elements);
+
+	nds_bench_use(&count);
+	nds_vector_destroy(vector);
+}
+
+
+void nds_search_bench(void)
+{
+	static const size_t element_sizes[] = { 1, 2, 4, 8, 36 };
+	size_t i;
+
+	for (i = 0; i < sizeof(element_sizes) / sizeof(element_sizes[0]); i++)
+	{
+		size_t size = element_sizes[i];
+
+		nds_bench_run("search/find", size, ELEMENTS, bench_search_find);
+		nds_bench_run("scalar/find", size, ELEMENTS, bench_scalar_find);
+		nds_bench_run("search/count", size, ELEMENTS, bench_search_count);
+		nds_bench_run("scalar/count", size, ELEMENTS, bench_scalar_count);
+	}
+}
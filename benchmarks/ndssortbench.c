@@ -0,0 +1,164 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the sort benchmarks of nds_bench. nds_vector_sort(),
+ * nds_vector_stable_sort() and nds_vector_radix_sort_by_key() are compared
+ * with qsort() from the C library on the same random input. The elements
+ * are ordered by a 32 bit integer key stored at their beginning.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndsbench.h"
+
+#include <nds/ndsvector.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* number of elements sorted */
+#define ELEMENTS 500000
+
+/* the largest element size used by the cases */
+#define MAX_ELEMENT_SIZE 64
+
+
+static int compare_key(const void *first, const void *second)
+{
+	int32_t a, b;
+
+	memcpy(&a, first, sizeof(a));
+	memcpy(&b, second, sizeof(b));
+
+	return (a > b) - (a < b);
+}
+
+
+/* fills a vector with elements whose keys come from a fixed pseudo random sequence */
+static NdsVector* sort_vector_new(NdsBench *bench)
+{
+	unsigned char element[MAX_ELEMENT_SIZE];
+	uint32_t state = 1;
+	int32_t key;
+	NdsVector *vector;
+	size_t i;
+
+	vector = nds_vector_new_with_allocator(bench->element_size, bench->elements, &bench->allocator);
+	if (!vector)
+		return NULL;
+
+	memset(element, 0, sizeof(element));
+	for (i = 0; i < bench->elements; i++)
+	{
+		state = state * 1103515245u + 12345u;
+		key = (int32_t)(state >> 1) - 0x40000000;
+
+		memcpy(element, &key, sizeof(key));
+		nds_vector_push_back(vector, element);
+	}
+
+	return vector;
+}
+
+
+static void bench_sort_pdqsort(NdsBench *bench)
+{
+	NdsVector *vector = sort_vector_new(bench);
+
+	if (!vector)
+		return;
+
+	nds_bench_start(bench);
+	nds_vector_sort(vector, compare_key);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(nds_vector_data(vector));
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_sort_stable(NdsBench *bench)
+{
+	NdsVector *vector = sort_vector_new(bench);
+
+	if (!vector)
+		return;
+
+	nds_bench_start(bench);
+	nds_vector_stable_sort(vector, compare_key);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(nds_vector_data(vector));
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_sort_radix(NdsBench *bench)
+{
+	NdsVector *vector = sort_vector_new(bench);
+
+	if (!vector)
+		return;
+
+	nds_bench_start(bench);
+	nds_vector_radix_sort_by_key(vector, 0, NDS_KEY_INT32);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(nds_vector_data(vector));
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_libc_qsort(NdsBench *bench)
+{
+	NdsVector *vector = sort_vector_new(bench);
+
+	if (!vector)
+		return;
+
+	nds_bench_start(bench);
+	qsort(nds_vector_data(vector), bench->elements, bench->element_size, compare_key);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(nds_vector_data(vector));
+	nds_vector_destroy(vector);
+}
+
+
+void nds_sort_bench(void)
+{
+	static const size_t element_sizes[] = { 4, 16, 36 };
+	size_t i;
+
+	for (i = 0; i < sizeof(element_sizes) / sizeof(element_sizes[0]); i++)
+	{
+		size_t size = element_sizes[i];
+
+		nds_bench_run("sort/pdqsort", size, ELEMENTS, bench_sort_pdqsort);
+		nds_bench_run("sort/stable", size, ELEMENTS, bench_sort_stable);
+		nds_bench_run("sort/radix", size, ELEMENTS, bench_sort_radix);
+		nds_bench_run("libc/qsort", size, ELEMENTS, bench_libc_qsort);
+	}
+}
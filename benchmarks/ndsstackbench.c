@@ -0,0 +1,230 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the stack benchmarks of nds_bench. The elements are 8
+ * byte integers. The push cases fill an empty NdsStack, and an NdsVector
+ * with nds_vector_push_back() for comparison, so they include every growth.
+ * The push_worst cases time every push of such a fill and report the
+ * slowest one as ns_per_op, which for the vector can be a growth that
+ * copies the whole buffer. The push_pop cases keep the stack at the end of a chunk
+ * while they push and pop, one by one or in batches, like a search that
+ * goes up and down around the same depth.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndsbench.h"
+
+#include <nds/ndsstack.h>
+#include <nds/ndsvector.h>
+
+#include <stdint.h>
+
+
+/* number of elements pushed and popped by the push_pop cases */
+#define TRANSFERS 10000000
+
+/* number of elements of a batch in the batched cases */
+#define BATCH 64
+
+
+static void bench_stack_push(NdsBench *bench)
+{
+	NdsStack *stack = nds_stack_new_with_allocator(sizeof(uint64_t), 0, &bench->allocator);
+	uint64_t i;
+
+	if (stack)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < bench->elements; i++)
+			nds_stack_push(stack, &i);
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	nds_stack_destroy(stack);
+}
+
+
+static void bench_vector_push(NdsBench *bench)
+{
+	NdsVector *vector = nds_vector_new_with_allocator(sizeof(uint64_t), 16, &bench->allocator);
+	uint64_t i;
+
+	if (vector)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < bench->elements; i++)
+			nds_vector_push_back(vector, &i);
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	nds_vector_destroy(vector);
+}
+
+
+/* the case reports the slowest push as its only operation */
+static void bench_stop_worst(NdsBench *bench, double worst_ns)
+{
+	nds_bench_stop(bench, 1);
+	bench->elapsed_ns = worst_ns;
+}
+
+
+static void bench_stack_push_worst(NdsBench *bench)
+{
+	NdsStack *stack = nds_stack_new_with_allocator(sizeof(uint64_t), 0, &bench->allocator);
+	double before, after, worst = 0;
+	uint64_t i;
+
+	if (stack)
+	{
+		nds_bench_start(bench);
+		before = nds_bench_now_ns();
+		for (i = 0; i < bench->elements; i++)
+		{
+			nds_stack_push(stack, &i);
+			after = nds_bench_now_ns();
+			if (after - before > worst)
+				worst = after - before;
+			before = after;
+		}
+		bench_stop_worst(bench, worst);
+	}
+
+	nds_stack_destroy(stack);
+}
+
+
+static void bench_vector_push_worst(NdsBench *bench)
+{
+	NdsVector *vector = nds_vector_new_with_allocator(sizeof(uint64_t), 16, &bench->allocator);
+	double before, after, worst = 0;
+	uint64_t i;
+
+	if (vector)
+	{
+		nds_bench_start(bench);
+		before = nds_bench_now_ns();
+		for (i = 0; i < bench->elements; i++)
+		{
+			nds_vector_push_back(vector, &i);
+			after = nds_bench_now_ns();
+			if (after - before > worst)
+				worst = after - before;
+			before = after;
+		}
+		bench_stop_worst(bench, worst);
+	}
+
+	nds_vector_destroy(vector);
+}
+
+
+/* fills a stack with count elements, with the first chunk as large as the stack, so the next push links a chunk */
+static NdsStack* stack_new(NdsBench *bench, size_t count)
+{
+	NdsStack *stack = nds_stack_new_with_allocator(sizeof(uint64_t), count, &bench->allocator);
+	uint64_t i;
+
+	if (!stack)
+		return NULL;
+
+	for (i = 0; i < count; i++)
+		nds_stack_push(stack, &i);
+
+	return stack;
+}
+
+
+static void bench_stack_push_pop(NdsBench *bench)
+{
+	NdsStack *stack = stack_new(bench, bench->elements);
+	uint64_t i, element, sum = 0;
+
+	if (stack)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < TRANSFERS; i++)
+		{
+			nds_stack_push(stack, &i);
+			nds_stack_pop(stack, &element);
+			nds_stack_pop(stack, &element);
+			sum += element;
+			nds_stack_push(stack, &i);
+		}
+		nds_bench_stop(bench, 4 * TRANSFERS);
+	}
+
+	nds_bench_use(&sum);
+	nds_stack_destroy(stack);
+}
+
+
+static void bench_stack_push_pop_n(NdsBench *bench)
+{
+	NdsStack *stack = stack_new(bench, bench->elements);
+	uint64_t elements[2 * BATCH], i, j, sum = 0;
+
+	if (stack)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < TRANSFERS; i += BATCH)
+		{
+			for (j = 0; j < BATCH; j++)
+				elements[j] = i + j;
+
+			nds_stack_push_n(stack, elements, BATCH);
+			nds_stack_pop_n(stack, elements, 2 * BATCH);
+
+			for (j = 0; j < 2 * BATCH; j++)
+				sum += elements[j];
+
+			nds_stack_push_n(stack, elements, BATCH);
+		}
+		nds_bench_stop(bench, 4 * i);
+	}
+
+	nds_bench_use(&sum);
+	nds_stack_destroy(stack);
+}
+
+
+void nds_stack_bench(void)
+{
+	static const size_t sizes[] = { 1000, 1000000, 64000000 };
+	size_t i;
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+	{
+		nds_bench_run("stack/push", sizeof(uint64_t), sizes[i], bench_stack_push);
+		nds_bench_run("vector_stack/push", sizeof(uint64_t), sizes[i], bench_vector_push);
+		nds_bench_run("stack/push_worst", sizeof(uint64_t), sizes[i], bench_stack_push_worst);
+		nds_bench_run("vector_stack/push_worst", sizeof(uint64_t), sizes[i], bench_vector_push_worst);
+	}
+
+	for (i = 0; i < 2; i++)
+	{
+		nds_bench_run("stack/push_pop", sizeof(uint64_t), sizes[i], bench_stack_push_pop);
+		nds_bench_run("stack/push_pop_n", sizeof(uint64_t), sizes[i], bench_stack_push_pop_n);
+	}
+}
@@ -0,0 +1,416 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the tree map benchmarks of nds_bench. The maps have 8
+ * byte integer keys and values and the number of elements is the number of
+ * pairs in the map. The NdsTreeMap is compared with a pointer based binary
+ * search tree with parent links, the layout of std::map, which allocates a
+ * node per pair. The pairs are inserted in random key order, so the depth of
+ * the binary tree stays close to the one of a red-black tree without the
+ * cost of rebalancing it.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndsbench.h"
+
+#include <nds/ndstreemap.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/* number of lookups done by the find cases */
+#define LOOKUPS 2000000
+
+/* number of keys in the list the lookups cycle through (a power of two) */
+#define LOOKUP_KEYS 65536
+
+/* number of pairs visited from every key of the scan cases */
+#define SCAN_LENGTH 100
+
+
+/* node of the binary search tree used as a baseline */
+struct PointerNode
+{
+	uint64_t key;
+	uint64_t value;
+	struct PointerNode *left;
+	struct PointerNode *right;
+	struct PointerNode *parent;
+};
+
+
+/* the n-th key of the maps, distinct for every n and in random order */
+static uint64_t bench_key(uint64_t n)
+{
+	return nds_hash_mix(n + 1);
+}
+
+
+static int callback_compare(const void *first, const void *second)
+{
+	uint64_t a = *(const uint64_t*)first, b = *(const uint64_t*)second;
+
+	return (a > b) - (a < b);
+}
+
+
+/* fills a map with the first elements keys, optionally ordered by a callback */
+static NdsTreeMap* tree_map_new(NdsBench *bench, int callbacks)
+{
+	NdsTreeMap *map;
+	uint64_t key, i;
+
+	if (callbacks)
+		map = nds_tree_map_new_with_allocator(sizeof(uint64_t), sizeof(uint64_t), callback_compare, &bench->allocator);
+	else
+		map = nds_tree_map_new_with_key_type(NDS_KEY_UINT64, sizeof(uint64_t), &bench->allocator);
+
+	if (!map)
+		return NULL;
+
+	for (i = 0; i < bench->elements; i++)
+	{
+		key = bench_key(i);
+		nds_tree_map_insert(map, &key, &i);
+	}
+
+	return map;
+}
+
+
+/* picks the keys the lookups cycle through among the inserted ones */
+static uint64_t* lookup_keys_new(NdsBench *bench)
+{
+	uint64_t *keys = (uint64_t*)malloc(LOOKUP_KEYS * sizeof(uint64_t));
+	uint32_t state = 1;
+	size_t i;
+
+	if (!keys)
+		return NULL;
+
+	for (i = 0; i < LOOKUP_KEYS; i++)
+	{
+		state = state * 1103515245u + 12345u;
+		keys[i] = bench_key(state % bench->elements);
+	}
+
+	return keys;
+}
+
+
+static void run_find(NdsBench *bench, int callbacks)
+{
+	NdsTreeMap *map = tree_map_new(bench, callbacks);
+	uint64_t *keys = lookup_keys_new(bench), sum = 0;
+	size_t i;
+
+	if (map && keys)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < LOOKUPS; i++)
+			sum += *(uint64_t*)nds_tree_map_find(map, &keys[i & (LOOKUP_KEYS - 1)]);
+		nds_bench_stop(bench, LOOKUPS);
+	}
+
+	nds_bench_use(&sum);
+	free(keys);
+	nds_tree_map_destroy(map);
+}
+
+
+static void bench_find(NdsBench *bench)
+{
+	run_find(bench, 0);
+}
+
+
+static void bench_find_callback(NdsBench *bench)
+{
+	run_find(bench, 1);
+}
+
+
+static void bench_insert(NdsBench *bench)
+{
+	NdsTreeMap *map = tree_map_new(bench, 0);
+
+	/* the map is filled by tree_map_new(), so the measure covers a second map */
+	nds_tree_map_destroy(map);
+
+	nds_bench_start(bench);
+	map = tree_map_new(bench, 0);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_tree_map_destroy(map);
+}
+
+
+static void bench_bulk_load(NdsBench *bench)
+{
+	NdsTreeMap *map = nds_tree_map_new_with_key_type(NDS_KEY_UINT64, sizeof(uint64_t), &bench->allocator);
+	NdsVector *vector = nds_vector_new_with_capacity(2 * sizeof(uint64_t), bench->elements);
+	uint64_t record[2], i;
+
+	if (map && vector)
+	{
+		for (i = 0; i < bench->elements; i++)
+		{
+			record[0] = bench_key(i);
+			record[1] = i;
+			nds_vector_push_back(vector, record);
+		}
+		nds_vector_radix_sort_by_key(vector, 0, NDS_KEY_UINT64);
+
+		nds_bench_start(bench);
+		nds_tree_map_bulk_load(map, vector, sizeof(uint64_t));
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	nds_vector_destroy(vector);
+	nds_tree_map_destroy(map);
+}
+
+
+static void bench_scan(NdsBench *bench)
+{
+	NdsTreeMap *map = tree_map_new(bench, 0);
+	uint64_t *keys = lookup_keys_new(bench), sum = 0;
+	NdsTreeMapIterator iterator;
+	size_t i, visited = 0;
+	int found, j;
+
+	if (map && keys)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < LOOKUP_KEYS; i++)
+			for (found = nds_tree_map_lower_bound(map, &keys[i], &iterator), j = 0; found == 1 && j < SCAN_LENGTH; found = nds_tree_map_iterator_next(&iterator), j++)
+			{
+				sum += *(uint64_t*)iterator.value;
+				visited++;
+			}
+		nds_bench_stop(bench, visited);
+	}
+
+	nds_bench_use(&sum);
+	free(keys);
+	nds_tree_map_destroy(map);
+}
+
+
+static void sum_value(const void *key, void *value, void *context)
+{
+	(void)key;
+
+	*(uint64_t*)context += *(uint64_t*)value;
+}
+
+
+static void bench_range_all(NdsBench *bench)
+{
+	NdsTreeMap *map = tree_map_new(bench, 0);
+	uint64_t sum = 0;
+
+	if (map)
+	{
+		nds_bench_start(bench);
+		nds_tree_map_range(map, NULL, NULL, sum_value, &sum);
+		nds_bench_stop(bench, bench->elements);
+	}
+
+	nds_bench_use(&sum);
+	nds_tree_map_destroy(map);
+}
+
+
+static void pointer_insert(NdsBench *bench, struct PointerNode **root, uint64_t key, uint64_t value)
+{
+	struct PointerNode **link = root, *parent = NULL;
+
+	while (*link && (*link)->key != key)
+	{
+		parent = *link;
+		link = key < parent->key ? &parent->left : &parent->right;
+	}
+
+	if (*link)
+	{
+		(*link)->value = value;
+		return;
+	}
+
+	*link = (struct PointerNode*)malloc(sizeof(struct PointerNode));
+	(*link)->key = key;
+	(*link)->value = value;
+	(*link)->left = NULL;
+	(*link)->right = NULL;
+	(*link)->parent = parent;
+	nds_bench_count_allocation(bench);
+}
+
+
+static struct PointerNode* pointer_lower_bound(struct PointerNode *node, uint64_t key)
+{
+	struct PointerNode *bound = NULL;
+
+	while (node)
+	{
+		if (node->key < key)
+			node = node->right;
+		else
+		{
+			bound = node;
+			node = node->left;
+		}
+	}
+
+	return bound;
+}
+
+
+static struct PointerNode* pointer_next(struct PointerNode *node)
+{
+	if (node->right)
+	{
+		for (node = node->right; node->left; node = node->left)
+			;
+
+		return node;
+	}
+
+	while (node->parent && node->parent->right == node)
+		node = node->parent;
+
+	return node->parent;
+}
+
+
+static struct PointerNode* pointer_tree_new(NdsBench *bench)
+{
+	struct PointerNode *root = NULL;
+	uint64_t i;
+
+	for (i = 0; i < bench->elements; i++)
+		pointer_insert(bench, &root, bench_key(i), i);
+
+	return root;
+}
+
+
+static void bench_pointer_find(NdsBench *bench)
+{
+	struct PointerNode *root = pointer_tree_new(bench), *node;
+	uint64_t *keys = lookup_keys_new(bench), sum = 0, key;
+	size_t i;
+
+	if (keys)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < LOOKUPS; i++)
+		{
+			key = keys[i & (LOOKUP_KEYS - 1)];
+			for (node = root; node->key != key; node = key < node->key ? node->left : node->right)
+				;
+			sum += node->value;
+		}
+		nds_bench_stop(bench, LOOKUPS);
+	}
+
+	nds_bench_use(&sum);
+	free(keys);
+
+	/* the nodes are released with the process of the case */
+}
+
+
+static void bench_pointer_insert(NdsBench *bench)
+{
+	struct PointerNode *root;
+
+	nds_bench_start(bench);
+	root = pointer_tree_new(bench);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(&root);
+}
+
+
+static void bench_pointer_scan(NdsBench *bench)
+{
+	struct PointerNode *root = pointer_tree_new(bench), *node;
+	uint64_t *keys = lookup_keys_new(bench), sum = 0;
+	size_t i, visited = 0;
+	int j;
+
+	if (keys)
+	{
+		nds_bench_start(bench);
+		for (i = 0; i < LOOKUP_KEYS; i++)
+			for (node = pointer_lower_bound(root, keys[i]), j = 0; node && j < SCAN_LENGTH; node = pointer_next(node), j++)
+			{
+				sum += node->value;
+				visited++;
+			}
+		nds_bench_stop(bench, visited);
+	}
+
+	nds_bench_use(&sum);
+	free(keys);
+}
+
+
+static void bench_pointer_range_all(NdsBench *bench)
+{
+	struct PointerNode *root = pointer_tree_new(bench), *node;
+	uint64_t sum = 0;
+
+	nds_bench_start(bench);
+	for (node = pointer_lower_bound(root, 0); node; node = pointer_next(node))
+		sum += node->value;
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(&sum);
+}
+
+
+void nds_tree_map_bench(void)
+{
+	static const size_t sizes[] = { 1000, 100000, 1000000 };
+	size_t i;
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+	{
+		nds_bench_run("tree_map/find", sizeof(uint64_t), sizes[i], bench_find);
+		nds_bench_run("tree_map/find_callback", sizeof(uint64_t), sizes[i], bench_find_callback);
+		nds_bench_run("pointer_tree/find", sizeof(uint64_t), sizes[i], bench_pointer_find);
+	}
+
+	nds_bench_run("tree_map/insert", sizeof(uint64_t), 1000000, bench_insert);
+	nds_bench_run("pointer_tree/insert", sizeof(uint64_t), 1000000, bench_pointer_insert);
+	nds_bench_run("tree_map/bulk_load", sizeof(uint64_t), 1000000, bench_bulk_load);
+	nds_bench_run("tree_map/scan_100", sizeof(uint64_t), 1000000, bench_scan);
+	nds_bench_run("pointer_tree/scan_100", sizeof(uint64_t), 1000000, bench_pointer_scan);
+	nds_bench_run("tree_map/range_all", sizeof(uint64_t), 1000000, bench_range_all);
+	nds_bench_run("pointer_tree/range_all", sizeof(uint64_t), 1000000, bench_pointer_range_all);
+}
@@ -0,0 +1,587 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the NdsVector benchmarks of nds_bench. Every case is
+ * run for each element size and next to a baseline that does the same work
+ * on a raw array managed with malloc()/realloc().
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndsbench.h"
+
+#include <nds/ndsvector.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+
+/* number of vectors created by the creation/destruction cases */
+#define CREATIONS 100000
+
+/* number of elements used by the growth and mixed cases */
+#define ELEMENTS 100000
+
+/* the incremental growth is quadratic, so it uses fewer elements */
+#define INCREMENTAL_ELEMENTS 10000
+
+/* number of elements appended at once by the bulk growth cases */
+#define BULK_BATCH 1024
+
+/* number of grow/truncate/shrink cycles of the shrink cases */
+#define SHRINK_CYCLES 64
+
+/* the largest element size used by the cases */
+#define MAX_ELEMENT_SIZE 256
+
+/* size in bytes from which the mapped cases move the elements to an anonymous mapping */
+#define MAPPED_THRESHOLD (64 * 1024)
+
+/* the example structure used throughout the library (36 bytes) */
+struct Person
+{
+	char name[30];
+	short age;
+	float height;
+};
+
+
+static void fill_element(char *element, size_t element_size, size_t seed)
+{
+	memset(element, (int)(seed & 0x7f), element_size);
+}
+
+
+static size_t next_random(size_t *state)
+{
+	*state = *state * 6364136223846793005UL + 1442695040888963407UL;
+
+	return *state >> 33;
+}
+
+
+/**
+ * Creation and destruction of vectors with the default capacity.
+ */
+static void bench_vector_create_destroy(NdsBench *bench)
+{
+	NdsVector *vector;
+	size_t i;
+
+	nds_bench_start(bench);
+	for (i = 0; i < CREATIONS; i++)
+	{
+		vector = nds_vector_new_with_allocator(bench->element_size, 10, &bench->allocator);
+		nds_bench_use(vector);
+		nds_vector_destroy(vector);
+	}
+	nds_bench_stop(bench, CREATIONS);
+}
+
+
+static void bench_raw_create_destroy(NdsBench *bench)
+{
+	char *array;
+	size_t i;
+
+	nds_bench_start(bench);
+	for (i = 0; i < CREATIONS; i++)
+	{
+		array = malloc(10 * bench->element_size);
+		nds_bench_count_allocation(bench);
+		nds_bench_use(array);
+		free(array);
+	}
+	nds_bench_stop(bench, CREATIONS);
+}
+
+
+/**
+ * Geometric growth: elements pushed one at a time into an empty vector.
+ */
+static void bench_vector_grow_geometric(NdsBench *bench)
+{
+	char element[MAX_ELEMENT_SIZE];
+	NdsVector *vector;
+	size_t i;
+
+	fill_element(element, bench->element_size, 1);
+	vector = nds_vector_new_with_allocator(bench->element_size, 1, &bench->allocator);
+	if (!vector)
+		return;
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++)
+		nds_vector_push_back(vector, element);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_raw_grow_geometric(NdsBench *bench)
+{
+	char element[MAX_ELEMENT_SIZE];
+	char *array, *grown;
+	size_t i, capacity = 1;
+
+	fill_element(element, bench->element_size, 1);
+	array = malloc(capacity * bench->element_size);
+	if (!array)
+		return;
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++)
+	{
+		if (i == capacity)
+		{
+			capacity *= 2;
+			grown = realloc(array, capacity * bench->element_size);
+			nds_bench_count_allocation(bench);
+			if (!grown)
+				break;
+			array = grown;
+		}
+		memcpy(array + i * bench->element_size, element, bench->element_size);
+	}
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(array);
+	free(array);
+}
+
+
+/**
+ * Incremental growth: the capacity is raised by one element before every
+ * push, which is the worst case for nds_vector_reserve().
+ */
+static void bench_vector_grow_incremental(NdsBench *bench)
+{
+	char element[MAX_ELEMENT_SIZE];
+	NdsVector *vector;
+	size_t i;
+
+	fill_element(element, bench->element_size, 2);
+	vector = nds_vector_new_with_allocator(bench->element_size, 1, &bench->allocator);
+	if (!vector)
+		return;
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++)
+	{
+		nds_vector_reserve(vector, (size_t)nds_vector_capacity(vector) + 1);
+		nds_vector_push_back(vector, element);
+	}
+	nds_bench_stop(bench, bench->elements);
+
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_raw_grow_incremental(NdsBench *bench)
+{
+	char element[MAX_ELEMENT_SIZE];
+	char *array, *grown;
+	size_t i;
+
+	fill_element(element, bench->element_size, 2);
+	array = malloc(bench->element_size);
+	if (!array)
+		return;
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++)
+	{
+		grown = realloc(array, (i + 2) * bench->element_size);
+		nds_bench_count_allocation(bench);
+		if (!grown)
+			break;
+		array = grown;
+		memcpy(array + i * bench->element_size, element, bench->element_size);
+	}
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(array);
+	free(array);
+}
+
+
+/**
+ * Bulk growth: elements appended in batches with nds_vector_append_n().
+ */
+static void bench_vector_grow_bulk(NdsBench *bench)
+{
+	char *batch;
+	NdsVector *vector;
+	size_t i;
+
+	batch = malloc(BULK_BATCH * bench->element_size);
+	vector = nds_vector_new_with_allocator(bench->element_size, 1, &bench->allocator);
+	if (!batch || !vector)
+	{
+		free(batch);
+		nds_vector_destroy(vector);
+		return;
+	}
+	fill_element(batch, BULK_BATCH * bench->element_size, 3);
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i += BULK_BATCH)
+		nds_vector_append_n(vector, batch, BULK_BATCH);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_vector_destroy(vector);
+	free(batch);
+}
+
+
+static void bench_raw_grow_bulk(NdsBench *bench)
+{
+	char *batch, *array = NULL, *grown;
+	size_t i;
+
+	batch = malloc(BULK_BATCH * bench->element_size);
+	if (!batch)
+		return;
+	fill_element(batch, BULK_BATCH * bench->element_size, 3);
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i += BULK_BATCH)
+	{
+		grown = realloc(array, (i + BULK_BATCH) * bench->element_size);
+		nds_bench_count_allocation(bench);
+		if (!grown)
+			break;
+		array = grown;
+		memcpy(array + i * bench->element_size, batch, BULK_BATCH * bench->element_size);
+	}
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(array);
+	free(array);
+	free(batch);
+}
+
+
+/**
+ * Bulk growth with nds_vector_resize(), followed by truncation and
+ * nds_vector_shrink_to_fit() in a loop.
+ */
+static void bench_vector_resize_shrink(NdsBench *bench)
+{
+	NdsVector *vector;
+	size_t i;
+
+	vector = nds_vector_new_with_allocator(bench->element_size, 1, &bench->allocator);
+	if (!vector)
+		return;
+
+	nds_bench_start(bench);
+	for (i = 0; i < SHRINK_CYCLES; i++)
+	{
+		nds_vector_resize(vector, bench->elements);
+		nds_vector_resize(vector, bench->elements / 16);
+		nds_vector_shrink_to_fit(vector);
+	}
+	nds_bench_stop(bench, 3 * SHRINK_CYCLES);
+
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_raw_resize_shrink(NdsBench *bench)
+{
+	char *array, *grown;
+	size_t i;
+
+	array = malloc(bench->element_size);
+	if (!array)
+		return;
+
+	nds_bench_start(bench);
+	for (i = 0; i < SHRINK_CYCLES; i++)
+	{
+		grown = realloc(array, bench->elements * bench->element_size);
+		nds_bench_count_allocation(bench);
+		if (!grown)
+			break;
+		array = grown;
+		nds_bench_use(array);
+
+		/* truncation does not touch the memory of a raw array */
+
+		grown = realloc(array, bench->elements / 16 * bench->element_size);
+		nds_bench_count_allocation(bench);
+		if (!grown)
+			break;
+		array = grown;
+	}
+	nds_bench_stop(bench, 3 * SHRINK_CYCLES);
+
+	free(array);
+}
+
+
+/**
+ * Geometric growth and resize/shrink cycles on the large-vector storage,
+ * where the capacity lives in an anonymous mapping that grows with mremap()
+ * instead of the allocator. The mapping calls are not counted as
+ * allocations, so these cases compare against the raw baselines above.
+ */
+static void bench_vector_grow_geometric_mapped(NdsBench *bench)
+{
+	char element[MAX_ELEMENT_SIZE];
+	NdsVector *vector;
+	size_t i;
+
+	fill_element(element, bench->element_size, 1);
+	vector = nds_vector_new_with_allocator(bench->element_size, 1, &bench->allocator);
+	if (!vector || nds_vector_set_large_storage(vector, MAPPED_THRESHOLD, 0) != NDS_OK)
+	{
+		nds_vector_destroy(vector);
+		return;
+	}
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++)
+		nds_vector_push_back(vector, element);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_vector_resize_shrink_mapped(NdsBench *bench)
+{
+	NdsVector *vector;
+	size_t i;
+
+	vector = nds_vector_new_with_allocator(bench->element_size, 1, &bench->allocator);
+	if (!vector || nds_vector_set_large_storage(vector, MAPPED_THRESHOLD, 0) != NDS_OK)
+	{
+		nds_vector_destroy(vector);
+		return;
+	}
+
+	nds_bench_start(bench);
+	for (i = 0; i < SHRINK_CYCLES; i++)
+	{
+		nds_vector_resize(vector, bench->elements);
+		nds_vector_resize(vector, bench->elements / 16);
+		nds_vector_shrink_to_fit(vector);
+	}
+	nds_bench_stop(bench, 3 * SHRINK_CYCLES);
+
+	nds_vector_destroy(vector);
+}
+
+
+/**
+ * Fill: a vector grown to its size with copies of one element, which the
+ * baseline writes one element at a time.
+ */
+static void bench_vector_resize_fill(NdsBench *bench)
+{
+	char element[MAX_ELEMENT_SIZE];
+	NdsVector *vector;
+
+	fill_element(element, bench->element_size, 5);
+	element[0] = 0;
+	vector = nds_vector_new_with_allocator(bench->element_size, bench->elements, &bench->allocator);
+	if (!vector)
+		return;
+
+	nds_bench_start(bench);
+	nds_vector_resize_fill(vector, bench->elements, element);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(nds_vector_data(vector));
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_raw_resize_fill(NdsBench *bench)
+{
+	char element[MAX_ELEMENT_SIZE];
+	char *array;
+	size_t i;
+
+	fill_element(element, bench->element_size, 5);
+	element[0] = 0;
+	array = malloc(bench->elements * bench->element_size);
+	if (!array)
+		return;
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++)
+		memcpy(array + i * bench->element_size, element, bench->element_size);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(array);
+	free(array);
+}
+
+
+/**
+ * Mixed workload: a random sequence of push, pop, get and set on a vector
+ * that starts with the given number of elements.
+ */
+static void bench_vector_mixed(NdsBench *bench)
+{
+	char element[MAX_ELEMENT_SIZE];
+	NdsVector *vector;
+	size_t i, size, state = 42;
+
+	fill_element(element, bench->element_size, 4);
+	vector = nds_vector_new_with_allocator(bench->element_size, 1, &bench->allocator);
+	if (!vector)
+		return;
+	for (i = 0; i < bench->elements; i++)
+		nds_vector_push_back(vector, element);
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++)
+	{
+		size_t random = next_random(&state);
+
+		size = (size_t)nds_vector_size(vector);
+		switch (random & 3)
+		{
+			case 0:
+				nds_vector_push_back(vector, element);
+				break;
+			case 1:
+				nds_vector_pop_back(vector, element);
+				break;
+			case 2:
+				if (size > 0)
+					nds_vector_get(vector, (random >> 2) % size, element);
+				break;
+			default:
+				if (size > 0)
+					nds_vector_set(vector, (random >> 2) % size, element);
+				break;
+		}
+	}
+	nds_vector_shrink_to_fit(vector);
+	nds_bench_stop(bench, bench->elements);
+
+	nds_vector_destroy(vector);
+}
+
+
+static void bench_raw_mixed(NdsBench *bench)
+{
+	char element[MAX_ELEMENT_SIZE];
+	char *array, *grown;
+	size_t i, size = 0, capacity = 1, state = 42;
+	size_t element_size = bench->element_size;
+
+	fill_element(element, element_size, 4);
+	array = malloc(capacity * element_size);
+	if (!array)
+		return;
+	for (i = 0; i < bench->elements; i++)
+	{
+		if (size == capacity)
+		{
+			grown = realloc(array, 2 * capacity * element_size);
+			if (!grown)
+				break;
+			array = grown;
+			capacity *= 2;
+		}
+		memcpy(array + size++ * element_size, element, element_size);
+	}
+
+	nds_bench_start(bench);
+	for (i = 0; i < bench->elements; i++)
+	{
+		size_t random = next_random(&state);
+
+		switch (random & 3)
+		{
+			case 0:
+				if (size == capacity)
+				{
+					grown = realloc(array, 2 * capacity * element_size);
+					nds_bench_count_allocation(bench);
+					if (!grown)
+						break;
+					array = grown;
+					capacity *= 2;
+				}
+				memcpy(array + size++ * element_size, element, element_size);
+				break;
+			case 1:
+				if (size > 0)
+					memcpy(element, array + --size * element_size, element_size);
+				break;
+			case 2:
+				if (size > 0)
+					memcpy(element, array + (random >> 2) % size * element_size, element_size);
+				break;
+			default:
+				if (size > 0)
+					memcpy(array + (random >> 2) % size * element_size, element, element_size);
+				break;
+		}
+	}
+	grown = realloc(array, (size > 0 ? size : 1) * element_size);
+	nds_bench_count_allocation(bench);
+	if (grown)
+		array = grown;
+	nds_bench_stop(bench, bench->elements);
+
+	nds_bench_use(array);
+	free(array);
+}
+
+
+void nds_vector_bench(void)
+{
+	static const size_t element_sizes[] = { 4, 16, sizeof(struct Person), MAX_ELEMENT_SIZE };
+	size_t i;
+
+	for (i = 0; i < sizeof(element_sizes) / sizeof(element_sizes[0]); i++)
+	{
+		size_t size = element_sizes[i];
+
+		nds_bench_run("vector/create_destroy", size, 10, bench_vector_create_destroy);
+		nds_bench_run("raw/create_destroy", size, 10, bench_raw_create_destroy);
+		nds_bench_run("vector/grow_geometric", size, ELEMENTS, bench_vector_grow_geometric);
+		nds_bench_run("raw/grow_geometric", size, ELEMENTS, bench_raw_grow_geometric);
+		nds_bench_run("vector/grow_incremental", size, INCREMENTAL_ELEMENTS, bench_vector_grow_incremental);
+		nds_bench_run("raw/grow_incremental", size, INCREMENTAL_ELEMENTS, bench_raw_grow_incremental);
+		nds_bench_run("vector/grow_bulk", size, ELEMENTS, bench_vector_grow_bulk);
+		nds_bench_run("raw/grow_bulk", size, ELEMENTS, bench_raw_grow_bulk);
+		nds_bench_run("vector/resize_shrink", size, ELEMENTS, bench_vector_resize_shrink);
+		nds_bench_run("raw/resize_shrink", size, ELEMENTS, bench_raw_resize_shrink);
+		nds_bench_run("vector/grow_geometric_mapped", size, ELEMENTS, bench_vector_grow_geometric_mapped);
+		nds_bench_run("vector/resize_shrink_mapped", size, ELEMENTS, bench_vector_resize_shrink_mapped);
+		nds_bench_run("vector/resize_fill", size, ELEMENTS, bench_vector_resize_fill);
+		nds_bench_run("raw/resize_fill", size, ELEMENTS, bench_raw_resize_fill);
+		nds_bench_run("vector/mixed", size, ELEMENTS, bench_vector_mixed);
+		nds_bench_run("raw/mixed", size, ELEMENTS, bench_raw_mixed);
+	}
+}
@@ -21,8 +21,8 @@ int main()
 	else
 		printf("Vector is not empty!\n");
 
-	printf("Size = %i\n", nds_vector_size(vector));
-	printf("Capacity = %i\n", nds_vector_capacity(vector));
+	printf("Size = %zd\n", nds_vector_size(vector));
+	printf("Capacity = %zd\n", nds_vector_capacity(vector));
 
 	/* cleanup */
 	nds_vector_destroy(vector);
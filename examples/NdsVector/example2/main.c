@@ -1,37 +1,48 @@
-#include "Person.h"
-
-#include <stdio.h>
-#include <string.h>
-
-#include <nds/ndsvector.h>
-
-
-void initialize_person(struct Person *person, char *name, int age)
-{
-	strcpy(person->name, name);
-	person->age = age;
-}
-
-
-int main()
-{
-	struct Person person1, person2;
-	NdsVector *vector;
-
-	initialize_person(&person1, "Person1", 24);
-	initialize_person(&person2, "Person2", 27);
-
-	/* create a new NdsVector of Person structures */
-	vector = nds_vector_new(sizeof(struct Person));
-	if (!vector)
-	{
-		printf("Error during NdsVector creation!\n");
-		return -1;
-	}
-
-	/* cleanup */
-	nds_vector_destroy(vector);
-
-	return 0;
-}
-
+#include "Person.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <nds/ndsvector.h>
+
+
+void initialize_person(struct Person *person, char *name, int age)
+{
+	strcpy(person->name, name);
+	person->age = age;
+}
+
+
+int main()
+{
+	struct Person person1, person2, person;
+	NdsVector *vector;
+	int i;
+
+	initialize_person(&person1, "Person1", 24);
+	initialize_person(&person2, "Person2", 27);
+
+	/* create a new NdsVector of Person structures */
+	vector = nds_vector_new(sizeof(struct Person));
+	if (!vector)
+	{
+		printf("Error during NdsVector creation!\n");
+		return -1;
+	}
+
+	/* add both persons at the end of the vector */
+	nds_vector_push_back(vector, &person1);
+	nds_vector_push_back(vector, &person2);
+
+	for (i = 0; i < nds_vector_size(vector); i++)
+	{
+		nds_vector_get(vector, i, &person);
+		print_person(person);
+	}
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return 0;
+}
+
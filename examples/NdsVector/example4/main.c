@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <nds/ndsvectortyped.h>
+
+
+struct Person
+{
+	char name[30];
+	int age;
+};
+
+typedef struct Person Person;
+
+/* generate NdsVector_Person and the nds_vector_Person_*() functions */
+NDS_VECTOR_DECLARE(Person)
+
+
+int main()
+{
+	NdsVector_Person vector;
+	Person person;
+	size_t i;
+
+	/* create a new vector of Person structures */
+	if (nds_vector_Person_init(&vector) != NDS_OK)
+	{
+		printf("Error during NdsVector_Person creation!\n");
+		return -1;
+	}
+
+	strcpy(person.name, "Person1");
+	person.age = 24;
+	nds_vector_Person_push_back(&vector, person);
+
+	strcpy(person.name, "Person2");
+	person.age = 27;
+	nds_vector_Person_push_back(&vector, person);
+
+	/* every access is a direct load from the elements of the vector */
+	for (i = 0; i < nds_vector_Person_size(&vector); i++)
+		printf("Name - %s | Age - %i\n", nds_vector_Person_get(&vector, i).name, nds_vector_Person_get(&vector, i).age);
+
+	/* cleanup */
+	nds_vector_Person_destroy(&vector);
+
+	return 0;
+}
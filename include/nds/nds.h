@@ -35,7 +35,19 @@
 #define __NDS_H__
 
 /* include whole library */
+#include <nds/ndsconcurrentqueue.h>
+#include <nds/ndsconcurrentvector.h>
+#include <nds/ndsforwardlist.h>
+#include <nds/ndshashmap.h>
+#include <nds/ndshashset.h>
+#include <nds/ndslist.h>
+#include <nds/ndspriorityqueue.h>
+#include <nds/ndsqueue.h>
+#include <nds/ndsscheduler.h>
+#include <nds/ndsstack.h>
+#include <nds/ndstreemap.h>
 #include <nds/ndsvector.h>
+#include <nds/ndsvectortyped.h>
 
 #endif /* __NDS_H__ */
 
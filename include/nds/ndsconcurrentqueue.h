@@ -0,0 +1,256 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains a bounded FIFO queue of elements of a fixed size that
+ * many producer threads and many consumer threads can use at once, without
+ * locks. Every slot of its ring buffer stores a sequence number next to the
+ * element, which tells the thread that reaches the slot whether it is free
+ * for the current lap or holds the element of the current lap. A thread
+ * claims a slot (or a run of consecutive slots) with one compare and swap on
+ * the position of its side, copies the elements and publishes the slots by
+ * storing their next sequence numbers, so the producers and the consumers
+ * only meet on the slots themselves.
+ *
+ * A queue created in blocking mode also has enqueue() and dequeue()
+ * functions that wait while the queue is full or empty: they yield the
+ * processor a few times and then sleep on a futex (Linux). The other
+ * threads pay for the wake up only while a thread sleeps. On other systems
+ * the waiting threads keep yielding the processor.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_CONCURRENT_QUEUE_H__
+#define __NDS_CONCURRENT_QUEUE_H__
+
+#include <nds/ndsutils.h>
+
+#include <stddef.h>
+#include <sys/types.h>
+
+
+struct NdsConcurrentQueue
+{
+	struct NdsConcurrentQueuePrivate *private;
+};
+
+typedef struct NdsConcurrentQueue NdsConcurrentQueue;
+
+
+/**
+ * Function that creates a new non-blocking NdsConcurrentQueue with room for
+ * capacity elements (rounded up to a power of two, at least 2).
+ *
+ * NOTE: Do not forget to call nds_concurrent_queue_destroy() before exiting
+ * the scope of the current NdsConcurrentQueue in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the queue
+ * @param           capacity    number of elements the queue fits
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    linear on the capacity
+ */
+NdsConcurrentQueue* nds_concurrent_queue_new(size_t sizeof_element, size_t capacity);
+
+
+/**
+ * Function that creates a new NdsConcurrentQueue with room for capacity
+ * elements (rounded up to a power of two, at least 2), which obtains its
+ * memory from the given allocator.
+ *
+ * NOTE: Do not forget to call nds_concurrent_queue_destroy() before exiting
+ * the scope of the current NdsConcurrentQueue in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the queue
+ * @param           capacity    number of elements the queue fits
+ * @param           blocking    1 if the threads may wait in enqueue() and dequeue(), 0 otherwise
+ * @param          allocator    allocator used for all the memory of the queue
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    linear on the capacity
+ */
+NdsConcurrentQueue* nds_concurrent_queue_new_with_allocator(size_t sizeof_element, size_t capacity, int blocking, const NdsAllocator *allocator);
+
+
+/**
+ * Function that frees the memory occupied by the NdsConcurrentQueue.
+ *
+ * NOTE: No other thread may use the queue while it is destroyed.
+ *
+ * @param    queue    pointer to a NdsConcurrentQueue structure
+ *
+ * @complexity    constant
+ */
+void nds_concurrent_queue_destroy(NdsConcurrentQueue *queue);
+
+
+/**
+ * Function that returns the number of elements the NdsConcurrentQueue fits.
+ *
+ * @param     queue    pointer to a NdsConcurrentQueue structure
+ *
+ * @return    capacity    the capacity of the NdsConcurrentQueue
+ *                  -1    the NdsConcurrentQueue is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_concurrent_queue_capacity(NdsConcurrentQueue *queue);
+
+
+/**
+ * Function that returns the number of elements claimed by the producers and
+ * not yet claimed by the consumers of the NdsConcurrentQueue. While other
+ * threads use the queue, the result is only an estimate.
+ *
+ * @param     queue    pointer to a NdsConcurrentQueue structure
+ *
+ * @return    size    the number of elements
+ *              -1    the NdsConcurrentQueue is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_concurrent_queue_size(NdsConcurrentQueue *queue);
+
+
+/**
+ * Function that adds a copy of the given element at the back of the
+ * NdsConcurrentQueue, unless the queue is full.
+ *
+ * @param      queue    pointer to a NdsConcurrentQueue structure
+ * @param    element    pointer to the element that will be copied
+ *
+ * @return    1    the element was added
+ *            0    the queue is full
+ *           -1    invalid parameters for the function
+ *
+ * @complexity    constant (without contention)
+ */
+int nds_concurrent_queue_try_enqueue(NdsConcurrentQueue *queue, const void *element);
+
+
+/**
+ * Function that adds copies of as many of the count elements stored
+ * contiguously at the given address as fit in the NdsConcurrentQueue. The
+ * added elements take consecutive positions in the queue, claimed at once.
+ *
+ * @param       queue    pointer to a NdsConcurrentQueue structure
+ * @param    elements    pointer to the first element
+ * @param       count    number of elements
+ *
+ * @return    number    the number of added elements, from the first one
+ *                -1    invalid parameters for the function
+ *
+ * @complexity    linear on count (without contention)
+ */
+ssize_t nds_concurrent_queue_try_enqueue_n(NdsConcurrentQueue *queue, const void *elements, size_t count);
+
+
+/**
+ * Function that removes the element at the front of the NdsConcurrentQueue,
+ * unless the queue is empty.
+ *
+ * @param      queue    pointer to a NdsConcurrentQueue structure
+ * @param    element    where to copy the removed element (can be NULL)
+ *
+ * @return    1    the element was removed
+ *            0    the queue is empty
+ *           -1    invalid parameters for the function
+ *
+ * @complexity    constant (without contention)
+ */
+int nds_concurrent_queue_try_dequeue(NdsConcurrentQueue *queue, void *element);
+
+
+/**
+ * Function that removes up to count consecutive elements from the front of
+ * the NdsConcurrentQueue, claimed at once.
+ *
+ * NOTE: An element whose producer has not finished copying it stops the
+ * batch, even if the elements after it are ready.
+ *
+ * @param       queue    pointer to a NdsConcurrentQueue structure
+ * @param    elements    where to copy the removed elements (can be NULL)
+ * @param       count    maximum number of elements to remove
+ *
+ * @return    number    the number of removed elements
+ *                -1    invalid parameters for the function
+ *
+ * @complexity    linear on count (without contention)
+ */
+ssize_t nds_concurrent_queue_try_dequeue_n(NdsConcurrentQueue *queue, void *elements, size_t count);
+
+
+/**
+ * Function that adds a copy of the given element at the back of a blocking
+ * NdsConcurrentQueue, and waits while the queue is full.
+ *
+ * @param      queue    pointer to a NdsConcurrentQueue structure
+ * @param    element    pointer to the element that will be copied
+ *
+ * @return    NDS_OK                     the element was added
+ *            NDS_ERROR                  the queue was closed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or the queue is not blocking
+ *
+ * @complexity    constant (without contention)
+ */
+NdsStatus nds_concurrent_queue_enqueue(NdsConcurrentQueue *queue, const void *element);
+
+
+/**
+ * Function that removes the element at the front of a blocking
+ * NdsConcurrentQueue, and waits while the queue is empty. The elements
+ * added before the queue was closed can still be removed.
+ *
+ * @param      queue    pointer to a NdsConcurrentQueue structure
+ * @param    element    where to copy the removed element (can be NULL)
+ *
+ * @return    NDS_OK                     the element was removed
+ *            NDS_ERROR                  the queue was closed and is empty
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or the queue is not blocking
+ *
+ * @complexity    constant (without contention)
+ */
+NdsStatus nds_concurrent_queue_dequeue(NdsConcurrentQueue *queue, void *element);
+
+
+/**
+ * Function that closes a blocking NdsConcurrentQueue and wakes all the
+ * waiting threads. From now on enqueue() fails and dequeue() fails once the
+ * queue is empty, so the consumers of a worker pool can stop. The try
+ * functions are not affected.
+ *
+ * @param    queue    pointer to a NdsConcurrentQueue structure
+ *
+ * @return    NDS_OK                     the queue was closed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or the queue is not blocking
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_concurrent_queue_close(NdsConcurrentQueue *queue);
+
+
+#endif /* __NDS_CONCURRENT_QUEUE_H__ */
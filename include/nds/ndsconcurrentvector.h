@@ -0,0 +1,207 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * NdsConcurrentVector is an append-only vector that many threads can push
+ * elements into at the same time. The elements are stored in segments whose
+ * sizes double, so growing the vector never moves the elements that are
+ * already stored and their addresses stay valid until the vector is
+ * destroyed. Readers can access and iterate the published elements while
+ * other threads keep appending.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_CONCURRENT_VECTOR_H__
+#define __NDS_CONCURRENT_VECTOR_H__
+
+#include <nds/ndsutils.h>
+#include <nds/ndsvector.h>
+
+#include <stddef.h>
+#include <sys/types.h>
+
+
+struct NdsConcurrentVector
+{
+	struct NdsConcurrentVectorPrivate *private;
+};
+
+typedef struct NdsConcurrentVector NdsConcurrentVector;
+
+
+/**
+ * Function that creates a new NdsConcurrentVector whose first segment holds
+ * 16 elements.
+ *
+ * NOTE: Do not forget to call nds_concurrent_vector_destroy() before exiting
+ * the scope of the current NdsConcurrentVector in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the vector
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsConcurrentVector* nds_concurrent_vector_new(size_t sizeof_element);
+
+
+/**
+ * Function that creates a new NdsConcurrentVector which obtains the memory
+ * for its segments from the given allocator. The first segment holds capacity
+ * elements rounded up to a power of two and every following segment is twice
+ * as large as the previous one.
+ *
+ * NOTE: The allocator is called from the threads that push elements, so it
+ * must be thread safe.
+ *
+ * @param     sizeof_element    size of one element in the vector
+ * @param           capacity    number of elements of the first segment
+ * @param          allocator    allocator used for all the memory of the vector
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsConcurrentVector* nds_concurrent_vector_new_with_allocator(size_t sizeof_element, size_t capacity, const NdsAllocator *allocator);
+
+
+/**
+ * Function that frees the memory occupied by the NdsConcurrentVector.
+ *
+ * NOTE: No other thread may use the vector while it is destroyed.
+ *
+ * @param    vector    pointer to a NdsConcurrentVector structure
+ *
+ * @complexity    linear on the number of segments
+ */
+void nds_concurrent_vector_destroy(NdsConcurrentVector *vector);
+
+
+/**
+ * Function that returns the number of elements published in the
+ * NdsConcurrentVector. While other threads push elements, the published
+ * elements do not have to be the first ones of the vector.
+ *
+ * @param     vector    pointer to a NdsConcurrentVector structure
+ *
+ * @return    size    the number of published elements
+ *              -1    the NdsConcurrentVector is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_concurrent_vector_size(NdsConcurrentVector *vector);
+
+
+/**
+ * Function that allocates the segments needed to store capacity elements, so
+ * the pushes that fill them do not allocate memory.
+ *
+ * NOTE: It can be called while other threads push elements.
+ *
+ * @param       vector    pointer to a NdsConcurrentVector structure
+ * @param     capacity    number of elements the vector should fit
+ *
+ * @return                     NDS_OK    the segments were allocated
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    linear on the number of segments
+ */
+NdsStatus nds_concurrent_vector_reserve(NdsConcurrentVector *vector, size_t capacity);
+
+
+/**
+ * Function that appends a copy of the given element to the
+ * NdsConcurrentVector and returns its index. The slot of the element is
+ * reserved with a compare and swap, which only fails when another push took
+ * the slot first, so some push always makes progress (lock-free, but a push
+ * may retry under contention). The thread that first reaches a segment which
+ * is not allocated yet allocates it, and the allocator may block.
+ *
+ * NOTE: A slot is only reserved after its segment was allocated, so when the
+ * allocation fails nothing is appended and the indexes stay contiguous.
+ * nds_concurrent_vector_reserve() takes the allocations out of the pushes.
+ *
+ * @param      vector    pointer to a NdsConcurrentVector structure
+ * @param     element    pointer to the element that will be copied
+ *
+ * @return    index    the index of the appended element
+ *               -1    invalid parameters or memory allocation error
+ *
+ * @complexity    constant
+ */
+ssize_t nds_concurrent_vector_push_back(NdsConcurrentVector *vector, const void *element);
+
+
+/**
+ * Function that returns the address of the element found at the given index
+ * of the NdsConcurrentVector. The address stays valid until the vector is
+ * destroyed.
+ *
+ * @param     vector    pointer to a NdsConcurrentVector structure
+ * @param      index    position of the element in the vector
+ *
+ * @return    valid pointer    address of the element
+ *                     NULL    invalid parameters or the element is not published yet
+ *
+ * @complexity    constant
+ */
+void* nds_concurrent_vector_at(NdsConcurrentVector *vector, size_t index);
+
+
+/**
+ * Function that copies the element found at the given index of the
+ * NdsConcurrentVector.
+ *
+ * @param      vector    pointer to a NdsConcurrentVector structure
+ * @param       index    position of the element in the vector
+ * @param     element    where to copy the element
+ *
+ * @return                     NDS_OK    the element was copied
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or the element is not published yet
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_concurrent_vector_get(NdsConcurrentVector *vector, size_t index, void *element);
+
+
+/**
+ * Function that calls the given function for every element published in the
+ * NdsConcurrentVector, in the order of their indexes. The elements pushed by
+ * other threads during the iteration may or may not be visited.
+ *
+ * @param       vector    pointer to a NdsConcurrentVector structure
+ * @param     function    function called with the address of every element
+ * @param      context    pointer passed to every call of the function
+ *
+ * @return                     NDS_OK    the elements were visited
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    linear
+ */
+NdsStatus nds_concurrent_vector_for_each(NdsConcurrentVector *vector, NdsElementFunction function, void *context);
+
+
+#endif /* __NDS_CONCURRENT_VECTOR_H__ */
@@ -0,0 +1,423 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains an intrusive singly-linked list. The list does not
+ * store elements: the caller embeds a NdsForwardLink in its own structure
+ * and links that structure, so adding an element costs no allocation and
+ * the structure is reached again with NDS_CONTAINER_OF():
+ *
+ *     struct Person
+ *     {
+ *         char name[32];
+ *         NdsForwardLink link;
+ *     };
+ *
+ *     nds_forward_list_push_back(list, &person->link);
+ *     person = NDS_CONTAINER_OF(nds_forward_list_pop_front(list), struct Person, link);
+ *
+ * A structure can be in as many lists as it has links, but a link can be
+ * in one list at a time. The list never frees the linked structures.
+ *
+ * NdsConcurrentForwardList is the lock-free variant for many threads, a
+ * Treiber stack: the threads push and pop links at the front with one
+ * compare and swap on the first link, which is kept together with a counter
+ * of the changes made to the list in one 64-bit word. A thread that read
+ * the first link before it was popped and pushed back by other threads sees
+ * the counter changed and tries again (the ABA problem). This makes it a
+ * free list for recycling objects between threads.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_FORWARD_LIST_H__
+#define __NDS_FORWARD_LIST_H__
+
+#include <nds/ndsutils.h>
+
+#include <stddef.h>
+#include <sys/types.h>
+
+
+/* the structure of the given type whose member is the given link */
+#define NDS_CONTAINER_OF(link, type, member) ((type*)(void*)((char*)(link) - offsetof(type, member)))
+
+
+/**
+ * NdsForwardLink is embedded in the structures that are linked in a
+ * NdsForwardList or a NdsConcurrentForwardList. The next link of the list
+ * may be read, but only the functions of the list change it.
+ */
+struct NdsForwardLink
+{
+	struct NdsForwardLink *next;
+};
+
+typedef struct NdsForwardLink NdsForwardLink;
+
+
+struct NdsForwardList
+{
+	struct NdsForwardListPrivate *private;
+};
+
+typedef struct NdsForwardList NdsForwardList;
+
+
+struct NdsConcurrentForwardList
+{
+	struct NdsConcurrentForwardListPrivate *private;
+};
+
+typedef struct NdsConcurrentForwardList NdsConcurrentForwardList;
+
+
+/**
+ * Function that creates a new empty NdsForwardList.
+ *
+ * NOTE: Do not forget to call nds_forward_list_destroy() before exiting the
+ * scope of the current NdsForwardList in order to avoid memory leaks!
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsForwardList* nds_forward_list_new(void);
+
+
+/**
+ * Function that creates a new empty NdsForwardList whose memory is obtained
+ * from the given allocator.
+ *
+ * NOTE: Do not forget to call nds_forward_list_destroy() before exiting the
+ * scope of the current NdsForwardList in order to avoid memory leaks!
+ *
+ * @param     allocator    allocator for the memory of the list
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsForwardList* nds_forward_list_new_with_allocator(const NdsAllocator *allocator);
+
+
+/**
+ * Function that frees the memory occupied by the NdsForwardList. The linked
+ * structures belong to the caller and are not touched.
+ *
+ * @param    list    pointer to a NdsForwardList structure
+ *
+ * @complexity    constant
+ */
+void nds_forward_list_destroy(NdsForwardList *list);
+
+
+/**
+ * Function that returns the number of links in the NdsForwardList.
+ *
+ * @param     list    pointer to a NdsForwardList structure
+ *
+ * @return    number    the size of the list
+ *                -1    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+ssize_t nds_forward_list_size(NdsForwardList *list);
+
+
+/**
+ * Function that returns the first link of the NdsForwardList. The list is
+ * walked by following the next pointers until NULL.
+ *
+ * @param     list    pointer to a NdsForwardList structure
+ *
+ * @return    valid pointer    the first link
+ *                     NULL    the list is empty or invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsForwardLink* nds_forward_list_first(NdsForwardList *list);
+
+
+/**
+ * Function that returns the last link of the NdsForwardList.
+ *
+ * @param     list    pointer to a NdsForwardList structure
+ *
+ * @return    valid pointer    the last link
+ *                     NULL    the list is empty or invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsForwardLink* nds_forward_list_last(NdsForwardList *list);
+
+
+/**
+ * Function that links a structure at the beginning of the NdsForwardList.
+ *
+ * @param     list    pointer to a NdsForwardList structure
+ * @param     link    pointer to the link embedded in the structure
+ *
+ * @return                     NDS_OK    insertion was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_forward_list_push_front(NdsForwardList *list, NdsForwardLink *link);
+
+
+/**
+ * Function that links a structure at the end of the NdsForwardList.
+ *
+ * @param     list    pointer to a NdsForwardList structure
+ * @param     link    pointer to the link embedded in the structure
+ *
+ * @return                     NDS_OK    insertion was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_forward_list_push_back(NdsForwardList *list, NdsForwardLink *link);
+
+
+/**
+ * Function that unlinks the first link of the NdsForwardList.
+ *
+ * @param     list    pointer to a NdsForwardList structure
+ *
+ * @return    valid pointer    the unlinked link
+ *                     NULL    the list is empty or invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsForwardLink* nds_forward_list_pop_front(NdsForwardList *list);
+
+
+/**
+ * Function that links a structure after the given link of the
+ * NdsForwardList, or at its beginning when position is NULL.
+ *
+ * @param         list    pointer to a NdsForwardList structure
+ * @param     position    pointer to a link of the list (can be NULL)
+ * @param         link    pointer to the link embedded in the structure
+ *
+ * @return                     NDS_OK    insertion was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_forward_list_insert_after(NdsForwardList *list, NdsForwardLink *position, NdsForwardLink *link);
+
+
+/**
+ * Function that unlinks the link that follows the given link of the
+ * NdsForwardList, or the first link when position is NULL.
+ *
+ * @param         list    pointer to a NdsForwardList structure
+ * @param     position    pointer to a link of the list (can be NULL)
+ *
+ * @return    valid pointer    the unlinked link
+ *                     NULL    no link follows position or invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsForwardLink* nds_forward_list_remove_after(NdsForwardList *list, NdsForwardLink *position);
+
+
+/**
+ * Function that unlinks the given link from the NdsForwardList. The list is
+ * searched for the link that precedes it.
+ *
+ * @param     list    pointer to a NdsForwardList structure
+ * @param     link    pointer to the link that is unlinked
+ *
+ * @return                     NDS_OK    the link was unlinked
+ *                          NDS_ERROR    the link is not in the list
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    linear
+ */
+NdsStatus nds_forward_list_remove(NdsForwardList *list, NdsForwardLink *link);
+
+
+/**
+ * Function that moves all the links of other to the end of the
+ * NdsForwardList, leaving other empty.
+ *
+ * @param      list    pointer to a NdsForwardList structure
+ * @param     other    pointer to the NdsForwardList whose links are moved
+ *
+ * @return                     NDS_OK    the links were moved
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_forward_list_splice_back(NdsForwardList *list, NdsForwardList *other);
+
+
+/**
+ * Function that reverses the order of the links of the NdsForwardList.
+ *
+ * @param     list    pointer to a NdsForwardList structure
+ *
+ * @return                     NDS_OK    the list was reversed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    linear
+ */
+NdsStatus nds_forward_list_reverse(NdsForwardList *list);
+
+
+/**
+ * Function that unlinks all the links of the NdsForwardList.
+ *
+ * @param     list    pointer to a NdsForwardList structure
+ *
+ * @return                     NDS_OK    the list was cleared
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_forward_list_clear(NdsForwardList *list);
+
+
+/**
+ * Function that creates a new empty NdsConcurrentForwardList.
+ *
+ * NOTE: Do not forget to call nds_concurrent_forward_list_destroy() before
+ * exiting the scope of the current NdsConcurrentForwardList in order to
+ * avoid memory leaks!
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsConcurrentForwardList* nds_concurrent_forward_list_new(void);
+
+
+/**
+ * Function that creates a new empty NdsConcurrentForwardList whose memory
+ * is obtained from the given allocator.
+ *
+ * NOTE: Do not forget to call nds_concurrent_forward_list_destroy() before
+ * exiting the scope of the current NdsConcurrentForwardList in order to
+ * avoid memory leaks!
+ *
+ * @param     allocator    allocator for the memory of the list
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsConcurrentForwardList* nds_concurrent_forward_list_new_with_allocator(const NdsAllocator *allocator);
+
+
+/**
+ * Function that frees the memory occupied by the NdsConcurrentForwardList.
+ * The linked structures belong to the caller and are not touched.
+ *
+ * NOTE: No other thread may use the list while it is destroyed.
+ *
+ * @param    list    pointer to a NdsConcurrentForwardList structure
+ *
+ * @complexity    constant
+ */
+void nds_concurrent_forward_list_destroy(NdsConcurrentForwardList *list);
+
+
+/**
+ * Function that links a structure at the beginning of the
+ * NdsConcurrentForwardList. Any thread may call it.
+ *
+ * NOTE: On 64-bit systems the list keeps the change counter in the upper
+ * 16 bits of the address of the first link, so the links must have
+ * addresses below 2^48 (the user space of x86-64 and ARMv8 systems, unless
+ * the program asks for 5-level page tables or tags its pointers).
+ *
+ * @param     list    pointer to a NdsConcurrentForwardList structure
+ * @param     link    pointer to the link embedded in the structure
+ *
+ * @return                     NDS_OK    insertion was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    constant, lock-free
+ */
+NdsStatus nds_concurrent_forward_list_push_front(NdsConcurrentForwardList *list, NdsForwardLink *link);
+
+
+/**
+ * Function that links a chain of structures at the beginning of the
+ * NdsConcurrentForwardList with a single compare and swap. The chain goes
+ * from first to last through the next pointers, the next pointer of last
+ * is overwritten. Any thread may call it.
+ *
+ * @param      list    pointer to a NdsConcurrentForwardList structure
+ * @param     first    pointer to the first link of the chain
+ * @param      last    pointer to the last link of the chain
+ *
+ * @return                     NDS_OK    insertion was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    constant, lock-free
+ */
+NdsStatus nds_concurrent_forward_list_push_front_n(NdsConcurrentForwardList *list, NdsForwardLink *first, NdsForwardLink *last);
+
+
+/**
+ * Function that unlinks the first link of the NdsConcurrentForwardList.
+ * Any thread may call it.
+ *
+ * NOTE: A thread that is about to pop a link may still read its next
+ * pointer after another thread popped it, so the memory of the links must
+ * stay valid while the list is in use: recycle the structures instead of
+ * freeing them.
+ *
+ * @param     list    pointer to a NdsConcurrentForwardList structure
+ *
+ * @return    valid pointer    the unlinked link
+ *                     NULL    the list is empty or invalid parameters for the function
+ *
+ * @complexity    constant, lock-free
+ */
+NdsForwardLink* nds_concurrent_forward_list_pop_front(NdsConcurrentForwardList *list);
+
+
+/**
+ * Function that unlinks all the links of the NdsConcurrentForwardList at
+ * once. The returned chain is linked through the next pointers, the last
+ * pushed link first. Any thread may call it.
+ *
+ * @param     list    pointer to a NdsConcurrentForwardList structure
+ *
+ * @return    valid pointer    the first link of the unlinked chain
+ *                     NULL    the list is empty or invalid parameters for the function
+ *
+ * @complexity    constant, lock-free
+ */
+NdsForwardLink* nds_concurrent_forward_list_pop_all(NdsConcurrentForwardList *list);
+
+
+#endif /* __NDS_FORWARD_LIST_H__ */
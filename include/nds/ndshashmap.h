@@ -0,0 +1,270 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * NdsHashMap is a generic unordered dictionary of key-value pairs. The pairs
+ * are stored in one flat array (open addressing) next to an array of control
+ * bytes, one per slot, which holds 7 bits of the hash of the key stored in
+ * the slot or marks the slot as empty. A lookup compares 16 control bytes at
+ * once and only compares the keys whose 7 bits match, so most lookups touch
+ * one cache line of control bytes and the slot of the key.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_HASH_MAP_H__
+#define __NDS_HASH_MAP_H__
+
+#include <nds/ndsutils.h>
+
+#include <stddef.h>
+#include <sys/types.h>
+
+
+struct NdsHashMap
+{
+	struct NdsHashMapPrivate *private;
+};
+
+typedef struct NdsHashMap NdsHashMap;
+
+
+/**
+ * Function that creates a new NdsHashMap with room for 13 pairs.
+ *
+ * When hash is NULL, the keys are hashed with nds_hash_mix() if they have 4
+ * or 8 bytes and with nds_hash_bytes() otherwise. When equal is NULL, the
+ * keys are compared bytewise. Both defaults are inlined in the lookups, so
+ * they are the fastest choice for keys without padding or pointers.
+ *
+ * NOTE: Do not forget to call nds_hash_map_destroy() before exiting the scope
+ * of the current NdsHashMap in order to avoid memory leaks!
+ *
+ * @param       sizeof_key    size of one key in the map
+ * @param     sizeof_value    size of one value in the map (can be 0)
+ * @param             hash    function that hashes the keys (can be NULL)
+ * @param            equal    function that compares the keys (can be NULL)
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsHashMap* nds_hash_map_new(size_t sizeof_key, size_t sizeof_value, NdsHashFunction hash, NdsEqualFunction equal);
+
+
+/**
+ * Function that creates a new NdsHashMap with room for at least capacity
+ * pairs, which obtains all its memory from the given allocator.
+ *
+ * NOTE: Do not forget to call nds_hash_map_destroy() before exiting the scope
+ * of the current NdsHashMap in order to avoid memory leaks!
+ *
+ * @param       sizeof_key    size of one key in the map
+ * @param     sizeof_value    size of one value in the map (can be 0)
+ * @param             hash    function that hashes the keys (can be NULL)
+ * @param            equal    function that compares the keys (can be NULL)
+ * @param         capacity    number of pairs the map fits without growing
+ * @param        allocator    allocator used for all the memory of the map
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    linear on capacity
+ */
+NdsHashMap* nds_hash_map_new_with_allocator(size_t sizeof_key, size_t sizeof_value, NdsHashFunction hash, NdsEqualFunction equal, size_t capacity, const NdsAllocator *allocator);
+
+
+/**
+ * Function that frees the memory occupied by the NdsHashMap.
+ *
+ * @param    map    pointer to a NdsHashMap structure
+ *
+ * @complexity    constant
+ */
+void nds_hash_map_destroy(NdsHashMap *map);
+
+
+/**
+ * Function that returns the number of pairs stored in the NdsHashMap.
+ *
+ * @param     map    pointer to a NdsHashMap structure
+ *
+ * @return    size    the number of pairs
+ *              -1    the NdsHashMap is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_hash_map_size(NdsHashMap *map);
+
+
+/**
+ * Function that returns the number of pairs the NdsHashMap fits before it
+ * has to grow. The map grows when 4/5 of its slots are used.
+ *
+ * @param     map    pointer to a NdsHashMap structure
+ *
+ * @return    capacity    the capacity of the NdsHashMap
+ *                  -1    the NdsHashMap is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_hash_map_capacity(NdsHashMap *map);
+
+
+/**
+ * Function that grows the NdsHashMap so that it fits capacity pairs without
+ * growing again. The map never shrinks.
+ *
+ * NOTE: The pointers returned by nds_hash_map_find() are invalidated when
+ * the map grows.
+ *
+ * @param          map    pointer to a NdsHashMap structure
+ * @param     capacity    number of pairs the map should fit
+ *
+ * @return                     NDS_OK    the map fits capacity pairs
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    linear
+ */
+NdsStatus nds_hash_map_reserve(NdsHashMap *map, size_t capacity);
+
+
+/**
+ * Function that stores a copy of the given pair in the NdsHashMap. If the
+ * key is already in the map, its value is overwritten.
+ *
+ * @param      map    pointer to a NdsHashMap structure
+ * @param      key    pointer to the key that will be copied
+ * @param    value    pointer to the value that will be copied (NULL when the size of the values is 0)
+ *
+ * @return                     NDS_OK    the pair was stored
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    amortized constant
+ */
+NdsStatus nds_hash_map_insert(NdsHashMap *map, const void *key, const void *value);
+
+
+/**
+ * Function that returns the address of the value paired with the given key.
+ *
+ * NOTE: The pointer is invalidated by any function that adds or removes
+ * pairs, since both can move the pairs inside the map.
+ *
+ * @param    map    pointer to a NdsHashMap structure
+ * @param    key    pointer to the searched key
+ *
+ * @return    valid pointer    address of the value
+ *                     NULL    invalid parameters or the key is not in the map
+ *
+ * @complexity    constant on average
+ */
+void* nds_hash_map_find(NdsHashMap *map, const void *key);
+
+
+/**
+ * Function that copies the value paired with the given key.
+ *
+ * @param      map    pointer to a NdsHashMap structure
+ * @param      key    pointer to the searched key
+ * @param    value    where to copy the value
+ *
+ * @return                     NDS_OK    the value was copied
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or the key is not in the map
+ *
+ * @complexity    constant on average
+ */
+NdsStatus nds_hash_map_get(NdsHashMap *map, const void *key, void *value);
+
+
+/**
+ * Function that checks if the given key is stored in the NdsHashMap.
+ *
+ * @param    map    pointer to a NdsHashMap structure
+ * @param    key    pointer to the searched key
+ *
+ * @return    1    the key is in the map
+ *            0    the key is not in the map
+ *           -1    invalid parameters for the function
+ *
+ * @complexity    constant on average
+ */
+int nds_hash_map_contains(NdsHashMap *map, const void *key);
+
+
+/**
+ * Function that removes the pair with the given key from the NdsHashMap. If
+ * value is not NULL, the removed value is copied there before removal.
+ *
+ * NOTE: The pairs that follow the removed one in its probe sequence are
+ * shifted back into the freed slot, so removals leave no tombstones and the
+ * lookups do not get slower after many removals.
+ *
+ * @param      map    pointer to a NdsHashMap structure
+ * @param      key    pointer to the key of the removed pair
+ * @param    value    where to copy the removed value (can be NULL)
+ *
+ * @return                     NDS_OK    the pair was removed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or the key is not in the map
+ *
+ * @complexity    constant on average
+ */
+NdsStatus nds_hash_map_remove(NdsHashMap *map, const void *key, void *value);
+
+
+/**
+ * Function that removes all the pairs of the NdsHashMap.
+ *
+ * NOTE: The capacity of the map is not affected.
+ *
+ * @param    map    pointer to a NdsHashMap structure
+ *
+ * @return                     NDS_OK    the map was cleared
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    linear on the capacity
+ */
+NdsStatus nds_hash_map_clear(NdsHashMap *map);
+
+
+/**
+ * Function that calls the given function for every pair of the NdsHashMap,
+ * in no particular order.
+ *
+ * NOTE: The function must not add or remove pairs.
+ *
+ * @param         map    pointer to a NdsHashMap structure
+ * @param    function    function called with the key and the value of every pair
+ * @param     context    pointer passed to every call of the function
+ *
+ * @return                     NDS_OK    the pairs were visited
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    linear on the capacity
+ */
+NdsStatus nds_hash_map_for_each(NdsHashMap *map, NdsEntryFunction function, void *context);
+
+
+#endif /* __NDS_HASH_MAP_H__ */
@@ -0,0 +1,351 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * NdsHashSet is a generic unordered set whose elements are unique based on
+ * their hash and an equality function. It uses the same open-addressing
+ * table as NdsHashMap. Besides the operations on single elements, it tests
+ * and inserts whole arrays of elements in batches: the hashes of a batch are
+ * computed and the slots they point to are prefetched before any of them is
+ * probed, so the cache misses of a batch overlap instead of being paid one
+ * after the other.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_HASH_SET_H__
+#define __NDS_HASH_SET_H__
+
+#include <nds/ndsutils.h>
+#include <nds/ndsvector.h>
+
+#include <stddef.h>
+#include <sys/types.h>
+
+
+struct NdsHashSet
+{
+	struct NdsHashSetPrivate *private;
+};
+
+typedef struct NdsHashSet NdsHashSet;
+
+
+/**
+ * Function that creates a new NdsHashSet with room for 13 elements.
+ *
+ * When hash is NULL, the elements are hashed with nds_hash_mix() if they
+ * have 4 or 8 bytes and with nds_hash_bytes() otherwise. When equal is
+ * NULL, the elements are compared bytewise.
+ *
+ * NOTE: Do not forget to call nds_hash_set_destroy() before exiting the scope
+ * of the current NdsHashSet in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the set
+ * @param               hash    function that hashes the elements (can be NULL)
+ * @param              equal    function that compares the elements (can be NULL)
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsHashSet* nds_hash_set_new(size_t sizeof_element, NdsHashFunction hash, NdsEqualFunction equal);
+
+
+/**
+ * Function that creates a new NdsHashSet with room for at least capacity
+ * elements, which obtains all its memory from the given allocator.
+ *
+ * NOTE: Do not forget to call nds_hash_set_destroy() before exiting the scope
+ * of the current NdsHashSet in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the set
+ * @param               hash    function that hashes the elements (can be NULL)
+ * @param              equal    function that compares the elements (can be NULL)
+ * @param           capacity    number of elements the set fits without growing
+ * @param          allocator    allocator used for all the memory of the set
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    linear on capacity
+ */
+NdsHashSet* nds_hash_set_new_with_allocator(size_t sizeof_element, NdsHashFunction hash, NdsEqualFunction equal, size_t capacity, const NdsAllocator *allocator);
+
+
+/**
+ * Function that creates a new NdsHashSet holding the distinct elements of
+ * the NdsVector. The table is sized for all the elements of the vector up
+ * front, so it is allocated once, and the elements are inserted in batches
+ * straight from the buffer of the vector.
+ *
+ * NOTE: Do not forget to call nds_hash_set_destroy() before exiting the scope
+ * of the current NdsHashSet in order to avoid memory leaks!
+ *
+ * @param     vector    pointer to a NdsVector structure
+ * @param       hash    function that hashes the elements (can be NULL)
+ * @param      equal    function that compares the elements (can be NULL)
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    linear
+ */
+NdsHashSet* nds_hash_set_new_from_vector(NdsVector *vector, NdsHashFunction hash, NdsEqualFunction equal);
+
+
+/**
+ * Function that frees the memory occupied by the NdsHashSet.
+ *
+ * @param    set    pointer to a NdsHashSet structure
+ *
+ * @complexity    constant
+ */
+void nds_hash_set_destroy(NdsHashSet *set);
+
+
+/**
+ * Function that returns the number of elements of the NdsHashSet.
+ *
+ * @param     set    pointer to a NdsHashSet structure
+ *
+ * @return    size    the number of elements
+ *              -1    the NdsHashSet is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_hash_set_size(NdsHashSet *set);
+
+
+/**
+ * Function that returns the number of elements the NdsHashSet fits before
+ * it has to grow.
+ *
+ * @param     set    pointer to a NdsHashSet structure
+ *
+ * @return    capacity    the capacity of the NdsHashSet
+ *                  -1    the NdsHashSet is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_hash_set_capacity(NdsHashSet *set);
+
+
+/**
+ * Function that grows the NdsHashSet so that it fits capacity elements
+ * without growing again. The set never shrinks.
+ *
+ * @param          set    pointer to a NdsHashSet structure
+ * @param     capacity    number of elements the set should fit
+ *
+ * @return                     NDS_OK    the set fits capacity elements
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    linear
+ */
+NdsStatus nds_hash_set_reserve(NdsHashSet *set, size_t capacity);
+
+
+/**
+ * Function that adds a copy of the given element to the NdsHashSet, unless
+ * an equal element is already in the set.
+ *
+ * @param        set    pointer to a NdsHashSet structure
+ * @param    element    pointer to the element that will be copied
+ *
+ * @return                     NDS_OK    the element is in the set
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    amortized constant
+ */
+NdsStatus nds_hash_set_insert(NdsHashSet *set, const void *element);
+
+
+/**
+ * Function that adds count elements stored contiguously at the given
+ * address to the NdsHashSet, skipping the ones that are already in the set.
+ * The elements are inserted in batches (see the description of NdsHashSet)
+ * and the set grows with the elements it actually adds, so an array that
+ * repeats a few distinct elements leaves a small set. If inserted is not
+ * NULL, inserted[i] is set to 1 if the i-th element was added and to 0 if it
+ * was already in the set (including when it repeats an earlier element of
+ * the array).
+ *
+ * NOTE: When the elements are known to be distinct, nds_hash_set_reserve()
+ * grows the set for all of them in one step.
+ *
+ * @param         set    pointer to a NdsHashSet structure
+ * @param    elements    pointer to the first element
+ * @param       count    number of elements
+ * @param    inserted    where to store whether every element was added (can be NULL)
+ *
+ * @return    number    the number of elements added to the set
+ *                -1    invalid parameters or memory allocation error
+ *
+ * @complexity    linear on count
+ */
+ssize_t nds_hash_set_insert_batch(NdsHashSet *set, const void *elements, size_t count, unsigned char *inserted);
+
+
+/**
+ * Function that checks if the given element is in the NdsHashSet.
+ *
+ * @param        set    pointer to a NdsHashSet structure
+ * @param    element    pointer to the searched element
+ *
+ * @return    1    the element is in the set
+ *            0    the element is not in the set
+ *           -1    invalid parameters for the function
+ *
+ * @complexity    constant on average
+ */
+int nds_hash_set_contains(NdsHashSet *set, const void *element);
+
+
+/**
+ * Function that checks which of the count elements stored contiguously at
+ * the given address are in the NdsHashSet. The elements are tested in
+ * batches (see the description of NdsHashSet). If found is not NULL,
+ * found[i] is set to 1 if the i-th element is in the set and to 0 otherwise.
+ *
+ * @param         set    pointer to a NdsHashSet structure
+ * @param    elements    pointer to the first element
+ * @param       count    number of elements
+ * @param       found    where to store whether every element is in the set (can be NULL)
+ *
+ * @return    number    the number of elements found in the set
+ *                -1    invalid parameters for the function
+ *
+ * @complexity    linear on count
+ */
+ssize_t nds_hash_set_contains_batch(NdsHashSet *set, const void *elements, size_t count, unsigned char *found);
+
+
+/**
+ * Function that removes the given element from the NdsHashSet.
+ *
+ * @param        set    pointer to a NdsHashSet structure
+ * @param    element    pointer to the element that will be removed
+ *
+ * @return                     NDS_OK    the element was removed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or the element is not in the set
+ *
+ * @complexity    constant on average
+ */
+NdsStatus nds_hash_set_remove(NdsHashSet *set, const void *element);
+
+
+/**
+ * Function that removes all the elements of the NdsHashSet.
+ *
+ * NOTE: The capacity of the set is not affected.
+ *
+ * @param    set    pointer to a NdsHashSet structure
+ *
+ * @return                     NDS_OK    the set was cleared
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    linear on the capacity
+ */
+NdsStatus nds_hash_set_clear(NdsHashSet *set);
+
+
+/**
+ * Function that calls the given function for every element of the
+ * NdsHashSet, in no particular order.
+ *
+ * NOTE: The function must not change the elements, nor add or remove any.
+ *
+ * @param         set    pointer to a NdsHashSet structure
+ * @param    function    function called with the address of every element
+ * @param     context    pointer passed to every call of the function
+ *
+ * @return                     NDS_OK    the elements were visited
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    linear on the capacity
+ */
+NdsStatus nds_hash_set_for_each(NdsHashSet *set, NdsElementFunction function, void *context);
+
+
+/**
+ * Function that creates a new NdsHashSet holding the elements that are in
+ * either of the given sets. The result starts as a copy of the larger set,
+ * sized for both, and the elements of the smaller one are inserted in
+ * batches.
+ *
+ * NOTE: The sets must have the same element size, hash and equality
+ * functions. The result uses the allocator of the first set.
+ *
+ * @param     first    pointer to a NdsHashSet structure
+ * @param    second    pointer to a NdsHashSet structure
+ *
+ * @return    valid pointer    the union of the sets
+ *                     NULL    invalid parameters or memory allocation error
+ *
+ * @complexity    linear on the sizes of the sets
+ */
+NdsHashSet* nds_hash_set_union(NdsHashSet *first, NdsHashSet *second);
+
+
+/**
+ * Function that creates a new NdsHashSet holding the elements that are in
+ * both of the given sets. The elements of the smaller set are looked up in
+ * the larger one in batches.
+ *
+ * NOTE: The sets must have the same element size, hash and equality
+ * functions. The result uses the allocator of the first set.
+ *
+ * @param     first    pointer to a NdsHashSet structure
+ * @param    second    pointer to a NdsHashSet structure
+ *
+ * @return    valid pointer    the intersection of the sets
+ *                     NULL    invalid parameters or memory allocation error
+ *
+ * @complexity    linear on the size of the smaller set
+ */
+NdsHashSet* nds_hash_set_intersection(NdsHashSet *first, NdsHashSet *second);
+
+
+/**
+ * Function that creates a new NdsHashSet holding the elements of the first
+ * set that are not in the second one. The elements of the first set are
+ * looked up in the second one in batches.
+ *
+ * NOTE: The sets must have the same element size, hash and equality
+ * functions. The result uses the allocator of the first set.
+ *
+ * @param     first    pointer to a NdsHashSet structure
+ * @param    second    pointer to a NdsHashSet structure
+ *
+ * @return    valid pointer    the difference of the sets
+ *                     NULL    invalid parameters or memory allocation error
+ *
+ * @complexity    linear on the size of the first set
+ */
+NdsHashSet* nds_hash_set_difference(NdsHashSet *first, NdsHashSet *second);
+
+
+#endif /* __NDS_HASH_SET_H__ */
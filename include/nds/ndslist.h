@@ -0,0 +1,412 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains a doubly-linked list of elements of a fixed size. The
+ * nodes of a NdsList are carved out of slabs that belong to the list and the
+ * released ones are kept in a free list, so adding an element costs no call
+ * to the allocator in the common case and the nodes of a list stay close in
+ * memory even when other containers allocate at the same time.
+ *
+ * A node holds a small array of elements. With one element per node the
+ * list behaves like a classic linked list; an unrolled NdsList stores as
+ * many elements in a node as fit in NDS_LIST_NODE_SIZE bytes, so walking it
+ * follows one pointer and touches a few adjacent cache lines per node
+ * instead of one pointer and one cache line per element.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_LIST_H__
+#define __NDS_LIST_H__
+
+#include <nds/ndsutils.h>
+#include <nds/ndsvector.h>
+
+#include <stddef.h>
+#include <sys/types.h>
+
+
+/* size in bytes of a node of the lists created by nds_list_new_unrolled() */
+#define NDS_LIST_NODE_SIZE 256
+
+
+struct NdsList
+{
+	struct NdsListPrivate *private;
+};
+
+typedef struct NdsList NdsList;
+
+
+/**
+ * NdsListIterator designates an element of a NdsList, or the end of the
+ * list when element is NULL. The end is the position after the last
+ * element, where nds_list_insert() appends.
+ *
+ * NOTE: Removing an element invalidates the iterators to it. In a list with
+ * one element per node the other iterators stay valid, while in an unrolled
+ * list any insertion or removal may move the elements of the nodes around
+ * and invalidates every other iterator.
+ */
+struct NdsListIterator
+{
+	void *element;
+
+	/* position of the element, private to the list */
+	struct NdsListPrivate *list;
+	void *node;
+	size_t index;
+};
+
+typedef struct NdsListIterator NdsListIterator;
+
+
+/**
+ * Function that creates a new empty NdsList that stores one element per
+ * node.
+ *
+ * NOTE: Do not forget to call nds_list_destroy() before exiting the scope of
+ * the current NdsList in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the list
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsList* nds_list_new(size_t sizeof_element);
+
+
+/**
+ * Function that creates a new empty unrolled NdsList, whose nodes hold as
+ * many elements as fit in NDS_LIST_NODE_SIZE bytes, but at least two.
+ *
+ * NOTE: Do not forget to call nds_list_destroy() before exiting the scope of
+ * the current NdsList in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the list
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsList* nds_list_new_unrolled(size_t sizeof_element);
+
+
+/**
+ * Function that creates a new empty NdsList whose slabs are obtained from
+ * the given allocator.
+ *
+ * NOTE: Do not forget to call nds_list_destroy() before exiting the scope of
+ * the current NdsList in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the list
+ * @param      node_capacity    number of elements of a node (0 for the capacity of nds_list_new_unrolled())
+ * @param          allocator    allocator for the memory of the list
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsList* nds_list_new_with_allocator(size_t sizeof_element, size_t node_capacity, const NdsAllocator *allocator);
+
+
+/**
+ * Function that frees the memory occupied by the NdsList.
+ *
+ * @param    list    pointer to a NdsList structure
+ *
+ * @complexity    linear on the number of slabs
+ */
+void nds_list_destroy(NdsList *list);
+
+
+/**
+ * Function that returns the number of elements in the NdsList.
+ *
+ * @param     list    pointer to a NdsList structure
+ *
+ * @return    number    the size of the list
+ *                -1    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+ssize_t nds_list_size(NdsList *list);
+
+
+/**
+ * Function that adds an element at the beginning of the NdsList.
+ *
+ * @param        list    pointer to a NdsList structure
+ * @param     element    pointer to the element that is copied into the list
+ *
+ * @return                     NDS_OK    insertion was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    a new slab could not be allocated
+ *
+ * @complexity    constant (linear on the node capacity for an unrolled list)
+ */
+NdsStatus nds_list_push_front(NdsList *list, const void *element);
+
+
+/**
+ * Function that adds an element at the end of the NdsList.
+ *
+ * @param        list    pointer to a NdsList structure
+ * @param     element    pointer to the element that is copied into the list
+ *
+ * @return                     NDS_OK    insertion was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    a new slab could not be allocated
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_list_push_back(NdsList *list, const void *element);
+
+
+/**
+ * Function that removes the first element of the NdsList.
+ *
+ * @param        list    pointer to a NdsList structure
+ * @param     element    pointer to the memory where the removed element is copied (can be NULL)
+ *
+ * @return                     NDS_OK    removal was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or empty list
+ *
+ * @complexity    constant (linear on the node capacity for an unrolled list)
+ */
+NdsStatus nds_list_pop_front(NdsList *list, void *element);
+
+
+/**
+ * Function that removes the last element of the NdsList.
+ *
+ * @param        list    pointer to a NdsList structure
+ * @param     element    pointer to the memory where the removed element is copied (can be NULL)
+ *
+ * @return                     NDS_OK    removal was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or empty list
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_list_pop_back(NdsList *list, void *element);
+
+
+/**
+ * Function that copies the first element of the NdsList.
+ *
+ * @param        list    pointer to a NdsList structure
+ * @param     element    pointer to the memory where the element is copied
+ *
+ * @return                     NDS_OK    the element was copied
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or empty list
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_list_front(NdsList *list, void *element);
+
+
+/**
+ * Function that copies the last element of the NdsList.
+ *
+ * @param        list    pointer to a NdsList structure
+ * @param     element    pointer to the memory where the element is copied
+ *
+ * @return                     NDS_OK    the element was copied
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or empty list
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_list_back(NdsList *list, void *element);
+
+
+/**
+ * Function that removes all the elements of the NdsList. The nodes go back
+ * to the free list of the list, so the memory is kept for later insertions.
+ *
+ * @param     list    pointer to a NdsList structure
+ *
+ * @return                     NDS_OK    the list was cleared
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_list_clear(NdsList *list);
+
+
+/**
+ * Function that points the iterator to the first element of the NdsList.
+ *
+ * @param         list    pointer to a NdsList structure
+ * @param     iterator    pointer to the iterator that is set
+ *
+ * @return    1    the iterator points to an element
+ *            0    the list is empty, the iterator points to the end
+ *           -1    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+int nds_list_first(NdsList *list, NdsListIterator *iterator);
+
+
+/**
+ * Function that points the iterator to the last element of the NdsList.
+ *
+ * @param         list    pointer to a NdsList structure
+ * @param     iterator    pointer to the iterator that is set
+ *
+ * @return    1    the iterator points to an element
+ *            0    the list is empty, the iterator points to the end
+ *           -1    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+int nds_list_last(NdsList *list, NdsListIterator *iterator);
+
+
+/**
+ * Function that points the iterator to the end of the NdsList.
+ *
+ * @param         list    pointer to a NdsList structure
+ * @param     iterator    pointer to the iterator that is set
+ *
+ * @return                     NDS_OK    the iterator points to the end
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_list_end(NdsList *list, NdsListIterator *iterator);
+
+
+/**
+ * Function that moves the iterator to the next element.
+ *
+ * @param    iterator    pointer to an iterator that points to an element
+ *
+ * @return    1    the iterator points to an element
+ *            0    the iterator reached the end
+ *           -1    invalid parameters or the iterator already was at the end
+ *
+ * @complexity    constant
+ */
+int nds_list_iterator_next(NdsListIterator *iterator);
+
+
+/**
+ * Function that moves the iterator to the previous element. The element
+ * before the end is the last one of the list.
+ *
+ * @param    iterator    pointer to an iterator of a NdsList
+ *
+ * @return    1    the iterator points to an element
+ *            0    there was no previous element, the iterator points to the end
+ *           -1    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+int nds_list_iterator_prev(NdsListIterator *iterator);
+
+
+/**
+ * Function that inserts an element before the position of the iterator and
+ * points the iterator to the new element. Inserting at the end appends.
+ *
+ * NOTE: In an unrolled list, a full node is split in two halves to make
+ * room for the element.
+ *
+ * @param         list    pointer to a NdsList structure
+ * @param     iterator    pointer to an iterator of the list
+ * @param      element    pointer to the element that is copied into the list
+ *
+ * @return                     NDS_OK    insertion was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    a new slab could not be allocated
+ *
+ * @complexity    constant (linear on the node capacity for an unrolled list)
+ */
+NdsStatus nds_list_insert(NdsList *list, NdsListIterator *iterator, const void *element);
+
+
+/**
+ * Function that removes the element the iterator points to and moves the
+ * iterator to the element that followed it.
+ *
+ * NOTE: In an unrolled list, a node is merged with a neighbouring one when both
+ * fit in half a node, so that removals do not leave the nodes almost empty.
+ *
+ * @param         list    pointer to a NdsList structure
+ * @param     iterator    pointer to an iterator that points to an element of the list
+ * @param      element    pointer to the memory where the removed element is copied (can be NULL)
+ *
+ * @return                     NDS_OK    removal was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    constant (linear on the node capacity for an unrolled list)
+ */
+NdsStatus nds_list_erase(NdsList *list, NdsListIterator *iterator, void *element);
+
+
+/**
+ * Function that moves all the elements of other before the position of the
+ * iterator, leaving other empty. No element is copied: the nodes are linked
+ * into the list and the slabs of other are handed over together with them.
+ * The iterator keeps pointing to the same element.
+ *
+ * NOTE: Both lists must have the same element size, node capacity and
+ * allocator. The iterators of other are invalidated.
+ *
+ * @param         list    pointer to a NdsList structure
+ * @param     iterator    pointer to an iterator of the list
+ * @param        other    pointer to the NdsList whose elements are moved
+ *
+ * @return                     NDS_OK    the elements were moved
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    the node of the iterator could not be split
+ *
+ * @complexity    constant (linear on the node capacity for an unrolled list)
+ */
+NdsStatus nds_list_splice(NdsList *list, NdsListIterator *iterator, NdsList *other);
+
+
+/**
+ * Function that calls the given function for every element of the NdsList,
+ * from the first to the last one.
+ *
+ * NOTE: The function must not add or remove elements.
+ *
+ * @param         list    pointer to a NdsList structure
+ * @param     function    function called with every element
+ * @param      context    pointer passed to every call of the function
+ *
+ * @return                     NDS_OK    every element was visited
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    linear
+ */
+NdsStatus nds_list_for_each(NdsList *list, NdsElementFunction function, void *context);
+
+
+#endif /* __NDS_LIST_H__ */
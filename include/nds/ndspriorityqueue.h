@@ -0,0 +1,324 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains a priority queue of elements of a fixed size, stored by
+ * value in an implicit d-ary heap: the children of the element at position i
+ * are the elements at positions d * i + 1 ... d * i + d of one contiguous
+ * buffer. The element that compares lowest is at the top. With the default
+ * arity of 4 the children of an element of 8 to 16 bytes share one or two
+ * cache lines and the heap is half as deep as a binary one, so a pop touches
+ * fewer cache lines even though it compares more children on every level.
+ *
+ * An indexed NdsPriorityQueue also keeps a handle for every element, which
+ * stays valid while the element is in the queue and lets the caller change
+ * its priority or remove it in logarithmic time.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_PRIORITY_QUEUE_H__
+#define __NDS_PRIORITY_QUEUE_H__
+
+#include <nds/ndsutils.h>
+#include <nds/ndsvector.h>
+
+#include <stddef.h>
+#include <sys/types.h>
+
+
+/* arity of the heap of nds_priority_queue_new() and nds_priority_queue_new_from_vector() */
+#define NDS_PRIORITY_QUEUE_ARITY 4
+
+
+struct NdsPriorityQueue
+{
+	struct NdsPriorityQueuePrivate *private;
+};
+
+typedef struct NdsPriorityQueue NdsPriorityQueue;
+
+
+/**
+ * Function that creates a new empty NdsPriorityQueue with a 4-ary heap and
+ * no handles.
+ *
+ * NOTE: Do not forget to call nds_priority_queue_destroy() before exiting
+ * the scope of the current NdsPriorityQueue in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the queue
+ * @param            compare    function that orders the elements, the lowest one is on top
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsPriorityQueue* nds_priority_queue_new(size_t sizeof_element, NdsCompareFunction compare);
+
+
+/**
+ * Function that creates a new empty NdsPriorityQueue with the given arity,
+ * which obtains all its memory from the given allocator.
+ *
+ * NOTE: Do not forget to call nds_priority_queue_destroy() before exiting
+ * the scope of the current NdsPriorityQueue in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the queue
+ * @param            compare    function that orders the elements, the lowest one is on top
+ * @param              arity    number of children of an element of the heap (at least 2)
+ * @param           capacity    number of elements the queue fits without growing
+ * @param            indexed    1 if the elements get handles, 0 otherwise
+ * @param          allocator    allocator used for all the memory of the queue
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsPriorityQueue* nds_priority_queue_new_with_allocator(size_t sizeof_element, NdsCompareFunction compare, size_t arity, size_t capacity, int indexed,
+	const NdsAllocator *allocator);
+
+
+/**
+ * Function that creates a new NdsPriorityQueue with a 4-ary heap and no
+ * handles, which holds copies of the elements of the given NdsVector. The
+ * heap is built bottom-up (Floyd), in linear time. The vector is not
+ * changed.
+ *
+ * NOTE: Do not forget to call nds_priority_queue_destroy() before exiting
+ * the scope of the current NdsPriorityQueue in order to avoid memory leaks!
+ *
+ * @param     vector    pointer to a NdsVector structure
+ * @param    compare    function that orders the elements, the lowest one is on top
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    linear on the size of the vector
+ */
+NdsPriorityQueue* nds_priority_queue_new_from_vector(NdsVector *vector, NdsCompareFunction compare);
+
+
+/**
+ * Function that frees the memory occupied by the NdsPriorityQueue.
+ *
+ * @param    queue    pointer to a NdsPriorityQueue structure
+ *
+ * @complexity    constant
+ */
+void nds_priority_queue_destroy(NdsPriorityQueue *queue);
+
+
+/**
+ * Function that returns the number of elements of the NdsPriorityQueue.
+ *
+ * @param     queue    pointer to a NdsPriorityQueue structure
+ *
+ * @return    size    the number of elements
+ *              -1    the NdsPriorityQueue is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_priority_queue_size(NdsPriorityQueue *queue);
+
+
+/**
+ * Function that makes room for at least capacity elements in the
+ * NdsPriorityQueue.
+ *
+ * @param       queue    pointer to a NdsPriorityQueue structure
+ * @param    capacity    number of elements the queue should fit
+ *
+ * @return    NDS_OK                     the queue fits capacity elements
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *            NDS_MEM_ALLOC_ERROR        memory allocation failure
+ *
+ * @complexity    linear on the size of the queue
+ */
+NdsStatus nds_priority_queue_reserve(NdsPriorityQueue *queue, size_t capacity);
+
+
+/**
+ * Function that adds a copy of the given element to the NdsPriorityQueue.
+ *
+ * @param      queue    pointer to a NdsPriorityQueue structure
+ * @param    element    pointer to the element that will be copied
+ *
+ * @return    NDS_OK                     the element was added
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *            NDS_MEM_ALLOC_ERROR        memory allocation failure
+ *
+ * @complexity    logarithmic on the size of the queue
+ */
+NdsStatus nds_priority_queue_push(NdsPriorityQueue *queue, const void *element);
+
+
+/**
+ * Function that adds copies of the count elements stored contiguously at
+ * the given address to the NdsPriorityQueue. When the elements are at least
+ * as many as the ones already in the queue, the whole heap is rebuilt
+ * bottom-up instead of sifting every element up.
+ *
+ * @param       queue    pointer to a NdsPriorityQueue structure
+ * @param    elements    pointer to the first element
+ * @param       count    number of elements
+ *
+ * @return    NDS_OK                     the elements were added
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *            NDS_MEM_ALLOC_ERROR        memory allocation failure (nothing was added)
+ *
+ * @complexity    linear on the size of the queue or count * logarithmic on the size of the queue, whichever is lower
+ */
+NdsStatus nds_priority_queue_push_n(NdsPriorityQueue *queue, const void *elements, size_t count);
+
+
+/**
+ * Function that copies the element on top of the NdsPriorityQueue, without
+ * removing it.
+ *
+ * @param      queue    pointer to a NdsPriorityQueue structure
+ * @param    element    where to copy the element
+ *
+ * @return    NDS_OK                     the element was copied
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or the queue is empty
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_priority_queue_top(NdsPriorityQueue *queue, void *element);
+
+
+/**
+ * Function that removes the element on top of the NdsPriorityQueue.
+ *
+ * @param      queue    pointer to a NdsPriorityQueue structure
+ * @param    element    where to copy the removed element (can be NULL)
+ *
+ * @return    NDS_OK                     the element was removed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or the queue is empty
+ *
+ * @complexity    logarithmic on the size of the queue
+ */
+NdsStatus nds_priority_queue_pop(NdsPriorityQueue *queue, void *element);
+
+
+/**
+ * Function that removes up to count elements from the top of the
+ * NdsPriorityQueue, in the order in which pop() would remove them.
+ *
+ * @param       queue    pointer to a NdsPriorityQueue structure
+ * @param    elements    where to copy the removed elements (can be NULL)
+ * @param       count    maximum number of elements to remove
+ *
+ * @return    number    the number of removed elements
+ *                -1    invalid parameters for the function
+ *
+ * @complexity    count * logarithmic on the size of the queue
+ */
+ssize_t nds_priority_queue_pop_n(NdsPriorityQueue *queue, void *elements, size_t count);
+
+
+/**
+ * Function that removes all the elements of the NdsPriorityQueue. The
+ * handles of an indexed queue become invalid.
+ *
+ * @param    queue    pointer to a NdsPriorityQueue structure
+ *
+ * @return    NDS_OK                     the queue was cleared
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_priority_queue_clear(NdsPriorityQueue *queue);
+
+
+/**
+ * Function that adds a copy of the given element to an indexed
+ * NdsPriorityQueue and returns its handle. The handle stays valid until the
+ * element is popped or removed, after which it can be given to another
+ * element. The elements added with push() and push_n() also get handles,
+ * but the caller cannot learn them.
+ *
+ * @param      queue    pointer to a NdsPriorityQueue structure
+ * @param    element    pointer to the element that will be copied
+ * @param     handle    where to store the handle of the element
+ *
+ * @return    NDS_OK                     the element was added
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or the queue is not indexed
+ *            NDS_MEM_ALLOC_ERROR        memory allocation failure
+ *
+ * @complexity    logarithmic on the size of the queue
+ */
+NdsStatus nds_priority_queue_insert(NdsPriorityQueue *queue, const void *element, size_t *handle);
+
+
+/**
+ * Function that replaces the element with the given handle of an indexed
+ * NdsPriorityQueue and moves it to its new place in the heap. Decreasing
+ * the key of an element is the usual case, but the new element can also
+ * compare higher than the old one.
+ *
+ * @param      queue    pointer to a NdsPriorityQueue structure
+ * @param     handle    handle of the element
+ * @param    element    pointer to the new element
+ *
+ * @return    NDS_OK                     the element was replaced
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters, the queue is not indexed or the handle is not in use
+ *
+ * @complexity    logarithmic on the size of the queue
+ */
+NdsStatus nds_priority_queue_update(NdsPriorityQueue *queue, size_t handle, const void *element);
+
+
+/**
+ * Function that copies the element with the given handle of an indexed
+ * NdsPriorityQueue.
+ *
+ * @param      queue    pointer to a NdsPriorityQueue structure
+ * @param     handle    handle of the element
+ * @param    element    where to copy the element
+ *
+ * @return    NDS_OK                     the element was copied
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters, the queue is not indexed or the handle is not in use
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_priority_queue_get(NdsPriorityQueue *queue, size_t handle, void *element);
+
+
+/**
+ * Function that removes the element with the given handle from an indexed
+ * NdsPriorityQueue.
+ *
+ * @param      queue    pointer to a NdsPriorityQueue structure
+ * @param     handle    handle of the element
+ * @param    element    where to copy the removed element (can be NULL)
+ *
+ * @return    NDS_OK                     the element was removed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters, the queue is not indexed or the handle is not in use
+ *
+ * @complexity    logarithmic on the size of the queue
+ */
+NdsStatus nds_priority_queue_remove(NdsPriorityQueue *queue, size_t handle, void *element);
+
+
+#endif /* __NDS_PRIORITY_QUEUE_H__ */
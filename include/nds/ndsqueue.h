@@ -0,0 +1,396 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains two FIFO queues of elements of a fixed size, stored by
+ * value in a ring buffer whose capacity is a power of two, so the position
+ * of an element is its index masked with capacity - 1.
+ *
+ * NdsQueue is the general purpose queue. It grows by doubling its buffer and
+ * moving the shorter of the two wrapped parts into the new half, so the
+ * elements are never copied out of the buffer.
+ *
+ * NdsSpscQueue is a bounded lock-free queue between exactly one producer
+ * thread and one consumer thread. Each side owns its index, publishes it
+ * with a release store and reads the other one with an acquire load, and
+ * keeps a cached copy of the other index, so it only touches the cache line
+ * of the other thread when the cached copy says that the queue is full (or
+ * empty). The two sides live on separate cache lines.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_QUEUE_H__
+#define __NDS_QUEUE_H__
+
+#include <nds/ndsutils.h>
+
+#include <stddef.h>
+#include <sys/types.h>
+
+
+struct NdsQueue
+{
+	struct NdsQueuePrivate *private;
+};
+
+typedef struct NdsQueue NdsQueue;
+
+
+struct NdsSpscQueue
+{
+	struct NdsSpscQueuePrivate *private;
+};
+
+typedef struct NdsSpscQueue NdsSpscQueue;
+
+
+/**
+ * Function that creates a new NdsQueue with room for 16 elements.
+ *
+ * NOTE: Do not forget to call nds_queue_destroy() before exiting the scope
+ * of the current NdsQueue in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the queue
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsQueue* nds_queue_new(size_t sizeof_element);
+
+
+/**
+ * Function that creates a new NdsQueue with room for at least capacity
+ * elements (rounded up to a power of two), which obtains all its memory
+ * from the given allocator.
+ *
+ * NOTE: Do not forget to call nds_queue_destroy() before exiting the scope
+ * of the current NdsQueue in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the queue
+ * @param           capacity    number of elements the queue fits without growing
+ * @param          allocator    allocator used for all the memory of the queue
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsQueue* nds_queue_new_with_allocator(size_t sizeof_element, size_t capacity, const NdsAllocator *allocator);
+
+
+/**
+ * Function that frees the memory occupied by the NdsQueue.
+ *
+ * @param    queue    pointer to a NdsQueue structure
+ *
+ * @complexity    constant
+ */
+void nds_queue_destroy(NdsQueue *queue);
+
+
+/**
+ * Function that returns the number of elements of the NdsQueue.
+ *
+ * @param     queue    pointer to a NdsQueue structure
+ *
+ * @return    size    the number of elements
+ *              -1    the NdsQueue is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_queue_size(NdsQueue *queue);
+
+
+/**
+ * Function that returns the number of elements the NdsQueue fits before it
+ * has to grow.
+ *
+ * @param     queue    pointer to a NdsQueue structure
+ *
+ * @return    capacity    the capacity of the NdsQueue
+ *                  -1    the NdsQueue is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_queue_capacity(NdsQueue *queue);
+
+
+/**
+ * Function that grows the NdsQueue so that it fits capacity elements
+ * without growing again. The queue never shrinks.
+ *
+ * @param        queue    pointer to a NdsQueue structure
+ * @param     capacity    number of elements the queue should fit
+ *
+ * @return                     NDS_OK    the queue fits capacity elements
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    linear on the size of the wrapped part of the queue
+ */
+NdsStatus nds_queue_reserve(NdsQueue *queue, size_t capacity);
+
+
+/**
+ * Function that adds a copy of the given element at the back of the
+ * NdsQueue.
+ *
+ * @param      queue    pointer to a NdsQueue structure
+ * @param    element    pointer to the element that will be copied
+ *
+ * @return                     NDS_OK    the element was added
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    amortized constant
+ */
+NdsStatus nds_queue_enqueue(NdsQueue *queue, const void *element);
+
+
+/**
+ * Function that adds copies of count elements stored contiguously at the
+ * given address at the back of the NdsQueue, with at most two copies of
+ * memory and at most one growth of the buffer.
+ *
+ * @param       queue    pointer to a NdsQueue structure
+ * @param    elements    pointer to the first element
+ * @param       count    number of elements
+ *
+ * @return                     NDS_OK    the elements were added
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    linear on count
+ */
+NdsStatus nds_queue_enqueue_n(NdsQueue *queue, const void *elements, size_t count);
+
+
+/**
+ * Function that removes the element at the front of the NdsQueue. If
+ * element is not NULL, the removed element is copied there.
+ *
+ * @param      queue    pointer to a NdsQueue structure
+ * @param    element    where to copy the removed element (can be NULL)
+ *
+ * @return                     NDS_OK    the element was removed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or empty queue
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_queue_dequeue(NdsQueue *queue, void *element);
+
+
+/**
+ * Function that removes up to count elements from the front of the
+ * NdsQueue. If elements is not NULL, the removed elements are copied there
+ * contiguously, in queue order.
+ *
+ * @param       queue    pointer to a NdsQueue structure
+ * @param    elements    where to copy the removed elements (can be NULL)
+ * @param       count    maximum number of elements to remove
+ *
+ * @return    number    the number of removed elements
+ *                -1    invalid parameters for the function
+ *
+ * @complexity    linear on the number of removed elements
+ */
+ssize_t nds_queue_dequeue_n(NdsQueue *queue, void *elements, size_t count);
+
+
+/**
+ * Function that copies the element at the front of the NdsQueue without
+ * removing it.
+ *
+ * @param      queue    pointer to a NdsQueue structure
+ * @param    element    where to copy the element
+ *
+ * @return                     NDS_OK    the element was copied
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or empty queue
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_queue_front(NdsQueue *queue, void *element);
+
+
+/**
+ * Function that removes all the elements of the NdsQueue.
+ *
+ * NOTE: The capacity of the queue is not affected.
+ *
+ * @param    queue    pointer to a NdsQueue structure
+ *
+ * @return                     NDS_OK    the queue was cleared
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_queue_clear(NdsQueue *queue);
+
+
+/**
+ * Function that creates a new NdsSpscQueue with room for capacity elements
+ * (rounded up to a power of two). The capacity never changes.
+ *
+ * NOTE: Do not forget to call nds_spsc_queue_destroy() before exiting the
+ * scope of the current NdsSpscQueue in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the queue
+ * @param           capacity    number of elements the queue fits
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsSpscQueue* nds_spsc_queue_new(size_t sizeof_element, size_t capacity);
+
+
+/**
+ * Function that creates a new NdsSpscQueue with room for capacity elements
+ * (rounded up to a power of two), which obtains its memory from the given
+ * allocator.
+ *
+ * NOTE: Do not forget to call nds_spsc_queue_destroy() before exiting the
+ * scope of the current NdsSpscQueue in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the queue
+ * @param           capacity    number of elements the queue fits
+ * @param          allocator    allocator used for all the memory of the queue
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsSpscQueue* nds_spsc_queue_new_with_allocator(size_t sizeof_element, size_t capacity, const NdsAllocator *allocator);
+
+
+/**
+ * Function that frees the memory occupied by the NdsSpscQueue. Neither the
+ * producer nor the consumer may use the queue any more.
+ *
+ * @param    queue    pointer to a NdsSpscQueue structure
+ *
+ * @complexity    constant
+ */
+void nds_spsc_queue_destroy(NdsSpscQueue *queue);
+
+
+/**
+ * Function that returns the number of elements the NdsSpscQueue fits.
+ *
+ * @param     queue    pointer to a NdsSpscQueue structure
+ *
+ * @return    capacity    the capacity of the NdsSpscQueue
+ *                  -1    the NdsSpscQueue is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_spsc_queue_capacity(NdsSpscQueue *queue);
+
+
+/**
+ * Function that returns the number of elements of the NdsSpscQueue. It can
+ * be called from both threads, but the size may change as soon as it is
+ * read.
+ *
+ * @param     queue    pointer to a NdsSpscQueue structure
+ *
+ * @return    size    the number of elements
+ *              -1    the NdsSpscQueue is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_spsc_queue_size(NdsSpscQueue *queue);
+
+
+/**
+ * Function that adds a copy of the given element at the back of the
+ * NdsSpscQueue, unless the queue is full. Only the producer thread may call
+ * it.
+ *
+ * @param      queue    pointer to a NdsSpscQueue structure
+ * @param    element    pointer to the element that will be copied
+ *
+ * @return    1    the element was added
+ *            0    the queue is full
+ *           -1    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+int nds_spsc_queue_try_enqueue(NdsSpscQueue *queue, const void *element);
+
+
+/**
+ * Function that adds copies of as many of the count elements stored
+ * contiguously at the given address as fit in the NdsSpscQueue, and
+ * publishes all of them at once. Only the producer thread may call it.
+ *
+ * @param       queue    pointer to a NdsSpscQueue structure
+ * @param    elements    pointer to the first element
+ * @param       count    number of elements
+ *
+ * @return    number    the number of added elements, from the first one
+ *                -1    invalid parameters for the function
+ *
+ * @complexity    linear on the number of added elements
+ */
+ssize_t nds_spsc_queue_enqueue_n(NdsSpscQueue *queue, const void *elements, size_t count);
+
+
+/**
+ * Function that removes the element at the front of the NdsSpscQueue,
+ * unless the queue is empty. Only the consumer thread may call it.
+ *
+ * @param      queue    pointer to a NdsSpscQueue structure
+ * @param    element    where to copy the removed element (can be NULL)
+ *
+ * @return    1    the element was removed
+ *            0    the queue is empty
+ *           -1    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+int nds_spsc_queue_try_dequeue(NdsSpscQueue *queue, void *element);
+
+
+/**
+ * Function that removes up to count elements from the front of the
+ * NdsSpscQueue and releases their slots at once. Only the consumer thread
+ * may call it.
+ *
+ * @param       queue    pointer to a NdsSpscQueue structure
+ * @param    elements    where to copy the removed elements (can be NULL)
+ * @param       count    maximum number of elements to remove
+ *
+ * @return    number    the number of removed elements
+ *                -1    invalid parameters for the function
+ *
+ * @complexity    linear on the number of removed elements
+ */
+ssize_t nds_spsc_queue_dequeue_n(NdsSpscQueue *queue, void *elements, size_t count);
+
+
+#endif /* __NDS_QUEUE_H__ */
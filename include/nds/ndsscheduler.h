@@ -0,0 +1,245 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * NdsScheduler is a work-stealing task scheduler that runs the parallel
+ * algorithms of the NDS library. Every worker thread owns a Chase-Lev deque:
+ * it pushes and pops the tasks it spawns at one end, while idle workers
+ * steal the oldest tasks from the other end. Threads that are not workers of
+ * a scheduler can spawn and wait for its tasks too; they help run tasks
+ * while they wait.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_SCHEDULER_H__
+#define __NDS_SCHEDULER_H__
+
+#include <nds/ndsutils.h>
+
+#include <stddef.h>
+#include <sys/types.h>
+
+
+/* largest number of threads used by a scheduler */
+#define NDS_MAX_WORKERS 256
+
+
+struct NdsScheduler
+{
+	struct NdsSchedulerPrivate *private;
+};
+
+typedef struct NdsScheduler NdsScheduler;
+
+
+/* function run by a task spawned with nds_task_spawn() */
+typedef void (*NdsTaskRoutine)(void *context);
+
+/* function that processes the indexes from begin to end - 1 (see nds_parallel_for()) */
+typedef void (*NdsRangeFunction)(size_t begin, size_t end, void *context);
+
+/* function that runs the task with the given index (see nds_parallel_run()) */
+typedef void (*NdsTaskFunction)(size_t index, void *context);
+
+
+/**
+ * NdsTask is the storage of a spawned task. It is provided by the caller,
+ * usually on the stack of the function that spawns the task and waits for
+ * it, so spawning a task does not allocate memory.
+ *
+ * NOTE: The fields are private to the scheduler. The task must stay valid
+ * until nds_task_wait() returns for it.
+ */
+struct NdsTask
+{
+	NdsTaskRoutine routine;
+	void *context;
+	struct NdsTask *next;
+	int done;
+};
+
+typedef struct NdsTask NdsTask;
+
+
+/**
+ * Function that creates a new NdsScheduler which starts the given number of
+ * worker threads. The threads that wait for tasks also run them, so a
+ * scheduler without workers runs every task in the threads that wait.
+ *
+ * NOTE: Do not forget to call nds_scheduler_destroy() before exiting the
+ * scope of the current NdsScheduler in order to avoid leaking its threads!
+ *
+ * @param     threads    number of worker threads
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    linear on the number of threads
+ */
+NdsScheduler* nds_scheduler_new(size_t threads);
+
+
+/**
+ * Function that stops the worker threads of the NdsScheduler and frees the
+ * memory occupied by it.
+ *
+ * NOTE: Every spawned task must have been waited for.
+ *
+ * @param     scheduler    pointer to a NdsScheduler structure
+ *
+ * @complexity    linear on the number of threads
+ */
+void nds_scheduler_destroy(NdsScheduler *scheduler);
+
+
+/**
+ * Function that returns the scheduler shared by the parallel algorithms of
+ * the library, which is created on first use with nds_get_worker_count() - 1
+ * worker threads (the calling thread makes up the last one).
+ *
+ * @return    valid pointer    the default scheduler
+ *                     NULL    the scheduler could not be created
+ *
+ * @complexity    constant
+ */
+NdsScheduler* nds_scheduler_default(void);
+
+
+/**
+ * Function that returns the number of worker threads of the NdsScheduler.
+ *
+ * @param     scheduler    pointer to a NdsScheduler structure
+ *
+ * @return    number of worker threads or -1 if the scheduler is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_scheduler_thread_count(NdsScheduler *scheduler);
+
+
+/**
+ * Function that spawns a task which runs routine(context). A worker thread
+ * pushes the task on its own deque, from where it is either popped again by
+ * nds_task_wait() or stolen by an idle worker. The tasks spawned by other
+ * threads go to a queue shared by the whole scheduler.
+ *
+ * @param     scheduler    pointer to a NdsScheduler structure
+ * @param          task    storage of the task
+ * @param       routine    function run by the task
+ * @param       context    pointer passed to routine
+ *
+ * @return                     NDS_OK    the task was spawned
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    amortized constant
+ */
+NdsStatus nds_task_spawn(NdsScheduler *scheduler, NdsTask *task, NdsTaskRoutine routine, void *context);
+
+
+/**
+ * Function that returns once the task has finished. Until then the calling
+ * thread runs other tasks of the scheduler, starting with the ones it spawned
+ * itself, so waiting threads do not sit idle.
+ *
+ * @param     scheduler    pointer to a NdsScheduler structure
+ * @param          task    a task spawned on the scheduler
+ *
+ * @return                     NDS_OK    the task has finished
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    depends on the tasks
+ */
+NdsStatus nds_task_wait(NdsScheduler *scheduler, NdsTask *task);
+
+
+/**
+ * Function that calls function on subranges that cover the indexes from
+ * begin to end - 1, on the threads of the NdsScheduler. A range is split in
+ * half, with one half spawned as a task, only while it is longer than grain
+ * and the deque of the thread is nearly empty, which is the case when other
+ * threads have stolen its work. The ranges therefore stay large when all
+ * the threads are busy and get smaller when some of them are idle.
+ *
+ * @param     scheduler    pointer to a NdsScheduler structure
+ * @param         begin    first index
+ * @param           end    index after the last one
+ * @param         grain    shortest range that is split, 0 for a grain based on the number of threads
+ * @param      function    function that processes a range
+ * @param       context    pointer passed to every call of function
+ *
+ * @return                     NDS_OK    all the indexes were processed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    linear on the number of indexes
+ */
+NdsStatus nds_parallel_for(NdsScheduler *scheduler, size_t begin, size_t end, size_t grain, NdsRangeFunction function, void *context);
+
+
+/**
+ * Function that sets the number of threads used by the parallel algorithms
+ * of the library, counting the thread that calls them. The default scheduler
+ * is destroyed and created again with the new count on its next use.
+ *
+ * NOTE: The count must not be changed while a parallel algorithm runs.
+ *
+ * @param     count    number of threads, 0 for one per online processor
+ *
+ * @return                     NDS_OK    the count was set
+ *            NDS_INVALID_PARAM_ERROR    count is above NDS_MAX_WORKERS
+ *
+ * @complexity    linear on the number of running workers
+ */
+NdsStatus nds_set_worker_count(size_t count);
+
+
+/**
+ * Function that returns the number of threads used by the parallel
+ * algorithms of the library, counting the thread that calls them.
+ *
+ * @return    number of threads
+ *
+ * @complexity    constant
+ */
+size_t nds_get_worker_count(void);
+
+
+/**
+ * Function that runs the tasks with indexes from 0 to tasks - 1 on the
+ * default scheduler, every index as a range of its own (see
+ * nds_parallel_for()), and returns once all of them have finished. It may
+ * be called from a task, in which case the nested tasks are stolen by the
+ * threads that run out of work.
+ *
+ * @param        tasks    number of tasks
+ * @param     function    function that runs a task
+ * @param      context    pointer passed to every task
+ *
+ * @return                     NDS_OK    all the tasks were run
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    linear on the number of tasks
+ */
+NdsStatus nds_parallel_run(size_t tasks, NdsTaskFunction function, void *context);
+
+
+#endif /* __NDS_SCHEDULER_H__ */
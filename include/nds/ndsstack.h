@@ -0,0 +1,231 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains a LIFO stack of elements of a fixed size, stored by
+ * value in a chain of chunks. When the top chunk is full, a new chunk twice
+ * as large (up to NDS_STACK_MAX_CHUNK_SIZE bytes) is linked on top of it, so
+ * a push never moves the elements that are already on the stack and the
+ * latency of a push does not grow with the depth of the stack.
+ *
+ * The chunk emptied last is kept aside and reused by the next growth, so a
+ * stack whose size goes back and forth across the end of a chunk does not
+ * allocate and free a chunk at every crossing.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_STACK_H__
+#define __NDS_STACK_H__
+
+#include <nds/ndsutils.h>
+
+#include <stddef.h>
+#include <sys/types.h>
+
+
+/* capacity of the first chunk of nds_stack_new() */
+#define NDS_STACK_MIN_CAPACITY 16
+
+/* size in bytes above which the chunks stop growing */
+#define NDS_STACK_MAX_CHUNK_SIZE (16 * 1024 * 1024)
+
+
+struct NdsStack
+{
+	struct NdsStackPrivate *private;
+};
+
+typedef struct NdsStack NdsStack;
+
+
+/**
+ * Function that creates a new NdsStack whose first chunk has room for 16
+ * elements.
+ *
+ * NOTE: Do not forget to call nds_stack_destroy() before exiting the scope
+ * of the current NdsStack in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the stack
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsStack* nds_stack_new(size_t sizeof_element);
+
+
+/**
+ * Function that creates a new NdsStack whose first chunk has room for
+ * capacity elements, which obtains all its memory from the given allocator.
+ *
+ * NOTE: Do not forget to call nds_stack_destroy() before exiting the scope
+ * of the current NdsStack in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the stack
+ * @param           capacity    number of elements of the first chunk (0 for the default)
+ * @param          allocator    allocator used for all the memory of the stack
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsStack* nds_stack_new_with_allocator(size_t sizeof_element, size_t capacity, const NdsAllocator *allocator);
+
+
+/**
+ * Function that frees the memory occupied by the NdsStack.
+ *
+ * @param    stack    pointer to a NdsStack structure
+ *
+ * @complexity    linear on the number of chunks
+ */
+void nds_stack_destroy(NdsStack *stack);
+
+
+/**
+ * Function that returns the number of elements of the NdsStack.
+ *
+ * @param     stack    pointer to a NdsStack structure
+ *
+ * @return    size    the number of elements
+ *              -1    the NdsStack is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_stack_size(NdsStack *stack);
+
+
+/**
+ * Function that returns the number of elements the NdsStack fits before it
+ * has to allocate another chunk, counting the chunk kept aside for reuse.
+ *
+ * @param     stack    pointer to a NdsStack structure
+ *
+ * @return    capacity    the capacity of the NdsStack
+ *                  -1    the NdsStack is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_stack_capacity(NdsStack *stack);
+
+
+/**
+ * Function that adds a copy of the given element on top of the NdsStack.
+ *
+ * @param      stack    pointer to a NdsStack structure
+ * @param    element    pointer to the element that will be copied
+ *
+ * @return                     NDS_OK    the element was added
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_stack_push(NdsStack *stack, const void *element);
+
+
+/**
+ * Function that adds copies of count elements stored contiguously at the
+ * given address on top of the NdsStack, in that order, so the last of them
+ * becomes the top. The elements are copied with one copy of memory per
+ * chunk they span. If a chunk cannot be allocated, none of the elements
+ * are added.
+ *
+ * @param       stack    pointer to a NdsStack structure
+ * @param    elements    pointer to the first element
+ * @param       count    number of elements
+ *
+ * @return                     NDS_OK    the elements were added
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    linear on count
+ */
+NdsStatus nds_stack_push_n(NdsStack *stack, const void *elements, size_t count);
+
+
+/**
+ * Function that removes the element on top of the NdsStack. If element is
+ * not NULL, the removed element is copied there.
+ *
+ * @param      stack    pointer to a NdsStack structure
+ * @param    element    where to copy the removed element (can be NULL)
+ *
+ * @return                     NDS_OK    the element was removed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or empty stack
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_stack_pop(NdsStack *stack, void *element);
+
+
+/**
+ * Function that removes up to count elements from the top of the NdsStack.
+ * If elements is not NULL, the removed elements are copied there
+ * contiguously in the order they were pushed, so the former top element is
+ * the last one and nds_stack_pop_n() undoes nds_stack_push_n().
+ *
+ * @param       stack    pointer to a NdsStack structure
+ * @param    elements    where to copy the removed elements (can be NULL)
+ * @param       count    maximum number of elements to remove
+ *
+ * @return    number    the number of removed elements
+ *                -1    invalid parameters for the function
+ *
+ * @complexity    linear on the number of removed elements
+ */
+ssize_t nds_stack_pop_n(NdsStack *stack, void *elements, size_t count);
+
+
+/**
+ * Function that copies the element on top of the NdsStack without removing
+ * it.
+ *
+ * @param      stack    pointer to a NdsStack structure
+ * @param    element    where to copy the element
+ *
+ * @return                     NDS_OK    the element was copied
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or empty stack
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_stack_top(NdsStack *stack, void *element);
+
+
+/**
+ * Function that removes all the elements of the NdsStack.
+ *
+ * NOTE: Only the first chunk of the stack is kept, all the others are freed.
+ *
+ * @param    stack    pointer to a NdsStack structure
+ *
+ * @return                     NDS_OK    the stack was cleared
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    linear on the number of chunks
+ */
+NdsStatus nds_stack_clear(NdsStack *stack);
+
+#endif /* __NDS_STACK_H__ */
@@ -0,0 +1,357 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * NdsTreeMap is an ordered dictionary of key-value pairs stored in a
+ * B+-tree. A node holds up to a few dozen keys in a contiguous array and is
+ * aligned to a cache line, so a lookup touches a handful of cache lines per
+ * level instead of one node per comparison like a binary tree. The pairs
+ * are kept in the leaves, which are linked in key order, so range scans walk
+ * the leaves sequentially without going back up the tree.
+ *
+ * The keys are ordered either by a comparison function or, for the numeric
+ * key types of NdsKeyType, natively: the position of a numeric key in a node
+ * is found by counting the smaller keys in a branch-free loop the compiler
+ * vectorizes.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_TREE_MAP_H__
+#define __NDS_TREE_MAP_H__
+
+#include <nds/ndsutils.h>
+#include <nds/ndsvector.h>
+
+#include <stddef.h>
+#include <sys/types.h>
+
+
+struct NdsTreeMap
+{
+	struct NdsTreeMapPrivate *private;
+};
+
+typedef struct NdsTreeMap NdsTreeMap;
+
+
+/**
+ * NdsTreeMapIterator designates a pair of a NdsTreeMap, or the end of the
+ * map when key is NULL. The key must not be changed through the iterator,
+ * the value may. An iterator is invalidated by any insertion or removal.
+ */
+struct NdsTreeMapIterator
+{
+	const void *key;
+	void *value;
+
+	/* position of the pair, private to the map */
+	struct NdsTreeMapPrivate *map;
+	void *node;
+	size_t index;
+};
+
+typedef struct NdsTreeMapIterator NdsTreeMapIterator;
+
+
+/**
+ * Function that creates a new NdsTreeMap whose keys are ordered by the
+ * given comparison function.
+ *
+ * NOTE: Do not forget to call nds_tree_map_destroy() before exiting the scope
+ * of the current NdsTreeMap in order to avoid memory leaks!
+ *
+ * @param       sizeof_key    size of one key
+ * @param     sizeof_value    size of one value (can be 0)
+ * @param          compare    function that orders the keys
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsTreeMap* nds_tree_map_new(size_t sizeof_key, size_t sizeof_value, NdsCompareFunction compare);
+
+
+/**
+ * Function that creates a new NdsTreeMap whose keys are ordered by the
+ * given comparison function, which obtains all its memory from the given
+ * allocator.
+ *
+ * NOTE: Do not forget to call nds_tree_map_destroy() before exiting the scope
+ * of the current NdsTreeMap in order to avoid memory leaks!
+ *
+ * @param       sizeof_key    size of one key
+ * @param     sizeof_value    size of one value (can be 0)
+ * @param          compare    function that orders the keys
+ * @param        allocator    allocator used for all the memory of the map
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsTreeMap* nds_tree_map_new_with_allocator(size_t sizeof_key, size_t sizeof_value, NdsCompareFunction compare, const NdsAllocator *allocator);
+
+
+/**
+ * Function that creates a new NdsTreeMap with numeric keys, which are
+ * ordered like numbers without a comparison function.
+ *
+ * NOTE: NaN keys are not supported by the floating point key types.
+ *
+ * NOTE: Do not forget to call nds_tree_map_destroy() before exiting the scope
+ * of the current NdsTreeMap in order to avoid memory leaks!
+ *
+ * @param         key_type    type of the keys
+ * @param     sizeof_value    size of one value (can be 0)
+ * @param        allocator    allocator used for all the memory of the map
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsTreeMap* nds_tree_map_new_with_key_type(NdsKeyType key_type, size_t sizeof_value, const NdsAllocator *allocator);
+
+
+/**
+ * Function that frees the memory occupied by the NdsTreeMap.
+ *
+ * @param    map    pointer to a NdsTreeMap structure
+ *
+ * @complexity    linear on the number of nodes
+ */
+void nds_tree_map_destroy(NdsTreeMap *map);
+
+
+/**
+ * Function that returns the number of pairs of the NdsTreeMap.
+ *
+ * @param     map    pointer to a NdsTreeMap structure
+ *
+ * @return    size    the number of pairs
+ *              -1    the NdsTreeMap is invalid
+ *
+ * @complexity    constant
+ */
+ssize_t nds_tree_map_size(NdsTreeMap *map);
+
+
+/**
+ * Function that replaces the content of the NdsTreeMap with the pairs of
+ * the NdsVector, whose elements are records holding a key at offset 0 and
+ * its value at value_offset, sorted by strictly increasing keys. The tree is
+ * built bottom up with full nodes, which are obtained in one allocation.
+ *
+ * @param              map    pointer to a NdsTreeMap structure
+ * @param           vector    pointer to a NdsVector structure holding the sorted records
+ * @param     value_offset    offset in bytes of the value inside a record
+ *
+ * @return                     NDS_OK    the map holds the pairs of the vector
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters, or the keys are not strictly increasing
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    linear
+ */
+NdsStatus nds_tree_map_bulk_load(NdsTreeMap *map, NdsVector *vector, size_t value_offset);
+
+
+/**
+ * Function that adds a copy of the given pair to the NdsTreeMap. If the key
+ * is already in the map, its value is overwritten.
+ *
+ * @param      map    pointer to a NdsTreeMap structure
+ * @param      key    pointer to the key that will be copied
+ * @param    value    pointer to the value that will be copied (can be NULL if sizeof_value is 0)
+ *
+ * @return                     NDS_OK    the pair is in the map
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    logarithmic
+ */
+NdsStatus nds_tree_map_insert(NdsTreeMap *map, const void *key, const void *value);
+
+
+/**
+ * Function that returns the address of the value stored for the given key
+ * in the NdsTreeMap. The address is invalidated by any insertion or removal.
+ *
+ * @param    map    pointer to a NdsTreeMap structure
+ * @param    key    pointer to the searched key
+ *
+ * @return    valid pointer    the value of the key
+ *                     NULL    the key is not in the map or invalid parameters
+ *
+ * @complexity    logarithmic
+ */
+void* nds_tree_map_find(NdsTreeMap *map, const void *key);
+
+
+/**
+ * Function that copies the value stored for the given key in the
+ * NdsTreeMap.
+ *
+ * @param      map    pointer to a NdsTreeMap structure
+ * @param      key    pointer to the searched key
+ * @param    value    where the value will be copied
+ *
+ * @return                     NDS_OK    the value was copied
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or the key is not in the map
+ *
+ * @complexity    logarithmic
+ */
+NdsStatus nds_tree_map_get(NdsTreeMap *map, const void *key, void *value);
+
+
+/**
+ * Function that checks if the given key is in the NdsTreeMap.
+ *
+ * @param    map    pointer to a NdsTreeMap structure
+ * @param    key    pointer to the searched key
+ *
+ * @return    1    the key is in the map
+ *            0    the key is not in the map
+ *           -1    invalid parameters for the function
+ *
+ * @complexity    logarithmic
+ */
+int nds_tree_map_contains(NdsTreeMap *map, const void *key);
+
+
+/**
+ * Function that removes the pair of the given key from the NdsTreeMap.
+ *
+ * @param      map    pointer to a NdsTreeMap structure
+ * @param      key    pointer to the key of the pair that will be removed
+ * @param    value    where the value of the pair will be copied (can be NULL)
+ *
+ * @return                     NDS_OK    the pair was removed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or the key is not in the map
+ *
+ * @complexity    logarithmic
+ */
+NdsStatus nds_tree_map_remove(NdsTreeMap *map, const void *key, void *value);
+
+
+/**
+ * Function that removes all the pairs of the NdsTreeMap. The nodes are kept
+ * for the next insertions.
+ *
+ * @param    map    pointer to a NdsTreeMap structure
+ *
+ * @return                     NDS_OK    the map was cleared
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    linear on the number of nodes
+ */
+NdsStatus nds_tree_map_clear(NdsTreeMap *map);
+
+
+/**
+ * Function that points the iterator to the pair with the smallest key of
+ * the NdsTreeMap.
+ *
+ * @param         map    pointer to a NdsTreeMap structure
+ * @param    iterator    pointer to the iterator that is set
+ *
+ * @return    1    the iterator points to a pair
+ *            0    the map is empty, the iterator points to the end
+ *           -1    invalid parameters for the function
+ *
+ * @complexity    logarithmic
+ */
+int nds_tree_map_first(NdsTreeMap *map, NdsTreeMapIterator *iterator);
+
+
+/**
+ * Function that points the iterator to the first pair of the NdsTreeMap
+ * whose key is not less than the given key.
+ *
+ * @param         map    pointer to a NdsTreeMap structure
+ * @param         key    pointer to the searched key
+ * @param    iterator    pointer to the iterator that is set
+ *
+ * @return    1    the iterator points to a pair
+ *            0    every key is less than the given one, the iterator points to the end
+ *           -1    invalid parameters for the function
+ *
+ * @complexity    logarithmic
+ */
+int nds_tree_map_lower_bound(NdsTreeMap *map, const void *key, NdsTreeMapIterator *iterator);
+
+
+/**
+ * Function that points the iterator to the first pair of the NdsTreeMap
+ * whose key is greater than the given key.
+ *
+ * @param         map    pointer to a NdsTreeMap structure
+ * @param         key    pointer to the searched key
+ * @param    iterator    pointer to the iterator that is set
+ *
+ * @return    1    the iterator points to a pair
+ *            0    no key is greater than the given one, the iterator points to the end
+ *           -1    invalid parameters for the function
+ *
+ * @complexity    logarithmic
+ */
+int nds_tree_map_upper_bound(NdsTreeMap *map, const void *key, NdsTreeMapIterator *iterator);
+
+
+/**
+ * Function that moves the iterator to the pair with the next key.
+ *
+ * @param    iterator    pointer to an iterator that points to a pair
+ *
+ * @return    1    the iterator points to a pair
+ *            0    the iterator reached the end
+ *           -1    invalid parameters or the iterator already was at the end
+ *
+ * @complexity    amortized constant
+ */
+int nds_tree_map_iterator_next(NdsTreeMapIterator *iterator);
+
+
+/**
+ * Function that calls the given function for every pair of the NdsTreeMap
+ * whose key is in [low, high), in key order. A NULL bound leaves that side
+ * of the range open, so both NULL visit the whole map. The keys of a leaf
+ * are only compared with high when the last of them is not below it.
+ *
+ * NOTE: The function must not add or remove pairs.
+ *
+ * @param         map    pointer to a NdsTreeMap structure
+ * @param         low    pointer to the smallest key of the range (can be NULL)
+ * @param        high    pointer to the key that ends the range (can be NULL)
+ * @param    function    function called with the key and the value of every pair
+ * @param     context    pointer passed to every call of the function
+ *
+ * @return    number    the number of visited pairs
+ *                -1    invalid parameters for the function
+ *
+ * @complexity    logarithmic plus linear on the number of visited pairs
+ */
+ssize_t nds_tree_map_range(NdsTreeMap *map, const void *low, const void *high, NdsEntryFunction function, void *context);
+
+
+#endif /* __NDS_TREE_MAP_H__ */
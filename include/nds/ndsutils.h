@@ -23,12 +23,19 @@
  *
  * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
  * @created     23 February 2018
- * @modified    23 February 2018
+ * @modified    17 October 2026
  */
 
 #ifndef __NDS_UTILS_H__
 #define __NDS_UTILS_H__
 
+#include <stddef.h>
+#include <stdint.h>
+
+
+/* size in bytes of a cache line, the unit in which data shared between threads is split */
+#define NDS_CACHE_LINE_SIZE 64
+
 
 enum NdsStatus
 {
@@ -41,4 +48,253 @@ enum NdsStatus
 typedef enum NdsStatus NdsStatus;
 
 
+/**
+ * Function type that compares two elements of a container. It returns a
+ * negative value if the first element goes before the second one, zero if
+ * they are equivalent and a positive value otherwise, like for qsort().
+ */
+typedef int (*NdsCompareFunction)(const void *first, const void *second);
+
+/**
+ * Function type that computes the hash of a key. Keys that are equal must
+ * have the same hash and all 64 bits of the result should be well mixed,
+ * since the hashed containers use both the low and the high bits.
+ */
+typedef uint64_t (*NdsHashFunction)(const void *key);
+
+/**
+ * Function type that checks if two keys are equal. It returns a non-zero
+ * value if they are and 0 otherwise.
+ */
+typedef int (*NdsEqualFunction)(const void *first, const void *second);
+
+/**
+ * Function type called for every pair visited in a dictionary, such as by
+ * nds_hash_map_for_each(). The value may be changed, the key must not.
+ */
+typedef void (*NdsEntryFunction)(const void *key, void *value, void *context);
+
+
+/**
+ * NdsAllocator is the interface through which the containers of the library
+ * obtain and release memory. Every function receives the context pointer of
+ * the allocator together with the sizes of the blocks, so allocators that do
+ * not keep per-block headers (such as NdsArena and NdsPool) can be plugged in.
+ *
+ * NOTE: The allocator is copied by the containers, but the memory its context
+ * points to must outlive every container created with it.
+ */
+struct NdsAllocator
+{
+	void* (*alloc)(void *context, size_t size);
+	void* (*realloc)(void *context, void *pointer, size_t old_size, size_t new_size);
+	void (*free)(void *context, void *pointer, size_t size);
+	void *context;
+};
+
+typedef struct NdsAllocator NdsAllocator;
+
+
+/**
+ * Function that computes the capacity a container grows to when it needs
+ * room for required elements. The current capacity is doubled, so repeated
+ * appends have amortized constant cost, unless required is even larger.
+ *
+ * @param     capacity    current capacity of the container
+ * @param     required    number of elements the container must fit
+ *
+ * @return    the new capacity of the container
+ *
+ * @complexity    constant
+ */
+static inline size_t nds_grow_capacity(size_t capacity, size_t required)
+{
+	/* the doubling saturates instead of wrapping around */
+	capacity = capacity > SIZE_MAX / 2 ? SIZE_MAX : capacity * 2;
+
+	return capacity < required ? required : capacity;
+}
+
+
+/**
+ * Function that checks if count elements of size bytes each need more bytes
+ * than a size_t can hold, so that computing count * size would wrap around.
+ *
+ * @param     count    number of elements
+ * @param      size    size in bytes of an element
+ *
+ * @return    1 if the product overflows, 0 otherwise
+ *
+ * @complexity    constant
+ */
+static inline int nds_size_overflows(size_t count, size_t size)
+{
+	return size != 0 && count > SIZE_MAX / size;
+}
+
+
+/**
+ * Function that mixes the bits of a 64-bit value so that every bit of the
+ * result depends on every bit of the value (the finalizer of MurmurHash3).
+ * It is the hash the containers use for keys of 4 and 8 bytes.
+ *
+ * @param     value    the value to mix
+ *
+ * @return    the mixed value
+ *
+ * @complexity    constant
+ */
+static inline uint64_t nds_hash_mix(uint64_t value)
+{
+	value ^= value >> 33;
+	value *= 0xff51afd7ed558ccdULL;
+	value ^= value >> 33;
+	value *= 0xc4ceb9fe1a85ec53ULL;
+	value ^= value >> 33;
+
+	return value;
+}
+
+
+/**
+ * Function that computes the hash of size bytes found at the given address.
+ * It is the hash the containers use for keys when no NdsHashFunction is
+ * given.
+ *
+ * @param     data    address of the first byte
+ * @param     size    number of bytes to hash
+ *
+ * @return    the hash of the bytes
+ *
+ * @complexity    linear on size
+ */
+uint64_t nds_hash_bytes(const void *data, size_t size);
+
+
+struct NdsArena
+{
+	struct NdsArenaPrivate *private;
+};
+
+typedef struct NdsArena NdsArena;
+
+
+struct NdsPool
+{
+	struct NdsPoolPrivate *private;
+};
+
+typedef struct NdsPool NdsPool;
+
+
+/**
+ * Function that returns the allocator backed by malloc(), realloc() and
+ * free() which is used by the containers when no allocator is given.
+ *
+ * @return    pointer to the default NdsAllocator
+ *
+ * @complexity    constant
+ */
+const NdsAllocator* nds_allocator_default(void);
+
+
+/**
+ * Function that creates a new NdsArena, a bump allocator that hands out
+ * memory from chunks of chunk_size bytes. Individual blocks are never given
+ * back to the system; all of them are released at once by nds_arena_reset()
+ * or nds_arena_destroy().
+ *
+ * NOTE: Do not forget to call nds_arena_destroy() before exiting the scope
+ * of the current NdsArena in order to avoid memory leaks!
+ *
+ * @param     chunk_size    size in bytes of the chunks requested from the system
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsArena* nds_arena_new(size_t chunk_size);
+
+
+/**
+ * Function that frees the memory occupied by the NdsArena, including all
+ * the blocks that were allocated from it.
+ *
+ * @param    arena    pointer to a NdsArena structure
+ *
+ * @complexity    linear on the number of chunks
+ */
+void nds_arena_destroy(NdsArena *arena);
+
+
+/**
+ * Function that releases all the blocks allocated from the NdsArena. The
+ * chunks are kept, so an arena reset at the end of every request stops
+ * calling the system allocator once it has reached its working size.
+ *
+ * @param     arena    pointer to a NdsArena structure
+ *
+ * @return                     NDS_OK    reset was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_arena_reset(NdsArena *arena);
+
+
+/**
+ * Function that returns a NdsAllocator which allocates from the NdsArena.
+ *
+ * @param     arena    pointer to a NdsArena structure
+ *
+ * @return    NdsAllocator backed by the arena
+ *
+ * @complexity    constant
+ */
+NdsAllocator nds_arena_allocator(NdsArena *arena);
+
+
+/**
+ * Function that creates a new NdsPool, an allocator of fixed-size blocks
+ * that keeps released blocks in a free list. Requests larger than
+ * block_size fail.
+ *
+ * NOTE: Do not forget to call nds_pool_destroy() before exiting the scope
+ * of the current NdsPool in order to avoid memory leaks!
+ *
+ * @param           block_size    size in bytes of one block
+ * @param     blocks_per_chunk    number of blocks requested from the system at once
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsPool* nds_pool_new(size_t block_size, size_t blocks_per_chunk);
+
+
+/**
+ * Function that frees the memory occupied by the NdsPool, including all
+ * the blocks that were allocated from it.
+ *
+ * @param    pool    pointer to a NdsPool structure
+ *
+ * @complexity    linear on the number of chunks
+ */
+void nds_pool_destroy(NdsPool *pool);
+
+
+/**
+ * Function that returns a NdsAllocator which allocates from the NdsPool.
+ *
+ * @param     pool    pointer to a NdsPool structure
+ *
+ * @return    NdsAllocator backed by the pool
+ *
+ * @complexity    constant
+ */
+NdsAllocator nds_pool_allocator(NdsPool *pool);
+
+
 #endif /* __NDS_UTILS_H__ */
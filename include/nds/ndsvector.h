@@ -25,7 +25,7 @@
  *
  * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
  * @created     13 July 2017
- * @modified    23 February 2018
+ * @modified    17 October 2026
  */
 
 #ifndef __NDS_VECTOR_H__
@@ -34,6 +34,7 @@
 #include <nds/ndsutils.h>
 
 #include <stddef.h>
+#include <sys/types.h>
 
 
 struct NdsVector
@@ -44,6 +45,99 @@ struct NdsVector
 typedef struct NdsVector NdsVector;
 
 
+/* vectors using the default allocator switch to anonymous mappings from this size (in bytes) */
+#define NDS_VECTOR_MMAP_THRESHOLD (32 * 1024 * 1024)
+
+/* flags for nds_vector_set_large_storage() */
+#define NDS_VECTOR_HUGE_PAGES 0x1
+
+/* policies for nds_vector_resize_with_policy() */
+#define NDS_RESIZE_UNINIT 0x0
+#define NDS_RESIZE_ZERO 0x1
+#define NDS_RESIZE_SCRUB 0x2
+
+/* types of the keys sorted by nds_vector_radix_sort_by_key() */
+enum NdsKeyType
+{
+	NDS_KEY_INT8,
+	NDS_KEY_UINT8,
+	NDS_KEY_INT16,
+	NDS_KEY_UINT16,
+	NDS_KEY_INT32,
+	NDS_KEY_UINT32,
+	NDS_KEY_INT64,
+	NDS_KEY_UINT64,
+	NDS_KEY_FLOAT,
+	NDS_KEY_DOUBLE
+};
+
+typedef enum NdsKeyType NdsKeyType;
+
+/* flags for nds_vector_open_mapped() */
+#define NDS_VECTOR_VERIFY_CHECKSUM 0x1
+
+
+/* counters of a single NdsVector (see nds_vector_get_stats()) */
+struct NdsVectorStats
+{
+	/* number of times the capacity of the vector was changed */
+	size_t reallocations;
+
+	/* number of bytes copied because the elements moved to another buffer */
+	size_t bytes_moved;
+
+	/* largest capacity the vector ever had */
+	size_t peak_capacity;
+
+	/* number of calls to nds_vector_shrink_to_fit() */
+	size_t shrink_calls;
+};
+
+typedef struct NdsVectorStats NdsVectorStats;
+
+/* totals over all the NdsVectors of the process (see nds_stats_snapshot()) */
+struct NdsStats
+{
+	/* number of vectors that were created and not destroyed yet */
+	size_t live_vectors;
+
+	/* bytes reserved for the elements of the live vectors */
+	size_t live_bytes;
+
+	/* part of live_bytes that does not hold elements */
+	size_t wasted_bytes;
+};
+
+typedef struct NdsStats NdsStats;
+
+
+/* function applied to every element by nds_vector_parallel_for_each() */
+typedef void (*NdsElementFunction)(void *element, void *context);
+
+/* function that computes an element of the destination from an element of the source (see nds_vector_parallel_transform()) */
+typedef void (*NdsTransformFunction)(const void *source, void *destination, void *context);
+
+/* function that folds a value into an accumulator (see nds_vector_parallel_reduce()) */
+typedef void (*NdsReduceFunction)(void *accumulator, const void *value, void *context);
+
+
+/**
+ * The functions marked with NDS_VECTOR_FAST_API are small accessors and the
+ * element API. When NDS_INLINE_FAST_PATH is defined before including this
+ * header, they become static inline functions (see ndsvectorinline.h), so a
+ * program linked against the static library can inline them in its loops.
+ *
+ * NOTE: The inline functions depend on the layout of the private part of the
+ * NdsVector, so NDS_INLINE_FAST_PATH should only be used with the static
+ * library (nds_static) of the same version.
+ */
+#ifdef NDS_INLINE_FAST_PATH
+#define NDS_VECTOR_FAST_API static inline
+#else
+#define NDS_VECTOR_FAST_API
+#endif
+
+
 /**
  * Function that creates a new NdsVector with an initial capacity of 10.
  *
@@ -70,13 +164,55 @@ NdsVector* nds_vector_new(size_t sizeof_element);
  * @param           capacity    the initial capacity of the vector
  *
  * @return    valid pointer    successful initialization
- *                     NULL    failure during initialization
+ *                     NULL    failure during initialization, or capacity * sizeof_element overflows
  *
  * @complexity    linear
  */
 NdsVector* nds_vector_new_with_capacity(size_t sizeof_element, size_t capacity);
 
 
+/**
+ * Function that creates a new NdsVector with a given initial capacity whose
+ * memory is obtained from the given NdsAllocator instead of malloc(). The
+ * allocator is used for the vector itself and by every function that changes
+ * its capacity, including nds_vector_destroy().
+ *
+ * NOTE: Do not forget to call nds_vector_destroy() before exiting the scope
+ * of the current NdsVector in order to avoid memory leaks!
+ *
+ * @param     sizeof_element    size of one element in the vector
+ * @param           capacity    the initial capacity of the vector
+ * @param          allocator    allocator used for all the memory of the vector
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    linear
+ */
+NdsVector* nds_vector_new_with_allocator(size_t sizeof_element, size_t capacity, const NdsAllocator *allocator);
+
+
+/**
+ * Function that creates a new NdsVector which stores its first
+ * inline_capacity elements inside the same allocation as the vector itself.
+ * The elements are moved to a separate heap buffer only when the size of the
+ * vector exceeds inline_capacity, so short-lived small vectors cost a single
+ * allocation.
+ *
+ * NOTE: Do not forget to call nds_vector_destroy() before exiting the scope
+ * of the current NdsVector in order to avoid memory leaks!
+ *
+ * @param      sizeof_element    size of one element in the vector
+ * @param     inline_capacity    number of elements stored inline
+ *
+ * @return    valid pointer    successful initialization
+ *                     NULL    failure during initialization
+ *
+ * @complexity    constant
+ */
+NdsVector* nds_vector_new_small(size_t sizeof_element, size_t inline_capacity);
+
+
 /**
  * Function that frees the memory occupied by the NdsVector.
  *
@@ -98,7 +234,7 @@ void nds_vector_destroy(NdsVector *vector);
  *
  * @complexity    constant
  */
-int nds_vector_is_empty(NdsVector *vector);
+NDS_VECTOR_FAST_API int nds_vector_is_empty(NdsVector *vector);
 
 
 /**
@@ -111,24 +247,73 @@ int nds_vector_is_empty(NdsVector *vector);
  *
  * @complexity    constant
  */
-int nds_vector_size(NdsVector *vector);
+NDS_VECTOR_FAST_API ssize_t nds_vector_size(NdsVector *vector);
 
 
 /**
  * Function that resizes the NdsVector container so that it contains size
- * elements.
+ * elements. The new elements are left uninitialized and the removed ones
+ * are not touched, like with NDS_RESIZE_UNINIT.
  *
  * @param     vector    pointer to a NdsVector structure
  * @param       size    new size of the NdsVector
  *
  * @return                     NDS_OK    resize was successful
  *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
  *
- * @complexity    linear
+ * @complexity    constant (linear when the capacity grows)
  */
 NdsStatus nds_vector_resize(NdsVector *vector, size_t size);
 
 
+/**
+ * Function that resizes the NdsVector container so that it contains size
+ * elements, with a policy for the memory of the new and removed elements:
+ *
+ *   NDS_RESIZE_UNINIT    the memory is not touched (fastest)
+ *   NDS_RESIZE_ZERO      the new elements are zeroed
+ *   NDS_RESIZE_SCRUB     the removed elements are zeroed
+ *
+ * NDS_RESIZE_ZERO and NDS_RESIZE_SCRUB can be combined.
+ *
+ * NOTE: When the growth moves the elements to a new anonymous mapping (see
+ * nds_vector_set_large_storage()), the pages that come fresh from the
+ * system are already zero and NDS_RESIZE_ZERO does not write them.
+ *
+ * @param     vector    pointer to a NdsVector structure
+ * @param       size    new size of the NdsVector
+ * @param     policy    NDS_RESIZE_UNINIT or a combination of NDS_RESIZE_ZERO and NDS_RESIZE_SCRUB
+ *
+ * @return                     NDS_OK    resize was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    linear in the number of zeroed elements
+ */
+NdsStatus nds_vector_resize_with_policy(NdsVector *vector, size_t size, unsigned int policy);
+
+
+/**
+ * Function that resizes the NdsVector container so that it contains size
+ * elements, with every new element a copy of value. The value is replicated
+ * into a block that stays in the cache and the block is copied with wide
+ * memory moves, so the fill runs at memcpy() speed for any element size.
+ * The removed elements are not touched.
+ *
+ * @param     vector    pointer to a NdsVector structure
+ * @param       size    new size of the NdsVector
+ * @param      value    pointer to the element copied into the new elements
+ *
+ * @return                     NDS_OK    resize was successful
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    linear in the number of new elements
+ */
+NdsStatus nds_vector_resize_fill(NdsVector *vector, size_t size, const void *value);
+
+
 /**
  * Function that returns the current capacity of the NdsVector.
  *
@@ -139,7 +324,7 @@ NdsStatus nds_vector_resize(NdsVector *vector, size_t size);
  *
  * @complexity    constant
  */
-int nds_vector_capacity(NdsVector *vector);
+NDS_VECTOR_FAST_API ssize_t nds_vector_capacity(NdsVector *vector);
 
 
 /**
@@ -149,6 +334,9 @@ int nds_vector_capacity(NdsVector *vector);
  * NOTE: A reallocation happens only if the new capacity is larger than the
  * current one. In all other cases, the capacity of the vector is not affected.
  *
+ * NOTE: A capacity whose size in bytes does not fit into a size_t is
+ * reported as NDS_MEM_ALLOC_ERROR.
+ *
  * @param       vector    pointer to a NdsVector structure
  * @param     capacity    new capacity for the NdsVector
  *
@@ -165,6 +353,9 @@ NdsStatus nds_vector_reserve(NdsVector *vector, size_t capacity);
  * Function which requests that the given NdsVector reduces its capacity in
  * order to be equal with its size.
  *
+ * NOTE: A vector created with nds_vector_new_small() whose elements fit into
+ * its inline buffer moves them back there and keeps the inline capacity.
+ *
  * @param     vector      pointer to a NdsVector structure
  *
  * @return                     NDS_OK    shrink was successful
@@ -176,4 +367,440 @@ NdsStatus nds_vector_reserve(NdsVector *vector, size_t capacity);
 NdsStatus nds_vector_shrink_to_fit(NdsVector *vector);
 
 
+/**
+ * Function that configures the large-vector storage mode of the NdsVector.
+ * Once its elements need at least threshold bytes, they are moved to an
+ * anonymous memory mapping which grows with mremap(), so a reallocation does
+ * not copy the elements and untouched capacity does not occupy physical
+ * memory. nds_vector_shrink_to_fit() gives the unused pages back to the
+ * system, or moves the elements back to the allocator below the threshold.
+ *
+ * NOTE: Vectors using the default allocator start with a threshold of
+ * NDS_VECTOR_MMAP_THRESHOLD bytes, vectors created with another allocator
+ * start with this mode disabled. The mode is only available on Linux.
+ *
+ * @param        vector    pointer to a NdsVector structure
+ * @param     threshold    size in bytes from which the elements are mapped (0 disables the mode)
+ * @param         flags    NDS_VECTOR_HUGE_PAGES asks for transparent huge pages
+ *
+ * @return                     NDS_OK    the storage mode was configured
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                          NDS_ERROR    the mode is not available on this system
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_vector_set_large_storage(NdsVector *vector, size_t threshold, unsigned int flags);
+
+
+/**
+ * Function that saves the elements of the NdsVector into a snapshot file
+ * which can be opened later with nds_vector_open_mapped().
+ *
+ * The file starts with a 64-byte header (magic "NDSVECT", format version,
+ * byte order marker, header size, sizeof_element, size and a 64-bit FNV-1a
+ * checksum of the elements computed on 8-byte words), followed by the raw
+ * elements. The header keeps the elements aligned to 64 bytes. Integers are
+ * stored in the byte order of the machine, so a snapshot can only be opened
+ * on machines with the same byte order.
+ *
+ * NOTE: The file is first written with a ".tmp" suffix and then renamed, so
+ * an existing snapshot is replaced atomically.
+ *
+ * @param    vector    pointer to a NdsVector structure
+ * @param      path    path of the snapshot file
+ *
+ * @return                     NDS_OK    the snapshot was saved
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *                          NDS_ERROR    the file could not be written
+ *
+ * @complexity    linear
+ */
+NdsStatus nds_vector_save(NdsVector *vector, const char *path);
+
+
+/**
+ * Function that opens a snapshot file saved by nds_vector_save(). The file is
+ * mapped in memory and the elements of the returned NdsVector point directly
+ * into the mapping, so no element is parsed or copied and the pages are read
+ * lazily when accessed. Writes to the elements are private to the process
+ * and never reach the file. The first growth of the vector copies its
+ * elements out of the mapping.
+ *
+ * NOTE: Do not forget to call nds_vector_destroy() before exiting the scope
+ * of the current NdsVector in order to avoid memory leaks!
+ *
+ * NOTE: Without NDS_VECTOR_VERIFY_CHECKSUM only the header is validated.
+ * With it, the checksum of the elements is verified, which reads the whole
+ * file. On systems without mmap() the elements are read into memory.
+ *
+ * @param     path    path of the snapshot file
+ * @param    flags    NDS_VECTOR_VERIFY_CHECKSUM or 0
+ *
+ * @return    valid pointer    the snapshot was opened
+ *                     NULL    invalid parameters, missing or corrupted file
+ *
+ * @complexity    constant (linear when verifying the checksum)
+ */
+NdsVector* nds_vector_open_mapped(const char *path, unsigned int flags);
+
+
+/**
+ * Function that copies the counters of the NdsVector into stats.
+ *
+ * NOTE: The counters are only kept when the library is built with
+ * NDS_ENABLE_STATS. Without it, the counters cost nothing and this function
+ * returns NDS_ERROR.
+ *
+ * @param     vector    pointer to a NdsVector structure
+ * @param      stats    pointer to the structure that receives the counters
+ *
+ * @return                     NDS_OK    the counters were copied
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                          NDS_ERROR    the library was built without NDS_ENABLE_STATS
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_vector_get_stats(NdsVector *vector, NdsVectorStats *stats);
+
+
+/**
+ * Function that copies the totals over all the NdsVectors of the process
+ * into stats. The totals are safe to read while other threads use vectors.
+ *
+ * NOTE: The totals are updated whenever the size or the capacity of a vector
+ * changes, including nds_vector_push_back(), nds_vector_append_n() and
+ * nds_vector_pop_back(), which then cost an atomic addition each.
+ *
+ * NOTE: The totals are only kept when the library is built with
+ * NDS_ENABLE_STATS. Without it, this function returns NDS_ERROR.
+ *
+ * @param     stats    pointer to the structure that receives the totals
+ *
+ * @return                     NDS_OK    the totals were copied
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                          NDS_ERROR    the library was built without NDS_ENABLE_STATS
+ *
+ * @complexity    constant
+ */
+NdsStatus nds_stats_snapshot(NdsStats *stats);
+
+
+/**
+ * Function that searches the NdsVector for the first element whose bytes are
+ * equal to the bytes of the given element.
+ *
+ * NOTE: Elements of 1, 2, 4 or 8 bytes are compared many at once with the
+ * widest SIMD instructions the processor supports (SSE2, AVX2 or AVX-512 on
+ * x86-64, chosen at runtime). Other element sizes are compared with memcmp().
+ * Since the comparison is bytewise, padding bytes inside the elements must be
+ * initialized for the result to be meaningful.
+ *
+ * @param      vector    pointer to a NdsVector structure
+ * @param     element    pointer to the element that is searched
+ *
+ * @return    index    index of the first equal element
+ *               -1    no element is equal or invalid parameters
+ *
+ * @complexity    linear
+ */
+ssize_t nds_vector_find(NdsVector *vector, const void *element);
+
+
+/**
+ * Function that counts the elements of the NdsVector whose bytes are equal to
+ * the bytes of the given element (see nds_vector_find() for the comparison).
+ *
+ * @param      vector    pointer to a NdsVector structure
+ * @param     element    pointer to the element that is counted
+ *
+ * @return    count    number of equal elements
+ *               -1    invalid parameters
+ *
+ * @complexity    linear
+ */
+ssize_t nds_vector_count(NdsVector *vector, const void *element);
+
+
+/**
+ * Function that checks if the NdsVector has an element whose bytes are equal
+ * to the bytes of the given element (see nds_vector_find() for the comparison).
+ *
+ * @param      vector    pointer to a NdsVector structure
+ * @param     element    pointer to the element that is searched
+ *
+ * @return     1    an equal element exists
+ *             0    no element is equal
+ *            -1    invalid parameters
+ *
+ * @complexity    linear
+ */
+int nds_vector_contains(NdsVector *vector, const void *element);
+
+
+/**
+ * Function that sorts the elements of the NdsVector in ascending order with
+ * pattern-defeating quicksort. Sorted inputs and runs of equal elements are
+ * detected and handled in linear time, and inputs that defeat the pivot
+ * selection fall back to heapsort, so the worst case stays O(n log n).
+ * Elements of 4, 8 and 16 bytes are swapped as whole integers.
+ *
+ * NOTE: The sort is not stable, equivalent elements may change their order
+ * (see nds_vector_stable_sort()).
+ *
+ * @param      vector    pointer to a NdsVector structure
+ * @param     compare    function that compares two elements
+ *
+ * @return                     NDS_OK    the elements were sorted
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error (only for elements above 256 bytes)
+ *
+ * @complexity    O(n log n)
+ */
+NdsStatus nds_vector_sort(NdsVector *vector, NdsCompareFunction compare);
+
+
+/**
+ * Function that sorts the elements of the NdsVector in ascending order with
+ * a merge sort, keeping the order of equivalent elements.
+ *
+ * NOTE: The merge needs a buffer as large as the elements, which is obtained
+ * from the allocator of the vector.
+ *
+ * @param      vector    pointer to a NdsVector structure
+ * @param     compare    function that compares two elements
+ *
+ * @return                     NDS_OK    the elements were sorted
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    O(n log n)
+ */
+NdsStatus nds_vector_stable_sort(NdsVector *vector, NdsCompareFunction compare);
+
+
+/**
+ * Function that sorts the elements of the NdsVector in ascending order of a
+ * numeric key stored inside every element, e.g. the age of a struct Person:
+ *
+ *     nds_vector_radix_sort_by_key(persons, offsetof(Person, age), NDS_KEY_INT16);
+ *
+ * The sort is a least significant digit radix sort that processes one byte
+ * of the key per pass and skips the bytes that are equal in all the keys. It
+ * makes no comparisons and is stable. Floating point keys are ordered like
+ * numbers, with negative zero before positive zero and NaNs at the ends.
+ *
+ * NOTE: The sort needs a buffer as large as the elements, which is obtained
+ * from the allocator of the vector.
+ *
+ * @param         vector    pointer to a NdsVector structure
+ * @param     key_offset    offset in bytes of the key inside an element
+ * @param       key_type    type of the key
+ *
+ * @return                     NDS_OK    the elements were sorted
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    linear (one pass per byte of the key)
+ */
+NdsStatus nds_vector_radix_sort_by_key(NdsVector *vector, size_t key_offset, NdsKeyType key_type);
+
+
+/**
+ * Function that sorts the elements of the NdsVector in ascending order with
+ * a merge sort that runs on the worker threads of the library (see
+ * nds_set_worker_count()). Every thread sorts a run of the elements, then
+ * the runs are merged in pairs, with large merges split between threads at
+ * positions found by binary search. The order of equivalent elements is
+ * kept, like for nds_vector_stable_sort().
+ *
+ * NOTE: The compare function is called from several threads at once, and the
+ * buffer for the merges is obtained from the allocator of the vector.
+ *
+ * @param      vector    pointer to a NdsVector structure
+ * @param     compare    function that compares two elements
+ *
+ * @return                     NDS_OK    the elements were sorted
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    O(n log n)
+ */
+NdsStatus nds_vector_parallel_sort(NdsVector *vector, NdsCompareFunction compare);
+
+
+/**
+ * Function that calls function for every element of the NdsVector on the
+ * worker threads of the library. The elements are split into chunks that
+ * start on cache line boundaries of the buffer (the first chunk ends on
+ * one), so threads do not write to the same line.
+ *
+ * NOTE: The order in which the elements are visited is not specified.
+ *
+ * @param       vector    pointer to a NdsVector structure
+ * @param     function    function called for every element
+ * @param      context    pointer passed to every call of function
+ *
+ * @return                     NDS_OK    function was called for every element
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *
+ * @complexity    linear
+ */
+NdsStatus nds_vector_parallel_for_each(NdsVector *vector, NdsElementFunction function, void *context);
+
+
+/**
+ * Function that resizes the destination NdsVector to the size of the source
+ * NdsVector and computes every element of the destination from the element
+ * of the source at the same index, on the worker threads of the library.
+ * Both vectors may be the same one, for a transformation in place. The chunks
+ * are split on the cache line boundaries of the destination.
+ *
+ * @param          source    pointer to the NdsVector that is read
+ * @param     destination    pointer to the NdsVector that is written
+ * @param        function    function that computes an element of the destination
+ * @param         context    pointer passed to every call of function
+ *
+ * @return                     NDS_OK    all the elements were computed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    the destination could not be resized
+ *
+ * @complexity    linear
+ */
+NdsStatus nds_vector_parallel_transform(NdsVector *source, NdsVector *destination, NdsTransformFunction function, void *context);
+
+
+/**
+ * Function that reduces the elements of the NdsVector to a single value on
+ * the worker threads of the library. On input, result holds the identity of
+ * the reduction (e.g. 0 for a sum). Every chunk of elements is folded with
+ * accumulate into a copy of the identity, then the partial results are folded
+ * into result with combine, in the order of the chunks.
+ *
+ * NOTE: The result is the same as a sequential reduction only when combine is
+ * associative, e.g. floating point sums may differ in the last bits.
+ *
+ * @param          vector    pointer to a NdsVector structure
+ * @param          result    identity on input, result of the reduction on output
+ * @param     result_size    size in bytes of the result
+ * @param      accumulate    function that folds an element into an accumulator
+ * @param         combine    function that folds a partial result into an accumulator
+ * @param         context    pointer passed to every call of accumulate and combine
+ *
+ * @return                     NDS_OK    the result was computed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    linear
+ */
+NdsStatus nds_vector_parallel_reduce(NdsVector *vector, void *result, size_t result_size, NdsReduceFunction accumulate, NdsReduceFunction combine, void *context);
+
+
+/**
+ * Function that appends a copy of the given element at the end of the
+ * NdsVector. When the vector is full, its capacity is doubled, so a sequence
+ * of appends has amortized constant cost. The element can be one of the
+ * NdsVector itself.
+ *
+ * @param      vector    pointer to a NdsVector structure
+ * @param     element    pointer to the element that will be copied
+ *
+ * @return                     NDS_OK    the element was appended
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    amortized constant
+ */
+NDS_VECTOR_FAST_API NdsStatus nds_vector_push_back(NdsVector *vector, const void *element);
+
+
+/**
+ * Function that appends count elements stored contiguously at the given
+ * address at the end of the NdsVector. The capacity is grown at most once and
+ * the elements are copied with a single memcpy(). The elements can be a part
+ * of the NdsVector itself, e.g. nds_vector_data() to duplicate its contents.
+ *
+ * @param       vector    pointer to a NdsVector structure
+ * @param     elements    pointer to the first element that will be copied
+ * @param        count    number of elements that will be copied
+ *
+ * @return                     NDS_OK    the elements were appended
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters for the function
+ *                NDS_MEM_ALLOC_ERROR    memory allocation error
+ *
+ * @complexity    linear on count
+ */
+NDS_VECTOR_FAST_API NdsStatus nds_vector_append_n(NdsVector *vector, const void *elements, size_t count);
+
+
+/**
+ * Function that removes the last element of the NdsVector. If element is not
+ * NULL, the removed element is copied there before removal.
+ *
+ * NOTE: The capacity of the vector is not affected.
+ *
+ * @param      vector    pointer to a NdsVector structure
+ * @param     element    where to copy the removed element (can be NULL)
+ *
+ * @return                     NDS_OK    the element was removed
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or empty vector
+ *
+ * @complexity    constant
+ */
+NDS_VECTOR_FAST_API NdsStatus nds_vector_pop_back(NdsVector *vector, void *element);
+
+
+/**
+ * Function that copies the element found at the given index of the NdsVector.
+ *
+ * @param      vector    pointer to a NdsVector structure
+ * @param       index    position of the element in the vector
+ * @param     element    where to copy the element
+ *
+ * @return                     NDS_OK    the element was copied
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or index out of range
+ *
+ * @complexity    constant
+ */
+NDS_VECTOR_FAST_API NdsStatus nds_vector_get(NdsVector *vector, size_t index, void *element);
+
+
+/**
+ * Function that overwrites the element found at the given index of the
+ * NdsVector with a copy of the given element.
+ *
+ * @param      vector    pointer to a NdsVector structure
+ * @param       index    position of the element in the vector
+ * @param     element    pointer to the element that will be copied
+ *
+ * @return                     NDS_OK    the element was overwritten
+ *            NDS_INVALID_PARAM_ERROR    invalid parameters or index out of range
+ *
+ * @complexity    constant
+ */
+NDS_VECTOR_FAST_API NdsStatus nds_vector_set(NdsVector *vector, size_t index, const void *element);
+
+
+/**
+ * Function that returns a pointer to the memory where the elements of the
+ * NdsVector are stored contiguously.
+ *
+ * NOTE: The pointer is invalidated by any function that changes the capacity
+ * of the vector (e.g. nds_vector_push_back(), nds_vector_reserve()).
+ *
+ * @param     vector    pointer to a NdsVector structure
+ *
+ * @return    valid pointer    address of the first element
+ *                     NULL    the NdsVector is invalid
+ *
+ * @complexity    constant
+ */
+NDS_VECTOR_FAST_API void* nds_vector_data(NdsVector *vector);
+
+
+#ifdef NDS_INLINE_FAST_PATH
+#include <nds/ndsvectorinline.h>
+#endif
+
+
 #endif /* __NDS_VECTOR_H__ */
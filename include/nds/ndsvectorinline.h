@@ -0,0 +1,255 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the layout of the private part of NdsVector together
+ * with the functions of NdsVector that are small enough to be inlined. The
+ * library compiles them as regular functions; sources that define
+ * NDS_INLINE_FAST_PATH before including ndsvector.h get them as static
+ * inline functions instead (see ndsvector.h).
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_VECTOR_INLINE_H__
+#define __NDS_VECTOR_INLINE_H__
+
+#include <nds/ndsvector.h>
+#include <nds/ndsutils.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+
+struct NdsVectorPrivate
+{
+	char *elements;
+	size_t sizeof_element;
+
+	/* current size and capacity of the vector */
+	size_t size;
+	size_t capacity;
+
+	/* number of elements that fit into the inline buffer (0 if the vector has no inline buffer) */
+	size_t inline_capacity;
+
+	/* allocator used for the block of the vector and for its elements */
+	NdsAllocator allocator;
+
+	/* elements that need at least mmap_threshold bytes are stored in an anonymous mapping (0 disables it) */
+	size_t mmap_threshold;
+	unsigned int mmap_flags;
+
+	/* whether the elements currently live in an anonymous mapping instead of the allocator */
+	int mapped;
+
+	/* read-only file mapping the elements point into, for vectors opened with nds_vector_open_mapped() */
+	void *file_mapping;
+	size_t file_mapping_length;
+
+#ifdef NDS_ENABLE_STATS
+	/* counters of the vector and the bytes it currently adds to the process-wide totals */
+	NdsVectorStats stats;
+	size_t accounted_bytes;
+	size_t accounted_waste;
+#endif
+};
+
+typedef struct NdsVectorPrivate NdsVectorPrivate;
+
+
+#ifdef NDS_ENABLE_STATS
+/* replaces what the vector adds to the process-wide totals, called after its size or capacity changed */
+void nds_vector_stats_account(NdsVectorPrivate *private);
+#define NDS_VECTOR_STATS_ACCOUNT(private) nds_vector_stats_account(private)
+#else
+#define NDS_VECTOR_STATS_ACCOUNT(private) ((void)0)
+#endif
+
+
+/* returns the offset in bytes of pointer from the first element if it points into the elements of the vector, SIZE_MAX otherwise */
+static inline size_t nds_vector_offset_of(const NdsVectorPrivate *private, const void *pointer)
+{
+	/* the addresses are compared as integers, since the pointer usually belongs to another object */
+	uintptr_t address = (uintptr_t)pointer, first = (uintptr_t)private->elements;
+
+	if (private->elements == NULL || address < first || address - first >= private->size * private->sizeof_element)
+		return SIZE_MAX;
+
+	return (size_t)(address - first);
+}
+
+
+NDS_VECTOR_FAST_API int nds_vector_is_empty(NdsVector *vector)
+{
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL)
+		return -1;
+
+	return vector->private->size == 0;
+}
+
+
+NDS_VECTOR_FAST_API ssize_t nds_vector_size(NdsVector *vector)
+{
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL)
+		return -1;
+
+	return vector->private->size;
+}
+
+
+NDS_VECTOR_FAST_API ssize_t nds_vector_capacity(NdsVector *vector)
+{
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL)
+		return -1;
+
+	return vector->private->capacity;
+}
+
+
+NDS_VECTOR_FAST_API NdsStatus nds_vector_push_back(NdsVector *vector, const void *element)
+{
+	NdsVectorPrivate *private;
+	size_t offset;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = vector->private;
+
+	if (private->size == private->capacity)
+	{
+		/* the element can be one of the vector, so it is found again in the buffer after the growth */
+		offset = nds_vector_offset_of(private, element);
+
+		if (nds_vector_reserve(vector, nds_grow_capacity(private->capacity, private->size + 1)) != NDS_OK)
+			return NDS_MEM_ALLOC_ERROR;
+
+		if (offset != SIZE_MAX)
+			element = &private->elements[offset];
+	}
+
+	memcpy(&private->elements[private->size * private->sizeof_element], element, private->sizeof_element);
+	private->size++;
+	NDS_VECTOR_STATS_ACCOUNT(private);
+
+	return NDS_OK;
+}
+
+
+NDS_VECTOR_FAST_API NdsStatus nds_vector_append_n(NdsVector *vector, const void *elements, size_t count)
+{
+	NdsVectorPrivate *private;
+	size_t offset;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || (elements == NULL && count > 0))
+		return NDS_INVALID_PARAM_ERROR;
+
+	if (count == 0)
+		return NDS_OK;
+
+	private = vector->private;
+
+	/* the new size must be representable, the reserve checks the size in bytes */
+	if (count > SIZE_MAX - private->size)
+		return NDS_MEM_ALLOC_ERROR;
+
+	if (private->size + count > private->capacity)
+	{
+		/* the elements can be a part of the vector, so they are found again in the buffer after the growth */
+		offset = nds_vector_offset_of(private, elements);
+
+		if (nds_vector_reserve(vector, nds_grow_capacity(private->capacity, private->size + count)) != NDS_OK)
+			return NDS_MEM_ALLOC_ERROR;
+
+		if (offset != SIZE_MAX)
+			elements = &private->elements[offset];
+	}
+
+	memcpy(&private->elements[private->size * private->sizeof_element], elements, count * private->sizeof_element);
+	private->size += count;
+	NDS_VECTOR_STATS_ACCOUNT(private);
+
+	return NDS_OK;
+}
+
+
+NDS_VECTOR_FAST_API NdsStatus nds_vector_pop_back(NdsVector *vector, void *element)
+{
+	NdsVectorPrivate *private;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || vector->private->size == 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = vector->private;
+	private->size--;
+	NDS_VECTOR_STATS_ACCOUNT(private);
+
+	if (element != NULL)
+		memcpy(element, &private->elements[private->size * private->sizeof_element], private->sizeof_element);
+
+	return NDS_OK;
+}
+
+
+NDS_VECTOR_FAST_API NdsStatus nds_vector_get(NdsVector *vector, size_t index, void *element)
+{
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || element == NULL || index >= vector->private->size)
+		return NDS_INVALID_PARAM_ERROR;
+
+	memcpy(element, &vector->private->elements[index * vector->private->sizeof_element], vector->private->sizeof_element);
+
+	return NDS_OK;
+}
+
+
+NDS_VECTOR_FAST_API NdsStatus nds_vector_set(NdsVector *vector, size_t index, const void *element)
+{
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || element == NULL || index >= vector->private->size)
+		return NDS_INVALID_PARAM_ERROR;
+
+	memcpy(&vector->private->elements[index * vector->private->sizeof_element], element, vector->private->sizeof_element);
+
+	return NDS_OK;
+}
+
+
+NDS_VECTOR_FAST_API void* nds_vector_data(NdsVector *vector)
+{
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL)
+		return NULL;
+
+	return vector->private->elements;
+}
+
+
+#endif /* __NDS_VECTOR_INLINE_H__ */
@@ -0,0 +1,289 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains NDS_VECTOR_DECLARE(T), a macro that generates a vector
+ * specialized for the element type T. Unlike NdsVector, the size of an
+ * element is known at compile time, so every accessor is a static inline
+ * function that the compiler reduces to plain loads and stores.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_VECTOR_TYPED_H__
+#define __NDS_VECTOR_TYPED_H__
+
+#include <nds/ndsutils.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * Macro that declares the type NdsVector_T and its functions for the element
+ * type T, which must be a single identifier (use a typedef for types such as
+ * struct Person or unsigned int). It should be used once per type, usually
+ * in a header shared by the sources that need the vector.
+ *
+ * The vector is a plain structure that can live on the stack or inside other
+ * structures. It grows like NdsVector (see nds_grow_capacity()) and its
+ * functions follow the same conventions as the ones from ndsvector.h:
+ *
+ *   NdsStatus nds_vector_T_init(NdsVector_T *vector)
+ *   NdsStatus nds_vector_T_init_with_capacity(NdsVector_T *vector, size_t capacity)
+ *   void      nds_vector_T_destroy(NdsVector_T *vector)
+ *   int       nds_vector_T_is_empty(const NdsVector_T *vector)
+ *   size_t    nds_vector_T_size(const NdsVector_T *vector)
+ *   size_t    nds_vector_T_capacity(const NdsVector_T *vector)
+ *   NdsStatus nds_vector_T_reserve(NdsVector_T *vector, size_t capacity)
+ *   NdsStatus nds_vector_T_resize(NdsVector_T *vector, size_t size)
+ *   NdsStatus nds_vector_T_shrink_to_fit(NdsVector_T *vector)
+ *   NdsStatus nds_vector_T_push_back(NdsVector_T *vector, T element)
+ *   NdsStatus nds_vector_T_append_n(NdsVector_T *vector, const T *elements, size_t count)
+ *   NdsStatus nds_vector_T_pop_back(NdsVector_T *vector, T *element)
+ *   T         nds_vector_T_get(const NdsVector_T *vector, size_t index)
+ *   void      nds_vector_T_set(NdsVector_T *vector, size_t index, T element)
+ *   T*        nds_vector_T_data(NdsVector_T *vector)
+ *
+ * NOTE: nds_vector_T_get() and nds_vector_T_set() do not check the index, so
+ * that element access compiles down to a single indexed load or store. The
+ * index must be smaller than the size of the vector.
+ *
+ * NOTE: The elements given to nds_vector_T_append_n() can be a part of the
+ * vector itself, e.g. nds_vector_T_data() to duplicate its contents.
+ *
+ * Example:
+ *
+ *     typedef struct Person Person;
+ *     NDS_VECTOR_DECLARE(Person)
+ *
+ *     NdsVector_Person persons;
+ *     nds_vector_Person_init(&persons);
+ *     nds_vector_Person_push_back(&persons, person);
+ *     age = nds_vector_Person_get(&persons, 0).age;
+ *     nds_vector_Person_destroy(&persons);
+ */
+#define NDS_VECTOR_DECLARE(T) \
+	struct NdsVector_##T \
+	{ \
+		T *data; \
+	\
+		/* current size and capacity of the vector */ \
+		size_t size; \
+		size_t capacity; \
+	}; \
+	\
+	typedef struct NdsVector_##T NdsVector_##T; \
+	\
+	static inline NdsStatus nds_vector_##T##_init_with_capacity(NdsVector_##T *vector, size_t capacity) \
+	{ \
+		/* sanity checks */ \
+		if (vector == NULL) \
+			return NDS_INVALID_PARAM_ERROR; \
+	\
+		/* a vector that failed to initialize is left empty, so it can still be destroyed */ \
+		vector->data = NULL; \
+		vector->size = 0; \
+		vector->capacity = 0; \
+	\
+		if (capacity == 0) \
+			return NDS_INVALID_PARAM_ERROR; \
+	\
+		if (nds_size_overflows(capacity, sizeof(T))) \
+			return NDS_MEM_ALLOC_ERROR; \
+	\
+		vector->data = (T*)malloc(capacity * sizeof(T)); \
+		if (!vector->data) \
+			return NDS_MEM_ALLOC_ERROR; \
+	\
+		vector->capacity = capacity; \
+	\
+		return NDS_OK; \
+	} \
+	\
+	static inline NdsStatus nds_vector_##T##_init(NdsVector_##T *vector) \
+	{ \
+		/* ideal starting capacity for a vector is 10 */ \
+		return nds_vector_##T##_init_with_capacity(vector, 10); \
+	} \
+	\
+	static inline void nds_vector_##T##_destroy(NdsVector_##T *vector) \
+	{ \
+		/* sanity checks */ \
+		if (vector == NULL) \
+			return; \
+	\
+		free(vector->data); \
+		vector->data = NULL; \
+		vector->size = 0; \
+		vector->capacity = 0; \
+	} \
+	\
+	static inline int nds_vector_##T##_is_empty(const NdsVector_##T *vector) \
+	{ \
+		return vector->size == 0; \
+	} \
+	\
+	static inline size_t nds_vector_##T##_size(const NdsVector_##T *vector) \
+	{ \
+		return vector->size; \
+	} \
+	\
+	static inline size_t nds_vector_##T##_capacity(const NdsVector_##T *vector) \
+	{ \
+		return vector->capacity; \
+	} \
+	\
+	static inline NdsStatus nds_vector_##T##_reserve(NdsVector_##T *vector, size_t capacity) \
+	{ \
+		T *data; \
+	\
+		/* sanity checks */ \
+		if (vector == NULL || capacity <= vector->capacity) \
+			return NDS_INVALID_PARAM_ERROR; \
+	\
+		if (nds_size_overflows(capacity, sizeof(T))) \
+			return NDS_MEM_ALLOC_ERROR; \
+	\
+		data = (T*)realloc(vector->data, capacity * sizeof(T)); \
+		if (!data) \
+			return NDS_MEM_ALLOC_ERROR; \
+	\
+		vector->data = data; \
+		vector->capacity = capacity; \
+	\
+		return NDS_OK; \
+	} \
+	\
+	static inline NdsStatus nds_vector_##T##_resize(NdsVector_##T *vector, size_t size) \
+	{ \
+		/* sanity checks */ \
+		if (vector == NULL) \
+			return NDS_INVALID_PARAM_ERROR; \
+	\
+		if (size > vector->capacity) \
+			if (nds_vector_##T##_reserve(vector, nds_grow_capacity(vector->capacity, size)) != NDS_OK) \
+				return NDS_MEM_ALLOC_ERROR; \
+	\
+		vector->size = size; \
+	\
+		return NDS_OK; \
+	} \
+	\
+	static inline NdsStatus nds_vector_##T##_shrink_to_fit(NdsVector_##T *vector) \
+	{ \
+		T *data; \
+		size_t capacity; \
+	\
+		/* sanity checks */ \
+		if (vector == NULL) \
+			return NDS_INVALID_PARAM_ERROR; \
+	\
+		/* if current size of vector is 0, we use capacity 1 instead */ \
+		capacity = vector->size > 0 ? vector->size : 1; \
+	\
+		data = (T*)realloc(vector->data, capacity * sizeof(T)); \
+		if (!data) \
+			return NDS_MEM_ALLOC_ERROR; \
+	\
+		vector->data = data; \
+		vector->capacity = capacity; \
+	\
+		return NDS_OK; \
+	} \
+	\
+	static inline NdsStatus nds_vector_##T##_push_back(NdsVector_##T *vector, T element) \
+	{ \
+		/* the reallocation is the rare case, the store is the common one */ \
+		if (vector->size == vector->capacity) \
+			if (nds_vector_##T##_reserve(vector, nds_grow_capacity(vector->capacity, vector->size + 1)) != NDS_OK) \
+				return NDS_MEM_ALLOC_ERROR; \
+	\
+		vector->data[vector->size++] = element; \
+	\
+		return NDS_OK; \
+	} \
+	\
+	static inline NdsStatus nds_vector_##T##_append_n(NdsVector_##T *vector, const T *elements, size_t count) \
+	{ \
+		uintptr_t address = (uintptr_t)elements, first; \
+		int inside; \
+	\
+		/* sanity checks */ \
+		if (vector == NULL || (elements == NULL && count > 0)) \
+			return NDS_INVALID_PARAM_ERROR; \
+	\
+		if (count > SIZE_MAX - vector->size) \
+			return NDS_MEM_ALLOC_ERROR; \
+	\
+		if (vector->size + count > vector->capacity) \
+		{ \
+			/* the elements can be a part of the vector, so they are found again in the buffer after the growth */ \
+			first = (uintptr_t)vector->data; \
+			inside = vector->data != NULL && address >= first && address - first < vector->size * sizeof(T); \
+	\
+			if (nds_vector_##T##_reserve(vector, nds_grow_capacity(vector->capacity, vector->size + count)) != NDS_OK) \
+				return NDS_MEM_ALLOC_ERROR; \
+	\
+			if (inside) \
+				elements = vector->data + (address - first) / sizeof(T); \
+		} \
+	\
+		if (count > 0) \
+			memcpy(&vector->data[vector->size], elements, count * sizeof(T)); \
+		vector->size += count; \
+	\
+		return NDS_OK; \
+	} \
+	\
+	static inline NdsStatus nds_vector_##T##_pop_back(NdsVector_##T *vector, T *element) \
+	{ \
+		/* sanity checks */ \
+		if (vector == NULL || vector->size == 0) \
+			return NDS_INVALID_PARAM_ERROR; \
+	\
+		vector->size--; \
+		if (element != NULL) \
+			*element = vector->data[vector->size]; \
+	\
+		return NDS_OK; \
+	} \
+	\
+	static inline T nds_vector_##T##_get(const NdsVector_##T *vector, size_t index) \
+	{ \
+		return vector->data[index]; \
+	} \
+	\
+	static inline void nds_vector_##T##_set(NdsVector_##T *vector, size_t index, T element) \
+	{ \
+		vector->data[index] = element; \
+	} \
+	\
+	static inline T* nds_vector_##T##_data(NdsVector_##T *vector) \
+	{ \
+		return vector->data; \
+	}
+
+
+#endif /* __NDS_VECTOR_TYPED_H__ */
@@ -0,0 +1,468 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the implementation of the NdsConcurrentQueue, a bounded
+ * multi-producer multi-consumer queue with a sequence number in every slot.
+ * The positions of both sides only grow. The slot of position p is free for
+ * a producer when its sequence number is p, holds the element of position p
+ * when it is p + 1, and becomes free for the next lap when the consumer sets
+ * it to p + capacity.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+/* syscall() is a GNU extension */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <nds/ndsconcurrentqueue.h>
+
+#include <limits.h>
+#include <sched.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define NDS_CONCURRENT_QUEUE_HAS_FUTEX
+#endif
+
+
+/* number of times a blocking call yields the processor and tries again before it sleeps */
+#define NDS_CONCURRENT_QUEUE_YIELDS 16
+
+/* the sequence number of a slot is followed by its element */
+#define NDS_SLOT_SEQUENCE(private, position) ((size_t*)((private)->slots + ((position) & (private)->mask) * (private)->stride))
+#define NDS_SLOT_ELEMENT(private, position) ((private)->slots + ((position) & (private)->mask) * (private)->stride + sizeof(size_t))
+
+
+/* what the threads of one side wait for: a change of the event counter, while they are counted as waiters */
+struct NdsQueueWait
+{
+	uint32_t event;
+	uint32_t waiters;
+	char padding[NDS_CACHE_LINE_SIZE - 2 * sizeof(uint32_t)];
+};
+
+
+struct NdsConcurrentQueuePrivate
+{
+	/* never written after the creation, except closed */
+	char *slots;
+	size_t stride;
+	size_t sizeof_element;
+	size_t mask;
+	int blocking;
+	int closed;
+	NdsAllocator allocator;
+	char shared_padding[NDS_CACHE_LINE_SIZE];
+
+	/* the next position claimed by a producer and by a consumer, each on its own cache line */
+	size_t enqueue_position;
+	char enqueue_padding[NDS_CACHE_LINE_SIZE - sizeof(size_t)];
+	size_t dequeue_position;
+	char dequeue_padding[NDS_CACHE_LINE_SIZE - sizeof(size_t)];
+
+	/* the producers wait for free slots and the consumers for elements (blocking queues only) */
+	struct NdsQueueWait not_full;
+	struct NdsQueueWait not_empty;
+};
+
+typedef struct NdsConcurrentQueuePrivate NdsConcurrentQueuePrivate;
+
+/* the handle and the private part of a NdsConcurrentQueue are allocated as a single block */
+struct NdsConcurrentQueueBlock
+{
+	NdsConcurrentQueue queue;
+	NdsConcurrentQueuePrivate private;
+};
+
+
+/* sleeps while the event counter still has the given value (or just yields without futexes) */
+static void nds_queue_wait(struct NdsQueueWait *wait, uint32_t event)
+{
+#ifdef NDS_CONCURRENT_QUEUE_HAS_FUTEX
+	syscall(SYS_futex, &wait->event, FUTEX_WAIT_PRIVATE, event, NULL, NULL, 0);
+#else
+	(void)wait;
+	(void)event;
+	sched_yield();
+#endif
+}
+
+
+/* wakes up to count threads that wait on the event counter, if there are any */
+static void nds_queue_wake(struct NdsQueueWait *wait, size_t count)
+{
+	/* pairs with the fence in nds_concurrent_queue_wait_for(): either we see the waiter, or it sees our slots */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	if (__atomic_load_n(&wait->waiters, __ATOMIC_RELAXED) == 0)
+		return;
+
+	__atomic_add_fetch(&wait->event, 1, __ATOMIC_SEQ_CST);
+
+#ifdef NDS_CONCURRENT_QUEUE_HAS_FUTEX
+	syscall(SYS_futex, &wait->event, FUTEX_WAKE_PRIVATE, count < INT_MAX ? (int)count : INT_MAX, NULL, NULL, 0);
+#else
+	(void)count;
+#endif
+}
+
+
+/*
+ * Claims up to count consecutive slots from the position of one side with a
+ * single compare and swap. A slot can be claimed when its sequence number is
+ * its position plus offset (0 for the producers, 1 for the consumers).
+ * Returns the number of claimed slots and the first of them in first.
+ */
+static size_t nds_concurrent_queue_claim(NdsConcurrentQueuePrivate *private, size_t *side, size_t offset, size_t count, size_t *first)
+{
+	size_t position = __atomic_load_n(side, __ATOMIC_RELAXED), claimed, sequence = 0;
+
+	for (;;)
+	{
+		for (claimed = 0; claimed < count; claimed++)
+		{
+			sequence = __atomic_load_n(NDS_SLOT_SEQUENCE(private, position + claimed), __ATOMIC_ACQUIRE);
+			if (sequence != position + claimed + offset)
+				break;
+		}
+
+		if (claimed == 0)
+		{
+			/* a slot of the previous lap means that the queue is full (or empty), otherwise the position is stale */
+			if ((ptrdiff_t)(sequence - (position + offset)) < 0)
+				return 0;
+
+			position = __atomic_load_n(side, __ATOMIC_RELAXED);
+			continue;
+		}
+
+		/* a failed exchange reloads the position */
+		if (__atomic_compare_exchange_n(side, &position, position + claimed, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		{
+			*first = position;
+			return claimed;
+		}
+	}
+}
+
+
+/* adds up to count elements and wakes the consumers that wait for them */
+static size_t nds_concurrent_queue_put(NdsConcurrentQueuePrivate *private, const char *elements, size_t count)
+{
+	size_t claimed, first, i;
+
+	claimed = nds_concurrent_queue_claim(private, &private->enqueue_position, 0, count, &first);
+
+	for (i = 0; i < claimed; i++)
+	{
+		memcpy(NDS_SLOT_ELEMENT(private, first + i), elements + i * private->sizeof_element, private->sizeof_element);
+
+		/* the element is written before a consumer can see the slot as full */
+		__atomic_store_n(NDS_SLOT_SEQUENCE(private, first + i), first + i + 1, __ATOMIC_RELEASE);
+	}
+
+	if (private->blocking && claimed != 0)
+		nds_queue_wake(&private->not_empty, claimed);
+
+	return claimed;
+}
+
+
+/* removes up to count elements and wakes the producers that wait for their slots */
+static size_t nds_concurrent_queue_take(NdsConcurrentQueuePrivate *private, char *elements, size_t count)
+{
+	size_t claimed, first, i;
+
+	claimed = nds_concurrent_queue_claim(private, &private->dequeue_position, 1, count, &first);
+
+	for (i = 0; i < claimed; i++)
+	{
+		if (elements != NULL)
+			memcpy(elements + i * private->sizeof_element, NDS_SLOT_ELEMENT(private, first + i), private->sizeof_element);
+
+		/* the element is read before a producer of the next lap can reuse the slot */
+		__atomic_store_n(NDS_SLOT_SEQUENCE(private, first + i), first + i + private->mask + 1, __ATOMIC_RELEASE);
+	}
+
+	if (private->blocking && claimed != 0)
+		nds_queue_wake(&private->not_full, claimed);
+
+	return claimed;
+}
+
+
+/* puts the element for a producer or takes one for a consumer */
+static size_t nds_concurrent_queue_transfer(NdsConcurrentQueuePrivate *private, int producer, const void *element, void *out)
+{
+	return producer ? nds_concurrent_queue_put(private, (const char*)element, 1) : nds_concurrent_queue_take(private, (char*)out, 1);
+}
+
+
+/*
+ * Repeats the transfer of one element until it succeeds, sleeping while it
+ * fails. The thread counts itself as a waiter and tries once more before it
+ * sleeps, so a wake that happens in between changes the event counter and
+ * the sleep returns at once.
+ */
+static NdsStatus nds_concurrent_queue_wait_for(NdsConcurrentQueuePrivate *private, int producer, const void *element, void *out)
+{
+	struct NdsQueueWait *wait = producer ? &private->not_full : &private->not_empty;
+	size_t yields = 0, done;
+	uint32_t event;
+
+	for (;;)
+	{
+		if (nds_concurrent_queue_transfer(private, producer, element, out))
+			return NDS_OK;
+
+		/* the other side usually makes progress within a few time slices, which is cheaper than a sleep and a wake */
+		if (yields < NDS_CONCURRENT_QUEUE_YIELDS && !__atomic_load_n(&private->closed, __ATOMIC_RELAXED))
+		{
+			yields++;
+			sched_yield();
+			continue;
+		}
+
+		if (__atomic_load_n(&private->closed, __ATOMIC_ACQUIRE))
+			return NDS_ERROR;
+
+		event = __atomic_load_n(&wait->event, __ATOMIC_SEQ_CST);
+		__atomic_add_fetch(&wait->waiters, 1, __ATOMIC_SEQ_CST);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+		done = nds_concurrent_queue_transfer(private, producer, element, out);
+		if (!done && !__atomic_load_n(&private->closed, __ATOMIC_ACQUIRE))
+			nds_queue_wait(wait, event);
+
+		__atomic_sub_fetch(&wait->waiters, 1, __ATOMIC_SEQ_CST);
+
+		if (done)
+			return NDS_OK;
+	}
+}
+
+
+NdsConcurrentQueue* nds_concurrent_queue_new(size_t sizeof_element, size_t capacity)
+{
+	return nds_concurrent_queue_new_with_allocator(sizeof_element, capacity, 0, nds_allocator_default());
+}
+
+
+NdsConcurrentQueue* nds_concurrent_queue_new_with_allocator(size_t sizeof_element, size_t capacity, int blocking, const NdsAllocator *allocator)
+{
+	struct NdsConcurrentQueueBlock *block;
+	size_t rounded = 2, stride, i;
+
+	/* sanity checks */
+	if (sizeof_element == 0 || capacity == 0 || allocator == NULL || allocator->alloc == NULL || allocator->free == NULL)
+		return NULL;
+
+	/* the sequence numbers stay aligned when the slots are a multiple of their size */
+	if (sizeof_element > SIZE_MAX - 2 * sizeof(size_t))
+		return NULL;
+	stride = (sizeof(size_t) + sizeof_element + sizeof(size_t) - 1) / sizeof(size_t) * sizeof(size_t);
+
+	while (rounded < capacity)
+	{
+		if (rounded > SIZE_MAX / 2)
+			return NULL;
+		rounded *= 2;
+	}
+
+	if (rounded > SIZE_MAX / stride)
+		return NULL;
+
+	/* we allocate memory for the structure and the private part of the NdsConcurrentQueue */
+	block = (struct NdsConcurrentQueueBlock*)allocator->alloc(allocator->context, sizeof(struct NdsConcurrentQueueBlock));
+	if (!block)
+		return NULL;
+
+	block->private.slots = (char*)allocator->alloc(allocator->context, rounded * stride);
+	if (!block->private.slots)
+	{
+		/* cleanup */
+		allocator->free(allocator->context, block, sizeof(struct NdsConcurrentQueueBlock));
+
+		return NULL;
+	}
+
+	block->queue.private = &block->private;
+	block->private.stride = stride;
+	block->private.sizeof_element = sizeof_element;
+	block->private.mask = rounded - 1;
+	block->private.blocking = blocking != 0;
+	block->private.closed = 0;
+	block->private.allocator = *allocator;
+	block->private.enqueue_position = 0;
+	block->private.dequeue_position = 0;
+	memset(&block->private.not_full, 0, sizeof(struct NdsQueueWait));
+	memset(&block->private.not_empty, 0, sizeof(struct NdsQueueWait));
+
+	/* every slot is free for the first lap */
+	for (i = 0; i < rounded; i++)
+		*NDS_SLOT_SEQUENCE(&block->private, i) = i;
+
+	return &block->queue;
+}
+
+
+void nds_concurrent_queue_destroy(NdsConcurrentQueue *queue)
+{
+	NdsAllocator allocator;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return;
+
+	/* the allocator lives inside the block that is released last, so we keep a copy of it */
+	allocator = queue->private->allocator;
+
+	allocator.free(allocator.context, queue->private->slots, (queue->private->mask + 1) * queue->private->stride);
+	queue->private = NULL;
+
+	allocator.free(allocator.context, queue, sizeof(struct NdsConcurrentQueueBlock));
+	queue = NULL;
+}
+
+
+ssize_t nds_concurrent_queue_capacity(NdsConcurrentQueue *queue)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return -1;
+
+	return (ssize_t)(queue->private->mask + 1);
+}
+
+
+ssize_t nds_concurrent_queue_size(NdsConcurrentQueue *queue)
+{
+	size_t dequeue_position, enqueue_position;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return -1;
+
+	/* the consumers may pass the position of the producers read before theirs, so theirs is read first */
+	dequeue_position = __atomic_load_n(&queue->private->dequeue_position, __ATOMIC_ACQUIRE);
+	enqueue_position = __atomic_load_n(&queue->private->enqueue_position, __ATOMIC_ACQUIRE);
+
+	return enqueue_position > dequeue_position ? (ssize_t)(enqueue_position - dequeue_position) : 0;
+}
+
+
+int nds_concurrent_queue_try_enqueue(NdsConcurrentQueue *queue, const void *element)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || element == NULL)
+		return -1;
+
+	return (int)nds_concurrent_queue_put(queue->private, (const char*)element, 1);
+}
+
+
+ssize_t nds_concurrent_queue_try_enqueue_n(NdsConcurrentQueue *queue, const void *elements, size_t count)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || (elements == NULL && count != 0))
+		return -1;
+
+	if (count == 0)
+		return 0;
+
+	return (ssize_t)nds_concurrent_queue_put(queue->private, (const char*)elements, count);
+}
+
+
+int nds_concurrent_queue_try_dequeue(NdsConcurrentQueue *queue, void *element)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return -1;
+
+	return (int)nds_concurrent_queue_take(queue->private, (char*)element, 1);
+}
+
+
+ssize_t nds_concurrent_queue_try_dequeue_n(NdsConcurrentQueue *queue, void *elements, size_t count)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return -1;
+
+	if (count == 0)
+		return 0;
+
+	return (ssize_t)nds_concurrent_queue_take(queue->private, (char*)elements, count);
+}
+
+
+NdsStatus nds_concurrent_queue_enqueue(NdsConcurrentQueue *queue, const void *element)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || element == NULL || !queue->private->blocking)
+		return NDS_INVALID_PARAM_ERROR;
+
+	if (__atomic_load_n(&queue->private->closed, __ATOMIC_ACQUIRE))
+		return NDS_ERROR;
+
+	return nds_concurrent_queue_wait_for(queue->private, 1, element, NULL);
+}
+
+
+NdsStatus nds_concurrent_queue_dequeue(NdsConcurrentQueue *queue, void *element)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || !queue->private->blocking)
+		return NDS_INVALID_PARAM_ERROR;
+
+	return nds_concurrent_queue_wait_for(queue->private, 0, NULL, element);
+}
+
+
+NdsStatus nds_concurrent_queue_close(NdsConcurrentQueue *queue)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || !queue->private->blocking)
+		return NDS_INVALID_PARAM_ERROR;
+
+	__atomic_store_n(&queue->private->closed, 1, __ATOMIC_SEQ_CST);
+
+	/* the waiters that read the event counter before this change do not sleep any more */
+	__atomic_add_fetch(&queue->private->not_full.event, 1, __ATOMIC_SEQ_CST);
+	__atomic_add_fetch(&queue->private->not_empty.event, 1, __ATOMIC_SEQ_CST);
+
+#ifdef NDS_CONCURRENT_QUEUE_HAS_FUTEX
+	syscall(SYS_futex, &queue->private->not_full.event, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+	syscall(SYS_futex, &queue->private->not_empty.event, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#endif
+
+	return NDS_OK;
+}
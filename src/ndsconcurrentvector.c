@@ -0,0 +1,377 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the implementation of the NdsConcurrentVector. The
+ * element with index i is stored in segment k at offset p - 2^m, where
+ * p = i + first, m = floor(log2(p)) and k = m - log2(first), so segment k
+ * holds first * 2^k elements. Every segment keeps a published flag per
+ * element after its elements, which the pushing thread sets once the copy
+ * of the element is complete.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include <nds/ndsconcurrentvector.h>
+
+#include <stdint.h>
+#include <string.h>
+
+
+/* enough segments for every index that fits in a size_t */
+#define NDS_CONCURRENT_VECTOR_SEGMENTS (sizeof(size_t) * 8)
+
+/* number of elements of the first segment of nds_concurrent_vector_new() */
+#define NDS_CONCURRENT_VECTOR_FIRST_SEGMENT 16
+
+struct NdsConcurrentVectorPrivate
+{
+	/* number of reserved indexes, incremented by every push, on its own cache line */
+	size_t reserved;
+	char reserved_padding[NDS_CACHE_LINE_SIZE - sizeof(size_t)];
+
+	/* number of published elements, also incremented by every push */
+	size_t published;
+	char published_padding[NDS_CACHE_LINE_SIZE - sizeof(size_t)];
+
+	/* the segments are allocated on demand and never move, so they are read without locks */
+	char *segments[NDS_CONCURRENT_VECTOR_SEGMENTS];
+	size_t sizeof_element;
+	unsigned int first_shift;
+	NdsAllocator allocator;
+};
+
+typedef struct NdsConcurrentVectorPrivate NdsConcurrentVectorPrivate;
+
+/* the handle and the private part of a NdsConcurrentVector are allocated as a single block */
+struct NdsConcurrentVectorBlock
+{
+	NdsConcurrentVector vector;
+	NdsConcurrentVectorPrivate private;
+};
+
+
+/* index of the most significant bit set in a non-zero value */
+static unsigned int nds_concurrent_vector_log2(size_t value)
+{
+	return (unsigned int)(sizeof(unsigned long long) * 8 - 1) - (unsigned int)__builtin_clzll((unsigned long long)value);
+}
+
+
+/* number of elements of a segment */
+static size_t nds_concurrent_vector_segment_capacity(NdsConcurrentVectorPrivate *private, size_t segment)
+{
+	return (size_t)1 << (private->first_shift + segment);
+}
+
+
+/* size in bytes of a segment, its elements followed by their published flags, or 0 if it overflows */
+static size_t nds_concurrent_vector_segment_size(NdsConcurrentVectorPrivate *private, size_t segment)
+{
+	size_t capacity = nds_concurrent_vector_segment_capacity(private, segment);
+
+	if (nds_size_overflows(capacity, private->sizeof_element + 1) || private->sizeof_element == SIZE_MAX)
+		return 0;
+
+	return capacity * (private->sizeof_element + 1);
+}
+
+
+/* finds the segment and the offset inside it of an index, returns 0 if the index cannot be stored */
+static int nds_concurrent_vector_locate(NdsConcurrentVectorPrivate *private, size_t index, size_t *segment, size_t *offset)
+{
+	size_t position;
+	unsigned int shift;
+
+	if (index > SIZE_MAX - ((size_t)1 << private->first_shift))
+		return 0;
+
+	position = index + ((size_t)1 << private->first_shift);
+	shift = nds_concurrent_vector_log2(position);
+
+	*segment = shift - private->first_shift;
+	*offset = position - ((size_t)1 << shift);
+
+	return 1;
+}
+
+
+/* returns a segment, allocating it if no thread did it yet */
+static char* nds_concurrent_vector_segment(NdsConcurrentVectorPrivate *private, size_t segment)
+{
+	char *existing = __atomic_load_n(&private->segments[segment], __ATOMIC_ACQUIRE);
+	char *fresh;
+	size_t size;
+
+	if (existing)
+		return existing;
+
+	size = nds_concurrent_vector_segment_size(private, segment);
+	if (size == 0)
+		return NULL;
+
+	fresh = (char*)private->allocator.alloc(private->allocator.context, size);
+	if (!fresh)
+		return NULL;
+
+	/* the published flags start cleared, the elements are written by the pushes */
+	memset(fresh + nds_concurrent_vector_segment_capacity(private, segment) * private->sizeof_element, 0, nds_concurrent_vector_segment_capacity(private, segment));
+
+	/* a single attempt is enough: a thread that loses the race uses the segment of the winner */
+	if (!__atomic_compare_exchange_n(&private->segments[segment], &existing, fresh, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+	{
+		/* cleanup */
+		private->allocator.free(private->allocator.context, fresh, size);
+
+		return existing;
+	}
+
+	return fresh;
+}
+
+
+/* returns the published flag of an element of a segment */
+static unsigned char* nds_concurrent_vector_flag(NdsConcurrentVectorPrivate *private, char *elements, size_t segment, size_t offset)
+{
+	return (unsigned char*)elements + nds_concurrent_vector_segment_capacity(private, segment) * private->sizeof_element + offset;
+}
+
+
+NdsConcurrentVector* nds_concurrent_vector_new(size_t sizeof_element)
+{
+	return nds_concurrent_vector_new_with_allocator(sizeof_element, NDS_CONCURRENT_VECTOR_FIRST_SEGMENT, nds_allocator_default());
+}
+
+
+NdsConcurrentVector* nds_concurrent_vector_new_with_allocator(size_t sizeof_element, size_t capacity, const NdsAllocator *allocator)
+{
+	struct NdsConcurrentVectorBlock *block;
+	unsigned int first_shift;
+	size_t i;
+
+	/* sanity checks */
+	if (sizeof_element == 0 || capacity == 0 || allocator == NULL)
+		return NULL;
+
+	if (allocator->alloc == NULL || allocator->free == NULL)
+		return NULL;
+
+	/* the first segment holds the next power of two elements */
+	first_shift = nds_concurrent_vector_log2(capacity);
+	if (capacity & (capacity - 1))
+		first_shift++;
+
+	if (first_shift >= NDS_CONCURRENT_VECTOR_SEGMENTS)
+		return NULL;
+
+	/* we allocate memory for the structure and the private part of the NdsConcurrentVector */
+	block = (struct NdsConcurrentVectorBlock*)allocator->alloc(allocator->context, sizeof(struct NdsConcurrentVectorBlock));
+	if (!block)
+		return NULL;
+
+	block->vector.private = &block->private;
+
+	/* various initializations */
+	block->private.reserved = 0;
+	block->private.published = 0;
+	block->private.sizeof_element = sizeof_element;
+	block->private.first_shift = first_shift;
+	block->private.allocator = *allocator;
+
+	for (i = 0; i < NDS_CONCURRENT_VECTOR_SEGMENTS; i++)
+		block->private.segments[i] = NULL;
+
+	return &block->vector;
+}
+
+
+void nds_concurrent_vector_destroy(NdsConcurrentVector *vector)
+{
+	NdsConcurrentVectorPrivate *private;
+	NdsAllocator allocator;
+	size_t i;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL)
+		return;
+
+	/* the allocator lives inside the block that is released last, so we keep a copy of it */
+	private = vector->private;
+	allocator = private->allocator;
+
+	for (i = 0; i < NDS_CONCURRENT_VECTOR_SEGMENTS; i++)
+		if (private->segments[i])
+			allocator.free(allocator.context, private->segments[i], nds_concurrent_vector_segment_size(private, i));
+
+	vector->private = NULL;
+
+	allocator.free(allocator.context, vector, sizeof(struct NdsConcurrentVectorBlock));
+	vector = NULL;
+}
+
+
+ssize_t nds_concurrent_vector_size(NdsConcurrentVector *vector)
+{
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL)
+		return -1;
+
+	return (ssize_t)__atomic_load_n(&vector->private->published, __ATOMIC_ACQUIRE);
+}
+
+
+NdsStatus nds_concurrent_vector_reserve(NdsConcurrentVector *vector, size_t capacity)
+{
+	size_t last, offset, i;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	if (capacity == 0)
+		return NDS_OK;
+
+	if (!nds_concurrent_vector_locate(vector->private, capacity - 1, &last, &offset))
+		return NDS_MEM_ALLOC_ERROR;
+
+	for (i = 0; i <= last; i++)
+		if (!nds_concurrent_vector_segment(vector->private, i))
+			return NDS_MEM_ALLOC_ERROR;
+
+	return NDS_OK;
+}
+
+
+ssize_t nds_concurrent_vector_push_back(NdsConcurrentVector *vector, const void *element)
+{
+	NdsConcurrentVectorPrivate *private;
+	size_t index, segment, offset;
+	char *elements;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || element == NULL)
+		return -1;
+
+	private = vector->private;
+	index = __atomic_load_n(&private->reserved, __ATOMIC_RELAXED);
+
+	/*
+	 * an index is only reserved once its segment exists, so a failed allocation
+	 * leaves no hole; the compare and swap fails only when another push reserved
+	 * the index first, and then the next free index is tried
+	 */
+	do
+	{
+		if (index > SIZE_MAX / 2 || !nds_concurrent_vector_locate(private, index, &segment, &offset))
+			return -1;
+
+		elements = nds_concurrent_vector_segment(private, segment);
+		if (!elements)
+			return -1;
+	}
+	while (!__atomic_compare_exchange_n(&private->reserved, &index, index + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+	memcpy(elements + offset * private->sizeof_element, element, private->sizeof_element);
+
+	/* the release store makes the copy visible to the readers that see the flag set */
+	__atomic_store_n(nds_concurrent_vector_flag(private, elements, segment, offset), 1, __ATOMIC_RELEASE);
+	__atomic_fetch_add(&private->published, 1, __ATOMIC_RELEASE);
+
+	return (ssize_t)index;
+}
+
+
+void* nds_concurrent_vector_at(NdsConcurrentVector *vector, size_t index)
+{
+	NdsConcurrentVectorPrivate *private;
+	size_t segment, offset;
+	char *elements;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL)
+		return NULL;
+
+	private = vector->private;
+
+	if (index >= __atomic_load_n(&private->reserved, __ATOMIC_RELAXED) || !nds_concurrent_vector_locate(private, index, &segment, &offset))
+		return NULL;
+
+	elements = __atomic_load_n(&private->segments[segment], __ATOMIC_ACQUIRE);
+	if (!elements || !__atomic_load_n(nds_concurrent_vector_flag(private, elements, segment, offset), __ATOMIC_ACQUIRE))
+		return NULL;
+
+	return elements + offset * private->sizeof_element;
+}
+
+
+NdsStatus nds_concurrent_vector_get(NdsConcurrentVector *vector, size_t index, void *element)
+{
+	void *source;
+
+	/* sanity checks */
+	if (element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	source = nds_concurrent_vector_at(vector, index);
+	if (!source)
+		return NDS_INVALID_PARAM_ERROR;
+
+	memcpy(element, source, vector->private->sizeof_element);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_concurrent_vector_for_each(NdsConcurrentVector *vector, NdsElementFunction function, void *context)
+{
+	NdsConcurrentVectorPrivate *private;
+	size_t end, index, segment, capacity, offset;
+	unsigned char *flags;
+	char *elements;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || function == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = vector->private;
+	end = __atomic_load_n(&private->reserved, __ATOMIC_RELAXED);
+
+	/* the segments are walked one after the other, the indexes they hold are contiguous */
+	for (index = 0, segment = 0; index < end && segment < NDS_CONCURRENT_VECTOR_SEGMENTS; segment++)
+	{
+		capacity = nds_concurrent_vector_segment_capacity(private, segment);
+
+		elements = __atomic_load_n(&private->segments[segment], __ATOMIC_ACQUIRE);
+		if (!elements)
+		{
+			index += capacity;
+			continue;
+		}
+
+		flags = nds_concurrent_vector_flag(private, elements, segment, 0);
+		for (offset = 0; offset < capacity && index < end; offset++, index++)
+			if (__atomic_load_n(&flags[offset], __ATOMIC_ACQUIRE))
+				function(elements + offset * private->sizeof_element, context);
+	}
+
+	return NDS_OK;
+}
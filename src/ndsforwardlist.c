@@ -0,0 +1,457 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the implementation of the NdsForwardList and of the
+ * NdsConcurrentForwardList. The first link of a NdsConcurrentForwardList
+ * and the number of changes made to the list share one 64-bit word, which
+ * every push and pop replaces with a compare and swap.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include <nds/ndsforwardlist.h>
+
+#include <stdint.h>
+
+
+/* the bits of the word above the address of the first link count the changes */
+#if UINTPTR_MAX > 0xffffffffu
+#define NDS_TAG_SHIFT 48
+#else
+#define NDS_TAG_SHIFT 32
+#endif
+
+#define NDS_TAG_LINK_MASK (((uint64_t)1 << NDS_TAG_SHIFT) - 1)
+
+/* the first link and the counter of a word */
+#define NDS_TAG_LINK(word) ((NdsForwardLink*)(uintptr_t)((word) & NDS_TAG_LINK_MASK))
+#define NDS_TAG_COUNTER(word) ((word) >> NDS_TAG_SHIFT)
+
+/* the word of the given first link, whose counter is one past the one of the previous word */
+#define NDS_TAG_NEXT(link, previous) ((uint64_t)(uintptr_t)(link) | (NDS_TAG_COUNTER(previous) + 1) << NDS_TAG_SHIFT)
+
+
+struct NdsForwardListPrivate
+{
+	NdsForwardLink *first;
+	NdsForwardLink *last;
+	size_t size;
+	NdsAllocator allocator;
+};
+
+typedef struct NdsForwardListPrivate NdsForwardListPrivate;
+
+/* the handle and the private part of a NdsForwardList are allocated as a single block */
+struct NdsForwardListBlock
+{
+	NdsForwardList list;
+	NdsForwardListPrivate private;
+};
+
+
+struct NdsConcurrentForwardListPrivate
+{
+	/* never written after the creation */
+	NdsAllocator allocator;
+	char shared_padding[NDS_CACHE_LINE_SIZE];
+
+	/* the first link and the change counter, on its own cache line */
+	uint64_t top;
+	char top_padding[NDS_CACHE_LINE_SIZE - sizeof(uint64_t)];
+};
+
+typedef struct NdsConcurrentForwardListPrivate NdsConcurrentForwardListPrivate;
+
+/* the handle and the private part of a NdsConcurrentForwardList are allocated as a single block */
+struct NdsConcurrentForwardListBlock
+{
+	NdsConcurrentForwardList list;
+	NdsConcurrentForwardListPrivate private;
+};
+
+
+NdsForwardList* nds_forward_list_new(void)
+{
+	return nds_forward_list_new_with_allocator(nds_allocator_default());
+}
+
+
+NdsForwardList* nds_forward_list_new_with_allocator(const NdsAllocator *allocator)
+{
+	struct NdsForwardListBlock *block;
+
+	/* sanity checks */
+	if (allocator == NULL || allocator->alloc == NULL || allocator->free == NULL)
+		return NULL;
+
+	/* we allocate memory for the structure and the private part of the NdsForwardList */
+	block = (struct NdsForwardListBlock*)allocator->alloc(allocator->context, sizeof(struct NdsForwardListBlock));
+	if (!block)
+		return NULL;
+
+	block->list.private = &block->private;
+	block->private.first = NULL;
+	block->private.last = NULL;
+	block->private.size = 0;
+	block->private.allocator = *allocator;
+
+	return &block->list;
+}
+
+
+void nds_forward_list_destroy(NdsForwardList *list)
+{
+	NdsAllocator allocator;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return;
+
+	/* the allocator lives inside the block that is released, so we keep a copy of it */
+	allocator = list->private->allocator;
+	list->private = NULL;
+
+	allocator.free(allocator.context, list, sizeof(struct NdsForwardListBlock));
+	list = NULL;
+}
+
+
+ssize_t nds_forward_list_size(NdsForwardList *list)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return -1;
+
+	return (ssize_t)list->private->size;
+}
+
+
+NdsForwardLink* nds_forward_list_first(NdsForwardList *list)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return NULL;
+
+	return list->private->first;
+}
+
+
+NdsForwardLink* nds_forward_list_last(NdsForwardList *list)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return NULL;
+
+	return list->private->last;
+}
+
+
+NdsStatus nds_forward_list_push_front(NdsForwardList *list, NdsForwardLink *link)
+{
+	return nds_forward_list_insert_after(list, NULL, link);
+}
+
+
+NdsStatus nds_forward_list_push_back(NdsForwardList *list, NdsForwardLink *link)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	return nds_forward_list_insert_after(list, list->private->last, link);
+}
+
+
+NdsForwardLink* nds_forward_list_pop_front(NdsForwardList *list)
+{
+	return nds_forward_list_remove_after(list, NULL);
+}
+
+
+NdsStatus nds_forward_list_insert_after(NdsForwardList *list, NdsForwardLink *position, NdsForwardLink *link)
+{
+	NdsForwardListPrivate *private;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || link == NULL || link == position)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = list->private;
+
+	if (position != NULL)
+	{
+		link->next = position->next;
+		position->next = link;
+	}
+	else
+	{
+		link->next = private->first;
+		private->first = link;
+	}
+
+	if (position == private->last)
+		private->last = link;
+
+	private->size++;
+
+	return NDS_OK;
+}
+
+
+NdsForwardLink* nds_forward_list_remove_after(NdsForwardList *list, NdsForwardLink *position)
+{
+	NdsForwardListPrivate *private;
+	NdsForwardLink *link;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return NULL;
+
+	private = list->private;
+
+	link = position != NULL ? position->next : private->first;
+	if (link == NULL)
+		return NULL;
+
+	if (position != NULL)
+		position->next = link->next;
+	else
+		private->first = link->next;
+
+	if (link == private->last)
+		private->last = position;
+
+	link->next = NULL;
+	private->size--;
+
+	return link;
+}
+
+
+NdsStatus nds_forward_list_remove(NdsForwardList *list, NdsForwardLink *link)
+{
+	NdsForwardLink *previous = NULL, *current;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || link == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	for (current = list->private->first; current != NULL && current != link; current = current->next)
+		previous = current;
+
+	if (current == NULL)
+		return NDS_ERROR;
+
+	nds_forward_list_remove_after(list, previous);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_forward_list_splice_back(NdsForwardList *list, NdsForwardList *other)
+{
+	NdsForwardListPrivate *private, *source;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || other == NULL || other->private == NULL || other->private == list->private)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = list->private;
+	source = other->private;
+
+	if (source->first == NULL)
+		return NDS_OK;
+
+	if (private->last != NULL)
+		private->last->next = source->first;
+	else
+		private->first = source->first;
+
+	private->last = source->last;
+	private->size += source->size;
+
+	source->first = NULL;
+	source->last = NULL;
+	source->size = 0;
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_forward_list_reverse(NdsForwardList *list)
+{
+	NdsForwardLink *reversed = NULL, *link, *next;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	list->private->last = list->private->first;
+
+	for (link = list->private->first; link != NULL; link = next)
+	{
+		next = link->next;
+		link->next = reversed;
+		reversed = link;
+	}
+
+	list->private->first = reversed;
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_forward_list_clear(NdsForwardList *list)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	list->private->first = NULL;
+	list->private->last = NULL;
+	list->private->size = 0;
+
+	return NDS_OK;
+}
+
+
+NdsConcurrentForwardList* nds_concurrent_forward_list_new(void)
+{
+	return nds_concurrent_forward_list_new_with_allocator(nds_allocator_default());
+}
+
+
+NdsConcurrentForwardList* nds_concurrent_forward_list_new_with_allocator(const NdsAllocator *allocator)
+{
+	struct NdsConcurrentForwardListBlock *block;
+
+	/* sanity checks */
+	if (allocator == NULL || allocator->alloc == NULL || allocator->free == NULL)
+		return NULL;
+
+	/* we allocate memory for the structure and the private part of the NdsConcurrentForwardList */
+	block = (struct NdsConcurrentForwardListBlock*)allocator->alloc(allocator->context, sizeof(struct NdsConcurrentForwardListBlock));
+	if (!block)
+		return NULL;
+
+	block->list.private = &block->private;
+	block->private.allocator = *allocator;
+	block->private.top = 0;
+
+	return &block->list;
+}
+
+
+void nds_concurrent_forward_list_destroy(NdsConcurrentForwardList *list)
+{
+	NdsAllocator allocator;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return;
+
+	/* the allocator lives inside the block that is released, so we keep a copy of it */
+	allocator = list->private->allocator;
+	list->private = NULL;
+
+	allocator.free(allocator.context, list, sizeof(struct NdsConcurrentForwardListBlock));
+	list = NULL;
+}
+
+
+NdsStatus nds_concurrent_forward_list_push_front(NdsConcurrentForwardList *list, NdsForwardLink *link)
+{
+	return nds_concurrent_forward_list_push_front_n(list, link, link);
+}
+
+
+NdsStatus nds_concurrent_forward_list_push_front_n(NdsConcurrentForwardList *list, NdsForwardLink *first, NdsForwardLink *last)
+{
+	uint64_t top;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || first == NULL || last == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	/* the links must leave the bits of the counter free */
+	if (((uint64_t)(uintptr_t)first & ~NDS_TAG_LINK_MASK) != 0 || ((uint64_t)(uintptr_t)last & ~NDS_TAG_LINK_MASK) != 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+	top = __atomic_load_n(&list->private->top, __ATOMIC_RELAXED);
+
+	/* the release publishes the chain, and what the caller wrote in its structures, to the thread that pops it */
+	do
+		__atomic_store_n(&last->next, NDS_TAG_LINK(top), __ATOMIC_RELAXED);
+	while (!__atomic_compare_exchange_n(&list->private->top, &top, NDS_TAG_NEXT(first, top), 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+	return NDS_OK;
+}
+
+
+NdsForwardLink* nds_concurrent_forward_list_pop_front(NdsConcurrentForwardList *list)
+{
+	NdsForwardLink *link, *next;
+	uint64_t top;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return NULL;
+
+	top = __atomic_load_n(&list->private->top, __ATOMIC_ACQUIRE);
+
+	/*
+	 * the link may be popped and pushed back by other threads between the
+	 * read of its next pointer and the compare and swap, which then fails
+	 * because the counter changed even though the first link is the same
+	 */
+	do
+	{
+		link = NDS_TAG_LINK(top);
+		if (link == NULL)
+			return NULL;
+
+		next = __atomic_load_n(&link->next, __ATOMIC_RELAXED);
+	}
+	while (!__atomic_compare_exchange_n(&list->private->top, &top, NDS_TAG_NEXT(next, top), 1, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+
+	return link;
+}
+
+
+NdsForwardLink* nds_concurrent_forward_list_pop_all(NdsConcurrentForwardList *list)
+{
+	uint64_t top;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return NULL;
+
+	top = __atomic_load_n(&list->private->top, __ATOMIC_ACQUIRE);
+
+	do
+		if (NDS_TAG_LINK(top) == NULL)
+			return NULL;
+	while (!__atomic_compare_exchange_n(&list->private->top, &top, NDS_TAG_NEXT(NULL, top), 1, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+
+	return NDS_TAG_LINK(top);
+}
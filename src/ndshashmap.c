@@ -0,0 +1,275 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the implementation of the NdsHashMap. The pairs are
+ * the entries of an open-addressing table (see ndshashtable.h), whose
+ * values follow their keys.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include <nds/ndshashmap.h>
+
+#include "ndshashtable.h"
+
+#include <stdint.h>
+#include <string.h>
+
+
+struct NdsHashMapPrivate
+{
+	NdsHashTable table;
+};
+
+typedef struct NdsHashMapPrivate NdsHashMapPrivate;
+
+/* the handle and the private part of a NdsHashMap are allocated as a single block */
+struct NdsHashMapBlock
+{
+	NdsHashMap map;
+	NdsHashMapPrivate private;
+};
+
+
+NdsHashMap* nds_hash_map_new(size_t sizeof_key, size_t sizeof_value, NdsHashFunction hash, NdsEqualFunction equal)
+{
+	/* the smallest table has 16 slots */
+	return nds_hash_map_new_with_allocator(sizeof_key, sizeof_value, hash, equal, nds_hash_table_max_load(16), nds_allocator_default());
+}
+
+
+NdsHashMap* nds_hash_map_new_with_allocator(size_t sizeof_key, size_t sizeof_value, NdsHashFunction hash, NdsEqualFunction equal, size_t capacity, const NdsAllocator *allocator)
+{
+	struct NdsHashMapBlock *block;
+
+	/* sanity checks */
+	if (sizeof_key == 0 || allocator == NULL)
+		return NULL;
+
+	if (allocator->alloc == NULL || allocator->free == NULL)
+		return NULL;
+
+	/* we allocate memory for the structure and the private part of the NdsHashMap */
+	block = (struct NdsHashMapBlock*)allocator->alloc(allocator->context, sizeof(struct NdsHashMapBlock));
+	if (!block)
+		return NULL;
+
+	block->map.private = &block->private;
+
+	if (nds_hash_table_init(&block->private.table, sizeof_key, sizeof_value, hash, equal, capacity, allocator) != NDS_OK)
+	{
+		/* cleanup */
+		allocator->free(allocator->context, block, sizeof(struct NdsHashMapBlock));
+
+		return NULL;
+	}
+
+	return &block->map;
+}
+
+
+void nds_hash_map_destroy(NdsHashMap *map)
+{
+	NdsAllocator allocator;
+
+	/* sanity checks */
+	if (map == NULL || map->private == NULL)
+		return;
+
+	/* the allocator lives inside the block that is released last, so we keep a copy of it */
+	allocator = map->private->table.allocator;
+
+	nds_hash_table_release(&map->private->table);
+	map->private = NULL;
+
+	allocator.free(allocator.context, map, sizeof(struct NdsHashMapBlock));
+	map = NULL;
+}
+
+
+ssize_t nds_hash_map_size(NdsHashMap *map)
+{
+	/* sanity checks */
+	if (map == NULL || map->private == NULL)
+		return -1;
+
+	return (ssize_t)map->private->table.size;
+}
+
+
+ssize_t nds_hash_map_capacity(NdsHashMap *map)
+{
+	/* sanity checks */
+	if (map == NULL || map->private == NULL)
+		return -1;
+
+	return (ssize_t)nds_hash_table_max_load(map->private->table.slots);
+}
+
+
+NdsStatus nds_hash_map_reserve(NdsHashMap *map, size_t capacity)
+{
+	/* sanity checks */
+	if (map == NULL || map->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	return nds_hash_table_reserve(&map->private->table, capacity);
+}
+
+
+NdsStatus nds_hash_map_insert(NdsHashMap *map, const void *key, const void *value)
+{
+	NdsHashTable *table;
+	uint64_t hash;
+	size_t slot;
+
+	/* sanity checks */
+	if (map == NULL || map->private == NULL || key == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	table = &map->private->table;
+
+	if (value == NULL && table->sizeof_value != 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+	hash = nds_hash_table_hash(table, key);
+	slot = nds_hash_table_find_hashed(table, key, hash);
+
+	/* a new key gets a slot, an existing one gets its value overwritten */
+	if (slot == table->slots)
+	{
+		slot = nds_hash_table_add(table, key, hash);
+		if (slot == table->slots)
+			return NDS_MEM_ALLOC_ERROR;
+	}
+
+	if (table->sizeof_value != 0)
+		memcpy(nds_hash_table_entry(table, slot) + table->value_offset, value, table->sizeof_value);
+
+	return NDS_OK;
+}
+
+
+void* nds_hash_map_find(NdsHashMap *map, const void *key)
+{
+	NdsHashTable *table;
+	size_t slot;
+
+	/* sanity checks */
+	if (map == NULL || map->private == NULL || key == NULL)
+		return NULL;
+
+	table = &map->private->table;
+
+	slot = nds_hash_table_find(table, key);
+	if (slot == table->slots)
+		return NULL;
+
+	return nds_hash_table_entry(table, slot) + table->value_offset;
+}
+
+
+NdsStatus nds_hash_map_get(NdsHashMap *map, const void *key, void *value)
+{
+	void *source;
+
+	/* sanity checks */
+	if (value == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	source = nds_hash_map_find(map, key);
+	if (!source)
+		return NDS_INVALID_PARAM_ERROR;
+
+	memcpy(value, source, map->private->table.sizeof_value);
+
+	return NDS_OK;
+}
+
+
+int nds_hash_map_contains(NdsHashMap *map, const void *key)
+{
+	/* sanity checks */
+	if (map == NULL || map->private == NULL || key == NULL)
+		return -1;
+
+	return nds_hash_map_find(map, key) != NULL;
+}
+
+
+NdsStatus nds_hash_map_remove(NdsHashMap *map, const void *key, void *value)
+{
+	NdsHashTable *table;
+	size_t slot;
+
+	/* sanity checks */
+	if (map == NULL || map->private == NULL || key == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	table = &map->private->table;
+
+	slot = nds_hash_table_find(table, key);
+	if (slot == table->slots)
+		return NDS_INVALID_PARAM_ERROR;
+
+	if (value)
+		memcpy(value, nds_hash_table_entry(table, slot) + table->value_offset, table->sizeof_value);
+
+	nds_hash_table_erase(table, slot);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_hash_map_clear(NdsHashMap *map)
+{
+	/* sanity checks */
+	if (map == NULL || map->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	nds_hash_table_clear(&map->private->table);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_hash_map_for_each(NdsHashMap *map, NdsEntryFunction function, void *context)
+{
+	NdsHashTable *table;
+	size_t slot;
+	char *entry;
+
+	/* sanity checks */
+	if (map == NULL || map->private == NULL || function == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	table = &map->private->table;
+
+	for (slot = nds_hash_table_next(table, 0); slot < table->slots; slot = nds_hash_table_next(table, slot + 1))
+	{
+		entry = nds_hash_table_entry(table, slot);
+		function(entry, entry + table->value_offset, context);
+	}
+
+	return NDS_OK;
+}
@@ -0,0 +1,539 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the implementation of the NdsHashSet. The elements are
+ * the keys of an open-addressing table (see ndshashtable.h) without values.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+/* ndsvector.c exports the accessors, this file only needs the private part of the vector */
+#define NDS_INLINE_FAST_PATH
+
+#include <nds/ndshashset.h>
+
+#include "ndshashtable.h"
+
+#include <stdint.h>
+#include <string.h>
+
+
+/* number of elements hashed and prefetched before the first of them is probed */
+#define NDS_HASH_BATCH 16
+
+
+struct NdsHashSetPrivate
+{
+	NdsHashTable table;
+};
+
+typedef struct NdsHashSetPrivate NdsHashSetPrivate;
+
+/* the handle and the private part of a NdsHashSet are allocated as a single block */
+struct NdsHashSetBlock
+{
+	NdsHashSet set;
+	NdsHashSetPrivate private;
+};
+
+
+/* hashes a batch of elements and prefetches their home slots */
+static void nds_hash_set_prepare(NdsHashTable *table, const char **elements, size_t count, uint64_t *hashes)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++)
+		hashes[i] = nds_hash_table_hash(table, elements[i]);
+
+	for (i = 0; i < count; i++)
+		nds_hash_table_prefetch(table, hashes[i]);
+}
+
+
+/* stores in found[i] whether the i-th element of a batch is in the table, returns how many are */
+static size_t nds_hash_set_find_batch(NdsHashTable *table, const char **elements, size_t count, const uint64_t *hashes, unsigned char *found)
+{
+	size_t i, total = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		found[i] = nds_hash_table_find_hashed(table, elements[i], hashes[i]) != table->slots;
+		total += found[i];
+	}
+
+	return total;
+}
+
+
+/*
+ * Adds the elements of a batch that are not in the table and stores in
+ * inserted[i] whether the i-th one was added. Returns how many were added,
+ * or count + 1 if the table could not grow.
+ */
+static size_t nds_hash_set_add_batch(NdsHashTable *table, const char **elements, size_t count, const uint64_t *hashes, unsigned char *inserted)
+{
+	size_t i, total = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		inserted[i] = 0;
+
+		if (nds_hash_table_find_hashed(table, elements[i], hashes[i]) != table->slots)
+			continue;
+
+		if (nds_hash_table_add(table, elements[i], hashes[i]) == table->slots)
+			return count + 1;
+
+		inserted[i] = 1;
+		total++;
+	}
+
+	return total;
+}
+
+
+/* fills a batch with the addresses of the used entries of a table from slot on, returns the number of entries */
+static size_t nds_hash_set_gather(NdsHashTable *table, size_t *slot, const char **elements)
+{
+	size_t count = 0;
+
+	for (*slot = nds_hash_table_next(table, *slot); *slot < table->slots && count < NDS_HASH_BATCH; *slot = nds_hash_table_next(table, *slot + 1))
+		elements[count++] = nds_hash_table_entry(table, *slot);
+
+	return count;
+}
+
+
+/* checks that two sets hold the same kind of elements */
+static int nds_hash_set_compatible(NdsHashSet *first, NdsHashSet *second)
+{
+	NdsHashTable *a, *b;
+
+	if (first == NULL || first->private == NULL || second == NULL || second->private == NULL)
+		return 0;
+
+	a = &first->private->table;
+	b = &second->private->table;
+
+	return a->sizeof_key == b->sizeof_key && a->hash == b->hash && a->equal == b->equal;
+}
+
+
+NdsHashSet* nds_hash_set_new(size_t sizeof_element, NdsHashFunction hash, NdsEqualFunction equal)
+{
+	/* the smallest table has 16 slots */
+	return nds_hash_set_new_with_allocator(sizeof_element, hash, equal, nds_hash_table_max_load(16), nds_allocator_default());
+}
+
+
+NdsHashSet* nds_hash_set_new_with_allocator(size_t sizeof_element, NdsHashFunction hash, NdsEqualFunction equal, size_t capacity, const NdsAllocator *allocator)
+{
+	struct NdsHashSetBlock *block;
+
+	/* sanity checks */
+	if (sizeof_element == 0 || allocator == NULL)
+		return NULL;
+
+	if (allocator->alloc == NULL || allocator->free == NULL)
+		return NULL;
+
+	/* we allocate memory for the structure and the private part of the NdsHashSet */
+	block = (struct NdsHashSetBlock*)allocator->alloc(allocator->context, sizeof(struct NdsHashSetBlock));
+	if (!block)
+		return NULL;
+
+	block->set.private = &block->private;
+
+	if (nds_hash_table_init(&block->private.table, sizeof_element, 0, hash, equal, capacity, allocator) != NDS_OK)
+	{
+		/* cleanup */
+		allocator->free(allocator->context, block, sizeof(struct NdsHashSetBlock));
+
+		return NULL;
+	}
+
+	return &block->set;
+}
+
+
+NdsHashSet* nds_hash_set_new_from_vector(NdsVector *vector, NdsHashFunction hash, NdsEqualFunction equal)
+{
+	NdsHashSet *set;
+	ssize_t size;
+
+	/* sanity checks */
+	size = nds_vector_size(vector);
+	if (size < 0)
+		return NULL;
+
+	/* the table is sized for every element, so the batched insertion never grows it */
+	set = nds_hash_set_new_with_allocator(vector->private->sizeof_element, hash, equal, (size_t)size, nds_allocator_default());
+	if (!set)
+		return NULL;
+
+	if (nds_hash_set_insert_batch(set, nds_vector_data(vector), (size_t)size, NULL) < 0)
+	{
+		/* cleanup */
+		nds_hash_set_destroy(set);
+
+		return NULL;
+	}
+
+	return set;
+}
+
+
+void nds_hash_set_destroy(NdsHashSet *set)
+{
+	NdsAllocator allocator;
+
+	/* sanity checks */
+	if (set == NULL || set->private == NULL)
+		return;
+
+	/* the allocator lives inside the block that is released last, so we keep a copy of it */
+	allocator = set->private->table.allocator;
+
+	nds_hash_table_release(&set->private->table);
+	set->private = NULL;
+
+	allocator.free(allocator.context, set, sizeof(struct NdsHashSetBlock));
+	set = NULL;
+}
+
+
+ssize_t nds_hash_set_size(NdsHashSet *set)
+{
+	/* sanity checks */
+	if (set == NULL || set->private == NULL)
+		return -1;
+
+	return (ssize_t)set->private->table.size;
+}
+
+
+ssize_t nds_hash_set_capacity(NdsHashSet *set)
+{
+	/* sanity checks */
+	if (set == NULL || set->private == NULL)
+		return -1;
+
+	return (ssize_t)nds_hash_table_max_load(set->private->table.slots);
+}
+
+
+NdsStatus nds_hash_set_reserve(NdsHashSet *set, size_t capacity)
+{
+	/* sanity checks */
+	if (set == NULL || set->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	return nds_hash_table_reserve(&set->private->table, capacity);
+}
+
+
+NdsStatus nds_hash_set_insert(NdsHashSet *set, const void *element)
+{
+	NdsHashTable *table;
+	uint64_t hash;
+
+	/* sanity checks */
+	if (set == NULL || set->private == NULL || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	table = &set->private->table;
+
+	hash = nds_hash_table_hash(table, element);
+	if (nds_hash_table_find_hashed(table, element, hash) != table->slots)
+		return NDS_OK;
+
+	if (nds_hash_table_add(table, element, hash) == table->slots)
+		return NDS_MEM_ALLOC_ERROR;
+
+	return NDS_OK;
+}
+
+
+ssize_t nds_hash_set_insert_batch(NdsHashSet *set, const void *elements, size_t count, unsigned char *inserted)
+{
+	const char *batch[NDS_HASH_BATCH];
+	uint64_t hashes[NDS_HASH_BATCH];
+	unsigned char flags[NDS_HASH_BATCH];
+	NdsHashTable *table;
+	size_t i, j, length, added, total = 0;
+
+	/* sanity checks */
+	if (set == NULL || set->private == NULL || (elements == NULL && count != 0))
+		return -1;
+
+	table = &set->private->table;
+
+	if (count > SIZE_MAX / 2 / table->sizeof_key)
+		return -1;
+
+	for (i = 0; i < count; i += length)
+	{
+		length = count - i < NDS_HASH_BATCH ? count - i : NDS_HASH_BATCH;
+
+		/* room for the batch keeps the prefetched slots valid, room for the whole array would be wasted on repeated elements */
+		if (nds_hash_table_reserve(table, table->size + length) != NDS_OK)
+			return -1;
+
+		for (j = 0; j < length; j++)
+			batch[j] = (const char*)elements + (i + j) * table->sizeof_key;
+
+		nds_hash_set_prepare(table, batch, length, hashes);
+
+		added = nds_hash_set_add_batch(table, batch, length, hashes, inserted ? inserted + i : flags);
+		if (added > length)
+			return -1;
+
+		total += added;
+	}
+
+	return (ssize_t)total;
+}
+
+
+int nds_hash_set_contains(NdsHashSet *set, const void *element)
+{
+	NdsHashTable *table;
+
+	/* sanity checks */
+	if (set == NULL || set->private == NULL || element == NULL)
+		return -1;
+
+	table = &set->private->table;
+
+	return nds_hash_table_find(table, element) != table->slots;
+}
+
+
+ssize_t nds_hash_set_contains_batch(NdsHashSet *set, const void *elements, size_t count, unsigned char *found)
+{
+	const char *batch[NDS_HASH_BATCH];
+	uint64_t hashes[NDS_HASH_BATCH];
+	unsigned char flags[NDS_HASH_BATCH];
+	NdsHashTable *table;
+	size_t i, j, length, total = 0;
+
+	/* sanity checks */
+	if (set == NULL || set->private == NULL || (elements == NULL && count != 0))
+		return -1;
+
+	table = &set->private->table;
+
+	if (count > SIZE_MAX / 2 / table->sizeof_key)
+		return -1;
+
+	for (i = 0; i < count; i += length)
+	{
+		length = count - i < NDS_HASH_BATCH ? count - i : NDS_HASH_BATCH;
+
+		for (j = 0; j < length; j++)
+			batch[j] = (const char*)elements + (i + j) * table->sizeof_key;
+
+		nds_hash_set_prepare(table, batch, length, hashes);
+		total += nds_hash_set_find_batch(table, batch, length, hashes, found ? found + i : flags);
+	}
+
+	return (ssize_t)total;
+}
+
+
+NdsStatus nds_hash_set_remove(NdsHashSet *set, const void *element)
+{
+	NdsHashTable *table;
+	size_t slot;
+
+	/* sanity checks */
+	if (set == NULL || set->private == NULL || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	table = &set->private->table;
+
+	slot = nds_hash_table_find(table, element);
+	if (slot == table->slots)
+		return NDS_INVALID_PARAM_ERROR;
+
+	nds_hash_table_erase(table, slot);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_hash_set_clear(NdsHashSet *set)
+{
+	/* sanity checks */
+	if (set == NULL || set->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	nds_hash_table_clear(&set->private->table);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_hash_set_for_each(NdsHashSet *set, NdsElementFunction function, void *context)
+{
+	NdsHashTable *table;
+	size_t slot;
+
+	/* sanity checks */
+	if (set == NULL || set->private == NULL || function == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	table = &set->private->table;
+
+	for (slot = nds_hash_table_next(table, 0); slot < table->slots; slot = nds_hash_table_next(table, slot + 1))
+		function(nds_hash_table_entry(table, slot), context);
+
+	return NDS_OK;
+}
+
+
+NdsHashSet* nds_hash_set_union(NdsHashSet *first, NdsHashSet *second)
+{
+	const char *batch[NDS_HASH_BATCH];
+	uint64_t hashes[NDS_HASH_BATCH];
+	unsigned char flags[NDS_HASH_BATCH];
+	NdsHashTable *larger, *smaller, *table;
+	NdsHashSet *result;
+	size_t slot, length, i;
+
+	/* sanity checks */
+	if (!nds_hash_set_compatible(first, second))
+		return NULL;
+
+	larger = &first->private->table;
+	smaller = &second->private->table;
+	if (larger->size < smaller->size)
+	{
+		larger = &second->private->table;
+		smaller = &first->private->table;
+	}
+
+	/* the result is sized for both sets, so it never grows */
+	result = nds_hash_set_new_with_allocator(larger->sizeof_key, larger->hash, larger->equal, larger->size + smaller->size, &first->private->table.allocator);
+	if (!result)
+		return NULL;
+
+	table = &result->private->table;
+
+	/* the elements of the larger set are distinct, so they are added without being looked up */
+	for (slot = 0; (length = nds_hash_set_gather(larger, &slot, batch)) != 0; )
+	{
+		nds_hash_set_prepare(table, batch, length, hashes);
+
+		for (i = 0; i < length; i++)
+			nds_hash_table_add(table, batch[i], hashes[i]);
+	}
+
+	for (slot = 0; (length = nds_hash_set_gather(smaller, &slot, batch)) != 0; )
+	{
+		nds_hash_set_prepare(table, batch, length, hashes);
+		nds_hash_set_add_batch(table, batch, length, hashes, flags);
+	}
+
+	return result;
+}
+
+
+NdsHashSet* nds_hash_set_intersection(NdsHashSet *first, NdsHashSet *second)
+{
+	const char *batch[NDS_HASH_BATCH];
+	uint64_t hashes[NDS_HASH_BATCH];
+	unsigned char found[NDS_HASH_BATCH];
+	NdsHashTable *larger, *smaller, *table;
+	NdsHashSet *result;
+	size_t slot, length, i;
+
+	/* sanity checks */
+	if (!nds_hash_set_compatible(first, second))
+		return NULL;
+
+	larger = &first->private->table;
+	smaller = &second->private->table;
+	if (larger->size < smaller->size)
+	{
+		larger = &second->private->table;
+		smaller = &first->private->table;
+	}
+
+	/* the intersection is at most as large as the smaller set */
+	result = nds_hash_set_new_with_allocator(larger->sizeof_key, larger->hash, larger->equal, smaller->size, &first->private->table.allocator);
+	if (!result)
+		return NULL;
+
+	table = &result->private->table;
+
+	/* both sets hash the elements the same way, so the hashes computed for the lookups serve the result too */
+	for (slot = 0; (length = nds_hash_set_gather(smaller, &slot, batch)) != 0; )
+	{
+		nds_hash_set_prepare(larger, batch, length, hashes);
+		nds_hash_set_find_batch(larger, batch, length, hashes, found);
+
+		for (i = 0; i < length; i++)
+			if (found[i])
+				nds_hash_table_add(table, batch[i], hashes[i]);
+	}
+
+	return result;
+}
+
+
+NdsHashSet* nds_hash_set_difference(NdsHashSet *first, NdsHashSet *second)
+{
+	const char *batch[NDS_HASH_BATCH];
+	uint64_t hashes[NDS_HASH_BATCH];
+	unsigned char found[NDS_HASH_BATCH];
+	NdsHashTable *source, *other, *table;
+	NdsHashSet *result;
+	size_t slot, length, i;
+
+	/* sanity checks */
+	if (!nds_hash_set_compatible(first, second))
+		return NULL;
+
+	source = &first->private->table;
+	other = &second->private->table;
+
+	/* the difference is at most as large as the first set */
+	result = nds_hash_set_new_with_allocator(source->sizeof_key, source->hash, source->equal, source->size, &source->allocator);
+	if (!result)
+		return NULL;
+
+	table = &result->private->table;
+
+	for (slot = 0; (length = nds_hash_set_gather(source, &slot, batch)) != 0; )
+	{
+		nds_hash_set_prepare(other, batch, length, hashes);
+		nds_hash_set_find_batch(other, batch, length, hashes, found);
+
+		for (i = 0; i < length; i++)
+			if (!found[i])
+				nds_hash_table_add(table, batch[i], hashes[i]);
+	}
+
+	return result;
+}
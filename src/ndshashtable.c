@@ -0,0 +1,293 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the parts of the open-addressing table of NdsHashMap
+ * and NdsHashSet that are not inlined in the lookups (see ndshashtable.h).
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndshashtable.h"
+
+
+/* smallest number of slots of a table */
+#define NDS_HASH_MIN_SLOTS 16
+
+/* largest alignment given to the keys and the values */
+#define NDS_HASH_MAX_ALIGNMENT 16
+
+
+/* alignment of an object of the given size: its lowest set bit, capped at NDS_HASH_MAX_ALIGNMENT */
+static size_t nds_hash_alignment(size_t size)
+{
+	size_t alignment = size & (~size + 1);
+
+	return size == 0 || alignment > NDS_HASH_MAX_ALIGNMENT ? NDS_HASH_MAX_ALIGNMENT : alignment;
+}
+
+
+/* size in bytes of the allocation of a table, or 0 if it overflows */
+static size_t nds_hash_table_size(NdsHashTable *table, size_t slots)
+{
+	if (nds_size_overflows(slots, table->sizeof_entry) || slots * table->sizeof_entry > SIZE_MAX - slots - NDS_HASH_GROUP)
+		return 0;
+
+	return slots * table->sizeof_entry + slots + NDS_HASH_GROUP - 1;
+}
+
+
+/* number of slots of the smallest table that holds count entries, or 0 if there is none */
+static size_t nds_hash_table_slots_for(size_t count)
+{
+	size_t slots = NDS_HASH_MIN_SLOTS;
+
+	while (nds_hash_table_max_load(slots) < count)
+	{
+		if (slots > SIZE_MAX / 2)
+			return 0;
+		slots *= 2;
+	}
+
+	return slots;
+}
+
+
+/* writes the control byte of a slot and of its mirror */
+static void nds_hash_table_set_control(NdsHashTable *table, size_t slot, unsigned char value)
+{
+	table->control[slot] = value;
+
+	if (slot < NDS_HASH_GROUP - 1)
+		table->control[table->slots + slot] = value;
+}
+
+
+/* returns the first empty slot of the run that starts at the home slot of hash */
+static size_t nds_hash_table_free_slot(NdsHashTable *table, uint64_t hash)
+{
+	size_t mask = table->slots - 1, position = NDS_HASH_HOME(hash, table->slots);
+	unsigned int empty;
+
+	for (;;)
+	{
+		nds_hash_table_match(table->control + position, NDS_HASH_EMPTY, &empty);
+		if (empty)
+			return (position + (size_t)__builtin_ctz(empty)) & mask;
+
+		position = (position + NDS_HASH_GROUP) & mask;
+	}
+}
+
+
+/* allocates a table of the given number of slots with all of them empty */
+static NdsStatus nds_hash_table_allocate(NdsHashTable *table, size_t slots)
+{
+	size_t size = nds_hash_table_size(table, slots);
+	char *entries;
+
+	if (size == 0)
+		return NDS_MEM_ALLOC_ERROR;
+
+	entries = (char*)table->allocator.alloc(table->allocator.context, size);
+	if (!entries)
+		return NDS_MEM_ALLOC_ERROR;
+
+	table->entries = entries;
+	table->control = (unsigned char*)entries + slots * table->sizeof_entry;
+	table->slots = slots;
+	table->growth_left = nds_hash_table_max_load(slots) - table->size;
+
+	memset(table->control, NDS_HASH_EMPTY, slots + NDS_HASH_GROUP - 1);
+
+	return NDS_OK;
+}
+
+
+/* moves every entry to a new table with the given number of slots */
+static NdsStatus nds_hash_table_rehash(NdsHashTable *table, size_t slots)
+{
+	char *old_entries = table->entries;
+	unsigned char *old_control = table->control;
+	size_t old_slots = table->slots, old_size = nds_hash_table_size(table, old_slots), i, slot;
+	const char *entry;
+	uint64_t hash;
+
+	/* the old table is left untouched when the new one cannot be allocated */
+	if (nds_hash_table_allocate(table, slots) != NDS_OK)
+		return NDS_MEM_ALLOC_ERROR;
+
+	/* the keys are known to be distinct, so they go to the first empty slot without any comparison */
+	for (i = 0; i < old_slots; i++)
+	{
+		if (old_control[i] & NDS_HASH_EMPTY)
+			continue;
+
+		entry = old_entries + i * table->sizeof_entry;
+		hash = nds_hash_table_hash(table, entry);
+		slot = nds_hash_table_free_slot(table, hash);
+
+		memcpy(nds_hash_table_entry(table, slot), entry, table->sizeof_entry);
+		nds_hash_table_set_control(table, slot, NDS_HASH_TAG(hash));
+	}
+
+	table->allocator.free(table->allocator.context, old_entries, old_size);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_hash_table_init(NdsHashTable *table, size_t sizeof_key, size_t sizeof_value, NdsHashFunction hash, NdsEqualFunction equal, size_t capacity, const NdsAllocator *allocator)
+{
+	size_t value_alignment, entry_alignment, slots;
+
+	if (sizeof_key > SIZE_MAX / 4 || sizeof_value > SIZE_MAX / 4)
+		return NDS_MEM_ALLOC_ERROR;
+
+	slots = nds_hash_table_slots_for(capacity);
+	if (slots == 0)
+		return NDS_MEM_ALLOC_ERROR;
+
+	/* the value follows the key at its own alignment and the entries are aligned for both (the sets have no value) */
+	value_alignment = sizeof_value == 0 ? 1 : nds_hash_alignment(sizeof_value);
+	entry_alignment = nds_hash_alignment(sizeof_key) > value_alignment ? nds_hash_alignment(sizeof_key) : value_alignment;
+
+	table->size = 0;
+	table->sizeof_key = sizeof_key;
+	table->sizeof_value = sizeof_value;
+	table->value_offset = (sizeof_key + value_alignment - 1) & ~(value_alignment - 1);
+	table->sizeof_entry = (table->value_offset + sizeof_value + entry_alignment - 1) & ~(entry_alignment - 1);
+	table->kind = NDS_HASH_KIND_GENERIC;
+	table->hash = hash;
+	table->equal = equal;
+	table->allocator = *allocator;
+
+	if (hash == NULL && equal == NULL && (sizeof_key == 4 || sizeof_key == 8))
+		table->kind = sizeof_key == 4 ? NDS_HASH_KIND_32 : NDS_HASH_KIND_64;
+
+	return nds_hash_table_allocate(table, slots);
+}
+
+
+void nds_hash_table_release(NdsHashTable *table)
+{
+	table->allocator.free(table->allocator.context, table->entries, nds_hash_table_size(table, table->slots));
+	table->entries = NULL;
+	table->control = NULL;
+}
+
+
+size_t nds_hash_table_max_load(size_t slots)
+{
+	/*
+	 * the table grows when 4/5 of its slots are used: with linear probing a
+	 * miss scans about (1 + 1 / (1 - load)^2) / 2 slots, 13 at 4/5 but 33 at 7/8
+	 */
+	return slots - slots / 5;
+}
+
+
+NdsStatus nds_hash_table_reserve(NdsHashTable *table, size_t capacity)
+{
+	size_t slots;
+
+	if (capacity <= nds_hash_table_max_load(table->slots))
+		return NDS_OK;
+
+	slots = nds_hash_table_slots_for(capacity);
+	if (slots == 0)
+		return NDS_MEM_ALLOC_ERROR;
+
+	return nds_hash_table_rehash(table, slots);
+}
+
+
+void nds_hash_table_clear(NdsHashTable *table)
+{
+	memset(table->control, NDS_HASH_EMPTY, table->slots + NDS_HASH_GROUP - 1);
+	table->size = 0;
+	table->growth_left = nds_hash_table_max_load(table->slots);
+}
+
+
+size_t nds_hash_table_add(NdsHashTable *table, const void *key, uint64_t hash)
+{
+	size_t slot;
+
+	/* a full table doubles its number of slots */
+	if (table->growth_left == 0)
+		if (table->slots > SIZE_MAX / 2 || nds_hash_table_rehash(table, table->slots * 2) != NDS_OK)
+			return table->slots;
+
+	slot = nds_hash_table_free_slot(table, hash);
+	memcpy(nds_hash_table_entry(table, slot), key, table->sizeof_key);
+	nds_hash_table_set_control(table, slot, NDS_HASH_TAG(hash));
+
+	table->size++;
+	table->growth_left--;
+
+	return slot;
+}
+
+
+void nds_hash_table_erase(NdsHashTable *table, size_t slot)
+{
+	size_t mask = table->slots - 1, hole = slot, home;
+
+	/* the entries of the run that may not sit between their home and the hole are shifted back into it */
+	for (slot = (hole + 1) & mask; !(table->control[slot] & NDS_HASH_EMPTY); slot = (slot + 1) & mask)
+	{
+		home = NDS_HASH_HOME(nds_hash_table_hash(table, nds_hash_table_entry(table, slot)), table->slots);
+
+		if (((slot - home) & mask) < ((slot - hole) & mask))
+			continue;
+
+		memcpy(nds_hash_table_entry(table, hole), nds_hash_table_entry(table, slot), table->sizeof_entry);
+		nds_hash_table_set_control(table, hole, table->control[slot]);
+		hole = slot;
+	}
+
+	nds_hash_table_set_control(table, hole, NDS_HASH_EMPTY);
+	table->size--;
+	table->growth_left++;
+}
+
+
+size_t nds_hash_table_next(NdsHashTable *table, size_t slot)
+{
+	unsigned int used, empty;
+
+	/* the windows may start anywhere, the mirrored bytes are never reached before slots */
+	for (; slot < table->slots; slot += NDS_HASH_GROUP)
+	{
+		nds_hash_table_match(table->control + slot, NDS_HASH_EMPTY, &empty);
+		used = ~empty & 0xffff;
+
+		if (used)
+		{
+			slot += (size_t)__builtin_ctz(used);
+			return slot < table->slots ? slot : table->slots;
+		}
+	}
+
+	return table->slots;
+}
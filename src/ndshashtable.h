@@ -0,0 +1,287 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the open-addressing table shared by NdsHashMap and
+ * NdsHashSet. It is internal to the library and is not installed. The
+ * table uses linear probing: a key is stored in the first empty slot at or
+ * after its home slot, and a lookup scans the control bytes from the home
+ * slot 16 at a time until it finds the key or an empty slot. The first 15
+ * control bytes are mirrored after the last one, so a window of 16 bytes
+ * never has to wrap around. Since every key lies before the first empty
+ * slot that follows its home, a removal can shift the next keys of the run
+ * back instead of leaving a tombstone.
+ *
+ * The lookups are static inline functions, so the containers get them
+ * specialized for the keys of 4 and 8 bytes without callbacks.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_HASH_TABLE_H__
+#define __NDS_HASH_TABLE_H__
+
+#include <nds/ndsutils.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+#define NDS_HASH_HAS_SSE2
+#endif
+
+
+/* number of control bytes compared at once */
+#define NDS_HASH_GROUP 16
+
+/* control byte of an empty slot, the ones of the used slots hold 7 bits of the hash (high bit clear) */
+#define NDS_HASH_EMPTY 0x80
+
+/* the home slot of a key comes from the high bits of its hash, the control byte from the low 7 bits */
+#define NDS_HASH_HOME(hash, slots) ((size_t)((hash) >> 7) & ((slots) - 1))
+#define NDS_HASH_TAG(hash) ((unsigned char)((hash) & 0x7f))
+
+
+/* the tables that hash and compare their keys of 4 or 8 bytes without callbacks have specialized lookups */
+enum NdsHashKind
+{
+	NDS_HASH_KIND_GENERIC,
+	NDS_HASH_KIND_32,
+	NDS_HASH_KIND_64
+};
+
+typedef enum NdsHashKind NdsHashKind;
+
+
+struct NdsHashTable
+{
+	/* the entries followed by slots + NDS_HASH_GROUP - 1 control bytes, in one allocation */
+	char *entries;
+	unsigned char *control;
+	size_t slots;
+	size_t size;
+
+	/* number of entries that can be added before the table grows */
+	size_t growth_left;
+
+	/* an entry is a key, followed by its value at value_offset for the maps */
+	size_t sizeof_key;
+	size_t sizeof_value;
+	size_t value_offset;
+	size_t sizeof_entry;
+
+	NdsHashKind kind;
+	NdsHashFunction hash;
+	NdsEqualFunction equal;
+	NdsAllocator allocator;
+};
+
+typedef struct NdsHashTable NdsHashTable;
+
+
+/**
+ * Initializes a table with room for capacity entries, returns NDS_OK or
+ * NDS_MEM_ALLOC_ERROR. The parameters are checked by the containers.
+ */
+NdsStatus nds_hash_table_init(NdsHashTable *table, size_t sizeof_key, size_t sizeof_value, NdsHashFunction hash, NdsEqualFunction equal, size_t capacity, const NdsAllocator *allocator);
+
+/* frees the entries of a table */
+void nds_hash_table_release(NdsHashTable *table);
+
+/* number of entries a table with the given number of slots holds before growing */
+size_t nds_hash_table_max_load(size_t slots);
+
+/* grows a table so that it holds capacity entries without growing again */
+NdsStatus nds_hash_table_reserve(NdsHashTable *table, size_t capacity);
+
+/* removes every entry of a table, keeping its capacity */
+void nds_hash_table_clear(NdsHashTable *table);
+
+/**
+ * Adds the key with the given hash, which must not be in the table yet, and
+ * returns its slot, or slots if the table could not grow. The value of a
+ * map entry is left for the caller to write.
+ */
+size_t nds_hash_table_add(NdsHashTable *table, const void *key, uint64_t hash);
+
+/* removes the entry of a slot, shifting back the next entries of its run */
+void nds_hash_table_erase(NdsHashTable *table, size_t slot);
+
+/* returns the first used slot at or after slot, or slots if there is none */
+size_t nds_hash_table_next(NdsHashTable *table, size_t slot);
+
+
+static inline char* nds_hash_table_entry(NdsHashTable *table, size_t slot)
+{
+	return table->entries + slot * table->sizeof_entry;
+}
+
+
+static inline uint64_t nds_hash_table_hash(NdsHashTable *table, const void *key)
+{
+	uint32_t key32;
+	uint64_t key64;
+
+	switch (table->kind)
+	{
+		/* the common integer keys are mixed inline */
+		case NDS_HASH_KIND_32:
+			memcpy(&key32, key, sizeof(key32));
+			return nds_hash_mix(key32);
+
+		case NDS_HASH_KIND_64:
+			memcpy(&key64, key, sizeof(key64));
+			return nds_hash_mix(key64);
+
+		default:
+			return table->hash ? table->hash(key) : nds_hash_bytes(key, table->sizeof_key);
+	}
+}
+
+
+/* bit masks of the slots of a window of control bytes that hold the given tag, or that are empty */
+static inline unsigned int nds_hash_table_match(const unsigned char *control, unsigned char tag, unsigned int *empty)
+{
+#ifdef NDS_HASH_HAS_SSE2
+	__m128i group = _mm_loadu_si128((const __m128i*)control);
+
+	*empty = (unsigned int)_mm_movemask_epi8(group);
+
+	return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)tag)));
+#else
+	unsigned int match = 0, i;
+
+	*empty = 0;
+	for (i = 0; i < NDS_HASH_GROUP; i++)
+	{
+		match |= (unsigned int)(control[i] == tag) << i;
+		*empty |= (unsigned int)(control[i] == NDS_HASH_EMPTY) << i;
+	}
+
+	return match;
+#endif
+}
+
+
+/* brings the control bytes and the entry of the home slot of hash into the cache */
+static inline void nds_hash_table_prefetch(NdsHashTable *table, uint64_t hash)
+{
+	size_t home = NDS_HASH_HOME(hash, table->slots);
+
+	__builtin_prefetch(table->control + home);
+	__builtin_prefetch(nds_hash_table_entry(table, home));
+}
+
+
+/*
+ * Scans the windows from the home slot of hash until the key is found (its
+ * slot is returned) or an empty slot ends the run (slots is returned). Only
+ * the matches before the first empty slot of a window can be in the run.
+ * Most keys sit at their home slot or close to it, so the entry of the home
+ * slot is prefetched while the control bytes are loaded.
+ */
+#define NDS_HASH_PROBE_LOOP(is_key) \
+	size_t mask = table->slots - 1, position = NDS_HASH_HOME(hash, table->slots), slot; \
+	unsigned char tag = NDS_HASH_TAG(hash); \
+	unsigned int match, empty; \
+	\
+	__builtin_prefetch(nds_hash_table_entry(table, position)); \
+	\
+	for (;;) \
+	{ \
+		match = nds_hash_table_match(table->control + position, tag, &empty); \
+		if (empty) \
+			match &= (empty & (~empty + 1)) - 1; \
+	\
+		while (match) \
+		{ \
+			slot = (position + (size_t)__builtin_ctz(match)) & mask; \
+			if (is_key) \
+				return slot; \
+			match &= match - 1; \
+		} \
+	\
+		if (empty) \
+			return table->slots; \
+	\
+		position = (position + NDS_HASH_GROUP) & mask; \
+	}
+
+
+static inline size_t nds_hash_table_probe(NdsHashTable *table, const void *key, uint64_t hash)
+{
+	NDS_HASH_PROBE_LOOP(table->equal ? table->equal(nds_hash_table_entry(table, slot), key) : memcmp(nds_hash_table_entry(table, slot), key, table->sizeof_key) == 0)
+}
+
+
+/* the keys of 4 and 8 bytes of the tables without callbacks are compared as integers */
+static inline size_t nds_hash_table_probe_32(NdsHashTable *table, uint32_t key, uint64_t hash)
+{
+	uint32_t stored;
+
+	NDS_HASH_PROBE_LOOP((memcpy(&stored, nds_hash_table_entry(table, slot), sizeof(stored)), stored == key))
+}
+
+
+static inline size_t nds_hash_table_probe_64(NdsHashTable *table, uint64_t key, uint64_t hash)
+{
+	uint64_t stored;
+
+	NDS_HASH_PROBE_LOOP((memcpy(&stored, nds_hash_table_entry(table, slot), sizeof(stored)), stored == key))
+}
+
+#undef NDS_HASH_PROBE_LOOP
+
+
+/* finds the slot of a key whose hash is already known, or returns slots if it is not in the table */
+static inline size_t nds_hash_table_find_hashed(NdsHashTable *table, const void *key, uint64_t hash)
+{
+	uint32_t key32;
+	uint64_t key64;
+
+	switch (table->kind)
+	{
+		case NDS_HASH_KIND_32:
+			memcpy(&key32, key, sizeof(key32));
+			return nds_hash_table_probe_32(table, key32, hash);
+
+		case NDS_HASH_KIND_64:
+			memcpy(&key64, key, sizeof(key64));
+			return nds_hash_table_probe_64(table, key64, hash);
+
+		default:
+			return nds_hash_table_probe(table, key, hash);
+	}
+}
+
+
+/* finds the slot of a key, or returns slots if it is not in the table */
+static inline size_t nds_hash_table_find(NdsHashTable *table, const void *key)
+{
+	return nds_hash_table_find_hashed(table, key, nds_hash_table_hash(table, key));
+}
+
+
+#endif /* __NDS_HASH_TABLE_H__ */
@@ -0,0 +1,760 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the implementation of the NdsList. A node is a header
+ * followed by the array of its elements. The nodes are carved out of slabs
+ * whose size doubles up to NDS_LIST_MAX_SLAB_NODES nodes, and the released
+ * nodes are linked in a free list through their next pointer, so a list
+ * never hands a node back to the allocator before it is destroyed.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include <nds/ndslist.h>
+
+#include <stdint.h>
+#include <string.h>
+
+
+/* number of nodes of the first slab of a list and the most nodes a slab grows to */
+#define NDS_LIST_MIN_SLAB_NODES 16
+#define NDS_LIST_MAX_SLAB_NODES 1024
+
+/* the element at the given index of a node */
+#define NDS_LIST_ELEMENT(private, node, index) ((char*)((node) + 1) + (index) * (private)->sizeof_element)
+
+
+struct NdsListNode
+{
+	struct NdsListNode *next;
+	struct NdsListNode *prev;
+
+	/* number of elements stored after the header */
+	size_t count;
+};
+
+typedef struct NdsListNode NdsListNode;
+
+
+struct NdsListSlab
+{
+	struct NdsListSlab *next;
+	size_t size;
+};
+
+typedef struct NdsListSlab NdsListSlab;
+
+
+struct NdsListPrivate
+{
+	NdsListNode *head;
+	NdsListNode *tail;
+	size_t size;
+	size_t sizeof_element;
+	size_t node_capacity;
+
+	/* size of a node rounded up so that the next node of a slab stays aligned */
+	size_t node_size;
+
+	/* released nodes, linked through their next pointer */
+	NdsListNode *free_nodes;
+	NdsListNode *free_tail;
+
+	/* slabs of the list, the nodes of the newest one are handed out from next_node */
+	NdsListSlab *slabs;
+	NdsListSlab *last_slab;
+	char *next_node;
+	size_t fresh_nodes;
+	size_t slab_nodes;
+
+	NdsAllocator allocator;
+};
+
+typedef struct NdsListPrivate NdsListPrivate;
+
+/* the handle and the private part of a NdsList are allocated as a single block */
+struct NdsListBlock
+{
+	NdsList list;
+	NdsListPrivate private;
+};
+
+
+/* takes a node from the free list or the newest slab, allocating a new slab when both are used up */
+static NdsListNode* nds_list_node_new(NdsListPrivate *private)
+{
+	NdsListNode *node;
+	NdsListSlab *slab;
+	size_t slab_size;
+
+	if (private->free_nodes != NULL)
+	{
+		node = private->free_nodes;
+		private->free_nodes = node->next;
+		if (private->free_nodes == NULL)
+			private->free_tail = NULL;
+
+		return node;
+	}
+
+	if (private->fresh_nodes == 0)
+	{
+		if (nds_size_overflows(private->slab_nodes, private->node_size))
+			return NULL;
+
+		slab_size = sizeof(NdsListSlab) + private->slab_nodes * private->node_size;
+		if (slab_size < sizeof(NdsListSlab))
+			return NULL;
+
+		slab = (NdsListSlab*)private->allocator.alloc(private->allocator.context, slab_size);
+		if (!slab)
+			return NULL;
+
+		slab->next = private->slabs;
+		slab->size = slab_size;
+		if (private->slabs == NULL)
+			private->last_slab = slab;
+		private->slabs = slab;
+
+		private->next_node = (char*)(slab + 1);
+		private->fresh_nodes = private->slab_nodes;
+
+		if (private->slab_nodes < NDS_LIST_MAX_SLAB_NODES)
+			private->slab_nodes *= 2;
+	}
+
+	node = (NdsListNode*)private->next_node;
+	private->next_node += private->node_size;
+	private->fresh_nodes--;
+
+	return node;
+}
+
+
+static void nds_list_node_release(NdsListPrivate *private, NdsListNode *node)
+{
+	node->next = private->free_nodes;
+	if (private->free_nodes == NULL)
+		private->free_tail = node;
+	private->free_nodes = node;
+}
+
+
+/* links the chain of nodes from first to last before the given node, or at the end when before is NULL */
+static void nds_list_link(NdsListPrivate *private, NdsListNode *first, NdsListNode *last, NdsListNode *before)
+{
+	NdsListNode *after = before != NULL ? before->prev : private->tail;
+
+	first->prev = after;
+	last->next = before;
+
+	if (after != NULL)
+		after->next = first;
+	else
+		private->head = first;
+
+	if (before != NULL)
+		before->prev = last;
+	else
+		private->tail = last;
+}
+
+
+static void nds_list_unlink(NdsListPrivate *private, NdsListNode *node)
+{
+	if (node->prev != NULL)
+		node->prev->next = node->next;
+	else
+		private->head = node->next;
+
+	if (node->next != NULL)
+		node->next->prev = node->prev;
+	else
+		private->tail = node->prev;
+}
+
+
+/* moves the elements of node from index on into a new node linked after it */
+static NdsListNode* nds_list_split(NdsListPrivate *private, NdsListNode *node, size_t index)
+{
+	NdsListNode *rest = nds_list_node_new(private);
+
+	if (!rest)
+		return NULL;
+
+	rest->count = node->count - index;
+	memcpy(NDS_LIST_ELEMENT(private, rest, 0), NDS_LIST_ELEMENT(private, node, index), rest->count * private->sizeof_element);
+	node->count = index;
+
+	nds_list_link(private, rest, rest, node->next);
+
+	return rest;
+}
+
+
+/* moves the elements of the node after the given one to its end and releases the emptied node */
+static void nds_list_merge(NdsListPrivate *private, NdsListNode *node)
+{
+	NdsListNode *next = node->next;
+
+	memcpy(NDS_LIST_ELEMENT(private, node, node->count), NDS_LIST_ELEMENT(private, next, 0), next->count * private->sizeof_element);
+	node->count += next->count;
+
+	nds_list_unlink(private, next);
+	nds_list_node_release(private, next);
+}
+
+
+/* points an iterator to an element, moving to the next node when index is past the end of node */
+static int nds_list_iterator_set(NdsListPrivate *private, NdsListIterator *iterator, NdsListNode *node, size_t index)
+{
+	if (node != NULL && index == node->count)
+	{
+		node = node->next;
+		index = 0;
+	}
+
+	iterator->list = private;
+	iterator->node = node;
+	iterator->index = index;
+	iterator->element = node != NULL ? NDS_LIST_ELEMENT(private, node, index) : NULL;
+
+	return node != NULL;
+}
+
+
+/* inserts an element before the given index of node, or at the end of the list when node is NULL */
+static NdsStatus nds_list_place(NdsListPrivate *private, NdsListNode *node, size_t index, const void *element, NdsListIterator *iterator)
+{
+	NdsListNode *target;
+	size_t half;
+
+	/* the end of the list is the position after the last element of the tail */
+	if (node == NULL && private->tail != NULL)
+	{
+		node = private->tail;
+		index = node->count;
+	}
+
+	if (node != NULL && node->count < private->node_capacity)
+		target = node;
+	else if (node != NULL && index == 0 && node->prev != NULL && node->prev->count < private->node_capacity)
+	{
+		/* the element goes at the end of the previous node, which has room left */
+		target = node->prev;
+		index = target->count;
+	}
+	else if (node == NULL || index == 0 || index == node->count)
+	{
+		target = nds_list_node_new(private);
+		if (!target)
+			return NDS_MEM_ALLOC_ERROR;
+
+		target->count = 0;
+
+		if (node != NULL && index == 0)
+			nds_list_link(private, target, target, node);
+		else
+			nds_list_link(private, target, target, node != NULL ? node->next : NULL);
+
+		index = 0;
+	}
+	else
+	{
+		/* a full node is split in two halves and the element goes into the half of its position */
+		half = node->count / 2;
+
+		target = nds_list_split(private, node, half);
+		if (!target)
+			return NDS_MEM_ALLOC_ERROR;
+
+		if (index > half)
+			index -= half;
+		else
+			target = node;
+	}
+
+	memmove(NDS_LIST_ELEMENT(private, target, index + 1), NDS_LIST_ELEMENT(private, target, index), (target->count - index) * private->sizeof_element);
+	memcpy(NDS_LIST_ELEMENT(private, target, index), element, private->sizeof_element);
+
+	target->count++;
+	private->size++;
+
+	if (iterator != NULL)
+		nds_list_iterator_set(private, iterator, target, index);
+
+	return NDS_OK;
+}
+
+
+/* removes the element at the given index of node and, if given, points the iterator to the element after it */
+static void nds_list_take(NdsListPrivate *private, NdsListNode *node, size_t index, void *element, NdsListIterator *iterator)
+{
+	NdsListNode *next;
+
+	if (element != NULL)
+		memcpy(element, NDS_LIST_ELEMENT(private, node, index), private->sizeof_element);
+
+	node->count--;
+	private->size--;
+
+	memmove(NDS_LIST_ELEMENT(private, node, index), NDS_LIST_ELEMENT(private, node, index + 1), (node->count - index) * private->sizeof_element);
+
+	if (node->count == 0)
+	{
+		next = node->next;
+
+		nds_list_unlink(private, node);
+		nds_list_node_release(private, node);
+
+		node = next;
+		index = 0;
+	}
+	else if (node->prev != NULL && node->prev->count + node->count <= private->node_capacity / 2)
+	{
+		/* the elements after the removed one move to the end of the previous node, in the same order */
+		index += node->prev->count;
+		node = node->prev;
+
+		nds_list_merge(private, node);
+	}
+	else if (node->next != NULL && node->count + node->next->count <= private->node_capacity / 2)
+	{
+		/* the elements after the removed one keep their index, so the position stays valid */
+		nds_list_merge(private, node);
+	}
+
+	if (iterator != NULL)
+		nds_list_iterator_set(private, iterator, node, index);
+}
+
+
+/* hands the slabs and the free nodes of other over to the list, leaving other without memory */
+static void nds_list_adopt_pool(NdsListPrivate *private, NdsListPrivate *other)
+{
+	if (other->slabs != NULL)
+	{
+		other->last_slab->next = private->slabs;
+		if (private->slabs == NULL)
+			private->last_slab = other->last_slab;
+		private->slabs = other->slabs;
+	}
+
+	if (other->free_nodes != NULL)
+	{
+		other->free_tail->next = private->free_nodes;
+		if (private->free_nodes == NULL)
+			private->free_tail = other->free_tail;
+		private->free_nodes = other->free_nodes;
+	}
+
+	/* nodes are only carved out of one slab, we keep the one with more of them left */
+	if (other->fresh_nodes > private->fresh_nodes)
+	{
+		private->next_node = other->next_node;
+		private->fresh_nodes = other->fresh_nodes;
+	}
+
+	if (other->slab_nodes > private->slab_nodes)
+		private->slab_nodes = other->slab_nodes;
+
+	other->head = NULL;
+	other->tail = NULL;
+	other->size = 0;
+	other->free_nodes = NULL;
+	other->free_tail = NULL;
+	other->slabs = NULL;
+	other->last_slab = NULL;
+	other->next_node = NULL;
+	other->fresh_nodes = 0;
+}
+
+
+/* checks that the iterator belongs to the list, returning the private part of the list */
+static NdsListPrivate* nds_list_position(NdsList *list, NdsListIterator *iterator)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || iterator == NULL || iterator->list != list->private)
+		return NULL;
+
+	if (iterator->node != NULL && iterator->index >= ((NdsListNode*)iterator->node)->count)
+		return NULL;
+
+	return list->private;
+}
+
+
+NdsList* nds_list_new(size_t sizeof_element)
+{
+	return nds_list_new_with_allocator(sizeof_element, 1, nds_allocator_default());
+}
+
+
+NdsList* nds_list_new_unrolled(size_t sizeof_element)
+{
+	return nds_list_new_with_allocator(sizeof_element, 0, nds_allocator_default());
+}
+
+
+NdsList* nds_list_new_with_allocator(size_t sizeof_element, size_t node_capacity, const NdsAllocator *allocator)
+{
+	struct NdsListBlock *block;
+	size_t node_size;
+
+	/* sanity checks */
+	if (sizeof_element == 0 || allocator == NULL)
+		return NULL;
+
+	if (allocator->alloc == NULL || allocator->realloc == NULL || allocator->free == NULL)
+		return NULL;
+
+	if (node_capacity == 0)
+	{
+		node_capacity = (NDS_LIST_NODE_SIZE - sizeof(NdsListNode)) / sizeof_element;
+		if (node_capacity < 2)
+			node_capacity = 2;
+	}
+
+	if (nds_size_overflows(node_capacity, sizeof_element) || node_capacity * sizeof_element > SIZE_MAX / 2)
+		return NULL;
+
+	node_size = sizeof(NdsListNode) + node_capacity * sizeof_element;
+	node_size = (node_size + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*);
+
+	/* we allocate memory for the structure and the private part of the NdsList */
+	block = (struct NdsListBlock*)allocator->alloc(allocator->context, sizeof(struct NdsListBlock));
+	if (!block)
+		return NULL;
+
+	block->list.private = &block->private;
+	block->private.head = NULL;
+	block->private.tail = NULL;
+	block->private.size = 0;
+	block->private.sizeof_element = sizeof_element;
+	block->private.node_capacity = node_capacity;
+	block->private.node_size = node_size;
+	block->private.free_nodes = NULL;
+	block->private.free_tail = NULL;
+	block->private.slabs = NULL;
+	block->private.last_slab = NULL;
+	block->private.next_node = NULL;
+	block->private.fresh_nodes = 0;
+	block->private.slab_nodes = NDS_LIST_MIN_SLAB_NODES;
+	block->private.allocator = *allocator;
+
+	return &block->list;
+}
+
+
+void nds_list_destroy(NdsList *list)
+{
+	NdsAllocator allocator;
+	NdsListSlab *slab, *next;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return;
+
+	/* the allocator lives inside the block that is released last, so we keep a copy of it */
+	allocator = list->private->allocator;
+
+	for (slab = list->private->slabs; slab != NULL; slab = next)
+	{
+		next = slab->next;
+		allocator.free(allocator.context, slab, slab->size);
+	}
+
+	list->private = NULL;
+
+	allocator.free(allocator.context, list, sizeof(struct NdsListBlock));
+	list = NULL;
+}
+
+
+ssize_t nds_list_size(NdsList *list)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return -1;
+
+	return (ssize_t)list->private->size;
+}
+
+
+NdsStatus nds_list_push_front(NdsList *list, const void *element)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	return nds_list_place(list->private, list->private->head, 0, element, NULL);
+}
+
+
+NdsStatus nds_list_push_back(NdsList *list, const void *element)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	return nds_list_place(list->private, NULL, 0, element, NULL);
+}
+
+
+NdsStatus nds_list_pop_front(NdsList *list, void *element)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || list->private->size == 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+	nds_list_take(list->private, list->private->head, 0, element, NULL);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_list_pop_back(NdsList *list, void *element)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || list->private->size == 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+	nds_list_take(list->private, list->private->tail, list->private->tail->count - 1, element, NULL);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_list_front(NdsList *list, void *element)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || element == NULL || list->private->size == 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+	memcpy(element, NDS_LIST_ELEMENT(list->private, list->private->head, 0), list->private->sizeof_element);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_list_back(NdsList *list, void *element)
+{
+	NdsListNode *tail;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || element == NULL || list->private->size == 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+	tail = list->private->tail;
+	memcpy(element, NDS_LIST_ELEMENT(list->private, tail, tail->count - 1), list->private->sizeof_element);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_list_clear(NdsList *list)
+{
+	NdsListPrivate *private;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = list->private;
+
+	/* the nodes are already linked through their next pointer, so the whole chain joins the free list */
+	if (private->head != NULL)
+	{
+		private->tail->next = private->free_nodes;
+		if (private->free_nodes == NULL)
+			private->free_tail = private->tail;
+		private->free_nodes = private->head;
+	}
+
+	private->head = NULL;
+	private->tail = NULL;
+	private->size = 0;
+
+	return NDS_OK;
+}
+
+
+int nds_list_first(NdsList *list, NdsListIterator *iterator)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || iterator == NULL)
+		return -1;
+
+	return nds_list_iterator_set(list->private, iterator, list->private->head, 0);
+}
+
+
+int nds_list_last(NdsList *list, NdsListIterator *iterator)
+{
+	NdsListNode *tail;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || iterator == NULL)
+		return -1;
+
+	tail = list->private->tail;
+
+	return nds_list_iterator_set(list->private, iterator, tail, tail != NULL ? tail->count - 1 : 0);
+}
+
+
+NdsStatus nds_list_end(NdsList *list, NdsListIterator *iterator)
+{
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || iterator == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	nds_list_iterator_set(list->private, iterator, NULL, 0);
+
+	return NDS_OK;
+}
+
+
+int nds_list_iterator_next(NdsListIterator *iterator)
+{
+	/* sanity checks */
+	if (iterator == NULL || iterator->list == NULL || iterator->node == NULL)
+		return -1;
+
+	return nds_list_iterator_set(iterator->list, iterator, (NdsListNode*)iterator->node, iterator->index + 1);
+}
+
+
+int nds_list_iterator_prev(NdsListIterator *iterator)
+{
+	NdsListNode *node;
+
+	/* sanity checks */
+	if (iterator == NULL || iterator->list == NULL)
+		return -1;
+
+	node = (NdsListNode*)iterator->node;
+
+	if (node != NULL && iterator->index > 0)
+		return nds_list_iterator_set(iterator->list, iterator, node, iterator->index - 1);
+
+	node = node != NULL ? node->prev : iterator->list->tail;
+
+	return nds_list_iterator_set(iterator->list, iterator, node, node != NULL ? node->count - 1 : 0);
+}
+
+
+NdsStatus nds_list_insert(NdsList *list, NdsListIterator *iterator, const void *element)
+{
+	NdsListPrivate *private;
+
+	/* sanity checks */
+	private = nds_list_position(list, iterator);
+	if (private == NULL || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	return nds_list_place(private, (NdsListNode*)iterator->node, iterator->index, element, iterator);
+}
+
+
+NdsStatus nds_list_erase(NdsList *list, NdsListIterator *iterator, void *element)
+{
+	NdsListPrivate *private;
+
+	/* sanity checks */
+	private = nds_list_position(list, iterator);
+	if (private == NULL || iterator->node == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	nds_list_take(private, (NdsListNode*)iterator->node, iterator->index, element, iterator);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_list_splice(NdsList *list, NdsListIterator *iterator, NdsList *other)
+{
+	NdsListPrivate *private, *source;
+	NdsListNode *node;
+
+	/* sanity checks */
+	private = nds_list_position(list, iterator);
+	if (private == NULL || other == NULL || other->private == NULL || other->private == private)
+		return NDS_INVALID_PARAM_ERROR;
+
+	source = other->private;
+
+	/* the nodes of other are released into the slabs of the list, so both must manage them alike */
+	if (source->sizeof_element != private->sizeof_element || source->node_capacity != private->node_capacity)
+		return NDS_INVALID_PARAM_ERROR;
+
+	if (source->allocator.alloc != private->allocator.alloc || source->allocator.free != private->allocator.free ||
+		source->allocator.context != private->allocator.context)
+		return NDS_INVALID_PARAM_ERROR;
+
+	node = (NdsListNode*)iterator->node;
+
+	if (source->head != NULL)
+	{
+		/* an unrolled node is split so that the elements of other go between its two parts */
+		if (node != NULL && iterator->index > 0)
+		{
+			node = nds_list_split(private, node, iterator->index);
+			if (!node)
+				return NDS_MEM_ALLOC_ERROR;
+		}
+
+		nds_list_link(private, source->head, source->tail, node);
+		private->size += source->size;
+
+		nds_list_iterator_set(private, iterator, node, 0);
+	}
+
+	nds_list_adopt_pool(private, source);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_list_for_each(NdsList *list, NdsElementFunction function, void *context)
+{
+	NdsListPrivate *private;
+	NdsListNode *node;
+	char *element, *end;
+
+	/* sanity checks */
+	if (list == NULL || list->private == NULL || function == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = list->private;
+
+	for (node = private->head; node != NULL; node = node->next)
+	{
+		end = NDS_LIST_ELEMENT(private, node, node->count);
+
+		for (element = NDS_LIST_ELEMENT(private, node, 0); element != end; element += private->sizeof_element)
+			function(element, context);
+	}
+
+	return NDS_OK;
+}
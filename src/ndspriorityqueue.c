@@ -0,0 +1,665 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the implementation of the NdsPriorityQueue, a d-ary
+ * heap. The elements, one spare slot and, for an indexed queue, the handle
+ * of every heap position and the heap position of every handle share one
+ * buffer. Sifting moves a hole instead of swapping elements: the element
+ * being placed waits outside the heap (in the spare slot, in the caller's
+ * memory or past the last element) and is copied once, to its final place.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+/* ndsvector.c exports the accessors, this file only needs the private part of the vector */
+#define NDS_INLINE_FAST_PATH
+
+#include <nds/ndspriorityqueue.h>
+
+#include <stdint.h>
+#include <string.h>
+
+
+/* capacity of the queues created without one */
+#define NDS_PRIORITY_QUEUE_MIN_CAPACITY 16
+
+/* marks the entry of a handle that is not in use, the rest of the entry is the next free handle */
+#define NDS_HANDLE_FREE ((size_t)1 << (sizeof(size_t) * 8 - 1))
+
+/* end of the list of free handles */
+#define NDS_HANDLE_NONE (~(size_t)0)
+
+/* the element at the given heap position */
+#define NDS_HEAP_SLOT(private, position) ((private)->elements + (position) * (private)->sizeof_element)
+
+
+struct NdsPriorityQueuePrivate
+{
+	/* capacity + 1 elements, the last one is the spare slot used while sifting */
+	char *elements;
+	size_t sizeof_element;
+	size_t size;
+	size_t capacity;
+	size_t arity;
+	NdsCompareFunction compare;
+
+	/* indexed queues only: handle of every heap position and heap position (or next free handle) of every handle */
+	int indexed;
+	size_t *handles;
+	size_t *positions;
+	size_t used_handles;
+	size_t free_handle;
+
+	NdsAllocator allocator;
+};
+
+typedef struct NdsPriorityQueuePrivate NdsPriorityQueuePrivate;
+
+/* the handle and the private part of a NdsPriorityQueue are allocated as a single block */
+struct NdsPriorityQueueBlock
+{
+	NdsPriorityQueue queue;
+	NdsPriorityQueuePrivate private;
+};
+
+
+/* offset of the handle arrays in the buffer of a queue with the given capacity */
+static size_t nds_heap_handles_offset(size_t sizeof_element, size_t capacity)
+{
+	return ((capacity + 1) * sizeof_element + sizeof(size_t) - 1) / sizeof(size_t) * sizeof(size_t);
+}
+
+
+/* size of the buffer of a queue with the given capacity, or 0 if it does not fit in a size_t */
+static size_t nds_heap_buffer_size(size_t sizeof_element, size_t capacity, int indexed)
+{
+	if (capacity >= SIZE_MAX / sizeof_element / 2 || capacity >= SIZE_MAX / (4 * sizeof(size_t)))
+		return 0;
+
+	return nds_heap_handles_offset(sizeof_element, capacity) + (indexed ? 2 * capacity * sizeof(size_t) : 0);
+}
+
+
+/* grows the buffer to the given capacity, keeping the elements and the handles */
+static NdsStatus nds_heap_grow(NdsPriorityQueuePrivate *private, size_t capacity)
+{
+	size_t old_size = nds_heap_buffer_size(private->sizeof_element, private->capacity, private->indexed);
+	size_t new_size = nds_heap_buffer_size(private->sizeof_element, capacity, private->indexed);
+	size_t old_offset = nds_heap_handles_offset(private->sizeof_element, private->capacity);
+	size_t new_offset = nds_heap_handles_offset(private->sizeof_element, capacity);
+	char *elements;
+
+	if (new_size == 0)
+		return NDS_MEM_ALLOC_ERROR;
+
+	elements = (char*)private->allocator.realloc(private->allocator.context, private->elements, old_size, new_size);
+	if (!elements)
+		return NDS_MEM_ALLOC_ERROR;
+
+	private->elements = elements;
+
+	if (private->indexed)
+	{
+		/* the positions move first, the handles may move over their old place */
+		memmove(elements + new_offset + capacity * sizeof(size_t), elements + old_offset + private->capacity * sizeof(size_t), private->used_handles * sizeof(size_t));
+		memmove(elements + new_offset, elements + old_offset, private->size * sizeof(size_t));
+
+		private->handles = (size_t*)(elements + new_offset);
+		private->positions = private->handles + capacity;
+	}
+
+	private->capacity = capacity;
+
+	return NDS_OK;
+}
+
+
+/* makes room for count more elements, doubling the capacity at least */
+static NdsStatus nds_heap_reserve_more(NdsPriorityQueuePrivate *private, size_t count)
+{
+	size_t capacity = private->capacity;
+
+	if (count <= capacity - private->size)
+		return NDS_OK;
+
+	if (count > SIZE_MAX / 2 - private->size)
+		return NDS_MEM_ALLOC_ERROR;
+
+	while (capacity < private->size + count)
+		capacity = capacity > SIZE_MAX / 4 ? private->size + count : capacity * 2;
+
+	return nds_heap_grow(private, capacity);
+}
+
+
+/* returns an unused handle (the queue fits one more element, so there is always one) */
+static size_t nds_heap_new_handle(NdsPriorityQueuePrivate *private)
+{
+	size_t handle = private->free_handle;
+
+	if (handle != NDS_HANDLE_NONE)
+	{
+		private->free_handle = private->positions[handle] & ~NDS_HANDLE_FREE;
+		return handle;
+	}
+
+	return private->used_handles++;
+}
+
+
+static void nds_heap_release_handle(NdsPriorityQueuePrivate *private, size_t handle)
+{
+	private->positions[handle] = NDS_HANDLE_FREE | (private->free_handle & ~NDS_HANDLE_FREE);
+	private->free_handle = handle;
+}
+
+
+/* copies one element, with a copy of fixed size for the common sizes that the compiler can inline */
+static void nds_heap_copy(char *destination, const char *source, size_t sizeof_element)
+{
+	switch (sizeof_element)
+	{
+		case 4:
+			memcpy(destination, source, 4);
+			break;
+
+		case 8:
+			memcpy(destination, source, 8);
+			break;
+
+		case 16:
+			memcpy(destination, source, 16);
+			break;
+
+		default:
+			memcpy(destination, source, sizeof_element);
+			break;
+	}
+}
+
+
+/* copies the element and its handle to the given heap position */
+static void nds_heap_place(NdsPriorityQueuePrivate *private, size_t position, const char *element, size_t handle)
+{
+	nds_heap_copy(NDS_HEAP_SLOT(private, position), element, private->sizeof_element);
+
+	if (private->indexed)
+	{
+		private->handles[position] = handle;
+		private->positions[handle] = position;
+	}
+}
+
+
+/* moves the element and the handle of one heap position to another one */
+static void nds_heap_move(NdsPriorityQueuePrivate *private, size_t to, size_t from)
+{
+	nds_heap_copy(NDS_HEAP_SLOT(private, to), NDS_HEAP_SLOT(private, from), private->sizeof_element);
+
+	if (private->indexed)
+	{
+		private->handles[to] = private->handles[from];
+		private->positions[private->handles[to]] = to;
+	}
+}
+
+
+/* places the element (which lives outside the heap) at the hole or at one of its ancestors */
+static void nds_heap_sift_up(NdsPriorityQueuePrivate *private, size_t hole, const char *element, size_t handle)
+{
+	size_t parent;
+
+	while (hole > 0)
+	{
+		parent = (hole - 1) / private->arity;
+		if (private->compare(element, NDS_HEAP_SLOT(private, parent)) >= 0)
+			break;
+
+		nds_heap_move(private, hole, parent);
+		hole = parent;
+	}
+
+	nds_heap_place(private, hole, element, handle);
+}
+
+
+/* places the element (which lives outside the heap) at the hole or at one of its descendants */
+static void nds_heap_sift_down(NdsPriorityQueuePrivate *private, size_t hole, const char *element, size_t handle)
+{
+	size_t size = private->size, arity = private->arity, child, last, best;
+
+	/* the hole has children while hole * arity + 1 < size */
+	while (size > 1 && hole <= (size - 2) / arity)
+	{
+		child = hole * arity + 1;
+		last = size - child < arity ? size : child + arity;
+
+		for (best = child++; child < last; child++)
+			if (private->compare(NDS_HEAP_SLOT(private, child), NDS_HEAP_SLOT(private, best)) < 0)
+				best = child;
+
+		if (private->compare(NDS_HEAP_SLOT(private, best), element) >= 0)
+			break;
+
+		nds_heap_move(private, hole, best);
+		hole = best;
+	}
+
+	nds_heap_place(private, hole, element, handle);
+}
+
+
+/* restores the heap order of all the elements, from the last parent up to the root (Floyd) */
+static void nds_heap_build(NdsPriorityQueuePrivate *private)
+{
+	char *spare = NDS_HEAP_SLOT(private, private->capacity);
+	size_t position, handle = 0;
+
+	if (private->size < 2)
+		return;
+
+	for (position = (private->size - 2) / private->arity + 1; position-- > 0; )
+	{
+		memcpy(spare, NDS_HEAP_SLOT(private, position), private->sizeof_element);
+		if (private->indexed)
+			handle = private->handles[position];
+
+		nds_heap_sift_down(private, position, spare, handle);
+	}
+}
+
+
+/* removes the element at the given heap position, the last element takes its place */
+static void nds_heap_remove(NdsPriorityQueuePrivate *private, size_t position, void *element)
+{
+	size_t handle = 0, last_handle = 0;
+	const char *last;
+
+	if (element != NULL)
+		memcpy(element, NDS_HEAP_SLOT(private, position), private->sizeof_element);
+
+	if (private->indexed)
+		handle = private->handles[position];
+
+	/* the last element is past the end of the heap once the size decreases */
+	private->size--;
+	last = NDS_HEAP_SLOT(private, private->size);
+	if (private->indexed)
+		last_handle = private->handles[private->size];
+
+	if (position != private->size)
+	{
+		if (position > 0 && private->compare(last, NDS_HEAP_SLOT(private, (position - 1) / private->arity)) < 0)
+			nds_heap_sift_up(private, position, last, last_handle);
+		else
+			nds_heap_sift_down(private, position, last, last_handle);
+	}
+
+	if (private->indexed)
+		nds_heap_release_handle(private, handle);
+}
+
+
+/* returns the private part of an indexed queue whose handle is in use, NULL otherwise */
+static NdsPriorityQueuePrivate* nds_heap_indexed(NdsPriorityQueue *queue, size_t handle)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || !queue->private->indexed)
+		return NULL;
+
+	if (handle >= queue->private->used_handles || (queue->private->positions[handle] & NDS_HANDLE_FREE) != 0)
+		return NULL;
+
+	return queue->private;
+}
+
+
+NdsPriorityQueue* nds_priority_queue_new(size_t sizeof_element, NdsCompareFunction compare)
+{
+	return nds_priority_queue_new_with_allocator(sizeof_element, compare, NDS_PRIORITY_QUEUE_ARITY, NDS_PRIORITY_QUEUE_MIN_CAPACITY, 0, nds_allocator_default());
+}
+
+
+NdsPriorityQueue* nds_priority_queue_new_with_allocator(size_t sizeof_element, NdsCompareFunction compare, size_t arity, size_t capacity, int indexed,
+	const NdsAllocator *allocator)
+{
+	struct NdsPriorityQueueBlock *block;
+	size_t buffer_size;
+
+	/* sanity checks */
+	if (sizeof_element == 0 || compare == NULL || arity < 2 || allocator == NULL)
+		return NULL;
+
+	if (allocator->alloc == NULL || allocator->realloc == NULL || allocator->free == NULL)
+		return NULL;
+
+	if (capacity == 0)
+		capacity = NDS_PRIORITY_QUEUE_MIN_CAPACITY;
+
+	buffer_size = nds_heap_buffer_size(sizeof_element, capacity, indexed != 0);
+	if (buffer_size == 0)
+		return NULL;
+
+	/* we allocate memory for the structure and the private part of the NdsPriorityQueue */
+	block = (struct NdsPriorityQueueBlock*)allocator->alloc(allocator->context, sizeof(struct NdsPriorityQueueBlock));
+	if (!block)
+		return NULL;
+
+	block->private.elements = (char*)allocator->alloc(allocator->context, buffer_size);
+	if (!block->private.elements)
+	{
+		/* cleanup */
+		allocator->free(allocator->context, block, sizeof(struct NdsPriorityQueueBlock));
+
+		return NULL;
+	}
+
+	block->queue.private = &block->private;
+	block->private.sizeof_element = sizeof_element;
+	block->private.size = 0;
+	block->private.capacity = capacity;
+	block->private.arity = arity;
+	block->private.compare = compare;
+	block->private.indexed = indexed != 0;
+	block->private.handles = NULL;
+	block->private.positions = NULL;
+	block->private.used_handles = 0;
+	block->private.free_handle = NDS_HANDLE_NONE;
+	block->private.allocator = *allocator;
+
+	if (block->private.indexed)
+	{
+		block->private.handles = (size_t*)(block->private.elements + nds_heap_handles_offset(sizeof_element, capacity));
+		block->private.positions = block->private.handles + capacity;
+	}
+
+	return &block->queue;
+}
+
+
+NdsPriorityQueue* nds_priority_queue_new_from_vector(NdsVector *vector, NdsCompareFunction compare)
+{
+	NdsPriorityQueue *queue;
+	ssize_t size;
+
+	/* sanity checks */
+	size = nds_vector_size(vector);
+	if (size < 0)
+		return NULL;
+
+	queue = nds_priority_queue_new_with_allocator(vector->private->sizeof_element, compare, NDS_PRIORITY_QUEUE_ARITY, (size_t)size, 0, nds_allocator_default());
+	if (!queue)
+		return NULL;
+
+	if (size > 0)
+		memcpy(queue->private->elements, nds_vector_data(vector), (size_t)size * queue->private->sizeof_element);
+
+	queue->private->size = (size_t)size;
+	nds_heap_build(queue->private);
+
+	return queue;
+}
+
+
+void nds_priority_queue_destroy(NdsPriorityQueue *queue)
+{
+	NdsAllocator allocator;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return;
+
+	/* the allocator lives inside the block that is released last, so we keep a copy of it */
+	allocator = queue->private->allocator;
+
+	allocator.free(allocator.context, queue->private->elements, nds_heap_buffer_size(queue->private->sizeof_element, queue->private->capacity, queue->private->indexed));
+	queue->private = NULL;
+
+	allocator.free(allocator.context, queue, sizeof(struct NdsPriorityQueueBlock));
+	queue = NULL;
+}
+
+
+ssize_t nds_priority_queue_size(NdsPriorityQueue *queue)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return -1;
+
+	return (ssize_t)queue->private->size;
+}
+
+
+NdsStatus nds_priority_queue_reserve(NdsPriorityQueue *queue, size_t capacity)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	if (capacity <= queue->private->capacity)
+		return NDS_OK;
+
+	return nds_heap_grow(queue->private, capacity);
+}
+
+
+NdsStatus nds_priority_queue_push(NdsPriorityQueue *queue, const void *element)
+{
+	NdsPriorityQueuePrivate *private;
+	size_t handle = 0;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = queue->private;
+
+	if (nds_heap_reserve_more(private, 1) != NDS_OK)
+		return NDS_MEM_ALLOC_ERROR;
+
+	if (private->indexed)
+		handle = nds_heap_new_handle(private);
+
+	/* the new last position is the hole, the element stays in the caller's memory until it is placed */
+	private->size++;
+	nds_heap_sift_up(private, private->size - 1, (const char*)element, handle);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_priority_queue_push_n(NdsPriorityQueue *queue, const void *elements, size_t count)
+{
+	NdsPriorityQueuePrivate *private;
+	size_t handle = 0, i;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || (elements == NULL && count != 0))
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = queue->private;
+
+	if (count == 0)
+		return NDS_OK;
+
+	if (nds_heap_reserve_more(private, count) != NDS_OK)
+		return NDS_MEM_ALLOC_ERROR;
+
+	if (count < private->size)
+	{
+		for (i = 0; i < count; i++)
+		{
+			if (private->indexed)
+				handle = nds_heap_new_handle(private);
+
+			private->size++;
+			nds_heap_sift_up(private, private->size - 1, (const char*)elements + i * private->sizeof_element, handle);
+		}
+
+		return NDS_OK;
+	}
+
+	/* at least half of the heap is new, so rebuilding it is cheaper than sifting every new element up */
+	memcpy(NDS_HEAP_SLOT(private, private->size), elements, count * private->sizeof_element);
+
+	if (private->indexed)
+	{
+		for (i = private->size; i < private->size + count; i++)
+		{
+			private->handles[i] = nds_heap_new_handle(private);
+			private->positions[private->handles[i]] = i;
+		}
+	}
+
+	private->size += count;
+	nds_heap_build(private);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_priority_queue_top(NdsPriorityQueue *queue, void *element)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || queue->private->size == 0 || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	memcpy(element, queue->private->elements, queue->private->sizeof_element);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_priority_queue_pop(NdsPriorityQueue *queue, void *element)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || queue->private->size == 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+	nds_heap_remove(queue->private, 0, element);
+
+	return NDS_OK;
+}
+
+
+ssize_t nds_priority_queue_pop_n(NdsPriorityQueue *queue, void *elements, size_t count)
+{
+	size_t i;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return -1;
+
+	if (count > queue->private->size)
+		count = queue->private->size;
+
+	for (i = 0; i < count; i++)
+		nds_heap_remove(queue->private, 0, elements == NULL ? NULL : (char*)elements + i * queue->private->sizeof_element);
+
+	return (ssize_t)count;
+}
+
+
+NdsStatus nds_priority_queue_clear(NdsPriorityQueue *queue)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	queue->private->size = 0;
+	queue->private->used_handles = 0;
+	queue->private->free_handle = NDS_HANDLE_NONE;
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_priority_queue_insert(NdsPriorityQueue *queue, const void *element, size_t *handle)
+{
+	NdsPriorityQueuePrivate *private;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || !queue->private->indexed || element == NULL || handle == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = queue->private;
+
+	if (nds_heap_reserve_more(private, 1) != NDS_OK)
+		return NDS_MEM_ALLOC_ERROR;
+
+	*handle = nds_heap_new_handle(private);
+
+	private->size++;
+	nds_heap_sift_up(private, private->size - 1, (const char*)element, *handle);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_priority_queue_update(NdsPriorityQueue *queue, size_t handle, const void *element)
+{
+	NdsPriorityQueuePrivate *private = nds_heap_indexed(queue, handle);
+	size_t position;
+
+	/* sanity checks */
+	if (private == NULL || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	position = private->positions[handle];
+
+	/* a lower element can only move up and a higher one only down */
+	if (private->compare(element, NDS_HEAP_SLOT(private, position)) < 0)
+		nds_heap_sift_up(private, position, (const char*)element, handle);
+	else
+		nds_heap_sift_down(private, position, (const char*)element, handle);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_priority_queue_get(NdsPriorityQueue *queue, size_t handle, void *element)
+{
+	NdsPriorityQueuePrivate *private = nds_heap_indexed(queue, handle);
+
+	/* sanity checks */
+	if (private == NULL || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	memcpy(element, NDS_HEAP_SLOT(private, private->positions[handle]), private->sizeof_element);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_priority_queue_remove(NdsPriorityQueue *queue, size_t handle, void *element)
+{
+	NdsPriorityQueuePrivate *private = nds_heap_indexed(queue, handle);
+
+	/* sanity checks */
+	if (private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	nds_heap_remove(private, private->positions[handle], element);
+
+	return NDS_OK;
+}
@@ -0,0 +1,578 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the implementation of the NdsQueue and of the
+ * NdsSpscQueue. Both keep the elements of a ring buffer whose capacity is a
+ * power of two. The NdsQueue stores the slot of its front element and its
+ * size, the NdsSpscQueue stores two indexes that only grow and are masked
+ * when a slot is accessed, so the producer and the consumer never write the
+ * same variable.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include <nds/ndsqueue.h>
+
+#include <stdint.h>
+#include <string.h>
+
+
+/* capacity of nds_queue_new() and smallest capacity of a NdsQueue */
+#define NDS_QUEUE_MIN_CAPACITY 16
+
+
+struct NdsQueuePrivate
+{
+	char *elements;
+	size_t sizeof_element;
+
+	/* slot of the front element, number of elements and capacity (a power of two) */
+	size_t head;
+	size_t size;
+	size_t capacity;
+
+	NdsAllocator allocator;
+};
+
+typedef struct NdsQueuePrivate NdsQueuePrivate;
+
+/* the handle and the private part of a NdsQueue are allocated as a single block */
+struct NdsQueueBlock
+{
+	NdsQueue queue;
+	NdsQueuePrivate private;
+};
+
+
+struct NdsSpscQueuePrivate
+{
+	/* never written after the creation, so it can share a cache line with the handle */
+	char *elements;
+	size_t sizeof_element;
+	size_t mask;
+	NdsAllocator allocator;
+	char shared_padding[NDS_CACHE_LINE_SIZE];
+
+	/* written by the producer: the index of the next element and its copy of the index of the consumer */
+	size_t tail;
+	size_t cached_head;
+	char producer_padding[NDS_CACHE_LINE_SIZE - 2 * sizeof(size_t)];
+
+	/* written by the consumer: the index of the front element and its copy of the index of the producer */
+	size_t head;
+	size_t cached_tail;
+	char consumer_padding[NDS_CACHE_LINE_SIZE - 2 * sizeof(size_t)];
+};
+
+typedef struct NdsSpscQueuePrivate NdsSpscQueuePrivate;
+
+/* the handle and the private part of a NdsSpscQueue are allocated as a single block */
+struct NdsSpscQueueBlock
+{
+	NdsSpscQueue queue;
+	NdsSpscQueuePrivate private;
+};
+
+
+/* returns the smallest power of two not less than capacity and minimum, or 0 if it does not fit in a size_t */
+static size_t nds_queue_round_capacity(size_t capacity, size_t minimum)
+{
+	size_t rounded = minimum;
+
+	while (rounded < capacity)
+	{
+		if (rounded > SIZE_MAX / 2)
+			return 0;
+		rounded *= 2;
+	}
+
+	return rounded;
+}
+
+
+/* copies count elements to the ring from the slot of index on, in at most two parts */
+static void nds_ring_write(char *elements, size_t sizeof_element, size_t mask, size_t index, const void *source, size_t count)
+{
+	size_t slot = index & mask, first = mask + 1 - slot < count ? mask + 1 - slot : count;
+
+	memcpy(elements + slot * sizeof_element, source, first * sizeof_element);
+	memcpy(elements, (const char*)source + first * sizeof_element, (count - first) * sizeof_element);
+}
+
+
+/* copies count elements from the ring from the slot of index on, in at most two parts */
+static void nds_ring_read(const char *elements, size_t sizeof_element, size_t mask, size_t index, void *destination, size_t count)
+{
+	size_t slot = index & mask, first = mask + 1 - slot < count ? mask + 1 - slot : count;
+
+	memcpy(destination, elements + slot * sizeof_element, first * sizeof_element);
+	memcpy((char*)destination + first * sizeof_element, elements, (count - first) * sizeof_element);
+}
+
+
+/*
+ * Grows the buffer to the given capacity, a larger power of two. When the
+ * elements wrap around the end of the old buffer, the part that wrapped to
+ * its start is moved right after the old end, or the part at the old end is
+ * moved to the end of the new buffer, whichever is shorter.
+ */
+static NdsStatus nds_queue_grow(NdsQueuePrivate *private, size_t capacity)
+{
+	size_t old_capacity = private->capacity, wrapped, end_part;
+	char *elements;
+
+	if (capacity > SIZE_MAX / private->sizeof_element)
+		return NDS_MEM_ALLOC_ERROR;
+
+	elements = (char*)private->allocator.realloc(private->allocator.context, private->elements, old_capacity * private->sizeof_element,
+		capacity * private->sizeof_element);
+	if (!elements)
+		return NDS_MEM_ALLOC_ERROR;
+
+	private->elements = elements;
+	private->capacity = capacity;
+
+	if (private->head + private->size <= old_capacity)
+		return NDS_OK;
+
+	wrapped = private->head + private->size - old_capacity;
+	end_part = old_capacity - private->head;
+
+	if (wrapped <= end_part)
+	{
+		memcpy(elements + old_capacity * private->sizeof_element, elements, wrapped * private->sizeof_element);
+	}
+	else
+	{
+		memmove(elements + (capacity - end_part) * private->sizeof_element, elements + private->head * private->sizeof_element, end_part * private->sizeof_element);
+		private->head = capacity - end_part;
+	}
+
+	return NDS_OK;
+}
+
+
+NdsQueue* nds_queue_new(size_t sizeof_element)
+{
+	return nds_queue_new_with_allocator(sizeof_element, NDS_QUEUE_MIN_CAPACITY, nds_allocator_default());
+}
+
+
+NdsQueue* nds_queue_new_with_allocator(size_t sizeof_element, size_t capacity, const NdsAllocator *allocator)
+{
+	struct NdsQueueBlock *block;
+
+	/* sanity checks */
+	if (sizeof_element == 0 || allocator == NULL)
+		return NULL;
+
+	if (allocator->alloc == NULL || allocator->realloc == NULL || allocator->free == NULL)
+		return NULL;
+
+	capacity = nds_queue_round_capacity(capacity, NDS_QUEUE_MIN_CAPACITY);
+	if (capacity == 0 || capacity > SIZE_MAX / sizeof_element)
+		return NULL;
+
+	/* we allocate memory for the structure and the private part of the NdsQueue */
+	block = (struct NdsQueueBlock*)allocator->alloc(allocator->context, sizeof(struct NdsQueueBlock));
+	if (!block)
+		return NULL;
+
+	block->private.elements = (char*)allocator->alloc(allocator->context, capacity * sizeof_element);
+	if (!block->private.elements)
+	{
+		/* cleanup */
+		allocator->free(allocator->context, block, sizeof(struct NdsQueueBlock));
+
+		return NULL;
+	}
+
+	block->queue.private = &block->private;
+	block->private.sizeof_element = sizeof_element;
+	block->private.head = 0;
+	block->private.size = 0;
+	block->private.capacity = capacity;
+	block->private.allocator = *allocator;
+
+	return &block->queue;
+}
+
+
+void nds_queue_destroy(NdsQueue *queue)
+{
+	NdsAllocator allocator;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return;
+
+	/* the allocator lives inside the block that is released last, so we keep a copy of it */
+	allocator = queue->private->allocator;
+
+	allocator.free(allocator.context, queue->private->elements, queue->private->capacity * queue->private->sizeof_element);
+	queue->private = NULL;
+
+	allocator.free(allocator.context, queue, sizeof(struct NdsQueueBlock));
+	queue = NULL;
+}
+
+
+ssize_t nds_queue_size(NdsQueue *queue)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return -1;
+
+	return (ssize_t)queue->private->size;
+}
+
+
+ssize_t nds_queue_capacity(NdsQueue *queue)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return -1;
+
+	return (ssize_t)queue->private->capacity;
+}
+
+
+NdsStatus nds_queue_reserve(NdsQueue *queue, size_t capacity)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	if (capacity <= queue->private->capacity)
+		return NDS_OK;
+
+	capacity = nds_queue_round_capacity(capacity, queue->private->capacity);
+	if (capacity == 0)
+		return NDS_MEM_ALLOC_ERROR;
+
+	return nds_queue_grow(queue->private, capacity);
+}
+
+
+NdsStatus nds_queue_enqueue(NdsQueue *queue, const void *element)
+{
+	NdsQueuePrivate *private;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = queue->private;
+
+	if (private->size == private->capacity)
+		if (private->capacity > SIZE_MAX / 2 || nds_queue_grow(private, private->capacity * 2) != NDS_OK)
+			return NDS_MEM_ALLOC_ERROR;
+
+	memcpy(private->elements + ((private->head + private->size) & (private->capacity - 1)) * private->sizeof_element, element, private->sizeof_element);
+	private->size++;
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_queue_enqueue_n(NdsQueue *queue, const void *elements, size_t count)
+{
+	NdsQueuePrivate *private;
+	NdsStatus status;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || (elements == NULL && count != 0))
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = queue->private;
+
+	if (count == 0)
+		return NDS_OK;
+
+	if (count > SIZE_MAX - private->size)
+		return NDS_MEM_ALLOC_ERROR;
+
+	status = nds_queue_reserve(queue, private->size + count);
+	if (status != NDS_OK)
+		return status;
+
+	nds_ring_write(private->elements, private->sizeof_element, private->capacity - 1, private->head + private->size, elements, count);
+	private->size += count;
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_queue_dequeue(NdsQueue *queue, void *element)
+{
+	NdsQueuePrivate *private;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || queue->private->size == 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = queue->private;
+
+	if (element != NULL)
+		memcpy(element, private->elements + private->head * private->sizeof_element, private->sizeof_element);
+
+	private->head = (private->head + 1) & (private->capacity - 1);
+	private->size--;
+
+	return NDS_OK;
+}
+
+
+ssize_t nds_queue_dequeue_n(NdsQueue *queue, void *elements, size_t count)
+{
+	NdsQueuePrivate *private;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return -1;
+
+	private = queue->private;
+
+	if (count > private->size)
+		count = private->size;
+
+	if (count == 0)
+		return 0;
+
+	if (elements != NULL)
+		nds_ring_read(private->elements, private->sizeof_element, private->capacity - 1, private->head, elements, count);
+
+	private->head = (private->head + count) & (private->capacity - 1);
+	private->size -= count;
+
+	return (ssize_t)count;
+}
+
+
+NdsStatus nds_queue_front(NdsQueue *queue, void *element)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || queue->private->size == 0 || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	memcpy(element, queue->private->elements + queue->private->head * queue->private->sizeof_element, queue->private->sizeof_element);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_queue_clear(NdsQueue *queue)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	queue->private->head = 0;
+	queue->private->size = 0;
+
+	return NDS_OK;
+}
+
+
+NdsSpscQueue* nds_spsc_queue_new(size_t sizeof_element, size_t capacity)
+{
+	return nds_spsc_queue_new_with_allocator(sizeof_element, capacity, nds_allocator_default());
+}
+
+
+NdsSpscQueue* nds_spsc_queue_new_with_allocator(size_t sizeof_element, size_t capacity, const NdsAllocator *allocator)
+{
+	struct NdsSpscQueueBlock *block;
+
+	/* sanity checks */
+	if (sizeof_element == 0 || capacity == 0 || allocator == NULL)
+		return NULL;
+
+	if (allocator->alloc == NULL || allocator->free == NULL)
+		return NULL;
+
+	capacity = nds_queue_round_capacity(capacity, 1);
+	if (capacity == 0 || capacity > SIZE_MAX / sizeof_element)
+		return NULL;
+
+	/* we allocate memory for the structure and the private part of the NdsSpscQueue */
+	block = (struct NdsSpscQueueBlock*)allocator->alloc(allocator->context, sizeof(struct NdsSpscQueueBlock));
+	if (!block)
+		return NULL;
+
+	block->private.elements = (char*)allocator->alloc(allocator->context, capacity * sizeof_element);
+	if (!block->private.elements)
+	{
+		/* cleanup */
+		allocator->free(allocator->context, block, sizeof(struct NdsSpscQueueBlock));
+
+		return NULL;
+	}
+
+	block->queue.private = &block->private;
+	block->private.sizeof_element = sizeof_element;
+	block->private.mask = capacity - 1;
+	block->private.allocator = *allocator;
+	block->private.tail = 0;
+	block->private.cached_head = 0;
+	block->private.head = 0;
+	block->private.cached_tail = 0;
+
+	return &block->queue;
+}
+
+
+void nds_spsc_queue_destroy(NdsSpscQueue *queue)
+{
+	NdsAllocator allocator;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return;
+
+	/* the allocator lives inside the block that is released last, so we keep a copy of it */
+	allocator = queue->private->allocator;
+
+	allocator.free(allocator.context, queue->private->elements, (queue->private->mask + 1) * queue->private->sizeof_element);
+	queue->private = NULL;
+
+	allocator.free(allocator.context, queue, sizeof(struct NdsSpscQueueBlock));
+	queue = NULL;
+}
+
+
+ssize_t nds_spsc_queue_capacity(NdsSpscQueue *queue)
+{
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return -1;
+
+	return (ssize_t)(queue->private->mask + 1);
+}
+
+
+ssize_t nds_spsc_queue_size(NdsSpscQueue *queue)
+{
+	size_t head, tail;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return -1;
+
+	/* the head is read first, so the tail read after it is never behind it */
+	head = __atomic_load_n(&queue->private->head, __ATOMIC_ACQUIRE);
+	tail = __atomic_load_n(&queue->private->tail, __ATOMIC_ACQUIRE);
+
+	return (ssize_t)(tail - head);
+}
+
+
+ssize_t nds_spsc_queue_enqueue_n(NdsSpscQueue *queue, const void *elements, size_t count)
+{
+	NdsSpscQueuePrivate *private;
+	size_t tail, room;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL || (elements == NULL && count != 0))
+		return -1;
+
+	private = queue->private;
+
+	/* only the producer writes the tail, so it reads its own value without synchronization */
+	tail = __atomic_load_n(&private->tail, __ATOMIC_RELAXED);
+	room = private->mask + 1 - (tail - private->cached_head);
+
+	/* the index of the consumer is read again only when the cached one does not leave enough room */
+	if (room < count)
+	{
+		private->cached_head = __atomic_load_n(&private->head, __ATOMIC_ACQUIRE);
+		room = private->mask + 1 - (tail - private->cached_head);
+	}
+
+	if (count > room)
+		count = room;
+
+	if (count == 0)
+		return 0;
+
+	nds_ring_write(private->elements, private->sizeof_element, private->mask, tail, elements, count);
+
+	/* the elements are written before the consumer can see the new tail */
+	__atomic_store_n(&private->tail, tail + count, __ATOMIC_RELEASE);
+
+	return (ssize_t)count;
+}
+
+
+int nds_spsc_queue_try_enqueue(NdsSpscQueue *queue, const void *element)
+{
+	/* sanity checks */
+	if (element == NULL)
+		return -1;
+
+	return (int)nds_spsc_queue_enqueue_n(queue, element, 1);
+}
+
+
+ssize_t nds_spsc_queue_dequeue_n(NdsSpscQueue *queue, void *elements, size_t count)
+{
+	NdsSpscQueuePrivate *private;
+	size_t head, available;
+
+	/* sanity checks */
+	if (queue == NULL || queue->private == NULL)
+		return -1;
+
+	private = queue->private;
+
+	/* only the consumer writes the head, so it reads its own value without synchronization */
+	head = __atomic_load_n(&private->head, __ATOMIC_RELAXED);
+	available = private->cached_tail - head;
+
+	/* the index of the producer is read again only when the cached one does not show enough elements */
+	if (available < count)
+	{
+		private->cached_tail = __atomic_load_n(&private->tail, __ATOMIC_ACQUIRE);
+		available = private->cached_tail - head;
+	}
+
+	if (count > available)
+		count = available;
+
+	if (count == 0)
+		return 0;
+
+	if (elements != NULL)
+		nds_ring_read(private->elements, private->sizeof_element, private->mask, head, elements, count);
+
+	/* the elements are read before the producer can reuse their slots */
+	__atomic_store_n(&private->head, head + count, __ATOMIC_RELEASE);
+
+	return (ssize_t)count;
+}
+
+
+int nds_spsc_queue_try_dequeue(NdsSpscQueue *queue, void *element)
+{
+	return (int)nds_spsc_queue_dequeue_n(queue, element, 1);
+}
@@ -0,0 +1,813 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the implementation of the NdsScheduler. The deques are
+ * the ones of Chase and Lev, with the memory orderings of Le, Pop, Cohen and
+ * Zappa Nardelli ("Correct and Efficient Work-Stealing for Weak Memory
+ * Models"). Workers that find no task to run or steal go to sleep on a
+ * condition variable and are woken by the next spawn.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+/* pthreads, sched_yield() and sysconf() are not part of C99 */
+#define _POSIX_C_SOURCE 200809L
+
+#include <nds/ndsscheduler.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+/* initial number of slots of a deque (a power of two) */
+#define NDS_DEQUE_INITIAL_CAPACITY 256
+
+/* number of failed searches for a task after which a worker goes to sleep */
+#define NDS_SCHEDULER_SPIN_ROUNDS 64
+
+/* a range of nds_parallel_for() is split while the deque of its thread holds fewer tasks than this */
+#define NDS_SCHEDULER_SPLIT_THRESHOLD 2
+
+/* largest number of halves a range of nds_parallel_for() gives away */
+#define NDS_SCHEDULER_MAX_SPLITS 32
+
+/* the automatic grain of nds_parallel_for() allows this many ranges per thread */
+#define NDS_SCHEDULER_RANGES_PER_THREAD 32
+
+
+/* the slots of a deque, replaced by a copy twice as large when the deque is full */
+struct NdsDequeArray
+{
+	int64_t capacity;
+
+	/* the array this one replaced, which thieves may still be reading */
+	struct NdsDequeArray *retired;
+
+	NdsTask *slots[];
+};
+
+
+/* a worker thread and its deque, the end written by the thieves is on its own cache line */
+struct NdsSchedulerWorker
+{
+	/* index of the oldest task, advanced by the thieves */
+	int64_t top;
+	char top_padding[NDS_CACHE_LINE_SIZE - sizeof(int64_t)];
+
+	/* index after the newest task and the other fields written only by the owner */
+	int64_t bottom;
+	struct NdsDequeArray *array;
+	NdsScheduler *scheduler;
+	unsigned int random;
+	pthread_t thread;
+
+	/* keeps the owner fields away from the top of the next worker */
+	char padding[NDS_CACHE_LINE_SIZE];
+};
+
+
+struct NdsSchedulerPrivate
+{
+	struct NdsSchedulerWorker *workers;
+	size_t threads;
+
+	/* tasks spawned by threads that are not workers of the scheduler, oldest first */
+	pthread_mutex_t injection_lock;
+	NdsTask *injection_head;
+	NdsTask *injection_tail;
+	size_t injected;
+
+	/* victim of the next steal made by a thread that is not a worker */
+	size_t next_victim;
+
+	/* workers that found nothing to do sleep until a spawn or the shutdown wakes them */
+	pthread_mutex_t sleep_lock;
+	pthread_cond_t sleep_wake;
+	int sleepers;
+	int shutdown;
+};
+
+typedef struct NdsSchedulerPrivate NdsSchedulerPrivate;
+
+
+/* the handle and the private part of a scheduler are allocated together */
+struct NdsSchedulerBlock
+{
+	NdsScheduler scheduler;
+	NdsSchedulerPrivate private;
+};
+
+
+/* the work of a call to nds_parallel_for() */
+struct NdsParallelFor
+{
+	NdsScheduler *scheduler;
+	size_t grain;
+	NdsRangeFunction function;
+	void *context;
+};
+
+/* a half of a range given away as a task */
+struct NdsParallelForRange
+{
+	const struct NdsParallelFor *job;
+	size_t begin;
+	size_t end;
+};
+
+/* the work of a call to nds_parallel_run() */
+struct NdsParallelRun
+{
+	NdsTaskFunction function;
+	void *context;
+};
+
+
+/* every worker thread keeps a pointer to its NdsSchedulerWorker under this key */
+static pthread_key_t nds_scheduler_key;
+static pthread_once_t nds_scheduler_key_once = PTHREAD_ONCE_INIT;
+
+/* the scheduler of the parallel algorithms and the thread count requested for it (0 for one per processor) */
+static pthread_mutex_t nds_scheduler_default_lock = PTHREAD_MUTEX_INITIALIZER;
+static NdsScheduler *nds_scheduler_default_instance;
+static size_t nds_scheduler_default_count;
+
+
+static void nds_scheduler_key_create(void)
+{
+	pthread_key_create(&nds_scheduler_key, NULL);
+}
+
+
+/* returns the worker of the scheduler that is the calling thread, or NULL for the other threads */
+static struct NdsSchedulerWorker* nds_scheduler_current(NdsScheduler *scheduler)
+{
+	struct NdsSchedulerWorker *worker = (struct NdsSchedulerWorker*)pthread_getspecific(nds_scheduler_key);
+
+	return worker && worker->scheduler == scheduler ? worker : NULL;
+}
+
+
+static struct NdsDequeArray* nds_deque_array_new(int64_t capacity)
+{
+	struct NdsDequeArray *array = (struct NdsDequeArray*)malloc(sizeof(struct NdsDequeArray) + (size_t)capacity * sizeof(NdsTask*));
+
+	if (!array)
+		return NULL;
+
+	array->capacity = capacity;
+	array->retired = NULL;
+
+	return array;
+}
+
+
+/* replaces the array of a full deque with a copy twice as large, only called by the owner */
+static struct NdsDequeArray* nds_deque_grow(struct NdsSchedulerWorker *worker, int64_t top, int64_t bottom)
+{
+	struct NdsDequeArray *array = worker->array;
+	struct NdsDequeArray *grown = nds_deque_array_new(array->capacity * 2);
+	int64_t i;
+
+	if (!grown)
+		return NULL;
+
+	for (i = top; i < bottom; i++)
+		grown->slots[i & (grown->capacity - 1)] = __atomic_load_n(&array->slots[i & (array->capacity - 1)], __ATOMIC_RELAXED);
+
+	/* the old array is freed with the scheduler, since a thief may have loaded it before the swap */
+	grown->retired = array;
+	__atomic_store_n(&worker->array, grown, __ATOMIC_RELEASE);
+
+	return grown;
+}
+
+
+/* pushes a task at the bottom of the deque of a worker, only called by the owner */
+static NdsStatus nds_deque_push(struct NdsSchedulerWorker *worker, NdsTask *task)
+{
+	int64_t bottom = __atomic_load_n(&worker->bottom, __ATOMIC_RELAXED);
+	int64_t top = __atomic_load_n(&worker->top, __ATOMIC_ACQUIRE);
+	struct NdsDequeArray *array = __atomic_load_n(&worker->array, __ATOMIC_RELAXED);
+
+	if (bottom - top > array->capacity - 1)
+	{
+		array = nds_deque_grow(worker, top, bottom);
+		if (!array)
+			return NDS_MEM_ALLOC_ERROR;
+	}
+
+	/* the release store publishes the task and its fields to the thieves that acquire bottom */
+	__atomic_store_n(&array->slots[bottom & (array->capacity - 1)], task, __ATOMIC_RELAXED);
+	__atomic_store_n(&worker->bottom, bottom + 1, __ATOMIC_RELEASE);
+
+	return NDS_OK;
+}
+
+
+/* pops the newest task of the deque of a worker, only called by the owner */
+static NdsTask* nds_deque_pop(struct NdsSchedulerWorker *worker)
+{
+	int64_t bottom = __atomic_load_n(&worker->bottom, __ATOMIC_RELAXED) - 1;
+	struct NdsDequeArray *array = __atomic_load_n(&worker->array, __ATOMIC_RELAXED);
+	int64_t top;
+	NdsTask *task;
+
+	__atomic_store_n(&worker->bottom, bottom, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	top = __atomic_load_n(&worker->top, __ATOMIC_RELAXED);
+
+	if (top > bottom)
+	{
+		/* the deque was empty */
+		__atomic_store_n(&worker->bottom, bottom + 1, __ATOMIC_RELAXED);
+		return NULL;
+	}
+
+	task = __atomic_load_n(&array->slots[bottom & (array->capacity - 1)], __ATOMIC_RELAXED);
+	if (top == bottom)
+	{
+		/* the last task, which a thief may be taking at the same time */
+		if (!__atomic_compare_exchange_n(&worker->top, &top, top + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+			task = NULL;
+
+		__atomic_store_n(&worker->bottom, bottom + 1, __ATOMIC_RELAXED);
+	}
+
+	return task;
+}
+
+
+/* takes the oldest task of the deque of a worker, reporting a lost race with another thread in contended */
+static NdsTask* nds_deque_steal(struct NdsSchedulerWorker *worker, int *contended)
+{
+	int64_t top = __atomic_load_n(&worker->top, __ATOMIC_ACQUIRE);
+	int64_t bottom;
+	struct NdsDequeArray *array;
+	NdsTask *task;
+
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	bottom = __atomic_load_n(&worker->bottom, __ATOMIC_ACQUIRE);
+
+	if (top >= bottom)
+		return NULL;
+
+	array = __atomic_load_n(&worker->array, __ATOMIC_ACQUIRE);
+	task = __atomic_load_n(&array->slots[top & (array->capacity - 1)], __ATOMIC_RELAXED);
+
+	if (!__atomic_compare_exchange_n(&worker->top, &top, top + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+	{
+		*contended = 1;
+		return NULL;
+	}
+
+	return task;
+}
+
+
+/* returns the number of tasks in the deque of a worker, exact only for the owner */
+static int64_t nds_deque_size(struct NdsSchedulerWorker *worker)
+{
+	return __atomic_load_n(&worker->bottom, __ATOMIC_RELAXED) - __atomic_load_n(&worker->top, __ATOMIC_RELAXED);
+}
+
+
+static void nds_scheduler_inject(NdsSchedulerPrivate *private, NdsTask *task)
+{
+	pthread_mutex_lock(&private->injection_lock);
+
+	if (private->injection_tail)
+		private->injection_tail->next = task;
+	else
+		private->injection_head = task;
+
+	private->injection_tail = task;
+	__atomic_add_fetch(&private->injected, 1, __ATOMIC_SEQ_CST);
+
+	pthread_mutex_unlock(&private->injection_lock);
+}
+
+
+static NdsTask* nds_scheduler_take_injected(NdsSchedulerPrivate *private)
+{
+	NdsTask *task;
+
+	if (__atomic_load_n(&private->injected, __ATOMIC_RELAXED) == 0)
+		return NULL;
+
+	pthread_mutex_lock(&private->injection_lock);
+
+	task = private->injection_head;
+	if (task)
+	{
+		private->injection_head = task->next;
+		if (!private->injection_head)
+			private->injection_tail = NULL;
+
+		__atomic_sub_fetch(&private->injected, 1, __ATOMIC_RELAXED);
+	}
+
+	pthread_mutex_unlock(&private->injection_lock);
+
+	return task;
+}
+
+
+/* looks for a task in the own deque, then in the shared queue, then in the deques of the other workers */
+static NdsTask* nds_scheduler_find_task(NdsSchedulerPrivate *private, struct NdsSchedulerWorker *self, int *contended)
+{
+	NdsTask *task = self ? nds_deque_pop(self) : NULL;
+	size_t start, i;
+
+	if (!task)
+		task = nds_scheduler_take_injected(private);
+
+	if (task || private->threads == 0)
+		return task;
+
+	/* the victims are visited from a random one, so that the thieves spread over the workers */
+	if (self)
+	{
+		self->random ^= self->random << 13;
+		self->random ^= self->random >> 17;
+		self->random ^= self->random << 5;
+		start = self->random % private->threads;
+	}
+	else
+	{
+		start = __atomic_fetch_add(&private->next_victim, 1, __ATOMIC_RELAXED) % private->threads;
+	}
+
+	for (i = 0; i < private->threads && !task; i++)
+		if (&private->workers[(start + i) % private->threads] != self)
+			task = nds_deque_steal(&private->workers[(start + i) % private->threads], contended);
+
+	return task;
+}
+
+
+static void nds_scheduler_execute(NdsTask *task)
+{
+	task->routine(task->context);
+	__atomic_store_n(&task->done, 1, __ATOMIC_RELEASE);
+}
+
+
+/* checks if any task is waiting to be run, used by workers before they go to sleep */
+static int nds_scheduler_has_work(NdsSchedulerPrivate *private)
+{
+	size_t i;
+
+	if (__atomic_load_n(&private->injected, __ATOMIC_SEQ_CST) != 0)
+		return 1;
+
+	for (i = 0; i < private->threads; i++)
+		if (__atomic_load_n(&private->workers[i].top, __ATOMIC_SEQ_CST) < __atomic_load_n(&private->workers[i].bottom, __ATOMIC_SEQ_CST))
+			return 1;
+
+	return 0;
+}
+
+
+/*
+ * Wakes a sleeping worker after a task was published. The fence pairs with
+ * the one in nds_scheduler_sleep(): either the spawn sees the sleeper, or
+ * the sleeper sees the task before it waits.
+ */
+static void nds_scheduler_wake(NdsSchedulerPrivate *private)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	if (__atomic_load_n(&private->sleepers, __ATOMIC_RELAXED) > 0)
+	{
+		pthread_mutex_lock(&private->sleep_lock);
+		pthread_cond_signal(&private->sleep_wake);
+		pthread_mutex_unlock(&private->sleep_lock);
+	}
+}
+
+
+static void nds_scheduler_sleep(NdsSchedulerPrivate *private)
+{
+	pthread_mutex_lock(&private->sleep_lock);
+
+	__atomic_add_fetch(&private->sleepers, 1, __ATOMIC_SEQ_CST);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	if (!__atomic_load_n(&private->shutdown, __ATOMIC_ACQUIRE) && !nds_scheduler_has_work(private))
+		pthread_cond_wait(&private->sleep_wake, &private->sleep_lock);
+
+	__atomic_sub_fetch(&private->sleepers, 1, __ATOMIC_SEQ_CST);
+
+	pthread_mutex_unlock(&private->sleep_lock);
+}
+
+
+static void* nds_scheduler_worker_main(void *argument)
+{
+	struct NdsSchedulerWorker *self = (struct NdsSchedulerWorker*)argument;
+	NdsSchedulerPrivate *private = self->scheduler->private;
+	unsigned int idle = 0;
+	int contended;
+	NdsTask *task;
+
+	pthread_setspecific(nds_scheduler_key, self);
+
+	while (!__atomic_load_n(&private->shutdown, __ATOMIC_ACQUIRE))
+	{
+		contended = 0;
+		task = nds_scheduler_find_task(private, self, &contended);
+
+		if (task)
+		{
+			nds_scheduler_execute(task);
+			idle = 0;
+		}
+		else if (contended || ++idle < NDS_SCHEDULER_SPIN_ROUNDS)
+		{
+			sched_yield();
+		}
+		else
+		{
+			nds_scheduler_sleep(private);
+			idle = 0;
+		}
+	}
+
+	return NULL;
+}
+
+
+/* stops the first started workers and frees the memory of the scheduler */
+static void nds_scheduler_release(NdsScheduler *scheduler, size_t started)
+{
+	NdsSchedulerPrivate *private = scheduler->private;
+	struct NdsDequeArray *array, *retired;
+	size_t i;
+
+	pthread_mutex_lock(&private->sleep_lock);
+	__atomic_store_n(&private->shutdown, 1, __ATOMIC_RELEASE);
+	pthread_cond_broadcast(&private->sleep_wake);
+	pthread_mutex_unlock(&private->sleep_lock);
+
+	for (i = 0; i < started; i++)
+		pthread_join(private->workers[i].thread, NULL);
+
+	for (i = 0; i < private->threads; i++)
+	{
+		for (array = private->workers[i].array; array; array = retired)
+		{
+			retired = array->retired;
+			free(array);
+		}
+	}
+
+	pthread_cond_destroy(&private->sleep_wake);
+	pthread_mutex_destroy(&private->sleep_lock);
+	pthread_mutex_destroy(&private->injection_lock);
+	free(private->workers);
+	free(scheduler);
+}
+
+
+NdsScheduler* nds_scheduler_new(size_t threads)
+{
+	struct NdsSchedulerBlock *block;
+	NdsSchedulerPrivate *private;
+	size_t i;
+
+	/* sanity checks */
+	if (threads > NDS_MAX_WORKERS)
+		return NULL;
+
+	pthread_once(&nds_scheduler_key_once, nds_scheduler_key_create);
+
+	block = (struct NdsSchedulerBlock*)calloc(1, sizeof(struct NdsSchedulerBlock));
+	if (!block)
+		return NULL;
+
+	block->scheduler.private = &block->private;
+	private = &block->private;
+	private->threads = threads;
+
+	private->workers = (struct NdsSchedulerWorker*)calloc(threads ? threads : 1, sizeof(struct NdsSchedulerWorker));
+	if (!private->workers)
+	{
+		/* cleanup */
+		free(block);
+
+		return NULL;
+	}
+
+	pthread_mutex_init(&private->injection_lock, NULL);
+	pthread_mutex_init(&private->sleep_lock, NULL);
+	pthread_cond_init(&private->sleep_wake, NULL);
+
+	for (i = 0; i < threads; i++)
+	{
+		private->workers[i].scheduler = &block->scheduler;
+		private->workers[i].random = (unsigned int)(i * 2654435761u) | 1;
+		private->workers[i].array = nds_deque_array_new(NDS_DEQUE_INITIAL_CAPACITY);
+
+		if (!private->workers[i].array)
+		{
+			/* cleanup */
+			nds_scheduler_release(&block->scheduler, 0);
+
+			return NULL;
+		}
+	}
+
+	for (i = 0; i < threads; i++)
+	{
+		if (pthread_create(&private->workers[i].thread, NULL, nds_scheduler_worker_main, &private->workers[i]) != 0)
+		{
+			/* cleanup */
+			nds_scheduler_release(&block->scheduler, i);
+
+			return NULL;
+		}
+	}
+
+	return &block->scheduler;
+}
+
+
+void nds_scheduler_destroy(NdsScheduler *scheduler)
+{
+	/* sanity checks */
+	if (scheduler == NULL || scheduler->private == NULL)
+		return;
+
+	nds_scheduler_release(scheduler, scheduler->private->threads);
+}
+
+
+NdsScheduler* nds_scheduler_default(void)
+{
+	NdsScheduler *scheduler = __atomic_load_n(&nds_scheduler_default_instance, __ATOMIC_ACQUIRE);
+
+	if (scheduler)
+		return scheduler;
+
+	pthread_mutex_lock(&nds_scheduler_default_lock);
+
+	scheduler = nds_scheduler_default_instance;
+	if (!scheduler)
+	{
+		scheduler = nds_scheduler_new(nds_get_worker_count() - 1);
+		__atomic_store_n(&nds_scheduler_default_instance, scheduler, __ATOMIC_RELEASE);
+	}
+
+	pthread_mutex_unlock(&nds_scheduler_default_lock);
+
+	return scheduler;
+}
+
+
+ssize_t nds_scheduler_thread_count(NdsScheduler *scheduler)
+{
+	/* sanity checks */
+	if (scheduler == NULL || scheduler->private == NULL)
+		return -1;
+
+	return (ssize_t)scheduler->private->threads;
+}
+
+
+NdsStatus nds_task_spawn(NdsScheduler *scheduler, NdsTask *task, NdsTaskRoutine routine, void *context)
+{
+	struct NdsSchedulerWorker *self;
+
+	/* sanity checks */
+	if (scheduler == NULL || scheduler->private == NULL || task == NULL || routine == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	task->routine = routine;
+	task->context = context;
+	task->next = NULL;
+	task->done = 0;
+
+	/* a deque that cannot grow sends its tasks to the shared queue */
+	self = nds_scheduler_current(scheduler);
+	if (!self || nds_deque_push(self, task) != NDS_OK)
+		nds_scheduler_inject(scheduler->private, task);
+
+	nds_scheduler_wake(scheduler->private);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_task_wait(NdsScheduler *scheduler, NdsTask *task)
+{
+	struct NdsSchedulerWorker *self;
+	NdsTask *other;
+	int contended;
+
+	/* sanity checks */
+	if (scheduler == NULL || scheduler->private == NULL || task == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	self = nds_scheduler_current(scheduler);
+
+	/* the thread runs other tasks until the one it waits for is done */
+	while (!__atomic_load_n(&task->done, __ATOMIC_ACQUIRE))
+	{
+		contended = 0;
+		other = nds_scheduler_find_task(scheduler->private, self, &contended);
+
+		if (other)
+			nds_scheduler_execute(other);
+		else
+			sched_yield();
+	}
+
+	return NDS_OK;
+}
+
+
+/* checks if a range is worth splitting, which is the case while the own tasks of the thread are being stolen */
+static int nds_parallel_for_should_split(NdsScheduler *scheduler)
+{
+	struct NdsSchedulerWorker *self;
+
+	if (scheduler->private->threads == 0)
+		return 0;
+
+	self = nds_scheduler_current(scheduler);
+	if (self)
+		return nds_deque_size(self) < NDS_SCHEDULER_SPLIT_THRESHOLD;
+
+	return __atomic_load_n(&scheduler->private->injected, __ATOMIC_RELAXED) < NDS_SCHEDULER_SPLIT_THRESHOLD;
+}
+
+
+static void nds_parallel_for_range(const struct NdsParallelFor *job, size_t begin, size_t end);
+
+
+static void nds_parallel_for_task(void *context)
+{
+	struct NdsParallelForRange *range = (struct NdsParallelForRange*)context;
+
+	nds_parallel_for_range(range->job, range->begin, range->end);
+}
+
+
+/*
+ * Processes a range grain by grain. Before every grain, the second half of
+ * what is left is given away as a task if the deque of the thread is nearly
+ * empty, so the range is split only as much as the idle threads need.
+ */
+static void nds_parallel_for_range(const struct NdsParallelFor *job, size_t begin, size_t end)
+{
+	struct NdsParallelForRange halves[NDS_SCHEDULER_MAX_SPLITS];
+	NdsTask tasks[NDS_SCHEDULER_MAX_SPLITS];
+	size_t splits = 0, middle;
+
+	while (end - begin > job->grain)
+	{
+		if (splits < NDS_SCHEDULER_MAX_SPLITS && nds_parallel_for_should_split(job->scheduler))
+		{
+			middle = begin + (end - begin) / 2;
+
+			halves[splits].job = job;
+			halves[splits].begin = middle;
+			halves[splits].end = end;
+			nds_task_spawn(job->scheduler, &tasks[splits], nds_parallel_for_task, &halves[splits]);
+
+			splits++;
+			end = middle;
+		}
+		else
+		{
+			job->function(begin, begin + job->grain, job->context);
+			begin += job->grain;
+		}
+	}
+
+	if (begin < end)
+		job->function(begin, end, job->context);
+
+	/* the newest halves are the most likely to still be in the own deque */
+	while (splits > 0)
+		nds_task_wait(job->scheduler, &tasks[--splits]);
+}
+
+
+NdsStatus nds_parallel_for(NdsScheduler *scheduler, size_t begin, size_t end, size_t grain, NdsRangeFunction function, void *context)
+{
+	struct NdsParallelFor job;
+
+	/* sanity checks */
+	if (scheduler == NULL || scheduler->private == NULL || function == NULL || begin > end)
+		return NDS_INVALID_PARAM_ERROR;
+
+	if (begin == end)
+		return NDS_OK;
+
+	job.scheduler = scheduler;
+	job.function = function;
+	job.context = context;
+
+	job.grain = grain;
+	if (job.grain == 0)
+		job.grain = (end - begin) / (NDS_SCHEDULER_RANGES_PER_THREAD * (scheduler->private->threads + 1));
+	if (job.grain == 0)
+		job.grain = 1;
+
+	nds_parallel_for_range(&job, begin, end);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_set_worker_count(size_t count)
+{
+	/* sanity checks */
+	if (count > NDS_MAX_WORKERS)
+		return NDS_INVALID_PARAM_ERROR;
+
+	pthread_mutex_lock(&nds_scheduler_default_lock);
+
+	if (nds_scheduler_default_instance)
+		nds_scheduler_destroy(nds_scheduler_default_instance);
+
+	__atomic_store_n(&nds_scheduler_default_instance, NULL, __ATOMIC_RELEASE);
+	nds_scheduler_default_count = count;
+
+	pthread_mutex_unlock(&nds_scheduler_default_lock);
+
+	return NDS_OK;
+}
+
+
+size_t nds_get_worker_count(void)
+{
+	long processors;
+
+	if (nds_scheduler_default_count != 0)
+		return nds_scheduler_default_count;
+
+	processors = sysconf(_SC_NPROCESSORS_ONLN);
+	if (processors < 1)
+		return 1;
+
+	return (size_t)processors < NDS_MAX_WORKERS ? (size_t)processors : NDS_MAX_WORKERS;
+}
+
+
+static void nds_parallel_run_range(size_t begin, size_t end, void *context)
+{
+	struct NdsParallelRun *run = (struct NdsParallelRun*)context;
+
+	for (; begin < end; begin++)
+		run->function(begin, run->context);
+}
+
+
+NdsStatus nds_parallel_run(size_t tasks, NdsTaskFunction function, void *context)
+{
+	struct NdsParallelRun run;
+	NdsScheduler *scheduler;
+
+	/* sanity checks */
+	if (function == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	run.function = function;
+	run.context = context;
+
+	/* without a scheduler the tasks run on the calling thread */
+	scheduler = nds_scheduler_default();
+	if (!scheduler)
+	{
+		nds_parallel_run_range(0, tasks, &run);
+		return NDS_OK;
+	}
+
+	return nds_parallel_for(scheduler, 0, tasks, 1, nds_parallel_run_range, &run);
+}
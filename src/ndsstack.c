@@ -0,0 +1,451 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the implementation of the NdsStack. The chunks are
+ * linked from the top of the stack down to its bottom, and the stack keeps
+ * pointers to the first element, the first free slot and the end of the
+ * chunk on top, so a push or a pop only compares two pointers and copies
+ * one element unless it crosses the end of a chunk.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include <nds/ndsstack.h>
+
+#include <stdint.h>
+#include <string.h>
+
+
+/* header of a chunk, followed by the elements */
+struct NdsStackChunk
+{
+	struct NdsStackChunk *previous;
+	size_t capacity;
+};
+
+typedef struct NdsStackChunk NdsStackChunk;
+
+/* size of the header of a chunk, rounded up so the elements keep the alignment of the allocation */
+#define NDS_STACK_CHUNK_HEADER_SIZE ((sizeof(NdsStackChunk) + 15) & ~(size_t)15)
+
+/* returns the address of the first element of a chunk */
+#define NDS_STACK_CHUNK_ELEMENTS(chunk) ((char*)(chunk) + NDS_STACK_CHUNK_HEADER_SIZE)
+
+
+struct NdsStackPrivate
+{
+	/* the chunk on top of the chain, its first element, its first free slot and its end */
+	NdsStackChunk *chunk;
+	char *begin;
+	char *top;
+	char *end;
+
+	/* the chunk emptied last, reused by the next growth (can be NULL) */
+	NdsStackChunk *spare;
+
+	/* number of elements and number of elements the chain of chunks fits */
+	size_t size;
+	size_t capacity;
+
+	size_t sizeof_element;
+	NdsAllocator allocator;
+};
+
+typedef struct NdsStackPrivate NdsStackPrivate;
+
+/* the handle and the private part of a NdsStack are allocated as a single block */
+struct NdsStackBlock
+{
+	NdsStack stack;
+	NdsStackPrivate private;
+};
+
+
+static NdsStackChunk* nds_stack_chunk_new(const NdsAllocator *allocator, size_t sizeof_element, size_t capacity)
+{
+	NdsStackChunk *chunk;
+
+	if (capacity > (SIZE_MAX - NDS_STACK_CHUNK_HEADER_SIZE) / sizeof_element)
+		return NULL;
+
+	chunk = (NdsStackChunk*)allocator->alloc(allocator->context, NDS_STACK_CHUNK_HEADER_SIZE + capacity * sizeof_element);
+	if (!chunk)
+		return NULL;
+
+	chunk->previous = NULL;
+	chunk->capacity = capacity;
+
+	return chunk;
+}
+
+
+static void nds_stack_chunk_free(NdsStackPrivate *private, NdsStackChunk *chunk)
+{
+	private->allocator.free(private->allocator.context, chunk, NDS_STACK_CHUNK_HEADER_SIZE + chunk->capacity * private->sizeof_element);
+}
+
+
+/* makes the given chunk the top of the stack, with count elements in use */
+static void nds_stack_enter(NdsStackPrivate *private, NdsStackChunk *chunk, size_t count)
+{
+	private->chunk = chunk;
+	private->begin = NDS_STACK_CHUNK_ELEMENTS(chunk);
+	private->top = private->begin + count * private->sizeof_element;
+	private->end = private->begin + chunk->capacity * private->sizeof_element;
+}
+
+
+/* returns the capacity of the chunk that follows the chunk on top: twice as large, up to NDS_STACK_MAX_CHUNK_SIZE bytes */
+static size_t nds_stack_next_capacity(const NdsStackPrivate *private)
+{
+	size_t capacity = private->chunk->capacity, limit = NDS_STACK_MAX_CHUNK_SIZE / private->sizeof_element;
+
+	if (limit == 0)
+		limit = 1;
+
+	if (capacity >= limit)
+		return capacity;
+
+	return capacity > limit / 2 ? limit : capacity * 2;
+}
+
+
+/* links an empty chunk on top of the full chunk on top, reusing the spare chunk if there is one */
+static NdsStatus nds_stack_raise(NdsStackPrivate *private)
+{
+	NdsStackChunk *chunk = private->spare;
+
+	if (chunk != NULL)
+	{
+		private->spare = NULL;
+	}
+	else
+	{
+		chunk = nds_stack_chunk_new(&private->allocator, private->sizeof_element, nds_stack_next_capacity(private));
+		if (!chunk)
+			return NDS_MEM_ALLOC_ERROR;
+	}
+
+	chunk->previous = private->chunk;
+	private->capacity += chunk->capacity;
+	nds_stack_enter(private, chunk, 0);
+
+	return NDS_OK;
+}
+
+
+/*
+ * Unlinks the empty chunk on top and makes the full chunk below it the top.
+ * The unlinked chunk replaces the spare chunk: it is the one that the next
+ * growth needs, while the former spare chunk was above it.
+ */
+static void nds_stack_lower(NdsStackPrivate *private)
+{
+	NdsStackChunk *chunk = private->chunk;
+
+	if (private->spare != NULL)
+		nds_stack_chunk_free(private, private->spare);
+
+	private->spare = chunk;
+	private->capacity -= chunk->capacity;
+	nds_stack_enter(private, chunk->previous, chunk->previous->capacity);
+}
+
+
+/*
+ * Removes count elements, at most the size of the stack, from its top. If
+ * destination is not NULL, they are copied there in the order they were
+ * pushed, with one copy of memory per chunk.
+ */
+static void nds_stack_take(NdsStackPrivate *private, char *destination, size_t count)
+{
+	size_t taken;
+
+	private->size -= count;
+
+	while (count > 0)
+	{
+		if (private->top == private->begin)
+			nds_stack_lower(private);
+
+		taken = (size_t)(private->top - private->begin) / private->sizeof_element;
+		if (taken > count)
+			taken = count;
+
+		count -= taken;
+		private->top -= taken * private->sizeof_element;
+
+		if (destination != NULL)
+			memcpy(destination + count * private->sizeof_element, private->top, taken * private->sizeof_element);
+	}
+}
+
+
+NdsStack* nds_stack_new(size_t sizeof_element)
+{
+	return nds_stack_new_with_allocator(sizeof_element, NDS_STACK_MIN_CAPACITY, nds_allocator_default());
+}
+
+
+NdsStack* nds_stack_new_with_allocator(size_t sizeof_element, size_t capacity, const NdsAllocator *allocator)
+{
+	struct NdsStackBlock *block;
+	NdsStackChunk *chunk;
+
+	/* sanity checks */
+	if (sizeof_element == 0 || allocator == NULL)
+		return NULL;
+
+	if (allocator->alloc == NULL || allocator->realloc == NULL || allocator->free == NULL)
+		return NULL;
+
+	if (capacity == 0)
+		capacity = NDS_STACK_MIN_CAPACITY;
+
+	/* we allocate memory for the structure and the private part of the NdsStack */
+	block = (struct NdsStackBlock*)allocator->alloc(allocator->context, sizeof(struct NdsStackBlock));
+	if (!block)
+		return NULL;
+
+	chunk = nds_stack_chunk_new(allocator, sizeof_element, capacity);
+	if (!chunk)
+	{
+		/* cleanup */
+		allocator->free(allocator->context, block, sizeof(struct NdsStackBlock));
+
+		return NULL;
+	}
+
+	block->stack.private = &block->private;
+	block->private.spare = NULL;
+	block->private.size = 0;
+	block->private.capacity = capacity;
+	block->private.sizeof_element = sizeof_element;
+	block->private.allocator = *allocator;
+	nds_stack_enter(&block->private, chunk, 0);
+
+	return &block->stack;
+}
+
+
+void nds_stack_destroy(NdsStack *stack)
+{
+	NdsAllocator allocator;
+	NdsStackChunk *chunk, *previous;
+
+	/* sanity checks */
+	if (stack == NULL || stack->private == NULL)
+		return;
+
+	/* the allocator lives inside the block that is released last, so we keep a copy of it */
+	allocator = stack->private->allocator;
+
+	if (stack->private->spare != NULL)
+		nds_stack_chunk_free(stack->private, stack->private->spare);
+
+	for (chunk = stack->private->chunk; chunk != NULL; chunk = previous)
+	{
+		previous = chunk->previous;
+		nds_stack_chunk_free(stack->private, chunk);
+	}
+
+	stack->private = NULL;
+
+	allocator.free(allocator.context, stack, sizeof(struct NdsStackBlock));
+	stack = NULL;
+}
+
+
+ssize_t nds_stack_size(NdsStack *stack)
+{
+	/* sanity checks */
+	if (stack == NULL || stack->private == NULL)
+		return -1;
+
+	return (ssize_t)stack->private->size;
+}
+
+
+ssize_t nds_stack_capacity(NdsStack *stack)
+{
+	/* sanity checks */
+	if (stack == NULL || stack->private == NULL)
+		return -1;
+
+	if (stack->private->spare != NULL)
+		return (ssize_t)(stack->private->capacity + stack->private->spare->capacity);
+
+	return (ssize_t)stack->private->capacity;
+}
+
+
+NdsStatus nds_stack_push(NdsStack *stack, const void *element)
+{
+	NdsStackPrivate *private;
+
+	/* sanity checks */
+	if (stack == NULL || stack->private == NULL || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = stack->private;
+
+	if (private->top == private->end && nds_stack_raise(private) != NDS_OK)
+		return NDS_MEM_ALLOC_ERROR;
+
+	memcpy(private->top, element, private->sizeof_element);
+	private->top += private->sizeof_element;
+	private->size++;
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_stack_push_n(NdsStack *stack, const void *elements, size_t count)
+{
+	NdsStackPrivate *private;
+	const char *source = (const char*)elements;
+	size_t pushed = 0, room;
+
+	/* sanity checks */
+	if (stack == NULL || stack->private == NULL || (elements == NULL && count != 0))
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = stack->private;
+
+	if (count > SIZE_MAX - private->size)
+		return NDS_MEM_ALLOC_ERROR;
+
+	while (pushed < count)
+	{
+		if (private->top == private->end && nds_stack_raise(private) != NDS_OK)
+		{
+			/* cleanup */
+			nds_stack_take(private, NULL, pushed);
+
+			return NDS_MEM_ALLOC_ERROR;
+		}
+
+		room = (size_t)(private->end - private->top) / private->sizeof_element;
+		if (room > count - pushed)
+			room = count - pushed;
+
+		memcpy(private->top, source + pushed * private->sizeof_element, room * private->sizeof_element);
+		private->top += room * private->sizeof_element;
+		private->size += room;
+		pushed += room;
+	}
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_stack_pop(NdsStack *stack, void *element)
+{
+	NdsStackPrivate *private;
+
+	/* sanity checks */
+	if (stack == NULL || stack->private == NULL || stack->private->size == 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = stack->private;
+
+	if (private->top == private->begin)
+		nds_stack_lower(private);
+
+	private->top -= private->sizeof_element;
+	private->size--;
+
+	if (element != NULL)
+		memcpy(element, private->top, private->sizeof_element);
+
+	return NDS_OK;
+}
+
+
+ssize_t nds_stack_pop_n(NdsStack *stack, void *elements, size_t count)
+{
+	/* sanity checks */
+	if (stack == NULL || stack->private == NULL)
+		return -1;
+
+	if (count > stack->private->size)
+		count = stack->private->size;
+
+	nds_stack_take(stack->private, (char*)elements, count);
+
+	return (ssize_t)count;
+}
+
+
+NdsStatus nds_stack_top(NdsStack *stack, void *element)
+{
+	NdsStackPrivate *private;
+
+	/* sanity checks */
+	if (stack == NULL || stack->private == NULL || stack->private->size == 0 || element == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = stack->private;
+
+	/* an emptied chunk stays on top until the next pop, so the top element can be the last one of the chunk below */
+	if (private->top == private->begin)
+	{
+		memcpy(element, NDS_STACK_CHUNK_ELEMENTS(private->chunk->previous) + (private->chunk->previous->capacity - 1) * private->sizeof_element,
+			private->sizeof_element);
+		return NDS_OK;
+	}
+
+	memcpy(element, private->top - private->sizeof_element, private->sizeof_element);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_stack_clear(NdsStack *stack)
+{
+	NdsStackPrivate *private;
+	NdsStackChunk *previous;
+
+	/* sanity checks */
+	if (stack == NULL || stack->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = stack->private;
+
+	if (private->spare != NULL)
+		nds_stack_chunk_free(private, private->spare);
+	private->spare = NULL;
+
+	while (private->chunk->previous != NULL)
+	{
+		previous = private->chunk->previous;
+		nds_stack_chunk_free(private, private->chunk);
+		private->chunk = previous;
+	}
+
+	private->size = 0;
+	private->capacity = private->chunk->capacity;
+	nds_stack_enter(private, private->chunk, 0);
+
+	return NDS_OK;
+}
@@ -0,0 +1,1173 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the implementation of the NdsTreeMap. Every node
+ * starts with a small header followed by its keys. A leaf stores the values
+ * after its keys, an inner node its children, and the separator keys[i] of
+ * an inner node is not greater than any key under children[i + 1] and is
+ * greater than every key under children[i]. Removals leave the separators
+ * alone when they stay valid bounds, so they are not always keys of the map.
+ *
+ * The nodes are carved out of chunks aligned to a cache line and the nodes
+ * released by removals are kept in a free list, so the tree calls the
+ * allocator once per chunk and a bulk load calls it at most once.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+/* ndsvector.c exports the accessors, this file only needs the private part of the vector */
+#define NDS_INLINE_FAST_PATH
+
+#include <nds/ndstreemap.h>
+
+#include <stdint.h>
+#include <string.h>
+
+
+/* the nodes are aligned to a cache line and their sizes are multiples of it */
+#define NDS_TREE_LINE 64
+
+/* the keys of a node take about 4 cache lines, with at least 4 and at most 128 keys */
+#define NDS_TREE_KEY_BYTES 256
+#define NDS_TREE_MIN_KEYS 4
+#define NDS_TREE_MAX_KEYS 128
+
+/* a tree of 64 levels would hold more pairs than the address space */
+#define NDS_TREE_MAX_HEIGHT 64
+
+/* number of nodes of the first chunk, the next chunks double up to NDS_TREE_MAX_CHUNK */
+#define NDS_TREE_MIN_CHUNK 8
+#define NDS_TREE_MAX_CHUNK 4096
+
+/* largest alignment given to the keys and the values */
+#define NDS_TREE_MAX_ALIGNMENT 16
+
+
+struct NdsTreeNode
+{
+	/* number of keys, an inner node has one child more */
+	unsigned int count;
+	unsigned int leaf;
+
+	/* the leaves are linked in key order, the released nodes through next */
+	struct NdsTreeNode *next;
+	struct NdsTreeNode *prev;
+};
+
+typedef struct NdsTreeNode NdsTreeNode;
+
+
+/* header of a chunk of nodes, the nodes start at the first cache line after it */
+struct NdsTreeChunk
+{
+	struct NdsTreeChunk *next;
+	size_t size;
+};
+
+typedef struct NdsTreeChunk NdsTreeChunk;
+
+
+typedef struct NdsTreeMapPrivate NdsTreeMapPrivate;
+
+/* returns the number of keys of a node that are less than key, or not greater than key when upper is set */
+typedef size_t (*NdsTreeSearchFunction)(NdsTreeMapPrivate *private, const char *keys, size_t count, const void *key, int upper);
+
+struct NdsTreeMapPrivate
+{
+	NdsTreeNode *root;
+	NdsTreeNode *first;
+	size_t size;
+	size_t height;
+
+	size_t sizeof_key;
+	size_t sizeof_value;
+
+	/* keys per node, a node other than the root keeps at least minimum of them */
+	size_t capacity;
+	size_t minimum;
+
+	/* layout of the nodes */
+	size_t keys_offset;
+	size_t values_offset;
+	size_t children_offset;
+	size_t sizeof_node;
+
+	NdsCompareFunction compare;
+	NdsTreeSearchFunction search;
+
+	/* two keys of scratch space for the separators moved up by the splits */
+	char *scratch;
+
+	/* node storage */
+	NdsTreeNode *free_nodes;
+	size_t free_count;
+	size_t used_nodes;
+	NdsTreeChunk *chunks;
+	char *next_node;
+	char *end;
+	size_t chunk_nodes;
+
+	NdsAllocator allocator;
+};
+
+
+/* the handle and the private part of a NdsTreeMap are allocated as a single block, followed by the scratch keys */
+struct NdsTreeMapBlock
+{
+	NdsTreeMap map;
+	NdsTreeMapPrivate private;
+};
+
+#define NDS_TREE_BLOCK_SIZE ((sizeof(struct NdsTreeMapBlock) + NDS_TREE_MAX_ALIGNMENT - 1) & ~(size_t)(NDS_TREE_MAX_ALIGNMENT - 1))
+
+
+static size_t nds_tree_search_generic(NdsTreeMapPrivate *private, const char *keys, size_t count, const void *key, int upper)
+{
+	size_t low = 0, high = count, middle;
+	int result;
+
+	while (low < high)
+	{
+		middle = low + (high - low) / 2;
+		result = private->compare(keys + middle * private->sizeof_key, key);
+
+		if (result < 0 || (upper && result == 0))
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return low;
+}
+
+
+/*
+ * The numeric keys are compared natively. A node is searched by counting
+ * its keys below the searched one, which has no branch to mispredict and is
+ * vectorized by the compiler, and costs no more than a binary search for
+ * the few cache lines of keys of a node.
+ */
+#define NDS_TREE_NUMERIC_KEY(name, type) \
+	static int nds_tree_compare_##name(const void *first, const void *second) \
+	{ \
+		type a, b; \
+	\
+		memcpy(&a, first, sizeof(a)); \
+		memcpy(&b, second, sizeof(b)); \
+	\
+		return (a > b) - (a < b); \
+	} \
+	\
+	static size_t nds_tree_search_##name(NdsTreeMapPrivate *private, const char *keys, size_t count, const void *key, int upper) \
+	{ \
+		const type *values = (const type*)keys; \
+		size_t i, position = 0; \
+		type target; \
+	\
+		(void)private; \
+		memcpy(&target, key, sizeof(target)); \
+	\
+		if (upper) \
+			for (i = 0; i < count; i++) \
+				position += values[i] <= target; \
+		else \
+			for (i = 0; i < count; i++) \
+				position += values[i] < target; \
+	\
+		return position; \
+	}
+
+NDS_TREE_NUMERIC_KEY(int8, int8_t)
+NDS_TREE_NUMERIC_KEY(uint8, uint8_t)
+NDS_TREE_NUMERIC_KEY(int16, int16_t)
+NDS_TREE_NUMERIC_KEY(uint16, uint16_t)
+NDS_TREE_NUMERIC_KEY(int32, int32_t)
+NDS_TREE_NUMERIC_KEY(uint32, uint32_t)
+NDS_TREE_NUMERIC_KEY(int64, int64_t)
+NDS_TREE_NUMERIC_KEY(uint64, uint64_t)
+NDS_TREE_NUMERIC_KEY(float, float)
+NDS_TREE_NUMERIC_KEY(double, double)
+
+#undef NDS_TREE_NUMERIC_KEY
+
+
+/* the numeric key types, in the order of NdsKeyType */
+static const struct
+{
+	size_t size;
+	NdsCompareFunction compare;
+	NdsTreeSearchFunction search;
+} nds_tree_key_types[] =
+{
+	{ sizeof(int8_t), nds_tree_compare_int8, nds_tree_search_int8 },
+	{ sizeof(uint8_t), nds_tree_compare_uint8, nds_tree_search_uint8 },
+	{ sizeof(int16_t), nds_tree_compare_int16, nds_tree_search_int16 },
+	{ sizeof(uint16_t), nds_tree_compare_uint16, nds_tree_search_uint16 },
+	{ sizeof(int32_t), nds_tree_compare_int32, nds_tree_search_int32 },
+	{ sizeof(uint32_t), nds_tree_compare_uint32, nds_tree_search_uint32 },
+	{ sizeof(int64_t), nds_tree_compare_int64, nds_tree_search_int64 },
+	{ sizeof(uint64_t), nds_tree_compare_uint64, nds_tree_search_uint64 },
+	{ sizeof(float), nds_tree_compare_float, nds_tree_search_float },
+	{ sizeof(double), nds_tree_compare_double, nds_tree_search_double }
+};
+
+
+static inline char* nds_tree_keys(NdsTreeMapPrivate *private, NdsTreeNode *node)
+{
+	return (char*)node + private->keys_offset;
+}
+
+
+static inline char* nds_tree_key(NdsTreeMapPrivate *private, NdsTreeNode *node, size_t index)
+{
+	return (char*)node + private->keys_offset + index * private->sizeof_key;
+}
+
+
+static inline char* nds_tree_value(NdsTreeMapPrivate *private, NdsTreeNode *node, size_t index)
+{
+	return (char*)node + private->values_offset + index * private->sizeof_value;
+}
+
+
+static inline NdsTreeNode** nds_tree_children(NdsTreeMapPrivate *private, NdsTreeNode *node)
+{
+	return (NdsTreeNode**)((char*)node + private->children_offset);
+}
+
+
+static inline size_t nds_tree_search(NdsTreeMapPrivate *private, NdsTreeNode *node, const void *key, int upper)
+{
+	return private->search(private, nds_tree_keys(private, node), node->count, key, upper);
+}
+
+
+/* alignment of an object of the given size: its lowest set bit, capped at NDS_TREE_MAX_ALIGNMENT */
+static size_t nds_tree_alignment(size_t size)
+{
+	size_t alignment = size & (~size + 1);
+
+	return size == 0 ? 1 : alignment > NDS_TREE_MAX_ALIGNMENT ? NDS_TREE_MAX_ALIGNMENT : alignment;
+}
+
+
+static size_t nds_tree_align(size_t size, size_t alignment)
+{
+	return (size + alignment - 1) & ~(alignment - 1);
+}
+
+
+/* makes sure that count nodes can be obtained without calling the allocator */
+static NdsStatus nds_tree_reserve_nodes(NdsTreeMapPrivate *private, size_t count)
+{
+	size_t carved = (size_t)(private->end - private->next_node) / private->sizeof_node, nodes, size;
+	NdsTreeChunk *chunk;
+
+	if (private->free_count + carved >= count)
+		return NDS_OK;
+
+	nodes = count - private->free_count > private->chunk_nodes ? count - private->free_count : private->chunk_nodes;
+	if (nodes > (SIZE_MAX - sizeof(NdsTreeChunk) - NDS_TREE_LINE) / private->sizeof_node)
+		return NDS_MEM_ALLOC_ERROR;
+
+	size = sizeof(NdsTreeChunk) + NDS_TREE_LINE - 1 + nodes * private->sizeof_node;
+	chunk = (NdsTreeChunk*)private->allocator.alloc(private->allocator.context, size);
+	if (!chunk)
+		return NDS_MEM_ALLOC_ERROR;
+
+	chunk->next = private->chunks;
+	chunk->size = size;
+	private->chunks = chunk;
+
+	/* the nodes left in the previous chunk are not lost, they join the free list */
+	for (; private->next_node != private->end; private->next_node += private->sizeof_node)
+	{
+		((NdsTreeNode*)private->next_node)->next = private->free_nodes;
+		private->free_nodes = (NdsTreeNode*)private->next_node;
+		private->free_count++;
+	}
+
+	private->next_node = (char*)(((uintptr_t)(chunk + 1) + NDS_TREE_LINE - 1) & ~(uintptr_t)(NDS_TREE_LINE - 1));
+	private->end = private->next_node + nodes * private->sizeof_node;
+
+	if (private->chunk_nodes < NDS_TREE_MAX_CHUNK)
+		private->chunk_nodes *= 2;
+
+	return NDS_OK;
+}
+
+
+/* returns an empty node, the caller made sure that one is available */
+static NdsTreeNode* nds_tree_node_new(NdsTreeMapPrivate *private, unsigned int leaf)
+{
+	NdsTreeNode *node;
+
+	if (private->free_nodes)
+	{
+		node = private->free_nodes;
+		private->free_nodes = node->next;
+		private->free_count--;
+	}
+	else
+	{
+		node = (NdsTreeNode*)private->next_node;
+		private->next_node += private->sizeof_node;
+	}
+
+	private->used_nodes++;
+
+	node->count = 0;
+	node->leaf = leaf;
+	node->next = NULL;
+	node->prev = NULL;
+
+	return node;
+}
+
+
+static void nds_tree_node_free(NdsTreeMapPrivate *private, NdsTreeNode *node)
+{
+	node->next = private->free_nodes;
+	private->free_nodes = node;
+	private->free_count++;
+	private->used_nodes--;
+}
+
+
+/* releases a subtree into the free list */
+static void nds_tree_free_subtree(NdsTreeMapPrivate *private, NdsTreeNode *node)
+{
+	size_t i;
+
+	if (!node->leaf)
+		for (i = 0; i <= node->count; i++)
+			nds_tree_free_subtree(private, nds_tree_children(private, node)[i]);
+
+	nds_tree_node_free(private, node);
+}
+
+
+/* makes the tree a single empty leaf, a node is available since the tree had at least one */
+static void nds_tree_reset(NdsTreeMapPrivate *private)
+{
+	nds_tree_free_subtree(private, private->root);
+
+	private->root = nds_tree_node_new(private, 1);
+	private->first = private->root;
+	private->size = 0;
+	private->height = 1;
+}
+
+
+/* returns the leaf in which key is or would be */
+static NdsTreeNode* nds_tree_leaf_for(NdsTreeMapPrivate *private, const void *key)
+{
+	NdsTreeNode *node = private->root;
+
+	while (!node->leaf)
+		node = nds_tree_children(private, node)[nds_tree_search(private, node, key, 1)];
+
+	return node;
+}
+
+
+static void nds_tree_leaf_insert(NdsTreeMapPrivate *private, NdsTreeNode *leaf, size_t position, const void *key, const void *value)
+{
+	size_t moved = leaf->count - position;
+
+	memmove(nds_tree_key(private, leaf, position + 1), nds_tree_key(private, leaf, position), moved * private->sizeof_key);
+	memcpy(nds_tree_key(private, leaf, position), key, private->sizeof_key);
+
+	if (private->sizeof_value != 0)
+	{
+		memmove(nds_tree_value(private, leaf, position + 1), nds_tree_value(private, leaf, position), moved * private->sizeof_value);
+		memcpy(nds_tree_value(private, leaf, position), value, private->sizeof_value);
+	}
+
+	leaf->count++;
+}
+
+
+static void nds_tree_inner_insert(NdsTreeMapPrivate *private, NdsTreeNode *node, size_t position, const void *key, NdsTreeNode *child)
+{
+	NdsTreeNode **children = nds_tree_children(private, node);
+	size_t moved = node->count - position;
+
+	memmove(nds_tree_key(private, node, position + 1), nds_tree_key(private, node, position), moved * private->sizeof_key);
+	memcpy(nds_tree_key(private, node, position), key, private->sizeof_key);
+
+	memmove(children + position + 2, children + position + 1, moved * sizeof(NdsTreeNode*));
+	children[position + 1] = child;
+
+	node->count++;
+}
+
+
+/* moves the pairs of a leaf from index on to the end of another leaf */
+static void nds_tree_leaf_move(NdsTreeMapPrivate *private, NdsTreeNode *from, size_t index, NdsTreeNode *to)
+{
+	size_t count = from->count - index;
+
+	memcpy(nds_tree_key(private, to, to->count), nds_tree_key(private, from, index), count * private->sizeof_key);
+	if (private->sizeof_value != 0)
+		memcpy(nds_tree_value(private, to, to->count), nds_tree_value(private, from, index), count * private->sizeof_value);
+
+	to->count += (unsigned int)count;
+	from->count = (unsigned int)index;
+}
+
+
+/*
+ * Splits a full leaf and inserts the pair in the proper half, returns the
+ * new right leaf. A pair appended after the last key of the map starts an
+ * empty leaf instead, so keys inserted in increasing order fill the leaves.
+ */
+static NdsTreeNode* nds_tree_split_leaf(NdsTreeMapPrivate *private, NdsTreeNode *leaf, size_t position, const void *key, const void *value)
+{
+	NdsTreeNode *right = nds_tree_node_new(private, 1);
+	size_t kept = leaf->next == NULL && position == leaf->count ? leaf->count : leaf->count - leaf->count / 2;
+
+	nds_tree_leaf_move(private, leaf, kept, right);
+
+	right->next = leaf->next;
+	right->prev = leaf;
+	if (leaf->next)
+		leaf->next->prev = right;
+	leaf->next = right;
+
+	if (position > kept || kept == private->capacity)
+		nds_tree_leaf_insert(private, right, position - kept, key, value);
+	else
+		nds_tree_leaf_insert(private, leaf, position, key, value);
+
+	return right;
+}
+
+
+/*
+ * Splits a full inner node around its middle key, which is copied to
+ * promoted, and inserts the separator and its right child in the proper
+ * half. Returns the new right node.
+ */
+static NdsTreeNode* nds_tree_split_inner(NdsTreeMapPrivate *private, NdsTreeNode *node, size_t position, const void *key, NdsTreeNode *child, char *promoted)
+{
+	NdsTreeNode *right = nds_tree_node_new(private, 0);
+	size_t middle = private->capacity / 2, count = node->count - middle - 1;
+
+	memcpy(promoted, nds_tree_key(private, node, middle), private->sizeof_key);
+
+	memcpy(nds_tree_keys(private, right), nds_tree_key(private, node, middle + 1), count * private->sizeof_key);
+	memcpy(nds_tree_children(private, right), nds_tree_children(private, node) + middle + 1, (count + 1) * sizeof(NdsTreeNode*));
+	right->count = (unsigned int)count;
+	node->count = (unsigned int)middle;
+
+	if (position <= middle)
+		nds_tree_inner_insert(private, node, position, key, child);
+	else
+		nds_tree_inner_insert(private, right, position - middle - 1, key, child);
+
+	return right;
+}
+
+
+/* merges children[index + 1] of a node into children[index], pulling down the separator between them */
+static void nds_tree_merge(NdsTreeMapPrivate *private, NdsTreeNode *node, size_t index)
+{
+	NdsTreeNode **children = nds_tree_children(private, node);
+	NdsTreeNode *left = children[index], *right = children[index + 1];
+
+	if (left->leaf)
+	{
+		nds_tree_leaf_move(private, right, 0, left);
+
+		left->next = right->next;
+		if (right->next)
+			right->next->prev = left;
+	}
+	else
+	{
+		memcpy(nds_tree_key(private, left, left->count), nds_tree_key(private, node, index), private->sizeof_key);
+		memcpy(nds_tree_key(private, left, left->count + 1), nds_tree_keys(private, right), right->count * private->sizeof_key);
+		memcpy(nds_tree_children(private, left) + left->count + 1, nds_tree_children(private, right), (right->count + 1) * sizeof(NdsTreeNode*));
+		left->count += right->count + 1;
+	}
+
+	memmove(nds_tree_key(private, node, index), nds_tree_key(private, node, index + 1), (node->count - index - 1) * private->sizeof_key);
+	memmove(children + index + 1, children + index + 2, (node->count - index - 1) * sizeof(NdsTreeNode*));
+	node->count--;
+
+	nds_tree_node_free(private, right);
+}
+
+
+/* moves the last key of children[index - 1] of a node to the front of children[index] */
+static void nds_tree_borrow_left(NdsTreeMapPrivate *private, NdsTreeNode *node, size_t index)
+{
+	NdsTreeNode **children = nds_tree_children(private, node);
+	NdsTreeNode *left = children[index - 1], *child = children[index];
+
+	memmove(nds_tree_key(private, child, 1), nds_tree_keys(private, child), child->count * private->sizeof_key);
+
+	if (child->leaf)
+	{
+		memcpy(nds_tree_keys(private, child), nds_tree_key(private, left, left->count - 1), private->sizeof_key);
+		if (private->sizeof_value != 0)
+		{
+			memmove(nds_tree_value(private, child, 1), nds_tree_value(private, child, 0), child->count * private->sizeof_value);
+			memcpy(nds_tree_value(private, child, 0), nds_tree_value(private, left, left->count - 1), private->sizeof_value);
+		}
+
+		memcpy(nds_tree_key(private, node, index - 1), nds_tree_keys(private, child), private->sizeof_key);
+	}
+	else
+	{
+		memmove(nds_tree_children(private, child) + 1, nds_tree_children(private, child), (child->count + 1) * sizeof(NdsTreeNode*));
+		nds_tree_children(private, child)[0] = nds_tree_children(private, left)[left->count];
+
+		memcpy(nds_tree_keys(private, child), nds_tree_key(private, node, index - 1), private->sizeof_key);
+		memcpy(nds_tree_key(private, node, index - 1), nds_tree_key(private, left, left->count - 1), private->sizeof_key);
+	}
+
+	left->count--;
+	child->count++;
+}
+
+
+/* moves the first key of children[index + 1] of a node to the end of children[index] */
+static void nds_tree_borrow_right(NdsTreeMapPrivate *private, NdsTreeNode *node, size_t index)
+{
+	NdsTreeNode **children = nds_tree_children(private, node);
+	NdsTreeNode *child = children[index], *right = children[index + 1];
+
+	if (child->leaf)
+	{
+		memcpy(nds_tree_key(private, child, child->count), nds_tree_keys(private, right), private->sizeof_key);
+		if (private->sizeof_value != 0)
+		{
+			memcpy(nds_tree_value(private, child, child->count), nds_tree_value(private, right, 0), private->sizeof_value);
+			memmove(nds_tree_value(private, right, 0), nds_tree_value(private, right, 1), (right->count - 1) * private->sizeof_value);
+		}
+
+		memmove(nds_tree_keys(private, right), nds_tree_key(private, right, 1), (right->count - 1) * private->sizeof_key);
+		memcpy(nds_tree_key(private, node, index), nds_tree_keys(private, right), private->sizeof_key);
+	}
+	else
+	{
+		memcpy(nds_tree_key(private, child, child->count), nds_tree_key(private, node, index), private->sizeof_key);
+		nds_tree_children(private, child)[child->count + 1] = nds_tree_children(private, right)[0];
+
+		memcpy(nds_tree_key(private, node, index), nds_tree_keys(private, right), private->sizeof_key);
+		memmove(nds_tree_keys(private, right), nds_tree_key(private, right, 1), (right->count - 1) * private->sizeof_key);
+		memmove(nds_tree_children(private, right), nds_tree_children(private, right) + 1, right->count * sizeof(NdsTreeNode*));
+	}
+
+	right->count--;
+	child->count++;
+}
+
+
+/* points an iterator to a pair, skipping to the next leaf when index is past the end of node */
+static int nds_tree_iterator_set(NdsTreeMapPrivate *private, NdsTreeMapIterator *iterator, NdsTreeNode *node, size_t index)
+{
+	while (node && index >= node->count)
+	{
+		node = node->next;
+		index = 0;
+	}
+
+	iterator->map = private;
+	iterator->node = node;
+	iterator->index = index;
+
+	if (!node)
+	{
+		iterator->key = NULL;
+		iterator->value = NULL;
+
+		return 0;
+	}
+
+	iterator->key = nds_tree_key(private, node, index);
+	iterator->value = nds_tree_value(private, node, index);
+
+	return 1;
+}
+
+
+static NdsTreeMap* nds_tree_map_create(size_t sizeof_key, size_t sizeof_value, NdsCompareFunction compare, NdsTreeSearchFunction search, const NdsAllocator *allocator)
+{
+	struct NdsTreeMapBlock *block;
+	NdsTreeMapPrivate *private;
+	size_t capacity, leaf_size, inner_size;
+
+	/* sanity checks */
+	if (sizeof_key == 0 || compare == NULL || allocator == NULL)
+		return NULL;
+
+	if (allocator->alloc == NULL || allocator->free == NULL)
+		return NULL;
+
+	if (sizeof_key > SIZE_MAX / (4 * NDS_TREE_MAX_KEYS) || sizeof_value > SIZE_MAX / (4 * NDS_TREE_MAX_KEYS))
+		return NULL;
+
+	/* we allocate memory for the structure and the private part of the NdsTreeMap */
+	block = (struct NdsTreeMapBlock*)allocator->alloc(allocator->context, NDS_TREE_BLOCK_SIZE + 2 * sizeof_key);
+	if (!block)
+		return NULL;
+
+	block->map.private = &block->private;
+	private = &block->private;
+
+	capacity = NDS_TREE_KEY_BYTES / sizeof_key;
+	capacity = capacity < NDS_TREE_MIN_KEYS ? NDS_TREE_MIN_KEYS : capacity > NDS_TREE_MAX_KEYS ? NDS_TREE_MAX_KEYS : capacity;
+
+	private->sizeof_key = sizeof_key;
+	private->sizeof_value = sizeof_value;
+	private->capacity = capacity;
+	private->minimum = capacity / 2;
+
+	/* the keys follow the header, then come the values of a leaf or the children of an inner node */
+	private->keys_offset = nds_tree_align(sizeof(NdsTreeNode), nds_tree_alignment(sizeof_key));
+	private->values_offset = nds_tree_align(private->keys_offset + capacity * sizeof_key, nds_tree_alignment(sizeof_value));
+	private->children_offset = nds_tree_align(private->keys_offset + capacity * sizeof_key, sizeof(NdsTreeNode*));
+
+	leaf_size = private->values_offset + capacity * sizeof_value;
+	inner_size = private->children_offset + (capacity + 1) * sizeof(NdsTreeNode*);
+	private->sizeof_node = nds_tree_align(leaf_size > inner_size ? leaf_size : inner_size, NDS_TREE_LINE);
+
+	private->compare = compare;
+	private->search = search;
+	private->scratch = (char*)block + NDS_TREE_BLOCK_SIZE;
+
+	private->free_nodes = NULL;
+	private->free_count = 0;
+	private->used_nodes = 0;
+	private->chunks = NULL;
+	private->next_node = NULL;
+	private->end = NULL;
+	private->chunk_nodes = NDS_TREE_MIN_CHUNK;
+	private->allocator = *allocator;
+
+	if (nds_tree_reserve_nodes(private, 1) != NDS_OK)
+	{
+		/* cleanup */
+		allocator->free(allocator->context, block, NDS_TREE_BLOCK_SIZE + 2 * sizeof_key);
+
+		return NULL;
+	}
+
+	private->root = nds_tree_node_new(private, 1);
+	private->first = private->root;
+	private->size = 0;
+	private->height = 1;
+
+	return &block->map;
+}
+
+
+NdsTreeMap* nds_tree_map_new(size_t sizeof_key, size_t sizeof_value, NdsCompareFunction compare)
+{
+	return nds_tree_map_new_with_allocator(sizeof_key, sizeof_value, compare, nds_allocator_default());
+}
+
+
+NdsTreeMap* nds_tree_map_new_with_allocator(size_t sizeof_key, size_t sizeof_value, NdsCompareFunction compare, const NdsAllocator *allocator)
+{
+	return nds_tree_map_create(sizeof_key, sizeof_value, compare, nds_tree_search_generic, allocator);
+}
+
+
+NdsTreeMap* nds_tree_map_new_with_key_type(NdsKeyType key_type, size_t sizeof_value, const NdsAllocator *allocator)
+{
+	/* sanity checks */
+	if ((size_t)key_type >= sizeof(nds_tree_key_types) / sizeof(nds_tree_key_types[0]))
+		return NULL;
+
+	return nds_tree_map_create(nds_tree_key_types[key_type].size, sizeof_value, nds_tree_key_types[key_type].compare, nds_tree_key_types[key_type].search,
+		allocator);
+}
+
+
+void nds_tree_map_destroy(NdsTreeMap *map)
+{
+	NdsAllocator allocator;
+	NdsTreeChunk *chunk, *next;
+	size_t size;
+
+	/* sanity checks */
+	if (map == NULL || map->private == NULL)
+		return;
+
+	/* the allocator lives inside the block that is released last, so we keep a copy of it */
+	allocator = map->private->allocator;
+	size = NDS_TREE_BLOCK_SIZE + 2 * map->private->sizeof_key;
+
+	for (chunk = map->private->chunks; chunk != NULL; chunk = next)
+	{
+		next = chunk->next;
+		allocator.free(allocator.context, chunk, chunk->size);
+	}
+
+	map->private = NULL;
+
+	allocator.free(allocator.context, map, size);
+	map = NULL;
+}
+
+
+ssize_t nds_tree_map_size(NdsTreeMap *map)
+{
+	/* sanity checks */
+	if (map == NULL || map->private == NULL)
+		return -1;
+
+	return (ssize_t)map->private->size;
+}
+
+
+NdsStatus nds_tree_map_bulk_load(NdsTreeMap *map, NdsVector *vector, size_t value_offset)
+{
+	NdsTreeMapPrivate *private;
+	NdsTreeNode *node, *level, *previous, *child, *next, *descendant;
+	size_t record, count, leaves, nodes, groups, length, i, j, k;
+	const char *records;
+	ssize_t size;
+
+	/* sanity checks */
+	if (map == NULL || map->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = map->private;
+
+	size = nds_vector_size(vector);
+	if (size < 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+	count = (size_t)size;
+	records = (const char*)nds_vector_data(vector);
+	record = vector->private->sizeof_element;
+
+	if (record < private->sizeof_key || (private->sizeof_value != 0 && (value_offset > record || record - value_offset < private->sizeof_value)))
+		return NDS_INVALID_PARAM_ERROR;
+
+	for (i = 1; i < count; i++)
+		if (private->compare(records + (i - 1) * record, records + i * record) >= 0)
+			return NDS_INVALID_PARAM_ERROR;
+
+	/* every level is as full as possible, the last nodes of a level only get fewer keys when there is a remainder */
+	leaves = count == 0 ? 1 : (count + private->capacity - 1) / private->capacity;
+	for (nodes = leaves, length = leaves; length > 1; nodes += length)
+		length = (length + private->capacity) / (private->capacity + 1);
+
+	/* the nodes of the current tree are reused, the missing ones come from a single chunk */
+	if (nds_tree_reserve_nodes(private, nodes > private->used_nodes ? nodes - private->used_nodes : 0) != NDS_OK)
+		return NDS_MEM_ALLOC_ERROR;
+
+	nds_tree_free_subtree(private, private->root);
+
+	/* the leaves hold the pairs in order */
+	level = NULL;
+	previous = NULL;
+
+	for (i = 0, k = 0; i < leaves; i++)
+	{
+		node = nds_tree_node_new(private, 1);
+		length = count / leaves + (i < count % leaves);
+
+		for (j = 0; j < length; j++, k++)
+		{
+			memcpy(nds_tree_key(private, node, j), records + k * record, private->sizeof_key);
+			if (private->sizeof_value != 0)
+				memcpy(nds_tree_value(private, node, j), records + k * record + value_offset, private->sizeof_value);
+		}
+
+		node->count = (unsigned int)length;
+		node->prev = previous;
+
+		if (previous)
+			previous->next = node;
+		else
+			level = node;
+
+		previous = node;
+	}
+
+	private->first = level;
+	private->height = 1;
+
+	/* every inner level is built from the one below, whose nodes are linked through next while the tree is built */
+	for (length = leaves; length > 1; length = groups)
+	{
+		groups = (length + private->capacity) / (private->capacity + 1);
+		child = level;
+		level = NULL;
+		previous = NULL;
+
+		for (i = 0; i < groups; i++)
+		{
+			node = nds_tree_node_new(private, 0);
+			k = length / groups + (i < length % groups);
+
+			for (j = 0; j < k; j++)
+			{
+				nds_tree_children(private, node)[j] = child;
+
+				/* the separator of a child is the smallest key under it */
+				if (j > 0)
+				{
+					for (descendant = child; !descendant->leaf; descendant = nds_tree_children(private, descendant)[0])
+						;
+					memcpy(nds_tree_key(private, node, j - 1), nds_tree_keys(private, descendant), private->sizeof_key);
+				}
+
+				next = child->next;
+				if (!child->leaf)
+					child->next = NULL;
+				child = next;
+			}
+
+			node->count = (unsigned int)(k - 1);
+
+			if (previous)
+				previous->next = node;
+			else
+				level = node;
+
+			previous = node;
+		}
+
+		private->height++;
+	}
+
+	private->root = level;
+	private->size = count;
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_tree_map_insert(NdsTreeMap *map, const void *key, const void *value)
+{
+	NdsTreeNode *path[NDS_TREE_MAX_HEIGHT], *node, *child, *root;
+	size_t positions[NDS_TREE_MAX_HEIGHT], depth = 0, position;
+	NdsTreeMapPrivate *private;
+	const char *separator;
+	char *promoted;
+
+	/* sanity checks */
+	if (map == NULL || map->private == NULL || key == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = map->private;
+
+	if (value == NULL && private->sizeof_value != 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+	for (node = private->root; !node->leaf; node = nds_tree_children(private, node)[position])
+	{
+		position = nds_tree_search(private, node, key, 1);
+		path[depth] = node;
+		positions[depth++] = position;
+	}
+
+	/* an existing key gets its value overwritten */
+	position = nds_tree_search(private, node, key, 0);
+	if (position < node->count && private->compare(nds_tree_key(private, node, position), key) == 0)
+	{
+		if (private->sizeof_value != 0)
+			memcpy(nds_tree_value(private, node, position), value, private->sizeof_value);
+
+		return NDS_OK;
+	}
+
+	if (node->count < private->capacity)
+	{
+		nds_tree_leaf_insert(private, node, position, key, value);
+		private->size++;
+
+		return NDS_OK;
+	}
+
+	/* a split may go up to the root and add a new one, so the nodes are obtained before the tree is changed */
+	if (depth + 2 > NDS_TREE_MAX_HEIGHT || nds_tree_reserve_nodes(private, depth + 2) != NDS_OK)
+		return NDS_MEM_ALLOC_ERROR;
+
+	child = nds_tree_split_leaf(private, node, position, key, value);
+	separator = nds_tree_keys(private, child);
+	promoted = private->scratch;
+
+	while (depth > 0)
+	{
+		node = path[--depth];
+		position = positions[depth];
+
+		if (node->count < private->capacity)
+		{
+			nds_tree_inner_insert(private, node, position, separator, child);
+			private->size++;
+
+			return NDS_OK;
+		}
+
+		/* the separator may be in one of the scratch keys, the key promoted by this split goes to the other one */
+		child = nds_tree_split_inner(private, node, position, separator, child, promoted);
+		separator = promoted;
+		promoted = promoted == private->scratch ? private->scratch + private->sizeof_key : private->scratch;
+	}
+
+	root = nds_tree_node_new(private, 0);
+	memcpy(nds_tree_keys(private, root), separator, private->sizeof_key);
+	nds_tree_children(private, root)[0] = private->root;
+	nds_tree_children(private, root)[1] = child;
+	root->count = 1;
+
+	private->root = root;
+	private->height++;
+	private->size++;
+
+	return NDS_OK;
+}
+
+
+void* nds_tree_map_find(NdsTreeMap *map, const void *key)
+{
+	NdsTreeMapPrivate *private;
+	NdsTreeNode *leaf;
+	size_t position;
+
+	/* sanity checks */
+	if (map == NULL || map->private == NULL || key == NULL)
+		return NULL;
+
+	private = map->private;
+
+	leaf = nds_tree_leaf_for(private, key);
+	position = nds_tree_search(private, leaf, key, 0);
+
+	if (position == leaf->count || private->compare(nds_tree_key(private, leaf, position), key) != 0)
+		return NULL;
+
+	return nds_tree_value(private, leaf, position);
+}
+
+
+NdsStatus nds_tree_map_get(NdsTreeMap *map, const void *key, void *value)
+{
+	void *source;
+
+	/* sanity checks */
+	if (value == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	source = nds_tree_map_find(map, key);
+	if (!source)
+		return NDS_INVALID_PARAM_ERROR;
+
+	memcpy(value, source, map->private->sizeof_value);
+
+	return NDS_OK;
+}
+
+
+int nds_tree_map_contains(NdsTreeMap *map, const void *key)
+{
+	/* sanity checks */
+	if (map == NULL || map->private == NULL || key == NULL)
+		return -1;
+
+	return nds_tree_map_find(map, key) != NULL;
+}
+
+
+NdsStatus nds_tree_map_remove(NdsTreeMap *map, const void *key, void *value)
+{
+	NdsTreeNode *path[NDS_TREE_MAX_HEIGHT], *node, *parent, **children;
+	size_t positions[NDS_TREE_MAX_HEIGHT], depth = 0, position;
+	NdsTreeMapPrivate *private;
+
+	/* sanity checks */
+	if (map == NULL || map->private == NULL || key == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = map->private;
+
+	for (node = private->root; !node->leaf; node = nds_tree_children(private, node)[position])
+	{
+		position = nds_tree_search(private, node, key, 1);
+		path[depth] = node;
+		positions[depth++] = position;
+	}
+
+	position = nds_tree_search(private, node, key, 0);
+	if (position == node->count || private->compare(nds_tree_key(private, node, position), key) != 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+	if (value && private->sizeof_value != 0)
+		memcpy(value, nds_tree_value(private, node, position), private->sizeof_value);
+
+	memmove(nds_tree_key(private, node, position), nds_tree_key(private, node, position + 1), (node->count - position - 1) * private->sizeof_key);
+	if (private->sizeof_value != 0)
+		memmove(nds_tree_value(private, node, position), nds_tree_value(private, node, position + 1), (node->count - position - 1) * private->sizeof_value);
+
+	node->count--;
+	private->size--;
+
+	/* a node that falls below the minimum borrows a key from a sibling, or is merged with one and the parent loses a key */
+	while (depth > 0 && node->count < private->minimum)
+	{
+		parent = path[--depth];
+		position = positions[depth];
+		children = nds_tree_children(private, parent);
+
+		if (position > 0 && children[position - 1]->count > private->minimum)
+		{
+			nds_tree_borrow_left(private, parent, position);
+			break;
+		}
+
+		if (position < parent->count && children[position + 1]->count > private->minimum)
+		{
+			nds_tree_borrow_right(private, parent, position);
+			break;
+		}
+
+		nds_tree_merge(private, parent, position > 0 ? position - 1 : position);
+		node = parent;
+	}
+
+	/* a root left with a single child is replaced by it */
+	if (!private->root->leaf && private->root->count == 0)
+	{
+		node = private->root;
+		private->root = nds_tree_children(private, node)[0];
+		private->height--;
+
+		nds_tree_node_free(private, node);
+	}
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_tree_map_clear(NdsTreeMap *map)
+{
+	/* sanity checks */
+	if (map == NULL || map->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	nds_tree_reset(map->private);
+
+	return NDS_OK;
+}
+
+
+int nds_tree_map_first(NdsTreeMap *map, NdsTreeMapIterator *iterator)
+{
+	/* sanity checks */
+	if (map == NULL || map->private == NULL || iterator == NULL)
+		return -1;
+
+	return nds_tree_iterator_set(map->private, iterator, map->private->first, 0);
+}
+
+
+int nds_tree_map_lower_bound(NdsTreeMap *map, const void *key, NdsTreeMapIterator *iterator)
+{
+	NdsTreeNode *leaf;
+
+	/* sanity checks */
+	if (map == NULL || map->private == NULL || key == NULL || iterator == NULL)
+		return -1;
+
+	leaf = nds_tree_leaf_for(map->private, key);
+
+	return nds_tree_iterator_set(map->private, iterator, leaf, nds_tree_search(map->private, leaf, key, 0));
+}
+
+
+int nds_tree_map_upper_bound(NdsTreeMap *map, const void *key, NdsTreeMapIterator *iterator)
+{
+	NdsTreeNode *leaf;
+
+	/* sanity checks */
+	if (map == NULL || map->private == NULL || key == NULL || iterator == NULL)
+		return -1;
+
+	leaf = nds_tree_leaf_for(map->private, key);
+
+	return nds_tree_iterator_set(map->private, iterator, leaf, nds_tree_search(map->private, leaf, key, 1));
+}
+
+
+int nds_tree_map_iterator_next(NdsTreeMapIterator *iterator)
+{
+	/* sanity checks */
+	if (iterator == NULL || iterator->map == NULL || iterator->node == NULL)
+		return -1;
+
+	return nds_tree_iterator_set(iterator->map, iterator, (NdsTreeNode*)iterator->node, iterator->index + 1);
+}
+
+
+ssize_t nds_tree_map_range(NdsTreeMap *map, const void *low, const void *high, NdsEntryFunction function, void *context)
+{
+	NdsTreeMapPrivate *private;
+	NdsTreeNode *leaf;
+	size_t index, end, visited = 0;
+	int last = 0;
+
+	/* sanity checks */
+	if (map == NULL || map->private == NULL || function == NULL)
+		return -1;
+
+	private = map->private;
+
+	if (low)
+	{
+		leaf = nds_tree_leaf_for(private, low);
+		index = nds_tree_search(private, leaf, low, 0);
+	}
+	else
+	{
+		leaf = private->first;
+		index = 0;
+	}
+
+	for (; leaf && !last; leaf = leaf->next, index = 0)
+	{
+		/* the next leaf is fetched while this one is visited */
+		__builtin_prefetch(leaf->next);
+
+		end = leaf->count;
+		if (high && end > 0 && private->compare(nds_tree_key(private, leaf, end - 1), high) >= 0)
+		{
+			end = nds_tree_search(private, leaf, high, 0);
+			last = 1;
+		}
+
+		for (; index < end; index++, visited++)
+			function(nds_tree_key(private, leaf, index), nds_tree_value(private, leaf, index), context);
+	}
+
+	return (ssize_t)visited;
+}
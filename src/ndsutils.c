@@ -0,0 +1,466 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains various utilities needed by the NDS library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include <nds/ndsutils.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* every block handed out by the arena and the pool is aligned for any element type */
+#define NDS_ALIGNMENT 16
+#define NDS_ALIGN(size) (((size) + NDS_ALIGNMENT - 1) & ~(size_t)(NDS_ALIGNMENT - 1))
+
+
+static void* nds_default_alloc(void *context, size_t size)
+{
+	(void)context;
+
+	return malloc(size);
+}
+
+
+static void* nds_default_realloc(void *context, void *pointer, size_t old_size, size_t new_size)
+{
+	(void)context;
+	(void)old_size;
+
+	return realloc(pointer, new_size);
+}
+
+
+static void nds_default_free(void *context, void *pointer, size_t size)
+{
+	(void)context;
+	(void)size;
+
+	free(pointer);
+}
+
+
+static const NdsAllocator nds_default_allocator = {nds_default_alloc, nds_default_realloc, nds_default_free, NULL};
+
+
+const NdsAllocator* nds_allocator_default(void)
+{
+	return &nds_default_allocator;
+}
+
+
+uint64_t nds_hash_bytes(const void *data, size_t size)
+{
+	const unsigned char *bytes = (const unsigned char*)data;
+	uint64_t hash = 0x9e3779b97f4a7c15ULL ^ size, chunk;
+
+	/* whole 8-byte chunks are folded in with a mix each, the tail is padded with zeros */
+	for (; size >= sizeof(chunk); size -= sizeof(chunk), bytes += sizeof(chunk))
+	{
+		memcpy(&chunk, bytes, sizeof(chunk));
+		hash = nds_hash_mix(hash ^ chunk) * 0x9e3779b97f4a7c15ULL;
+	}
+
+	if (size > 0)
+	{
+		chunk = 0;
+		memcpy(&chunk, bytes, size);
+		hash = nds_hash_mix(hash ^ chunk) * 0x9e3779b97f4a7c15ULL;
+	}
+
+	return nds_hash_mix(hash);
+}
+
+
+struct NdsArenaChunk
+{
+	struct NdsArenaChunk *next;
+
+	/* number of bytes that can be allocated from the chunk */
+	size_t size;
+};
+
+/* the memory of a chunk follows its header */
+#define NDS_ARENA_CHUNK_OFFSET NDS_ALIGN(sizeof(struct NdsArenaChunk))
+
+/* largest request that can be aligned and prefixed with a chunk header without wrapping around */
+#define NDS_ARENA_MAX_SIZE (SIZE_MAX - NDS_ALIGNMENT - NDS_ARENA_CHUNK_OFFSET)
+
+
+struct NdsArenaPrivate
+{
+	/* chunks are kept in a list that is reused after every reset */
+	struct NdsArenaChunk *first;
+	struct NdsArenaChunk *current;
+
+	/* number of bytes already allocated from the current chunk */
+	size_t offset;
+
+	/* offset of the last allocated block, which can still grow or be released in place */
+	size_t last_offset;
+	void *last;
+
+	size_t chunk_size;
+};
+
+typedef struct NdsArenaPrivate NdsArenaPrivate;
+
+
+/* the handle and the private part of a NdsArena are allocated as a single block */
+struct NdsArenaBlock
+{
+	NdsArena arena;
+	NdsArenaPrivate private;
+};
+
+
+static struct NdsArenaChunk* nds_arena_new_chunk(size_t size)
+{
+	struct NdsArenaChunk *chunk;
+
+	chunk = (struct NdsArenaChunk*)malloc(NDS_ARENA_CHUNK_OFFSET + size);
+	if (!chunk)
+		return NULL;
+
+	chunk->next = NULL;
+	chunk->size = size;
+
+	return chunk;
+}
+
+
+static void* nds_arena_alloc(void *context, size_t size)
+{
+	NdsArenaPrivate *private = (NdsArenaPrivate*)context;
+	struct NdsArenaChunk *chunk;
+
+	/* sanity checks */
+	if (private == NULL || size > NDS_ARENA_MAX_SIZE)
+		return NULL;
+
+	size = NDS_ALIGN(size);
+
+	/* when the current chunk is full, we move to the next retained chunk or insert a new one */
+	if (size > private->current->size - private->offset)
+	{
+		chunk = private->current->next;
+		if (chunk == NULL || chunk->size < size)
+		{
+			chunk = nds_arena_new_chunk(size > private->chunk_size ? size : private->chunk_size);
+			if (!chunk)
+				return NULL;
+
+			chunk->next = private->current->next;
+			private->current->next = chunk;
+		}
+
+		private->current = chunk;
+		private->offset = 0;
+	}
+
+	private->last = (char*)private->current + NDS_ARENA_CHUNK_OFFSET + private->offset;
+	private->last_offset = private->offset;
+	private->offset += size;
+
+	return private->last;
+}
+
+
+static void* nds_arena_realloc(void *context, void *pointer, size_t old_size, size_t new_size)
+{
+	NdsArenaPrivate *private = (NdsArenaPrivate*)context;
+	void *block;
+
+	/* sanity checks */
+	if (private == NULL || new_size > NDS_ARENA_MAX_SIZE)
+		return NULL;
+
+	/* the last block grows or shrinks in place while it fits into the current chunk */
+	if (pointer != NULL && pointer == private->last && NDS_ALIGN(new_size) <= private->current->size - private->last_offset)
+	{
+		private->offset = private->last_offset + NDS_ALIGN(new_size);
+		return pointer;
+	}
+
+	block = nds_arena_alloc(context, new_size);
+	if (block && pointer)
+		memcpy(block, pointer, old_size < new_size ? old_size : new_size);
+
+	return block;
+}
+
+
+static void nds_arena_free(void *context, void *pointer, size_t size)
+{
+	NdsArenaPrivate *private = (NdsArenaPrivate*)context;
+
+	(void)size;
+
+	if (private == NULL)
+		return;
+
+	/* only the last block can be given back, all others are released by a reset */
+	if (pointer != NULL && pointer == private->last)
+	{
+		private->offset = private->last_offset;
+		private->last = NULL;
+	}
+}
+
+
+NdsArena* nds_arena_new(size_t chunk_size)
+{
+	struct NdsArenaBlock *block;
+
+	/* sanity checks */
+	if (chunk_size == 0 || chunk_size > NDS_ARENA_MAX_SIZE)
+		return NULL;
+
+	block = (struct NdsArenaBlock*)malloc(sizeof(struct NdsArenaBlock));
+	if (!block)
+		return NULL;
+
+	block->private.first = nds_arena_new_chunk(NDS_ALIGN(chunk_size));
+	if (!block->private.first)
+	{
+		/* cleanup */
+		free(block);
+
+		return NULL;
+	}
+
+	/* various initializations */
+	block->arena.private = &block->private;
+	block->private.current = block->private.first;
+	block->private.offset = 0;
+	block->private.last_offset = 0;
+	block->private.last = NULL;
+	block->private.chunk_size = NDS_ALIGN(chunk_size);
+
+	return &block->arena;
+}
+
+
+void nds_arena_destroy(NdsArena *arena)
+{
+	struct NdsArenaChunk *chunk, *next;
+
+	/* sanity checks */
+	if (arena == NULL || arena->private == NULL)
+		return;
+
+	for (chunk = arena->private->first; chunk != NULL; chunk = next)
+	{
+		next = chunk->next;
+		free(chunk);
+	}
+
+	arena->private = NULL;
+
+	free(arena);
+	arena = NULL;
+}
+
+
+NdsStatus nds_arena_reset(NdsArena *arena)
+{
+	/* sanity checks */
+	if (arena == NULL || arena->private == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	arena->private->current = arena->private->first;
+	arena->private->offset = 0;
+	arena->private->last = NULL;
+
+	return NDS_OK;
+}
+
+
+NdsAllocator nds_arena_allocator(NdsArena *arena)
+{
+	NdsAllocator allocator = {nds_arena_alloc, nds_arena_realloc, nds_arena_free, NULL};
+
+	if (arena != NULL)
+		allocator.context = arena->private;
+
+	return allocator;
+}
+
+
+struct NdsPoolPrivate
+{
+	/* released blocks, linked through their first word */
+	void *free_list;
+
+	/* chunks requested from the system, linked through their first word */
+	void *chunks;
+
+	/* blocks of the newest chunk that were never handed out */
+	char *next_block;
+	char *end;
+
+	size_t block_size;
+	size_t blocks_per_chunk;
+};
+
+typedef struct NdsPoolPrivate NdsPoolPrivate;
+
+
+/* the handle and the private part of a NdsPool are allocated as a single block */
+struct NdsPoolBlock
+{
+	NdsPool pool;
+	NdsPoolPrivate private;
+};
+
+
+static void* nds_pool_alloc(void *context, size_t size)
+{
+	NdsPoolPrivate *private = (NdsPoolPrivate*)context;
+	void *block;
+	char *chunk;
+
+	/* sanity checks */
+	if (private == NULL || size > private->block_size)
+		return NULL;
+
+	/* released blocks are reused first */
+	if (private->free_list != NULL)
+	{
+		block = private->free_list;
+		private->free_list = *(void**)block;
+
+		return block;
+	}
+
+	if (private->next_block == private->end)
+	{
+		chunk = (char*)malloc(NDS_ALIGNMENT + private->block_size * private->blocks_per_chunk);
+		if (!chunk)
+			return NULL;
+
+		*(void**)chunk = private->chunks;
+		private->chunks = chunk;
+
+		private->next_block = chunk + NDS_ALIGNMENT;
+		private->end = private->next_block + private->block_size * private->blocks_per_chunk;
+	}
+
+	block = private->next_block;
+	private->next_block += private->block_size;
+
+	return block;
+}
+
+
+static void* nds_pool_realloc(void *context, void *pointer, size_t old_size, size_t new_size)
+{
+	NdsPoolPrivate *private = (NdsPoolPrivate*)context;
+
+	(void)old_size;
+
+	if (private == NULL || pointer == NULL)
+		return nds_pool_alloc(context, new_size);
+
+	/* every block already has the maximum size the pool can offer */
+	return new_size <= private->block_size ? pointer : NULL;
+}
+
+
+static void nds_pool_free(void *context, void *pointer, size_t size)
+{
+	NdsPoolPrivate *private = (NdsPoolPrivate*)context;
+
+	(void)size;
+
+	if (private == NULL || pointer == NULL)
+		return;
+
+	*(void**)pointer = private->free_list;
+	private->free_list = pointer;
+}
+
+
+NdsPool* nds_pool_new(size_t block_size, size_t blocks_per_chunk)
+{
+	struct NdsPoolBlock *block;
+
+	/* sanity checks */
+	if (block_size == 0 || blocks_per_chunk == 0)
+		return NULL;
+
+	/* a whole chunk, with its alignment prefix, must be representable */
+	if (block_size > SIZE_MAX - NDS_ALIGNMENT || NDS_ALIGN(block_size) > (SIZE_MAX - NDS_ALIGNMENT) / blocks_per_chunk)
+		return NULL;
+
+	block = (struct NdsPoolBlock*)malloc(sizeof(struct NdsPoolBlock));
+	if (!block)
+		return NULL;
+
+	/* various initializations */
+	block->pool.private = &block->private;
+	block->private.free_list = NULL;
+	block->private.chunks = NULL;
+	block->private.next_block = NULL;
+	block->private.end = NULL;
+	block->private.block_size = NDS_ALIGN(block_size);
+	block->private.blocks_per_chunk = blocks_per_chunk;
+
+	return &block->pool;
+}
+
+
+void nds_pool_destroy(NdsPool *pool)
+{
+	void *chunk, *next;
+
+	/* sanity checks */
+	if (pool == NULL || pool->private == NULL)
+		return;
+
+	for (chunk = pool->private->chunks; chunk != NULL; chunk = next)
+	{
+		next = *(void**)chunk;
+		free(chunk);
+	}
+
+	pool->private = NULL;
+
+	free(pool);
+	pool = NULL;
+}
+
+
+NdsAllocator nds_pool_allocator(NdsPool *pool)
+{
+	NdsAllocator allocator = {nds_pool_alloc, nds_pool_realloc, nds_pool_free, NULL};
+
+	if (pool != NULL)
+		allocator.context = pool->private;
+
+	return allocator;
+}
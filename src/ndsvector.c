@@ -25,26 +25,406 @@
  *
  * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
  * @created     13 July 2017
- * @modified    23 February 2018
+ * @modified    17 October 2026
  */
 
+/* mremap() is a GNU extension */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <nds/ndsvector.h>
+#include <nds/ndsvectorinline.h>
 
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define NDS_VECTOR_HAS_MMAP
+#endif
+
 
-struct NdsVectorPrivate
+/* the handle and the private part of a NdsVector are allocated as a single block */
+struct NdsVectorBlock
 {
-	char *elements;
-	size_t sizeof_element;
+	NdsVector vector;
+	NdsVectorPrivate private;
+};
 
-	/* current size and capacity of the vector */
-	size_t size;
-	size_t capacity;
+/* the inline buffer of a small vector follows the block, aligned for any element type */
+#define NDS_VECTOR_INLINE_OFFSET ((sizeof(struct NdsVectorBlock) + 15) & ~(size_t)15)
+
+/* size of the allocation that holds the handle, the private part and the inline buffer */
+#define NDS_VECTOR_BLOCK_SIZE(sizeof_element, inline_capacity) (NDS_VECTOR_INLINE_OFFSET + (inline_capacity) * (sizeof_element))
+
+
+/* header of a NdsVector snapshot file, the elements follow it (see nds_vector_save()) */
+struct NdsVectorFileHeader
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	uint64_t header_size;
+	uint64_t sizeof_element;
+	uint64_t size;
+	uint64_t checksum;
+	uint64_t reserved[2];
 };
 
-typedef struct NdsVectorPrivate NdsVectorPrivate;
+#define NDS_VECTOR_FILE_MAGIC "NDSVECT"
+#define NDS_VECTOR_FILE_VERSION 1
+#define NDS_VECTOR_FILE_BYTE_ORDER 0x01020304
+
+/* size in bytes of the block that nds_vector_resize_fill() replicates the value into */
+#define NDS_VECTOR_FILL_BLOCK 4096
+
+
+#ifdef NDS_ENABLE_STATS
+/* process-wide totals, updated with atomic operations since vectors are used from many threads */
+static size_t nds_stats_live_vectors = 0;
+static size_t nds_stats_live_bytes = 0;
+static size_t nds_stats_wasted_bytes = 0;
+
+
+/* replaces what the vector adds to the process-wide totals with its current capacity and slack */
+void nds_vector_stats_account(NdsVectorPrivate *private)
+{
+	size_t bytes = private->capacity * private->sizeof_element;
+	size_t waste = private->size < private->capacity ? (private->capacity - private->size) * private->sizeof_element : 0;
+
+	/* the differences wrap around when the values decrease, which the additions undo */
+	if (bytes != private->accounted_bytes)
+		__sync_fetch_and_add(&nds_stats_live_bytes, bytes - private->accounted_bytes);
+	if (waste != private->accounted_waste)
+		__sync_fetch_and_add(&nds_stats_wasted_bytes, waste - private->accounted_waste);
+
+	private->accounted_bytes = bytes;
+	private->accounted_waste = waste;
+
+	if (private->capacity > private->stats.peak_capacity)
+		private->stats.peak_capacity = private->capacity;
+}
+
+
+/* records a vector that was created */
+static void nds_vector_stats_created(NdsVectorPrivate *private)
+{
+	memset(&private->stats, 0, sizeof(private->stats));
+	private->accounted_bytes = 0;
+	private->accounted_waste = 0;
+
+	__sync_fetch_and_add(&nds_stats_live_vectors, 1);
+	nds_vector_stats_account(private);
+}
+
+
+/* removes a vector that is destroyed from the process-wide totals */
+static void nds_vector_stats_destroyed(NdsVectorPrivate *private)
+{
+	private->size = 0;
+	private->capacity = 0;
+
+	nds_vector_stats_account(private);
+	__sync_fetch_and_sub(&nds_stats_live_vectors, 1);
+}
+
+
+/* records a change of the capacity of the vector */
+static void nds_vector_stats_reallocated(NdsVectorPrivate *private)
+{
+	private->stats.reallocations++;
+	nds_vector_stats_account(private);
+}
+
+
+/* records elements that were copied to another buffer */
+static void nds_vector_stats_moved(NdsVectorPrivate *private, size_t bytes)
+{
+	private->stats.bytes_moved += bytes;
+}
+#else
+/* without NDS_ENABLE_STATS the counters compile to nothing */
+#define nds_vector_stats_account(private) ((void)0)
+#define nds_vector_stats_created(private) ((void)0)
+#define nds_vector_stats_destroyed(private) ((void)0)
+#define nds_vector_stats_reallocated(private) ((void)0)
+#define nds_vector_stats_moved(private, bytes) ((void)0)
+#endif
+
+
+/* allocates the block of a NdsVector together with room for inline_capacity elements after it */
+static NdsVector* nds_vector_new_block(size_t sizeof_element, size_t inline_capacity, const NdsAllocator *allocator)
+{
+	struct NdsVectorBlock *block;
+
+	block = (struct NdsVectorBlock*)allocator->alloc(allocator->context, NDS_VECTOR_BLOCK_SIZE(sizeof_element, inline_capacity));
+	if (!block)
+		return NULL;
+
+	block->vector.private = &block->private;
+
+	/* various initializations */
+	block->private.elements = inline_capacity > 0 ? (char*)block + NDS_VECTOR_INLINE_OFFSET : NULL;
+	block->private.sizeof_element = sizeof_element;
+	block->private.size = 0;
+	block->private.capacity = inline_capacity;
+	block->private.inline_capacity = inline_capacity;
+	block->private.allocator = *allocator;
+	block->private.mmap_threshold = 0;
+	block->private.mmap_flags = 0;
+	block->private.mapped = 0;
+	block->private.file_mapping = NULL;
+	block->private.file_mapping_length = 0;
+
+#ifdef NDS_VECTOR_HAS_MMAP
+	/* only vectors using the default allocator move their large element buffers to mappings by themselves */
+	if (allocator->alloc == nds_allocator_default()->alloc)
+		block->private.mmap_threshold = NDS_VECTOR_MMAP_THRESHOLD;
+#endif
+
+	nds_vector_stats_created(&block->private);
+
+	return &block->vector;
+}
+
+
+/* checks if the elements of the vector are currently stored in its inline buffer */
+static int nds_vector_is_inline(NdsVector *vector)
+{
+	return vector->private->inline_capacity > 0 && vector->private->elements == (char*)vector + NDS_VECTOR_INLINE_OFFSET;
+}
+
+
+#ifdef NDS_VECTOR_HAS_MMAP
+static size_t nds_vector_page_align(size_t size);
+#endif
+
+
+/* releases the memory that currently holds the elements of the vector (nothing for the inline buffer) */
+static void nds_vector_release_elements(NdsVector *vector)
+{
+	NdsVectorPrivate *private = vector->private;
+
+	if (nds_vector_is_inline(vector))
+		return;
+
+#ifdef NDS_VECTOR_HAS_MMAP
+	if (private->file_mapping != NULL)
+	{
+		munmap(private->file_mapping, private->file_mapping_length);
+		private->file_mapping = NULL;
+
+		return;
+	}
+
+	if (private->mapped)
+	{
+		munmap(private->elements, nds_vector_page_align(private->capacity * private->sizeof_element));
+		private->mapped = 0;
+
+		return;
+	}
+#endif
+
+	private->allocator.free(private->allocator.context, private->elements, private->capacity * private->sizeof_element);
+}
+
+
+#ifdef NDS_VECTOR_HAS_MMAP
+/* rounds a size in bytes up to a whole number of pages */
+static size_t nds_vector_page_align(size_t size)
+{
+	static size_t page_size = 0;
+
+	if (page_size == 0)
+		page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+	return (size + page_size - 1) & ~(page_size - 1);
+}
+
+
+/* asks for transparent huge pages on a mapping, when the vector was configured to use them */
+static void nds_vector_advise(NdsVectorPrivate *private, void *address, size_t length)
+{
+#ifdef MADV_HUGEPAGE
+	if (private->mmap_flags & NDS_VECTOR_HUGE_PAGES)
+		madvise(address, length, MADV_HUGEPAGE);
+#else
+	(void)private;
+	(void)address;
+	(void)length;
+#endif
+}
+
+
+/* gives capacity elements to a vector whose elements are mapped, or moves its elements to a new mapping */
+static NdsStatus nds_vector_reserve_mapped(NdsVector *vector, size_t capacity)
+{
+	NdsVectorPrivate *private = vector->private;
+	size_t length = nds_vector_page_align(capacity * private->sizeof_element);
+	void *elements;
+
+	if (private->mapped)
+	{
+		/* the kernel moves the pages to a larger range without copying them */
+		elements = mremap(private->elements, nds_vector_page_align(private->capacity * private->sizeof_element), length, MREMAP_MAYMOVE);
+		if (elements == MAP_FAILED)
+			return NDS_MEM_ALLOC_ERROR;
+	}
+	else
+	{
+		elements = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (elements == MAP_FAILED)
+			return NDS_MEM_ALLOC_ERROR;
+
+		/* this is the last time the elements are copied */
+		memcpy(elements, private->elements, private->size * private->sizeof_element);
+		nds_vector_stats_moved(private, private->size * private->sizeof_element);
+
+		nds_vector_release_elements(vector);
+		private->mapped = 1;
+	}
+
+	nds_vector_advise(private, elements, length);
+
+	private->elements = (char*)elements;
+	private->capacity = capacity;
+	nds_vector_stats_reallocated(private);
+
+	return NDS_OK;
+}
+
+
+/* reduces the mapping of a vector to capacity elements, or moves its elements back to the allocator */
+static NdsStatus nds_vector_shrink_mapped(NdsVector *vector, size_t capacity)
+{
+	NdsVectorPrivate *private = vector->private;
+	char *elements;
+
+	if (private->mmap_threshold > 0 && capacity * private->sizeof_element >= private->mmap_threshold)
+	{
+		/* the pages after the new end of the mapping are returned to the system */
+		elements = (char*)mremap(private->elements, nds_vector_page_align(private->capacity * private->sizeof_element), nds_vector_page_align(capacity * private->sizeof_element), 0);
+		if (elements == (char*)MAP_FAILED)
+			return NDS_MEM_ALLOC_ERROR;
+	}
+	else
+	{
+		if (private->inline_capacity > 0 && private->size <= private->inline_capacity)
+		{
+			elements = (char*)vector + NDS_VECTOR_INLINE_OFFSET;
+			capacity = private->inline_capacity;
+		}
+		else
+		{
+			elements = (char*)private->allocator.alloc(private->allocator.context, capacity * private->sizeof_element);
+			if (!elements)
+				return NDS_MEM_ALLOC_ERROR;
+		}
+
+		memcpy(elements, private->elements, private->size * private->sizeof_element);
+		nds_vector_stats_moved(private, private->size * private->sizeof_element);
+		nds_vector_release_elements(vector);
+	}
+
+	private->elements = elements;
+	private->capacity = capacity;
+	nds_vector_stats_reallocated(private);
+
+	return NDS_OK;
+}
+#endif
+
+
+/* makes room for size elements and reports from which element on the memory is known to be zero */
+static NdsStatus nds_vector_resize_storage(NdsVector *vector, size_t size, size_t *fresh)
+{
+	NdsVectorPrivate *private = vector->private;
+#ifdef NDS_VECTOR_HAS_MMAP
+	size_t old_capacity = private->capacity;
+	int was_mapped = private->mapped;
+#endif
+
+	*fresh = SIZE_MAX;
+
+	if (size <= private->capacity)
+		return NDS_OK;
+
+	/* the vector gets twice the requested size, unless that many bytes do not fit into a size_t */
+	if (nds_vector_reserve(vector, nds_size_overflows(size, 2 * private->sizeof_element) ? size : 2 * size) != NDS_OK)
+		return NDS_MEM_ALLOC_ERROR;
+
+#ifdef NDS_VECTOR_HAS_MMAP
+	/*
+	 * the pages added to a mapping are zero, but the last page of the old
+	 * mapping can still hold elements from before a shrink, so only the
+	 * elements that start after it are known to be zero; a new mapping is
+	 * zero after the elements copied into it
+	 */
+	if (private->mapped)
+		*fresh = was_mapped ? (nds_vector_page_align(old_capacity * private->sizeof_element) + private->sizeof_element - 1) / private->sizeof_element : private->size;
+#endif
+
+	return NDS_OK;
+}
+
+
+/* checks if all the bytes of an element have the same value */
+static int nds_vector_is_byte_pattern(const unsigned char *value, size_t sizeof_element)
+{
+	size_t i;
+
+	for (i = 1; i < sizeof_element; i++)
+		if (value[i] != value[0])
+			return 0;
+
+	return 1;
+}
+
+
+/* copies the element at value into count consecutive elements starting at destination */
+static void nds_vector_fill(char *destination, const void *value, size_t sizeof_element, size_t count)
+{
+	size_t total = count * sizeof_element;
+	size_t filled, length, block;
+
+	if (total == 0)
+		return;
+
+	/* elements made of one repeated byte (zero among them) are a single memset() */
+	if (nds_vector_is_byte_pattern((const unsigned char*)value, sizeof_element))
+	{
+		memset(destination, *(const unsigned char*)value, total);
+		return;
+	}
+
+	/* the value is doubled in place until it forms a block that fits in the L1 cache */
+	memcpy(destination, value, sizeof_element);
+	filled = sizeof_element;
+
+	while (filled < total && filled < NDS_VECTOR_FILL_BLOCK)
+	{
+		length = filled < total - filled ? filled : total - filled;
+		memcpy(destination + filled, destination, length);
+		filled += length;
+	}
+
+	/* the rest is copied from that block, whose size is a whole number of elements */
+	block = filled;
+	while (filled < total)
+	{
+		length = block < total - filled ? block : total - filled;
+		memcpy(destination + filled, destination, length);
+		filled += length;
+	}
+}
 
 
 NdsVector* nds_vector_new(size_t sizeof_element)
@@ -55,136 +435,196 @@ NdsVector* nds_vector_new(size_t sizeof_element)
 
 
 NdsVector* nds_vector_new_with_capacity(size_t sizeof_element, size_t capacity)
+{
+	return nds_vector_new_with_allocator(sizeof_element, capacity, nds_allocator_default());
+}
+
+
+NdsVector* nds_vector_new_with_allocator(size_t sizeof_element, size_t capacity, const NdsAllocator *allocator)
 {
 	NdsVector *vector;
 
 	/* sanity checks */
-	if (sizeof_element == 0 || capacity == 0)
+	if (sizeof_element == 0 || capacity == 0 || allocator == NULL)
 		return NULL;
 
-	/* we allocate memory for the structure of the NdsVector */
-	vector = (NdsVector*)malloc(sizeof(NdsVector));
-	if (!vector)
+	if (allocator->alloc == NULL || allocator->realloc == NULL || allocator->free == NULL)
 		return NULL;
 
-	/* we allocate memory for the private part of the NdsVector */
-	vector->private = (NdsVectorPrivate*)malloc(sizeof(NdsVectorPrivate));
-	if (!vector->private)
-	{
-		/* cleanup */
-		free(vector);
+	if (nds_size_overflows(capacity, sizeof_element))
+		return NULL;
 
+	/* we allocate memory for the structure and the private part of the NdsVector */
+	vector = nds_vector_new_block(sizeof_element, 0, allocator);
+	if (!vector)
 		return NULL;
-	}
 
 	/* we allocate memory for the elements that will be stored in the NdsVector */
-	vector->private->elements = (char*)malloc(capacity * sizeof_element);
+	vector->private->elements = (char*)allocator->alloc(allocator->context, capacity * sizeof_element);
 	if (!vector->private->elements)
 	{
 		/* cleanup */
-		free(vector->private);
-		free(vector);
+		allocator->free(allocator->context, vector, NDS_VECTOR_BLOCK_SIZE(sizeof_element, 0));
 
 		return NULL;
 	}
 
-	/* various initializations */
-	vector->private->sizeof_element = sizeof_element;
-	vector->private->size = 0;
 	vector->private->capacity = capacity;
+	nds_vector_stats_account(vector->private);
 
 	return vector;
 }
 
 
-void nds_vector_destroy(NdsVector *vector)
+NdsVector* nds_vector_new_small(size_t sizeof_element, size_t inline_capacity)
 {
 	/* sanity checks */
-	if (vector == NULL || vector->private == NULL)
-		return;
-
-	free(vector->private->elements);
-	vector->private->elements = NULL;
+	if (sizeof_element == 0 || inline_capacity == 0)
+		return NULL;
 
-	free(vector->private);
-	vector->private = NULL;
+	if (nds_size_overflows(inline_capacity, sizeof_element) || inline_capacity * sizeof_element > SIZE_MAX - NDS_VECTOR_INLINE_OFFSET)
+		return NULL;
 
-	free(vector);
-	vector = NULL;
+	/* the structure, the private part and the first elements of the NdsVector share one allocation */
+	return nds_vector_new_block(sizeof_element, inline_capacity, nds_allocator_default());
 }
 
 
-int nds_vector_is_empty(NdsVector *vector)
+void nds_vector_destroy(NdsVector *vector)
 {
+	NdsVectorPrivate *private;
+	NdsAllocator allocator;
+
 	/* sanity checks */
 	if (vector == NULL || vector->private == NULL)
-		return -1;
+		return;
 
-	return vector->private->size == 0;
-}
+	/* the allocator lives inside the block that is released last, so we keep a copy of it */
+	private = vector->private;
+	allocator = private->allocator;
 
+	nds_vector_release_elements(vector);
+	private->elements = NULL;
+	nds_vector_stats_destroyed(private);
 
-int nds_vector_size(NdsVector *vector)
-{
-	/* sanity checks */
-	if (vector == NULL || vector->private == NULL)
-		return -1;
+	vector->private = NULL;
 
-	return vector->private->size;
+	allocator.free(allocator.context, vector, NDS_VECTOR_BLOCK_SIZE(private->sizeof_element, private->inline_capacity));
+	vector = NULL;
 }
 
 
 NdsStatus nds_vector_resize(NdsVector *vector, size_t size)
 {
+	return nds_vector_resize_with_policy(vector, size, NDS_RESIZE_UNINIT);
+}
+
+
+NdsStatus nds_vector_resize_with_policy(NdsVector *vector, size_t size, unsigned int policy)
+{
+	NdsVectorPrivate *private;
+	size_t old_size, zero_end, fresh;
+
 	/* sanity checks */
-	if (vector == NULL || vector->private == NULL)
+	if (vector == NULL || vector->private == NULL || (policy & ~(unsigned int)(NDS_RESIZE_ZERO | NDS_RESIZE_SCRUB)) != 0)
 		return NDS_INVALID_PARAM_ERROR;
 
-	/* if new size is bigger than the current capacity */
-	if (size > vector->private->capacity)
-		if (nds_vector_reserve(vector, 2 * size) == NDS_MEM_ALLOC_ERROR)
-			return NDS_MEM_ALLOC_ERROR;
+	private = vector->private;
+	old_size = private->size;
 
-	if (size < vector->private->size)
-	{
-		size_t i;
-		size_t sizeof_element = vector->private->sizeof_element;
+	if (nds_vector_resize_storage(vector, size, &fresh) != NDS_OK)
+		return NDS_MEM_ALLOC_ERROR;
 
-		/* remove elements at the end of the vector in order to reflect the new size */
-		for (i = size; i < vector->private->size; i++)
-			memset(&vector->private->elements[i * sizeof_element], 0, sizeof_element);
+	/* the new elements from fresh on are already zero */
+	if (size > old_size && (policy & NDS_RESIZE_ZERO))
+	{
+		zero_end = size < fresh ? size : fresh;
+		if (zero_end > old_size)
+			memset(&private->elements[old_size * private->sizeof_element], 0, (zero_end - old_size) * private->sizeof_element);
 	}
 
-	vector->private->size = size;
+	/* the removed elements are only overwritten on request */
+	if (size < old_size && (policy & NDS_RESIZE_SCRUB))
+		memset(&private->elements[size * private->sizeof_element], 0, (old_size - size) * private->sizeof_element);
+
+	private->size = size;
+	nds_vector_stats_account(private);
 
 	return NDS_OK;
 }
 
 
-int nds_vector_capacity(NdsVector *vector)
+NdsStatus nds_vector_resize_fill(NdsVector *vector, size_t size, const void *value)
 {
+	NdsVectorPrivate *private;
+	size_t old_size, fresh;
+
 	/* sanity checks */
-	if (vector == NULL || vector->private == NULL)
-		return -1;
+	if (vector == NULL || vector->private == NULL || value == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = vector->private;
+	old_size = private->size;
 
-	return vector->private->capacity;
+	if (nds_vector_resize_storage(vector, size, &fresh) != NDS_OK)
+		return NDS_MEM_ALLOC_ERROR;
+
+	if (size > old_size)
+		nds_vector_fill(&private->elements[old_size * private->sizeof_element], value, private->sizeof_element, size - old_size);
+
+	private->size = size;
+	nds_vector_stats_account(private);
+
+	return NDS_OK;
 }
 
 
 NdsStatus nds_vector_reserve(NdsVector *vector, size_t capacity)
 {
+	NdsVectorPrivate *private;
 	char *elements;
 
 	/* sanity checks */
 	if (vector == NULL || vector->private == NULL || capacity <= vector->private->capacity)
 		return NDS_INVALID_PARAM_ERROR;
 
-	elements = (char*)realloc(vector->private->elements, capacity * vector->private->sizeof_element);
-	if (!elements)
+	private = vector->private;
+
+	/* the size in bytes of the new capacity must not wrap around */
+	if (nds_size_overflows(capacity, private->sizeof_element))
 		return NDS_MEM_ALLOC_ERROR;
 
-	vector->private->elements = elements;
-	vector->private->capacity = capacity;
+#ifdef NDS_VECTOR_HAS_MMAP
+	/* large element buffers live in anonymous mappings */
+	if (private->mapped || (private->mmap_threshold > 0 && capacity * private->sizeof_element >= private->mmap_threshold))
+		return nds_vector_reserve_mapped(vector, capacity);
+#endif
+
+	/* elements stored inline or in a file mapping are copied to the allocator, the inline buffer stays unused until a shrink */
+	if (nds_vector_is_inline(vector) || private->file_mapping != NULL)
+	{
+		elements = (char*)private->allocator.alloc(private->allocator.context, capacity * private->sizeof_element);
+		if (!elements)
+			return NDS_MEM_ALLOC_ERROR;
+
+		memcpy(elements, private->elements, private->size * private->sizeof_element);
+		nds_vector_stats_moved(private, private->size * private->sizeof_element);
+		nds_vector_release_elements(vector);
+	}
+	else
+	{
+		elements = (char*)private->allocator.realloc(private->allocator.context, private->elements, private->capacity * private->sizeof_element, capacity * private->sizeof_element);
+		if (!elements)
+			return NDS_MEM_ALLOC_ERROR;
+
+		/* realloc() copies the elements only when it can not extend the buffer in place */
+		if (elements != private->elements)
+			nds_vector_stats_moved(private, private->size * private->sizeof_element);
+	}
+
+	private->elements = elements;
+	private->capacity = capacity;
+	nds_vector_stats_reallocated(private);
 
 	return NDS_OK;
 }
@@ -192,6 +632,7 @@ NdsStatus nds_vector_reserve(NdsVector *vector, size_t capacity)
 
 NdsStatus nds_vector_shrink_to_fit(NdsVector *vector)
 {
+	NdsVectorPrivate *private;
 	char *elements;
 	size_t capacity;
 
@@ -199,15 +640,331 @@ NdsStatus nds_vector_shrink_to_fit(NdsVector *vector)
 	if (vector == NULL || vector->private == NULL)
 		return NDS_INVALID_PARAM_ERROR;
 
+	private = vector->private;
+
+#ifdef NDS_ENABLE_STATS
+	private->stats.shrink_calls++;
+	nds_vector_stats_account(private);
+#endif
+
+	/* the inline buffer can not be released, so its capacity is already the smallest one (same for a file mapping) */
+	if (nds_vector_is_inline(vector) || private->file_mapping != NULL)
+		return NDS_OK;
+
+#ifdef NDS_VECTOR_HAS_MMAP
+	if (private->mapped)
+		return nds_vector_shrink_mapped(vector, private->size > 0 ? private->size : 1);
+#endif
+
+	/* if the elements fit into the inline buffer, we move them back there and release the heap memory */
+	if (private->inline_capacity > 0 && private->size <= private->inline_capacity)
+	{
+		elements = (char*)vector + NDS_VECTOR_INLINE_OFFSET;
+		memcpy(elements, private->elements, private->size * private->sizeof_element);
+		nds_vector_stats_moved(private, private->size * private->sizeof_element);
+		private->allocator.free(private->allocator.context, private->elements, private->capacity * private->sizeof_element);
+
+		private->elements = elements;
+		private->capacity = private->inline_capacity;
+		nds_vector_stats_reallocated(private);
+
+		return NDS_OK;
+	}
+
 	/* if current size of vector is 0, we can not shrink it to capacity 0 (we use capacity 1 instead) */
-	capacity = vector->private->size > 0 ? vector->private->size : 1;
+	capacity = private->size > 0 ? private->size : 1;
 
-	elements = (char*)realloc(vector->private->elements, capacity * vector->private->sizeof_element);
+	elements = (char*)private->allocator.realloc(private->allocator.context, private->elements, private->capacity * private->sizeof_element, capacity * private->sizeof_element);
 	if (!elements)
 		return NDS_MEM_ALLOC_ERROR;
 
-	vector->private->elements = elements;
-	vector->private->capacity = capacity;
+	if (elements != private->elements)
+		nds_vector_stats_moved(private, private->size * private->sizeof_element);
+
+	private->elements = elements;
+	private->capacity = capacity;
+	nds_vector_stats_reallocated(private);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_vector_set_large_storage(NdsVector *vector, size_t threshold, unsigned int flags)
+{
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || (flags & ~(unsigned int)NDS_VECTOR_HUGE_PAGES) != 0)
+		return NDS_INVALID_PARAM_ERROR;
+
+#ifdef NDS_VECTOR_HAS_MMAP
+	/* the new threshold applies from the next change of the capacity */
+	vector->private->mmap_threshold = threshold;
+	vector->private->mmap_flags = flags;
+
+	return NDS_OK;
+#else
+	return threshold == 0 ? NDS_OK : NDS_ERROR;
+#endif
+}
+
+
+/* 64-bit FNV-1a applied on 8-byte words (and on single bytes for the tail) */
+static uint64_t nds_vector_checksum(const char *data, size_t length)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	uint64_t word;
+	size_t i;
+
+	for (i = 0; i + sizeof(word) <= length; i += sizeof(word))
+	{
+		memcpy(&word, &data[i], sizeof(word));
+		hash = (hash ^ word) * 1099511628211ULL;
+	}
+
+	for (; i < length; i++)
+		hash = (hash ^ (unsigned char)data[i]) * 1099511628211ULL;
+
+	return hash;
+}
+
+
+/* checks that the header of a snapshot describes elements that fit into file_size bytes */
+static int nds_vector_file_header_is_valid(const struct NdsVectorFileHeader *header, uint64_t file_size)
+{
+	if (memcmp(header->magic, NDS_VECTOR_FILE_MAGIC, sizeof(header->magic)) != 0)
+		return 0;
+
+	if (header->version != NDS_VECTOR_FILE_VERSION || header->byte_order != NDS_VECTOR_FILE_BYTE_ORDER)
+		return 0;
+
+	if (header->header_size != sizeof(struct NdsVectorFileHeader) || header->sizeof_element == 0)
+		return 0;
+
+	/* the division avoids an overflow of size * sizeof_element */
+	return header->size <= (file_size - header->header_size) / header->sizeof_element;
+}
+
+
+NdsStatus nds_vector_save(NdsVector *vector, const char *path)
+{
+	struct NdsVectorFileHeader header;
+	NdsVectorPrivate *private;
+	char *temporary_path;
+	size_t length;
+	FILE *file;
+	int written;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || path == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = vector->private;
+	length = private->size * private->sizeof_element;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, NDS_VECTOR_FILE_MAGIC, sizeof(header.magic));
+	header.version = NDS_VECTOR_FILE_VERSION;
+	header.byte_order = NDS_VECTOR_FILE_BYTE_ORDER;
+	header.header_size = sizeof(header);
+	header.sizeof_element = private->sizeof_element;
+	header.size = private->size;
+	header.checksum = nds_vector_checksum(private->elements, length);
+
+	/* the snapshot is written next to its final path and renamed, so readers never map a partial file */
+	temporary_path = (char*)malloc(strlen(path) + 5);
+	if (!temporary_path)
+		return NDS_MEM_ALLOC_ERROR;
+
+	strcpy(temporary_path, path);
+	strcat(temporary_path, ".tmp");
+
+	file = fopen(temporary_path, "wb");
+	if (!file)
+	{
+		/* cleanup */
+		free(temporary_path);
+
+		return NDS_ERROR;
+	}
+
+	written = fwrite(&header, sizeof(header), 1, file) == 1 && (length == 0 || fwrite(private->elements, length, 1, file) == 1);
+
+	if (fclose(file) != 0 || !written || rename(temporary_path, path) != 0)
+	{
+		/* cleanup */
+		remove(temporary_path);
+		free(temporary_path);
+
+		return NDS_ERROR;
+	}
+
+	free(temporary_path);
+
+	return NDS_OK;
+}
+
+
+#ifdef NDS_VECTOR_HAS_MMAP
+NdsVector* nds_vector_open_mapped(const char *path, unsigned int flags)
+{
+	struct NdsVectorFileHeader header;
+	NdsVectorPrivate *private;
+	NdsVector *vector;
+	struct stat status;
+	char *mapping;
+	int descriptor;
+
+	/* sanity checks */
+	if (path == NULL || (flags & ~(unsigned int)NDS_VECTOR_VERIFY_CHECKSUM) != 0)
+		return NULL;
+
+	descriptor = open(path, O_RDONLY);
+	if (descriptor < 0)
+		return NULL;
+
+	if (fstat(descriptor, &status) != 0 || (uint64_t)status.st_size < sizeof(header))
+	{
+		/* cleanup */
+		close(descriptor);
+
+		return NULL;
+	}
+
+	/* writes to the elements stay private to the process (copy-on-write), the file is never modified */
+	mapping = (char*)mmap(NULL, status.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0);
+	close(descriptor);
+
+	if (mapping == (char*)MAP_FAILED)
+		return NULL;
+
+	memcpy(&header, mapping, sizeof(header));
+	if (!nds_vector_file_header_is_valid(&header, status.st_size))
+	{
+		/* cleanup */
+		munmap(mapping, status.st_size);
+
+		return NULL;
+	}
+
+	/* verifying the checksum reads the whole file, so it is only done on request */
+	if ((flags & NDS_VECTOR_VERIFY_CHECKSUM) && nds_vector_checksum(mapping + header.header_size, header.size * header.sizeof_element) != header.checksum)
+	{
+		/* cleanup */
+		munmap(mapping, status.st_size);
+
+		return NULL;
+	}
+
+	vector = nds_vector_new_block(header.sizeof_element, 0, nds_allocator_default());
+	if (!vector)
+	{
+		/* cleanup */
+		munmap(mapping, status.st_size);
+
+		return NULL;
+	}
+
+	/* the elements are used in place, so opening does not depend on the size of the vector */
+	private = vector->private;
+	private->elements = mapping + header.header_size;
+	private->size = header.size;
+	private->capacity = header.size;
+	private->file_mapping = mapping;
+	private->file_mapping_length = status.st_size;
+	nds_vector_stats_account(private);
+
+	return vector;
+}
+#else
+NdsVector* nds_vector_open_mapped(const char *path, unsigned int flags)
+{
+	struct NdsVectorFileHeader header;
+	NdsVector *vector;
+	long file_size;
+	FILE *file;
+
+	/* sanity checks */
+	if (path == NULL || (flags & ~(unsigned int)NDS_VECTOR_VERIFY_CHECKSUM) != 0)
+		return NULL;
+
+	file = fopen(path, "rb");
+	if (!file)
+		return NULL;
+
+	/* without mmap() the elements are read into a regular vector */
+	if (fseek(file, 0, SEEK_END) != 0 || (file_size = ftell(file)) < (long)sizeof(header) || fseek(file, 0, SEEK_SET) != 0 ||
+		fread(&header, sizeof(header), 1, file) != 1 || !nds_vector_file_header_is_valid(&header, file_size))
+	{
+		/* cleanup */
+		fclose(file);
+
+		return NULL;
+	}
+
+	vector = nds_vector_new_with_capacity(header.sizeof_element, header.size > 0 ? header.size : 1);
+	if (!vector)
+	{
+		/* cleanup */
+		fclose(file);
+
+		return NULL;
+	}
+
+	if (header.size > 0 && fread(vector->private->elements, header.size * header.sizeof_element, 1, file) != 1)
+	{
+		/* cleanup */
+		nds_vector_destroy(vector);
+		fclose(file);
+
+		return NULL;
+	}
+
+	fclose(file);
+	vector->private->size = header.size;
+	nds_vector_stats_account(vector->private);
+
+	if ((flags & NDS_VECTOR_VERIFY_CHECKSUM) && nds_vector_checksum(vector->private->elements, header.size * header.sizeof_element) != header.checksum)
+	{
+		/* cleanup */
+		nds_vector_destroy(vector);
+
+		return NULL;
+	}
+
+	return vector;
+}
+#endif
+
+
+NdsStatus nds_vector_get_stats(NdsVector *vector, NdsVectorStats *stats)
+{
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || stats == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+#ifdef NDS_ENABLE_STATS
+	*stats = vector->private->stats;
+
+	return NDS_OK;
+#else
+	return NDS_ERROR;
+#endif
+}
+
+
+NdsStatus nds_stats_snapshot(NdsStats *stats)
+{
+	/* sanity checks */
+	if (stats == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+#ifdef NDS_ENABLE_STATS
+	/* adding 0 reads each total atomically */
+	stats->live_vectors = __sync_fetch_and_add(&nds_stats_live_vectors, 0);
+	stats->live_bytes = __sync_fetch_and_add(&nds_stats_live_bytes, 0);
+	stats->wasted_bytes = __sync_fetch_and_add(&nds_stats_wasted_bytes, 0);
 
 	return NDS_OK;
+#else
+	return NDS_ERROR;
+#endif
 }
@@ -0,0 +1,308 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the parallel algorithms of NdsVector that visit the
+ * elements independently: for_each, transform and reduce. They run on the
+ * default NdsScheduler over blocks of elements that fill whole cache lines,
+ * so that two threads never write to the same line.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+/* ndsvector.c exports the accessors, this file only needs the private part of the vector */
+#define NDS_INLINE_FAST_PATH
+
+#include <nds/ndsscheduler.h>
+#include <nds/ndsvector.h>
+
+#include <stdint.h>
+#include <string.h>
+
+
+/* ranges of for_each and transform and chunks of reduce hold at least this many bytes */
+#define NDS_PARALLEL_MIN_CHUNK_BYTES (16 * 1024)
+
+/* number of chunks of reduce per thread, so that the threads that finish early take over the remaining work */
+#define NDS_PARALLEL_CHUNKS_PER_WORKER 4
+
+
+/* the work shared by the tasks of a parallel algorithm */
+struct NdsParallelJob
+{
+	char *source;
+	size_t source_width;
+	char *destination;
+	size_t destination_width;
+
+	/* number of elements and number of elements per block (for_each and transform) or per chunk (reduce) */
+	size_t size;
+	size_t chunk;
+
+	/* the first block is shorter by this many elements, so that the others start on cache line boundaries */
+	size_t skew;
+
+	NdsElementFunction for_each;
+	NdsTransformFunction transform;
+	NdsReduceFunction accumulate;
+	void *context;
+
+	/* the partial results of the reduction, one per chunk and each on its own cache lines */
+	char *partials;
+	size_t partial_stride;
+};
+
+
+/* returns the smallest number of elements of width bytes that fills whole cache lines */
+static size_t nds_parallel_block_size(size_t width)
+{
+	size_t low_bit = width & (~width + 1);
+
+	return NDS_CACHE_LINE_SIZE / (low_bit < NDS_CACHE_LINE_SIZE ? low_bit : NDS_CACHE_LINE_SIZE);
+}
+
+
+/* returns the number of elements to leave out of the first block of chunk elements, so that the next blocks start on cache lines */
+static size_t nds_parallel_skew(const char *elements, size_t width, size_t chunk)
+{
+	size_t block = nds_parallel_block_size(width), head;
+
+	/* the element addresses repeat their position in the cache lines every block, so if no element of the first block starts a line, none does */
+	for (head = 0; head < block; head++)
+		if (((uintptr_t)(elements + head * width) & (NDS_CACHE_LINE_SIZE - 1)) == 0)
+			return (chunk - head) % chunk;
+
+	return 0;
+}
+
+
+/* returns the number of elements of width bytes per chunk of the reduction, a multiple of the block size */
+static size_t nds_parallel_chunk_size(size_t size, size_t width)
+{
+	size_t block = nds_parallel_block_size(width);
+	size_t chunk = size / (nds_get_worker_count() * NDS_PARALLEL_CHUNKS_PER_WORKER);
+
+	if (chunk < NDS_PARALLEL_MIN_CHUNK_BYTES / width)
+		chunk = NDS_PARALLEL_MIN_CHUNK_BYTES / width;
+
+	if (chunk % block != 0 || chunk == 0)
+		chunk += block - chunk % block;
+
+	return chunk;
+}
+
+
+/* returns the number of blocks (or chunks) of a job, which are the indexes of nds_parallel_for() (or nds_parallel_run()) */
+static size_t nds_parallel_block_count(const struct NdsParallelJob *job)
+{
+	return (job->size + job->skew) / job->chunk + ((job->size + job->skew) % job->chunk != 0);
+}
+
+
+/* returns the grain of nds_parallel_for() in blocks, so that no range is smaller than the minimum chunk */
+static size_t nds_parallel_grain(const struct NdsParallelJob *job, size_t width)
+{
+	size_t grain = NDS_PARALLEL_MIN_CHUNK_BYTES / (job->chunk * width);
+
+	return grain ? grain : 1;
+}
+
+
+/* returns the index of the first element of the block (or chunk) with the given index, the size for the blocks past the end */
+static size_t nds_parallel_block_start(const struct NdsParallelJob *job, size_t index)
+{
+	size_t start;
+
+	if (index == 0)
+		return 0;
+
+	start = index * job->chunk - job->skew;
+
+	return start < job->size ? start : job->size;
+}
+
+
+static void nds_parallel_for_each_range(size_t begin, size_t end, void *context)
+{
+	struct NdsParallelJob *job = (struct NdsParallelJob*)context;
+	size_t i = nds_parallel_block_start(job, begin), last = nds_parallel_block_start(job, end);
+	char *element = job->source + i * job->source_width;
+
+	for (; i < last; i++, element += job->source_width)
+		job->for_each(element, job->context);
+}
+
+
+static void nds_parallel_transform_range(size_t begin, size_t end, void *context)
+{
+	struct NdsParallelJob *job = (struct NdsParallelJob*)context;
+	size_t i = nds_parallel_block_start(job, begin), last = nds_parallel_block_start(job, end);
+	const char *source = job->source + i * job->source_width;
+	char *destination = job->destination + i * job->destination_width;
+
+	for (; i < last; i++, source += job->source_width, destination += job->destination_width)
+		job->transform(source, destination, job->context);
+}
+
+
+static void nds_parallel_reduce_task(size_t index, void *context)
+{
+	struct NdsParallelJob *job = (struct NdsParallelJob*)context;
+	size_t begin = nds_parallel_block_start(job, index), length = nds_parallel_block_start(job, index + 1) - begin;
+	const char *element = job->source + begin * job->source_width;
+	char *accumulator = job->partials + index * job->partial_stride;
+	size_t i;
+
+	for (i = 0; i < length; i++, element += job->source_width)
+		job->accumulate(accumulator, element, job->context);
+}
+
+
+/* runs a range function over the blocks of a job on the default scheduler, or on the calling thread without one */
+static NdsStatus nds_parallel_for_blocks(struct NdsParallelJob *job, size_t width, NdsRangeFunction function)
+{
+	NdsScheduler *scheduler = nds_scheduler_default();
+	size_t blocks = nds_parallel_block_count(job);
+
+	if (!scheduler)
+	{
+		function(0, blocks, job);
+		return NDS_OK;
+	}
+
+	return nds_parallel_for(scheduler, 0, blocks, nds_parallel_grain(job, width), function, job);
+}
+
+
+NdsStatus nds_vector_parallel_for_each(NdsVector *vector, NdsElementFunction function, void *context)
+{
+	struct NdsParallelJob job;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || function == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	if (vector->private->size == 0)
+		return NDS_OK;
+
+	memset(&job, 0, sizeof(job));
+	job.source = vector->private->elements;
+	job.source_width = vector->private->sizeof_element;
+	job.size = vector->private->size;
+	job.chunk = nds_parallel_block_size(job.source_width);
+	job.skew = nds_parallel_skew(job.source, job.source_width, job.chunk);
+	job.for_each = function;
+	job.context = context;
+
+	return nds_parallel_for_blocks(&job, job.source_width, nds_parallel_for_each_range);
+}
+
+
+NdsStatus nds_vector_parallel_transform(NdsVector *source, NdsVector *destination, NdsTransformFunction function, void *context)
+{
+	struct NdsParallelJob job;
+	NdsStatus status;
+
+	/* sanity checks */
+	if (source == NULL || source->private == NULL || destination == NULL || destination->private == NULL || function == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	if (destination != source)
+	{
+		status = nds_vector_resize(destination, source->private->size);
+		if (status != NDS_OK)
+			return status;
+	}
+
+	if (source->private->size == 0)
+		return NDS_OK;
+
+	memset(&job, 0, sizeof(job));
+	job.source = source->private->elements;
+	job.source_width = source->private->sizeof_element;
+	job.destination = destination->private->elements;
+	job.destination_width = destination->private->sizeof_element;
+	job.size = source->private->size;
+
+	/* the blocks are aligned for the vector that is written */
+	job.chunk = nds_parallel_block_size(job.destination_width);
+	job.skew = nds_parallel_skew(job.destination, job.destination_width, job.chunk);
+	job.transform = function;
+	job.context = context;
+
+	return nds_parallel_for_blocks(&job, job.destination_width, nds_parallel_transform_range);
+}
+
+
+NdsStatus nds_vector_parallel_reduce(NdsVector *vector, void *result, size_t result_size, NdsReduceFunction accumulate, NdsReduceFunction combine, void *context)
+{
+	struct NdsParallelJob job;
+	NdsVectorPrivate *private;
+	size_t chunks, length, i;
+	char *block;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || result == NULL || result_size == 0 || accumulate == NULL || combine == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = vector->private;
+	if (private->size == 0)
+		return NDS_OK;
+
+	memset(&job, 0, sizeof(job));
+	job.source = private->elements;
+	job.source_width = private->sizeof_element;
+	job.size = private->size;
+	job.chunk = nds_parallel_chunk_size(job.size, job.source_width);
+	job.accumulate = accumulate;
+	job.context = context;
+	chunks = nds_parallel_block_count(&job);
+
+	/* every partial result starts as a copy of the identity */
+	if (result_size > SIZE_MAX - NDS_CACHE_LINE_SIZE)
+		return NDS_MEM_ALLOC_ERROR;
+
+	job.partial_stride = (result_size + NDS_CACHE_LINE_SIZE - 1) / NDS_CACHE_LINE_SIZE * NDS_CACHE_LINE_SIZE;
+	if (nds_size_overflows(chunks, job.partial_stride) || chunks * job.partial_stride > SIZE_MAX - NDS_CACHE_LINE_SIZE)
+		return NDS_MEM_ALLOC_ERROR;
+
+	/* the allocator does not align to cache lines, so the partial results start at the first line of a larger block */
+	length = chunks * job.partial_stride + NDS_CACHE_LINE_SIZE;
+	block = (char*)private->allocator.alloc(private->allocator.context, length);
+	if (!block)
+		return NDS_MEM_ALLOC_ERROR;
+
+	job.partials = block + (NDS_CACHE_LINE_SIZE - ((uintptr_t)block & (NDS_CACHE_LINE_SIZE - 1))) % NDS_CACHE_LINE_SIZE;
+
+	for (i = 0; i < chunks; i++)
+		memcpy(job.partials + i * job.partial_stride, result, result_size);
+
+	nds_parallel_run(chunks, nds_parallel_reduce_task, &job);
+
+	for (i = 0; i < chunks; i++)
+		combine(result, job.partials + i * job.partial_stride, context);
+
+	/* cleanup */
+	private->allocator.free(private->allocator.context, block, length);
+
+	return NDS_OK;
+}
@@ -0,0 +1,275 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the search functions of NdsVector. Elements of 1, 2, 4
+ * and 8 bytes are compared a whole register at a time: the register is
+ * compared bytewise with the searched element replicated across it, and the
+ * resulting bit mask is reduced to one bit per element whose bytes all
+ * matched. The kernel is chosen at runtime among AVX-512, AVX2, SSE2 and a
+ * scalar loop, so the library runs on any x86-64 processor.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+/* ndsvector.c exports the accessors, this file only needs the private part of the vector */
+#define NDS_INLINE_FAST_PATH
+
+#include <nds/ndsvector.h>
+
+#include <stdint.h>
+#include <string.h>
+
+/* the SIMD kernels need GCC 5 (or a compatible compiler) for the AVX-512 intrinsics and target attributes */
+#if defined(__x86_64__) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#include <immintrin.h>
+
+#define NDS_SEARCH_HAS_X86
+#define NDS_SEARCH_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+
+/* number of bytes the searched element is replicated into, enough for the widest register */
+#define NDS_SEARCH_PATTERN_SIZE 64
+
+/* signature of a search kernel: counts the elements equal to the pattern, or stops at the first one */
+typedef size_t (*NdsSearchKernel)(const char *elements, size_t begin, size_t end, size_t width, const char *pattern, int first_only, size_t *first);
+
+
+/* compares the elements in [begin, end) one by one */
+static size_t nds_search_scalar(const char *elements, size_t begin, size_t end, size_t width, const char *pattern, int first_only, size_t *first)
+{
+	size_t i, count = 0;
+
+	/* the fixed widths let the compiler use plain integer comparisons */
+#define NDS_SEARCH_SCALAR_LOOP(type) \
+	{ \
+		type needle, value; \
+	\
+		memcpy(&needle, pattern, sizeof(type)); \
+		for (i = begin; i < end; i++) \
+		{ \
+			memcpy(&value, elements + i * sizeof(type), sizeof(type)); \
+			if (value == needle) \
+			{ \
+				if (first_only) \
+				{ \
+					*first = i; \
+					return 1; \
+				} \
+				count++; \
+			} \
+		} \
+	}
+
+	switch (width)
+	{
+		case 1:
+			NDS_SEARCH_SCALAR_LOOP(uint8_t)
+			break;
+
+		case 2:
+			NDS_SEARCH_SCALAR_LOOP(uint16_t)
+			break;
+
+		case 4:
+			NDS_SEARCH_SCALAR_LOOP(uint32_t)
+			break;
+
+		case 8:
+			NDS_SEARCH_SCALAR_LOOP(uint64_t)
+			break;
+
+		default:
+			for (i = begin; i < end; i++)
+				if (memcmp(elements + i * width, pattern, width) == 0)
+				{
+					if (first_only)
+					{
+						*first = i;
+						return 1;
+					}
+					count++;
+				}
+			break;
+	}
+
+#undef NDS_SEARCH_SCALAR_LOOP
+
+	return count;
+}
+
+
+#ifdef NDS_SEARCH_HAS_X86
+/* keeps one bit per element of the byte mask, set only if all the bytes of the element matched */
+static inline uint64_t nds_search_reduce(uint64_t mask, size_t width)
+{
+	switch (width)
+	{
+		case 1:
+			return mask;
+
+		case 2:
+			return mask & (mask >> 1) & 0x5555555555555555ULL;
+
+		case 4:
+			mask &= mask >> 1;
+			mask &= mask >> 2;
+			return mask & 0x1111111111111111ULL;
+
+		default:
+			mask &= mask >> 1;
+			mask &= mask >> 2;
+			mask &= mask >> 4;
+			return mask & 0x0101010101010101ULL;
+	}
+}
+
+
+/*
+ * The kernels walk the elements one register at a time. Every register holds a
+ * whole number of elements, so the byte mask never splits an element, and the
+ * elements left after the last full register are handed to the scalar loop.
+ */
+#define NDS_SEARCH_KERNEL(name, isa, register_size, compare) \
+	NDS_SEARCH_TARGET(isa) \
+	static size_t name(const char *elements, size_t begin, size_t end, size_t width, const char *pattern, int first_only, size_t *first) \
+	{ \
+		size_t offset = begin * width, bytes = end * width, count = 0; \
+		uint64_t mask; \
+	\
+		for (; offset + (register_size) <= bytes; offset += (register_size)) \
+		{ \
+			mask = nds_search_reduce(compare, width); \
+			if (mask != 0) \
+			{ \
+				if (first_only) \
+				{ \
+					*first = (offset + __builtin_ctzll(mask)) / width; \
+					return 1; \
+				} \
+				count += __builtin_popcountll(mask); \
+			} \
+		} \
+	\
+		return count + nds_search_scalar(elements, offset / width, end, width, pattern, first_only, first); \
+	}
+
+NDS_SEARCH_KERNEL(nds_search_sse2, "sse2", 16,
+	(uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(elements + offset)), _mm_loadu_si128((const __m128i*)pattern))))
+
+NDS_SEARCH_KERNEL(nds_search_avx2, "avx2", 32,
+	(uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(elements + offset)), _mm256_loadu_si256((const __m256i*)pattern))))
+
+NDS_SEARCH_KERNEL(nds_search_avx512, "avx512f,avx512bw", 64,
+	(uint64_t)_mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void*)(elements + offset)), _mm512_loadu_si512((const void*)pattern)))
+
+#undef NDS_SEARCH_KERNEL
+
+
+/* picks the widest kernel the processor supports, once per process */
+static NdsSearchKernel nds_search_kernel(void)
+{
+	static NdsSearchKernel kernel = NULL;
+	NdsSearchKernel selected = __atomic_load_n(&kernel, __ATOMIC_RELAXED);
+
+	if (selected != NULL)
+		return selected;
+
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx512bw"))
+		selected = nds_search_avx512;
+	else if (__builtin_cpu_supports("avx2"))
+		selected = nds_search_avx2;
+	else
+		selected = nds_search_sse2;
+
+	/* every thread selects the same kernel, so a race between them is harmless */
+	__atomic_store_n(&kernel, selected, __ATOMIC_RELAXED);
+
+	return selected;
+}
+#endif
+
+
+/* searches the vector for element, counting all the matches or stopping at the first one */
+static size_t nds_vector_search(NdsVectorPrivate *private, const void *element, int first_only, size_t *first)
+{
+	char pattern[NDS_SEARCH_PATTERN_SIZE];
+	size_t width = private->sizeof_element;
+	size_t i;
+
+	if (width == 1 || width == 2 || width == 4 || width == 8)
+	{
+		/* the element is replicated so that the pattern lines up with every element of a register */
+		for (i = 0; i < NDS_SEARCH_PATTERN_SIZE; i += width)
+			memcpy(pattern + i, element, width);
+
+#ifdef NDS_SEARCH_HAS_X86
+		return nds_search_kernel()(private->elements, 0, private->size, width, pattern, first_only, first);
+#else
+		return nds_search_scalar(private->elements, 0, private->size, width, pattern, first_only, first);
+#endif
+	}
+
+	return nds_search_scalar(private->elements, 0, private->size, width, (const char*)element, first_only, first);
+}
+
+
+ssize_t nds_vector_find(NdsVector *vector, const void *element)
+{
+	size_t first;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || element == NULL)
+		return -1;
+
+	if (nds_vector_search(vector->private, element, 1, &first) == 0)
+		return -1;
+
+	return (ssize_t)first;
+}
+
+
+ssize_t nds_vector_count(NdsVector *vector, const void *element)
+{
+	size_t first;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || element == NULL)
+		return -1;
+
+	return (ssize_t)nds_vector_search(vector->private, element, 0, &first);
+}
+
+
+int nds_vector_contains(NdsVector *vector, const void *element)
+{
+	size_t first;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || element == NULL)
+		return -1;
+
+	return nds_vector_search(vector->private, element, 1, &first) > 0;
+}
@@ -0,0 +1,1074 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the sorting functions of NdsVector: a pattern-defeating
+ * quicksort (after the pdqsort of Orson Peters) for the unstable sort, a
+ * bottom-up merge sort for the stable and the parallel sorts and a least
+ * significant digit radix sort for elements ordered by a numeric key. The
+ * elements are moved with copies and swaps specialized for the common element
+ * sizes, so that the compiler turns them into plain integer loads and stores.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+/* ndsvector.c exports the accessors, this file only needs the private part of the vector */
+#define NDS_INLINE_FAST_PATH
+
+#include <nds/ndsscheduler.h>
+#include <nds/ndsvector.h>
+
+#include <stdint.h>
+#include <string.h>
+
+
+/* ranges below this number of elements are sorted by insertion */
+#define NDS_SORT_INSERTION_THRESHOLD 24
+
+/* ranges above this number of elements take the pivot as the median of three medians */
+#define NDS_SORT_NINTHER_THRESHOLD 128
+
+/* number of element moves after which a partial insertion sort gives up */
+#define NDS_SORT_PARTIAL_INSERTION_LIMIT 8
+
+/* elements up to this size use scratch space on the stack */
+#define NDS_SORT_STACK_ELEMENT_SIZE 256
+
+/* length of the runs sorted by insertion before the merge passes of the stable sort */
+#define NDS_SORT_RUN_LENGTH 16
+
+/* every thread of the parallel sort gets a run of at least this many elements */
+#define NDS_SORT_PARALLEL_MIN_RUN 4096
+
+/* checks if the element at first goes before the element at second */
+#define NDS_SORT_LESS(sort, first, second) ((sort)->compare((first), (second)) < 0)
+
+
+typedef void (*NdsSortSwap)(char *first, char *second, size_t width);
+
+/* everything the sorting functions need to know about the elements */
+struct NdsSort
+{
+	size_t width;
+	NdsCompareFunction compare;
+	NdsSortSwap swap;
+
+	/* scratch elements that hold the pivot of a partition and the element being inserted */
+	char *pivot;
+	char *hole;
+};
+
+/* the work shared by the tasks of nds_vector_parallel_sort() */
+struct NdsParallelSort
+{
+	/* the scratch elements of sort are set by every task */
+	struct NdsSort sort;
+	char *scratch;
+
+	/* the buffer sits at the same offset in its cache line as the elements, inside a larger block */
+	char *elements;
+	char *buffer;
+	char *buffer_block;
+	size_t size;
+
+	/* number of runs (a power of two), the first element that starts a cache line and the number of elements between such starts */
+	size_t runs;
+	size_t head;
+	size_t alignment;
+
+	/* where the runs are sorted to, so that the last merge writes to the elements */
+	char *sorted;
+
+	/* the current merge pass: runs on each side of a merge, tasks per merge and the direction of the pass */
+	size_t span;
+	size_t parts;
+	char *source;
+	char *destination;
+};
+
+/* scratch space for two elements, aligned for any element type since it is passed to the compare function */
+union NdsSortScratch
+{
+	char bytes[2 * NDS_SORT_STACK_ELEMENT_SIZE];
+	long double long_double_alignment;
+	uint64_t integer_alignment;
+	void *pointer_alignment;
+};
+
+
+static void nds_sort_swap_4(char *first, char *second, size_t width)
+{
+	uint32_t temporary;
+
+	(void)width;
+
+	memcpy(&temporary, first, 4);
+	memcpy(first, second, 4);
+	memcpy(second, &temporary, 4);
+}
+
+
+static void nds_sort_swap_8(char *first, char *second, size_t width)
+{
+	uint64_t temporary;
+
+	(void)width;
+
+	memcpy(&temporary, first, 8);
+	memcpy(first, second, 8);
+	memcpy(second, &temporary, 8);
+}
+
+
+static void nds_sort_swap_16(char *first, char *second, size_t width)
+{
+	uint64_t temporary[2];
+
+	(void)width;
+
+	memcpy(temporary, first, 16);
+	memcpy(first, second, 16);
+	memcpy(second, temporary, 16);
+}
+
+
+/* swaps 8 bytes at a time, then the bytes that are left */
+static void nds_sort_swap_generic(char *first, char *second, size_t width)
+{
+	uint64_t word;
+	char byte;
+
+	for (; width >= 8; width -= 8, first += 8, second += 8)
+	{
+		memcpy(&word, first, 8);
+		memcpy(first, second, 8);
+		memcpy(second, &word, 8);
+	}
+
+	for (; width > 0; width--, first++, second++)
+	{
+		byte = *first;
+		*first = *second;
+		*second = byte;
+	}
+}
+
+
+static NdsSortSwap nds_sort_swap_function(size_t width)
+{
+	switch (width)
+	{
+		case 4:
+			return nds_sort_swap_4;
+
+		case 8:
+			return nds_sort_swap_8;
+
+		case 16:
+			return nds_sort_swap_16;
+
+		default:
+			return nds_sort_swap_generic;
+	}
+}
+
+
+/* copies an element, the constant sizes of the common cases become single moves */
+static inline void nds_sort_copy(char *destination, const char *source, size_t width)
+{
+	switch (width)
+	{
+		case 4:
+			memcpy(destination, source, 4);
+			break;
+
+		case 8:
+			memcpy(destination, source, 8);
+			break;
+
+		case 16:
+			memcpy(destination, source, 16);
+			break;
+
+		default:
+			memcpy(destination, source, width);
+			break;
+	}
+}
+
+
+/* prepares the description of the elements, with scratch space on the stack or from the allocator */
+static NdsStatus nds_sort_init(struct NdsSort *sort, NdsVectorPrivate *private, NdsCompareFunction compare, union NdsSortScratch *scratch)
+{
+	sort->width = private->sizeof_element;
+	sort->compare = compare;
+	sort->swap = nds_sort_swap_function(private->sizeof_element);
+
+	if (private->sizeof_element <= NDS_SORT_STACK_ELEMENT_SIZE)
+		sort->pivot = scratch->bytes;
+	else
+		sort->pivot = (char*)private->allocator.alloc(private->allocator.context, 2 * private->sizeof_element);
+
+	if (!sort->pivot)
+		return NDS_MEM_ALLOC_ERROR;
+
+	sort->hole = sort->pivot + private->sizeof_element;
+
+	return NDS_OK;
+}
+
+
+static void nds_sort_release(struct NdsSort *sort, NdsVectorPrivate *private, union NdsSortScratch *scratch)
+{
+	if (sort->pivot != scratch->bytes)
+		private->allocator.free(private->allocator.context, sort->pivot, 2 * private->sizeof_element);
+}
+
+
+/* sorts [begin, end) by insertion, moving only elements that are strictly smaller, which keeps it stable */
+static void nds_sort_insertion(const struct NdsSort *sort, char *begin, char *end)
+{
+	size_t width = sort->width;
+	char *current, *sift;
+
+	if (begin == end)
+		return;
+
+	for (current = begin + width; current < end; current += width)
+	{
+		if (NDS_SORT_LESS(sort, current, current - width))
+		{
+			nds_sort_copy(sort->hole, current, width);
+			sift = current;
+
+			do
+			{
+				nds_sort_copy(sift, sift - width, width);
+				sift -= width;
+			}
+			while (sift != begin && NDS_SORT_LESS(sort, sort->hole, sift - width));
+
+			nds_sort_copy(sift, sort->hole, width);
+		}
+	}
+}
+
+
+/* like nds_sort_insertion(), but the element before begin must not be greater than any element of the range */
+static void nds_sort_unguarded_insertion(const struct NdsSort *sort, char *begin, char *end)
+{
+	size_t width = sort->width;
+	char *current, *sift;
+
+	if (begin == end)
+		return;
+
+	for (current = begin + width; current < end; current += width)
+	{
+		if (NDS_SORT_LESS(sort, current, current - width))
+		{
+			nds_sort_copy(sort->hole, current, width);
+			sift = current;
+
+			do
+			{
+				nds_sort_copy(sift, sift - width, width);
+				sift -= width;
+			}
+			while (NDS_SORT_LESS(sort, sort->hole, sift - width));
+
+			nds_sort_copy(sift, sort->hole, width);
+		}
+	}
+}
+
+
+/* attempts an insertion sort and gives up after a few moves, which tells if the range was already nearly sorted */
+static int nds_sort_partial_insertion(const struct NdsSort *sort, char *begin, char *end)
+{
+	size_t width = sort->width;
+	size_t moves = 0;
+	char *current, *sift;
+
+	if (begin == end)
+		return 1;
+
+	for (current = begin + width; current < end; current += width)
+	{
+		if (NDS_SORT_LESS(sort, current, current - width))
+		{
+			nds_sort_copy(sort->hole, current, width);
+			sift = current;
+
+			do
+			{
+				nds_sort_copy(sift, sift - width, width);
+				sift -= width;
+			}
+			while (sift != begin && NDS_SORT_LESS(sort, sort->hole, sift - width));
+
+			nds_sort_copy(sift, sort->hole, width);
+
+			moves += (size_t)(current - sift) / width;
+			if (moves > NDS_SORT_PARTIAL_INSERTION_LIMIT)
+				return 0;
+		}
+	}
+
+	return 1;
+}
+
+
+static void nds_sort_2(const struct NdsSort *sort, char *first, char *second)
+{
+	if (NDS_SORT_LESS(sort, second, first))
+		sort->swap(first, second, sort->width);
+}
+
+
+static void nds_sort_3(const struct NdsSort *sort, char *first, char *second, char *third)
+{
+	nds_sort_2(sort, first, second);
+	nds_sort_2(sort, second, third);
+	nds_sort_2(sort, first, second);
+}
+
+
+/*
+ * Partitions [begin, end) around the pivot at begin: the elements smaller than
+ * the pivot go to its left, the others to its right. Returns the final position
+ * of the pivot and reports whether no element had to be swapped.
+ */
+static char* nds_sort_partition_right(const struct NdsSort *sort, char *begin, char *end, int *already_partitioned)
+{
+	size_t width = sort->width;
+	char *first = begin, *last = end, *pivot_position;
+
+	nds_sort_copy(sort->pivot, begin, width);
+
+	/* the median of three guarantees an element that is not smaller than the pivot */
+	do
+		first += width;
+	while (NDS_SORT_LESS(sort, first, sort->pivot));
+
+	/* if no element was skipped, nothing guarantees an element smaller than the pivot */
+	if (first - width == begin)
+	{
+		while (first < last)
+		{
+			last -= width;
+			if (NDS_SORT_LESS(sort, last, sort->pivot))
+				break;
+		}
+	}
+	else
+	{
+		do
+			last -= width;
+		while (!NDS_SORT_LESS(sort, last, sort->pivot));
+	}
+
+	*already_partitioned = first >= last;
+
+	while (first < last)
+	{
+		sort->swap(first, last, width);
+
+		do
+			first += width;
+		while (NDS_SORT_LESS(sort, first, sort->pivot));
+
+		do
+			last -= width;
+		while (!NDS_SORT_LESS(sort, last, sort->pivot));
+	}
+
+	pivot_position = first - width;
+	nds_sort_copy(begin, pivot_position, width);
+	nds_sort_copy(pivot_position, sort->pivot, width);
+
+	return pivot_position;
+}
+
+
+/*
+ * Partitions [begin, end) around the pivot at begin, putting the elements equal
+ * to the pivot to its left. It is used when the range holds many elements equal
+ * to the pivot, which then never have to be sorted again.
+ */
+static char* nds_sort_partition_left(const struct NdsSort *sort, char *begin, char *end)
+{
+	size_t width = sort->width;
+	char *first = begin, *last = end, *pivot_position;
+
+	nds_sort_copy(sort->pivot, begin, width);
+
+	do
+		last -= width;
+	while (NDS_SORT_LESS(sort, sort->pivot, last));
+
+	if (last + width == end)
+	{
+		while (first < last)
+		{
+			first += width;
+			if (NDS_SORT_LESS(sort, sort->pivot, first))
+				break;
+		}
+	}
+	else
+	{
+		do
+			first += width;
+		while (!NDS_SORT_LESS(sort, sort->pivot, first));
+	}
+
+	while (first < last)
+	{
+		sort->swap(first, last, width);
+
+		do
+			last -= width;
+		while (NDS_SORT_LESS(sort, sort->pivot, last));
+
+		do
+			first += width;
+		while (!NDS_SORT_LESS(sort, sort->pivot, first));
+	}
+
+	pivot_position = last;
+	nds_sort_copy(begin, pivot_position, width);
+	nds_sort_copy(pivot_position, sort->pivot, width);
+
+	return pivot_position;
+}
+
+
+static void nds_sort_sift_down(const struct NdsSort *sort, char *base, size_t root, size_t count)
+{
+	size_t width = sort->width;
+	size_t child;
+
+	for (;;)
+	{
+		child = 2 * root + 1;
+		if (child >= count)
+			return;
+
+		if (child + 1 < count && NDS_SORT_LESS(sort, base + child * width, base + (child + 1) * width))
+			child++;
+
+		if (!NDS_SORT_LESS(sort, base + root * width, base + child * width))
+			return;
+
+		sort->swap(base + root * width, base + child * width, width);
+		root = child;
+	}
+}
+
+
+/* heapsort is the fallback that keeps the worst case at O(n log n) */
+static void nds_sort_heap(const struct NdsSort *sort, char *begin, char *end)
+{
+	size_t count = (size_t)(end - begin) / sort->width;
+	size_t i;
+
+	for (i = count / 2; i-- > 0; )
+		nds_sort_sift_down(sort, begin, i, count);
+
+	for (i = count - 1; i > 0; i--)
+	{
+		sort->swap(begin, begin + i * sort->width, sort->width);
+		nds_sort_sift_down(sort, begin, 0, i);
+	}
+}
+
+
+/* breaks the patterns that made a partition unbalanced by swapping a few elements of each side */
+static void nds_sort_shuffle(const struct NdsSort *sort, char *begin, char *pivot_position, char *end)
+{
+	size_t width = sort->width;
+	size_t left_size = (size_t)(pivot_position - begin) / width;
+	size_t right_size = (size_t)(end - (pivot_position + width)) / width;
+
+	if (left_size >= NDS_SORT_INSERTION_THRESHOLD)
+	{
+		sort->swap(begin, begin + left_size / 4 * width, width);
+		sort->swap(pivot_position - width, pivot_position - left_size / 4 * width, width);
+
+		if (left_size > NDS_SORT_NINTHER_THRESHOLD)
+		{
+			sort->swap(begin + width, begin + (left_size / 4 + 1) * width, width);
+			sort->swap(begin + 2 * width, begin + (left_size / 4 + 2) * width, width);
+			sort->swap(pivot_position - 2 * width, pivot_position - (left_size / 4 + 1) * width, width);
+			sort->swap(pivot_position - 3 * width, pivot_position - (left_size / 4 + 2) * width, width);
+		}
+	}
+
+	if (right_size >= NDS_SORT_INSERTION_THRESHOLD)
+	{
+		sort->swap(pivot_position + width, pivot_position + (right_size / 4 + 1) * width, width);
+		sort->swap(end - width, end - right_size / 4 * width, width);
+
+		if (right_size > NDS_SORT_NINTHER_THRESHOLD)
+		{
+			sort->swap(pivot_position + 2 * width, pivot_position + (right_size / 4 + 2) * width, width);
+			sort->swap(pivot_position + 3 * width, pivot_position + (right_size / 4 + 3) * width, width);
+			sort->swap(end - 2 * width, end - (right_size / 4 + 1) * width, width);
+			sort->swap(end - 3 * width, end - (right_size / 4 + 2) * width, width);
+		}
+	}
+}
+
+
+/* sorts [begin, end), recursing into the left part and looping over the right part */
+static void nds_sort_pdq(const struct NdsSort *sort, char *begin, char *end, int bad_allowed, int leftmost)
+{
+	size_t width = sort->width;
+	size_t size, half, left_size, right_size;
+	char *pivot_position;
+	int already_partitioned;
+
+	for (;;)
+	{
+		size = (size_t)(end - begin) / width;
+
+		if (size < NDS_SORT_INSERTION_THRESHOLD)
+		{
+			if (leftmost)
+				nds_sort_insertion(sort, begin, end);
+			else
+				nds_sort_unguarded_insertion(sort, begin, end);
+
+			return;
+		}
+
+		/* the pivot is moved to begin */
+		half = size / 2;
+		if (size > NDS_SORT_NINTHER_THRESHOLD)
+		{
+			nds_sort_3(sort, begin, begin + half * width, end - width);
+			nds_sort_3(sort, begin + width, begin + (half - 1) * width, end - 2 * width);
+			nds_sort_3(sort, begin + 2 * width, begin + (half + 1) * width, end - 3 * width);
+			nds_sort_3(sort, begin + (half - 1) * width, begin + half * width, begin + (half + 1) * width);
+			sort->swap(begin, begin + half * width, width);
+		}
+		else
+		{
+			nds_sort_3(sort, begin + half * width, begin, end - width);
+		}
+
+		/* a pivot equal to the element before the range means many equal elements, which are gathered and skipped */
+		if (!leftmost && !NDS_SORT_LESS(sort, begin - width, begin))
+		{
+			begin = nds_sort_partition_left(sort, begin, end) + width;
+			continue;
+		}
+
+		pivot_position = nds_sort_partition_right(sort, begin, end, &already_partitioned);
+
+		left_size = (size_t)(pivot_position - begin) / width;
+		right_size = (size_t)(end - (pivot_position + width)) / width;
+
+		if (left_size < size / 8 || right_size < size / 8)
+		{
+			/* too many unbalanced partitions mean an adversarial input */
+			if (--bad_allowed == 0)
+			{
+				nds_sort_heap(sort, begin, end);
+				return;
+			}
+
+			nds_sort_shuffle(sort, begin, pivot_position, end);
+		}
+		else if (already_partitioned && nds_sort_partial_insertion(sort, begin, pivot_position) &&
+			nds_sort_partial_insertion(sort, pivot_position + width, end))
+		{
+			/* a range that needed no swap and only a few moves was already sorted */
+			return;
+		}
+
+		nds_sort_pdq(sort, begin, pivot_position, bad_allowed, leftmost);
+
+		begin = pivot_position + width;
+		leftmost = 0;
+	}
+}
+
+
+/* merges the sorted ranges [first, first_end) and [second, second_end) into destination, taking from the first range on ties */
+static void nds_sort_merge(const struct NdsSort *sort, const char *first, const char *first_end, const char *second, const char *second_end, char *destination)
+{
+	size_t width = sort->width;
+
+	/* ranges that are already in order are copied at once */
+	if (first == first_end || second == second_end || !NDS_SORT_LESS(sort, second, first_end - width))
+	{
+		memcpy(destination, first, (size_t)(first_end - first));
+		memcpy(destination + (first_end - first), second, (size_t)(second_end - second));
+		return;
+	}
+
+	while (first < first_end && second < second_end)
+	{
+		if (NDS_SORT_LESS(sort, second, first))
+		{
+			nds_sort_copy(destination, second, width);
+			second += width;
+		}
+		else
+		{
+			nds_sort_copy(destination, first, width);
+			first += width;
+		}
+
+		destination += width;
+	}
+
+	memcpy(destination, first, (size_t)(first_end - first));
+	destination += first_end - first;
+	memcpy(destination, second, (size_t)(second_end - second));
+}
+
+
+/*
+ * Sorts the size elements at elements with a bottom-up merge sort: short runs
+ * are sorted by insertion, then merged in passes of doubling length between
+ * the elements and the buffer. Returns the one that holds the sorted elements.
+ */
+static char* nds_sort_merge_sort(const struct NdsSort *sort, char *elements, char *buffer, size_t size)
+{
+	size_t width = sort->width;
+	size_t run, i, middle, right;
+	char *source = elements, *destination = buffer, *temporary;
+
+	for (i = 0; i < size; i += NDS_SORT_RUN_LENGTH)
+		nds_sort_insertion(sort, elements + i * width, elements + (size - i < NDS_SORT_RUN_LENGTH ? size : i + NDS_SORT_RUN_LENGTH) * width);
+
+	for (run = NDS_SORT_RUN_LENGTH; run < size; run *= 2)
+	{
+		for (i = 0; i < size; i += 2 * run)
+		{
+			middle = size - i < run ? size : i + run;
+			right = size - middle < run ? size : middle + run;
+
+			nds_sort_merge(sort, source + i * width, source + middle * width, source + middle * width, source + right * width, destination + i * width);
+		}
+
+		temporary = source;
+		source = destination;
+		destination = temporary;
+	}
+
+	return source;
+}
+
+
+/* returns how many of the first count elements of the stable merge of two sorted ranges come from the first range */
+static size_t nds_sort_co_rank(const struct NdsSort *sort, const char *first, size_t first_size, const char *second, size_t second_size, size_t count)
+{
+	size_t low = count > second_size ? count - second_size : 0;
+	size_t high = count < first_size ? count : first_size;
+	size_t i;
+
+	while (low < high)
+	{
+		i = low + (high - low) / 2;
+
+		/* first[i] is merged before second[count - i - 1] unless it is strictly greater */
+		if (!NDS_SORT_LESS(sort, second + (count - i - 1) * sort->width, first + i * sort->width))
+			low = i + 1;
+		else
+			high = i;
+	}
+
+	return low;
+}
+
+
+NdsStatus nds_vector_sort(NdsVector *vector, NdsCompareFunction compare)
+{
+	union NdsSortScratch scratch;
+	struct NdsSort sort;
+	NdsVectorPrivate *private;
+	size_t size;
+	int bad_allowed = 0;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || compare == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = vector->private;
+	if (private->size < 2)
+		return NDS_OK;
+
+	if (nds_sort_init(&sort, private, compare, &scratch) != NDS_OK)
+		return NDS_MEM_ALLOC_ERROR;
+
+	/* the number of unbalanced partitions tolerated before heapsort is log2(size) */
+	for (size = private->size; size > 1; size >>= 1)
+		bad_allowed++;
+
+	nds_sort_pdq(&sort, private->elements, private->elements + private->size * private->sizeof_element, bad_allowed, 1);
+
+	/* cleanup */
+	nds_sort_release(&sort, private, &scratch);
+
+	return NDS_OK;
+}
+
+
+NdsStatus nds_vector_stable_sort(NdsVector *vector, NdsCompareFunction compare)
+{
+	union NdsSortScratch scratch;
+	struct NdsSort sort;
+	NdsVectorPrivate *private;
+	size_t size, width;
+	char *buffer, *sorted;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || compare == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = vector->private;
+	size = private->size;
+	width = private->sizeof_element;
+
+	if (size < 2)
+		return NDS_OK;
+
+	if (nds_sort_init(&sort, private, compare, &scratch) != NDS_OK)
+		return NDS_MEM_ALLOC_ERROR;
+
+	buffer = (char*)private->allocator.alloc(private->allocator.context, size * width);
+	if (!buffer)
+	{
+		/* cleanup */
+		nds_sort_release(&sort, private, &scratch);
+
+		return NDS_MEM_ALLOC_ERROR;
+	}
+
+	sorted = nds_sort_merge_sort(&sort, private->elements, buffer, size);
+
+	if (sorted != private->elements)
+		memcpy(private->elements, sorted, size * width);
+
+	/* cleanup */
+	private->allocator.free(private->allocator.context, buffer, size * width);
+	nds_sort_release(&sort, private, &scratch);
+
+	return NDS_OK;
+}
+
+
+/* returns the index of the first element of a run of the parallel sort, runs after the first one start on cache line boundaries */
+static size_t nds_sort_run_start(const struct NdsParallelSort *job, size_t run)
+{
+	size_t start;
+
+	if (run >= job->runs)
+		return job->size;
+
+	start = job->size / job->runs * run + job->size % job->runs * run / job->runs;
+
+	return start < job->head ? 0 : start - (start - job->head) % job->alignment;
+}
+
+
+static void nds_sort_run_task(size_t index, void *context)
+{
+	struct NdsParallelSort *job = (struct NdsParallelSort*)context;
+	struct NdsSort sort = job->sort;
+	union NdsSortScratch scratch;
+	size_t width = sort.width;
+	size_t begin = nds_sort_run_start(job, index);
+	size_t end = nds_sort_run_start(job, index + 1);
+	char *sorted;
+
+	sort.pivot = job->scratch ? job->scratch + index * 2 * width : scratch.bytes;
+	sort.hole = sort.pivot + width;
+
+	sorted = nds_sort_merge_sort(&sort, job->elements + begin * width, job->buffer + begin * width, end - begin);
+	if (sorted != job->sorted + begin * width)
+		memcpy(job->sorted + begin * width, sorted, (end - begin) * width);
+}
+
+
+/* merges a part of a pair of runs, the parts of the output are split between the runs by binary search */
+static void nds_sort_merge_task(size_t index, void *context)
+{
+	struct NdsParallelSort *job = (struct NdsParallelSort*)context;
+	size_t width = job->sort.width;
+	size_t pair = index / job->parts, part = index % job->parts;
+	size_t left = nds_sort_run_start(job, 2 * pair * job->span);
+	size_t middle = nds_sort_run_start(job, (2 * pair + 1) * job->span);
+	size_t right = nds_sort_run_start(job, (2 * pair + 2) * job->span);
+	size_t total = right - left;
+	size_t output_begin = total / job->parts * part + total % job->parts * part / job->parts;
+	size_t output_end = total / job->parts * (part + 1) + total % job->parts * (part + 1) / job->parts;
+	const char *first = job->source + left * width;
+	const char *second = job->source + middle * width;
+	size_t first_begin, first_end;
+
+	first_begin = nds_sort_co_rank(&job->sort, first, middle - left, second, right - middle, output_begin);
+	first_end = nds_sort_co_rank(&job->sort, first, middle - left, second, right - middle, output_end);
+
+	nds_sort_merge(&job->sort, first + first_begin * width, first + first_end * width, second + (output_begin - first_begin) * width,
+		second + (output_end - first_end) * width, job->destination + (left + output_begin) * width);
+}
+
+
+NdsStatus nds_vector_parallel_sort(NdsVector *vector, NdsCompareFunction compare)
+{
+	struct NdsParallelSort job;
+	NdsVectorPrivate *private;
+	size_t width, low_bit, threads, passes = 0, runs, length;
+	char *temporary;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || compare == NULL)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = vector->private;
+	width = private->sizeof_element;
+
+	/* one run per thread, rounded up to a power of two so that the runs merge in pairs */
+	threads = nds_get_worker_count();
+	for (runs = 1; runs < threads && private->size / (runs * 2) >= NDS_SORT_PARALLEL_MIN_RUN; runs *= 2)
+		passes++;
+
+	if (runs == 1)
+		return nds_vector_stable_sort(vector, compare);
+
+	memset(&job, 0, sizeof(job));
+	job.sort.width = width;
+	job.sort.compare = compare;
+	job.sort.swap = nds_sort_swap_function(width);
+	job.elements = private->elements;
+	job.size = private->size;
+	job.runs = runs;
+
+	/* a multiple of this number of elements fills whole cache lines */
+	low_bit = width & (~width + 1);
+	job.alignment = NDS_CACHE_LINE_SIZE / (low_bit < NDS_CACHE_LINE_SIZE ? low_bit : NDS_CACHE_LINE_SIZE);
+
+	/* the element addresses repeat their position in the cache lines every alignment elements, so without a start in the first ones there is none */
+	for (job.head = 0; job.head < job.alignment; job.head++)
+		if (((uintptr_t)(job.elements + job.head * width) & (NDS_CACHE_LINE_SIZE - 1)) == 0)
+			break;
+
+	if (job.head == job.alignment)
+		job.head = 0;
+
+	if (job.size * width > SIZE_MAX - NDS_CACHE_LINE_SIZE)
+		return NDS_MEM_ALLOC_ERROR;
+
+	length = job.size * width + NDS_CACHE_LINE_SIZE;
+	job.buffer_block = (char*)private->allocator.alloc(private->allocator.context, length);
+	if (!job.buffer_block)
+		return NDS_MEM_ALLOC_ERROR;
+
+	job.buffer = job.buffer_block + (((uintptr_t)job.elements - (uintptr_t)job.buffer_block) & (NDS_CACHE_LINE_SIZE - 1));
+
+	if (width > NDS_SORT_STACK_ELEMENT_SIZE)
+	{
+		job.scratch = (char*)private->allocator.alloc(private->allocator.context, runs * 2 * width);
+		if (!job.scratch)
+		{
+			/* cleanup */
+			private->allocator.free(private->allocator.context, job.buffer_block, length);
+
+			return NDS_MEM_ALLOC_ERROR;
+		}
+	}
+
+	/* every merge pass moves the elements to the other buffer */
+	job.sorted = passes % 2 ? job.buffer : job.elements;
+	nds_parallel_run(runs, nds_sort_run_task, &job);
+
+	job.source = job.sorted;
+	job.destination = job.sorted == job.elements ? job.buffer : job.elements;
+
+	/* every pass runs one task per run, so large merges are shared by several threads */
+	for (job.span = 1; job.span < runs; job.span *= 2)
+	{
+		job.parts = 2 * job.span;
+		nds_parallel_run(runs, nds_sort_merge_task, &job);
+
+		temporary = job.source;
+		job.source = job.destination;
+		job.destination = temporary;
+	}
+
+	/* cleanup */
+	if (job.scratch)
+		private->allocator.free(private->allocator.context, job.scratch, runs * 2 * width);
+	private->allocator.free(private->allocator.context, job.buffer_block, length);
+
+	return NDS_OK;
+}
+
+
+/* returns the size in bytes of a key type */
+static size_t nds_sort_key_size(NdsKeyType key_type)
+{
+	switch (key_type)
+	{
+		case NDS_KEY_INT8:
+		case NDS_KEY_UINT8:
+			return 1;
+
+		case NDS_KEY_INT16:
+		case NDS_KEY_UINT16:
+			return 2;
+
+		case NDS_KEY_INT32:
+		case NDS_KEY_UINT32:
+		case NDS_KEY_FLOAT:
+			return 4;
+
+		default:
+			return 8;
+	}
+}
+
+
+/* reads a key and maps it to an unsigned integer whose order is the order of the keys */
+static inline uint64_t nds_sort_key(const char *key, NdsKeyType key_type)
+{
+	uint8_t key8;
+	uint16_t key16;
+	uint32_t key32;
+	uint64_t key64;
+
+	switch (key_type)
+	{
+		case NDS_KEY_INT8:
+		case NDS_KEY_UINT8:
+			memcpy(&key8, key, 1);
+			return key_type == NDS_KEY_INT8 ? (uint64_t)(key8 ^ 0x80u) : key8;
+
+		case NDS_KEY_INT16:
+		case NDS_KEY_UINT16:
+			memcpy(&key16, key, 2);
+			return key_type == NDS_KEY_INT16 ? (uint64_t)(key16 ^ 0x8000u) : key16;
+
+		case NDS_KEY_INT32:
+		case NDS_KEY_UINT32:
+			memcpy(&key32, key, 4);
+			return key_type == NDS_KEY_INT32 ? (uint64_t)(key32 ^ 0x80000000u) : key32;
+
+		case NDS_KEY_FLOAT:
+			/* negative numbers have all their bits flipped, so that larger magnitudes come first */
+			memcpy(&key32, key, 4);
+			return (key32 & 0x80000000u) ? (uint64_t)(uint32_t)~key32 : (uint64_t)(key32 | 0x80000000u);
+
+		case NDS_KEY_INT64:
+		case NDS_KEY_UINT64:
+			memcpy(&key64, key, 8);
+			return key_type == NDS_KEY_INT64 ? key64 ^ 0x8000000000000000ULL : key64;
+
+		default:
+			memcpy(&key64, key, 8);
+			return (key64 & 0x8000000000000000ULL) ? ~key64 : key64 | 0x8000000000000000ULL;
+	}
+}
+
+
+NdsStatus nds_vector_radix_sort_by_key(NdsVector *vector, size_t key_offset, NdsKeyType key_type)
+{
+	size_t counts[8][256];
+	NdsVectorPrivate *private;
+	size_t size, width, key_size, byte, value, position, i;
+	char *buffer, *source, *destination, *temporary;
+	uint64_t key, first_key;
+
+	/* sanity checks */
+	if (vector == NULL || vector->private == NULL || (unsigned int)key_type > (unsigned int)NDS_KEY_DOUBLE)
+		return NDS_INVALID_PARAM_ERROR;
+
+	private = vector->private;
+	size = private->size;
+	width = private->sizeof_element;
+	key_size = nds_sort_key_size(key_type);
+
+	if (key_offset > width || key_size > width - key_offset)
+		return NDS_INVALID_PARAM_ERROR;
+
+	if (size < 2)
+		return NDS_OK;
+
+	buffer = (char*)private->allocator.alloc(private->allocator.context, size * width);
+	if (!buffer)
+		return NDS_MEM_ALLOC_ERROR;
+
+	/* the counts of every byte of the keys are taken in a single pass */
+	memset(counts, 0, key_size * sizeof(counts[0]));
+	for (i = 0; i < size; i++)
+	{
+		key = nds_sort_key(private->elements + i * width + key_offset, key_type);
+
+		for (byte = 0; byte < key_size; byte++)
+			counts[byte][(key >> (8 * byte)) & 0xff]++;
+	}
+
+	source = private->elements;
+	destination = buffer;
+	first_key = nds_sort_key(private->elements + key_offset, key_type);
+
+	for (byte = 0; byte < key_size; byte++)
+	{
+		/* a byte that is the same in all the keys does not change the order */
+		if (counts[byte][(first_key >> (8 * byte)) & 0xff] == size)
+			continue;
+
+		/* the counts become the positions where the elements with each byte value start */
+		for (position = 0, value = 0; value < 256; value++)
+		{
+			i = counts[byte][value];
+			counts[byte][value] = position;
+			position += i;
+		}
+
+		/* the elements are scattered in their current order, which keeps the sort stable */
+		for (i = 0; i < size; i++)
+		{
+			key = nds_sort_key(source + i * width + key_offset, key_type);
+			position = counts[byte][(key >> (8 * byte)) & 0xff]++;
+
+			nds_sort_copy(destination + position * width, source + i * width, width);
+		}
+
+		temporary = source;
+		source = destination;
+		destination = temporary;
+	}
+
+	if (source != private->elements)
+		memcpy(private->elements, source, size * width);
+
+	/* cleanup */
+	private->allocator.free(private->allocator.context, buffer, size * width);
+
+	return NDS_OK;
+}
@@ -0,0 +1,656 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file defines various unit tests for the functionality of the
+ * NdsConcurrentQueue data structure from the NDS library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ndstesthelpers.h"
+
+#include <nds/ndsconcurrentqueue.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+/* number of producer and consumer threads and number of elements enqueued by every producer in the concurrent tests */
+#define THREADS 4
+#define THREAD_ELEMENTS 50000
+
+
+/* arguments of the producers and of the consumers of the concurrent tests */
+struct QueueThread
+{
+	NdsConcurrentQueue *queue;
+	int thread;
+
+	/* 0 for the try functions, the size of a batch for the batched ones and -1 for the blocking ones */
+	int mode;
+
+	/* what a consumer received: the number of elements, their sum and whether some producer's elements came out of order */
+	uint64_t received;
+	uint64_t sum;
+	int failed;
+
+	/* number of elements received by all the consumers, shared by them */
+	uint64_t *total;
+};
+
+
+/* enqueues THREAD_ELEMENTS elements whose value encodes the thread and their order */
+static void* producer_thread(void *context)
+{
+	struct QueueThread *arguments = (struct QueueThread*)context;
+	uint32_t elements[16];
+	uint32_t next = 0, i, count;
+	ssize_t added;
+
+	while (next < THREAD_ELEMENTS)
+	{
+		if (arguments->mode < 0)
+		{
+			elements[0] = (uint32_t)arguments->thread << 24 | next;
+			added = nds_concurrent_queue_enqueue(arguments->queue, elements) == NDS_OK;
+		}
+		else if (arguments->mode == 0)
+		{
+			elements[0] = (uint32_t)arguments->thread << 24 | next;
+			added = nds_concurrent_queue_try_enqueue(arguments->queue, elements);
+		}
+		else
+		{
+			count = THREAD_ELEMENTS - next < (uint32_t)arguments->mode ? THREAD_ELEMENTS - next : (uint32_t)arguments->mode;
+			for (i = 0; i < count; i++)
+				elements[i] = (uint32_t)arguments->thread << 24 | (next + i);
+			added = nds_concurrent_queue_try_enqueue_n(arguments->queue, elements, count);
+		}
+
+		if (added < 0)
+		{
+			arguments->failed = 1;
+			return NULL;
+		}
+
+		/* the threads may share the processor, so we give the consumers the chance to empty the queue */
+		if (added == 0)
+			sched_yield();
+
+		next += (uint32_t)added;
+	}
+
+	return NULL;
+}
+
+
+/* dequeues until the queue is closed (blocking mode) or until the consumers received all the elements */
+static void* consumer_thread(void *context)
+{
+	struct QueueThread *arguments = (struct QueueThread*)context;
+	uint32_t elements[16], last[THREADS];
+	ssize_t removed, i;
+
+	memset(last, 0xff, sizeof(last));
+
+	for (;;)
+	{
+		if (arguments->mode < 0)
+		{
+			if (nds_concurrent_queue_dequeue(arguments->queue, elements) != NDS_OK)
+				return NULL;
+			removed = 1;
+		}
+		else
+		{
+			if (__atomic_load_n(arguments->total, __ATOMIC_RELAXED) == (uint64_t)THREADS * THREAD_ELEMENTS)
+				return NULL;
+
+			if (arguments->mode == 0)
+				removed = nds_concurrent_queue_try_dequeue(arguments->queue, elements);
+			else
+				removed = nds_concurrent_queue_try_dequeue_n(arguments->queue, elements, (size_t)arguments->mode);
+
+			if (removed == 0)
+				sched_yield();
+			__atomic_add_fetch(arguments->total, (uint64_t)removed, __ATOMIC_RELAXED);
+		}
+
+		for (i = 0; i < removed; i++)
+		{
+			/* the elements of one producer reach every consumer in the order in which they were enqueued */
+			if (last[elements[i] >> 24] != UINT32_MAX && (elements[i] & 0xffffff) <= last[elements[i] >> 24])
+				arguments->failed = 1;
+			last[elements[i] >> 24] = elements[i] & 0xffffff;
+
+			arguments->received++;
+			arguments->sum += elements[i] & 0xffffff;
+		}
+	}
+}
+
+
+/* moves the elements of THREADS producers to THREADS consumers and checks that every element arrived once */
+static int run_threads(NdsConcurrentQueue *queue, int mode)
+{
+	struct QueueThread producers[THREADS], consumers[THREADS];
+	pthread_t producer_threads[THREADS], consumer_threads[THREADS];
+	uint64_t total = 0, received = 0, sum = 0;
+	int i, result = 0;
+
+	if (!queue)
+		return 1;
+
+	for (i = 0; i < THREADS; i++)
+	{
+		memset(&producers[i], 0, sizeof(struct QueueThread));
+		producers[i].queue = queue;
+		producers[i].thread = i;
+		producers[i].mode = mode;
+		consumers[i] = producers[i];
+		consumers[i].total = &total;
+
+		pthread_create(&consumer_threads[i], NULL, consumer_thread, &consumers[i]);
+		pthread_create(&producer_threads[i], NULL, producer_thread, &producers[i]);
+	}
+
+	for (i = 0; i < THREADS; i++)
+		pthread_join(producer_threads[i], NULL);
+
+	/* the blocking consumers stop once the queue is closed and empty */
+	if (mode < 0 && nds_concurrent_queue_close(queue) != NDS_OK)
+		result = 1;
+
+	for (i = 0; i < THREADS; i++)
+	{
+		pthread_join(consumer_threads[i], NULL);
+
+		received += consumers[i].received;
+		sum += consumers[i].sum;
+		result |= producers[i].failed | consumers[i].failed;
+	}
+
+	if (received != (uint64_t)THREADS * THREAD_ELEMENTS || sum != (uint64_t)THREADS * THREAD_ELEMENTS * (THREAD_ELEMENTS - 1) / 2 || nds_concurrent_queue_size(queue) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_queue_destroy(queue);
+
+	return result;
+}
+
+
+/* a consumer that waits in dequeue() on an empty queue and records what it returned */
+static void* waiting_consumer(void *context)
+{
+	struct QueueThread *arguments = (struct QueueThread*)context;
+
+	arguments->failed = nds_concurrent_queue_dequeue(arguments->queue, NULL) != NDS_ERROR;
+
+	return NULL;
+}
+
+
+/**
+ * Unit tests for the nds_concurrent_queue_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_concurrent_queue_new()
+ */
+int test_1_nds_concurrent_queue_new()
+{
+	/* new() should refuse elements without size and queues without room */
+	return nds_concurrent_queue_new(0, 16) != NULL || nds_concurrent_queue_new(sizeof(int), 0) != NULL ||
+		nds_concurrent_queue_new_with_allocator(sizeof(int), 16, 0, NULL) != NULL || nds_concurrent_queue_new((size_t)-1, 16) != NULL;
+}
+
+
+/**
+ * Test 2 - verify if a new queue is empty and its capacity is rounded up to a power of two (at least 2)
+ */
+int test_2_nds_concurrent_queue_new()
+{
+	NdsConcurrentQueue *queue = nds_concurrent_queue_new(sizeof(int), 5);
+	int result = 0;
+
+	if (!queue || nds_concurrent_queue_capacity(queue) != 8 || nds_concurrent_queue_size(queue) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_queue_destroy(queue);
+
+	queue = nds_concurrent_queue_new(sizeof(int), 1);
+	if (!queue || nds_concurrent_queue_capacity(queue) != 2)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_queue_new_with_allocator() function.
+ */
+
+/**
+ * Test 1 - verify if all the memory of the queue comes from the allocator
+ */
+int test_1_nds_concurrent_queue_new_with_allocator()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsConcurrentQueue *queue;
+	int element = 3, result = 0;
+
+	allocator = counting_allocator(&usage);
+	queue = nds_concurrent_queue_new_with_allocator(sizeof(int), 64, 1, &allocator);
+
+	if (!queue || usage.allocations != 2)
+		result = 1;
+
+	/* the operations do not allocate */
+	if (nds_concurrent_queue_enqueue(queue, &element) != NDS_OK || nds_concurrent_queue_dequeue(queue, &element) != NDS_OK || element != 3 || usage.allocations != 2)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_queue_destroy() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_concurrent_queue_destroy()
+ */
+int test_1_nds_concurrent_queue_destroy()
+{
+	/* destroy() should ignore invalid queues */
+	nds_concurrent_queue_destroy(NULL);
+
+	return nds_concurrent_queue_size(NULL) != -1 || nds_concurrent_queue_capacity(NULL) != -1;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_queue_try_enqueue() function.
+ */
+
+/**
+ * Test 1 - verify if try_enqueue() refuses a full queue
+ */
+int test_1_nds_concurrent_queue_try_enqueue()
+{
+	NdsConcurrentQueue *queue = nds_concurrent_queue_new(sizeof(int), 4);
+	int i, result = 0;
+
+	if (!queue)
+		return 1;
+
+	if (nds_concurrent_queue_try_enqueue(NULL, &i) != -1 || nds_concurrent_queue_try_enqueue(queue, NULL) != -1)
+		result = 1;
+
+	for (i = 0; i < 4; i++)
+		if (nds_concurrent_queue_try_enqueue(queue, &i) != 1)
+			result = 1;
+
+	if (nds_concurrent_queue_try_enqueue(queue, &i) != 0 || nds_concurrent_queue_size(queue) != 4)
+		result = 1;
+
+	/* a removed element makes room for another one */
+	if (nds_concurrent_queue_try_dequeue(queue, NULL) != 1 || nds_concurrent_queue_try_enqueue(queue, &i) != 1)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if elements of odd sizes keep their bytes
+ */
+int test_2_nds_concurrent_queue_try_enqueue()
+{
+	NdsConcurrentQueue *queue = nds_concurrent_queue_new(13, 8);
+	char element[13], out[13];
+	int i, result = 0;
+
+	if (!queue)
+		return 1;
+
+	for (i = 0; i < 40 && !result; i++)
+	{
+		memset(element, 'a' + i % 26, sizeof(element));
+		if (nds_concurrent_queue_try_enqueue(queue, element) != 1 || nds_concurrent_queue_try_dequeue(queue, out) != 1 || memcmp(element, out, sizeof(out)) != 0)
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_concurrent_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if many producers and consumers move every element once with the try functions
+ */
+int test_3_nds_concurrent_queue_try_enqueue()
+{
+	return run_threads(nds_concurrent_queue_new(sizeof(uint32_t), 64), 0);
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_queue_try_enqueue_n() function.
+ */
+
+/**
+ * Test 1 - verify if try_enqueue_n() adds only the elements that fit
+ */
+int test_1_nds_concurrent_queue_try_enqueue_n()
+{
+	NdsConcurrentQueue *queue = nds_concurrent_queue_new(sizeof(int), 8);
+	int elements[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }, i, element, result = 0;
+
+	if (!queue)
+		return 1;
+
+	if (nds_concurrent_queue_try_enqueue_n(queue, NULL, 3) != -1 || nds_concurrent_queue_try_enqueue_n(queue, NULL, 0) != 0 ||
+		nds_concurrent_queue_try_enqueue_n(queue, elements, 5) != 5 || nds_concurrent_queue_try_enqueue_n(queue, elements + 5, 7) != 3)
+		result = 1;
+
+	if (nds_concurrent_queue_try_enqueue_n(queue, elements, 1) != 0 || nds_concurrent_queue_size(queue) != 8)
+		result = 1;
+
+	for (i = 0; i < 8; i++)
+		if (nds_concurrent_queue_try_dequeue(queue, &element) != 1 || element != i)
+			result = 1;
+
+	/* cleanup */
+	nds_concurrent_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_queue_try_dequeue() function.
+ */
+
+/**
+ * Test 1 - verify if try_dequeue() removes the elements in order and refuses an empty queue
+ */
+int test_1_nds_concurrent_queue_try_dequeue()
+{
+	NdsConcurrentQueue *queue = nds_concurrent_queue_new(sizeof(int), 4);
+	int i, element, result = 0;
+
+	if (!queue)
+		return 1;
+
+	if (nds_concurrent_queue_try_dequeue(queue, &element) != 0 || nds_concurrent_queue_try_dequeue(NULL, &element) != -1)
+		result = 1;
+
+	/* the positions go around the buffer several times */
+	for (i = 0; i < 50; i++)
+		if (nds_concurrent_queue_try_enqueue(queue, &i) != 1 || nds_concurrent_queue_try_dequeue(queue, &element) != 1 || element != i)
+			result = 1;
+
+	if (nds_concurrent_queue_try_dequeue(queue, &element) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_queue_try_dequeue_n() function.
+ */
+
+/**
+ * Test 1 - verify if try_dequeue_n() removes at most the elements of the queue, across the end of the buffer
+ */
+int test_1_nds_concurrent_queue_try_dequeue_n()
+{
+	NdsConcurrentQueue *queue = nds_concurrent_queue_new(sizeof(int), 8);
+	int elements[8] = { 0, 1, 2, 3, 4, 5, 6, 7 }, out[8] = { 0 }, result = 0;
+
+	if (!queue)
+		return 1;
+
+	/* the elements 0 .. 5 start at the slot 6 and wrap after the slot 7 */
+	nds_concurrent_queue_try_enqueue_n(queue, elements, 6);
+	nds_concurrent_queue_try_dequeue_n(queue, NULL, 6);
+	nds_concurrent_queue_try_enqueue_n(queue, elements, 6);
+
+	if (nds_concurrent_queue_try_dequeue_n(NULL, out, 8) != -1 || nds_concurrent_queue_try_dequeue_n(queue, out, 2) != 2 ||
+		nds_concurrent_queue_try_dequeue_n(queue, out + 2, 8) != 4 || memcmp(out, elements, 6 * sizeof(int)) != 0)
+		result = 1;
+
+	if (nds_concurrent_queue_try_dequeue_n(queue, out, 8) != 0 || nds_concurrent_queue_size(queue) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if many producers and consumers move every element once with the batched functions
+ */
+int test_2_nds_concurrent_queue_try_dequeue_n()
+{
+	return run_threads(nds_concurrent_queue_new(sizeof(uint32_t), 64), 16);
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_queue_enqueue() function.
+ */
+
+/**
+ * Test 1 - verify if the blocking functions refuse a non-blocking queue
+ */
+int test_1_nds_concurrent_queue_enqueue()
+{
+	NdsConcurrentQueue *queue = nds_concurrent_queue_new(sizeof(int), 4);
+	int element = 1, result = 0;
+
+	if (!queue)
+		return 1;
+
+	if (nds_concurrent_queue_enqueue(queue, &element) != NDS_INVALID_PARAM_ERROR || nds_concurrent_queue_dequeue(queue, &element) != NDS_INVALID_PARAM_ERROR ||
+		nds_concurrent_queue_close(queue) != NDS_INVALID_PARAM_ERROR || nds_concurrent_queue_enqueue(NULL, &element) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if many producers and consumers move every element once through a small blocking queue
+ */
+int test_2_nds_concurrent_queue_enqueue()
+{
+	return run_threads(nds_concurrent_queue_new_with_allocator(sizeof(uint32_t), 4, 1, nds_allocator_default()), -1);
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_queue_dequeue() function.
+ */
+
+/**
+ * Test 1 - verify if dequeue() returns the elements of a closed queue before it fails
+ */
+int test_1_nds_concurrent_queue_dequeue()
+{
+	NdsConcurrentQueue *queue = nds_concurrent_queue_new_with_allocator(sizeof(int), 4, 1, nds_allocator_default());
+	int element = 9, result = 0;
+
+	if (!queue)
+		return 1;
+
+	nds_concurrent_queue_enqueue(queue, &element);
+	nds_concurrent_queue_close(queue);
+
+	if (nds_concurrent_queue_enqueue(queue, &element) != NDS_ERROR || nds_concurrent_queue_dequeue(queue, &element) != NDS_OK || element != 9 ||
+		nds_concurrent_queue_dequeue(queue, &element) != NDS_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_queue_close() function.
+ */
+
+/**
+ * Test 1 - verify if close() wakes a consumer that waits on an empty queue
+ */
+int test_1_nds_concurrent_queue_close()
+{
+	NdsConcurrentQueue *queue = nds_concurrent_queue_new_with_allocator(sizeof(int), 4, 1, nds_allocator_default());
+	struct timespec pause = { 0, 20000000 };
+	struct QueueThread consumer;
+	pthread_t thread;
+
+	if (!queue)
+		return 1;
+
+	memset(&consumer, 0, sizeof(struct QueueThread));
+	consumer.queue = queue;
+	consumer.failed = 1;
+
+	/* the consumer should be asleep by the time the queue is closed */
+	pthread_create(&thread, NULL, waiting_consumer, &consumer);
+	nanosleep(&pause, NULL);
+	nds_concurrent_queue_close(queue);
+	pthread_join(thread, NULL);
+
+	/* cleanup */
+	nds_concurrent_queue_destroy(queue);
+
+	return consumer.failed;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndsconcurrentqueuetests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_concurrent_queue_new();
+
+		case 2:
+			return test_2_nds_concurrent_queue_new();
+
+		case 3:
+			return test_1_nds_concurrent_queue_new_with_allocator();
+
+		case 4:
+			return test_1_nds_concurrent_queue_destroy();
+
+		case 5:
+			return test_1_nds_concurrent_queue_try_enqueue();
+
+		case 6:
+			return test_2_nds_concurrent_queue_try_enqueue();
+
+		case 7:
+			return test_3_nds_concurrent_queue_try_enqueue();
+
+		case 8:
+			return test_1_nds_concurrent_queue_try_enqueue_n();
+
+		case 9:
+			return test_1_nds_concurrent_queue_try_dequeue();
+
+		case 10:
+			return test_1_nds_concurrent_queue_try_dequeue_n();
+
+		case 11:
+			return test_2_nds_concurrent_queue_try_dequeue_n();
+
+		case 12:
+			return test_1_nds_concurrent_queue_enqueue();
+
+		case 13:
+			return test_2_nds_concurrent_queue_enqueue();
+
+		case 14:
+			return test_1_nds_concurrent_queue_dequeue();
+
+		case 15:
+			return test_1_nds_concurrent_queue_close();
+
+		default:
+			printf("No tests were found with the given ID!\n");
+			return 1;
+	}
+}
@@ -0,0 +1,629 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file defines various unit tests for the functionality of the
+ * NdsConcurrentVector data structure from the NDS library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ndstesthelpers.h"
+
+#include <nds/ndsconcurrentvector.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* number of threads and number of elements pushed by every thread in the concurrent tests */
+#define PUSH_THREADS 4
+#define PUSH_ELEMENTS 20000
+
+
+/* arguments of a thread that pushes elements */
+struct PushThread
+{
+	NdsConcurrentVector *vector;
+	int thread;
+	int failed;
+};
+
+
+/* pushes PUSH_ELEMENTS elements whose value encodes the thread and their order */
+static void* push_thread(void *context)
+{
+	struct PushThread *arguments = (struct PushThread*)context;
+	int i, value;
+
+	for (i = 0; i < PUSH_ELEMENTS; i++)
+	{
+		value = arguments->thread * PUSH_ELEMENTS + i;
+		if (nds_concurrent_vector_push_back(arguments->vector, &value) < 0)
+			arguments->failed = 1;
+	}
+
+	return NULL;
+}
+
+
+/* counts the visited elements and adds their values in the two longs given as context */
+static void sum_element(void *element, void *context)
+{
+	((long*)context)[0]++;
+	((long*)context)[1] += *(int*)element;
+}
+
+
+/* marks the value of the visited element in the array of flags given as context */
+static void mark_element(void *element, void *context)
+{
+	((unsigned char*)context)[*(int*)element]++;
+}
+
+
+/**
+ * Unit tests for the nds_concurrent_vector_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_concurrent_vector_new()
+ */
+int test_1_nds_concurrent_vector_new()
+{
+	NdsConcurrentVector *vector = nds_concurrent_vector_new(0);
+
+	/* new() should refuse elements without size */
+	return vector != NULL;
+}
+
+
+/**
+ * Test 2 - verify if a new vector is empty
+ */
+int test_2_nds_concurrent_vector_new()
+{
+	NdsConcurrentVector *vector = nds_concurrent_vector_new(sizeof(int));
+	int result = 0;
+
+	if (!vector || nds_concurrent_vector_size(vector) != 0 || nds_concurrent_vector_at(vector, 0) != NULL)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_vector_new_with_allocator() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_concurrent_vector_new_with_allocator()
+ */
+int test_1_nds_concurrent_vector_new_with_allocator()
+{
+	NdsAllocator allocator = *nds_allocator_default();
+	int result = 0;
+
+	if (nds_concurrent_vector_new_with_allocator(sizeof(int), 0, &allocator) != NULL ||
+		nds_concurrent_vector_new_with_allocator(sizeof(int), 16, NULL) != NULL)
+		result = 1;
+
+	allocator.alloc = NULL;
+	if (nds_concurrent_vector_new_with_allocator(sizeof(int), 16, &allocator) != NULL)
+		result = 1;
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if a first segment that is not a power of two is rounded up
+ */
+int test_2_nds_concurrent_vector_new_with_allocator()
+{
+	NdsConcurrentVector *vector = nds_concurrent_vector_new_with_allocator(sizeof(int), 3, nds_allocator_default());
+	int *first, i, result = 0;
+
+	for (i = 0; i < 4; i++)
+		nds_concurrent_vector_push_back(vector, &i);
+
+	/* the 4 elements share the first segment, so they are contiguous */
+	first = (int*)nds_concurrent_vector_at(vector, 0);
+	for (i = 0; i < 4; i++)
+		if ((int*)nds_concurrent_vector_at(vector, i) != first + i || first[i] != i)
+			result = 1;
+
+	/* cleanup */
+	nds_concurrent_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_vector_destroy() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_concurrent_vector_destroy()
+ */
+int test_1_nds_concurrent_vector_destroy()
+{
+	/* destroy() should ignore NULL */
+	nds_concurrent_vector_destroy(NULL);
+
+	return 0;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_vector_size() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_concurrent_vector_size()
+ */
+int test_1_nds_concurrent_vector_size()
+{
+	/* size() should return -1 for an invalid vector */
+	return nds_concurrent_vector_size(NULL) != -1;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_vector_reserve() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_concurrent_vector_reserve()
+ */
+int test_1_nds_concurrent_vector_reserve()
+{
+	NdsConcurrentVector *vector = nds_concurrent_vector_new(sizeof(int));
+	int result = 0;
+
+	if (nds_concurrent_vector_reserve(NULL, 10) != NDS_INVALID_PARAM_ERROR || nds_concurrent_vector_reserve(vector, 0) != NDS_OK ||
+		nds_concurrent_vector_reserve(vector, (size_t)-1) != NDS_MEM_ALLOC_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the pushes into reserved segments do not allocate memory
+ */
+int test_2_nds_concurrent_vector_reserve()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsConcurrentVector *vector;
+	int i, result = 0;
+
+	allocator = counting_allocator(&usage);
+	vector = nds_concurrent_vector_new_with_allocator(sizeof(int), 16, &allocator);
+
+	if (nds_concurrent_vector_reserve(vector, 1000) != NDS_OK)
+		result = 1;
+
+	/* the block of the vector and the segments of 16, 32, ..., 512 elements */
+	if (usage.allocations != 7)
+		result = 1;
+
+	for (i = 0; i < 1000; i++)
+		if (nds_concurrent_vector_push_back(vector, &i) != i)
+			result = 1;
+
+	if (usage.allocations != 7 || nds_concurrent_vector_size(vector) != 1000)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 1 - sanity check for nds_concurrent_vector_push_back()
+ */
+int test_1_nds_concurrent_vector_push_back()
+{
+	NdsConcurrentVector *vector = nds_concurrent_vector_new(sizeof(int));
+	int value = 1, result = 0;
+
+	if (nds_concurrent_vector_push_back(NULL, &value) != -1 || nds_concurrent_vector_push_back(vector, NULL) != -1)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the addresses of the elements stay the same while the vector grows
+ */
+int test_2_nds_concurrent_vector_push_back()
+{
+	NdsConcurrentVector *vector = nds_concurrent_vector_new(sizeof(double));
+	double *addresses[100], value;
+	int i, result = 0;
+
+	for (i = 0; i < 100000; i++)
+	{
+		value = i * 0.5;
+		if (nds_concurrent_vector_push_back(vector, &value) != i)
+			result = 1;
+
+		if (i < 100)
+			addresses[i] = (double*)nds_concurrent_vector_at(vector, i);
+	}
+
+	for (i = 0; i < 100; i++)
+		if ((double*)nds_concurrent_vector_at(vector, i) != addresses[i] || *addresses[i] != i * 0.5)
+			result = 1;
+
+	for (i = 0; i < 100000; i++)
+		if (nds_concurrent_vector_get(vector, i, &value) != NDS_OK || value != i * 0.5)
+			result = 1;
+
+	/* cleanup */
+	nds_concurrent_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if the elements pushed by several threads are all stored once
+ */
+int test_3_nds_concurrent_vector_push_back()
+{
+	NdsConcurrentVector *vector = nds_concurrent_vector_new(sizeof(int));
+	unsigned char *seen = (unsigned char*)calloc(PUSH_THREADS * PUSH_ELEMENTS, 1);
+	struct PushThread arguments[PUSH_THREADS];
+	pthread_t threads[PUSH_THREADS];
+	int i, last[PUSH_THREADS], value, result = 0;
+
+	for (i = 0; i < PUSH_THREADS; i++)
+	{
+		arguments[i].vector = vector;
+		arguments[i].thread = i;
+		arguments[i].failed = 0;
+		pthread_create(&threads[i], NULL, push_thread, &arguments[i]);
+	}
+
+	for (i = 0; i < PUSH_THREADS; i++)
+	{
+		pthread_join(threads[i], NULL);
+		result |= arguments[i].failed;
+		last[i] = -1;
+	}
+
+	if (nds_concurrent_vector_size(vector) != PUSH_THREADS * PUSH_ELEMENTS)
+		result = 1;
+
+	/* every value appears once and the elements of a thread keep the order they were pushed in */
+	for (i = 0; i < PUSH_THREADS * PUSH_ELEMENTS; i++)
+	{
+		if (nds_concurrent_vector_get(vector, i, &value) != NDS_OK || seen[value]++ != 0)
+		{
+			result = 1;
+			break;
+		}
+
+		if (value % PUSH_ELEMENTS <= last[value / PUSH_ELEMENTS])
+			result = 1;
+		last[value / PUSH_ELEMENTS] = value % PUSH_ELEMENTS;
+	}
+
+	/* cleanup */
+	free(seen);
+	nds_concurrent_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 4 - verify if a push whose segment can not be allocated leaves no hole in the indexes
+ */
+int test_4_nds_concurrent_vector_push_back()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsConcurrentVector *vector;
+	long visited[2] = { 0, 0 };
+	int i, result = 0;
+
+	allocator = counting_allocator(&usage);
+	vector = nds_concurrent_vector_new_with_allocator(sizeof(int), 16, &allocator);
+
+	/* the block of the vector and the first segment are the only allocations that succeed */
+	usage.limit = 2;
+
+	for (i = 0; i < 16; i++)
+		if (nds_concurrent_vector_push_back(vector, &i) != i)
+			result = 1;
+
+	if (nds_concurrent_vector_push_back(vector, &i) != -1 || nds_concurrent_vector_size(vector) != 16)
+		result = 1;
+
+	/* once the memory is available again, the next push takes the index that failed */
+	usage.limit = -1;
+
+	if (nds_concurrent_vector_push_back(vector, &i) != 16 || nds_concurrent_vector_size(vector) != 17 || nds_concurrent_vector_at(vector, 16) == NULL)
+		result = 1;
+
+	nds_concurrent_vector_for_each(vector, sum_element, visited);
+	if (visited[0] != 17 || visited[1] != 16 * 17 / 2)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_vector_at() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_concurrent_vector_at()
+ */
+int test_1_nds_concurrent_vector_at()
+{
+	NdsConcurrentVector *vector = nds_concurrent_vector_new(sizeof(int));
+	int value = 7, result = 0;
+
+	nds_concurrent_vector_push_back(vector, &value);
+
+	if (nds_concurrent_vector_at(NULL, 0) != NULL || nds_concurrent_vector_at(vector, 1) != NULL || *(int*)nds_concurrent_vector_at(vector, 0) != 7)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_vector_get() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_concurrent_vector_get()
+ */
+int test_1_nds_concurrent_vector_get()
+{
+	NdsConcurrentVector *vector = nds_concurrent_vector_new(sizeof(int));
+	int value = 7, result = 0;
+
+	nds_concurrent_vector_push_back(vector, &value);
+
+	if (nds_concurrent_vector_get(NULL, 0, &value) != NDS_INVALID_PARAM_ERROR || nds_concurrent_vector_get(vector, 0, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_concurrent_vector_get(vector, 1, &value) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_vector_for_each() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_concurrent_vector_for_each()
+ */
+int test_1_nds_concurrent_vector_for_each()
+{
+	NdsConcurrentVector *vector = nds_concurrent_vector_new(sizeof(int));
+	long sums[2] = { 0, 0 };
+	int result = 0;
+
+	if (nds_concurrent_vector_for_each(NULL, sum_element, sums) != NDS_INVALID_PARAM_ERROR || nds_concurrent_vector_for_each(vector, NULL, sums) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* an empty vector calls the function for no element */
+	if (nds_concurrent_vector_for_each(vector, sum_element, sums) != NDS_OK || sums[0] != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the elements are visited in the order of their indexes
+ */
+int test_2_nds_concurrent_vector_for_each()
+{
+	NdsConcurrentVector *vector = nds_concurrent_vector_new_with_allocator(sizeof(int), 1, nds_allocator_default());
+	unsigned char seen[1000];
+	long sums[2] = { 0, 0 };
+	int i, result = 0;
+
+	memset(seen, 0, sizeof(seen));
+
+	for (i = 0; i < 1000; i++)
+		nds_concurrent_vector_push_back(vector, &i);
+
+	if (nds_concurrent_vector_for_each(vector, sum_element, sums) != NDS_OK || sums[0] != 1000 || sums[1] != 999 * 1000 / 2)
+		result = 1;
+
+	nds_concurrent_vector_for_each(vector, mark_element, seen);
+	for (i = 0; i < 1000; i++)
+		if (seen[i] != 1)
+			result = 1;
+
+	/* cleanup */
+	nds_concurrent_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if readers iterate the vector while other threads push elements
+ */
+int test_3_nds_concurrent_vector_for_each()
+{
+	NdsConcurrentVector *vector = nds_concurrent_vector_new(sizeof(int));
+	struct PushThread arguments[PUSH_THREADS];
+	pthread_t threads[PUSH_THREADS];
+	long sums[2], previous = 0;
+	int i, result = 0;
+
+	for (i = 0; i < PUSH_THREADS; i++)
+	{
+		arguments[i].vector = vector;
+		arguments[i].thread = i;
+		arguments[i].failed = 0;
+		pthread_create(&threads[i], NULL, push_thread, &arguments[i]);
+	}
+
+	/* the number of visited elements never goes down and the size is a lower bound of it */
+	while (previous < PUSH_THREADS * PUSH_ELEMENTS)
+	{
+		ssize_t size = nds_concurrent_vector_size(vector);
+
+		sums[0] = sums[1] = 0;
+		nds_concurrent_vector_for_each(vector, sum_element, sums);
+
+		if (sums[0] < previous || sums[0] < size)
+		{
+			result = 1;
+			break;
+		}
+		previous = sums[0];
+	}
+
+	for (i = 0; i < PUSH_THREADS; i++)
+	{
+		pthread_join(threads[i], NULL);
+		result |= arguments[i].failed;
+	}
+
+	/* cleanup */
+	nds_concurrent_vector_destroy(vector);
+
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndsconcurrentvectortests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_concurrent_vector_new();
+
+		case 2:
+			return test_2_nds_concurrent_vector_new();
+
+		case 3:
+			return test_1_nds_concurrent_vector_new_with_allocator();
+
+		case 4:
+			return test_2_nds_concurrent_vector_new_with_allocator();
+
+		case 5:
+			return test_1_nds_concurrent_vector_destroy();
+
+		case 6:
+			return test_1_nds_concurrent_vector_size();
+
+		case 7:
+			return test_1_nds_concurrent_vector_reserve();
+
+		case 8:
+			return test_2_nds_concurrent_vector_reserve();
+
+		case 9:
+			return test_1_nds_concurrent_vector_push_back();
+
+		case 10:
+			return test_2_nds_concurrent_vector_push_back();
+
+		case 11:
+			return test_3_nds_concurrent_vector_push_back();
+
+		case 12:
+			return test_1_nds_concurrent_vector_at();
+
+		case 13:
+			return test_1_nds_concurrent_vector_get();
+
+		case 14:
+			return test_1_nds_concurrent_vector_for_each();
+
+		case 15:
+			return test_2_nds_concurrent_vector_for_each();
+
+		case 16:
+			return test_3_nds_concurrent_vector_for_each();
+
+		case 17:
+			return test_4_nds_concurrent_vector_push_back();
+
+		default:
+			printf("No tests were found with the given ID!\n");
+			return 1;
+	}
+}
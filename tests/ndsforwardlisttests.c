@@ -0,0 +1,825 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file defines various unit tests for the functionality of the
+ * NdsForwardList and NdsConcurrentForwardList data structures from the NDS
+ * library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ndstesthelpers.h"
+
+#include <nds/ndsforwardlist.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* number of threads and number of operations done by every thread in the concurrent tests */
+#define THREADS 4
+#define THREAD_OPERATIONS 100000
+
+
+/* a structure linked in the lists of the tests */
+struct Person
+{
+	int age;
+	NdsForwardLink link;
+	char name[12];
+};
+
+
+/* a structure recycled between the threads of the concurrent tests */
+struct Token
+{
+	NdsForwardLink link;
+	uint64_t uses;
+	int owner;
+};
+
+
+/* gives every person a different age, the position in the array */
+static void people_init(struct Person *people, int count)
+{
+	int i;
+
+	memset(people, 0, (size_t)count * sizeof(struct Person));
+
+	for (i = 0; i < count; i++)
+	{
+		people[i].age = i;
+		snprintf(people[i].name, sizeof(people[i].name), "person %d", i);
+	}
+}
+
+
+/* checks that the list links the people of the given ages in this order and that its last link is the last of them */
+static int list_check(NdsForwardList *list, const int *ages, int count)
+{
+	NdsForwardLink *link = nds_forward_list_first(list), *last = NULL;
+	int i;
+
+	if (nds_forward_list_size(list) != count)
+		return 1;
+
+	for (i = 0; i < count; i++, link = link->next)
+	{
+		if (link == NULL || NDS_CONTAINER_OF(link, struct Person, link)->age != ages[i])
+			return 1;
+
+		last = link;
+	}
+
+	return link != NULL || nds_forward_list_last(list) != last;
+}
+
+
+/* arguments of the threads of the concurrent tests */
+struct ListThread
+{
+	NdsConcurrentForwardList *list;
+	int thread;
+
+	/* tokens pushed and popped by the thread, and whether it saw a token used by two threads at once */
+	uint64_t pushed;
+	uint64_t popped;
+	int failed;
+};
+
+
+/* pops a token, marks it as its own while it holds it and pushes it back */
+static void* recycle_thread(void *context)
+{
+	struct ListThread *arguments = (struct ListThread*)context;
+	struct Token *token;
+	NdsForwardLink *link;
+	uint64_t i;
+
+	for (i = 0; i < THREAD_OPERATIONS; i++)
+	{
+		link = nds_concurrent_forward_list_pop_front(arguments->list);
+
+		/* the threads may share the processor, so we give the owners of the tokens the chance to push them back */
+		if (link == NULL)
+		{
+			sched_yield();
+			continue;
+		}
+
+		token = NDS_CONTAINER_OF(link, struct Token, link);
+
+		/* a token popped by two threads at once would be seen with the mark of the other one */
+		if (token->owner != -1)
+			arguments->failed = 1;
+
+		token->owner = arguments->thread;
+		token->uses++;
+		arguments->popped++;
+
+		if (token->owner != arguments->thread)
+			arguments->failed = 1;
+
+		token->owner = -1;
+
+		if (nds_concurrent_forward_list_push_front(arguments->list, link) != NDS_OK)
+			arguments->failed = 1;
+	}
+
+	return NULL;
+}
+
+
+/* runs the given function in THREADS threads sharing the list, returning 1 if a thread failed */
+static int run_threads(NdsConcurrentForwardList *list, void *(*function)(void*), struct ListThread *arguments)
+{
+	pthread_t threads[THREADS];
+	int i, result = 0;
+
+	for (i = 0; i < THREADS; i++)
+	{
+		memset(&arguments[i], 0, sizeof(arguments[i]));
+		arguments[i].list = list;
+		arguments[i].thread = i;
+
+		if (pthread_create(&threads[i], NULL, function, &arguments[i]) != 0)
+			return 1;
+	}
+
+	for (i = 0; i < THREADS; i++)
+	{
+		pthread_join(threads[i], NULL);
+		result |= arguments[i].failed;
+	}
+
+	return result;
+}
+
+
+/**
+ * Unit tests for the nds_forward_list_new() function.
+ */
+
+/**
+ * Test 1 - verify if a new list is empty
+ */
+int test_1_nds_forward_list_new()
+{
+	NdsForwardList *list = nds_forward_list_new();
+	int result = 0;
+
+	if (!list || list_check(list, NULL, 0) || nds_forward_list_pop_front(list) != NULL || nds_forward_list_remove_after(list, NULL) != NULL)
+		result = 1;
+
+	/* cleanup */
+	nds_forward_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_forward_list_new_with_allocator() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_forward_list_new_with_allocator()
+ */
+int test_1_nds_forward_list_new_with_allocator()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+
+	allocator = counting_allocator(&usage);
+	allocator.realloc = NULL;
+	allocator.free = NULL;
+
+	/* new_with_allocator() should refuse a missing or incomplete allocator */
+	return nds_forward_list_new_with_allocator(NULL) != NULL || nds_forward_list_new_with_allocator(&allocator) != NULL || usage.allocations != 0;
+}
+
+
+/**
+ * Test 2 - verify if linking structures allocates nothing
+ */
+int test_2_nds_forward_list_new_with_allocator()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	struct Person people[100];
+	NdsForwardList *list;
+	int i, result = 0;
+
+	allocator = counting_allocator(&usage);
+	people_init(people, 100);
+
+	list = nds_forward_list_new_with_allocator(&allocator);
+	if (!list)
+		return 1;
+
+	for (i = 0; i < 100 && !result; i++)
+		if (nds_forward_list_push_back(list, &people[i].link) != NDS_OK)
+			result = 1;
+
+	/* only the block of the list itself was allocated */
+	if (usage.allocations != 1 || nds_forward_list_size(list) != 100)
+		result = 1;
+
+	/* cleanup */
+	nds_forward_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_forward_list_size() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_forward_list_size()
+ */
+int test_1_nds_forward_list_size()
+{
+	NdsForwardList list = { NULL };
+
+	return nds_forward_list_size(NULL) != -1 || nds_forward_list_size(&list) != -1 || nds_forward_list_first(&list) != NULL ||
+		nds_forward_list_last(NULL) != NULL;
+}
+
+
+
+/**
+ * Unit tests for the nds_forward_list_push_front() function.
+ */
+
+/**
+ * Test 1 - verify if the structures pushed at both ends come back through NDS_CONTAINER_OF()
+ */
+int test_1_nds_forward_list_push_front()
+{
+	NdsForwardList *list = nds_forward_list_new();
+	struct Person people[6], *person;
+	int ages[] = { 4, 2, 0, 1, 3, 5 };
+	int i, result = 0;
+
+	people_init(people, 6);
+
+	for (i = 0; i < 6 && !result; i++)
+		if ((i % 2 ? nds_forward_list_push_back(list, &people[i].link) : nds_forward_list_push_front(list, &people[i].link)) != NDS_OK)
+			result = 1;
+
+	if (list_check(list, ages, 6))
+		result = 1;
+
+	/* the whole structure is reached from its link */
+	person = NDS_CONTAINER_OF(nds_forward_list_first(list), struct Person, link);
+	if (person != &people[4] || strcmp(person->name, "person 4") != 0)
+		result = 1;
+
+	if (nds_forward_list_push_front(list, NULL) != NDS_INVALID_PARAM_ERROR || nds_forward_list_push_back(NULL, &people[0].link) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_forward_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_forward_list_pop_front() function.
+ */
+
+/**
+ * Test 1 - verify if the list works as a FIFO queue of structures
+ */
+int test_1_nds_forward_list_pop_front()
+{
+	NdsForwardList *list = nds_forward_list_new();
+	struct Person people[50];
+	NdsForwardLink *link;
+	int i, next = 0, result = 0;
+
+	people_init(people, 50);
+
+	/* two pushes for every pop, then the rest of the pops */
+	for (i = 0; i < 75 && !result; i++)
+	{
+		if (i < 50)
+			nds_forward_list_push_back(list, &people[i].link);
+
+		if (i % 2 || i >= 50)
+		{
+			link = nds_forward_list_pop_front(list);
+			if (link == NULL || link->next != NULL || NDS_CONTAINER_OF(link, struct Person, link)->age != next++)
+				result = 1;
+		}
+	}
+
+	if (next != 50 || list_check(list, NULL, 0) || nds_forward_list_pop_front(list) != NULL)
+		result = 1;
+
+	/* the emptied list appends again */
+	nds_forward_list_push_back(list, &people[7].link);
+	if (list_check(list, &people[7].age, 1))
+		result = 1;
+
+	/* cleanup */
+	nds_forward_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_forward_list_insert_after() function.
+ */
+
+/**
+ * Test 1 - verify if structures are linked after any position
+ */
+int test_1_nds_forward_list_insert_after()
+{
+	NdsForwardList *list = nds_forward_list_new();
+	struct Person people[5];
+	int ages[] = { 3, 0, 2, 1, 4 };
+	int result = 0;
+
+	people_init(people, 5);
+
+	nds_forward_list_insert_after(list, NULL, &people[0].link);
+	nds_forward_list_insert_after(list, &people[0].link, &people[1].link);
+	nds_forward_list_insert_after(list, &people[0].link, &people[2].link);
+	nds_forward_list_insert_after(list, NULL, &people[3].link);
+
+	/* inserting after the last link moves the end of the list */
+	if (nds_forward_list_insert_after(list, &people[1].link, &people[4].link) != NDS_OK || list_check(list, ages, 5))
+		result = 1;
+
+	if (nds_forward_list_insert_after(list, &people[4].link, &people[4].link) != NDS_INVALID_PARAM_ERROR ||
+		nds_forward_list_insert_after(list, &people[4].link, NULL) != NDS_INVALID_PARAM_ERROR || list_check(list, ages, 5))
+		result = 1;
+
+	/* cleanup */
+	nds_forward_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_forward_list_remove_after() function.
+ */
+
+/**
+ * Test 1 - verify if the links that follow any position are unlinked
+ */
+int test_1_nds_forward_list_remove_after()
+{
+	NdsForwardList *list = nds_forward_list_new();
+	struct Person people[5];
+	int ages[] = { 1, 3 };
+	int i, result = 0;
+
+	people_init(people, 5);
+
+	for (i = 0; i < 5; i++)
+		nds_forward_list_push_back(list, &people[i].link);
+
+	/* removing the last link moves the end of the list back */
+	if (nds_forward_list_remove_after(list, &people[3].link) != &people[4].link || nds_forward_list_remove_after(list, &people[3].link) != NULL ||
+		nds_forward_list_remove_after(list, &people[1].link) != &people[2].link || nds_forward_list_remove_after(list, NULL) != &people[0].link)
+		result = 1;
+
+	if (list_check(list, ages, 2))
+		result = 1;
+
+	/* the end of the list keeps working after the removals */
+	nds_forward_list_push_back(list, &people[0].link);
+	if (nds_forward_list_last(list) != &people[0].link || people[3].link.next != &people[0].link)
+		result = 1;
+
+	/* cleanup */
+	nds_forward_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_forward_list_remove() function.
+ */
+
+/**
+ * Test 1 - verify if a structure is found and unlinked
+ */
+int test_1_nds_forward_list_remove()
+{
+	NdsForwardList *list = nds_forward_list_new();
+	struct Person people[4];
+	int ages[] = { 1, 2 };
+	int i, result = 0;
+
+	people_init(people, 4);
+
+	for (i = 0; i < 3; i++)
+		nds_forward_list_push_back(list, &people[i].link);
+
+	/* the last person was never linked */
+	if (nds_forward_list_remove(list, &people[3].link) != NDS_ERROR || nds_forward_list_remove(list, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_forward_list_remove(list, &people[0].link) != NDS_OK || list_check(list, ages, 2))
+		result = 1;
+
+	if (nds_forward_list_remove(list, &people[2].link) != NDS_OK || nds_forward_list_remove(list, &people[1].link) != NDS_OK ||
+		list_check(list, NULL, 0))
+		result = 1;
+
+	/* cleanup */
+	nds_forward_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_forward_list_splice_back() function.
+ */
+
+/**
+ * Test 1 - verify if all the links of another list are moved to the end
+ */
+int test_1_nds_forward_list_splice_back()
+{
+	NdsForwardList *list = nds_forward_list_new(), *other = nds_forward_list_new();
+	struct Person people[6];
+	int ages[] = { 0, 1, 2, 3, 4, 5 };
+	int i, result = 0;
+
+	people_init(people, 6);
+
+	/* splicing into an empty list and splicing an empty list */
+	for (i = 0; i < 3; i++)
+		nds_forward_list_push_back(other, &people[i].link);
+
+	if (nds_forward_list_splice_back(list, other) != NDS_OK || nds_forward_list_splice_back(list, other) != NDS_OK ||
+		list_check(list, ages, 3) || list_check(other, NULL, 0))
+		result = 1;
+
+	for (i = 3; i < 6; i++)
+		nds_forward_list_push_back(other, &people[i].link);
+
+	if (nds_forward_list_splice_back(list, other) != NDS_OK || list_check(list, ages, 6) || list_check(other, NULL, 0) ||
+		nds_forward_list_splice_back(list, list) != NDS_INVALID_PARAM_ERROR || nds_forward_list_splice_back(list, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_forward_list_destroy(list);
+	nds_forward_list_destroy(other);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_forward_list_reverse() function.
+ */
+
+/**
+ * Test 1 - verify if the order of the links is reversed
+ */
+int test_1_nds_forward_list_reverse()
+{
+	NdsForwardList *list = nds_forward_list_new();
+	struct Person people[5];
+	int ages[] = { 4, 3, 2, 1, 0 };
+	int i, result = 0;
+
+	people_init(people, 5);
+
+	if (nds_forward_list_reverse(list) != NDS_OK || list_check(list, NULL, 0))
+		result = 1;
+
+	for (i = 0; i < 5; i++)
+		nds_forward_list_push_back(list, &people[i].link);
+
+	if (nds_forward_list_reverse(list) != NDS_OK || list_check(list, ages, 5) || nds_forward_list_reverse(NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_forward_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_forward_list_clear() function.
+ */
+
+/**
+ * Test 1 - verify if a cleared list is empty and the structures can be linked again
+ */
+int test_1_nds_forward_list_clear()
+{
+	NdsForwardList *list = nds_forward_list_new();
+	struct Person people[3];
+	int ages[] = { 2, 0 };
+	int i, result = 0;
+
+	people_init(people, 3);
+
+	for (i = 0; i < 3; i++)
+		nds_forward_list_push_front(list, &people[i].link);
+
+	if (nds_forward_list_clear(list) != NDS_OK || list_check(list, NULL, 0) || nds_forward_list_clear(NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	nds_forward_list_push_back(list, &people[2].link);
+	nds_forward_list_push_back(list, &people[0].link);
+
+	if (list_check(list, ages, 2))
+		result = 1;
+
+	/* cleanup */
+	nds_forward_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_forward_list_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_concurrent_forward_list_new()
+ */
+int test_1_nds_concurrent_forward_list_new()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsConcurrentForwardList *list = nds_concurrent_forward_list_new();
+	int result = 0;
+
+	allocator = counting_allocator(&usage);
+	allocator.realloc = NULL;
+	allocator.free = NULL;
+
+	if (!list || nds_concurrent_forward_list_pop_front(list) != NULL || nds_concurrent_forward_list_pop_all(list) != NULL ||
+		nds_concurrent_forward_list_new_with_allocator(&allocator) != NULL || nds_concurrent_forward_list_pop_front(NULL) != NULL)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_forward_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_forward_list_push_front() function.
+ */
+
+/**
+ * Test 1 - verify if the list works as a LIFO stack in a single thread
+ */
+int test_1_nds_concurrent_forward_list_push_front()
+{
+	NdsConcurrentForwardList *list = nds_concurrent_forward_list_new();
+	struct Person people[20];
+	NdsForwardLink *link;
+	int i, result = 0;
+
+	people_init(people, 20);
+
+	for (i = 0; i < 20 && !result; i++)
+		if (nds_concurrent_forward_list_push_front(list, &people[i].link) != NDS_OK)
+			result = 1;
+
+	for (i = 19; i >= 0 && !result; i--)
+	{
+		link = nds_concurrent_forward_list_pop_front(list);
+		if (link == NULL || NDS_CONTAINER_OF(link, struct Person, link)->age != i)
+			result = 1;
+	}
+
+	if (nds_concurrent_forward_list_pop_front(list) != NULL || nds_concurrent_forward_list_push_front(list, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_forward_list_destroy(list);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if links whose address uses the bits of the counter are refused
+ */
+int test_2_nds_concurrent_forward_list_push_front()
+{
+	NdsConcurrentForwardList *list = nds_concurrent_forward_list_new();
+	NdsForwardLink *high = (NdsForwardLink*)(((uintptr_t)1 << (sizeof(uintptr_t) * 8 - 1)) | 4096);
+	int result = 0;
+
+	/* only 64-bit systems keep the counter in the address */
+	if (sizeof(uintptr_t) == 8 && (nds_concurrent_forward_list_push_front(list, high) != NDS_INVALID_PARAM_ERROR ||
+		nds_concurrent_forward_list_pop_front(list) != NULL))
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_forward_list_destroy(list);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if tokens recycled by many threads are never held by two threads at once
+ */
+int test_3_nds_concurrent_forward_list_push_front()
+{
+	NdsConcurrentForwardList *list = nds_concurrent_forward_list_new();
+	struct ListThread arguments[THREADS];
+	struct Token tokens[2];
+	NdsForwardLink *link;
+	uint64_t uses = 0, popped = 0;
+	int i, count = 0, result = 0;
+
+	/* fewer tokens than threads, so the same token is popped and pushed back all the time */
+	for (i = 0; i < 2; i++)
+	{
+		tokens[i].uses = 0;
+		tokens[i].owner = -1;
+		nds_concurrent_forward_list_push_front(list, &tokens[i].link);
+	}
+
+	if (run_threads(list, recycle_thread, arguments))
+		result = 1;
+
+	for (i = 0; i < THREADS; i++)
+		popped += arguments[i].popped;
+
+	/* both tokens are in the list once and every pop was counted by one of them */
+	for (link = nds_concurrent_forward_list_pop_all(list); link != NULL && count <= 2; link = link->next, count++)
+		uses += NDS_CONTAINER_OF(link, struct Token, link)->uses;
+
+	if (count != 2 || uses != popped || popped == 0)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_forward_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_concurrent_forward_list_push_front_n() function.
+ */
+
+/**
+ * Test 1 - verify if a chain is pushed at once in its order and pop_all() returns the whole list
+ */
+int test_1_nds_concurrent_forward_list_push_front_n()
+{
+	NdsConcurrentForwardList *list = nds_concurrent_forward_list_new();
+	int ages[] = { 3, 4, 5, 0, 1, 2 };
+	struct Person people[6];
+	NdsForwardLink *link;
+	int i, result = 0;
+
+	people_init(people, 6);
+
+	/* two chains of three people, each linked in the order of their ages */
+	for (i = 0; i < 6; i++)
+		people[i].link.next = i % 3 != 2 ? &people[i + 1].link : NULL;
+
+	if (nds_concurrent_forward_list_push_front_n(list, &people[0].link, &people[2].link) != NDS_OK ||
+		nds_concurrent_forward_list_push_front_n(list, &people[3].link, &people[5].link) != NDS_OK ||
+		nds_concurrent_forward_list_push_front_n(list, NULL, &people[5].link) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	link = nds_concurrent_forward_list_pop_all(list);
+
+	for (i = 0; i < 6 && !result; i++, link = link->next)
+		if (link == NULL || NDS_CONTAINER_OF(link, struct Person, link)->age != ages[i])
+			result = 1;
+
+	if (link != NULL || nds_concurrent_forward_list_pop_front(list) != NULL)
+		result = 1;
+
+	/* cleanup */
+	nds_concurrent_forward_list_destroy(list);
+
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndsforwardlisttests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_forward_list_new();
+
+		case 2:
+			return test_1_nds_forward_list_new_with_allocator();
+
+		case 3:
+			return test_2_nds_forward_list_new_with_allocator();
+
+		case 4:
+			return test_1_nds_forward_list_size();
+
+		case 5:
+			return test_1_nds_forward_list_push_front();
+
+		case 6:
+			return test_1_nds_forward_list_pop_front();
+
+		case 7:
+			return test_1_nds_forward_list_insert_after();
+
+		case 8:
+			return test_1_nds_forward_list_remove_after();
+
+		case 9:
+			return test_1_nds_forward_list_remove();
+
+		case 10:
+			return test_1_nds_forward_list_splice_back();
+
+		case 11:
+			return test_1_nds_forward_list_reverse();
+
+		case 12:
+			return test_1_nds_forward_list_clear();
+
+		case 13:
+			return test_1_nds_concurrent_forward_list_new();
+
+		case 14:
+			return test_1_nds_concurrent_forward_list_push_front();
+
+		case 15:
+			return test_2_nds_concurrent_forward_list_push_front();
+
+		case 16:
+			return test_3_nds_concurrent_forward_list_push_front();
+
+		case 17:
+			return test_1_nds_concurrent_forward_list_push_front_n();
+
+		default:
+			printf("No tests were found with the given ID!\n");
+			return 1;
+	}
+}
@@ -0,0 +1,736 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file defines various unit tests for the functionality of the
+ * NdsHashMap data structure from the NDS library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndstesthelpers.h"
+
+#include <nds/ndshashmap.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* adds the key and the value of the visited pair in the two uint64_t given as context */
+static void sum_pair(const void *key, void *value, void *context)
+{
+	((uint64_t*)context)[0] += *(const uint64_t*)key;
+	((uint64_t*)context)[1] += *(uint32_t*)value;
+}
+
+
+/* runs random inserts and removes of keys below range and checks the map against an array of values */
+static int map_check_random(NdsHashMap *map, uint32_t range, int operations)
+{
+	uint32_t *values = (uint32_t*)malloc(range * sizeof(uint32_t)), key, value, state = 7;
+	ssize_t size = 0;
+	int i, result = 0;
+
+	/* the value 0 marks the keys that are not in the map */
+	memset(values, 0, range * sizeof(uint32_t));
+
+	for (i = 0; i < operations && !result; i++)
+	{
+		key = test_random(&state) % range;
+
+		if (test_random(&state) % 3 == 0)
+		{
+			if (nds_hash_map_remove(map, &key, &value) != (values[key] ? NDS_OK : NDS_INVALID_PARAM_ERROR) || (values[key] && value != values[key]))
+				result = 1;
+
+			size -= values[key] != 0;
+			values[key] = 0;
+		}
+		else
+		{
+			value = (uint32_t)i + 1;
+			if (nds_hash_map_insert(map, &key, &value) != NDS_OK)
+				result = 1;
+
+			size += values[key] == 0;
+			values[key] = value;
+		}
+	}
+
+	if (nds_hash_map_size(map) != size)
+		result = 1;
+
+	for (key = 0; key < range; key++)
+	{
+		uint32_t *found = (uint32_t*)nds_hash_map_find(map, &key);
+
+		if ((found == NULL) != (values[key] == 0) || (found && *found != values[key]))
+			result = 1;
+	}
+
+	/* cleanup */
+	free(values);
+
+	return result;
+}
+
+
+/**
+ * Unit tests for the nds_hash_map_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_map_new()
+ */
+int test_1_nds_hash_map_new()
+{
+	NdsHashMap *map = nds_hash_map_new(0, sizeof(int), NULL, NULL);
+
+	/* new() should refuse keys without size */
+	return map != NULL;
+}
+
+
+/**
+ * Test 2 - verify if a new map is empty and has room for 14 pairs
+ */
+int test_2_nds_hash_map_new()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(int), sizeof(int), NULL, NULL);
+	int key = 1, result = 0;
+
+	if (!map || nds_hash_map_size(map) != 0 || nds_hash_map_capacity(map) != 13 || nds_hash_map_contains(map, &key) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_map_new_with_allocator() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_map_new_with_allocator()
+ */
+int test_1_nds_hash_map_new_with_allocator()
+{
+	NdsAllocator allocator = *nds_allocator_default();
+	int result = 0;
+
+	if (nds_hash_map_new_with_allocator(sizeof(int), sizeof(int), NULL, NULL, 10, NULL) != NULL ||
+		nds_hash_map_new_with_allocator(sizeof(int), sizeof(int), NULL, NULL, (size_t)-1, &allocator) != NULL)
+		result = 1;
+
+	allocator.free = NULL;
+	if (nds_hash_map_new_with_allocator(sizeof(int), sizeof(int), NULL, NULL, 10, &allocator) != NULL)
+		result = 1;
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the map fits the requested capacity without growing
+ */
+int test_2_nds_hash_map_new_with_allocator()
+{
+	NdsHashMap *map = nds_hash_map_new_with_allocator(sizeof(int), sizeof(double), NULL, NULL, 1000, nds_allocator_default());
+	ssize_t capacity = nds_hash_map_capacity(map);
+	double value;
+	int i, result = 0;
+
+	if (capacity < 1000)
+		result = 1;
+
+	for (i = 0; i < 1000; i++)
+	{
+		value = i * 0.25;
+		nds_hash_map_insert(map, &i, &value);
+	}
+
+	/* the values of 8 bytes after keys of 4 bytes are aligned */
+	for (i = 0; i < 1000; i++)
+		if (((uintptr_t)nds_hash_map_find(map, &i) & 7) != 0 || *(double*)nds_hash_map_find(map, &i) != i * 0.25)
+			result = 1;
+
+	if (nds_hash_map_capacity(map) != capacity)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_map_destroy() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_map_destroy()
+ */
+int test_1_nds_hash_map_destroy()
+{
+	/* destroy() should ignore NULL */
+	nds_hash_map_destroy(NULL);
+
+	return 0;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_map_size() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_map_size() and nds_hash_map_capacity()
+ */
+int test_1_nds_hash_map_size()
+{
+	/* size() and capacity() should return -1 for an invalid map */
+	return nds_hash_map_size(NULL) != -1 || nds_hash_map_capacity(NULL) != -1;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_map_reserve() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_map_reserve()
+ */
+int test_1_nds_hash_map_reserve()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(int), sizeof(int), NULL, NULL);
+	int result = 0;
+
+	if (nds_hash_map_reserve(NULL, 10) != NDS_INVALID_PARAM_ERROR || nds_hash_map_reserve(map, 5) != NDS_OK || nds_hash_map_capacity(map) != 13 ||
+		nds_hash_map_reserve(map, (size_t)-1) != NDS_MEM_ALLOC_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the pairs are kept when the map grows
+ */
+int test_2_nds_hash_map_reserve()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(int), sizeof(int), NULL, NULL);
+	int i, value, result = 0;
+
+	for (i = 0; i < 10; i++)
+	{
+		value = -i;
+		nds_hash_map_insert(map, &i, &value);
+	}
+
+	if (nds_hash_map_reserve(map, 5000) != NDS_OK || nds_hash_map_capacity(map) < 5000 || nds_hash_map_size(map) != 10)
+		result = 1;
+
+	for (i = 0; i < 10; i++)
+		if (nds_hash_map_get(map, &i, &value) != NDS_OK || value != -i)
+			result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_map_insert() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_map_insert()
+ */
+int test_1_nds_hash_map_insert()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(int), sizeof(int), NULL, NULL);
+	int key = 1, result = 0;
+
+	if (nds_hash_map_insert(NULL, &key, &key) != NDS_INVALID_PARAM_ERROR || nds_hash_map_insert(map, NULL, &key) != NDS_INVALID_PARAM_ERROR ||
+		nds_hash_map_insert(map, &key, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if inserting an existing key overwrites its value
+ */
+int test_2_nds_hash_map_insert()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(uint64_t), sizeof(uint32_t), NULL, NULL);
+	uint64_t key, sums[2] = { 0, 0 };
+	uint32_t value;
+	int result = 0;
+
+	for (key = 0; key < 100000; key++)
+	{
+		value = 1;
+		nds_hash_map_insert(map, &key, &value);
+	}
+
+	for (key = 0; key < 100000; key += 2)
+	{
+		value = 3;
+		nds_hash_map_insert(map, &key, &value);
+	}
+
+	if (nds_hash_map_size(map) != 100000)
+		result = 1;
+
+	/* the keys add up to n(n - 1)/2 and half of the values became 3 */
+	nds_hash_map_for_each(map, sum_pair, sums);
+	if (sums[0] != 99999ULL * 100000 / 2 || sums[1] != 200000)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if keys with their own hash and equality are found by value
+ */
+int test_3_nds_hash_map_insert()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(struct NdsTestName), sizeof(int), name_hash, name_equal);
+	struct NdsTestName key;
+	int i, value, result = 0;
+
+	for (i = 0; i < 500; i++)
+	{
+		/* the bytes after the terminator are garbage that must not matter */
+		memset(key.name, 'x' + i % 3, sizeof(key.name));
+		sprintf(key.name, "name-%d", i);
+		nds_hash_map_insert(map, &key, &i);
+	}
+
+	for (i = 0; i < 500; i++)
+	{
+		memset(key.name, 0, sizeof(key.name));
+		sprintf(key.name, "name-%d", i);
+		if (nds_hash_map_get(map, &key, &value) != NDS_OK || value != i)
+			result = 1;
+	}
+
+	strcpy(key.name, "name-500");
+	if (nds_hash_map_contains(map, &key) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 4 - verify if a map with keys of 3 bytes and no values works as a set
+ */
+int test_4_nds_hash_map_insert()
+{
+	NdsHashMap *map = nds_hash_map_new(3, 0, NULL, NULL);
+	unsigned char key[3];
+	int i, result = 0;
+
+	for (i = 0; i < 3000; i++)
+	{
+		key[0] = (unsigned char)i;
+		key[1] = (unsigned char)(i >> 8);
+		key[2] = 0x5a;
+		if (nds_hash_map_insert(map, key, NULL) != NDS_OK)
+			result = 1;
+	}
+
+	key[2] = 0x5b;
+	if (nds_hash_map_size(map) != 3000 || nds_hash_map_contains(map, key) != 0)
+		result = 1;
+
+	key[0] = 7;
+	key[1] = 0;
+	key[2] = 0x5a;
+	if (nds_hash_map_contains(map, key) != 1)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_map_find() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_map_find()
+ */
+int test_1_nds_hash_map_find()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(int), sizeof(int), NULL, NULL);
+	int key = 1, result = 0;
+
+	nds_hash_map_insert(map, &key, &key);
+
+	if (nds_hash_map_find(NULL, &key) != NULL || nds_hash_map_find(map, NULL) != NULL || *(int*)nds_hash_map_find(map, &key) != 1)
+		result = 1;
+
+	/* the value can be changed in place */
+	*(int*)nds_hash_map_find(map, &key) = 5;
+	if (*(int*)nds_hash_map_find(map, &key) != 5)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_map_get() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_map_get()
+ */
+int test_1_nds_hash_map_get()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(int), sizeof(int), NULL, NULL);
+	int key = 1, value, result = 0;
+
+	nds_hash_map_insert(map, &key, &key);
+
+	if (nds_hash_map_get(NULL, &key, &value) != NDS_INVALID_PARAM_ERROR || nds_hash_map_get(map, &key, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	key = 2;
+	if (nds_hash_map_get(map, &key, &value) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_map_contains() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_map_contains()
+ */
+int test_1_nds_hash_map_contains()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(int), sizeof(int), NULL, NULL);
+	int key = 1, result = 0;
+
+	if (nds_hash_map_contains(NULL, &key) != -1 || nds_hash_map_contains(map, NULL) != -1)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_map_remove() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_map_remove()
+ */
+int test_1_nds_hash_map_remove()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(int), sizeof(int), NULL, NULL);
+	int key = 1, value = 10, result = 0;
+
+	nds_hash_map_insert(map, &key, &value);
+
+	if (nds_hash_map_remove(NULL, &key, NULL) != NDS_INVALID_PARAM_ERROR || nds_hash_map_remove(map, NULL, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	value = 0;
+	if (nds_hash_map_remove(map, &key, &value) != NDS_OK || value != 10 || nds_hash_map_size(map) != 0)
+		result = 1;
+
+	/* a removed key cannot be removed twice */
+	if (nds_hash_map_remove(map, &key, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify random inserts and removes against a reference array
+ */
+int test_2_nds_hash_map_remove()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(uint32_t), sizeof(uint32_t), NULL, NULL);
+	int result;
+
+	result = map_check_random(map, 5000, 200000);
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if removals shift back the pairs of long runs that wrap around the table
+ */
+int test_3_nds_hash_map_remove()
+{
+	NdsHashMap *map = nds_hash_map_new_with_allocator(sizeof(uint32_t), sizeof(uint32_t), colliding_hash, NULL, 100, nds_allocator_default());
+	int result;
+
+	/* 100 pairs fit in 128 slots, where the run that starts at slot 120 wraps around the end of the table */
+	result = map_check_random(map, 100, 20000);
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 4 - verify if the capacity does not degrade after many removals
+ */
+int test_4_nds_hash_map_remove()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(int), sizeof(int), NULL, NULL);
+	ssize_t capacity;
+	int i, result = 0;
+
+	for (i = 0; i < 100; i++)
+		nds_hash_map_insert(map, &i, &i);
+	capacity = nds_hash_map_capacity(map);
+
+	/* without tombstones, a steady number of pairs never makes the map grow */
+	for (i = 100; i < 100000; i++)
+	{
+		int old = i - 100;
+
+		nds_hash_map_remove(map, &old, NULL);
+		nds_hash_map_insert(map, &i, &i);
+	}
+
+	if (nds_hash_map_capacity(map) != capacity || nds_hash_map_size(map) != 100)
+		result = 1;
+
+	for (i = 99900; i < 100000; i++)
+		if (nds_hash_map_contains(map, &i) != 1)
+			result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_map_clear() function.
+ */
+
+/**
+ * Test 1 - verify if clear() removes every pair and keeps the capacity
+ */
+int test_1_nds_hash_map_clear()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(int), sizeof(int), NULL, NULL);
+	ssize_t capacity;
+	int i, result = 0;
+
+	if (nds_hash_map_clear(NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	for (i = 0; i < 100; i++)
+		nds_hash_map_insert(map, &i, &i);
+	capacity = nds_hash_map_capacity(map);
+
+	if (nds_hash_map_clear(map) != NDS_OK || nds_hash_map_size(map) != 0 || nds_hash_map_capacity(map) != capacity)
+		result = 1;
+
+	for (i = 0; i < 100; i++)
+		if (nds_hash_map_contains(map, &i) != 0)
+			result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_map_for_each() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_map_for_each()
+ */
+int test_1_nds_hash_map_for_each()
+{
+	NdsHashMap *map = nds_hash_map_new(sizeof(uint64_t), sizeof(uint32_t), NULL, NULL);
+	uint64_t sums[2] = { 0, 0 };
+	int result = 0;
+
+	if (nds_hash_map_for_each(NULL, sum_pair, sums) != NDS_INVALID_PARAM_ERROR || nds_hash_map_for_each(map, NULL, sums) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* an empty map calls the function for no pair */
+	if (nds_hash_map_for_each(map, sum_pair, sums) != NDS_OK || sums[0] != 0 || sums[1] != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_map_destroy(map);
+
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndshashmaptests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_hash_map_new();
+
+		case 2:
+			return test_2_nds_hash_map_new();
+
+		case 3:
+			return test_1_nds_hash_map_new_with_allocator();
+
+		case 4:
+			return test_2_nds_hash_map_new_with_allocator();
+
+		case 5:
+			return test_1_nds_hash_map_destroy();
+
+		case 6:
+			return test_1_nds_hash_map_size();
+
+		case 7:
+			return test_1_nds_hash_map_reserve();
+
+		case 8:
+			return test_2_nds_hash_map_reserve();
+
+		case 9:
+			return test_1_nds_hash_map_insert();
+
+		case 10:
+			return test_2_nds_hash_map_insert();
+
+		case 11:
+			return test_3_nds_hash_map_insert();
+
+		case 12:
+			return test_4_nds_hash_map_insert();
+
+		case 13:
+			return test_1_nds_hash_map_find();
+
+		case 14:
+			return test_1_nds_hash_map_get();
+
+		case 15:
+			return test_1_nds_hash_map_contains();
+
+		case 16:
+			return test_1_nds_hash_map_remove();
+
+		case 17:
+			return test_2_nds_hash_map_remove();
+
+		case 18:
+			return test_3_nds_hash_map_remove();
+
+		case 19:
+			return test_4_nds_hash_map_remove();
+
+		case 20:
+			return test_1_nds_hash_map_clear();
+
+		case 21:
+			return test_1_nds_hash_map_for_each();
+
+		default:
+			printf("No tests were found with the given ID!\n");
+			return 1;
+	}
+}
@@ -0,0 +1,911 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file defines various unit tests for the functionality of the
+ * NdsHashSet data structure from the NDS library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndstesthelpers.h"
+
+#include <nds/ndshashset.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* adds the visited element to the uint64_t given as context */
+static void sum_element(void *element, void *context)
+{
+	*(uint64_t*)context += *(uint64_t*)element;
+}
+
+
+/* checks that the set holds exactly the uint32_t elements below range whose flag is set */
+static int set_check(NdsHashSet *set, const unsigned char *flags, uint32_t range)
+{
+	ssize_t size = 0;
+	uint32_t element;
+
+	for (element = 0; element < range; element++)
+	{
+		if (nds_hash_set_contains(set, &element) != flags[element])
+			return 1;
+
+		size += flags[element];
+	}
+
+	return nds_hash_set_size(set) != size;
+}
+
+
+/**
+ * Unit tests for the nds_hash_set_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_set_new()
+ */
+int test_1_nds_hash_set_new()
+{
+	NdsHashSet *set = nds_hash_set_new(0, NULL, NULL);
+
+	/* new() should refuse elements without size */
+	return set != NULL;
+}
+
+
+/**
+ * Test 2 - verify if a new set is empty and has room for 14 elements
+ */
+int test_2_nds_hash_set_new()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(int), NULL, NULL);
+	int element = 1, result = 0;
+
+	if (!set || nds_hash_set_size(set) != 0 || nds_hash_set_capacity(set) != 13 || nds_hash_set_contains(set, &element) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_set_new_with_allocator() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_set_new_with_allocator()
+ */
+int test_1_nds_hash_set_new_with_allocator()
+{
+	NdsAllocator allocator = *nds_allocator_default();
+	int result = 0;
+
+	if (nds_hash_set_new_with_allocator(sizeof(int), NULL, NULL, 10, NULL) != NULL ||
+		nds_hash_set_new_with_allocator(sizeof(int), NULL, NULL, (size_t)-1, &allocator) != NULL)
+		result = 1;
+
+	allocator.alloc = NULL;
+	if (nds_hash_set_new_with_allocator(sizeof(int), NULL, NULL, 10, &allocator) != NULL)
+		result = 1;
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if a set filled up to its capacity allocates only the handle and the table
+ */
+int test_2_nds_hash_set_new_with_allocator()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsHashSet *set;
+	uint32_t element;
+	int result = 0;
+
+	allocator = counting_allocator(&usage);
+	set = nds_hash_set_new_with_allocator(sizeof(uint32_t), NULL, NULL, 1000, &allocator);
+
+	for (element = 0; element < 1000; element++)
+		if (nds_hash_set_insert(set, &element) != NDS_OK)
+			result = 1;
+
+	if (usage.allocations != 2 || nds_hash_set_size(set) != 1000)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_set_new_from_vector() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_set_new_from_vector()
+ */
+int test_1_nds_hash_set_new_from_vector()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	NdsHashSet *set;
+	int result = 0;
+
+	if (nds_hash_set_new_from_vector(NULL, NULL, NULL) != NULL)
+		result = 1;
+
+	/* an empty vector gives an empty set */
+	set = nds_hash_set_new_from_vector(vector, NULL, NULL);
+	if (!set || nds_hash_set_size(set) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the set holds the distinct elements of the vector and was sized for all of them
+ */
+int test_2_nds_hash_set_new_from_vector()
+{
+	NdsVector *vector = nds_vector_new(sizeof(uint32_t));
+	NdsHashSet *set, *sized;
+	unsigned char flags[500];
+	uint32_t element, state = 3;
+	int i, result = 0;
+
+	memset(flags, 0, sizeof(flags));
+	for (i = 0; i < 2000; i++)
+	{
+		element = test_random(&state) % 500;
+		flags[element] = 1;
+		nds_vector_push_back(vector, &element);
+	}
+
+	set = nds_hash_set_new_from_vector(vector, NULL, NULL);
+	sized = nds_hash_set_new_with_allocator(sizeof(uint32_t), NULL, NULL, 2000, nds_allocator_default());
+
+	if (!set || set_check(set, flags, 500) || nds_hash_set_capacity(set) != nds_hash_set_capacity(sized))
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(sized);
+	nds_hash_set_destroy(set);
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_set_destroy() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_set_destroy()
+ */
+int test_1_nds_hash_set_destroy()
+{
+	/* destroy() should ignore NULL */
+	nds_hash_set_destroy(NULL);
+
+	return 0;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_set_size() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_set_size() and nds_hash_set_capacity()
+ */
+int test_1_nds_hash_set_size()
+{
+	/* size() and capacity() should return -1 for an invalid set */
+	return nds_hash_set_size(NULL) != -1 || nds_hash_set_capacity(NULL) != -1;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_set_reserve() function.
+ */
+
+/**
+ * Test 1 - verify if the elements are kept when the set grows
+ */
+int test_1_nds_hash_set_reserve()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(int), NULL, NULL);
+	int i, result = 0;
+
+	for (i = 0; i < 10; i++)
+		nds_hash_set_insert(set, &i);
+
+	if (nds_hash_set_reserve(NULL, 10) != NDS_INVALID_PARAM_ERROR || nds_hash_set_reserve(set, (size_t)-1) != NDS_MEM_ALLOC_ERROR ||
+		nds_hash_set_reserve(set, 5000) != NDS_OK || nds_hash_set_capacity(set) < 5000 || nds_hash_set_size(set) != 10)
+		result = 1;
+
+	for (i = 0; i < 10; i++)
+		if (nds_hash_set_contains(set, &i) != 1)
+			result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_set_insert() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_set_insert()
+ */
+int test_1_nds_hash_set_insert()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(int), NULL, NULL);
+	int element = 1, result = 0;
+
+	if (nds_hash_set_insert(NULL, &element) != NDS_INVALID_PARAM_ERROR || nds_hash_set_insert(set, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if inserting an element twice keeps a single copy, also while the set grows
+ */
+int test_2_nds_hash_set_insert()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(uint64_t), NULL, NULL);
+	uint64_t element;
+	int result = 0;
+
+	for (element = 0; element < 10000; element++)
+		if (nds_hash_set_insert(set, &element) != NDS_OK || nds_hash_set_insert(set, &element) != NDS_OK)
+			result = 1;
+
+	if (nds_hash_set_size(set) != 10000)
+		result = 1;
+
+	for (element = 0; element < 20000; element++)
+		if (nds_hash_set_contains(set, &element) != (element < 10000))
+			result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if the set uses the given hash and equality functions
+ */
+int test_3_nds_hash_set_insert()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(struct NdsTestName), name_hash, name_equal);
+	struct NdsTestName first, second;
+	int result = 0;
+
+	/* the two names differ only after their terminators */
+	memset(&first, 'x', sizeof(first));
+	memset(&second, 'y', sizeof(second));
+	strcpy(first.name, "neo");
+	strcpy(second.name, "neo");
+
+	if (nds_hash_set_insert(set, &first) != NDS_OK || nds_hash_set_insert(set, &second) != NDS_OK || nds_hash_set_size(set) != 1 ||
+		nds_hash_set_contains(set, &second) != 1)
+		result = 1;
+
+	strcpy(second.name, "data");
+	if (nds_hash_set_contains(set, &second) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_set_insert_batch() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_set_insert_batch()
+ */
+int test_1_nds_hash_set_insert_batch()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(int), NULL, NULL);
+	int elements[2] = { 1, 2 }, result = 0;
+
+	if (nds_hash_set_insert_batch(NULL, elements, 2, NULL) != -1 || nds_hash_set_insert_batch(set, NULL, 2, NULL) != -1 ||
+		nds_hash_set_insert_batch(set, elements, (size_t)-1, NULL) != -1 || nds_hash_set_insert_batch(set, NULL, 0, NULL) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the flags mark the elements that were added, the repeated ones included
+ */
+int test_2_nds_hash_set_insert_batch()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(int), NULL, NULL);
+	int elements[40], i, result = 0;
+	unsigned char inserted[40];
+
+	/* 0, 2, 4 and 6 are in the set before the batch, which holds 0..19 twice */
+	for (i = 0; i < 8; i += 2)
+		nds_hash_set_insert(set, &i);
+
+	for (i = 0; i < 40; i++)
+		elements[i] = i % 20;
+
+	if (nds_hash_set_insert_batch(set, elements, 40, inserted) != 16 || nds_hash_set_size(set) != 20)
+		result = 1;
+
+	for (i = 0; i < 40; i++)
+		if (inserted[i] != (i < 20 && (i >= 8 || i % 2 == 1)))
+			result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if a batch of colliding elements gives the same set as single insertions
+ */
+int test_3_nds_hash_set_insert_batch()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(uint32_t), colliding_hash, NULL);
+	uint32_t elements[1000], state = 5;
+	unsigned char flags[300];
+	ssize_t added = 0;
+	int i, round, result = 0;
+
+	memset(flags, 0, sizeof(flags));
+
+	for (round = 0; round < 3; round++)
+	{
+		for (i = 0; i < 100; i++)
+		{
+			elements[i] = test_random(&state) % 300;
+			added += !flags[elements[i]];
+			flags[elements[i]] = 1;
+		}
+
+		if (nds_hash_set_insert_batch(set, elements, 100, NULL) < 0)
+			result = 1;
+	}
+
+	if (set_check(set, flags, 300) || nds_hash_set_size(set) != added)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+/**
+ * Test 4 - verify if a heavily repeated array leaves a set sized for its distinct elements
+ */
+int test_4_nds_hash_set_insert_batch()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(int), NULL, NULL), *single = nds_hash_set_new(sizeof(int), NULL, NULL);
+	static int elements[1000000];
+	int i, result = 0;
+
+	if (!set || !single)
+		result = 1;
+
+	/* 1000 distinct elements, each of them repeated 1000 times */
+	for (i = 0; i < 1000000; i++)
+		elements[i] = i * 7 % 1000;
+
+	for (i = 0; i < 1000 && !result; i++)
+		nds_hash_set_insert(single, &i);
+
+	/* the set grows like one filled with single insertions of the distinct elements */
+	if (!result && (nds_hash_set_insert_batch(set, elements, 1000000, NULL) != 1000 || nds_hash_set_size(set) != 1000 ||
+		nds_hash_set_capacity(set) != nds_hash_set_capacity(single) || nds_hash_set_capacity(set) >= 4000))
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+	nds_hash_set_destroy(single);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_set_contains() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_set_contains()
+ */
+int test_1_nds_hash_set_contains()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(int), NULL, NULL);
+	int element = 1, result = 0;
+
+	if (nds_hash_set_contains(NULL, &element) != -1 || nds_hash_set_contains(set, NULL) != -1 || nds_hash_set_contains(set, &element) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_set_contains_batch() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_set_contains_batch()
+ */
+int test_1_nds_hash_set_contains_batch()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(int), NULL, NULL);
+	int elements[2] = { 1, 2 }, result = 0;
+
+	if (nds_hash_set_contains_batch(NULL, elements, 2, NULL) != -1 || nds_hash_set_contains_batch(set, NULL, 2, NULL) != -1 ||
+		nds_hash_set_contains_batch(set, elements, 2, NULL) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the flags and the count of a batch match single lookups, with and without flags
+ */
+int test_2_nds_hash_set_contains_batch()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(struct NdsTestName), name_hash, name_equal);
+	struct NdsTestName elements[50];
+	unsigned char found[50];
+	ssize_t count = 0;
+	int i, result = 0;
+
+	for (i = 0; i < 50; i++)
+	{
+		memset(&elements[i], i, sizeof(struct NdsTestName));
+		sprintf(elements[i].name, "name %d", i);
+
+		if (i % 3 == 0)
+			nds_hash_set_insert(set, &elements[i]);
+		count += i % 3 == 0;
+	}
+
+	if (nds_hash_set_contains_batch(set, elements, 50, found) != count || nds_hash_set_contains_batch(set, elements, 50, NULL) != count)
+		result = 1;
+
+	for (i = 0; i < 50; i++)
+		if (found[i] != (i % 3 == 0) || found[i] != nds_hash_set_contains(set, &elements[i]))
+			result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_set_remove() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_set_remove()
+ */
+int test_1_nds_hash_set_remove()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(int), NULL, NULL);
+	int element = 1, result = 0;
+
+	if (nds_hash_set_remove(NULL, &element) != NDS_INVALID_PARAM_ERROR || nds_hash_set_remove(set, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_hash_set_remove(set, &element) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify random inserts and removes of colliding elements against an array of flags
+ */
+int test_2_nds_hash_set_remove()
+{
+	NdsHashSet *set = nds_hash_set_new_with_allocator(sizeof(uint32_t), colliding_hash, NULL, 100, nds_allocator_default());
+	unsigned char flags[100];
+	uint32_t element, state = 11;
+	int i, result = 0;
+
+	memset(flags, 0, sizeof(flags));
+
+	for (i = 0; i < 5000; i++)
+	{
+		element = test_random(&state) % 100;
+
+		if (test_random(&state) % 2)
+		{
+			if (nds_hash_set_remove(set, &element) != (flags[element] ? NDS_OK : NDS_INVALID_PARAM_ERROR))
+				result = 1;
+			flags[element] = 0;
+		}
+		else
+		{
+			nds_hash_set_insert(set, &element);
+			flags[element] = 1;
+		}
+	}
+
+	if (set_check(set, flags, 100))
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_set_clear() function.
+ */
+
+/**
+ * Test 1 - verify if clear() empties the set and keeps its capacity
+ */
+int test_1_nds_hash_set_clear()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(int), NULL, NULL);
+	ssize_t capacity;
+	int i, result = 0;
+
+	for (i = 0; i < 100; i++)
+		nds_hash_set_insert(set, &i);
+
+	capacity = nds_hash_set_capacity(set);
+
+	if (nds_hash_set_clear(NULL) != NDS_INVALID_PARAM_ERROR || nds_hash_set_clear(set) != NDS_OK || nds_hash_set_size(set) != 0 ||
+		nds_hash_set_capacity(set) != capacity)
+		result = 1;
+
+	for (i = 0; i < 100; i++)
+		if (nds_hash_set_contains(set, &i) != 0)
+			result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_set_for_each() function.
+ */
+
+/**
+ * Test 1 - verify if for_each() visits every element once
+ */
+int test_1_nds_hash_set_for_each()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(uint64_t), NULL, NULL);
+	uint64_t element, sum = 0;
+	int result = 0;
+
+	if (nds_hash_set_for_each(NULL, sum_element, &sum) != NDS_INVALID_PARAM_ERROR || nds_hash_set_for_each(set, NULL, &sum) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	for (element = 1; element <= 1000; element++)
+		nds_hash_set_insert(set, &element);
+
+	if (nds_hash_set_for_each(set, sum_element, &sum) != NDS_OK || sum != 500500)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_hash_set_union() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_hash_set_union(), nds_hash_set_intersection() and nds_hash_set_difference()
+ */
+int test_1_nds_hash_set_union()
+{
+	NdsHashSet *first = nds_hash_set_new(sizeof(uint32_t), NULL, NULL);
+	NdsHashSet *second = nds_hash_set_new(sizeof(uint64_t), NULL, NULL);
+	NdsHashSet *third = nds_hash_set_new(sizeof(uint32_t), colliding_hash, NULL);
+	int result = 0;
+
+	/* the sets must hold the same kind of elements */
+	if (nds_hash_set_union(first, NULL) != NULL || nds_hash_set_union(first, second) != NULL || nds_hash_set_union(first, third) != NULL ||
+		nds_hash_set_intersection(NULL, first) != NULL || nds_hash_set_intersection(first, second) != NULL ||
+		nds_hash_set_difference(first, NULL) != NULL || nds_hash_set_difference(third, first) != NULL)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(third);
+	nds_hash_set_destroy(second);
+	nds_hash_set_destroy(first);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify the union, the intersection and the differences of two overlapping sets
+ */
+int test_2_nds_hash_set_union()
+{
+	NdsHashSet *first = nds_hash_set_new(sizeof(uint32_t), NULL, NULL);
+	NdsHashSet *second = nds_hash_set_new(sizeof(uint32_t), NULL, NULL);
+	NdsHashSet *both, *common, *only_first, *only_second;
+	unsigned char in_first[3000], in_second[3000], flags[3000];
+	uint32_t element, state = 13;
+	int i, result = 0;
+
+	memset(in_first, 0, sizeof(in_first));
+	memset(in_second, 0, sizeof(in_second));
+
+	/* the first set is the larger one, so each order of the arguments is exercised */
+	for (i = 0; i < 2000; i++)
+	{
+		element = test_random(&state) % 3000;
+		in_first[element] = 1;
+		nds_hash_set_insert(first, &element);
+
+		if (i % 3 == 0)
+		{
+			element = test_random(&state) % 3000;
+			in_second[element] = 1;
+			nds_hash_set_insert(second, &element);
+		}
+	}
+
+	both = nds_hash_set_union(second, first);
+	common = nds_hash_set_intersection(second, first);
+	only_first = nds_hash_set_difference(first, second);
+	only_second = nds_hash_set_difference(second, first);
+
+	for (i = 0; i < 3000; i++)
+		flags[i] = in_first[i] | in_second[i];
+	if (!both || set_check(both, flags, 3000))
+		result = 1;
+
+	for (i = 0; i < 3000; i++)
+		flags[i] = in_first[i] & in_second[i];
+	if (!common || set_check(common, flags, 3000))
+		result = 1;
+
+	for (i = 0; i < 3000; i++)
+		flags[i] = in_first[i] & !in_second[i];
+	if (!only_first || set_check(only_first, flags, 3000))
+		result = 1;
+
+	for (i = 0; i < 3000; i++)
+		flags[i] = in_second[i] & !in_first[i];
+	if (!only_second || set_check(only_second, flags, 3000))
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(only_second);
+	nds_hash_set_destroy(only_first);
+	nds_hash_set_destroy(common);
+	nds_hash_set_destroy(both);
+	nds_hash_set_destroy(second);
+	nds_hash_set_destroy(first);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify the algebra of an empty set and of a set with itself
+ */
+int test_3_nds_hash_set_union()
+{
+	NdsHashSet *set = nds_hash_set_new(sizeof(int), NULL, NULL);
+	NdsHashSet *empty = nds_hash_set_new(sizeof(int), NULL, NULL);
+	NdsHashSet *both, *common, *difference;
+	int i, result = 0;
+
+	for (i = 0; i < 100; i++)
+		nds_hash_set_insert(set, &i);
+
+	both = nds_hash_set_union(set, set);
+	common = nds_hash_set_intersection(set, empty);
+	difference = nds_hash_set_difference(set, set);
+
+	if (nds_hash_set_size(both) != 100 || nds_hash_set_size(common) != 0 || nds_hash_set_size(difference) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_hash_set_destroy(difference);
+	nds_hash_set_destroy(common);
+	nds_hash_set_destroy(both);
+	nds_hash_set_destroy(empty);
+	nds_hash_set_destroy(set);
+
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndshashsettests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_hash_set_new();
+
+		case 2:
+			return test_2_nds_hash_set_new();
+
+		case 3:
+			return test_1_nds_hash_set_new_with_allocator();
+
+		case 4:
+			return test_2_nds_hash_set_new_with_allocator();
+
+		case 5:
+			return test_1_nds_hash_set_new_from_vector();
+
+		case 6:
+			return test_2_nds_hash_set_new_from_vector();
+
+		case 7:
+			return test_1_nds_hash_set_destroy();
+
+		case 8:
+			return test_1_nds_hash_set_size();
+
+		case 9:
+			return test_1_nds_hash_set_reserve();
+
+		case 10:
+			return test_1_nds_hash_set_insert();
+
+		case 11:
+			return test_2_nds_hash_set_insert();
+
+		case 12:
+			return test_3_nds_hash_set_insert();
+
+		case 13:
+			return test_1_nds_hash_set_insert_batch();
+
+		case 14:
+			return test_2_nds_hash_set_insert_batch();
+
+		case 15:
+			return test_3_nds_hash_set_insert_batch();
+
+		case 16:
+			return test_1_nds_hash_set_contains();
+
+		case 17:
+			return test_1_nds_hash_set_contains_batch();
+
+		case 18:
+			return test_2_nds_hash_set_contains_batch();
+
+		case 19:
+			return test_1_nds_hash_set_remove();
+
+		case 20:
+			return test_2_nds_hash_set_remove();
+
+		case 21:
+			return test_1_nds_hash_set_clear();
+
+		case 22:
+			return test_1_nds_hash_set_for_each();
+
+		case 23:
+			return test_1_nds_hash_set_union();
+
+		case 24:
+			return test_2_nds_hash_set_union();
+
+		case 25:
+			return test_3_nds_hash_set_union();
+
+		case 26:
+			return test_4_nds_hash_set_insert_batch();
+
+		default:
+			printf("No tests were found with the given ID!\n");
+			return 1;
+	}
+}
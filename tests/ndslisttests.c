@@ -0,0 +1,1049 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file defines various unit tests for the functionality of the
+ * NdsList data structure from the NDS library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndstesthelpers.h"
+
+#include <nds/ndslist.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* node capacities covered by the tests, 0 is the capacity of an unrolled list */
+static const size_t capacities[] = { 1, 2, 3, 7, 0 };
+
+#define CAPACITIES (sizeof(capacities) / sizeof(capacities[0]))
+
+
+/* creates a list of ints with the given node capacity and the default allocator */
+static NdsList* list_new(size_t node_capacity)
+{
+	return nds_list_new_with_allocator(sizeof(int), node_capacity, nds_allocator_default());
+}
+
+
+/* points the iterator to the element at the given position, or to the end */
+static void list_seek(NdsList *list, NdsListIterator *iterator, size_t position)
+{
+	if (nds_list_first(list, iterator) != 1)
+		return;
+
+	while (position-- > 0)
+		nds_list_iterator_next(iterator);
+}
+
+
+/* checks that the list holds the size ints of expected, walking it forwards and then backwards */
+static int list_check(NdsList *list, const int *expected, size_t size)
+{
+	NdsListIterator iterator;
+	size_t i;
+	int found;
+
+	if (nds_list_size(list) != (ssize_t)size)
+		return 1;
+
+	found = nds_list_first(list, &iterator);
+
+	for (i = 0; i < size; i++)
+	{
+		if (found != 1 || *(int*)iterator.element != expected[i])
+			return 1;
+
+		found = nds_list_iterator_next(&iterator);
+	}
+
+	if (found != 0)
+		return 1;
+
+	for (i = size; i > 0; i--)
+		if (nds_list_iterator_prev(&iterator) != 1 || *(int*)iterator.element != expected[i - 1])
+			return 1;
+
+	return nds_list_iterator_prev(&iterator) != 0 || iterator.element != NULL;
+}
+
+
+/* inserts and, if erase is set, erases ints at random positions of the list and of the model array, which has room for limit ints */
+static int list_churn(NdsList *list, int *model, size_t *size, size_t limit, size_t operations, int erase, uint32_t seed)
+{
+	NdsListIterator iterator;
+	size_t i, position;
+	int element, removed;
+
+	for (i = 0; i < operations; i++)
+	{
+		if (*size < limit && (!erase || *size == 0 || test_random(&seed) % 3 != 0))
+		{
+			position = test_random(&seed) % (*size + 1);
+			list_seek(list, &iterator, position);
+
+			element = (int)i;
+
+			if (nds_list_insert(list, &iterator, &element) != NDS_OK || *(int*)iterator.element != element)
+				return 1;
+
+			memmove(model + position + 1, model + position, (*size - position) * sizeof(int));
+			model[position] = element;
+			(*size)++;
+		}
+		else
+		{
+			position = test_random(&seed) % *size;
+			list_seek(list, &iterator, position);
+
+			if (nds_list_erase(list, &iterator, &removed) != NDS_OK || removed != model[position])
+				return 1;
+
+			memmove(model + position, model + position + 1, (*size - position - 1) * sizeof(int));
+			(*size)--;
+
+			/* the iterator moved to the element after the removed one */
+			if (position < *size ? iterator.element == NULL || *(int*)iterator.element != model[position] : iterator.element != NULL)
+				return 1;
+		}
+	}
+
+	return list_check(list, model, *size);
+}
+
+
+/* adds the visited ints to the sum the context points to */
+static void list_sum(void *element, void *context)
+{
+	*(long long*)context += *(int*)element;
+}
+
+
+/**
+ * Unit tests for the nds_list_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_list_new()
+ */
+int test_1_nds_list_new()
+{
+	/* new() should refuse elements without size */
+	return nds_list_new(0) != NULL || nds_list_new_unrolled(0) != NULL;
+}
+
+
+/**
+ * Test 2 - verify if a new list is empty
+ */
+int test_2_nds_list_new()
+{
+	NdsList *list = nds_list_new(sizeof(int));
+	NdsListIterator iterator;
+	int element = 0, result = 0;
+
+	if (!list || list_check(list, NULL, 0) || nds_list_front(list, &element) != NDS_INVALID_PARAM_ERROR ||
+		nds_list_back(list, &element) != NDS_INVALID_PARAM_ERROR || nds_list_pop_front(list, &element) != NDS_INVALID_PARAM_ERROR ||
+		nds_list_pop_back(list, NULL) != NDS_INVALID_PARAM_ERROR || nds_list_last(list, &iterator) != 0 || iterator.element != NULL)
+		result = 1;
+
+	/* cleanup */
+	nds_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_new_unrolled() function.
+ */
+
+/**
+ * Test 1 - verify if an unrolled list of large elements keeps them in order
+ */
+int test_1_nds_list_new_unrolled()
+{
+	/* elements larger than a node still get two of them per node */
+	struct Large { int value; char padding[300]; } element;
+	NdsList *list = nds_list_new_unrolled(sizeof(struct Large));
+	int i, result = 0;
+
+	if (!list)
+		return 1;
+
+	memset(&element, 0, sizeof(element));
+
+	/* the even values are pushed in front and end up in descending order, the odd ones at the back */
+	for (i = 0; i < 100 && !result; i++)
+	{
+		element.value = i;
+		if ((i % 2 ? nds_list_push_back(list, &element) : nds_list_push_front(list, &element)) != NDS_OK)
+			result = 1;
+	}
+
+	for (i = 0; i < 100 && !result; i++)
+		if (nds_list_pop_front(list, &element) != NDS_OK || element.value != (i < 50 ? 98 - 2 * i : 2 * i - 99))
+			result = 1;
+
+	if (nds_list_size(list) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_new_with_allocator() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_list_new_with_allocator()
+ */
+int test_1_nds_list_new_with_allocator()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+
+	allocator = counting_allocator(&usage);
+	allocator.realloc = NULL;
+
+	/* new_with_allocator() should refuse a missing or incomplete allocator and elements without size */
+	return nds_list_new_with_allocator(sizeof(int), 1, NULL) != NULL || nds_list_new_with_allocator(sizeof(int), 1, &allocator) != NULL ||
+		nds_list_new_with_allocator(0, 1, nds_allocator_default()) != NULL ||
+		nds_list_new_with_allocator(sizeof(int), SIZE_MAX, nds_allocator_default()) != NULL || usage.allocations != 0;
+}
+
+
+/**
+ * Test 2 - verify if the nodes are allocated in slabs from the given allocator
+ */
+int test_2_nds_list_new_with_allocator()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsList *list;
+	int i, result = 0;
+
+	allocator = counting_allocator(&usage);
+
+	list = nds_list_new_with_allocator(sizeof(int), 1, &allocator);
+	if (!list)
+		return 1;
+
+	for (i = 0; i < 1000 && !result; i++)
+		if (nds_list_push_back(list, &i) != NDS_OK)
+			result = 1;
+
+	/* the block of the list and the slabs of 16, 32, ... 512 nodes */
+	if (usage.allocations != 7)
+		result = 1;
+
+	/* removed nodes are reused before the slabs are touched again */
+	for (i = 0; i < 500 && !result; i++)
+		if (nds_list_pop_front(list, NULL) != NDS_OK || nds_list_push_back(list, &i) != NDS_OK)
+			result = 1;
+
+	if (usage.allocations != 7)
+		result = 1;
+
+	/* cleanup */
+	nds_list_destroy(list);
+
+	/* every slab went back to the allocator */
+	return result || usage.bytes != 0;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_size() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_list_size()
+ */
+int test_1_nds_list_size()
+{
+	NdsList list = { NULL };
+
+	return nds_list_size(NULL) != -1 || nds_list_size(&list) != -1;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_push_front() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_list_push_front()
+ */
+int test_1_nds_list_push_front()
+{
+	NdsList *list = nds_list_new(sizeof(int));
+	int element = 1, result = 0;
+
+	if (nds_list_push_front(NULL, &element) != NDS_INVALID_PARAM_ERROR || nds_list_push_front(list, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_list_push_back(NULL, &element) != NDS_INVALID_PARAM_ERROR || nds_list_push_back(list, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_list_size(list) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_list_destroy(list);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the elements pushed in front are in reverse order, for every node capacity
+ */
+int test_2_nds_list_push_front()
+{
+	int expected[100];
+	size_t c;
+	int i, result = 0;
+
+	for (c = 0; c < CAPACITIES && !result; c++)
+	{
+		NdsList *list = list_new(capacities[c]);
+
+		for (i = 0; i < 100 && !result; i++)
+		{
+			expected[99 - i] = i;
+			if (nds_list_push_front(list, &i) != NDS_OK)
+				result = 1;
+		}
+
+		if (list_check(list, expected, 100))
+			result = 1;
+
+		/* cleanup */
+		nds_list_destroy(list);
+	}
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_push_back() function.
+ */
+
+/**
+ * Test 1 - verify if the elements pushed at the back keep their order, for every node capacity
+ */
+int test_1_nds_list_push_back()
+{
+	int expected[100];
+	size_t c;
+	int i, result = 0;
+
+	for (c = 0; c < CAPACITIES && !result; c++)
+	{
+		NdsList *list = list_new(capacities[c]);
+
+		for (i = 0; i < 100 && !result; i++)
+		{
+			expected[i] = i;
+			if (nds_list_push_back(list, &i) != NDS_OK)
+				result = 1;
+		}
+
+		if (list_check(list, expected, 100))
+			result = 1;
+
+		/* cleanup */
+		nds_list_destroy(list);
+	}
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_pop_front() function.
+ */
+
+/**
+ * Test 1 - verify if the list works as a FIFO queue, for every node capacity
+ */
+int test_1_nds_list_pop_front()
+{
+	uint32_t state = 7;
+	size_t c;
+	int i, element, pushed, popped, result = 0;
+
+	for (c = 0; c < CAPACITIES && !result; c++)
+	{
+		NdsList *list = list_new(capacities[c]);
+
+		pushed = 0;
+		popped = 0;
+
+		for (i = 0; i < 5000 && !result; i++)
+		{
+			if (pushed == popped || test_random(&state) % 2)
+			{
+				if (nds_list_push_back(list, &pushed) != NDS_OK)
+					result = 1;
+
+				pushed++;
+			}
+			else if (nds_list_front(list, &element) != NDS_OK || element != popped || nds_list_pop_front(list, &element) != NDS_OK ||
+				element != popped++)
+				result = 1;
+		}
+
+		if (nds_list_size(list) != pushed - popped)
+			result = 1;
+
+		/* cleanup */
+		nds_list_destroy(list);
+	}
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_pop_back() function.
+ */
+
+/**
+ * Test 1 - verify if the list works as a LIFO stack from both of its ends, for every node capacity
+ */
+int test_1_nds_list_pop_back()
+{
+	size_t c;
+	int i, element, result = 0;
+
+	for (c = 0; c < CAPACITIES && !result; c++)
+	{
+		NdsList *list = list_new(capacities[c]);
+
+		for (i = 0; i < 200 && !result; i++)
+			if ((i < 100 ? nds_list_push_back(list, &i) : nds_list_push_front(list, &i)) != NDS_OK)
+				result = 1;
+
+		for (i = 99; i >= 0 && !result; i--)
+			if (nds_list_back(list, &element) != NDS_OK || element != i || nds_list_pop_back(list, &element) != NDS_OK || element != i)
+				result = 1;
+
+		/* the elements pushed in front are all that is left, the last one pushed is first */
+		for (i = 100; i < 200 && !result; i++)
+			if (nds_list_pop_back(list, &element) != NDS_OK || element != i)
+				result = 1;
+
+		if (nds_list_pop_back(list, &element) != NDS_INVALID_PARAM_ERROR)
+			result = 1;
+
+		/* cleanup */
+		nds_list_destroy(list);
+	}
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_clear() function.
+ */
+
+/**
+ * Test 1 - verify if a cleared list keeps its nodes for the next insertions
+ */
+int test_1_nds_list_clear()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	int expected[300];
+	size_t c;
+	int i, allocations, result = 0;
+
+	allocator = counting_allocator(&usage);
+
+	for (c = 0; c < CAPACITIES && !result; c++)
+	{
+		NdsList *list = nds_list_new_with_allocator(sizeof(int), capacities[c], &allocator);
+
+		for (i = 0; i < 300 && !result; i++)
+			if (nds_list_push_back(list, &i) != NDS_OK)
+				result = 1;
+
+		allocations = usage.allocations;
+
+		if (nds_list_clear(list) != NDS_OK || list_check(list, NULL, 0))
+			result = 1;
+
+		for (i = 0; i < 300 && !result; i++)
+		{
+			expected[i] = -i;
+			if (nds_list_push_back(list, &expected[i]) != NDS_OK)
+				result = 1;
+		}
+
+		if (usage.allocations != allocations || list_check(list, expected, 300) || nds_list_clear(NULL) != NDS_INVALID_PARAM_ERROR)
+			result = 1;
+
+		/* cleanup */
+		nds_list_destroy(list);
+	}
+
+	return result || usage.bytes != 0;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_first() function.
+ */
+
+/**
+ * Test 1 - verify if first(), last() and end() point to the ends of the list
+ */
+int test_1_nds_list_first()
+{
+	NdsList *list = nds_list_new_unrolled(sizeof(int));
+	NdsListIterator iterator;
+	int i, result = 0;
+
+	for (i = 0; i < 500; i++)
+		nds_list_push_back(list, &i);
+
+	if (nds_list_first(list, &iterator) != 1 || *(int*)iterator.element != 0 || nds_list_last(list, &iterator) != 1 ||
+		*(int*)iterator.element != 499 || nds_list_iterator_next(&iterator) != 0 || iterator.element != NULL)
+		result = 1;
+
+	if (nds_list_end(list, &iterator) != NDS_OK || iterator.element != NULL || nds_list_iterator_prev(&iterator) != 1 ||
+		*(int*)iterator.element != 499)
+		result = 1;
+
+	if (nds_list_first(NULL, &iterator) != -1 || nds_list_last(list, NULL) != -1 || nds_list_end(list, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_iterator_next() function.
+ */
+
+/**
+ * Test 1 - verify if next() refuses to move past the end and prev() stops before the first element
+ */
+int test_1_nds_list_iterator_next()
+{
+	NdsList *list = nds_list_new(sizeof(int));
+	NdsListIterator iterator;
+	int element = 3, result = 0;
+
+	nds_list_push_back(list, &element);
+
+	if (nds_list_first(list, &iterator) != 1 || nds_list_iterator_next(&iterator) != 0 || nds_list_iterator_next(&iterator) != -1)
+		result = 1;
+
+	if (nds_list_first(list, &iterator) != 1 || nds_list_iterator_prev(&iterator) != 0 || iterator.element != NULL)
+		result = 1;
+
+	if (nds_list_iterator_next(NULL) != -1 || nds_list_iterator_prev(NULL) != -1)
+		result = 1;
+
+	/* cleanup */
+	nds_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_insert() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_list_insert()
+ */
+int test_1_nds_list_insert()
+{
+	NdsList *list = nds_list_new(sizeof(int)), *other = nds_list_new(sizeof(int));
+	NdsListIterator iterator;
+	int element = 5, result = 0;
+
+	nds_list_end(other, &iterator);
+
+	/* the iterator of another list is refused */
+	if (nds_list_insert(list, &iterator, &element) != NDS_INVALID_PARAM_ERROR || nds_list_insert(other, &iterator, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_list_insert(other, NULL, &element) != NDS_INVALID_PARAM_ERROR || nds_list_size(list) != 0 || nds_list_size(other) != 0)
+		result = 1;
+
+	/* inserting at the end appends */
+	if (nds_list_insert(other, &iterator, &element) != NDS_OK || *(int*)iterator.element != 5 || nds_list_size(other) != 1)
+		result = 1;
+
+	/* cleanup */
+	nds_list_destroy(list);
+	nds_list_destroy(other);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if insertions before every position keep the order of the elements, for every node capacity
+ */
+int test_2_nds_list_insert()
+{
+	int model[400];
+	size_t c, size;
+	int result = 0;
+
+	for (c = 0; c < CAPACITIES && !result; c++)
+	{
+		NdsList *list = list_new(capacities[c]);
+
+		size = 0;
+
+		if (list_churn(list, model, &size, 400, 400, 0, 11) || size != 400)
+			result = 1;
+
+		/* cleanup */
+		nds_list_destroy(list);
+	}
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if inserting before the same position of a full node splits it in order
+ */
+int test_3_nds_list_insert()
+{
+	NdsList *list = nds_list_new_with_allocator(sizeof(int), 4, nds_allocator_default());
+	NdsListIterator iterator;
+	int expected[] = { 0, 1, 10, 11, 12, 13, 14, 2, 3 };
+	int i, result = 0;
+
+	for (i = 0; i < 4; i++)
+		nds_list_push_back(list, &i);
+
+	/* every insertion points the iterator to the new element, the next one goes after it */
+	list_seek(list, &iterator, 2);
+
+	for (i = 10; i < 15 && !result; i++)
+		if (nds_list_insert(list, &iterator, &i) != NDS_OK || *(int*)iterator.element != i || nds_list_iterator_next(&iterator) != 1)
+			result = 1;
+
+	if (list_check(list, expected, 9))
+		result = 1;
+
+	/* cleanup */
+	nds_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_erase() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_list_erase()
+ */
+int test_1_nds_list_erase()
+{
+	NdsList *list = nds_list_new(sizeof(int));
+	NdsListIterator iterator;
+	int element = 5, result = 0;
+
+	nds_list_push_back(list, &element);
+	nds_list_end(list, &iterator);
+
+	/* the end is not an element */
+	if (nds_list_erase(list, &iterator, NULL) != NDS_INVALID_PARAM_ERROR || nds_list_erase(NULL, &iterator, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_list_size(list) != 1)
+		result = 1;
+
+	element = 0;
+
+	if (nds_list_first(list, &iterator) != 1 || nds_list_erase(list, &iterator, &element) != NDS_OK || element != 5 ||
+		iterator.element != NULL || nds_list_size(list) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_list_destroy(list);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify random insertions and removals against an array, for every node capacity
+ */
+int test_2_nds_list_erase()
+{
+	int model[300];
+	size_t c, size;
+	int result = 0;
+
+	for (c = 0; c < CAPACITIES && !result; c++)
+	{
+		NdsList *list = list_new(capacities[c]);
+
+		size = 0;
+
+		if (list_churn(list, model, &size, 300, 5000, 1, 23 + (uint32_t)c))
+			result = 1;
+
+		/* cleanup */
+		nds_list_destroy(list);
+	}
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if removals merge the nodes of an unrolled list so that they do not stay almost empty
+ */
+int test_3_nds_list_erase()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsListIterator iterator;
+	NdsList *list;
+	int i, allocations, result = 0;
+
+	allocator = counting_allocator(&usage);
+
+	list = nds_list_new_with_allocator(sizeof(int), 8, &allocator);
+	if (!list)
+		return 1;
+
+	for (i = 0; i < 1024; i++)
+		nds_list_push_back(list, &i);
+
+	/* removing three elements out of four leaves 256 elements in 128 full nodes, which merge two by two */
+	for (i = 0, nds_list_first(list, &iterator); iterator.element != NULL && !result; i++)
+		if (i % 4 != 0 ? nds_list_erase(list, &iterator, NULL) != NDS_OK : nds_list_iterator_next(&iterator) < 0)
+			result = 1;
+
+	/*
+	 * the 240 nodes of the four slabs hold 64 merged nodes, 64 free ones and 112 that were never used, so
+	 * 150 more full nodes take no new slab, while without the merges only the 112 unused nodes would be left
+	 */
+	allocations = usage.allocations;
+
+	for (i = 0; i < 1200 && !result; i++)
+		if (nds_list_push_back(list, &i) != NDS_OK)
+			result = 1;
+
+	if (nds_list_size(list) != 1456 || usage.allocations != allocations)
+		result = 1;
+
+	/* cleanup */
+	nds_list_destroy(list);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_splice() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_list_splice()
+ */
+int test_1_nds_list_splice()
+{
+	NdsList *list = nds_list_new(sizeof(int)), *other = nds_list_new(sizeof(int));
+	NdsList *unrolled = nds_list_new_unrolled(sizeof(int)), *wide = nds_list_new(sizeof(long long));
+	NdsListIterator iterator;
+	int element = 1, result = 0;
+
+	nds_list_push_back(other, &element);
+	nds_list_push_back(unrolled, &element);
+	nds_list_end(list, &iterator);
+
+	/* the lists must manage their nodes alike, and a list cannot be spliced into itself */
+	if (nds_list_splice(list, &iterator, unrolled) != NDS_INVALID_PARAM_ERROR || nds_list_splice(list, &iterator, wide) != NDS_INVALID_PARAM_ERROR ||
+		nds_list_splice(list, &iterator, list) != NDS_INVALID_PARAM_ERROR || nds_list_splice(other, &iterator, list) != NDS_INVALID_PARAM_ERROR ||
+		nds_list_splice(list, &iterator, NULL) != NDS_INVALID_PARAM_ERROR || nds_list_size(list) != 0 || nds_list_size(unrolled) != 1)
+		result = 1;
+
+	/* cleanup */
+	nds_list_destroy(list);
+	nds_list_destroy(other);
+	nds_list_destroy(unrolled);
+	nds_list_destroy(wide);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if splicing inside a node puts the elements between its two parts, for every node capacity
+ */
+int test_2_nds_list_splice()
+{
+	int expected[150];
+	size_t c;
+	int i, result = 0;
+
+	for (c = 0; c < CAPACITIES && !result; c++)
+	{
+		NdsList *list = list_new(capacities[c]), *other = list_new(capacities[c]);
+		NdsListIterator iterator;
+
+		for (i = 0; i < 100; i++)
+		{
+			nds_list_push_back(list, &i);
+			expected[i < 37 ? i : i + 50] = i;
+		}
+
+		for (i = 0; i < 50; i++)
+		{
+			expected[37 + i] = 1000 + i;
+			nds_list_push_back(other, &expected[37 + i]);
+		}
+
+		/* the iterator keeps pointing to the element it pointed to before */
+		list_seek(list, &iterator, 37);
+
+		if (nds_list_splice(list, &iterator, other) != NDS_OK || *(int*)iterator.element != 37 || list_check(list, expected, 150) ||
+			list_check(other, NULL, 0))
+			result = 1;
+
+		/* the emptied list stays usable */
+		i = 7;
+		if (nds_list_push_back(other, &i) != NDS_OK || list_check(other, &i, 1))
+			result = 1;
+
+		/* cleanup */
+		nds_list_destroy(list);
+		nds_list_destroy(other);
+	}
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if the spliced nodes outlive the list they came from
+ */
+int test_3_nds_list_splice()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsListIterator iterator;
+	NdsList *list, *other;
+	int expected[400];
+	int i, result = 0;
+
+	allocator = counting_allocator(&usage);
+
+	list = nds_list_new_with_allocator(sizeof(int), 1, &allocator);
+	other = nds_list_new_with_allocator(sizeof(int), 1, &allocator);
+	if (!list || !other)
+		return 1;
+
+	for (i = 0; i < 200; i++)
+	{
+		expected[i] = i;
+		expected[200 + i] = 200 + i;
+		nds_list_push_back(other, &expected[i]);
+		nds_list_push_back(list, &expected[200 + i]);
+	}
+
+	/* a few free nodes are handed over as well */
+	nds_list_pop_back(other, NULL);
+	nds_list_push_back(other, &expected[199]);
+
+	nds_list_first(list, &iterator);
+
+	if (nds_list_splice(list, &iterator, other) != NDS_OK)
+		result = 1;
+
+	/* the other list gives its slabs away, so destroying it releases only its block */
+	nds_list_destroy(other);
+
+	for (i = 0; i < 100 && !result; i++)
+		if (nds_list_pop_front(list, NULL) != NDS_OK || nds_list_push_front(list, &expected[99 - i]) != NDS_OK)
+			result = 1;
+
+	if (list_check(list, expected, 400))
+		result = 1;
+
+	/* cleanup */
+	nds_list_destroy(list);
+
+	return result || usage.bytes != 0;
+}
+
+
+
+/**
+ * Unit tests for the nds_list_for_each() function.
+ */
+
+/**
+ * Test 1 - verify if for_each() visits every element once, for every node capacity
+ */
+int test_1_nds_list_for_each()
+{
+	long long sum;
+	size_t c;
+	int i, result = 0;
+
+	for (c = 0; c < CAPACITIES && !result; c++)
+	{
+		NdsList *list = list_new(capacities[c]);
+
+		for (i = 1; i <= 1000; i++)
+			nds_list_push_back(list, &i);
+
+		sum = 0;
+
+		if (nds_list_for_each(list, list_sum, &sum) != NDS_OK || sum != 500500 || nds_list_for_each(list, NULL, &sum) != NDS_INVALID_PARAM_ERROR)
+			result = 1;
+
+		/* cleanup */
+		nds_list_destroy(list);
+	}
+
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndslisttests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_list_new();
+
+		case 2:
+			return test_2_nds_list_new();
+
+		case 3:
+			return test_1_nds_list_new_unrolled();
+
+		case 4:
+			return test_1_nds_list_new_with_allocator();
+
+		case 5:
+			return test_2_nds_list_new_with_allocator();
+
+		case 6:
+			return test_1_nds_list_size();
+
+		case 7:
+			return test_1_nds_list_push_front();
+
+		case 8:
+			return test_2_nds_list_push_front();
+
+		case 9:
+			return test_1_nds_list_push_back();
+
+		case 10:
+			return test_1_nds_list_pop_front();
+
+		case 11:
+			return test_1_nds_list_pop_back();
+
+		case 12:
+			return test_1_nds_list_clear();
+
+		case 13:
+			return test_1_nds_list_first();
+
+		case 14:
+			return test_1_nds_list_iterator_next();
+
+		case 15:
+			return test_1_nds_list_insert();
+
+		case 16:
+			return test_2_nds_list_insert();
+
+		case 17:
+			return test_3_nds_list_insert();
+
+		case 18:
+			return test_1_nds_list_erase();
+
+		case 19:
+			return test_2_nds_list_erase();
+
+		case 20:
+			return test_3_nds_list_erase();
+
+		case 21:
+			return test_1_nds_list_splice();
+
+		case 22:
+			return test_2_nds_list_splice();
+
+		case 23:
+			return test_3_nds_list_splice();
+
+		case 24:
+			return test_1_nds_list_for_each();
+
+		default:
+			printf("No tests were found with the given ID!\n");
+			return 1;
+	}
+}
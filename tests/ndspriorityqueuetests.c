@@ -0,0 +1,917 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file defines various unit tests for the functionality of the
+ * NdsPriorityQueue data structure from the NDS library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndstesthelpers.h"
+
+#include <nds/ndspriorityqueue.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* an element whose priority is its key, the payload tells equal keys apart */
+struct Job
+{
+	uint32_t key;
+	uint32_t payload;
+};
+
+
+static int job_compare(const void *first, const void *second)
+{
+	uint32_t a = ((const struct Job*)first)->key, b = ((const struct Job*)second)->key;
+
+	return (a > b) - (a < b);
+}
+
+
+/* pops all the int elements and checks that there were size of them, in ascending order, with the given sum */
+static int heap_check(NdsPriorityQueue *queue, size_t size, long long sum)
+{
+	int element, previous = 0;
+	size_t i;
+
+	for (i = 0; i < size; i++)
+	{
+		if (nds_priority_queue_pop(queue, &element) != NDS_OK || (i > 0 && element < previous))
+			return 1;
+
+		previous = element;
+		sum -= element;
+	}
+
+	return sum != 0 || nds_priority_queue_size(queue) != 0;
+}
+
+
+/**
+ * Unit tests for the nds_priority_queue_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_priority_queue_new()
+ */
+int test_1_nds_priority_queue_new()
+{
+	/* new() should refuse elements without size and queues without comparison function */
+	return nds_priority_queue_new(0, int_compare) != NULL || nds_priority_queue_new(sizeof(int), NULL) != NULL;
+}
+
+
+/**
+ * Test 2 - verify if a new queue is empty
+ */
+int test_2_nds_priority_queue_new()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new(sizeof(int), int_compare);
+	int element = 0, result = 0;
+
+	if (!queue || nds_priority_queue_size(queue) != 0 || nds_priority_queue_top(queue, &element) != NDS_INVALID_PARAM_ERROR ||
+		nds_priority_queue_pop(queue, &element) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_new_with_allocator() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_priority_queue_new_with_allocator()
+ */
+int test_1_nds_priority_queue_new_with_allocator()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+
+	allocator = counting_allocator(&usage);
+	allocator.realloc = NULL;
+
+	/* the heap needs at least two children per element and an allocator that can reallocate */
+	return nds_priority_queue_new_with_allocator(sizeof(int), int_compare, 1, 16, 0, nds_allocator_default()) != NULL ||
+		nds_priority_queue_new_with_allocator(sizeof(int), int_compare, 4, 16, 0, &allocator) != NULL ||
+		nds_priority_queue_new_with_allocator(sizeof(int), int_compare, 4, 16, 0, NULL) != NULL ||
+		nds_priority_queue_new_with_allocator((size_t)-1, int_compare, 4, 16, 0, nds_allocator_default()) != NULL || usage.allocations != 0;
+}
+
+
+/**
+ * Test 2 - verify if heaps of several arities order the elements and take their memory from the allocator
+ */
+int test_2_nds_priority_queue_new_with_allocator()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	static const size_t arities[] = { 2, 3, 4, 8, 16 };
+	NdsPriorityQueue *queue;
+	uint32_t state = 5;
+	int element, i, result = 0;
+	long long sum;
+	size_t j;
+
+	allocator = counting_allocator(&usage);
+
+	for (j = 0; j < sizeof(arities) / sizeof(arities[0]); j++)
+	{
+		usage.allocations = 0;
+		queue = nds_priority_queue_new_with_allocator(sizeof(int), int_compare, arities[j], 1000, j % 2, &allocator);
+		if (!queue || usage.allocations != 2)
+		{
+			/* cleanup */
+			nds_priority_queue_destroy(queue);
+
+			return 1;
+		}
+
+		for (i = 0, sum = 0; i < 1000; i++)
+		{
+			element = (int)(test_random(&state) % 500) - 250;
+			sum += element;
+			nds_priority_queue_push(queue, &element);
+		}
+
+		/* the queue was created large enough */
+		if (usage.allocations != 2 || heap_check(queue, 1000, sum))
+			result = 1;
+
+		/* cleanup */
+		nds_priority_queue_destroy(queue);
+	}
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_new_from_vector() function.
+ */
+
+/**
+ * Test 1 - verify if the queue built from a vector pops its elements in order and leaves the vector unchanged
+ */
+int test_1_nds_priority_queue_new_from_vector()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	NdsPriorityQueue *queue = NULL;
+	uint32_t state = 17;
+	int element, i, result = 0;
+	long long sum = 0;
+
+	if (!vector)
+		return 1;
+
+	for (i = 0; i < 5000; i++)
+	{
+		element = (int)(test_random(&state) % 100000);
+		sum += element;
+		nds_vector_push_back(vector, &element);
+	}
+
+	queue = nds_priority_queue_new_from_vector(vector, int_compare);
+	if (!queue || nds_priority_queue_size(queue) != 5000 || heap_check(queue, 5000, sum))
+		result = 1;
+
+	/* the vector keeps its order */
+	state = 17;
+	for (i = 0; i < 5000; i++)
+		if (nds_vector_get(vector, (size_t)i, &element) != NDS_OK || element != (int)(test_random(&state) % 100000))
+			result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if an empty vector gives an empty queue that can grow
+ */
+int test_2_nds_priority_queue_new_from_vector()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	NdsPriorityQueue *queue = NULL;
+	int i, result = 0;
+
+	if (!vector)
+		return 1;
+
+	queue = nds_priority_queue_new_from_vector(vector, int_compare);
+	if (!queue || nds_priority_queue_new_from_vector(NULL, int_compare) != NULL || nds_priority_queue_new_from_vector(vector, NULL) != NULL)
+		result = 1;
+
+	for (i = 100; i > 0 && !result; i--)
+		nds_priority_queue_push(queue, &i);
+
+	if (result || heap_check(queue, 100, 5050))
+		result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_destroy() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_priority_queue_destroy()
+ */
+int test_1_nds_priority_queue_destroy()
+{
+	/* destroy() should ignore invalid queues */
+	nds_priority_queue_destroy(NULL);
+
+	return nds_priority_queue_size(NULL) != -1;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_reserve() function.
+ */
+
+/**
+ * Test 1 - verify if the handles of an indexed queue survive the growth of the queue
+ */
+int test_1_nds_priority_queue_reserve()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new_with_allocator(sizeof(int), int_compare, 4, 4, 1, nds_allocator_default());
+	size_t handles[20];
+	int element, i, result = 0;
+
+	if (!queue)
+		return 1;
+
+	/* the queue grows from 4 to 8, 16 and 32 elements while the handles are given */
+	for (i = 0; i < 20; i++)
+	{
+		element = 1000 - i;
+		if (nds_priority_queue_insert(queue, &element, &handles[i]) != NDS_OK)
+			result = 1;
+	}
+
+	if (nds_priority_queue_reserve(NULL, 100) != NDS_INVALID_PARAM_ERROR || nds_priority_queue_reserve(queue, 1000) != NDS_OK)
+		result = 1;
+
+	for (i = 0; i < 20; i++)
+		if (nds_priority_queue_get(queue, handles[i], &element) != NDS_OK || element != 1000 - i)
+			result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_push() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_priority_queue_push()
+ */
+int test_1_nds_priority_queue_push()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new(sizeof(int), int_compare);
+	int result = 0;
+
+	if (!queue)
+		return 1;
+
+	if (nds_priority_queue_push(NULL, &result) != NDS_INVALID_PARAM_ERROR || nds_priority_queue_push(queue, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_priority_queue_size(queue) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify a random mix of pushes and pops against a count of the elements in the queue
+ */
+int test_2_nds_priority_queue_push()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new(sizeof(int), int_compare);
+	int counts[256] = { 0 }, element, lowest, i, result = 0;
+	uint32_t state = 3;
+
+	if (!queue)
+		return 1;
+
+	for (i = 0; i < 100000 && !result; i++)
+	{
+		if (test_random(&state) % 3 != 0 || nds_priority_queue_size(queue) == 0)
+		{
+			element = (int)(test_random(&state) % 256);
+			counts[element]++;
+			nds_priority_queue_push(queue, &element);
+		}
+		else
+		{
+			for (lowest = 0; counts[lowest] == 0; lowest++)
+				;
+
+			if (nds_priority_queue_pop(queue, &element) != NDS_OK || element != lowest)
+				result = 1;
+			counts[lowest]--;
+		}
+	}
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_push_n() function.
+ */
+
+/**
+ * Test 1 - verify both the batches that are sifted up and the ones that rebuild the heap
+ */
+int test_1_nds_priority_queue_push_n()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new(sizeof(int), int_compare);
+	int elements[3000], i, result = 0;
+	long long sum = 0;
+	uint32_t state = 23;
+
+	if (!queue)
+		return 1;
+
+	for (i = 0; i < 3000; i++)
+	{
+		elements[i] = (int)(test_random(&state) % 10000);
+		sum += elements[i];
+	}
+
+	if (nds_priority_queue_push_n(NULL, elements, 3) != NDS_INVALID_PARAM_ERROR || nds_priority_queue_push_n(queue, NULL, 3) != NDS_INVALID_PARAM_ERROR ||
+		nds_priority_queue_push_n(queue, NULL, 0) != NDS_OK)
+		result = 1;
+
+	/* 1000 elements rebuild the empty heap, 1500 more rebuild it again and 500 more are sifted up */
+	if (nds_priority_queue_push_n(queue, elements, 1000) != NDS_OK || nds_priority_queue_push_n(queue, elements + 1000, 1500) != NDS_OK ||
+		nds_priority_queue_push_n(queue, elements + 2500, 500) != NDS_OK)
+		result = 1;
+
+	if (nds_priority_queue_size(queue) != 3000 || heap_check(queue, 3000, sum))
+		result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the batches of an indexed queue keep the handles consistent
+ */
+int test_2_nds_priority_queue_push_n()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new_with_allocator(sizeof(int), int_compare, 4, 0, 1, nds_allocator_default());
+	int elements[64], element, i, result = 0;
+	size_t handle;
+
+	if (!queue)
+		return 1;
+
+	for (i = 0; i < 64; i++)
+		elements[i] = 64 - i;
+
+	nds_priority_queue_insert(queue, elements + 10, &handle);
+	nds_priority_queue_push_n(queue, elements, 64);
+	nds_priority_queue_push_n(queue, elements, 8);
+
+	/* the handle still finds its element after the heap was rebuilt, and the element can move to the top */
+	if (nds_priority_queue_get(queue, handle, &element) != NDS_OK || element != 54)
+		result = 1;
+
+	element = -1;
+	if (nds_priority_queue_update(queue, handle, &element) != NDS_OK)
+		result = 1;
+
+	if (nds_priority_queue_top(queue, &element) != NDS_OK || element != -1 || heap_check(queue, 73, -1 + 64 * 65 / 2 + (64 + 57) * 8 / 2))
+		result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_top() function.
+ */
+
+/**
+ * Test 1 - verify if top() copies the lowest element without removing it
+ */
+int test_1_nds_priority_queue_top()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new(sizeof(int), int_compare);
+	int elements[5] = { 7, 3, 9, 3, 5 }, element = 0, result = 0;
+
+	if (!queue)
+		return 1;
+
+	nds_priority_queue_push_n(queue, elements, 5);
+
+	if (nds_priority_queue_top(queue, NULL) != NDS_INVALID_PARAM_ERROR || nds_priority_queue_top(queue, &element) != NDS_OK || element != 3 ||
+		nds_priority_queue_size(queue) != 5)
+		result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_pop() function.
+ */
+
+/**
+ * Test 1 - verify if pop() removes elements of several bytes with equal keys whole
+ */
+int test_1_nds_priority_queue_pop()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new(sizeof(struct Job), job_compare);
+	struct Job job;
+	uint32_t seen[4] = { 0 }, i;
+	int result = 0;
+
+	if (!queue)
+		return 1;
+
+	/* four jobs for every key, their payloads are key * 4 + j */
+	for (i = 0; i < 400; i++)
+	{
+		job.key = (i * 37) % 100;
+		job.payload = job.key * 4 + i / 100;
+		nds_priority_queue_push(queue, &job);
+	}
+
+	for (i = 0; i < 400; i++)
+	{
+		if (nds_priority_queue_pop(queue, i % 2 ? &job : NULL) != NDS_OK)
+			result = 1;
+
+		if (i % 2 && (job.key != i / 4 || job.payload / 4 != job.key))
+			result = 1;
+
+		if (i % 2)
+			seen[job.payload % 4]++;
+	}
+
+	if (nds_priority_queue_pop(queue, &job) != NDS_INVALID_PARAM_ERROR || seen[0] + seen[1] + seen[2] + seen[3] != 200)
+		result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_pop_n() function.
+ */
+
+/**
+ * Test 1 - verify if pop_n() removes at most the elements of the queue, in order
+ */
+int test_1_nds_priority_queue_pop_n()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new(sizeof(int), int_compare);
+	int elements[20], i, result = 0;
+
+	if (!queue)
+		return 1;
+
+	for (i = 0; i < 12; i++)
+		elements[i] = (i * 5) % 12;
+	nds_priority_queue_push_n(queue, elements, 12);
+
+	if (nds_priority_queue_pop_n(NULL, elements, 4) != -1 || nds_priority_queue_pop_n(queue, elements, 4) != 4 || nds_priority_queue_pop_n(queue, NULL, 2) != 2 ||
+		nds_priority_queue_pop_n(queue, elements + 4, 20) != 6 || nds_priority_queue_pop_n(queue, elements, 20) != 0)
+		result = 1;
+
+	for (i = 0; i < 4; i++)
+		if (elements[i] != i)
+			result = 1;
+
+	for (i = 4; i < 10; i++)
+		if (elements[i] != i + 2)
+			result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_clear() function.
+ */
+
+/**
+ * Test 1 - verify if clear() empties an indexed queue and releases its handles
+ */
+int test_1_nds_priority_queue_clear()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new_with_allocator(sizeof(int), int_compare, 4, 0, 1, nds_allocator_default());
+	size_t first, second;
+	int element = 1, result = 0;
+
+	if (!queue)
+		return 1;
+
+	nds_priority_queue_insert(queue, &element, &first);
+	nds_priority_queue_insert(queue, &element, &second);
+
+	if (nds_priority_queue_clear(NULL) != NDS_INVALID_PARAM_ERROR || nds_priority_queue_clear(queue) != NDS_OK || nds_priority_queue_size(queue) != 0 ||
+		nds_priority_queue_get(queue, second, &element) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_insert() function.
+ */
+
+/**
+ * Test 1 - verify if insert() refuses a queue without handles
+ */
+int test_1_nds_priority_queue_insert()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new(sizeof(int), int_compare);
+	size_t handle;
+	int element = 1, result = 0;
+
+	if (!queue)
+		return 1;
+
+	if (nds_priority_queue_insert(queue, &element, &handle) != NDS_INVALID_PARAM_ERROR || nds_priority_queue_update(queue, 0, &element) != NDS_INVALID_PARAM_ERROR ||
+		nds_priority_queue_remove(queue, 0, NULL) != NDS_INVALID_PARAM_ERROR || nds_priority_queue_size(queue) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the handles given by insert() are distinct and reused once their elements are popped
+ */
+int test_2_nds_priority_queue_insert()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new_with_allocator(sizeof(int), int_compare, 4, 0, 1, nds_allocator_default());
+	size_t handles[10], handle;
+	int element, i, result = 0;
+
+	if (!queue)
+		return 1;
+
+	for (i = 0; i < 10; i++)
+	{
+		element = i;
+		if (nds_priority_queue_insert(queue, &element, &handles[i]) != NDS_OK || handles[i] != (size_t)i)
+			result = 1;
+	}
+
+	if (nds_priority_queue_insert(queue, &element, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* popping 0 releases the handle 0, which is not valid any more until it is given again */
+	nds_priority_queue_pop(queue, &element);
+	if (nds_priority_queue_get(queue, handles[0], &element) != NDS_INVALID_PARAM_ERROR || nds_priority_queue_insert(queue, &element, &handle) != NDS_OK ||
+		handle != handles[0])
+		result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_update() function.
+ */
+
+/**
+ * Test 1 - verify if update() moves an element up and down
+ */
+int test_1_nds_priority_queue_update()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new_with_allocator(sizeof(int), int_compare, 2, 0, 1, nds_allocator_default());
+	size_t handles[100];
+	int element, i, result = 0;
+
+	if (!queue)
+		return 1;
+
+	for (i = 0; i < 100; i++)
+	{
+		element = i * 10;
+		nds_priority_queue_insert(queue, &element, &handles[i]);
+	}
+
+	/* the last element goes to the top and the first one to the bottom */
+	element = -5;
+	nds_priority_queue_update(queue, handles[99], &element);
+	element = 5000;
+	nds_priority_queue_update(queue, handles[0], &element);
+
+	if (nds_priority_queue_update(queue, 1000, &element) != NDS_INVALID_PARAM_ERROR || nds_priority_queue_update(queue, handles[1], NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	if (nds_priority_queue_pop(queue, &element) != NDS_OK || element != -5 || nds_priority_queue_top(queue, &element) != NDS_OK || element != 10)
+		result = 1;
+
+	if (nds_priority_queue_get(queue, handles[0], &element) != NDS_OK || element != 5000 || heap_check(queue, 99, 5000 + 10 * (98 * 99 / 2)))
+		result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify random decreases and increases of keys against an array of the keys
+ */
+int test_2_nds_priority_queue_update()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new_with_allocator(sizeof(struct Job), job_compare, 4, 0, 1, nds_allocator_default());
+	uint32_t keys[500], state = 41, lowest, i, j;
+	size_t handles[500];
+	struct Job job;
+	int result = 0;
+
+	if (!queue)
+		return 1;
+
+	for (i = 0; i < 500; i++)
+	{
+		job.key = keys[i] = test_random(&state) % 100000 * 500 + i;
+		job.payload = i;
+		nds_priority_queue_insert(queue, &job, &handles[i]);
+	}
+
+	/* the keys stay distinct, so the job with the lowest key is known */
+	for (i = 0; i < 5000 && !result; i++)
+	{
+		j = test_random(&state) % 500;
+		job.key = keys[j] = test_random(&state) % 100000 * 500 + j;
+		job.payload = j;
+		nds_priority_queue_update(queue, handles[j], &job);
+
+		for (lowest = 0, j = 1; j < 500; j++)
+			if (keys[j] < keys[lowest])
+				lowest = j;
+
+		if (nds_priority_queue_top(queue, &job) != NDS_OK || job.payload != lowest || job.key != keys[lowest])
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_get() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_priority_queue_get()
+ */
+int test_1_nds_priority_queue_get()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new_with_allocator(sizeof(int), int_compare, 4, 0, 1, nds_allocator_default());
+	size_t handle;
+	int element = 4, result = 0;
+
+	if (!queue)
+		return 1;
+
+	nds_priority_queue_insert(queue, &element, &handle);
+
+	if (nds_priority_queue_get(NULL, handle, &element) != NDS_INVALID_PARAM_ERROR || nds_priority_queue_get(queue, handle, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_priority_queue_get(queue, handle + 1, &element) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	element = 0;
+	if (nds_priority_queue_get(queue, handle, &element) != NDS_OK || element != 4)
+		result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_priority_queue_remove() function.
+ */
+
+/**
+ * Test 1 - verify if remove() takes out any element and keeps the rest in order
+ */
+int test_1_nds_priority_queue_remove()
+{
+	NdsPriorityQueue *queue = nds_priority_queue_new_with_allocator(sizeof(int), int_compare, 3, 0, 1, nds_allocator_default());
+	size_t handles[1000];
+	int element, i, result = 0;
+	long long sum = 0;
+	uint32_t state = 9;
+
+	if (!queue)
+		return 1;
+
+	for (i = 0; i < 1000; i++)
+	{
+		element = (int)(test_random(&state) % 5000);
+		nds_priority_queue_insert(queue, &element, &handles[i]);
+		sum += element;
+	}
+
+	/* every third element is removed, the removed elements come out whole */
+	for (i = 0; i < 1000 && !result; i += 3)
+	{
+		if (nds_priority_queue_get(queue, handles[i], &element) != NDS_OK)
+			result = 1;
+		sum -= element;
+
+		if (nds_priority_queue_remove(queue, handles[i], i % 2 ? &element : NULL) != NDS_OK ||
+			nds_priority_queue_remove(queue, handles[i], NULL) != NDS_INVALID_PARAM_ERROR)
+			result = 1;
+	}
+
+	if (result || heap_check(queue, 666, sum))
+		result = 1;
+
+	/* cleanup */
+	nds_priority_queue_destroy(queue);
+
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndspriorityqueuetests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_priority_queue_new();
+
+		case 2:
+			return test_2_nds_priority_queue_new();
+
+		case 3:
+			return test_1_nds_priority_queue_new_with_allocator();
+
+		case 4:
+			return test_2_nds_priority_queue_new_with_allocator();
+
+		case 5:
+			return test_1_nds_priority_queue_new_from_vector();
+
+		case 6:
+			return test_2_nds_priority_queue_new_from_vector();
+
+		case 7:
+			return test_1_nds_priority_queue_destroy();
+
+		case 8:
+			return test_1_nds_priority_queue_reserve();
+
+		case 9:
+			return test_1_nds_priority_queue_push();
+
+		case 10:
+			return test_2_nds_priority_queue_push();
+
+		case 11:
+			return test_1_nds_priority_queue_push_n();
+
+		case 12:
+			return test_2_nds_priority_queue_push_n();
+
+		case 13:
+			return test_1_nds_priority_queue_top();
+
+		case 14:
+			return test_1_nds_priority_queue_pop();
+
+		case 15:
+			return test_1_nds_priority_queue_pop_n();
+
+		case 16:
+			return test_1_nds_priority_queue_clear();
+
+		case 17:
+			return test_1_nds_priority_queue_insert();
+
+		case 18:
+			return test_2_nds_priority_queue_insert();
+
+		case 19:
+			return test_1_nds_priority_queue_update();
+
+		case 20:
+			return test_2_nds_priority_queue_update();
+
+		case 21:
+			return test_1_nds_priority_queue_get();
+
+		case 22:
+			return test_1_nds_priority_queue_remove();
+
+		default:
+			printf("No tests were found with the given ID!\n");
+			return 1;
+	}
+}
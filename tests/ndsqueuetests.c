@@ -0,0 +1,924 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file defines various unit tests for the functionality of the
+ * NdsQueue and NdsSpscQueue data structures from the NDS library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ndstesthelpers.h"
+
+#include <nds/ndsqueue.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* number of elements moved between the two threads of the concurrent tests */
+#define TRANSFER_ELEMENTS 200000
+
+
+/* dequeues count elements and checks that they are first, first + 1, ... */
+static int queue_check(NdsQueue *queue, int first, int count)
+{
+	int i, element;
+
+	for (i = 0; i < count; i++)
+		if (nds_queue_dequeue(queue, &element) != NDS_OK || element != first + i)
+			return 1;
+
+	return 0;
+}
+
+
+/* arguments of the producer and of the consumer of the concurrent tests */
+struct TransferThread
+{
+	NdsSpscQueue *queue;
+	size_t batch;
+	int failed;
+};
+
+
+/* enqueues 0, 1, ..., TRANSFER_ELEMENTS - 1, batch elements at a time (one by one when batch is 1) */
+static void* producer_thread(void *context)
+{
+	struct TransferThread *arguments = (struct TransferThread*)context;
+	uint32_t elements[64];
+	uint32_t next = 0;
+	size_t i, count;
+	ssize_t added;
+
+	while (next < TRANSFER_ELEMENTS)
+	{
+		count = TRANSFER_ELEMENTS - next < arguments->batch ? TRANSFER_ELEMENTS - next : arguments->batch;
+		for (i = 0; i < count; i++)
+			elements[i] = next + (uint32_t)i;
+
+		if (arguments->batch == 1)
+			added = nds_spsc_queue_try_enqueue(arguments->queue, elements);
+		else
+			added = nds_spsc_queue_enqueue_n(arguments->queue, elements, count);
+
+		if (added < 0)
+		{
+			arguments->failed = 1;
+			return NULL;
+		}
+
+		/* the other thread may share the processor, so we give it the chance to empty the queue */
+		if (added == 0)
+			sched_yield();
+
+		next += (uint32_t)added;
+	}
+
+	return NULL;
+}
+
+
+/* dequeues TRANSFER_ELEMENTS elements and checks that they come in the order in which they were enqueued */
+static void* consumer_thread(void *context)
+{
+	struct TransferThread *arguments = (struct TransferThread*)context;
+	uint32_t elements[64];
+	uint32_t next = 0;
+	ssize_t removed, i;
+
+	while (next < TRANSFER_ELEMENTS)
+	{
+		if (arguments->batch == 1)
+			removed = nds_spsc_queue_try_dequeue(arguments->queue, elements);
+		else
+			removed = nds_spsc_queue_dequeue_n(arguments->queue, elements, arguments->batch);
+
+		if (removed < 0)
+		{
+			arguments->failed = 1;
+			return NULL;
+		}
+
+		if (removed == 0)
+			sched_yield();
+
+		for (i = 0; i < removed; i++)
+			if (elements[i] != next++)
+				arguments->failed = 1;
+	}
+
+	return NULL;
+}
+
+
+/* moves TRANSFER_ELEMENTS elements through a small queue between two threads */
+static int transfer(size_t batch)
+{
+	NdsSpscQueue *queue = nds_spsc_queue_new(sizeof(uint32_t), 128);
+	struct TransferThread producer, consumer;
+	pthread_t threads[2];
+	int result = 0;
+
+	if (!queue)
+		return 1;
+
+	producer.queue = consumer.queue = queue;
+	producer.batch = consumer.batch = batch;
+	producer.failed = consumer.failed = 0;
+
+	pthread_create(&threads[0], NULL, producer_thread, &producer);
+	pthread_create(&threads[1], NULL, consumer_thread, &consumer);
+	pthread_join(threads[0], NULL);
+	pthread_join(threads[1], NULL);
+
+	if (producer.failed || consumer.failed || nds_spsc_queue_size(queue) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_spsc_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Unit tests for the nds_queue_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_queue_new()
+ */
+int test_1_nds_queue_new()
+{
+	NdsQueue *queue = nds_queue_new(0);
+
+	/* new() should refuse elements without size */
+	return queue != NULL;
+}
+
+
+/**
+ * Test 2 - verify if a new queue is empty and has room for 16 elements
+ */
+int test_2_nds_queue_new()
+{
+	NdsQueue *queue = nds_queue_new(sizeof(int));
+	int element = 0, result = 0;
+
+	if (!queue || nds_queue_size(queue) != 0 || nds_queue_capacity(queue) != 16 || nds_queue_front(queue, &element) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_queue_new_with_allocator() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_queue_new_with_allocator()
+ */
+int test_1_nds_queue_new_with_allocator()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+
+	allocator = counting_allocator(&usage);
+	allocator.realloc = NULL;
+
+	/* the queue grows in place, so it needs an allocator that can reallocate */
+	return nds_queue_new_with_allocator(sizeof(int), 16, NULL) != NULL || nds_queue_new_with_allocator(sizeof(int), 16, &allocator) != NULL ||
+		nds_queue_new_with_allocator((size_t)-1, 16, nds_allocator_default()) != NULL || usage.allocations != 0;
+}
+
+
+/**
+ * Test 2 - verify if the capacity is rounded up to a power of two and all the memory comes from the allocator
+ */
+int test_2_nds_queue_new_with_allocator()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsQueue *queue;
+	int result = 0;
+
+	allocator = counting_allocator(&usage);
+	queue = nds_queue_new_with_allocator(sizeof(int), 100, &allocator);
+
+	if (!queue || nds_queue_capacity(queue) != 128 || usage.allocations != 2)
+		result = 1;
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	queue = nds_queue_new_with_allocator(sizeof(int), 3, &allocator);
+	if (!queue || nds_queue_capacity(queue) != 16)
+		result = 1;
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_queue_destroy() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_queue_destroy()
+ */
+int test_1_nds_queue_destroy()
+{
+	/* destroy() should ignore invalid queues */
+	nds_queue_destroy(NULL);
+
+	return nds_queue_size(NULL) != -1 || nds_queue_capacity(NULL) != -1;
+}
+
+
+
+/**
+ * Unit tests for the nds_queue_reserve() function.
+ */
+
+/**
+ * Test 1 - verify if reserve() rounds the capacity up and keeps wrapped elements in order
+ */
+int test_1_nds_queue_reserve()
+{
+	NdsQueue *queue = nds_queue_new(sizeof(int));
+	int i, result = 0;
+
+	if (!queue)
+		return 1;
+
+	/* the elements 10 .. 19 start at the slot 10 and wrap after the slot 15 */
+	for (i = 0; i < 16; i++)
+		nds_queue_enqueue(queue, &i);
+	nds_queue_dequeue_n(queue, NULL, 10);
+	for (i = 16; i < 20; i++)
+		nds_queue_enqueue(queue, &i);
+
+	if (nds_queue_reserve(NULL, 64) != NDS_INVALID_PARAM_ERROR || nds_queue_reserve(queue, 8) != NDS_OK || nds_queue_capacity(queue) != 16)
+		result = 1;
+
+	if (nds_queue_reserve(queue, 100) != NDS_OK || nds_queue_capacity(queue) != 128 || nds_queue_size(queue) != 10 || queue_check(queue, 10, 10))
+		result = 1;
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_queue_enqueue() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_queue_enqueue()
+ */
+int test_1_nds_queue_enqueue()
+{
+	NdsQueue *queue = nds_queue_new(sizeof(int));
+	int result = 0;
+
+	if (!queue)
+		return 1;
+
+	if (nds_queue_enqueue(NULL, &result) != NDS_INVALID_PARAM_ERROR || nds_queue_enqueue(queue, NULL) != NDS_INVALID_PARAM_ERROR || nds_queue_size(queue) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify the growth of a full queue whose wrapped part is the shorter one
+ */
+int test_2_nds_queue_enqueue()
+{
+	NdsQueue *queue = nds_queue_new(sizeof(int));
+	int i, result = 0;
+
+	if (!queue)
+		return 1;
+
+	/* the elements 3 .. 18 fill the queue from the slot 3, so only 3 of them wrap */
+	for (i = 0; i < 16; i++)
+		nds_queue_enqueue(queue, &i);
+	nds_queue_dequeue_n(queue, NULL, 3);
+	for (i = 16; i < 19; i++)
+		nds_queue_enqueue(queue, &i);
+
+	for (i = 19; i < 40; i++)
+		if (nds_queue_enqueue(queue, &i) != NDS_OK)
+			result = 1;
+
+	if (nds_queue_capacity(queue) != 64 || nds_queue_size(queue) != 37 || queue_check(queue, 3, 37))
+		result = 1;
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify the growth of a full queue whose part at the end of the buffer is the shorter one
+ */
+int test_3_nds_queue_enqueue()
+{
+	NdsQueue *queue = nds_queue_new(sizeof(int));
+	int i, result = 0;
+
+	if (!queue)
+		return 1;
+
+	/* the elements 12 .. 27 fill the queue from the slot 12, so 12 of them wrap */
+	for (i = 0; i < 16; i++)
+		nds_queue_enqueue(queue, &i);
+	nds_queue_dequeue_n(queue, NULL, 12);
+	for (i = 16; i < 28; i++)
+		nds_queue_enqueue(queue, &i);
+
+	for (i = 28; i < 40; i++)
+		if (nds_queue_enqueue(queue, &i) != NDS_OK)
+			result = 1;
+
+	if (nds_queue_capacity(queue) != 32 || nds_queue_size(queue) != 28 || queue_check(queue, 12, 28))
+		result = 1;
+
+	/* the queue should keep working after the front moved to the end of the new buffer */
+	for (i = 0; i < 100; i++)
+		nds_queue_enqueue(queue, &i);
+	if (queue_check(queue, 0, 100) || nds_queue_size(queue) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_queue_enqueue_n() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_queue_enqueue_n()
+ */
+int test_1_nds_queue_enqueue_n()
+{
+	NdsQueue *queue = nds_queue_new(sizeof(int));
+	int elements[4] = { 0, 1, 2, 3 }, result = 0;
+
+	if (!queue)
+		return 1;
+
+	if (nds_queue_enqueue_n(NULL, elements, 4) != NDS_INVALID_PARAM_ERROR || nds_queue_enqueue_n(queue, NULL, 4) != NDS_INVALID_PARAM_ERROR ||
+		nds_queue_enqueue_n(queue, NULL, 0) != NDS_OK || nds_queue_size(queue) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if enqueue_n() wraps around the end of the buffer and grows it at most once
+ */
+int test_2_nds_queue_enqueue_n()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsQueue *queue;
+	int elements[200], i, result = 0;
+
+	allocator = counting_allocator(&usage);
+	queue = nds_queue_new_with_allocator(sizeof(int), 16, &allocator);
+	if (!queue)
+		return 1;
+
+	for (i = 0; i < 200; i++)
+		elements[i] = i;
+
+	/* 10 elements from the slot 10 wrap after the slot 15 */
+	nds_queue_enqueue_n(queue, elements, 10);
+	nds_queue_dequeue_n(queue, NULL, 10);
+	if (nds_queue_enqueue_n(queue, elements, 10) != NDS_OK || nds_queue_capacity(queue) != 16 || queue_check(queue, 0, 10))
+		result = 1;
+
+	nds_queue_enqueue_n(queue, elements, 5);
+	if (nds_queue_enqueue_n(queue, elements + 5, 195) != NDS_OK || nds_queue_capacity(queue) != 256 || nds_queue_size(queue) != 200 ||
+		queue_check(queue, 0, 200))
+		result = 1;
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_queue_dequeue() function.
+ */
+
+/**
+ * Test 1 - verify if dequeue() refuses an empty queue
+ */
+int test_1_nds_queue_dequeue()
+{
+	NdsQueue *queue = nds_queue_new(sizeof(int));
+	int element = 7, result = 0;
+
+	if (!queue)
+		return 1;
+
+	if (nds_queue_dequeue(NULL, &element) != NDS_INVALID_PARAM_ERROR || nds_queue_dequeue(queue, &element) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* the element can be dropped */
+	nds_queue_enqueue(queue, &element);
+	if (nds_queue_dequeue(queue, NULL) != NDS_OK || nds_queue_size(queue) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify the FIFO order of a random mix of single and batched operations
+ */
+int test_2_nds_queue_dequeue()
+{
+	NdsQueue *queue = nds_queue_new(sizeof(uint64_t));
+	uint64_t elements[40], element, next_in = 0, next_out = 0;
+	uint32_t state = 11, count, i;
+	int result = 0;
+
+	if (!queue)
+		return 1;
+
+	while (next_in < 100000 && !result)
+	{
+		count = test_random(&state) % 40;
+
+		switch (test_random(&state) % 4)
+		{
+			case 0:
+				if (nds_queue_enqueue(queue, &next_in) != NDS_OK)
+					result = 1;
+				next_in++;
+				break;
+
+			case 1:
+				for (i = 0; i < count; i++)
+					elements[i] = next_in++;
+				if (nds_queue_enqueue_n(queue, elements, count) != NDS_OK)
+					result = 1;
+				break;
+
+			case 2:
+				if (next_out < next_in && (nds_queue_dequeue(queue, &element) != NDS_OK || element != next_out++))
+					result = 1;
+				break;
+
+			default:
+				count = nds_queue_dequeue_n(queue, elements, count);
+				for (i = 0; i < count; i++)
+					if (elements[i] != next_out++)
+						result = 1;
+				break;
+		}
+
+		if (nds_queue_size(queue) != (ssize_t)(next_in - next_out))
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_queue_dequeue_n() function.
+ */
+
+/**
+ * Test 1 - verify if dequeue_n() removes at most the elements of the queue
+ */
+int test_1_nds_queue_dequeue_n()
+{
+	NdsQueue *queue = nds_queue_new(sizeof(int));
+	int elements[16] = { 0 }, i, result = 0;
+
+	if (!queue)
+		return 1;
+
+	for (i = 0; i < 12; i++)
+		nds_queue_enqueue(queue, &i);
+
+	if (nds_queue_dequeue_n(NULL, elements, 4) != -1 || nds_queue_dequeue_n(queue, elements, 4) != 4 || elements[3] != 3)
+		result = 1;
+
+	if (nds_queue_dequeue_n(queue, elements, 16) != 8 || elements[0] != 4 || elements[7] != 11 || nds_queue_dequeue_n(queue, elements, 16) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_queue_front() function.
+ */
+
+/**
+ * Test 1 - verify if front() copies the first element without removing it
+ */
+int test_1_nds_queue_front()
+{
+	NdsQueue *queue = nds_queue_new(sizeof(int));
+	int element = 5, result = 0;
+
+	if (!queue)
+		return 1;
+
+	nds_queue_enqueue(queue, &element);
+	element = 6;
+	nds_queue_enqueue(queue, &element);
+
+	if (nds_queue_front(queue, NULL) != NDS_INVALID_PARAM_ERROR || nds_queue_front(queue, &element) != NDS_OK || element != 5 || nds_queue_size(queue) != 2)
+		result = 1;
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_queue_clear() function.
+ */
+
+/**
+ * Test 1 - verify if clear() empties the queue and keeps its capacity
+ */
+int test_1_nds_queue_clear()
+{
+	NdsQueue *queue = nds_queue_new(sizeof(int));
+	int i, result = 0;
+
+	if (!queue)
+		return 1;
+
+	for (i = 0; i < 40; i++)
+		nds_queue_enqueue(queue, &i);
+
+	if (nds_queue_clear(NULL) != NDS_INVALID_PARAM_ERROR || nds_queue_clear(queue) != NDS_OK || nds_queue_size(queue) != 0 || nds_queue_capacity(queue) != 64)
+		result = 1;
+
+	for (i = 0; i < 3; i++)
+		nds_queue_enqueue(queue, &i);
+	if (queue_check(queue, 0, 3))
+		result = 1;
+
+	/* cleanup */
+	nds_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_spsc_queue_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_spsc_queue_new()
+ */
+int test_1_nds_spsc_queue_new()
+{
+	/* new() should refuse elements without size and queues without room */
+	return nds_spsc_queue_new(0, 16) != NULL || nds_spsc_queue_new(sizeof(int), 0) != NULL || nds_spsc_queue_new_with_allocator(sizeof(int), 16, NULL) != NULL;
+}
+
+
+/**
+ * Test 2 - verify if a new queue is empty and its capacity is rounded up to a power of two
+ */
+int test_2_nds_spsc_queue_new()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsSpscQueue *queue;
+	int result = 0;
+
+	allocator = counting_allocator(&usage);
+	queue = nds_spsc_queue_new_with_allocator(sizeof(int), 5, &allocator);
+
+	if (!queue || nds_spsc_queue_capacity(queue) != 8 || nds_spsc_queue_size(queue) != 0 || usage.allocations != 2)
+		result = 1;
+
+	/* cleanup */
+	nds_spsc_queue_destroy(queue);
+	nds_spsc_queue_destroy(NULL);
+
+	return result || nds_spsc_queue_capacity(NULL) != -1 || nds_spsc_queue_size(NULL) != -1;
+}
+
+
+
+/**
+ * Unit tests for the nds_spsc_queue_try_enqueue() function.
+ */
+
+/**
+ * Test 1 - verify if try_enqueue() refuses a full queue
+ */
+int test_1_nds_spsc_queue_try_enqueue()
+{
+	NdsSpscQueue *queue = nds_spsc_queue_new(sizeof(int), 4);
+	int i, result = 0;
+
+	if (!queue)
+		return 1;
+
+	if (nds_spsc_queue_try_enqueue(NULL, &i) != -1 || nds_spsc_queue_try_enqueue(queue, NULL) != -1)
+		result = 1;
+
+	for (i = 0; i < 4; i++)
+		if (nds_spsc_queue_try_enqueue(queue, &i) != 1)
+			result = 1;
+
+	if (nds_spsc_queue_try_enqueue(queue, &i) != 0 || nds_spsc_queue_size(queue) != 4)
+		result = 1;
+
+	/* a removed element makes room for another one */
+	if (nds_spsc_queue_try_dequeue(queue, NULL) != 1 || nds_spsc_queue_try_enqueue(queue, &i) != 1)
+		result = 1;
+
+	/* cleanup */
+	nds_spsc_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_spsc_queue_enqueue_n() function.
+ */
+
+/**
+ * Test 1 - verify if enqueue_n() adds only the elements that fit
+ */
+int test_1_nds_spsc_queue_enqueue_n()
+{
+	NdsSpscQueue *queue = nds_spsc_queue_new(sizeof(int), 8);
+	int elements[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }, result = 0;
+
+	if (!queue)
+		return 1;
+
+	if (nds_spsc_queue_enqueue_n(queue, NULL, 3) != -1 || nds_spsc_queue_enqueue_n(queue, elements, 5) != 5 || nds_spsc_queue_enqueue_n(queue, elements + 5, 7) != 3)
+		result = 1;
+
+	if (nds_spsc_queue_enqueue_n(queue, elements, 1) != 0 || nds_spsc_queue_size(queue) != 8)
+		result = 1;
+
+	/* cleanup */
+	nds_spsc_queue_destroy(queue);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_spsc_queue_try_dequeue() function.
+ */
+
+/**
+ * Test 1 - verify if try_dequeue() removes the elements in order and refuses an empty queue
+ */
+int test_1_nds_spsc_queue_try_dequeue()
+{
+	NdsSpscQueue *queue = nds_spsc_queue_new(sizeof(int), 4);
+	int i, element, result = 0;
+
+	if (!queue)
+		return 1;
+
+	if (nds_spsc_queue_try_dequeue(queue, &element) != 0 || nds_spsc_queue_try_dequeue(NULL, &element) != -1)
+		result = 1;
+
+	/* the indexes go around the buffer several times */
+	for (i = 0; i < 50; i++)
+		if (nds_spsc_queue_try_enqueue(queue, &i) != 1 || nds_spsc_queue_try_dequeue(queue, &element) != 1 || element != i)
+			result = 1;
+
+	/* cleanup */
+	nds_spsc_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify the order of elements moved one by one between two threads
+ */
+int test_2_nds_spsc_queue_try_dequeue()
+{
+	return transfer(1);
+}
+
+
+
+/**
+ * Unit tests for the nds_spsc_queue_dequeue_n() function.
+ */
+
+/**
+ * Test 1 - verify if dequeue_n() wraps around the end of the buffer
+ */
+int test_1_nds_spsc_queue_dequeue_n()
+{
+	NdsSpscQueue *queue = nds_spsc_queue_new(sizeof(int), 8);
+	int elements[8] = { 0, 1, 2, 3, 4, 5, 6, 7 }, out[8] = { 0 }, result = 0;
+
+	if (!queue)
+		return 1;
+
+	/* the elements 0 .. 5 start at the slot 6 and wrap after the slot 7 */
+	nds_spsc_queue_enqueue_n(queue, elements, 6);
+	nds_spsc_queue_dequeue_n(queue, NULL, 6);
+	nds_spsc_queue_enqueue_n(queue, elements, 6);
+
+	if (nds_spsc_queue_dequeue_n(queue, out, 8) != 6 || memcmp(out, elements, 6 * sizeof(int)) != 0 || nds_spsc_queue_dequeue_n(queue, out, 8) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_spsc_queue_destroy(queue);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify the order of elements moved in batches between two threads
+ */
+int test_2_nds_spsc_queue_dequeue_n()
+{
+	return transfer(48);
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndsqueuetests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_queue_new();
+
+		case 2:
+			return test_2_nds_queue_new();
+
+		case 3:
+			return test_1_nds_queue_new_with_allocator();
+
+		case 4:
+			return test_2_nds_queue_new_with_allocator();
+
+		case 5:
+			return test_1_nds_queue_destroy();
+
+		case 6:
+			return test_1_nds_queue_reserve();
+
+		case 7:
+			return test_1_nds_queue_enqueue();
+
+		case 8:
+			return test_2_nds_queue_enqueue();
+
+		case 9:
+			return test_3_nds_queue_enqueue();
+
+		case 10:
+			return test_1_nds_queue_enqueue_n();
+
+		case 11:
+			return test_2_nds_queue_enqueue_n();
+
+		case 12:
+			return test_1_nds_queue_dequeue();
+
+		case 13:
+			return test_2_nds_queue_dequeue();
+
+		case 14:
+			return test_1_nds_queue_dequeue_n();
+
+		case 15:
+			return test_1_nds_queue_front();
+
+		case 16:
+			return test_1_nds_queue_clear();
+
+		case 17:
+			return test_1_nds_spsc_queue_new();
+
+		case 18:
+			return test_2_nds_spsc_queue_new();
+
+		case 19:
+			return test_1_nds_spsc_queue_try_enqueue();
+
+		case 20:
+			return test_1_nds_spsc_queue_enqueue_n();
+
+		case 21:
+			return test_1_nds_spsc_queue_try_dequeue();
+
+		case 22:
+			return test_2_nds_spsc_queue_try_dequeue();
+
+		case 23:
+			return test_1_nds_spsc_queue_dequeue_n();
+
+		case 24:
+			return test_2_nds_spsc_queue_dequeue_n();
+
+		default:
+			printf("No tests were found with the given ID!\n");
+			return 1;
+	}
+}
@@ -0,0 +1,569 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file defines various unit tests for the functionality of the
+ * NdsScheduler task scheduler from the NDS library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include <nds/ndsscheduler.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* marks the task in the array of counters given as context */
+static void parallel_mark_task(size_t index, void *context)
+{
+	__atomic_fetch_add((unsigned int*)context + index, 1, __ATOMIC_RELAXED);
+}
+
+
+/* every task marks 100 counters with a parallel run of its own */
+static void parallel_nested_task(size_t index, void *context)
+{
+	nds_parallel_run(100, parallel_mark_task, (unsigned int*)context + index * 100);
+}
+
+
+/* marks every index of a range in the array of counters given as context */
+static void parallel_mark_range(size_t begin, size_t end, void *context)
+{
+	for (; begin < end; begin++)
+		parallel_mark_task(begin, context);
+}
+
+
+/* the arguments and the result of a task that computes a Fibonacci number */
+struct FibonacciTask
+{
+	NdsScheduler *scheduler;
+	unsigned int n;
+	unsigned long result;
+};
+
+
+/* computes a Fibonacci number by spawning one of the two recursive calls */
+static void fibonacci_task(void *context)
+{
+	struct FibonacciTask *task = (struct FibonacciTask*)context;
+	struct FibonacciTask first, second;
+	NdsTask spawned;
+
+	if (task->n < 2)
+	{
+		task->result = task->n;
+		return;
+	}
+
+	first.scheduler = second.scheduler = task->scheduler;
+	first.n = task->n - 1;
+	second.n = task->n - 2;
+
+	nds_task_spawn(task->scheduler, &spawned, fibonacci_task, &first);
+	fibonacci_task(&second);
+	nds_task_wait(task->scheduler, &spawned);
+
+	task->result = first.result + second.result;
+}
+
+
+static void increment_task(void *context)
+{
+	__atomic_fetch_add((unsigned int*)context, 1, __ATOMIC_RELAXED);
+}
+
+
+/**
+ * Unit tests for the nds_scheduler_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_scheduler_new()
+ */
+int test_1_nds_scheduler_new()
+{
+	NdsScheduler *scheduler = nds_scheduler_new(NDS_MAX_WORKERS + 1);
+	int result = 0;
+
+	/* new() should refuse more threads than NDS_MAX_WORKERS */
+	if (scheduler != NULL)
+		result = 1;
+
+	/* cleanup */
+	nds_scheduler_destroy(scheduler);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if schedulers with and without worker threads are created
+ */
+int test_2_nds_scheduler_new()
+{
+	NdsScheduler *without_workers = nds_scheduler_new(0);
+	NdsScheduler *with_workers = nds_scheduler_new(3);
+	int result = 0;
+
+	if (!without_workers || !with_workers || nds_scheduler_thread_count(without_workers) != 0 || nds_scheduler_thread_count(with_workers) != 3)
+		result = 1;
+
+	/* cleanup */
+	nds_scheduler_destroy(without_workers);
+	nds_scheduler_destroy(with_workers);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_scheduler_destroy() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_scheduler_destroy()
+ */
+int test_1_nds_scheduler_destroy()
+{
+	NdsScheduler *scheduler = nds_scheduler_new(2);
+	unsigned int counter = 0;
+	NdsTask task;
+
+	/* destroy() should ignore NULL and stop the workers of a scheduler that ran tasks */
+	nds_scheduler_destroy(NULL);
+
+	nds_task_spawn(scheduler, &task, increment_task, &counter);
+	nds_task_wait(scheduler, &task);
+	nds_scheduler_destroy(scheduler);
+
+	return counter != 1;
+}
+
+
+
+/**
+ * Unit tests for the nds_scheduler_default() function.
+ */
+
+/**
+ * Test 1 - verify if the default scheduler is shared and follows the worker count
+ */
+int test_1_nds_scheduler_default()
+{
+	int result = 0;
+
+	nds_set_worker_count(3);
+
+	if (nds_scheduler_default() == NULL || nds_scheduler_default() != nds_scheduler_default() || nds_scheduler_thread_count(nds_scheduler_default()) != 2)
+		result = 1;
+
+	nds_set_worker_count(1);
+
+	if (nds_scheduler_thread_count(nds_scheduler_default()) != 0)
+		result = 1;
+
+	nds_set_worker_count(0);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_scheduler_thread_count() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_scheduler_thread_count()
+ */
+int test_1_nds_scheduler_thread_count()
+{
+	/* thread_count() should return -1 for an invalid scheduler */
+	return nds_scheduler_thread_count(NULL) != -1;
+}
+
+
+
+/**
+ * Unit tests for the nds_task_spawn() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_task_spawn()
+ */
+int test_1_nds_task_spawn()
+{
+	NdsScheduler *scheduler = nds_scheduler_new(1);
+	unsigned int counter = 0;
+	int result = 0;
+	NdsTask task;
+
+	if (nds_task_spawn(NULL, &task, increment_task, &counter) != NDS_INVALID_PARAM_ERROR ||
+		nds_task_spawn(scheduler, NULL, increment_task, &counter) != NDS_INVALID_PARAM_ERROR ||
+		nds_task_spawn(scheduler, &task, NULL, &counter) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_scheduler_destroy(scheduler);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if every task spawned from outside the scheduler runs once
+ */
+int test_2_nds_task_spawn()
+{
+	NdsScheduler *scheduler = nds_scheduler_new(3);
+	unsigned int counters[500];
+	NdsTask tasks[500];
+	int result = 0, i;
+
+	memset(counters, 0, sizeof(counters));
+
+	for (i = 0; i < 500; i++)
+		if (nds_task_spawn(scheduler, &tasks[i], increment_task, &counters[i]) != NDS_OK)
+			result = 1;
+
+	for (i = 0; i < 500; i++)
+		if (nds_task_wait(scheduler, &tasks[i]) != NDS_OK || counters[i] != 1)
+			result = 1;
+
+	/* cleanup */
+	nds_scheduler_destroy(scheduler);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_task_wait() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_task_wait()
+ */
+int test_1_nds_task_wait()
+{
+	NdsScheduler *scheduler = nds_scheduler_new(0);
+	int result = 0;
+	NdsTask task;
+
+	if (nds_task_wait(NULL, &task) != NDS_INVALID_PARAM_ERROR || nds_task_wait(scheduler, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_scheduler_destroy(scheduler);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if recursive fork/join tasks compute the right result
+ */
+int test_2_nds_task_wait()
+{
+	NdsScheduler *scheduler = nds_scheduler_new(3);
+	struct FibonacciTask task;
+	int result = 0;
+
+	/* the deques of the workers have to grow past their initial capacity */
+	task.scheduler = scheduler;
+	task.n = 25;
+	fibonacci_task(&task);
+
+	if (task.result != 75025)
+		result = 1;
+
+	/* cleanup */
+	nds_scheduler_destroy(scheduler);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if a scheduler without worker threads runs the tasks in the waiting thread
+ */
+int test_3_nds_task_wait()
+{
+	NdsScheduler *scheduler = nds_scheduler_new(0);
+	struct FibonacciTask task;
+	int result = 0;
+
+	task.scheduler = scheduler;
+	task.n = 15;
+	fibonacci_task(&task);
+
+	if (task.result != 610)
+		result = 1;
+
+	/* cleanup */
+	nds_scheduler_destroy(scheduler);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_parallel_for() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_parallel_for()
+ */
+int test_1_nds_parallel_for()
+{
+	NdsScheduler *scheduler = nds_scheduler_new(1);
+	unsigned int counters[10];
+	int result = 0;
+
+	if (nds_parallel_for(NULL, 0, 10, 0, parallel_mark_range, counters) != NDS_INVALID_PARAM_ERROR ||
+		nds_parallel_for(scheduler, 0, 10, 0, NULL, counters) != NDS_INVALID_PARAM_ERROR ||
+		nds_parallel_for(scheduler, 10, 0, 0, parallel_mark_range, counters) != NDS_INVALID_PARAM_ERROR ||
+		nds_parallel_for(scheduler, 5, 5, 0, parallel_mark_range, NULL) != NDS_OK)
+		result = 1;
+
+	/* cleanup */
+	nds_scheduler_destroy(scheduler);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if every index is processed exactly once for several grains
+ */
+int test_2_nds_parallel_for()
+{
+	static const size_t grains[] = { 0, 1, 7, 100000 };
+	NdsScheduler *scheduler = nds_scheduler_new(3);
+	unsigned int *counters = (unsigned int*)malloc(100000 * sizeof(unsigned int));
+	int result = 0;
+	size_t g, i;
+
+	for (g = 0; g < sizeof(grains) / sizeof(grains[0]); g++)
+	{
+		memset(counters, 0, 100000 * sizeof(unsigned int));
+
+		/* the indexes start at 3, so the first three counters stay at 0 */
+		if (nds_parallel_for(scheduler, 3, 100000, grains[g], parallel_mark_range, counters) != NDS_OK)
+			result = 1;
+
+		for (i = 0; i < 100000; i++)
+			if (counters[i] != (i >= 3))
+				result = 1;
+	}
+
+	/* cleanup */
+	free(counters);
+	nds_scheduler_destroy(scheduler);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_set_worker_count() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_set_worker_count()
+ */
+int test_1_nds_set_worker_count()
+{
+	int result = 0;
+
+	/* set_worker_count() should reject counts above NDS_MAX_WORKERS */
+	if (nds_set_worker_count(NDS_MAX_WORKERS + 1) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the worker count is reported back, with 0 meaning one per processor
+ */
+int test_2_nds_set_worker_count()
+{
+	int result = 0;
+
+	if (nds_set_worker_count(5) != NDS_OK || nds_get_worker_count() != 5)
+		result = 1;
+
+	if (nds_set_worker_count(0) != NDS_OK || nds_get_worker_count() < 1 || nds_get_worker_count() > NDS_MAX_WORKERS)
+		result = 1;
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_parallel_run() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_parallel_run()
+ */
+int test_1_nds_parallel_run()
+{
+	int result = 0;
+
+	/* parallel_run() should reject a missing function and do nothing for no tasks */
+	if (nds_parallel_run(10, NULL, NULL) != NDS_INVALID_PARAM_ERROR || nds_parallel_run(0, parallel_mark_task, NULL) != NDS_OK)
+		result = 1;
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if every task runs exactly once, also after the worker count changes
+ */
+int test_2_nds_parallel_run()
+{
+	unsigned int marks[1000];
+	int result = 0, round, i;
+
+	for (round = 0; round < 3; round++)
+	{
+		nds_set_worker_count(round == 0 ? 4 : (size_t)round);
+		memset(marks, 0, sizeof(marks));
+
+		if (nds_parallel_run(1000, parallel_mark_task, marks) != NDS_OK)
+			result = 1;
+
+		for (i = 0; i < 1000; i++)
+			if (marks[i] != 1)
+				result = 1;
+	}
+
+	nds_set_worker_count(0);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if tasks that start parallel runs of their own finish
+ */
+int test_3_nds_parallel_run()
+{
+	unsigned int marks[8 * 100];
+	int result = 0, i;
+
+	nds_set_worker_count(4);
+	memset(marks, 0, sizeof(marks));
+
+	if (nds_parallel_run(8, parallel_nested_task, marks) != NDS_OK)
+		result = 1;
+
+	for (i = 0; i < 8 * 100; i++)
+		if (marks[i] != 1)
+			result = 1;
+
+	nds_set_worker_count(0);
+
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndsschedulertests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_scheduler_new();
+
+		case 2:
+			return test_2_nds_scheduler_new();
+
+		case 3:
+			return test_1_nds_scheduler_destroy();
+
+		case 4:
+			return test_1_nds_scheduler_default();
+
+		case 5:
+			return test_1_nds_scheduler_thread_count();
+
+		case 6:
+			return test_1_nds_task_spawn();
+
+		case 7:
+			return test_2_nds_task_spawn();
+
+		case 8:
+			return test_1_nds_task_wait();
+
+		case 9:
+			return test_2_nds_task_wait();
+
+		case 10:
+			return test_3_nds_task_wait();
+
+		case 11:
+			return test_1_nds_parallel_for();
+
+		case 12:
+			return test_2_nds_parallel_for();
+
+		case 13:
+			return test_1_nds_set_worker_count();
+
+		case 14:
+			return test_2_nds_set_worker_count();
+
+		case 15:
+			return test_1_nds_parallel_run();
+
+		case 16:
+			return test_2_nds_parallel_run();
+
+		case 17:
+			return test_3_nds_parallel_run();
+
+		default:
+			printf("No tests were found with the given ID!\n");
+			return 1;
+	}
+}
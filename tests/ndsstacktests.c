@@ -0,0 +1,817 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file defines various unit tests for the functionality of the
+ * NdsStack data structure from the NDS library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndstesthelpers.h"
+
+#include <nds/ndsstack.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* creates a stack of ints whose first chunk has the given capacity and whose memory is counted in usage */
+static NdsStack* stack_new(size_t capacity, NdsAllocator *allocator, struct NdsTestUsage *usage)
+{
+	*allocator = counting_allocator(usage);
+
+	return nds_stack_new_with_allocator(sizeof(int), capacity, allocator);
+}
+
+
+/* pushes first, first + 1, ..., first + count - 1 one by one */
+static int stack_fill(NdsStack *stack, int first, int count)
+{
+	int i, element;
+
+	for (i = 0; i < count; i++)
+	{
+		element = first + i;
+		if (nds_stack_push(stack, &element) != NDS_OK)
+			return 1;
+	}
+
+	return 0;
+}
+
+
+/* pops count elements and checks that they are first + count - 1, ..., first + 1, first */
+static int stack_check(NdsStack *stack, int first, int count)
+{
+	int i, element;
+
+	for (i = count - 1; i >= 0; i--)
+		if (nds_stack_pop(stack, &element) != NDS_OK || element != first + i)
+			return 1;
+
+	return 0;
+}
+
+
+/**
+ * Unit tests for the nds_stack_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_stack_new()
+ */
+int test_1_nds_stack_new()
+{
+	NdsStack *stack = nds_stack_new(0);
+
+	/* new() should refuse elements without size */
+	return stack != NULL;
+}
+
+
+/**
+ * Test 2 - verify if a new stack is empty and its first chunk has room for 16 elements
+ */
+int test_2_nds_stack_new()
+{
+	NdsStack *stack = nds_stack_new(sizeof(int));
+	int element = 0, result = 0;
+
+	if (!stack || nds_stack_size(stack) != 0 || nds_stack_capacity(stack) != 16 || nds_stack_top(stack, &element) != NDS_INVALID_PARAM_ERROR ||
+		nds_stack_pop(stack, &element) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_stack_new_with_allocator() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_stack_new_with_allocator()
+ */
+int test_1_nds_stack_new_with_allocator()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	int result = 0;
+
+	allocator = counting_allocator(&usage);
+	allocator.realloc = NULL;
+
+	if (nds_stack_new_with_allocator(sizeof(int), 16, NULL) != NULL || nds_stack_new_with_allocator(sizeof(int), 16, &allocator) != NULL ||
+		usage.allocations != 0)
+		result = 1;
+
+	/* a first chunk that does not fit in memory releases the block that was already allocated */
+	allocator.realloc = counting_realloc;
+	if (nds_stack_new_with_allocator((size_t)-1, 16, &allocator) != NULL || usage.bytes != 0)
+		result = 1;
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the first chunk has the given capacity and all the memory comes from the allocator
+ */
+int test_2_nds_stack_new_with_allocator()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsStack *stack;
+	int result = 0;
+
+	stack = stack_new(100, &allocator, &usage);
+	if (!stack || nds_stack_capacity(stack) != 100 || usage.allocations != 2)
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	if (usage.bytes != 0)
+		result = 1;
+
+	stack = stack_new(0, &allocator, &usage);
+	if (!stack || nds_stack_capacity(stack) != 16)
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_stack_destroy() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_stack_destroy()
+ */
+int test_1_nds_stack_destroy()
+{
+	/* destroy() should ignore invalid stacks */
+	nds_stack_destroy(NULL);
+
+	return nds_stack_size(NULL) != -1 || nds_stack_capacity(NULL) != -1;
+}
+
+
+
+/**
+ * Unit tests for the nds_stack_push() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_stack_push()
+ */
+int test_1_nds_stack_push()
+{
+	NdsStack *stack = nds_stack_new(sizeof(int));
+	int element = 1, result = 0;
+
+	if (!stack)
+		return 1;
+
+	if (nds_stack_push(NULL, &element) != NDS_INVALID_PARAM_ERROR || nds_stack_push(stack, NULL) != NDS_INVALID_PARAM_ERROR || nds_stack_size(stack) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if each new chunk doubles the capacity and the elements are never reallocated
+ */
+int test_2_nds_stack_push()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsStack *stack;
+	int result = 0;
+
+	stack = stack_new(16, &allocator, &usage);
+	if (!stack)
+		return 1;
+
+	/* the chunks hold 16, 32, 64, 128, 256 and 512 elements */
+	if (stack_fill(stack, 0, 1000) || nds_stack_size(stack) != 1000 || nds_stack_capacity(stack) != 1008 || usage.allocations != 7 ||
+		usage.reallocations != 0)
+		result = 1;
+
+	if (stack_check(stack, 0, 1000) || nds_stack_size(stack) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	if (usage.bytes != 0)
+		result = 1;
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if the chunks stop growing at NDS_STACK_MAX_CHUNK_SIZE bytes
+ */
+int test_3_nds_stack_push()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsStack *stack;
+	size_t sizeof_element = 1024 * 1024;
+	char *element;
+	int i, result = 0;
+
+	allocator = counting_allocator(&usage);
+
+	element = (char*)malloc(sizeof_element);
+	stack = nds_stack_new_with_allocator(sizeof_element, 4, &allocator);
+	if (!element || !stack)
+	{
+		free(element);
+		nds_stack_destroy(stack);
+		return 1;
+	}
+
+	/* the chunks hold 4, 8, 16 and 16 elements of 1 MB */
+	for (i = 0; i < 30; i++)
+	{
+		memset(element, i, sizeof_element);
+		if (nds_stack_push(stack, element) != NDS_OK)
+			result = 1;
+	}
+
+	if (nds_stack_capacity(stack) != 44 || usage.allocations != 5 || usage.largest > NDS_STACK_MAX_CHUNK_SIZE + 64)
+		result = 1;
+
+	for (i = 29; i >= 0; i--)
+		if (nds_stack_pop(stack, element) != NDS_OK || element[0] != i || element[sizeof_element - 1] != i)
+			result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+	free(element);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_stack_push_n() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_stack_push_n()
+ */
+int test_1_nds_stack_push_n()
+{
+	NdsStack *stack = nds_stack_new(sizeof(int));
+	int elements[4] = { 0, 1, 2, 3 }, result = 0;
+
+	if (!stack)
+		return 1;
+
+	if (nds_stack_push_n(NULL, elements, 4) != NDS_INVALID_PARAM_ERROR || nds_stack_push_n(stack, NULL, 4) != NDS_INVALID_PARAM_ERROR ||
+		nds_stack_push_n(stack, NULL, 0) != NDS_OK || nds_stack_size(stack) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if push_n() fills the chunk on top before it links new ones
+ */
+int test_2_nds_stack_push_n()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsStack *stack;
+	int elements[500], i, result = 0;
+
+	stack = stack_new(4, &allocator, &usage);
+	if (!stack)
+		return 1;
+
+	for (i = 0; i < 500; i++)
+		elements[i] = i;
+
+	/* the chunks hold 4, 8, 16, 32, 64, 128 and 256 elements */
+	if (nds_stack_push_n(stack, elements, 3) != NDS_OK || nds_stack_push_n(stack, elements + 3, 497) != NDS_OK || nds_stack_size(stack) != 500 ||
+		nds_stack_capacity(stack) != 508 || usage.allocations != 8)
+		result = 1;
+
+	if (stack_check(stack, 0, 500))
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if push_n() adds none of the elements when a chunk cannot be allocated
+ */
+int test_3_nds_stack_push_n()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsStack *stack;
+	int elements[100], i, result = 0;
+
+	stack = stack_new(16, &allocator, &usage);
+	if (!stack)
+		return 1;
+
+	for (i = 0; i < 100; i++)
+		elements[i] = 10 + i;
+
+	/* the 100 elements need the chunks of 32 and 64 elements, but only the first one can be allocated */
+	stack_fill(stack, 0, 10);
+	usage.limit = usage.allocations + 1;
+	if (nds_stack_push_n(stack, elements, 100) != NDS_MEM_ALLOC_ERROR || nds_stack_size(stack) != 10 || nds_stack_capacity(stack) != 48)
+		result = 1;
+
+	usage.limit = -1;
+	if (nds_stack_push_n(stack, elements, 100) != NDS_OK || nds_stack_size(stack) != 110 || stack_check(stack, 0, 110))
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	if (usage.bytes != 0)
+		result = 1;
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_stack_pop() function.
+ */
+
+/**
+ * Test 1 - verify if pop() refuses an empty stack and accepts a NULL element
+ */
+int test_1_nds_stack_pop()
+{
+	NdsStack *stack = nds_stack_new(sizeof(int));
+	int element = 7, result = 0;
+
+	if (!stack)
+		return 1;
+
+	if (nds_stack_pop(NULL, &element) != NDS_INVALID_PARAM_ERROR || nds_stack_pop(stack, &element) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	nds_stack_push(stack, &element);
+	if (nds_stack_pop(stack, NULL) != NDS_OK || nds_stack_size(stack) != 0 || nds_stack_pop(stack, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if crossing the end of a chunk back and forth reuses the spare chunk
+ */
+int test_2_nds_stack_pop()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsStack *stack;
+	int i, element = 100, result = 0;
+
+	stack = stack_new(16, &allocator, &usage);
+	if (!stack)
+		return 1;
+
+	stack_fill(stack, 0, 16);
+
+	/* the second chunk is linked at the first crossing and only reused after that */
+	for (i = 0; i < 1000; i++)
+	{
+		nds_stack_push(stack, &element);
+		nds_stack_pop(stack, NULL);
+		nds_stack_pop(stack, NULL);
+		nds_stack_push(stack, &i);
+		nds_stack_push(stack, &element);
+		nds_stack_pop(stack, NULL);
+	}
+
+	if (usage.allocations != 3 || nds_stack_size(stack) != 16 || nds_stack_capacity(stack) != 48)
+		result = 1;
+
+	nds_stack_pop(stack, &element);
+	if (element != 999 || stack_check(stack, 0, 15))
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if the emptied chunks are freed except the spare one
+ */
+int test_3_nds_stack_pop()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsStack *stack;
+	long long bytes;
+	int result = 0;
+
+	stack = stack_new(16, &allocator, &usage);
+	if (!stack)
+		return 1;
+
+	/* with 17 elements the stack uses its first chunk and the chunk of 32 elements, which stays as the spare one */
+	stack_fill(stack, 0, 17);
+	bytes = usage.bytes;
+
+	stack_fill(stack, 17, 983);
+	if (stack_check(stack, 0, 1000) || nds_stack_capacity(stack) != 48 || usage.bytes != bytes)
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_stack_pop_n() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_stack_pop_n()
+ */
+int test_1_nds_stack_pop_n()
+{
+	NdsStack *stack = nds_stack_new(sizeof(int));
+	int elements[4], result = 0;
+
+	if (!stack)
+		return 1;
+
+	if (nds_stack_pop_n(NULL, elements, 4) != -1 || nds_stack_pop_n(stack, elements, 4) != 0 || nds_stack_pop_n(stack, NULL, 0) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if pop_n() copies the elements in the order they were pushed, across chunks
+ */
+int test_2_nds_stack_pop_n()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsStack *stack;
+	int elements[100], i, result = 0;
+
+	stack = stack_new(4, &allocator, &usage);
+	if (!stack)
+		return 1;
+
+	stack_fill(stack, 0, 100);
+
+	if (nds_stack_pop_n(stack, elements, 30) != 30 || nds_stack_size(stack) != 70)
+		result = 1;
+
+	for (i = 0; i < 30; i++)
+		if (elements[i] != 70 + i)
+			result = 1;
+
+	if (nds_stack_pop_n(stack, NULL, 20) != 20 || nds_stack_pop_n(stack, elements, 1000) != 50 || nds_stack_size(stack) != 0)
+		result = 1;
+
+	for (i = 0; i < 50; i++)
+		if (elements[i] != i)
+			result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_stack_top() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_stack_top()
+ */
+int test_1_nds_stack_top()
+{
+	NdsStack *stack = nds_stack_new(sizeof(int));
+	int element = 5, result = 0;
+
+	if (!stack)
+		return 1;
+
+	nds_stack_push(stack, &element);
+	if (nds_stack_top(NULL, &element) != NDS_INVALID_PARAM_ERROR || nds_stack_top(stack, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	element = 0;
+	if (nds_stack_top(stack, &element) != NDS_OK || element != 5 || nds_stack_size(stack) != 1)
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if top() finds the top element in the chunk below an emptied chunk
+ */
+int test_2_nds_stack_top()
+{
+	NdsStack *stack = nds_stack_new(sizeof(int));
+	int element = 0, result = 0;
+
+	if (!stack)
+		return 1;
+
+	/* the seventeenth element is the only one in the second chunk */
+	stack_fill(stack, 0, 17);
+	nds_stack_pop(stack, NULL);
+	if (nds_stack_top(stack, &element) != NDS_OK || element != 15)
+		result = 1;
+
+	element = 99;
+	nds_stack_push(stack, &element);
+	element = 0;
+	if (nds_stack_top(stack, &element) != NDS_OK || element != 99 || nds_stack_size(stack) != 17)
+		result = 1;
+
+	nds_stack_pop_n(stack, NULL, 2);
+	if (nds_stack_top(stack, &element) != NDS_OK || element != 14)
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_stack_clear() function.
+ */
+
+/**
+ * Test 1 - verify if clear() keeps only the first chunk and the stack is usable afterwards
+ */
+int test_1_nds_stack_clear()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsStack *stack;
+	long long bytes;
+	int result = 0;
+
+	stack = stack_new(16, &allocator, &usage);
+	if (!stack)
+		return 1;
+
+	bytes = usage.bytes;
+	stack_fill(stack, 0, 1000);
+	nds_stack_pop_n(stack, NULL, 500);
+
+	if (nds_stack_clear(NULL) != NDS_INVALID_PARAM_ERROR || nds_stack_clear(stack) != NDS_OK || nds_stack_size(stack) != 0 ||
+		nds_stack_capacity(stack) != 16 || usage.bytes != bytes)
+		result = 1;
+
+	if (stack_fill(stack, 0, 20) || stack_check(stack, 0, 20))
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify random pushes and pops of single elements and batches against an array
+ */
+int test_2_nds_stack_clear()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsStack *stack;
+	static int model[20000], batch[64];
+	size_t size = 0, count, j;
+	uint32_t state = 7;
+	int i, element, result = 0;
+
+	/* chunks of one element at first, so the operations cross chunks all the time */
+	stack = stack_new(1, &allocator, &usage);
+	if (!stack)
+		return 1;
+
+	for (i = 0; i < 100000 && !result; i++)
+	{
+		count = 1 + test_random(&state) % 64;
+
+		switch (test_random(&state) % 4)
+		{
+			case 0:
+				if (size == 20000)
+					break;
+				model[size] = i;
+				if (nds_stack_push(stack, &model[size]) != NDS_OK)
+					result = 1;
+				size++;
+				break;
+
+			case 1:
+				if (size + count > 20000)
+					break;
+				for (j = 0; j < count; j++)
+					batch[j] = model[size + j] = i + (int)j;
+				if (nds_stack_push_n(stack, batch, count) != NDS_OK)
+					result = 1;
+				size += count;
+				break;
+
+			case 2:
+				if (size == 0)
+					break;
+				size--;
+				if (nds_stack_pop(stack, &element) != NDS_OK || element != model[size])
+					result = 1;
+				break;
+
+			default:
+				count = count > size ? size : count;
+				size -= count;
+				if (nds_stack_pop_n(stack, batch, count) != (ssize_t)count || memcmp(batch, model + size, count * sizeof(int)) != 0)
+					result = 1;
+				break;
+		}
+
+		if (nds_stack_size(stack) != (ssize_t)size || (size > 0 && (nds_stack_top(stack, &element) != NDS_OK || element != model[size - 1])))
+			result = 1;
+
+		/* the stack is cleared from time to time, so it starts over from a single chunk */
+		if (i % 30000 == 29999)
+		{
+			nds_stack_clear(stack);
+			size = 0;
+		}
+	}
+
+	if (usage.reallocations != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_stack_destroy(stack);
+
+	if (usage.bytes != 0)
+		result = 1;
+
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndsstacktests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_stack_new();
+
+		case 2:
+			return test_2_nds_stack_new();
+
+		case 3:
+			return test_1_nds_stack_new_with_allocator();
+
+		case 4:
+			return test_2_nds_stack_new_with_allocator();
+
+		case 5:
+			return test_1_nds_stack_destroy();
+
+		case 6:
+			return test_1_nds_stack_push();
+
+		case 7:
+			return test_2_nds_stack_push();
+
+		case 8:
+			return test_3_nds_stack_push();
+
+		case 9:
+			return test_1_nds_stack_push_n();
+
+		case 10:
+			return test_2_nds_stack_push_n();
+
+		case 11:
+			return test_3_nds_stack_push_n();
+
+		case 12:
+			return test_1_nds_stack_pop();
+
+		case 13:
+			return test_2_nds_stack_pop();
+
+		case 14:
+			return test_3_nds_stack_pop();
+
+		case 15:
+			return test_1_nds_stack_pop_n();
+
+		case 16:
+			return test_2_nds_stack_pop_n();
+
+		case 17:
+			return test_1_nds_stack_top();
+
+		case 18:
+			return test_2_nds_stack_top();
+
+		case 19:
+			return test_1_nds_stack_clear();
+
+		case 20:
+			return test_2_nds_stack_clear();
+
+		default:
+			printf("No tests were found with the given ID!\n");
+			return 1;
+	}
+}
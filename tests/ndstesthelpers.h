@@ -0,0 +1,163 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file contains the helpers shared by the unit tests of the NDS library:
+ * an allocator that counts the calls and the bytes it serves and can be told
+ * to fail, the pseudo-random sequence used by the randomized tests, the
+ * comparison of the ordered containers and the hash functions used by the
+ * tests of the hashed containers.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#ifndef __NDS_TEST_HELPERS_H__
+#define __NDS_TEST_HELPERS_H__
+
+#include <nds/ndsutils.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* the calls and the bytes seen by the counting allocator, which fails once limit allocations were served (never if limit is negative) */
+struct NdsTestUsage
+{
+	int allocations;
+	int reallocations;
+	int frees;
+	int limit;
+	long long bytes;
+	size_t largest;
+};
+
+
+/* allocator that counts the allocations it serves in the NdsTestUsage given as context */
+static inline void* counting_alloc(void *context, size_t size)
+{
+	struct NdsTestUsage *usage = (struct NdsTestUsage*)context;
+
+	if (usage->limit >= 0 && usage->allocations + usage->reallocations >= usage->limit)
+		return NULL;
+
+	usage->allocations++;
+	usage->bytes += (long long)size;
+	if (size > usage->largest)
+		usage->largest = size;
+
+	return malloc(size);
+}
+
+
+static inline void* counting_realloc(void *context, void *pointer, size_t old_size, size_t new_size)
+{
+	struct NdsTestUsage *usage = (struct NdsTestUsage*)context;
+	void *resized;
+
+	if (usage->limit >= 0 && usage->allocations + usage->reallocations >= usage->limit)
+		return NULL;
+
+	resized = realloc(pointer, new_size);
+	if (!resized)
+		return NULL;
+
+	usage->reallocations++;
+	usage->bytes += (long long)new_size - (long long)old_size;
+	if (new_size > usage->largest)
+		usage->largest = new_size;
+
+	return resized;
+}
+
+
+static inline void counting_free(void *context, void *pointer, size_t size)
+{
+	struct NdsTestUsage *usage = (struct NdsTestUsage*)context;
+
+	usage->frees++;
+	usage->bytes -= (long long)size;
+
+	free(pointer);
+}
+
+
+/* resets usage and returns the counting allocator that records its calls there */
+static inline NdsAllocator counting_allocator(struct NdsTestUsage *usage)
+{
+	NdsAllocator allocator = { counting_alloc, counting_realloc, counting_free, NULL };
+
+	memset(usage, 0, sizeof(*usage));
+	usage->limit = -1;
+	allocator.context = usage;
+
+	return allocator;
+}
+
+
+/* pseudo-random sequence used by the randomized tests */
+static inline uint32_t test_random(uint32_t *state)
+{
+	*state = *state * 1103515245u + 12345u;
+
+	return *state >> 8;
+}
+
+
+/* orders int elements, for the ordered containers */
+static inline int int_compare(const void *first, const void *second)
+{
+	int a = *(const int*)first, b = *(const int*)second;
+
+	return (a > b) - (a < b);
+}
+
+
+/* a key whose bytes after the terminator are not significant, so it needs its own hash and equality */
+struct NdsTestName
+{
+	char name[24];
+};
+
+
+static inline uint64_t name_hash(const void *key)
+{
+	const char *name = ((const struct NdsTestName*)key)->name;
+
+	return nds_hash_bytes(name, strlen(name));
+}
+
+
+static inline int name_equal(const void *first, const void *second)
+{
+	return strcmp(((const struct NdsTestName*)first)->name, ((const struct NdsTestName*)second)->name) == 0;
+}
+
+
+/* a hash of uint32_t keys with only 4 distinct values and the same tag, whose home slots in a table of 128 slots are 120, 24, 56 and 88 */
+static inline uint64_t colliding_hash(const void *key)
+{
+	return (uint64_t)(*(const uint32_t*)key % 4 * 32 + 120) << 7;
+}
+
+#endif /* __NDS_TEST_HELPERS_H__ */
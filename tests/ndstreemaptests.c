@@ -0,0 +1,958 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file defines various unit tests for the functionality of the
+ * NdsTreeMap data structure from the NDS library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include "ndstesthelpers.h"
+
+#include <nds/ndstreemap.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* a key of 64 bytes, so the nodes hold only 4 keys and every insertion and removal rebalances the tree */
+struct WideKey
+{
+	int32_t id;
+	char padding[60];
+};
+
+
+static int wide_compare(const void *first, const void *second)
+{
+	int32_t a = ((const struct WideKey*)first)->id, b = ((const struct WideKey*)second)->id;
+
+	return (a > b) - (a < b);
+}
+
+
+/* a record of a bulk load */
+struct Record
+{
+	int64_t key;
+	double value;
+};
+
+
+/* adds the visited key to the int64_t given as context and checks that the value is its opposite */
+static void sum_pair(const void *key, void *value, void *context)
+{
+	int64_t *sum = (int64_t*)context;
+
+	if (*(int*)value != -*(const int*)key)
+		sum[1] = 1;
+
+	sum[0] += *(const int*)key;
+}
+
+
+/* checks with the iterators that the map of int keys and values holds in order the keys below range whose flag is set */
+static int tree_check(NdsTreeMap *map, const unsigned char *flags, int range)
+{
+	NdsTreeMapIterator iterator;
+	ssize_t size = 0;
+	int key, found;
+
+	found = nds_tree_map_first(map, &iterator);
+
+	for (key = 0; key < range; key++)
+	{
+		if (!flags[key])
+			continue;
+
+		if (found != 1 || *(const int*)iterator.key != key || *(int*)iterator.value != -key)
+			return 1;
+
+		found = nds_tree_map_iterator_next(&iterator);
+		size++;
+	}
+
+	return found != 0 || nds_tree_map_size(map) != size;
+}
+
+
+/* inserts and removes random keys below range with the value -key and checks the map against an array of flags */
+static int tree_check_random(NdsTreeMap *map, int range, int operations, uint32_t seed)
+{
+	unsigned char *flags = (unsigned char*)calloc((size_t)range, 1);
+	int i, key, value, result = 0;
+
+	for (i = 0; i < operations && !result; i++)
+	{
+		key = (int)(test_random(&seed) % (uint32_t)range);
+
+		if (test_random(&seed) % 2)
+		{
+			if (nds_tree_map_remove(map, &key, &value) != (flags[key] ? NDS_OK : NDS_INVALID_PARAM_ERROR) || (flags[key] && value != -key))
+				result = 1;
+			flags[key] = 0;
+		}
+		else
+		{
+			value = -key;
+			if (nds_tree_map_insert(map, &key, &value) != NDS_OK)
+				result = 1;
+			flags[key] = 1;
+		}
+	}
+
+	if (!result)
+		result = tree_check(map, flags, range);
+
+	/* cleanup */
+	free(flags);
+
+	return result;
+}
+
+
+/**
+ * Unit tests for the nds_tree_map_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_tree_map_new()
+ */
+int test_1_nds_tree_map_new()
+{
+	/* new() should refuse keys without size and maps without comparison function */
+	return nds_tree_map_new(0, sizeof(int), int_compare) != NULL || nds_tree_map_new(sizeof(int), sizeof(int), NULL) != NULL;
+}
+
+
+/**
+ * Test 2 - verify if a new map is empty
+ */
+int test_2_nds_tree_map_new()
+{
+	NdsTreeMap *map = nds_tree_map_new(sizeof(int), sizeof(int), int_compare);
+	NdsTreeMapIterator iterator;
+	int key = 1, result = 0;
+
+	if (!map || nds_tree_map_size(map) != 0 || nds_tree_map_contains(map, &key) != 0 || nds_tree_map_first(map, &iterator) != 0 || iterator.key != NULL)
+		result = 1;
+
+	/* cleanup */
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_tree_map_new_with_allocator() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_tree_map_new_with_allocator()
+ */
+int test_1_nds_tree_map_new_with_allocator()
+{
+	NdsAllocator allocator = *nds_allocator_default();
+	int result = 0;
+
+	if (nds_tree_map_new_with_allocator(sizeof(int), sizeof(int), int_compare, NULL) != NULL ||
+		nds_tree_map_new_with_allocator((size_t)-1, sizeof(int), int_compare, &allocator) != NULL)
+		result = 1;
+
+	allocator.free = NULL;
+	if (nds_tree_map_new_with_allocator(sizeof(int), sizeof(int), int_compare, &allocator) != NULL)
+		result = 1;
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_tree_map_new_with_key_type() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_tree_map_new_with_key_type()
+ */
+int test_1_nds_tree_map_new_with_key_type()
+{
+	/* new_with_key_type() should refuse unknown key types */
+	return nds_tree_map_new_with_key_type((NdsKeyType)100, sizeof(int), nds_allocator_default()) != NULL ||
+		nds_tree_map_new_with_key_type(NDS_KEY_INT32, sizeof(int), NULL) != NULL;
+}
+
+
+/**
+ * Test 2 - verify if signed and floating point keys are ordered like numbers
+ */
+int test_2_nds_tree_map_new_with_key_type()
+{
+	NdsTreeMap *integers = nds_tree_map_new_with_key_type(NDS_KEY_INT16, 0, nds_allocator_default());
+	NdsTreeMap *reals = nds_tree_map_new_with_key_type(NDS_KEY_DOUBLE, 0, nds_allocator_default());
+	NdsTreeMapIterator iterator;
+	int16_t integer, previous_integer = INT16_MIN;
+	double real, previous_real = -1e300;
+	int i, found, result = 0;
+
+	for (i = 0; i < 1000; i++)
+	{
+		integer = (int16_t)((i * 7919) % 2001 - 1000);
+		real = integer * 0.5;
+		nds_tree_map_insert(integers, &integer, NULL);
+		nds_tree_map_insert(reals, &real, NULL);
+	}
+
+	for (found = nds_tree_map_first(integers, &iterator); found == 1; found = nds_tree_map_iterator_next(&iterator))
+	{
+		memcpy(&integer, iterator.key, sizeof(integer));
+		if (integer <= previous_integer)
+			result = 1;
+		previous_integer = integer;
+	}
+
+	for (found = nds_tree_map_first(reals, &iterator); found == 1; found = nds_tree_map_iterator_next(&iterator))
+	{
+		memcpy(&real, iterator.key, sizeof(real));
+		if (real <= previous_real)
+			result = 1;
+		previous_real = real;
+	}
+
+	if (nds_tree_map_size(integers) != 1000 || nds_tree_map_size(reals) != 1000)
+		result = 1;
+
+	/* cleanup */
+	nds_tree_map_destroy(reals);
+	nds_tree_map_destroy(integers);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_tree_map_destroy() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_tree_map_destroy()
+ */
+int test_1_nds_tree_map_destroy()
+{
+	/* destroy() should ignore NULL */
+	nds_tree_map_destroy(NULL);
+
+	return 0;
+}
+
+
+
+/**
+ * Unit tests for the nds_tree_map_size() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_tree_map_size()
+ */
+int test_1_nds_tree_map_size()
+{
+	/* size() should return -1 for an invalid map */
+	return nds_tree_map_size(NULL) != -1;
+}
+
+
+
+/**
+ * Unit tests for the nds_tree_map_bulk_load() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_tree_map_bulk_load()
+ */
+int test_1_nds_tree_map_bulk_load()
+{
+	NdsTreeMap *map = nds_tree_map_new_with_key_type(NDS_KEY_INT64, sizeof(double), nds_allocator_default());
+	NdsVector *vector = nds_vector_new(sizeof(struct Record));
+	struct Record record = { 5, 0.5 };
+	int64_t key = 7;
+	int result = 0;
+
+	nds_tree_map_insert(map, &key, &record.value);
+	nds_vector_push_back(vector, &record);
+	nds_vector_push_back(vector, &record);
+
+	/* the keys must be strictly increasing and the values must fit in the records */
+	if (nds_tree_map_bulk_load(NULL, vector, 8) != NDS_INVALID_PARAM_ERROR || nds_tree_map_bulk_load(map, NULL, 8) != NDS_INVALID_PARAM_ERROR ||
+		nds_tree_map_bulk_load(map, vector, 8) != NDS_INVALID_PARAM_ERROR || nds_tree_map_bulk_load(map, vector, 12) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* the map is left unchanged */
+	if (nds_tree_map_size(map) != 1 || nds_tree_map_contains(map, &key) != 1)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if a loaded map holds the records in order and stays usable
+ */
+int test_2_nds_tree_map_bulk_load()
+{
+	NdsTreeMap *map = nds_tree_map_new_with_key_type(NDS_KEY_INT64, sizeof(double), nds_allocator_default());
+	NdsVector *vector = nds_vector_new(sizeof(struct Record));
+	struct Record record;
+	NdsTreeMapIterator iterator;
+	int64_t key, expected = 0;
+	double value;
+	int found, result = 0;
+
+	/* the keys are the even numbers below 200000 */
+	for (record.key = 0; record.key < 200000; record.key += 2)
+	{
+		record.value = record.key * 0.5;
+		nds_vector_push_back(vector, &record);
+	}
+
+	if (nds_tree_map_bulk_load(map, vector, offsetof(struct Record, value)) != NDS_OK || nds_tree_map_size(map) != 100000)
+		result = 1;
+
+	for (found = nds_tree_map_first(map, &iterator); found == 1; found = nds_tree_map_iterator_next(&iterator), expected += 2)
+		if (*(const int64_t*)iterator.key != expected || *(double*)iterator.value != expected * 0.5)
+			result = 1;
+
+	if (expected != 200000)
+		result = 1;
+
+	/* the odd keys go between the loaded ones and the multiples of 4 are removed */
+	for (key = 1; key < 200000; key += 2)
+	{
+		value = -1.0;
+		if (nds_tree_map_insert(map, &key, &value) != NDS_OK)
+			result = 1;
+	}
+
+	for (key = 0; key < 200000; key += 4)
+		if (nds_tree_map_remove(map, &key, NULL) != NDS_OK)
+			result = 1;
+
+	for (key = 0; key < 200000; key++)
+		if (nds_tree_map_contains(map, &key) != (key % 4 != 0))
+			result = 1;
+
+	if (nds_tree_map_get(map, &(int64_t){ 6 }, &value) != NDS_OK || value != 3.0 || nds_tree_map_size(map) != 150000)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if a load obtains its nodes in one allocation and a reload reuses them
+ */
+int test_3_nds_tree_map_bulk_load()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsVector *vector = nds_vector_new(sizeof(struct Record));
+	NdsTreeMap *map;
+	struct Record record;
+	int result = 0;
+
+	allocator = counting_allocator(&usage);
+	map = nds_tree_map_new_with_key_type(NDS_KEY_INT64, sizeof(double), &allocator);
+
+	for (record.key = 0; record.key < 50000; record.key++)
+	{
+		record.value = 0.0;
+		nds_vector_push_back(vector, &record);
+	}
+
+	/* the block of the map and its first chunk, then the chunk of the load */
+	if (usage.allocations != 2 || nds_tree_map_bulk_load(map, vector, 8) != NDS_OK || usage.allocations != 3)
+		result = 1;
+
+	if (nds_tree_map_bulk_load(map, vector, 8) != NDS_OK || usage.allocations != 3 || nds_tree_map_size(map) != 50000)
+		result = 1;
+
+	/* an empty vector leaves an empty map */
+	nds_vector_resize(vector, 0);
+	if (nds_tree_map_bulk_load(map, vector, 8) != NDS_OK || nds_tree_map_size(map) != 0 || nds_tree_map_contains(map, &record.key) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_tree_map_insert() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_tree_map_insert()
+ */
+int test_1_nds_tree_map_insert()
+{
+	NdsTreeMap *map = nds_tree_map_new(sizeof(int), sizeof(int), int_compare);
+	int key = 1, result = 0;
+
+	if (nds_tree_map_insert(NULL, &key, &key) != NDS_INVALID_PARAM_ERROR || nds_tree_map_insert(map, NULL, &key) != NDS_INVALID_PARAM_ERROR ||
+		nds_tree_map_insert(map, &key, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if inserting an existing key overwrites its value
+ */
+int test_2_nds_tree_map_insert()
+{
+	NdsTreeMap *map = nds_tree_map_new(sizeof(int), sizeof(int), int_compare);
+	int key, value, result = 0;
+
+	for (key = 0; key < 1000; key++)
+	{
+		value = key;
+		nds_tree_map_insert(map, &key, &value);
+	}
+
+	for (key = 0; key < 1000; key++)
+	{
+		value = -key;
+		if (nds_tree_map_insert(map, &key, &value) != NDS_OK)
+			result = 1;
+	}
+
+	for (key = 0; key < 1000; key++)
+		if (*(int*)nds_tree_map_find(map, &key) != -key)
+			result = 1;
+
+	if (nds_tree_map_size(map) != 1000)
+		result = 1;
+
+	/* cleanup */
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if keys inserted in increasing, decreasing and random order are iterated in order
+ */
+int test_3_nds_tree_map_insert()
+{
+	NdsTreeMap *map = nds_tree_map_new(sizeof(int), sizeof(int), int_compare);
+	unsigned char flags[30000];
+	int key, value, result = 0;
+
+	memset(flags, 1, sizeof(flags));
+
+	for (key = 0; key < 10000; key++)
+	{
+		value = -key;
+		nds_tree_map_insert(map, &key, &value);
+	}
+
+	for (key = 19999; key >= 10000; key--)
+	{
+		value = -key;
+		nds_tree_map_insert(map, &key, &value);
+	}
+
+	if (tree_check(map, flags, 20000))
+		result = 1;
+
+	/* the random keys are the ones from 20000 on that are not multiples of 3 */
+	for (key = 20000; key < 30000; key++)
+		flags[key] = key % 3 != 0;
+
+	for (key = 0; key < 10000; key++)
+	{
+		value = 20000 + (key * 7 % 10000);
+		if (value % 3 != 0)
+			nds_tree_map_insert(map, &value, &(int){ -value });
+	}
+
+	if (tree_check(map, flags, 30000))
+		result = 1;
+
+	/* cleanup */
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_tree_map_find() function.
+ */
+
+/**
+ * Test 1 - verify find(), get() and contains() on present and missing keys
+ */
+int test_1_nds_tree_map_find()
+{
+	NdsTreeMap *map = nds_tree_map_new_with_key_type(NDS_KEY_UINT32, sizeof(int), nds_allocator_default());
+	uint32_t key;
+	int value, result = 0;
+
+	for (key = 0; key < 3000; key += 3)
+	{
+		value = (int)key + 1;
+		nds_tree_map_insert(map, &key, &value);
+	}
+
+	if (nds_tree_map_find(NULL, &key) != NULL || nds_tree_map_find(map, NULL) != NULL || nds_tree_map_get(map, &key, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_tree_map_contains(NULL, &key) != -1 || nds_tree_map_contains(map, NULL) != -1)
+		result = 1;
+
+	for (key = 0; key < 3100; key++)
+	{
+		if (nds_tree_map_contains(map, &key) != (key < 3000 && key % 3 == 0))
+			result = 1;
+
+		if (key < 3000 && key % 3 == 0 && (nds_tree_map_get(map, &key, &value) != NDS_OK || value != (int)key + 1))
+			result = 1;
+
+		if (key % 3 != 0 && nds_tree_map_get(map, &key, &value) != NDS_INVALID_PARAM_ERROR)
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_tree_map_remove() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_tree_map_remove()
+ */
+int test_1_nds_tree_map_remove()
+{
+	NdsTreeMap *map = nds_tree_map_new(sizeof(int), sizeof(int), int_compare);
+	int key = 1, result = 0;
+
+	if (nds_tree_map_remove(NULL, &key, NULL) != NDS_INVALID_PARAM_ERROR || nds_tree_map_remove(map, NULL, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_tree_map_remove(map, &key, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify random inserts and removes against an array of flags, with generic and numeric keys
+ */
+int test_2_nds_tree_map_remove()
+{
+	NdsTreeMap *generic = nds_tree_map_new(sizeof(int), sizeof(int), int_compare);
+	NdsTreeMap *numeric = nds_tree_map_new_with_key_type(NDS_KEY_INT32, sizeof(int), nds_allocator_default());
+	int result = 0;
+
+	if (tree_check_random(generic, 5000, 100000, 1) || tree_check_random(numeric, 100000, 300000, 2))
+		result = 1;
+
+	/* cleanup */
+	nds_tree_map_destroy(numeric);
+	nds_tree_map_destroy(generic);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify random inserts and removes in a tree of 4 keys per node
+ */
+int test_3_nds_tree_map_remove()
+{
+	NdsTreeMap *map = nds_tree_map_new(sizeof(struct WideKey), 0, wide_compare);
+	NdsTreeMapIterator iterator;
+	unsigned char flags[2000];
+	struct WideKey key;
+	uint32_t state = 9;
+	ssize_t size = 0;
+	int i, found, result = 0;
+
+	memset(flags, 0, sizeof(flags));
+	memset(&key, 0, sizeof(key));
+
+	for (i = 0; i < 50000; i++)
+	{
+		key.id = (int32_t)(test_random(&state) % 2000);
+
+		if (test_random(&state) % 2)
+		{
+			if (nds_tree_map_remove(map, &key, NULL) != (flags[key.id] ? NDS_OK : NDS_INVALID_PARAM_ERROR))
+				result = 1;
+			flags[key.id] = 0;
+		}
+		else
+		{
+			nds_tree_map_insert(map, &key, NULL);
+			flags[key.id] = 1;
+		}
+	}
+
+	found = nds_tree_map_first(map, &iterator);
+	for (i = 0; i < 2000; i++)
+	{
+		if (!flags[i])
+			continue;
+
+		if (found != 1 || ((const struct WideKey*)iterator.key)->id != i)
+			result = 1;
+
+		found = nds_tree_map_iterator_next(&iterator);
+		size++;
+	}
+
+	if (found != 0 || nds_tree_map_size(map) != size)
+		result = 1;
+
+	/* cleanup */
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 4 - verify if removing every key in increasing and then decreasing order empties the map
+ */
+int test_4_nds_tree_map_remove()
+{
+	NdsTreeMap *map = nds_tree_map_new(sizeof(struct WideKey), 0, wide_compare);
+	NdsTreeMapIterator iterator;
+	struct WideKey key;
+	int round, result = 0;
+
+	memset(&key, 0, sizeof(key));
+
+	for (round = 0; round < 2; round++)
+	{
+		for (key.id = 0; key.id < 5000; key.id++)
+			nds_tree_map_insert(map, &key, NULL);
+
+		if (round == 0)
+		{
+			for (key.id = 0; key.id < 5000; key.id++)
+				if (nds_tree_map_remove(map, &key, NULL) != NDS_OK)
+					result = 1;
+		}
+		else
+		{
+			for (key.id = 4999; key.id >= 0; key.id--)
+				if (nds_tree_map_remove(map, &key, NULL) != NDS_OK)
+					result = 1;
+		}
+
+		if (nds_tree_map_size(map) != 0 || nds_tree_map_first(map, &iterator) != 0)
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_tree_map_clear() function.
+ */
+
+/**
+ * Test 1 - verify if clear() empties the map, which can be filled again
+ */
+int test_1_nds_tree_map_clear()
+{
+	NdsTreeMap *map = nds_tree_map_new(sizeof(int), sizeof(int), int_compare);
+	unsigned char flags[10000];
+	int key, result = 0;
+
+	for (key = 0; key < 10000; key++)
+		nds_tree_map_insert(map, &key, &(int){ -key });
+
+	if (nds_tree_map_clear(NULL) != NDS_INVALID_PARAM_ERROR || nds_tree_map_clear(map) != NDS_OK || nds_tree_map_size(map) != 0)
+		result = 1;
+
+	memset(flags, 0, sizeof(flags));
+	for (key = 0; key < 10000; key += 5)
+	{
+		nds_tree_map_insert(map, &key, &(int){ -key });
+		flags[key] = 1;
+	}
+
+	if (tree_check(map, flags, 10000))
+		result = 1;
+
+	/* cleanup */
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_tree_map_lower_bound() function.
+ */
+
+/**
+ * Test 1 - verify lower_bound() and upper_bound() on present, missing and out of range keys
+ */
+int test_1_nds_tree_map_lower_bound()
+{
+	NdsTreeMap *map = nds_tree_map_new_with_key_type(NDS_KEY_INT32, sizeof(int), nds_allocator_default());
+	NdsTreeMapIterator iterator;
+	int32_t key;
+	int result = 0;
+
+	/* the keys are the multiples of 10 from 0 to 9990 */
+	for (key = 0; key < 10000; key += 10)
+		nds_tree_map_insert(map, &key, &(int){ -key });
+
+	if (nds_tree_map_lower_bound(NULL, &key, &iterator) != -1 || nds_tree_map_lower_bound(map, NULL, &iterator) != -1 ||
+		nds_tree_map_upper_bound(map, &key, NULL) != -1 || nds_tree_map_first(map, NULL) != -1 || nds_tree_map_iterator_next(NULL) != -1)
+		result = 1;
+
+	for (key = -5; key < 10000; key++)
+	{
+		if (nds_tree_map_lower_bound(map, &key, &iterator) != (key <= 9990) ||
+			(key <= 9990 && *(const int32_t*)iterator.key != (key < 0 ? 0 : (key + 9) / 10 * 10)))
+			result = 1;
+
+		if (nds_tree_map_upper_bound(map, &key, &iterator) != (key < 9990) ||
+			(key < 9990 && (*(const int32_t*)iterator.key != (key < 0 ? 0 : key / 10 * 10 + 10) || *(int*)iterator.value != -*(const int32_t*)iterator.key)))
+			result = 1;
+	}
+
+	/* an iterator at the end stays there */
+	key = 9990;
+	if (nds_tree_map_lower_bound(map, &key, &iterator) != 1 || nds_tree_map_iterator_next(&iterator) != 0 || nds_tree_map_iterator_next(&iterator) != -1)
+		result = 1;
+
+	/* cleanup */
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_tree_map_range() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_tree_map_range()
+ */
+int test_1_nds_tree_map_range()
+{
+	NdsTreeMap *map = nds_tree_map_new(sizeof(int), sizeof(int), int_compare);
+	int64_t sum[2] = { 0, 0 };
+	int result = 0;
+
+	if (nds_tree_map_range(NULL, NULL, NULL, sum_pair, sum) != -1 || nds_tree_map_range(map, NULL, NULL, NULL, sum) != -1 ||
+		nds_tree_map_range(map, NULL, NULL, sum_pair, sum) != 0 || sum[0] != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify the pairs visited for random ranges, open and closed
+ */
+int test_2_nds_tree_map_range()
+{
+	NdsTreeMap *map = nds_tree_map_new_with_key_type(NDS_KEY_INT32, sizeof(int), nds_allocator_default());
+	int64_t sum[2], expected;
+	int32_t key, low, high;
+	uint32_t state = 21;
+	ssize_t visited, count;
+	int i, result = 0;
+
+	/* the keys are the multiples of 3 from 0 to 29997 */
+	for (key = 0; key < 30000; key += 3)
+		nds_tree_map_insert(map, &key, &(int){ -key });
+
+	for (i = 0; i < 500; i++)
+	{
+		low = (int32_t)(test_random(&state) % 31000) - 500;
+		high = low + (int32_t)(test_random(&state) % 5000);
+
+		expected = 0;
+		count = 0;
+		for (key = 0; key < 30000; key += 3)
+			if (key >= low && key < high)
+			{
+				expected += key;
+				count++;
+			}
+
+		sum[0] = sum[1] = 0;
+		visited = nds_tree_map_range(map, &low, &high, sum_pair, sum);
+		if (visited != count || sum[0] != expected || sum[1] != 0)
+			result = 1;
+	}
+
+	/* the open ranges */
+	sum[0] = sum[1] = 0;
+	if (nds_tree_map_range(map, NULL, NULL, sum_pair, sum) != 10000 || sum[0] != (int64_t)29997 * 10000 / 2)
+		result = 1;
+
+	key = 15000;
+	sum[0] = sum[1] = 0;
+	if (nds_tree_map_range(map, NULL, &key, sum_pair, sum) != 5000 || nds_tree_map_range(map, &key, NULL, sum_pair, sum) != 5000 ||
+		sum[0] != (int64_t)29997 * 10000 / 2)
+		result = 1;
+
+	/* cleanup */
+	nds_tree_map_destroy(map);
+
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndstreemaptests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_tree_map_new();
+
+		case 2:
+			return test_2_nds_tree_map_new();
+
+		case 3:
+			return test_1_nds_tree_map_new_with_allocator();
+
+		case 4:
+			return test_1_nds_tree_map_new_with_key_type();
+
+		case 5:
+			return test_2_nds_tree_map_new_with_key_type();
+
+		case 6:
+			return test_1_nds_tree_map_destroy();
+
+		case 7:
+			return test_1_nds_tree_map_size();
+
+		case 8:
+			return test_1_nds_tree_map_bulk_load();
+
+		case 9:
+			return test_2_nds_tree_map_bulk_load();
+
+		case 10:
+			return test_3_nds_tree_map_bulk_load();
+
+		case 11:
+			return test_1_nds_tree_map_insert();
+
+		case 12:
+			return test_2_nds_tree_map_insert();
+
+		case 13:
+			return test_3_nds_tree_map_insert();
+
+		case 14:
+			return test_1_nds_tree_map_find();
+
+		case 15:
+			return test_1_nds_tree_map_remove();
+
+		case 16:
+			return test_2_nds_tree_map_remove();
+
+		case 17:
+			return test_3_nds_tree_map_remove();
+
+		case 18:
+			return test_4_nds_tree_map_remove();
+
+		case 19:
+			return test_1_nds_tree_map_clear();
+
+		case 20:
+			return test_1_nds_tree_map_lower_bound();
+
+		case 21:
+			return test_1_nds_tree_map_range();
+
+		case 22:
+			return test_2_nds_tree_map_range();
+
+		default:
+			printf("No tests were found with the given ID!\n");
+			return 1;
+	}
+}
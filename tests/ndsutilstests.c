@@ -0,0 +1,467 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file defines various unit tests for the utilities (allocators) from
+ * the NDS library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include <nds/ndsutils.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * Unit tests for the nds_allocator_default() function.
+ */
+
+/**
+ * Test 1 - verify if nds_allocator_default() allocates, grows and frees memory
+ */
+int test_1_nds_allocator_default()
+{
+	const NdsAllocator *allocator = nds_allocator_default();
+	char *block;
+
+	if (allocator == NULL || allocator->alloc == NULL || allocator->realloc == NULL || allocator->free == NULL)
+		return 1;
+
+	block = (char*)allocator->alloc(allocator->context, 16);
+	if (block == NULL)
+		return 1;
+
+	strcpy(block, "nds");
+
+	/* the content should be preserved after growing the block */
+	block = (char*)allocator->realloc(allocator->context, block, 16, 4096);
+	if (block == NULL)
+		return 1;
+
+	if (strcmp(block, "nds") != 0)
+	{
+		allocator->free(allocator->context, block, 4096);
+		return 1;
+	}
+
+	/* cleanup */
+	allocator->free(allocator->context, block, 4096);
+
+	return 0;
+}
+
+
+/**
+ * Unit tests for the nds_arena_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_arena_new()
+ */
+int test_1_nds_arena_new()
+{
+	NdsArena *arena = nds_arena_new(0);
+
+	/* arena should be null, because we set the size of a chunk to 0 */
+	if (arena != NULL)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - verify if nds_arena_new() creates an arena that hands out aligned, disjoint blocks
+ */
+int test_2_nds_arena_new()
+{
+	NdsArena *arena = nds_arena_new(1024);
+	NdsAllocator allocator = nds_arena_allocator(arena);
+	char *first, *second;
+	int result = 0;
+
+	/* arena should not be null */
+	if (arena == NULL)
+		return 1;
+
+	first = (char*)allocator.alloc(allocator.context, 3);
+	second = (char*)allocator.alloc(allocator.context, 3);
+
+	/* blocks should be 16 bytes aligned and should not overlap */
+	if (first == NULL || second == NULL || ((size_t)first & 15) != 0 || ((size_t)second & 15) != 0 || second < first + 3)
+		result = 1;
+
+	/* a block larger than a chunk should get its own chunk */
+	if (allocator.alloc(allocator.context, 4096) == NULL)
+		result = 1;
+
+	/* cleanup */
+	nds_arena_destroy(arena);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_arena_destroy() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_arena_destroy()
+ */
+int test_1_nds_arena_destroy()
+{
+	nds_arena_destroy(NULL);
+
+	return 0;
+}
+
+
+
+/**
+ * Unit tests for the nds_arena_reset() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_arena_reset()
+ */
+int test_1_nds_arena_reset()
+{
+	/* reset() should return NDS_INVALID_PARAM_ERROR */
+	if (nds_arena_reset(NULL) != NDS_INVALID_PARAM_ERROR)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - verify if nds_arena_reset() reuses the chunks of the arena
+ */
+int test_2_nds_arena_reset()
+{
+	NdsArena *arena = nds_arena_new(256);
+	NdsAllocator allocator = nds_arena_allocator(arena);
+	void *blocks[40];
+	int result = 0, i;
+
+	/* the first pass requires several chunks */
+	for (i = 0; i < 40; i++)
+		blocks[i] = allocator.alloc(allocator.context, 64);
+
+	nds_arena_reset(arena);
+
+	/* the second pass should get exactly the same blocks from the retained chunks */
+	for (i = 0; i < 40; i++)
+		if (allocator.alloc(allocator.context, 64) != blocks[i])
+			result = 1;
+
+	/* cleanup */
+	nds_arena_destroy(arena);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_arena_allocator() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_arena_allocator()
+ */
+int test_1_nds_arena_allocator()
+{
+	NdsAllocator allocator = nds_arena_allocator(NULL);
+
+	/* an allocator without arena should not hand out memory */
+	if (allocator.alloc(allocator.context, 16) != NULL)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - verify if the arena grows and releases its last block in place
+ */
+int test_2_nds_arena_allocator()
+{
+	NdsArena *arena = nds_arena_new(1024);
+	NdsAllocator allocator = nds_arena_allocator(arena);
+	char *block, *grown, *next;
+	int result = 0;
+
+	block = (char*)allocator.alloc(allocator.context, 32);
+	strcpy(block, "arena");
+
+	/* the last block should grow without moving */
+	grown = (char*)allocator.realloc(allocator.context, block, 32, 512);
+	if (grown != block || strcmp(grown, "arena") != 0)
+		result = 1;
+
+	/* freeing the last block should make its memory available again */
+	allocator.free(allocator.context, grown, 512);
+	next = (char*)allocator.alloc(allocator.context, 16);
+	if (next != block)
+		result = 1;
+
+	/* a block that can not grow in place should be copied */
+	grown = (char*)allocator.realloc(allocator.context, block, 16, 2048);
+	if (grown == NULL || grown == block || strcmp(grown, "arena") != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_arena_destroy(arena);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if the arena rejects sizes that would wrap around instead of handing out short blocks
+ */
+int test_3_nds_arena_allocator()
+{
+	NdsArena *arena = nds_arena_new(1024);
+	NdsAllocator allocator = nds_arena_allocator(arena);
+	char *block;
+	int result = 0;
+
+	/* an arena with such a chunk size can not exist */
+	if (nds_arena_new(SIZE_MAX) != NULL)
+		result = 1;
+
+	if (allocator.alloc(allocator.context, SIZE_MAX) != NULL || allocator.alloc(allocator.context, SIZE_MAX - 8) != NULL)
+		result = 1;
+
+	block = (char*)allocator.alloc(allocator.context, 32);
+	strcpy(block, "arena");
+
+	/* the last block should neither grow in place nor be moved, and it should stay intact */
+	if (allocator.realloc(allocator.context, block, 32, SIZE_MAX - 8) != NULL || strcmp(block, "arena") != 0)
+		result = 1;
+
+	/* the arena should keep working after the rejected requests */
+	if (allocator.alloc(allocator.context, 16) != block + 32)
+		result = 1;
+
+	/* cleanup */
+	nds_arena_destroy(arena);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_pool_new() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_pool_new()
+ */
+int test_1_nds_pool_new()
+{
+	/* pool should be null, because we set the size of a block or the number of blocks to 0 */
+	if (nds_pool_new(0, 16) != NULL || nds_pool_new(16, 0) != NULL)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - verify if nds_pool_new() creates a pool that rejects blocks larger than its block size
+ */
+int test_2_nds_pool_new()
+{
+	NdsPool *pool = nds_pool_new(64, 4);
+	NdsAllocator allocator = nds_pool_allocator(pool);
+	int result = 0;
+
+	/* pool should not be null */
+	if (pool == NULL)
+		return 1;
+
+	if (allocator.alloc(allocator.context, 64) == NULL || allocator.alloc(allocator.context, 65) != NULL)
+		result = 1;
+
+	/* cleanup */
+	nds_pool_destroy(pool);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if nds_pool_new() rejects chunks whose size would wrap around
+ */
+int test_3_nds_pool_new()
+{
+	/* pool should be null, because a chunk of these blocks can not be allocated */
+	if (nds_pool_new(SIZE_MAX, 1) != NULL || nds_pool_new(SIZE_MAX / 2, 4) != NULL)
+		return 1;
+
+	return 0;
+}
+
+
+
+/**
+ * Unit tests for the nds_pool_destroy() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_pool_destroy()
+ */
+int test_1_nds_pool_destroy()
+{
+	nds_pool_destroy(NULL);
+
+	return 0;
+}
+
+
+
+/**
+ * Unit tests for the nds_pool_allocator() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_pool_allocator()
+ */
+int test_1_nds_pool_allocator()
+{
+	NdsAllocator allocator = nds_pool_allocator(NULL);
+
+	/* an allocator without pool should not hand out memory */
+	if (allocator.alloc(allocator.context, 16) != NULL)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - verify if the pool hands out distinct blocks and reuses released ones
+ */
+int test_2_nds_pool_allocator()
+{
+	NdsPool *pool = nds_pool_new(32, 4);
+	NdsAllocator allocator = nds_pool_allocator(pool);
+	void *blocks[10];
+	int result = 0, i, j;
+
+	/* blocks should be distinct, even across chunks */
+	for (i = 0; i < 10; i++)
+	{
+		blocks[i] = allocator.alloc(allocator.context, 32);
+		if (blocks[i] == NULL)
+			result = 1;
+
+		for (j = 0; j < i; j++)
+			if (blocks[j] == blocks[i])
+				result = 1;
+	}
+
+	/* the last released block should be handed out first */
+	allocator.free(allocator.context, blocks[3], 32);
+	allocator.free(allocator.context, blocks[7], 32);
+	if (allocator.alloc(allocator.context, 32) != blocks[7] || allocator.alloc(allocator.context, 32) != blocks[3])
+		result = 1;
+
+	/* cleanup */
+	nds_pool_destroy(pool);
+
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndsutilstests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_allocator_default();
+
+		case 2:
+			return test_1_nds_arena_new();
+
+		case 3:
+			return test_2_nds_arena_new();
+
+		case 4:
+			return test_1_nds_arena_destroy();
+
+		case 5:
+			return test_1_nds_arena_reset();
+
+		case 6:
+			return test_2_nds_arena_reset();
+
+		case 7:
+			return test_1_nds_arena_allocator();
+
+		case 8:
+			return test_2_nds_arena_allocator();
+
+		case 9:
+			return test_1_nds_pool_new();
+
+		case 10:
+			return test_2_nds_pool_new();
+
+		case 11:
+			return test_1_nds_pool_destroy();
+
+		case 12:
+			return test_1_nds_pool_allocator();
+
+		case 13:
+			return test_2_nds_pool_allocator();
+
+		case 14:
+			return test_3_nds_arena_allocator();
+
+		case 15:
+			return test_3_nds_pool_new();
+
+		default:
+			printf("No tests were found with the given ID!\n");
+			return 1;
+	}
+}
@@ -24,13 +24,19 @@
  *
  * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
  * @created     14 July 2017
- * @modified    23 February 2018
+ * @modified    17 October 2026
  */
 
+#include "ndstesthelpers.h"
+
+#include <nds/ndsscheduler.h>
 #include <nds/ndsvector.h>
 
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 
 /**
@@ -132,6 +138,19 @@ int test_3_nds_vector_new_with_capacity()
 }
 
 
+/**
+ * Test 4 - verify if a capacity whose size in bytes overflows is rejected
+ */
+int test_4_nds_vector_new_with_capacity()
+{
+	/* SIZE_MAX / 2 elements of 3 bytes need more bytes than a size_t holds */
+	if (nds_vector_new_with_capacity(3, SIZE_MAX / 2) != NULL || nds_vector_new_small(3, SIZE_MAX / 2) != NULL)
+		return 1;
+
+	return 0;
+}
+
+
 /**
  * Unit tests for the nds_vector_destroy() function.
  */
@@ -155,29 +174,36 @@ int test_2_nds_vector_destroy()
 	NdsVector *vector = nds_vector_new(sizeof(int));
 	struct NdsVectorPrivate *private = vector->private;
 
+	/* destroy() should ignore an invalidated NdsVector */
 	vector->private = NULL;
 	nds_vector_destroy(vector);
 
 	/* cleanup */
-	free(private);
+	vector->private = private;
+	nds_vector_destroy(vector);
 
 	return 0;
 }
 
 
 /**
- * Test 3 - test if nds_vector_destroy() frees the memory of the NdsVector
+ * Test 3 - test if nds_vector_destroy() frees vectors with inline and spilled elements
  */
 int test_3_nds_vector_destroy()
 {
-	NdsVector *vector = nds_vector_new(sizeof(int));
+	NdsVector *inline_vector = nds_vector_new_small(sizeof(int), 4);
+	NdsVector *spilled_vector = nds_vector_new_small(sizeof(int), 4);
+	int i;
 
-	/* cleanup */
-	nds_vector_destroy(vector);
+	for (i = 0; i < 2; i++)
+		nds_vector_push_back(inline_vector, &i);
 
-	/* the private part of the vector should be NULL */
-	if (vector->private != NULL)
-		return 1;
+	for (i = 0; i < 8; i++)
+		nds_vector_push_back(spilled_vector, &i);
+
+	/* cleanup */
+	nds_vector_destroy(inline_vector);
+	nds_vector_destroy(spilled_vector);
 
 	return 0;
 }
@@ -291,6 +317,33 @@ int test_3_nds_vector_size()
 }
 
 
+/**
+ * Test 4 - verify if the size of a NdsVector with more than 2^31 elements is reported
+ */
+int test_4_nds_vector_size()
+{
+	NdsVector *vector = nds_vector_new(sizeof(char));
+	int result = 0;
+
+#if SIZE_MAX > 0xffffffffu
+	/* the elements are never touched, so the mapping does not use physical memory */
+	if (nds_vector_reserve(vector, 3000000000u) == NDS_OK)
+	{
+		if (nds_vector_resize(vector, 3000000000u) != NDS_OK)
+			result = 1;
+
+		if (nds_vector_size(vector) != (ssize_t)3000000000u || nds_vector_capacity(vector) != (ssize_t)3000000000u)
+			result = 1;
+	}
+#endif
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
 /**
  * Unit tests for the nds_vector_resize() function.
  */
@@ -332,9 +385,10 @@ int test_2_nds_vector_resize()
 int test_3_nds_vector_resize()
 {
 	NdsVector *vector = nds_vector_new(sizeof(int));
-	int result = 0;
+	int result = 0, i;
 
-	/* TODO - add some elements */
+	for (i = 0; i < 5; i++)
+		nds_vector_push_back(vector, &i);
 
 	/* vector should have size 0 after resize */
 	nds_vector_resize(vector, 0);
@@ -354,9 +408,10 @@ int test_3_nds_vector_resize()
 int test_4_nds_vector_resize()
 {
 	NdsVector *vector = nds_vector_new(sizeof(int));
-	int result = 0;
+	int result = 0, i;
 
-	/* TODO - add some elements */
+	for (i = 0; i < 5; i++)
+		nds_vector_push_back(vector, &i);
 
 	/* vector should have size 2 after resize */
 	nds_vector_resize(vector, 2);
@@ -376,9 +431,10 @@ int test_4_nds_vector_resize()
 int test_5_nds_vector_resize()
 {
 	NdsVector *vector = nds_vector_new(sizeof(int));
-	int result = 0, size;
+	int result = 0, size, i;
 
-	/* TODO - add some elements */
+	for (i = 0; i < 5; i++)
+		nds_vector_push_back(vector, &i);
 
 	size = nds_vector_size(vector);
 
@@ -434,6 +490,28 @@ int test_7_nds_vector_resize()
 }
 
 
+/**
+ * Test 8 - verify if a size whose size in bytes overflows is rejected
+ */
+int test_8_nds_vector_resize()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0;
+
+	if (nds_vector_resize(vector, SIZE_MAX / 2) != NDS_MEM_ALLOC_ERROR)
+		result = 1;
+
+	/* the vector should be unchanged */
+	if (nds_vector_size(vector) != 0 || nds_vector_capacity(vector) != 10)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
 /**
  * Unit tests for the nds_vector_capacity() function.
  */
@@ -578,6 +656,24 @@ int test_5_nds_vector_reserve()
 }
 
 
+/**
+ * Test 6 - verify if a capacity whose size in bytes overflows is rejected
+ */
+int test_6_nds_vector_reserve()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0;
+
+	if (nds_vector_reserve(vector, SIZE_MAX / 2) != NDS_MEM_ALLOC_ERROR || nds_vector_capacity(vector) != 10)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
 /**
  * Unit tests for the nds_vector_shrink_to_fit() function.
  */
@@ -656,116 +752,2945 @@ int test_4_nds_vector_shrink_to_fit()
 }
 
 
-int main(int argc, char **argv)
+/**
+ * Unit tests for the nds_vector_push_back() function.
+ */
+
+/**
+ * Test 1 - sanity check 1 for nds_vector_push_back()
+ */
+int test_1_nds_vector_push_back()
 {
-	/* sanity check */
-	if (argc != 2)
-	{
-		printf("Usage: ./ndsvectortests test_id\n");
+	int element = 1;
+
+	/* push_back() should return NDS_INVALID_PARAM_ERROR */
+	if (nds_vector_push_back(NULL, &element) != NDS_INVALID_PARAM_ERROR)
 		return 1;
-	}
 
-	/* we run the test that was passed as command line argument */
-	switch (atoi(argv[1]))
-	{
-		case 1:
-			return test_1_nds_vector_new();
+	return 0;
+}
 
-		case 2:
-			return test_2_nds_vector_new();
 
-		case 3:
-			return test_1_nds_vector_new_with_capacity();
+/**
+ * Test 2 - sanity check 2 for nds_vector_push_back()
+ */
+int test_2_nds_vector_push_back()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0;
 
-		case 4:
-			return test_2_nds_vector_new_with_capacity();
+	/* push_back() should return NDS_INVALID_PARAM_ERROR for a NULL element */
+	if (nds_vector_push_back(vector, NULL) != NDS_INVALID_PARAM_ERROR || nds_vector_size(vector) != 0)
+		result = 1;
 
-		case 5:
-			return test_3_nds_vector_new_with_capacity();
+	/* cleanup */
+	nds_vector_destroy(vector);
 
-		case 6:
-			return test_1_nds_vector_destroy();
+	return result;
+}
 
-		case 7:
-			return test_2_nds_vector_destroy();
 
-		case 8:
-			return test_3_nds_vector_destroy();
+/**
+ * Test 3 - verify if nds_vector_push_back() appends elements and grows the capacity
+ */
+int test_3_nds_vector_push_back()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, i, element;
 
-		case 9:
-			return test_1_nds_vector_is_empty();
+	for (i = 0; i < 100; i++)
+		if (nds_vector_push_back(vector, &i) != NDS_OK)
+			result = 1;
 
-		case 10:
-			return test_2_nds_vector_is_empty();
+	/* vector should have size 100 and capacity 160 (10 doubled four times) */
+	if (nds_vector_size(vector) != 100 || nds_vector_capacity(vector) != 160)
+		result = 1;
 
-		case 11:
-			return test_3_nds_vector_is_empty();
+	/* elements should be stored in the order they were appended */
+	for (i = 0; i < 100; i++)
+		if (nds_vector_get(vector, i, &element) != NDS_OK || element != i)
+			result = 1;
 
-		case 12:
-			return test_1_nds_vector_size();
+	/* cleanup */
+	nds_vector_destroy(vector);
 
-		case 13:
-			return test_2_nds_vector_size();
+	return result;
+}
 
-		case 14:
-			return test_3_nds_vector_size();
+/**
+ * Test 4 - verify if nds_vector_push_back() appends an element of the vector itself when the vector grows
+ */
+int test_4_nds_vector_push_back()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, i, element;
 
-		case 15:
-			return test_1_nds_vector_resize();
+	for (i = 0; i < 10; i++)
+		nds_vector_push_back(vector, &i);
 
-		case 16:
-			return test_2_nds_vector_resize();
+	/* the vector is full, so the element is read after the buffer was moved */
+	if (nds_vector_push_back(vector, (int*)nds_vector_data(vector) + 3) != NDS_OK || nds_vector_size(vector) != 11)
+		result = 1;
 
-		case 17:
-			return test_3_nds_vector_resize();
+	if (nds_vector_get(vector, 10, &element) != NDS_OK || element != 3)
+		result = 1;
 
-		case 18:
-			return test_4_nds_vector_resize();
+	/* cleanup */
+	nds_vector_destroy(vector);
 
-		case 19:
-			return test_5_nds_vector_resize();
+	return result;
+}
 
-		case 20:
-			return test_6_nds_vector_resize();
 
-		case 21:
-			return test_7_nds_vector_resize();
 
-		case 22:
-			return test_1_nds_vector_capacity();
+/**
+ * Unit tests for the nds_vector_append_n() function.
+ */
 
-		case 23:
-			return test_2_nds_vector_capacity();
+/**
+ * Test 1 - sanity check 1 for nds_vector_append_n()
+ */
+int test_1_nds_vector_append_n()
+{
+	int elements[2] = {1, 2};
 
-		case 24:
-			return test_3_nds_vector_capacity();
+	/* append_n() should return NDS_INVALID_PARAM_ERROR */
+	if (nds_vector_append_n(NULL, elements, 2) != NDS_INVALID_PARAM_ERROR)
+		return 1;
 
-		case 25:
-			return test_1_nds_vector_reserve();
+	return 0;
+}
 
-		case 26:
-			return test_2_nds_vector_reserve();
 
-		case 27:
-			return test_3_nds_vector_reserve();
+/**
+ * Test 2 - verify if nds_vector_append_n() accepts an empty range
+ */
+int test_2_nds_vector_append_n()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0;
 
-		case 28:
-			return test_4_nds_vector_reserve();
+	/* appending no elements should succeed and leave the vector untouched */
+	if (nds_vector_append_n(vector, NULL, 0) != NDS_OK || nds_vector_size(vector) != 0 || nds_vector_capacity(vector) != 10)
+		result = 1;
 
-		case 29:
-			return test_5_nds_vector_reserve();
+	/* cleanup */
+	nds_vector_destroy(vector);
 
-		case 30:
-			return test_1_nds_vector_shrink_to_fit();
+	return result;
+}
 
-		case 31:
-			return test_2_nds_vector_shrink_to_fit();
 
-		case 32:
-			return test_3_nds_vector_shrink_to_fit();
+/**
+ * Test 3 - verify if nds_vector_append_n() appends a large range after existing elements
+ */
+int test_3_nds_vector_append_n()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int elements[1000];
+	int result = 0, i, element = -1;
 
-		case 33:
-			return test_4_nds_vector_shrink_to_fit();
+	for (i = 0; i < 1000; i++)
+		elements[i] = i;
+
+	nds_vector_push_back(vector, &element);
+
+	/* vector should grow only once, to fit exactly 1001 elements */
+	if (nds_vector_append_n(vector, elements, 1000) != NDS_OK || nds_vector_size(vector) != 1001 || nds_vector_capacity(vector) != 1001)
+		result = 1;
+
+	/* the first element should be preserved and followed by the appended range */
+	if (nds_vector_get(vector, 0, &element) != NDS_OK || element != -1)
+		result = 1;
+
+	for (i = 0; i < 1000; i++)
+		if (nds_vector_get(vector, i + 1, &element) != NDS_OK || element != i)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 4 - verify if a count that overflows the size is rejected
+ */
+int test_4_nds_vector_append_n()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, element = 1;
+
+	nds_vector_push_back(vector, &element);
+
+	if (nds_vector_append_n(vector, &element, SIZE_MAX) != NDS_MEM_ALLOC_ERROR || nds_vector_size(vector) != 1)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+/**
+ * Test 5 - verify if nds_vector_append_n() duplicates the contents of the vector into itself when the vector grows
+ */
+int test_5_nds_vector_append_n()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, i, element;
+
+	for (i = 0; i < 10; i++)
+		nds_vector_push_back(vector, &i);
+
+	/* the source is the whole buffer, which is moved by the growth */
+	if (nds_vector_append_n(vector, nds_vector_data(vector), 10) != NDS_OK || nds_vector_size(vector) != 20)
+		result = 1;
+
+	for (i = 0; i < 20; i++)
+		if (nds_vector_get(vector, i, &element) != NDS_OK || element != i % 10)
+			result = 1;
+
+	/* a part of the vector that does not start at the first element */
+	if (nds_vector_append_n(vector, (int*)nds_vector_data(vector) + 15, 5) != NDS_OK || nds_vector_size(vector) != 25)
+		result = 1;
+
+	for (i = 20; i < 25; i++)
+		if (nds_vector_get(vector, i, &element) != NDS_OK || element != i - 15)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_pop_back() function.
+ */
+
+/**
+ * Test 1 - sanity check 1 for nds_vector_pop_back()
+ */
+int test_1_nds_vector_pop_back()
+{
+	/* pop_back() should return NDS_INVALID_PARAM_ERROR */
+	if (nds_vector_pop_back(NULL, NULL) != NDS_INVALID_PARAM_ERROR)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - sanity check 2 for nds_vector_pop_back()
+ */
+int test_2_nds_vector_pop_back()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0;
+
+	/* pop_back() should return NDS_INVALID_PARAM_ERROR for an empty vector */
+	if (nds_vector_pop_back(vector, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if nds_vector_pop_back() removes the last elements in reverse order
+ */
+int test_3_nds_vector_pop_back()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, i, element;
+
+	for (i = 0; i < 20; i++)
+		nds_vector_push_back(vector, &i);
+
+	for (i = 19; i >= 10; i--)
+		if (nds_vector_pop_back(vector, &element) != NDS_OK || element != i)
+			result = 1;
+
+	/* vector should have size 10, while the capacity stays 20 */
+	if (nds_vector_size(vector) != 10 || nds_vector_capacity(vector) != 20)
+		result = 1;
+
+	/* element can be NULL */
+	if (nds_vector_pop_back(vector, NULL) != NDS_OK || nds_vector_size(vector) != 9)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_get() function.
+ */
+
+/**
+ * Test 1 - sanity check 1 for nds_vector_get()
+ */
+int test_1_nds_vector_get()
+{
+	int element;
+
+	/* get() should return NDS_INVALID_PARAM_ERROR */
+	if (nds_vector_get(NULL, 0, &element) != NDS_INVALID_PARAM_ERROR)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - sanity check 2 for nds_vector_get()
+ */
+int test_2_nds_vector_get()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, element = 7;
+
+	nds_vector_push_back(vector, &element);
+
+	/* get() should return NDS_INVALID_PARAM_ERROR for an index out of range */
+	if (nds_vector_get(vector, 1, &element) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* get() should return NDS_INVALID_PARAM_ERROR for a NULL destination */
+	if (nds_vector_get(vector, 0, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if nds_vector_get() copies elements larger than a word
+ */
+int test_3_nds_vector_get()
+{
+	NdsVector *vector = nds_vector_new(sizeof(double[4]));
+	double element[4] = {1.5, 2.5, 3.5, 4.5}, copy[4];
+	int result = 0;
+
+	nds_vector_push_back(vector, element);
+
+	if (nds_vector_get(vector, 0, copy) != NDS_OK)
+		result = 1;
+
+	if (copy[0] != 1.5 || copy[1] != 2.5 || copy[2] != 3.5 || copy[3] != 4.5)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_set() function.
+ */
+
+/**
+ * Test 1 - sanity check 1 for nds_vector_set()
+ */
+int test_1_nds_vector_set()
+{
+	int element = 1;
+
+	/* set() should return NDS_INVALID_PARAM_ERROR */
+	if (nds_vector_set(NULL, 0, &element) != NDS_INVALID_PARAM_ERROR)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - sanity check 2 for nds_vector_set()
+ */
+int test_2_nds_vector_set()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, element = 1;
+
+	/* set() should return NDS_INVALID_PARAM_ERROR for an index that is not part of the size */
+	if (nds_vector_set(vector, 0, &element) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if nds_vector_set() overwrites only the given element
+ */
+int test_3_nds_vector_set()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, i, element;
+
+	for (i = 0; i < 5; i++)
+		nds_vector_push_back(vector, &i);
+
+	element = 42;
+	if (nds_vector_set(vector, 2, &element) != NDS_OK)
+		result = 1;
+
+	for (i = 0; i < 5; i++)
+		if (nds_vector_get(vector, i, &element) != NDS_OK || element != (i == 2 ? 42 : i))
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_data() function.
+ */
+
+/**
+ * Test 1 - sanity check 1 for nds_vector_data()
+ */
+int test_1_nds_vector_data()
+{
+	/* data() should return NULL */
+	if (nds_vector_data(NULL) != NULL)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - verify if nds_vector_data() exposes the elements contiguously
+ */
+int test_2_nds_vector_data()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, i;
+	int *data;
+
+	for (i = 0; i < 50; i++)
+		nds_vector_push_back(vector, &i);
+
+	data = (int*)nds_vector_data(vector);
+	if (data == NULL)
+		result = 1;
+	else
+		for (i = 0; i < 50; i++)
+			if (data[i] != i)
+				result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Unit tests for the nds_vector_new_small() function.
+ */
+
+/**
+ * Test 1 - sanity check 1 for nds_vector_new_small()
+ */
+int test_1_nds_vector_new_small()
+{
+	/* vector should be null, because we set the size of one element or the inline capacity to 0 */
+	if (nds_vector_new_small(0, 8) != NULL || nds_vector_new_small(sizeof(int), 0) != NULL)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - verify if nds_vector_new_small() uses the inline buffer as its capacity
+ */
+int test_2_nds_vector_new_small()
+{
+	NdsVector *vector = nds_vector_new_small(sizeof(int), 8);
+	int result = 0;
+
+	/* vector should not be null */
+	if (vector == NULL)
+		return 1;
+
+	/* vector should have size 0, capacity 8 and its elements right after the vector */
+	if (nds_vector_size(vector) != 0 || nds_vector_capacity(vector) != 8)
+		result = 1;
+
+	if ((char*)nds_vector_data(vector) <= (char*)vector || (char*)nds_vector_data(vector) > (char*)vector + 256)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if a small NdsVector spills its elements to the heap when full
+ */
+int test_3_nds_vector_new_small()
+{
+	NdsVector *vector = nds_vector_new_small(sizeof(int), 4);
+	int result = 0, i, element;
+
+	for (i = 0; i < 4; i++)
+		nds_vector_push_back(vector, &i);
+
+	if (nds_vector_capacity(vector) != 4)
+		result = 1;
+
+	/* the fifth element should double the capacity and keep the existing elements */
+	nds_vector_push_back(vector, &i);
+	if (nds_vector_size(vector) != 5 || nds_vector_capacity(vector) != 8)
+		result = 1;
+
+	for (i = 0; i < 5; i++)
+		if (nds_vector_get(vector, i, &element) != NDS_OK || element != i)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 4 - verify if nds_vector_shrink_to_fit() moves the elements back into the inline buffer
+ */
+int test_4_nds_vector_new_small()
+{
+	NdsVector *vector = nds_vector_new_small(sizeof(int), 4);
+	int result = 0, i, element;
+
+	for (i = 0; i < 10; i++)
+		nds_vector_push_back(vector, &i);
+
+	nds_vector_resize(vector, 3);
+
+	/* the vector should come back to its inline capacity and keep its elements */
+	if (nds_vector_shrink_to_fit(vector) != NDS_OK || nds_vector_capacity(vector) != 4)
+		result = 1;
+
+	for (i = 0; i < 3; i++)
+		if (nds_vector_get(vector, i, &element) != NDS_OK || element != i)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Unit tests for the nds_vector_new_with_allocator() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_new_with_allocator()
+ */
+int test_1_nds_vector_new_with_allocator()
+{
+	NdsAllocator allocator = {NULL, NULL, NULL, NULL};
+
+	/* vector should be null, because the allocator is missing or incomplete */
+	if (nds_vector_new_with_allocator(sizeof(int), 10, NULL) != NULL || nds_vector_new_with_allocator(sizeof(int), 10, &allocator) != NULL)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - verify if every allocation of the NdsVector goes through its allocator
+ */
+int test_2_nds_vector_new_with_allocator()
+{
+	NdsAllocator allocator;
+	struct NdsTestUsage usage;
+	NdsVector *vector;
+	int result = 0, i;
+
+	allocator = counting_allocator(&usage);
+
+	vector = nds_vector_new_with_allocator(sizeof(int), 4, &allocator);
+	if (vector == NULL)
+		return 1;
+
+	/* the block of the vector and its elements */
+	if (usage.allocations - usage.frees != 2)
+		result = 1;
+
+	for (i = 0; i < 100; i++)
+		nds_vector_push_back(vector, &i);
+
+	nds_vector_reserve(vector, 500);
+	nds_vector_shrink_to_fit(vector);
+
+	/* growth and shrinking should go through realloc() of the allocator */
+	if (usage.allocations - usage.frees != 2 || usage.reallocations < 3)
+		result = 1;
+
+	/* destroy() should give back every block */
+	nds_vector_destroy(vector);
+	if (usage.allocations - usage.frees != 0)
+		result = 1;
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if scratch vectors can live in an arena that is reset between requests
+ */
+int test_3_nds_vector_new_with_allocator()
+{
+	NdsArena *arena = nds_arena_new(4096);
+	NdsAllocator allocator = nds_arena_allocator(arena);
+	NdsVector *vector;
+	int result = 0, request, i, element;
+
+	for (request = 0; request < 3; request++)
+	{
+		vector = nds_vector_new_with_allocator(sizeof(int), 8, &allocator);
+		if (vector == NULL)
+		{
+			result = 1;
+			break;
+		}
+
+		for (i = 0; i < 200; i++)
+			nds_vector_push_back(vector, &i);
+
+		for (i = 0; i < 200; i++)
+			if (nds_vector_get(vector, i, &element) != NDS_OK || element != i)
+				result = 1;
+
+		nds_vector_destroy(vector);
+		nds_arena_reset(arena);
+	}
+
+	/* cleanup */
+	nds_arena_destroy(arena);
+
+	return result;
+}
+
+
+/**
+ * Test 4 - verify if a pool limits the vector to the size of its blocks
+ */
+int test_4_nds_vector_new_with_allocator()
+{
+	NdsPool *pool = nds_pool_new(256, 16);
+	NdsAllocator allocator = nds_pool_allocator(pool);
+	NdsVector *vector = nds_vector_new_with_allocator(sizeof(int), 8, &allocator);
+	int result = 0;
+
+	if (vector == NULL)
+		result = 1;
+
+	/* 64 integers fill one block of the pool, 65 do not fit anymore */
+	if (nds_vector_reserve(vector, 64) != NDS_OK || nds_vector_reserve(vector, 65) != NDS_MEM_ALLOC_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+	nds_pool_destroy(pool);
+
+	return result;
+}
+
+
+/**
+ * Unit tests for the nds_vector_set_large_storage() function.
+ */
+
+/**
+ * Test 1 - sanity check 1 for nds_vector_set_large_storage()
+ */
+int test_1_nds_vector_set_large_storage()
+{
+	/* set_large_storage() should return NDS_INVALID_PARAM_ERROR */
+	if (nds_vector_set_large_storage(NULL, 4096, 0) != NDS_INVALID_PARAM_ERROR)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - sanity check 2 for nds_vector_set_large_storage()
+ */
+int test_2_nds_vector_set_large_storage()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0;
+
+	/* set_large_storage() should return NDS_INVALID_PARAM_ERROR for unknown flags */
+	if (nds_vector_set_large_storage(vector, 4096, 0x80) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* disabling the mode is always possible */
+	if (nds_vector_set_large_storage(vector, 0, 0) != NDS_OK)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if a mapped NdsVector keeps its elements while growing and shrinking
+ */
+int test_3_nds_vector_set_large_storage()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, i, element;
+
+	/* everything above one page is mapped */
+	if (nds_vector_set_large_storage(vector, 4096, NDS_VECTOR_HUGE_PAGES) == NDS_ERROR)
+	{
+		/* cleanup */
+		nds_vector_destroy(vector);
+
+		return 0;
+	}
+
+	for (i = 0; i < 100000; i++)
+		if (nds_vector_push_back(vector, &i) != NDS_OK)
+			result = 1;
+
+	/* the mapped elements should start on a page boundary */
+	if (((size_t)nds_vector_data(vector) & 4095) != 0)
+		result = 1;
+
+	for (i = 0; i < 100000; i++)
+		if (nds_vector_get(vector, i, &element) != NDS_OK || element != i)
+			result = 1;
+
+	/* shrinking above the threshold should keep the elements mapped */
+	nds_vector_resize(vector, 5000);
+	if (nds_vector_shrink_to_fit(vector) != NDS_OK || nds_vector_capacity(vector) != 5000)
+		result = 1;
+
+	/* shrinking below the threshold should move the elements back to the allocator */
+	nds_vector_resize(vector, 10);
+	if (nds_vector_shrink_to_fit(vector) != NDS_OK || nds_vector_capacity(vector) != 10)
+		result = 1;
+
+	for (i = 0; i < 10; i++)
+		if (nds_vector_get(vector, i, &element) != NDS_OK || element != i)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 4 - verify if a small NdsVector goes from its inline buffer to a mapping and back
+ */
+int test_4_nds_vector_set_large_storage()
+{
+	NdsVector *vector = nds_vector_new_small(sizeof(int), 4);
+	int elements[5000];
+	int result = 0, i, element;
+
+	for (i = 0; i < 5000; i++)
+		elements[i] = i;
+
+	nds_vector_set_large_storage(vector, 4096, 0);
+
+	nds_vector_push_back(vector, &elements[0]);
+	if (nds_vector_append_n(vector, &elements[1], 4999) != NDS_OK || nds_vector_size(vector) != 5000)
+		result = 1;
+
+	nds_vector_resize(vector, 3);
+	if (nds_vector_shrink_to_fit(vector) != NDS_OK || nds_vector_capacity(vector) != 4)
+		result = 1;
+
+	for (i = 0; i < 3; i++)
+		if (nds_vector_get(vector, i, &element) != NDS_OK || element != i)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Unit tests for the nds_vector_save() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_save()
+ */
+int test_1_nds_vector_save()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0;
+
+	/* save() should return NDS_INVALID_PARAM_ERROR */
+	if (nds_vector_save(NULL, "test_1_nds_vector_save.bin") != NDS_INVALID_PARAM_ERROR || nds_vector_save(vector, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if nds_vector_save() reports a path that can not be written
+ */
+int test_2_nds_vector_save()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0;
+
+	/* save() should return NDS_ERROR */
+	if (nds_vector_save(vector, "missing_directory/test_2_nds_vector_save.bin") != NDS_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_open_mapped() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_open_mapped()
+ */
+int test_1_nds_vector_open_mapped()
+{
+	/* open_mapped() should return NULL for invalid parameters or a missing file */
+	if (nds_vector_open_mapped(NULL, 0) != NULL || nds_vector_open_mapped("missing_file.bin", 0) != NULL)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - verify if a saved NdsVector is opened with the same elements
+ */
+int test_2_nds_vector_open_mapped()
+{
+	const char *path = "test_2_nds_vector_open_mapped.bin";
+	NdsVector *vector = nds_vector_new(sizeof(double[3]));
+	NdsVector *opened;
+	double element[3];
+	int result = 0, i;
+
+	for (i = 0; i < 1000; i++)
+	{
+		element[0] = i;
+		element[1] = i * 0.5;
+		element[2] = -i;
+		nds_vector_push_back(vector, element);
+	}
+
+	if (nds_vector_save(vector, path) != NDS_OK)
+		result = 1;
+
+	opened = nds_vector_open_mapped(path, NDS_VECTOR_VERIFY_CHECKSUM);
+	if (opened == NULL)
+		result = 1;
+	else
+	{
+		/* the opened vector should have the same size and elements */
+		if (nds_vector_size(opened) != 1000 || memcmp(nds_vector_data(opened), nds_vector_data(vector), 1000 * sizeof(element)) != 0)
+			result = 1;
+
+		/* the elements should be used in place, right after the 64-byte header */
+		if (((size_t)nds_vector_data(opened) & 63) != 0)
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_vector_destroy(opened);
+	nds_vector_destroy(vector);
+	remove(path);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if nds_vector_open_mapped() rejects corrupted snapshots
+ */
+int test_3_nds_vector_open_mapped()
+{
+	const char *path = "test_3_nds_vector_open_mapped.bin";
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	NdsVector *opened;
+	FILE *file;
+	int result = 0, i;
+
+	for (i = 0; i < 100; i++)
+		nds_vector_push_back(vector, &i);
+
+	nds_vector_save(vector, path);
+
+	/* change one element */
+	file = fopen(path, "r+b");
+	fseek(file, 64 + 10 * sizeof(int), SEEK_SET);
+	fputc(0x7f, file);
+	fclose(file);
+
+	/* only the header is validated by default */
+	opened = nds_vector_open_mapped(path, 0);
+	if (opened == NULL)
+		result = 1;
+	nds_vector_destroy(opened);
+
+	/* the checksum should detect the change */
+	if (nds_vector_open_mapped(path, NDS_VECTOR_VERIFY_CHECKSUM) != NULL)
+		result = 1;
+
+	/* a truncated file should be rejected from its header */
+	file = fopen(path, "wb");
+	fputs("NDSVECT", file);
+	fclose(file);
+
+	if (nds_vector_open_mapped(path, 0) != NULL)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+	remove(path);
+
+	return result;
+}
+
+
+/**
+ * Test 4 - verify if changes to a mapped NdsVector do not reach the snapshot
+ */
+int test_4_nds_vector_open_mapped()
+{
+	const char *path = "test_4_nds_vector_open_mapped.bin";
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	NdsVector *opened;
+	int result = 0, i, element;
+
+	for (i = 0; i < 100; i++)
+		nds_vector_push_back(vector, &i);
+
+	nds_vector_save(vector, path);
+	nds_vector_destroy(vector);
+
+	opened = nds_vector_open_mapped(path, 0);
+	if (opened == NULL)
+		return 1;
+
+	/* overwrite an element in place, then grow the vector out of the mapping */
+	element = -1;
+	nds_vector_set(opened, 0, &element);
+
+	for (i = 100; i < 300; i++)
+		if (nds_vector_push_back(opened, &i) != NDS_OK)
+			result = 1;
+
+	for (i = 0; i < 300; i++)
+		if (nds_vector_get(opened, i, &element) != NDS_OK || element != (i == 0 ? -1 : i))
+			result = 1;
+
+	nds_vector_destroy(opened);
+
+	/* the snapshot should still hold the original elements */
+	opened = nds_vector_open_mapped(path, NDS_VECTOR_VERIFY_CHECKSUM);
+	if (opened == NULL || nds_vector_get(opened, 0, &element) != NDS_OK || element != 0 || nds_vector_size(opened) != 100)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(opened);
+	remove(path);
+
+	return result;
+}
+
+
+/**
+ * Unit tests for the nds_vector_get_stats() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_get_stats()
+ */
+int test_1_nds_vector_get_stats()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	NdsVectorStats stats;
+	int result = 0;
+
+	/* get_stats() should fail for invalid parameters */
+	if (nds_vector_get_stats(NULL, &stats) != NDS_INVALID_PARAM_ERROR || nds_vector_get_stats(vector, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the counters follow the growth and the shrinking of a NdsVector
+ */
+int test_2_nds_vector_get_stats()
+{
+	NdsVector *vector = nds_vector_new_with_capacity(sizeof(int), 1);
+	NdsVectorStats stats;
+	int result = 0, i;
+
+	for (i = 0; i < 1000; i++)
+		nds_vector_push_back(vector, &i);
+
+#ifdef NDS_ENABLE_STATS
+	/* 1000 elements pushed into a vector of capacity 1 need 10 doublings */
+	if (nds_vector_get_stats(vector, &stats) != NDS_OK || stats.reallocations != 10 || stats.peak_capacity != 1024 || stats.shrink_calls != 0)
+		result = 1;
+
+	nds_vector_shrink_to_fit(vector);
+
+	if (nds_vector_get_stats(vector, &stats) != NDS_OK || stats.reallocations != 11 || stats.peak_capacity != 1024 || stats.shrink_calls != 1)
+		result = 1;
+#else
+	/* without NDS_ENABLE_STATS no counters are kept */
+	if (nds_vector_get_stats(vector, &stats) != NDS_ERROR)
+		result = 1;
+#endif
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_stats_snapshot() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_stats_snapshot()
+ */
+int test_1_nds_stats_snapshot()
+{
+	/* stats_snapshot() should fail for invalid parameters */
+	if (nds_stats_snapshot(NULL) != NDS_INVALID_PARAM_ERROR)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - verify if the totals account the live vectors and their unused capacity
+ */
+int test_2_nds_stats_snapshot()
+{
+	NdsVector *vector;
+	NdsStats before, stats;
+	int result = 0;
+
+#ifdef NDS_ENABLE_STATS
+	if (nds_stats_snapshot(&before) != NDS_OK)
+		return 1;
+
+	vector = nds_vector_new_with_capacity(sizeof(int), 100);
+
+	/* the new vector holds 400 bytes, none of them used */
+	nds_stats_snapshot(&stats);
+	if (stats.live_vectors != before.live_vectors + 1 || stats.live_bytes != before.live_bytes + 400 || stats.wasted_bytes != before.wasted_bytes + 400)
+		result = 1;
+
+	nds_vector_resize(vector, 50);
+
+	nds_stats_snapshot(&stats);
+	if (stats.live_bytes != before.live_bytes + 400 || stats.wasted_bytes != before.wasted_bytes + 200)
+		result = 1;
+
+	nds_vector_destroy(vector);
+
+	/* destroying the vector removes it from the totals */
+	nds_stats_snapshot(&stats);
+	if (stats.live_vectors != before.live_vectors || stats.live_bytes != before.live_bytes || stats.wasted_bytes != before.wasted_bytes)
+		result = 1;
+#else
+	(void)vector;
+	(void)before;
+
+	/* without NDS_ENABLE_STATS no totals are kept */
+	if (nds_stats_snapshot(&stats) != NDS_ERROR)
+		result = 1;
+#endif
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if the totals follow the elements pushed, appended and popped between capacity changes
+ */
+int test_3_nds_stats_snapshot()
+{
+	NdsVector *vector;
+	NdsStats before, stats;
+	int elements[10] = {0}, result = 0, i;
+
+#ifdef NDS_ENABLE_STATS
+	vector = nds_vector_new_with_capacity(sizeof(int), 100);
+	if (nds_stats_snapshot(&before) != NDS_OK)
+		result = 1;
+
+	for (i = 0; i < 5; i++)
+		nds_vector_push_back(vector, &i);
+
+	/* 5 elements of the 100 are used and the capacity is unchanged */
+	nds_stats_snapshot(&stats);
+	if (stats.live_bytes != before.live_bytes || stats.wasted_bytes != before.wasted_bytes - 20)
+		result = 1;
+
+	nds_vector_pop_back(vector, &i);
+	nds_vector_append_n(vector, elements, 10);
+
+	nds_stats_snapshot(&stats);
+	if (stats.live_bytes != before.live_bytes || stats.wasted_bytes != before.wasted_bytes - 56)
+		result = 1;
+
+	/* popping every element gives the whole capacity back to the waste */
+	for (i = 0; i < 14; i++)
+		nds_vector_pop_back(vector, NULL);
+
+	nds_stats_snapshot(&stats);
+	if (stats.wasted_bytes != before.wasted_bytes)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+#else
+	(void)vector;
+	(void)before;
+	(void)elements;
+	(void)i;
+
+	/* without NDS_ENABLE_STATS no totals are kept */
+	if (nds_stats_snapshot(&stats) != NDS_ERROR)
+		result = 1;
+#endif
+
+	return result;
+}
+
+
+/**
+ * Unit tests for the nds_vector_resize_with_policy() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_resize_with_policy()
+ */
+int test_1_nds_vector_resize_with_policy()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0;
+
+	/* resize_with_policy() should return NDS_INVALID_PARAM_ERROR for a missing vector or an unknown policy */
+	if (nds_vector_resize_with_policy(NULL, 5, NDS_RESIZE_ZERO) != NDS_INVALID_PARAM_ERROR || nds_vector_resize_with_policy(vector, 5, 0x4) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if truncation leaves the memory alone and NDS_RESIZE_ZERO zeroes the new elements
+ */
+int test_2_nds_vector_resize_with_policy()
+{
+	NdsVector *vector = nds_vector_new_with_capacity(sizeof(int), 4);
+	int result = 0, i;
+	int *data;
+
+	for (i = 1; i <= 4; i++)
+		nds_vector_push_back(vector, &i);
+
+	/* the removed elements should still be in the buffer */
+	nds_vector_resize_with_policy(vector, 0, NDS_RESIZE_UNINIT);
+	data = (int*)nds_vector_data(vector);
+	for (i = 0; i < 4; i++)
+		if (data[i] != i + 1)
+			result = 1;
+
+	/* growing past the capacity with NDS_RESIZE_ZERO should zero every new element */
+	if (nds_vector_resize_with_policy(vector, 8, NDS_RESIZE_ZERO) != NDS_OK || nds_vector_size(vector) != 8)
+		result = 1;
+
+	data = (int*)nds_vector_data(vector);
+	for (i = 0; i < 8; i++)
+		if (data[i] != 0)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if NDS_RESIZE_SCRUB zeroes the removed elements only
+ */
+int test_3_nds_vector_resize_with_policy()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, i;
+	int *data;
+
+	for (i = 1; i <= 10; i++)
+		nds_vector_push_back(vector, &i);
+
+	if (nds_vector_resize_with_policy(vector, 5, NDS_RESIZE_SCRUB) != NDS_OK || nds_vector_size(vector) != 5)
+		result = 1;
+
+	data = (int*)nds_vector_data(vector);
+	for (i = 0; i < 10; i++)
+		if (data[i] != (i < 5 ? i + 1 : 0))
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 4 - verify if NDS_RESIZE_ZERO zeroes reused memory of a mapped NdsVector
+ */
+int test_4_nds_vector_resize_with_policy()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, i, value = -1;
+	int *data;
+
+	/* the elements are mapped from 4 KiB on, where the system provides zero pages */
+	nds_vector_set_large_storage(vector, 4096, 0);
+	nds_vector_resize_fill(vector, 4000, &value);
+	nds_vector_resize_fill(vector, nds_vector_capacity(vector), &value);
+
+	/* the whole capacity was written, the elements after it come from pages added by the growth */
+	nds_vector_resize(vector, 0);
+	if (nds_vector_resize_with_policy(vector, 9000, NDS_RESIZE_ZERO) != NDS_OK || nds_vector_size(vector) != 9000)
+		result = 1;
+
+	data = (int*)nds_vector_data(vector);
+	for (i = 0; i < 9000; i++)
+		if (data[i] != 0)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 5 - verify if NDS_RESIZE_ZERO zeroes the tail of the last page left by a shrink of a mapped NdsVector
+ */
+int test_5_nds_vector_resize_with_policy()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, i;
+	int *data;
+
+	if (nds_vector_set_large_storage(vector, 4096, 0) == NDS_ERROR)
+	{
+		/* cleanup */
+		nds_vector_destroy(vector);
+
+		return 0;
+	}
+
+	nds_vector_resize_with_policy(vector, 100000, NDS_RESIZE_ZERO);
+	memset(nds_vector_data(vector), 0xAB, 100000 * sizeof(int));
+
+	/* the shrink keeps the mapping, whose last page still holds elements after the new capacity */
+	nds_vector_resize(vector, 5000);
+	if (nds_vector_shrink_to_fit(vector) != NDS_OK || nds_vector_capacity(vector) != 5000)
+		result = 1;
+
+	if (nds_vector_resize_with_policy(vector, 9000, NDS_RESIZE_ZERO) != NDS_OK || nds_vector_size(vector) != 9000)
+		result = 1;
+
+	data = (int*)nds_vector_data(vector);
+	for (i = 5000; i < 9000; i++)
+		if (data[i] != 0)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_resize_fill() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_resize_fill()
+ */
+int test_1_nds_vector_resize_fill()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, value = 7;
+
+	/* resize_fill() should return NDS_INVALID_PARAM_ERROR for a missing vector or value */
+	if (nds_vector_resize_fill(NULL, 5, &value) != NDS_INVALID_PARAM_ERROR || nds_vector_resize_fill(vector, 5, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the new elements are copies of a 36 byte value and the old elements are kept
+ */
+int test_2_nds_vector_resize_fill()
+{
+	struct Record { char name[30]; short age; float height; } value, element;
+	NdsVector *vector = nds_vector_new(sizeof(struct Record));
+	int result = 0, i;
+
+	memset(&element, 0, sizeof(element));
+	for (i = 0; i < 3; i++)
+	{
+		element.age = i;
+		nds_vector_push_back(vector, &element);
+	}
+
+	memset(&value, 0, sizeof(value));
+	strcpy(value.name, "Valentin");
+	value.age = 27;
+	value.height = 1.83f;
+
+	if (nds_vector_resize_fill(vector, 10003, &value) != NDS_OK || nds_vector_size(vector) != 10003)
+		result = 1;
+
+	for (i = 0; i < 10003; i++)
+	{
+		nds_vector_get(vector, i, &element);
+
+		if (i < 3 && element.age != i)
+			result = 1;
+
+		if (i >= 3 && memcmp(&element, &value, sizeof(value)) != 0)
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if values made of one repeated byte and single elements are filled
+ */
+int test_3_nds_vector_resize_fill()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, i, value = 0x01010101, element;
+
+	if (nds_vector_resize_fill(vector, 1000, &value) != NDS_OK)
+		result = 1;
+
+	/* a single new element takes no doubling */
+	value = 0x01020304;
+	if (nds_vector_resize_fill(vector, 1001, &value) != NDS_OK || nds_vector_size(vector) != 1001)
+		result = 1;
+
+	for (i = 0; i < 1001; i++)
+	{
+		nds_vector_get(vector, i, &element);
+		if (element != (i < 1000 ? 0x01010101 : 0x01020304))
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Unit tests for the nds_vector_find() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_find()
+ */
+int test_1_nds_vector_find()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, element = 0;
+
+	/* find() should return -1 for invalid parameters */
+	if (nds_vector_find(NULL, &element) != -1 || nds_vector_find(vector, NULL) != -1)
+		result = 1;
+
+	/* find() should return -1 for an empty vector */
+	if (nds_vector_find(vector, &element) != -1)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/* fills a NdsVector with size elements of width bytes, the bytes of element i start at i % 200 and increase */
+static NdsVector* search_vector_new(size_t width, size_t size)
+{
+	NdsVector *vector = nds_vector_new(width);
+	unsigned char element[64];
+	size_t i, k;
+
+	for (i = 0; i < size; i++)
+	{
+		for (k = 0; k < width; k++)
+			element[k] = (unsigned char)(i % 200 + k);
+
+		nds_vector_push_back(vector, element);
+	}
+
+	return vector;
+}
+
+
+/* builds the element of search_vector_new() for a value */
+static void search_element(unsigned char *element, size_t width, size_t value)
+{
+	size_t k;
+
+	for (k = 0; k < width; k++)
+		element[k] = (unsigned char)(value + k);
+}
+
+
+/**
+ * Test 2 - verify if elements of every width are found, including the ones after the last full register
+ */
+int test_2_nds_vector_find()
+{
+	static const size_t widths[] = { 1, 2, 3, 4, 8, 36 };
+	unsigned char element[64];
+	NdsVector *vector;
+	int result = 0;
+	size_t i;
+
+	for (i = 0; i < sizeof(widths) / sizeof(widths[0]); i++)
+	{
+		vector = search_vector_new(widths[i], 1003);
+
+		search_element(element, widths[i], 150);
+		if (nds_vector_find(vector, element) != 150)
+			result = 1;
+
+		/* no element starts with the value 230 */
+		search_element(element, widths[i], 230);
+		if (nds_vector_find(vector, element) != -1)
+			result = 1;
+
+		/* the last elements are compared outside of the SIMD registers */
+		nds_vector_set(vector, 1001, element);
+		if (nds_vector_find(vector, element) != 1001)
+			result = 1;
+
+		nds_vector_destroy(vector);
+	}
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if the bytes of two neighbouring elements are not matched as one element
+ */
+int test_3_nds_vector_find()
+{
+	NdsVector *vector = nds_vector_new(sizeof(unsigned short));
+	unsigned char bytes[64];
+	unsigned short element;
+	int result = 0;
+
+	/* the element 0x3412 only appears across the boundary of two elements */
+	memset(bytes, 0, sizeof(bytes));
+	bytes[33] = 0x12;
+	bytes[34] = 0x34;
+	nds_vector_append_n(vector, bytes, sizeof(bytes) / sizeof(element));
+
+	memcpy(&element, &bytes[33], sizeof(element));
+	if (nds_vector_find(vector, &element) != -1)
+		result = 1;
+
+	/* moved by one byte, the same bytes form the element 16 */
+	bytes[32] = 0x12;
+	bytes[33] = 0x34;
+	nds_vector_set(vector, 16, &bytes[32]);
+	if (nds_vector_find(vector, &element) != 16)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_count() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_count()
+ */
+int test_1_nds_vector_count()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, element = 0;
+
+	/* count() should return -1 for invalid parameters and 0 for an empty vector */
+	if (nds_vector_count(NULL, &element) != -1 || nds_vector_count(vector, NULL) != -1 || nds_vector_count(vector, &element) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the equal elements of every width are counted
+ */
+int test_2_nds_vector_count()
+{
+	static const size_t widths[] = { 1, 2, 3, 4, 8, 36 };
+	unsigned char element[64];
+	NdsVector *vector;
+	int result = 0;
+	size_t i;
+
+	for (i = 0; i < sizeof(widths) / sizeof(widths[0]); i++)
+	{
+		vector = search_vector_new(widths[i], 1003);
+
+		/* the values 0 to 2 appear 6 times in 1003 elements, the others 5 times */
+		search_element(element, widths[i], 1);
+		if (nds_vector_count(vector, element) != 6)
+			result = 1;
+
+		search_element(element, widths[i], 150);
+		if (nds_vector_count(vector, element) != 5)
+			result = 1;
+
+		search_element(element, widths[i], 230);
+		if (nds_vector_count(vector, element) != 0)
+			result = 1;
+
+		nds_vector_destroy(vector);
+	}
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_contains() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_contains()
+ */
+int test_1_nds_vector_contains()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, element = 0;
+
+	/* contains() should return -1 for invalid parameters and 0 for an empty vector */
+	if (nds_vector_contains(NULL, &element) != -1 || nds_vector_contains(vector, NULL) != -1 || nds_vector_contains(vector, &element) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if present and missing elements are told apart
+ */
+int test_2_nds_vector_contains()
+{
+	NdsVector *vector = nds_vector_new(sizeof(double));
+	int result = 0, i;
+	double element;
+
+	for (i = 0; i < 100; i++)
+	{
+		element = i * 0.5;
+		nds_vector_push_back(vector, &element);
+	}
+
+	element = 49.5;
+	if (nds_vector_contains(vector, &element) != 1)
+		result = 1;
+
+	element = 50.0;
+	if (nds_vector_contains(vector, &element) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Unit tests for the nds_vector_sort() function.
+ */
+
+
+/* element of 36 bytes sorted by its age */
+struct SortPerson
+{
+	char name[28];
+	short age;
+	int id;
+};
+
+typedef struct SortPerson SortPerson;
+
+
+static int sort_compare_int(const void *first, const void *second)
+{
+	int a = *(const int*)first, b = *(const int*)second;
+
+	return (a > b) - (a < b);
+}
+
+
+static int sort_compare_int64(const void *first, const void *second)
+{
+	int64_t a = *(const int64_t*)first, b = *(const int64_t*)second;
+
+	return (a > b) - (a < b);
+}
+
+
+static int sort_compare_person(const void *first, const void *second)
+{
+	return ((const SortPerson*)first)->age - ((const SortPerson*)second)->age;
+}
+
+
+/* checks if every element of a NdsVector is not smaller than the one before it */
+static int sort_is_sorted(NdsVector *vector, size_t width, NdsCompareFunction compare)
+{
+	const char *elements = (const char*)nds_vector_data(vector);
+	ssize_t i;
+
+	for (i = 1; i < nds_vector_size(vector); i++)
+		if (compare(elements + (i - 1) * width, elements + i * width) > 0)
+			return 0;
+
+	return 1;
+}
+
+
+/**
+ * Test 1 - sanity check for nds_vector_sort()
+ */
+int test_1_nds_vector_sort()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0;
+
+	/* sort() should fail for invalid parameters and do nothing for an empty vector */
+	if (nds_vector_sort(NULL, sort_compare_int) != NDS_INVALID_PARAM_ERROR || nds_vector_sort(vector, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_vector_sort(vector, sort_compare_int) != NDS_OK || nds_vector_size(vector) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if random integers are sorted without losing any of them
+ */
+int test_2_nds_vector_sort()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	uint32_t state = 1;
+	long long sum = 0, sorted_sum = 0;
+	int result = 0, i, element;
+
+	for (i = 0; i < 10000; i++)
+	{
+		element = (int)(test_random(&state) % 20000) - 10000;
+		sum += element;
+		nds_vector_push_back(vector, &element);
+	}
+
+	if (nds_vector_sort(vector, sort_compare_int) != NDS_OK)
+		result = 1;
+
+	for (i = 0; i < 10000; i++)
+	{
+		sorted_sum += ((int*)nds_vector_data(vector))[i];
+		if (i > 0 && ((int*)nds_vector_data(vector))[i - 1] > ((int*)nds_vector_data(vector))[i])
+			result = 1;
+	}
+
+	if (nds_vector_size(vector) != 10000 || sorted_sum != sum)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if the patterns handled specially by the sort come out sorted
+ */
+int test_3_nds_vector_sort()
+{
+	NdsVector *vector;
+	int result = 0, pattern, i, element;
+
+	for (pattern = 0; pattern < 5; pattern++)
+	{
+		vector = nds_vector_new(sizeof(int));
+
+		/* ascending, descending, all equal, organ pipe and sawtooth inputs */
+		for (i = 0; i < 5000; i++)
+		{
+			switch (pattern)
+			{
+				case 0:
+					element = i;
+					break;
+
+				case 1:
+					element = 5000 - i;
+					break;
+
+				case 2:
+					element = 7;
+					break;
+
+				case 3:
+					element = i < 2500 ? i : 5000 - i;
+					break;
+
+				default:
+					element = i % 64;
+					break;
+			}
+
+			nds_vector_push_back(vector, &element);
+		}
+
+		if (nds_vector_sort(vector, sort_compare_int) != NDS_OK || !sort_is_sorted(vector, sizeof(int), sort_compare_int))
+			result = 1;
+
+		nds_vector_destroy(vector);
+	}
+
+	return result;
+}
+
+
+/**
+ * Test 4 - verify if structures are sorted by one of their fields
+ */
+int test_4_nds_vector_sort()
+{
+	NdsVector *vector = nds_vector_new(sizeof(SortPerson));
+	uint32_t state = 7;
+	long long id_sum = 0, sorted_id_sum = 0;
+	SortPerson person;
+	int result = 0, i;
+
+	/* 36 byte elements go through the generic swap */
+	memset(&person, 0, sizeof(person));
+	for (i = 0; i < 3000; i++)
+	{
+		person.age = (short)(test_random(&state) % 100);
+		person.id = i;
+		id_sum += i;
+		nds_vector_push_back(vector, &person);
+	}
+
+	if (nds_vector_sort(vector, sort_compare_person) != NDS_OK || !sort_is_sorted(vector, sizeof(SortPerson), sort_compare_person))
+		result = 1;
+
+	for (i = 0; i < 3000; i++)
+		sorted_id_sum += ((SortPerson*)nds_vector_data(vector))[i].id;
+
+	if (sorted_id_sum != id_sum)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 5 - verify if elements larger than the stack scratch space are sorted
+ */
+int test_5_nds_vector_sort()
+{
+	NdsVector *vector = nds_vector_new(300);
+	uint32_t state = 3;
+	char element[300];
+	int result = 0, i, key;
+
+	memset(element, 0, sizeof(element));
+	for (i = 0; i < 1000; i++)
+	{
+		key = (int)(test_random(&state) % 1000);
+		memcpy(element, &key, sizeof(key));
+		element[299] = (char)key;
+		nds_vector_push_back(vector, element);
+	}
+
+	if (nds_vector_sort(vector, sort_compare_int) != NDS_OK || !sort_is_sorted(vector, 300, sort_compare_int))
+		result = 1;
+
+	/* the whole element moves together with its key */
+	for (i = 0; i < 1000; i++)
+	{
+		memcpy(&key, (char*)nds_vector_data(vector) + i * 300, sizeof(key));
+		if (((char*)nds_vector_data(vector))[i * 300 + 299] != (char)key)
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_stable_sort() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_stable_sort()
+ */
+int test_1_nds_vector_stable_sort()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, element = 1;
+
+	if (nds_vector_stable_sort(NULL, sort_compare_int) != NDS_INVALID_PARAM_ERROR || nds_vector_stable_sort(vector, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* a single element is already sorted */
+	nds_vector_push_back(vector, &element);
+	if (nds_vector_stable_sort(vector, sort_compare_int) != NDS_OK || ((int*)nds_vector_data(vector))[0] != 1)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if equivalent elements keep their order
+ */
+int test_2_nds_vector_stable_sort()
+{
+	NdsVector *vector = nds_vector_new(sizeof(SortPerson));
+	uint32_t state = 11;
+	SortPerson person, *previous, *current;
+	int result = 0, i;
+
+	memset(&person, 0, sizeof(person));
+	for (i = 0; i < 5000; i++)
+	{
+		person.age = (short)(test_random(&state) % 10);
+		person.id = i;
+		nds_vector_push_back(vector, &person);
+	}
+
+	if (nds_vector_stable_sort(vector, sort_compare_person) != NDS_OK || nds_vector_size(vector) != 5000)
+		result = 1;
+
+	/* persons of the same age should still be ordered by id */
+	for (i = 1; i < 5000; i++)
+	{
+		previous = (SortPerson*)nds_vector_data(vector) + i - 1;
+		current = (SortPerson*)nds_vector_data(vector) + i;
+
+		if (previous->age > current->age || (previous->age == current->age && previous->id > current->id))
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_radix_sort_by_key() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_radix_sort_by_key()
+ */
+int test_1_nds_vector_radix_sort_by_key()
+{
+	NdsVector *vector = nds_vector_new(sizeof(SortPerson));
+	int result = 0;
+
+	/* invalid vector, key type and keys that do not fit in the element should be rejected */
+	if (nds_vector_radix_sort_by_key(NULL, 0, NDS_KEY_INT32) != NDS_INVALID_PARAM_ERROR ||
+		nds_vector_radix_sort_by_key(vector, 0, (NdsKeyType)42) != NDS_INVALID_PARAM_ERROR ||
+		nds_vector_radix_sort_by_key(vector, sizeof(SortPerson) - 2, NDS_KEY_INT32) != NDS_INVALID_PARAM_ERROR ||
+		nds_vector_radix_sort_by_key(vector, sizeof(SortPerson) + 1, NDS_KEY_UINT8) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	if (nds_vector_radix_sort_by_key(vector, sizeof(SortPerson) - 4, NDS_KEY_INT32) != NDS_OK)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if structures are sorted by a signed field and keep their order
+ */
+int test_2_nds_vector_radix_sort_by_key()
+{
+	NdsVector *vector = nds_vector_new(sizeof(SortPerson));
+	uint32_t state = 5;
+	SortPerson person, *previous, *current;
+	int result = 0, i;
+
+	memset(&person, 0, sizeof(person));
+	for (i = 0; i < 5000; i++)
+	{
+		person.age = (short)((int)(test_random(&state) % 600) - 300);
+		person.id = i;
+		nds_vector_push_back(vector, &person);
+	}
+
+	if (nds_vector_radix_sort_by_key(vector, offsetof(SortPerson, age), NDS_KEY_INT16) != NDS_OK || nds_vector_size(vector) != 5000)
+		result = 1;
+
+	for (i = 1; i < 5000; i++)
+	{
+		previous = (SortPerson*)nds_vector_data(vector) + i - 1;
+		current = (SortPerson*)nds_vector_data(vector) + i;
+
+		if (previous->age > current->age || (previous->age == current->age && previous->id > current->id))
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if floating point keys are sorted like numbers
+ */
+int test_3_nds_vector_radix_sort_by_key()
+{
+	NdsVector *floats = nds_vector_new(sizeof(float));
+	NdsVector *doubles = nds_vector_new(sizeof(double));
+	uint32_t state = 9;
+	float float_element;
+	double double_element;
+	int result = 0, i;
+
+	for (i = 0; i < 4000; i++)
+	{
+		double_element = ((double)(test_random(&state) % 100000) - 50000.0) / 7.0;
+		float_element = (float)double_element;
+
+		nds_vector_push_back(floats, &float_element);
+		nds_vector_push_back(doubles, &double_element);
+	}
+
+	if (nds_vector_radix_sort_by_key(floats, 0, NDS_KEY_FLOAT) != NDS_OK || nds_vector_radix_sort_by_key(doubles, 0, NDS_KEY_DOUBLE) != NDS_OK)
+		result = 1;
+
+	for (i = 1; i < 4000; i++)
+	{
+		if (((float*)nds_vector_data(floats))[i - 1] > ((float*)nds_vector_data(floats))[i] ||
+			((double*)nds_vector_data(doubles))[i - 1] > ((double*)nds_vector_data(doubles))[i])
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_vector_destroy(floats);
+	nds_vector_destroy(doubles);
+
+	return result;
+}
+
+
+/**
+ * Test 4 - verify if 64 bit keys agree with a comparison sort
+ */
+int test_4_nds_vector_radix_sort_by_key()
+{
+	NdsVector *radix_sorted = nds_vector_new(sizeof(int64_t));
+	NdsVector *compare_sorted = nds_vector_new(sizeof(int64_t));
+	uint32_t state = 13;
+	int64_t element;
+	int result = 0, i;
+
+	for (i = 0; i < 4000; i++)
+	{
+		element = (int64_t)(((uint64_t)test_random(&state) << 39) ^ test_random(&state));
+		if (i % 3 == 0)
+			element = -element;
+
+		nds_vector_push_back(radix_sorted, &element);
+		nds_vector_push_back(compare_sorted, &element);
+	}
+
+	if (nds_vector_radix_sort_by_key(radix_sorted, 0, NDS_KEY_INT64) != NDS_OK || nds_vector_sort(compare_sorted, sort_compare_int64) != NDS_OK)
+		result = 1;
+
+	if (memcmp(nds_vector_data(radix_sorted), nds_vector_data(compare_sorted), 4000 * sizeof(int64_t)) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(radix_sorted);
+	nds_vector_destroy(compare_sorted);
+
+	return result;
+}
+
+
+/* number of bytes the skewed allocator moves its blocks away from the alignment of malloc() */
+#define PARALLEL_SKEW 20
+
+
+/* allocator whose blocks start in the middle of a cache line, so the parallel algorithms have to find the line boundaries */
+static void* skewed_alloc(void *context, size_t size)
+{
+	char *block = (char*)malloc(size + PARALLEL_SKEW);
+
+	(void)context;
+
+	return block ? block + PARALLEL_SKEW : NULL;
+}
+
+
+static void* skewed_realloc(void *context, void *pointer, size_t old_size, size_t new_size)
+{
+	char *block = (char*)realloc(pointer ? (char*)pointer - PARALLEL_SKEW : NULL, new_size + PARALLEL_SKEW);
+
+	(void)context;
+	(void)old_size;
+
+	return block ? block + PARALLEL_SKEW : NULL;
+}
+
+
+static void skewed_free(void *context, void *pointer, size_t size)
+{
+	(void)context;
+	(void)size;
+
+	if (pointer)
+		free((char*)pointer - PARALLEL_SKEW);
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_parallel_sort() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_parallel_sort()
+ */
+int test_1_nds_vector_parallel_sort()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0;
+
+	if (nds_vector_parallel_sort(NULL, sort_compare_int) != NDS_INVALID_PARAM_ERROR || nds_vector_parallel_sort(vector, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_vector_parallel_sort(vector, sort_compare_int) != NDS_OK)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the result matches the sequential sort for several worker counts
+ */
+int test_2_nds_vector_parallel_sort()
+{
+	static const size_t workers[] = { 1, 2, 3, 8 };
+	NdsVector *parallel_sorted, *sorted;
+	uint32_t state;
+	int result = 0, element;
+	size_t w, i;
+
+	for (w = 0; w < sizeof(workers) / sizeof(workers[0]); w++)
+	{
+		nds_set_worker_count(workers[w]);
+		parallel_sorted = nds_vector_new(sizeof(int));
+		sorted = nds_vector_new(sizeof(int));
+		state = 17;
+
+		for (i = 0; i < 100003; i++)
+		{
+			element = (int)(test_random(&state) % 50000);
+			nds_vector_push_back(parallel_sorted, &element);
+			nds_vector_push_back(sorted, &element);
+		}
+
+		if (nds_vector_parallel_sort(parallel_sorted, sort_compare_int) != NDS_OK || nds_vector_sort(sorted, sort_compare_int) != NDS_OK)
+			result = 1;
+
+		if (memcmp(nds_vector_data(parallel_sorted), nds_vector_data(sorted), 100003 * sizeof(int)) != 0)
+			result = 1;
+
+		nds_vector_destroy(parallel_sorted);
+		nds_vector_destroy(sorted);
+	}
+
+	nds_set_worker_count(0);
+
+	return result;
+}
+
+
+/**
+ * Test 4 - verify if nds_vector_parallel_sort() sorts elements that do not start a cache line
+ */
+int test_4_nds_vector_parallel_sort()
+{
+	NdsAllocator allocator = { skewed_alloc, skewed_realloc, skewed_free, NULL };
+	NdsVector *parallel_sorted, *sorted;
+	uint32_t state = 23;
+	int result = 0, element;
+	size_t i;
+
+	nds_set_worker_count(4);
+	parallel_sorted = nds_vector_new_with_allocator(sizeof(int), 1, &allocator);
+	sorted = nds_vector_new(sizeof(int));
+
+	for (i = 0; i < 100003; i++)
+	{
+		element = (int)(test_random(&state) % 50000);
+		nds_vector_push_back(parallel_sorted, &element);
+		nds_vector_push_back(sorted, &element);
+	}
+
+	if (nds_vector_parallel_sort(parallel_sorted, sort_compare_int) != NDS_OK || nds_vector_sort(sorted, sort_compare_int) != NDS_OK)
+		result = 1;
+
+	if (memcmp(nds_vector_data(parallel_sorted), nds_vector_data(sorted), 100003 * sizeof(int)) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(parallel_sorted);
+	nds_vector_destroy(sorted);
+	nds_set_worker_count(0);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if equivalent elements keep their order across the merges of the threads
+ */
+int test_3_nds_vector_parallel_sort()
+{
+	NdsVector *vector = nds_vector_new(sizeof(SortPerson));
+	uint32_t state = 23;
+	SortPerson person, *previous, *current;
+	int result = 0, i;
+
+	nds_set_worker_count(4);
+
+	memset(&person, 0, sizeof(person));
+	for (i = 0; i < 60000; i++)
+	{
+		person.age = (short)(test_random(&state) % 16);
+		person.id = i;
+		nds_vector_push_back(vector, &person);
+	}
+
+	if (nds_vector_parallel_sort(vector, sort_compare_person) != NDS_OK || nds_vector_size(vector) != 60000)
+		result = 1;
+
+	for (i = 1; i < 60000; i++)
+	{
+		previous = (SortPerson*)nds_vector_data(vector) + i - 1;
+		current = (SortPerson*)nds_vector_data(vector) + i;
+
+		if (previous->age > current->age || (previous->age == current->age && previous->id > current->id))
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+	nds_set_worker_count(0);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_parallel_for_each() function.
+ */
+
+
+static void parallel_increment(void *element, void *context)
+{
+	(void)context;
+
+	(*(int*)element)++;
+}
+
+
+static void parallel_half(const void *source, void *destination, void *context)
+{
+	(void)context;
+
+	*(double*)destination = *(const int*)source * 0.5;
+}
+
+
+static void parallel_square(const void *source, void *destination, void *context)
+{
+	int value = *(const int*)source % 1000;
+
+	(void)context;
+
+	*(int*)destination = value * value;
+}
+
+
+static void parallel_add(void *accumulator, const void *value, void *context)
+{
+	(void)context;
+
+	*(long long*)accumulator += *(const int*)value;
+}
+
+
+static void parallel_combine(void *accumulator, const void *value, void *context)
+{
+	(void)context;
+
+	*(long long*)accumulator += *(const long long*)value;
+}
+
+
+/**
+ * Test 1 - sanity check for nds_vector_parallel_for_each()
+ */
+int test_1_nds_vector_parallel_for_each()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0;
+
+	if (nds_vector_parallel_for_each(NULL, parallel_increment, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_vector_parallel_for_each(vector, NULL, NULL) != NDS_INVALID_PARAM_ERROR || nds_vector_parallel_for_each(vector, parallel_increment, NULL) != NDS_OK)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if every element is visited exactly once
+ */
+int test_2_nds_vector_parallel_for_each()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, i;
+
+	nds_set_worker_count(4);
+
+	for (i = 0; i < 100001; i++)
+		nds_vector_push_back(vector, &i);
+
+	if (nds_vector_parallel_for_each(vector, parallel_increment, NULL) != NDS_OK)
+		result = 1;
+
+	for (i = 0; i < 100001; i++)
+		if (((int*)nds_vector_data(vector))[i] != i + 1)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+	nds_set_worker_count(0);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if nds_vector_parallel_for_each() and nds_vector_parallel_reduce() visit every element once when the elements do not start a cache line
+ */
+int test_3_nds_vector_parallel_for_each()
+{
+	static const int sizes[] = { 1, 11, 16, 17, 100001 };
+	NdsAllocator allocator = { skewed_alloc, skewed_realloc, skewed_free, NULL };
+	NdsVector *vector;
+	long long sum;
+	int result = 0, i;
+	size_t s;
+
+	nds_set_worker_count(4);
+
+	for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		vector = nds_vector_new_with_allocator(sizeof(int), 1, &allocator);
+		for (i = 0; i < sizes[s]; i++)
+			nds_vector_push_back(vector, &i);
+
+		if (nds_vector_parallel_for_each(vector, parallel_increment, NULL) != NDS_OK)
+			result = 1;
+
+		for (i = 0; i < sizes[s]; i++)
+			if (((int*)nds_vector_data(vector))[i] != i + 1)
+				result = 1;
+
+		/* the elements are now 1 to size */
+		sum = 0;
+		if (nds_vector_parallel_reduce(vector, &sum, sizeof(sum), parallel_add, parallel_combine, NULL) != NDS_OK || sum != (long long)sizes[s] * (sizes[s] + 1) / 2)
+			result = 1;
+
+		nds_vector_destroy(vector);
+	}
+
+	nds_set_worker_count(0);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_parallel_transform() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_parallel_transform()
+ */
+int test_1_nds_vector_parallel_transform()
+{
+	NdsVector *source = nds_vector_new(sizeof(int));
+	NdsVector *destination = nds_vector_new(sizeof(double));
+	double element = 1.0;
+	int result = 0;
+
+	if (nds_vector_parallel_transform(NULL, destination, parallel_half, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_vector_parallel_transform(source, NULL, parallel_half, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_vector_parallel_transform(source, destination, NULL, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* an empty source leaves an empty destination */
+	nds_vector_push_back(destination, &element);
+	if (nds_vector_parallel_transform(source, destination, parallel_half, NULL) != NDS_OK || nds_vector_size(destination) != 0)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(source);
+	nds_vector_destroy(destination);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if a destination with another element type is resized and computed
+ */
+int test_2_nds_vector_parallel_transform()
+{
+	NdsVector *source = nds_vector_new(sizeof(int));
+	NdsVector *destination = nds_vector_new(sizeof(double));
+	int result = 0, i;
+
+	nds_set_worker_count(3);
+
+	for (i = 0; i < 70001; i++)
+		nds_vector_push_back(source, &i);
+
+	if (nds_vector_parallel_transform(source, destination, parallel_half, NULL) != NDS_OK || nds_vector_size(destination) != 70001)
+		result = 1;
+
+	for (i = 0; i < 70001; i++)
+		if (((double*)nds_vector_data(destination))[i] != i * 0.5)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(source);
+	nds_vector_destroy(destination);
+	nds_set_worker_count(0);
+
+	return result;
+}
+
+
+/**
+ * Test 3 - verify if a vector is transformed in place
+ */
+int test_3_nds_vector_parallel_transform()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	int result = 0, i;
+
+	nds_set_worker_count(4);
+
+	for (i = 0; i < 50000; i++)
+		nds_vector_push_back(vector, &i);
+
+	if (nds_vector_parallel_transform(vector, vector, parallel_square, NULL) != NDS_OK || nds_vector_size(vector) != 50000)
+		result = 1;
+
+	for (i = 0; i < 50000; i++)
+		if (((int*)nds_vector_data(vector))[i] != (i % 1000) * (i % 1000))
+			result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+	nds_set_worker_count(0);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_parallel_reduce() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_parallel_reduce()
+ */
+int test_1_nds_vector_parallel_reduce()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	long long sum = 42;
+	int result = 0;
+
+	if (nds_vector_parallel_reduce(NULL, &sum, sizeof(sum), parallel_add, parallel_combine, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_vector_parallel_reduce(vector, NULL, sizeof(sum), parallel_add, parallel_combine, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_vector_parallel_reduce(vector, &sum, 0, parallel_add, parallel_combine, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_vector_parallel_reduce(vector, &sum, sizeof(sum), NULL, parallel_combine, NULL) != NDS_INVALID_PARAM_ERROR ||
+		nds_vector_parallel_reduce(vector, &sum, sizeof(sum), parallel_add, NULL, NULL) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	/* an empty vector leaves the identity in the result */
+	if (nds_vector_parallel_reduce(vector, &sum, sizeof(sum), parallel_add, parallel_combine, NULL) != NDS_OK || sum != 42)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if the partial results of the threads add up to the sum of the elements
+ */
+int test_2_nds_vector_parallel_reduce()
+{
+	NdsVector *vector = nds_vector_new(sizeof(int));
+	long long sum = 0;
+	int result = 0, i;
+
+	nds_set_worker_count(4);
+
+	for (i = 0; i < 200000; i++)
+		nds_vector_push_back(vector, &i);
+
+	if (nds_vector_parallel_reduce(vector, &sum, sizeof(sum), parallel_add, parallel_combine, NULL) != NDS_OK || sum != 199999LL * 200000 / 2)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_destroy(vector);
+	nds_set_worker_count(0);
+
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndsvectortests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_vector_new();
+
+		case 2:
+			return test_2_nds_vector_new();
+
+		case 3:
+			return test_1_nds_vector_new_with_capacity();
+
+		case 4:
+			return test_2_nds_vector_new_with_capacity();
+
+		case 5:
+			return test_3_nds_vector_new_with_capacity();
+
+		case 6:
+			return test_1_nds_vector_destroy();
+
+		case 7:
+			return test_2_nds_vector_destroy();
+
+		case 8:
+			return test_3_nds_vector_destroy();
+
+		case 9:
+			return test_1_nds_vector_is_empty();
+
+		case 10:
+			return test_2_nds_vector_is_empty();
+
+		case 11:
+			return test_3_nds_vector_is_empty();
+
+		case 12:
+			return test_1_nds_vector_size();
+
+		case 13:
+			return test_2_nds_vector_size();
+
+		case 14:
+			return test_3_nds_vector_size();
+
+		case 15:
+			return test_1_nds_vector_resize();
+
+		case 16:
+			return test_2_nds_vector_resize();
+
+		case 17:
+			return test_3_nds_vector_resize();
+
+		case 18:
+			return test_4_nds_vector_resize();
+
+		case 19:
+			return test_5_nds_vector_resize();
+
+		case 20:
+			return test_6_nds_vector_resize();
+
+		case 21:
+			return test_7_nds_vector_resize();
+
+		case 22:
+			return test_1_nds_vector_capacity();
+
+		case 23:
+			return test_2_nds_vector_capacity();
+
+		case 24:
+			return test_3_nds_vector_capacity();
+
+		case 25:
+			return test_1_nds_vector_reserve();
+
+		case 26:
+			return test_2_nds_vector_reserve();
+
+		case 27:
+			return test_3_nds_vector_reserve();
+
+		case 28:
+			return test_4_nds_vector_reserve();
+
+		case 29:
+			return test_5_nds_vector_reserve();
+
+		case 30:
+			return test_1_nds_vector_shrink_to_fit();
+
+		case 31:
+			return test_2_nds_vector_shrink_to_fit();
+
+		case 32:
+			return test_3_nds_vector_shrink_to_fit();
+
+		case 33:
+			return test_4_nds_vector_shrink_to_fit();
+
+		case 34:
+			return test_1_nds_vector_push_back();
+
+		case 35:
+			return test_2_nds_vector_push_back();
+
+		case 36:
+			return test_3_nds_vector_push_back();
+
+		case 37:
+			return test_1_nds_vector_append_n();
+
+		case 38:
+			return test_2_nds_vector_append_n();
+
+		case 39:
+			return test_3_nds_vector_append_n();
+
+		case 40:
+			return test_1_nds_vector_pop_back();
+
+		case 41:
+			return test_2_nds_vector_pop_back();
+
+		case 42:
+			return test_3_nds_vector_pop_back();
+
+		case 43:
+			return test_1_nds_vector_get();
+
+		case 44:
+			return test_2_nds_vector_get();
+
+		case 45:
+			return test_3_nds_vector_get();
+
+		case 46:
+			return test_1_nds_vector_set();
+
+		case 47:
+			return test_2_nds_vector_set();
+
+		case 48:
+			return test_3_nds_vector_set();
+
+		case 49:
+			return test_1_nds_vector_data();
+
+		case 50:
+			return test_2_nds_vector_data();
+
+		case 51:
+			return test_1_nds_vector_new_small();
+
+		case 52:
+			return test_2_nds_vector_new_small();
+
+		case 53:
+			return test_3_nds_vector_new_small();
+
+		case 54:
+			return test_4_nds_vector_new_small();
+
+		case 55:
+			return test_1_nds_vector_new_with_allocator();
+
+		case 56:
+			return test_2_nds_vector_new_with_allocator();
+
+		case 57:
+			return test_3_nds_vector_new_with_allocator();
+
+		case 58:
+			return test_4_nds_vector_new_with_allocator();
+
+		case 59:
+			return test_1_nds_vector_set_large_storage();
+
+		case 60:
+			return test_2_nds_vector_set_large_storage();
+
+		case 61:
+			return test_3_nds_vector_set_large_storage();
+
+		case 62:
+			return test_4_nds_vector_set_large_storage();
+
+		case 63:
+			return test_1_nds_vector_save();
+
+		case 64:
+			return test_2_nds_vector_save();
+
+		case 65:
+			return test_1_nds_vector_open_mapped();
+
+		case 66:
+			return test_2_nds_vector_open_mapped();
+
+		case 67:
+			return test_3_nds_vector_open_mapped();
+
+		case 68:
+			return test_4_nds_vector_open_mapped();
+
+		case 69:
+			return test_1_nds_vector_get_stats();
+
+		case 70:
+			return test_2_nds_vector_get_stats();
+
+		case 71:
+			return test_1_nds_stats_snapshot();
+
+		case 72:
+			return test_2_nds_stats_snapshot();
+
+		case 73:
+			return test_1_nds_vector_resize_with_policy();
+
+		case 74:
+			return test_2_nds_vector_resize_with_policy();
+
+		case 75:
+			return test_3_nds_vector_resize_with_policy();
+
+		case 76:
+			return test_4_nds_vector_resize_with_policy();
+
+		case 77:
+			return test_1_nds_vector_resize_fill();
+
+		case 78:
+			return test_2_nds_vector_resize_fill();
+
+		case 79:
+			return test_3_nds_vector_resize_fill();
+
+		case 80:
+			return test_4_nds_vector_new_with_capacity();
+
+		case 81:
+			return test_4_nds_vector_size();
+
+		case 82:
+			return test_8_nds_vector_resize();
+
+		case 83:
+			return test_6_nds_vector_reserve();
+
+		case 84:
+			return test_4_nds_vector_append_n();
+
+		case 85:
+			return test_1_nds_vector_find();
+
+		case 86:
+			return test_2_nds_vector_find();
+
+		case 87:
+			return test_3_nds_vector_find();
+
+		case 88:
+			return test_1_nds_vector_count();
+
+		case 89:
+			return test_2_nds_vector_count();
+
+		case 90:
+			return test_1_nds_vector_contains();
+
+		case 91:
+			return test_2_nds_vector_contains();
+
+		case 92:
+			return test_1_nds_vector_sort();
+
+		case 93:
+			return test_2_nds_vector_sort();
+
+		case 94:
+			return test_3_nds_vector_sort();
+
+		case 95:
+			return test_4_nds_vector_sort();
+
+		case 96:
+			return test_5_nds_vector_sort();
+
+		case 97:
+			return test_1_nds_vector_stable_sort();
+
+		case 98:
+			return test_2_nds_vector_stable_sort();
+
+		case 99:
+			return test_1_nds_vector_radix_sort_by_key();
+
+		case 100:
+			return test_2_nds_vector_radix_sort_by_key();
+
+		case 101:
+			return test_3_nds_vector_radix_sort_by_key();
+
+		case 102:
+			return test_4_nds_vector_radix_sort_by_key();
+
+		case 103:
+			return test_1_nds_vector_parallel_sort();
+
+		case 104:
+			return test_2_nds_vector_parallel_sort();
+
+		case 105:
+			return test_3_nds_vector_parallel_sort();
+
+		case 106:
+			return test_1_nds_vector_parallel_for_each();
+
+		case 107:
+			return test_2_nds_vector_parallel_for_each();
+
+		case 108:
+			return test_1_nds_vector_parallel_transform();
+
+		case 109:
+			return test_2_nds_vector_parallel_transform();
+
+		case 110:
+			return test_3_nds_vector_parallel_transform();
+
+		case 111:
+			return test_1_nds_vector_parallel_reduce();
+
+		case 112:
+			return test_2_nds_vector_parallel_reduce();
+
+		case 113:
+			return test_4_nds_vector_push_back();
+
+		case 114:
+			return test_5_nds_vector_append_n();
+
+		case 115:
+			return test_3_nds_stats_snapshot();
+
+		case 116:
+			return test_5_nds_vector_resize_with_policy();
+
+		case 117:
+			return test_3_nds_vector_parallel_for_each();
+
+		case 118:
+			return test_4_nds_vector_parallel_sort();
 
 		default:
 			printf("No tests were found with the given ID!\n");
@@ -0,0 +1,464 @@
+/**
+ * NDS - Neo Data Structures
+ * Copyright (C) 2017-2018 MiVal Software
+ *
+ * This file is part of Neo Data Structures.
+ *
+ * Neo Data Structures is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Neo Data Structures is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Neo Data Structures. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * This file defines various unit tests for the vectors generated by the
+ * NDS_VECTOR_DECLARE() macro from the NDS library.
+ *
+ * @author      Valentin Gabriel Mitrea <mitrea.valentin@gmail.com>
+ * @created     17 October 2026
+ * @modified    17 October 2026
+ */
+
+#include <nds/ndsvectortyped.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+struct Person
+{
+	char name[30];
+	int age;
+};
+
+typedef struct Person Person;
+
+
+NDS_VECTOR_DECLARE(int)
+NDS_VECTOR_DECLARE(double)
+NDS_VECTOR_DECLARE(Person)
+
+
+/**
+ * Unit tests for the nds_vector_T_init() function.
+ */
+
+/**
+ * Test 1 - sanity check for nds_vector_T_init_with_capacity()
+ */
+int test_1_nds_vector_typed_init()
+{
+	NdsVector_int vector;
+
+	/* init() should return NDS_INVALID_PARAM_ERROR */
+	if (nds_vector_int_init_with_capacity(NULL, 10) != NDS_INVALID_PARAM_ERROR || nds_vector_int_init_with_capacity(&vector, 0) != NDS_INVALID_PARAM_ERROR)
+		return 1;
+
+	return 0;
+}
+
+
+/**
+ * Test 2 - verify if nds_vector_T_init() creates an empty vector with capacity 10
+ */
+int test_2_nds_vector_typed_init()
+{
+	NdsVector_double vector;
+	int result = 0;
+
+	if (nds_vector_double_init(&vector) != NDS_OK)
+		return 1;
+
+	/* vector should be empty, with size 0 and capacity 10 */
+	if (!nds_vector_double_is_empty(&vector) || nds_vector_double_size(&vector) != 0 || nds_vector_double_capacity(&vector) != 10)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_double_destroy(&vector);
+
+	/* destroy() should leave the vector without memory */
+	if (nds_vector_double_data(&vector) != NULL || nds_vector_double_capacity(&vector) != 0)
+		result = 1;
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_T_push_back() function.
+ */
+
+/**
+ * Test 1 - verify if nds_vector_T_push_back() grows like nds_vector_push_back()
+ */
+int test_1_nds_vector_typed_push_back()
+{
+	NdsVector_int vector;
+	int result = 0, i;
+
+	nds_vector_int_init(&vector);
+
+	for (i = 0; i < 100; i++)
+		if (nds_vector_int_push_back(&vector, i) != NDS_OK)
+			result = 1;
+
+	/* vector should have size 100 and capacity 160 (10 doubled four times) */
+	if (nds_vector_int_size(&vector) != 100 || nds_vector_int_capacity(&vector) != 160)
+		result = 1;
+
+	for (i = 0; i < 100; i++)
+		if (nds_vector_int_get(&vector, i) != i)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_int_destroy(&vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if nds_vector_T_push_back() stores structures by value
+ */
+int test_2_nds_vector_typed_push_back()
+{
+	NdsVector_Person vector;
+	Person person;
+	int result = 0, i;
+
+	nds_vector_Person_init(&vector);
+
+	for (i = 0; i < 20; i++)
+	{
+		sprintf(person.name, "Person%d", i);
+		person.age = 20 + i;
+		nds_vector_Person_push_back(&vector, person);
+	}
+
+	/* changing the local copy should not affect the vector */
+	strcpy(person.name, "Changed");
+
+	for (i = 0; i < 20; i++)
+	{
+		char name[30];
+
+		sprintf(name, "Person%d", i);
+		if (nds_vector_Person_get(&vector, i).age != 20 + i || strcmp(nds_vector_Person_data(&vector)[i].name, name) != 0)
+			result = 1;
+	}
+
+	/* cleanup */
+	nds_vector_Person_destroy(&vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_T_append_n() function.
+ */
+
+/**
+ * Test 1 - verify if nds_vector_T_append_n() appends a range with a single growth
+ */
+int test_1_nds_vector_typed_append_n()
+{
+	NdsVector_int vector;
+	int elements[500];
+	int result = 0, i;
+
+	for (i = 0; i < 500; i++)
+		elements[i] = 3 * i;
+
+	nds_vector_int_init(&vector);
+
+	if (nds_vector_int_append_n(&vector, NULL, 1) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	if (nds_vector_int_append_n(&vector, elements, 500) != NDS_OK || nds_vector_int_size(&vector) != 500 || nds_vector_int_capacity(&vector) != 500)
+		result = 1;
+
+	for (i = 0; i < 500; i++)
+		if (nds_vector_int_get(&vector, i) != 3 * i)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_int_destroy(&vector);
+
+	return result;
+}
+
+/**
+ * Test 2 - verify if nds_vector_T_append_n() duplicates the contents of the vector into itself when the vector grows
+ */
+int test_2_nds_vector_typed_append_n()
+{
+	NdsVector_int vector;
+	int result = 0, i;
+
+	nds_vector_int_init(&vector);
+
+	for (i = 0; i < 10; i++)
+		nds_vector_int_push_back(&vector, i);
+
+	/* the source is the whole buffer, which is moved by the growth */
+	if (nds_vector_int_append_n(&vector, nds_vector_int_data(&vector), 10) != NDS_OK || nds_vector_int_size(&vector) != 20)
+		result = 1;
+
+	for (i = 0; i < 20; i++)
+		if (nds_vector_int_get(&vector, i) != i % 10)
+			result = 1;
+
+	/* cleanup */
+	nds_vector_int_destroy(&vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_T_pop_back() function.
+ */
+
+/**
+ * Test 1 - verify if nds_vector_T_pop_back() removes the elements in reverse order
+ */
+int test_1_nds_vector_typed_pop_back()
+{
+	NdsVector_double vector;
+	double element;
+	int result = 0, i;
+
+	nds_vector_double_init(&vector);
+
+	/* pop_back() should return NDS_INVALID_PARAM_ERROR for an empty vector */
+	if (nds_vector_double_pop_back(&vector, &element) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	for (i = 0; i < 5; i++)
+		nds_vector_double_push_back(&vector, i + 0.5);
+
+	for (i = 4; i >= 0; i--)
+		if (nds_vector_double_pop_back(&vector, &element) != NDS_OK || element != i + 0.5)
+			result = 1;
+
+	if (!nds_vector_double_is_empty(&vector))
+		result = 1;
+
+	/* cleanup */
+	nds_vector_double_destroy(&vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_T_set() function.
+ */
+
+/**
+ * Test 1 - verify if nds_vector_T_set() overwrites only the given element
+ */
+int test_1_nds_vector_typed_set()
+{
+	NdsVector_int vector;
+	int result = 0, i;
+
+	nds_vector_int_init(&vector);
+
+	for (i = 0; i < 5; i++)
+		nds_vector_int_push_back(&vector, i);
+
+	nds_vector_int_set(&vector, 3, 42);
+
+	for (i = 0; i < 5; i++)
+		if (nds_vector_int_get(&vector, i) != (i == 3 ? 42 : i))
+			result = 1;
+
+	/* cleanup */
+	nds_vector_int_destroy(&vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_T_reserve() function.
+ */
+
+/**
+ * Test 1 - verify if nds_vector_T_reserve() has the semantics of nds_vector_reserve()
+ */
+int test_1_nds_vector_typed_reserve()
+{
+	NdsVector_int vector;
+	int result = 0;
+
+	nds_vector_int_init(&vector);
+
+	/* reserve() should return NDS_INVALID_PARAM_ERROR when the capacity does not grow */
+	if (nds_vector_int_reserve(&vector, 10) != NDS_INVALID_PARAM_ERROR || nds_vector_int_reserve(NULL, 20) != NDS_INVALID_PARAM_ERROR)
+		result = 1;
+
+	if (nds_vector_int_reserve(&vector, 20) != NDS_OK || nds_vector_int_capacity(&vector) != 20)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_int_destroy(&vector);
+
+	return result;
+}
+
+
+/**
+ * Test 2 - verify if a capacity whose size in bytes overflows is rejected
+ */
+int test_2_nds_vector_typed_reserve()
+{
+	NdsVector_double vector;
+	int result = 0;
+
+	if (nds_vector_double_init_with_capacity(&vector, SIZE_MAX / 4) != NDS_MEM_ALLOC_ERROR)
+		result = 1;
+
+	nds_vector_double_init(&vector);
+	if (nds_vector_double_reserve(&vector, SIZE_MAX / 4) != NDS_MEM_ALLOC_ERROR || nds_vector_double_capacity(&vector) != 10)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_double_destroy(&vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_T_resize() function.
+ */
+
+/**
+ * Test 1 - verify if nds_vector_T_resize() grows the capacity like nds_vector_resize()
+ */
+int test_1_nds_vector_typed_resize()
+{
+	NdsVector_int vector;
+	int result = 0;
+
+	nds_vector_int_init(&vector);
+
+	/* vector should have size 15 and capacity 20 after resize */
+	if (nds_vector_int_resize(&vector, 15) != NDS_OK || nds_vector_int_size(&vector) != 15 || nds_vector_int_capacity(&vector) != 20)
+		result = 1;
+
+	/* vector should have size 2 and the same capacity after resize */
+	if (nds_vector_int_resize(&vector, 2) != NDS_OK || nds_vector_int_size(&vector) != 2 || nds_vector_int_capacity(&vector) != 20)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_int_destroy(&vector);
+
+	return result;
+}
+
+
+
+/**
+ * Unit tests for the nds_vector_T_shrink_to_fit() function.
+ */
+
+/**
+ * Test 1 - verify if nds_vector_T_shrink_to_fit() reduces the capacity to the size
+ */
+int test_1_nds_vector_typed_shrink_to_fit()
+{
+	NdsVector_int vector;
+	int result = 0;
+
+	nds_vector_int_init(&vector);
+
+	/* shrink_to_fit() should have reduced the capacity to 1 for an empty vector */
+	if (nds_vector_int_shrink_to_fit(&vector) != NDS_OK || nds_vector_int_capacity(&vector) != 1)
+		result = 1;
+
+	nds_vector_int_resize(&vector, 5);
+
+	/* shrink_to_fit() should have reduced the capacity to 5 */
+	if (nds_vector_int_shrink_to_fit(&vector) != NDS_OK || nds_vector_int_capacity(&vector) != 5)
+		result = 1;
+
+	/* cleanup */
+	nds_vector_int_destroy(&vector);
+
+	return result;
+}
+
+
+int main(int argc, char **argv)
+{
+	/* sanity check */
+	if (argc != 2)
+	{
+		printf("Usage: ./ndsvectortypedtests test_id\n");
+		return 1;
+	}
+
+	/* we run the test that was passed as command line argument */
+	switch (atoi(argv[1]))
+	{
+		case 1:
+			return test_1_nds_vector_typed_init();
+
+		case 2:
+			return test_2_nds_vector_typed_init();
+
+		case 3:
+			return test_1_nds_vector_typed_push_back();
+
+		case 4:
+			return test_2_nds_vector_typed_push_back();
+
+		case 5:
+			return test_1_nds_vector_typed_append_n();
+
+		case 6:
+			return test_1_nds_vector_typed_pop_back();
+
+		case 7:
+			return test_1_nds_vector_typed_set();
+
+		case 8:
+			return test_1_nds_vector_typed_reserve();
+
+		case 9:
+			return test_1_nds_vector_typed_resize();
+
+		case 10:
+			return test_1_nds_vector_typed_shrink_to_fit();
+
+		case 11:
+			return test_2_nds_vector_typed_reserve();
+
+		case 12:
+			return test_2_nds_vector_typed_append_n();
+
+		default:
+			printf("No tests were found with the given ID!\n");
+			return 1;
+	}
+}